@@ -8,10 +8,12 @@
 #define CFD_CORE_INCLUDE_CFDCORE_CFDCORE_ADDRESS_H_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
+#include "cfdcore/cfdcore_exception.h"
 #include "cfdcore/cfdcore_key.h"
 #include "cfdcore/cfdcore_schnorrsig.h"
 #include "cfdcore/cfdcore_script.h"
@@ -45,9 +47,30 @@ constexpr const char* const kPrefixBlindP2sh = "blindedP2sh";
 //! key: blind bech32 hrp (blech32)
 constexpr const char* const kPrefixBlindBech32Hrp = "blech32";
 
+/**
+ * @brief The network parameters decoded from the address format data.
+ * @details The has_* flags show that the value is set and valid.
+ */
+struct NetworkParams {
+  NetType net_type;               //!< network type
+  bool has_net_type;              //!< network type exists
+  uint8_t p2pkh_prefix;           //!< p2pkh prefix
+  bool has_p2pkh_prefix;          //!< p2pkh prefix exists
+  uint8_t p2sh_prefix;            //!< p2sh prefix
+  bool has_p2sh_prefix;           //!< p2sh prefix exists
+  std::string bech32_hrp;         //!< bech32 hrp (empty: not exist)
+  uint8_t blinded_p2pkh_prefix;   //!< blinded p2pkh prefix (elements)
+  bool has_blinded_p2pkh_prefix;  //!< blinded p2pkh prefix exists
+  uint8_t blinded_p2sh_prefix;    //!< blinded p2sh prefix (elements)
+  bool has_blinded_p2sh_prefix;   //!< blinded p2sh prefix exists
+  std::string blech32_hrp;        //!< blech32 hrp (empty: not exist)
+};
+
 /**
  * @class AddressFormatData
  * @brief class for showing format data of address
+ * @details The format data is immutable, and it is shared between copies.
+ *     The network parameters are decoded on construction.
  */
 class CFD_CORE_EXPORT AddressFormatData {
  public:
@@ -107,6 +130,11 @@ class CFD_CORE_EXPORT AddressFormatData {
    * @return network type
    */
   NetType GetNetType() const;
+  /**
+   * @brief Get the decoded network parameters.
+   * @return network parameters
+   */
+  const NetworkParams& GetNetworkParams() const { return body_->params; }
 
   /**
    * @brief Check format item.
@@ -139,7 +167,23 @@ class CFD_CORE_EXPORT AddressFormatData {
       const std::string& json_data);
 
  private:
-  std::map<std::string, std::string> map_;  //!< map
+  /**
+   * @brief format data body.
+   */
+  struct FormatBody {
+    std::map<std::string, std::string> map;  //!< map
+    NetworkParams params;                    //!< decoded network parameters
+  };
+
+  std::shared_ptr<const FormatBody> body_;  //!< format data body (immutable)
+
+  /**
+   * @brief Create the format data body.
+   * @param[in] map_data     prefix setting map
+   * @return format data body
+   */
+  static std::shared_ptr<const FormatBody> CreateBody(
+      const std::map<std::string, std::string>& map_data);
 };
 
 /**
@@ -150,6 +194,9 @@ CFD_CORE_API std::vector<AddressFormatData> GetBitcoinAddressFormatList();
 
 /**
  * @brief set custom address format list.
+ * @details The list is published as an immutable snapshot, so it can be
+ *     called while other threads are creating addresses. If the custom
+ *     list is already set, this function does nothing.
  * @param[in] list    custom address format list.
  */
 CFD_CORE_API void SetCustomAddressFormatList(
@@ -157,6 +204,8 @@ CFD_CORE_API void SetCustomAddressFormatList(
 
 /**
  * @brief clear custom address format list.
+ * @details The threads that are using the previous snapshot continue to
+ *     use it until their address operation finishes.
  */
 CFD_CORE_API void ClearCustomAddressFormatList();
 
@@ -175,6 +224,24 @@ enum AddressType {
   kWitnessUnknown      //!< witness unknown address
 };
 
+//! max locking script size of the address (segwit: 2 + 40 bytes)
+constexpr size_t kMaxAddressLockingScriptSize = 42;
+
+/**
+ * @brief The result of Address::Parse.
+ * @details This is a plain structure, and the other fields are valid only
+ *     if the error is kCfdSuccess.
+ */
+struct AddressParseResult {
+  CfdError error;                  //!< error code (kCfdSuccess: valid)
+  NetType net_type;                //!< network type
+  AddressType address_type;        //!< address type
+  WitnessVersion witness_version;  //!< witness version
+  uint32_t locking_script_size;    //!< locking script size
+  //! locking script
+  uint8_t locking_script[kMaxAddressLockingScriptSize];
+};
+
 /**
  * @class Address
  * @brief address class.
@@ -190,12 +257,23 @@ class CFD_CORE_EXPORT Address {
    * @param[in] object    object
    */
   Address(const Address& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  Address(Address&& object) noexcept;
   /**
    * @brief copy constructor.
    * @param[in] object    object
    * @return object
    */
   Address& operator=(const Address& object);
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  Address& operator=(Address&& object) noexcept;
 
   /**
    * @brief Constructor. (for string)
@@ -594,6 +672,26 @@ class CFD_CORE_EXPORT Address {
       NetType type, const Script& locking_script,
       const std::vector<AddressFormatData>& network_parameters);
 
+  /**
+   * @brief Parse the address string for the validation.
+   * @details The network format is selected from the base58 prefix or the
+   *     bech32 hrp with the address format table. This function does not
+   *     allocate memory or throw an exception.
+   * @param[in] address_string  address string
+   * @return parse result
+   */
+  static AddressParseResult Parse(const std::string& address_string);
+  /**
+   * @brief Parse the address string for the validation.
+   * @details This function does not throw an exception.
+   * @param[in] address_string      address string
+   * @param[in] network_parameters  network prefix list
+   * @return parse result
+   */
+  static AddressParseResult Parse(
+      const std::string& address_string,
+      const std::vector<AddressFormatData>& network_parameters);
+
  private:
   /**
    * @brief calculate P2SH Address
@@ -691,6 +789,8 @@ class CFD_CORE_EXPORT Address {
   static AddressFormatData GetTargetFormatData(
       const std::vector<AddressFormatData>& network_parameters, NetType type);
 
+  friend class AddressFactory;
+
   //! address's NetType
   NetType type_;
 
@@ -722,6 +822,187 @@ class CFD_CORE_EXPORT Address {
   AddressFormatData format_data_;
 };
 
+/**
+ * @class AddressFactory
+ * @brief Batch address creation class.
+ * @details The hashes of the whole list are calculated at once, and all
+ *     addresses are encoded with the same network parameter.
+ */
+class CFD_CORE_EXPORT AddressFactory {
+ public:
+  /**
+   * @brief Create the addresses from the pubkeys.
+   * @param[in] net_type        network type
+   * @param[in] address_type    address type
+   *     (p2pkh, p2wpkh or p2sh-p2wpkh)
+   * @param[in] pubkeys         pubkey list
+   * @param[in] thread_count    worker thread count (0: hardware concurrency)
+   * @return address list (same order as pubkeys)
+   */
+  static std::vector<Address> CreateBatch(
+      NetType net_type, AddressType address_type,
+      const std::vector<Pubkey>& pubkeys, uint32_t thread_count = 0);
+  /**
+   * @brief Create the addresses from the pubkeys.
+   * @param[in] net_type            network type
+   * @param[in] address_type        address type
+   *     (p2pkh, p2wpkh or p2sh-p2wpkh)
+   * @param[in] pubkeys             pubkey list
+   * @param[in] network_parameters  network parameter list
+   * @param[in] thread_count        worker thread count
+   *     (0: hardware concurrency)
+   * @return address list (same order as pubkeys)
+   */
+  static std::vector<Address> CreateBatch(
+      NetType net_type, AddressType address_type,
+      const std::vector<Pubkey>& pubkeys,
+      const std::vector<AddressFormatData>& network_parameters,
+      uint32_t thread_count = 0);
+  /**
+   * @brief Create the addresses from the scripts.
+   * @param[in] net_type        network type
+   * @param[in] address_type    address type
+   *     (p2sh, p2wsh or p2sh-p2wsh)
+   * @param[in] scripts         redeem script (or witness script) list
+   * @param[in] thread_count    worker thread count (0: hardware concurrency)
+   * @return address list (same order as scripts)
+   */
+  static std::vector<Address> CreateBatch(
+      NetType net_type, AddressType address_type,
+      const std::vector<Script>& scripts, uint32_t thread_count = 0);
+  /**
+   * @brief Create the addresses from the scripts.
+   * @param[in] net_type            network type
+   * @param[in] address_type        address type
+   *     (p2sh, p2wsh or p2sh-p2wsh)
+   * @param[in] scripts             redeem script (or witness script) list
+   * @param[in] network_parameters  network parameter list
+   * @param[in] thread_count        worker thread count
+   *     (0: hardware concurrency)
+   * @return address list (same order as scripts)
+   */
+  static std::vector<Address> CreateBatch(
+      NetType net_type, AddressType address_type,
+      const std::vector<Script>& scripts,
+      const std::vector<AddressFormatData>& network_parameters,
+      uint32_t thread_count = 0);
+
+ private:
+  /**
+   * @brief Create the addresses from the pubkeys or the scripts.
+   * @param[in] net_type            network type
+   * @param[in] address_type        address type
+   * @param[in] pubkeys             pubkey list (nullptr if scripts is used)
+   * @param[in] scripts             script list (nullptr if pubkeys is used)
+   * @param[in] network_parameters  network parameter list
+   * @param[in] thread_count        worker thread count
+   * @return address list
+   */
+  static std::vector<Address> CreateAddressList(
+      NetType net_type, AddressType address_type,
+      const std::vector<Pubkey>* pubkeys, const std::vector<Script>* scripts,
+      const std::vector<AddressFormatData>& network_parameters,
+      uint32_t thread_count);
+};
+
+/**
+ * @class Bech32Util
+ * @brief Bech32/Bech32m encoding utility for segwit address.
+ * @details The witness script is the locking script of the segwit address.
+ *     (witness version, program size, witness program)
+ */
+class CFD_CORE_EXPORT Bech32Util {
+ public:
+  //! maximum witness program size
+  static constexpr size_t kMaxWitnessProgramSize = 40;
+  //! maximum witness script size
+  static constexpr size_t kMaxWitnessScriptSize = kMaxWitnessProgramSize + 2;
+
+  /**
+   * @brief Encode a segwit address.
+   * @details Witness version 0 is bech32, and 1 or later is bech32m.
+   * @param[in] hrp             bech32 hrp
+   * @param[in] witness_script  witness script (locking script)
+   * @return segwit address
+   * @throws CfdException   If invalid hrp or witness script.
+   */
+  static std::string EncodeSegwitAddress(
+      const std::string& hrp, const ByteData& witness_script);
+  /**
+   * @brief Encode segwit addresses on the same hrp.
+   * @param[in] hrp                 bech32 hrp
+   * @param[in] witness_script_list witness script (locking script) list
+   * @return segwit address list
+   * @throws CfdException   If invalid hrp or witness script.
+   */
+  static std::vector<std::string> EncodeSegwitAddresses(
+      const std::string& hrp, const std::vector<ByteData>& witness_script_list);
+  /**
+   * @brief Decode a segwit address.
+   * @param[in] hrp             bech32 hrp
+   * @param[in] address         segwit address
+   * @param[out] witness_script witness script buffer
+   *     (kMaxWitnessScriptSize bytes is enough)
+   * @param[in] buffer_size     witness script buffer size
+   * @param[out] written        witness script size
+   * @retval true   success
+   * @retval false  invalid address
+   */
+  static bool DecodeSegwitAddress(
+      const std::string& hrp, const std::string& address,
+      uint8_t* witness_script, size_t buffer_size, size_t* written);
+  /**
+   * @brief Decode a segwit address with the hrp buffer.
+   * @details This function does not allocate memory or throw an exception.
+   * @param[in] hrp             bech32 hrp buffer
+   * @param[in] hrp_size        bech32 hrp size
+   * @param[in] address         segwit address
+   * @param[out] witness_script witness script buffer
+   *     (kMaxWitnessScriptSize bytes is enough)
+   * @param[in] buffer_size     witness script buffer size
+   * @param[out] written        witness script size
+   * @retval true   success
+   * @retval false  invalid address
+   */
+  static bool DecodeSegwitAddress(
+      const char* hrp, size_t hrp_size, const std::string& address,
+      uint8_t* witness_script, size_t buffer_size, size_t* written);
+
+#ifndef CFD_DISABLE_ELEMENTS
+  /**
+   * @brief Encode a blinded segwit address. (blech32/blech32m)
+   * @param[in] hrp               blech32 hrp
+   * @param[in] witness_script    witness script (locking script)
+   * @param[in] confidential_key  confidential key (compressed pubkey)
+   * @return blinded segwit address
+   * @throws CfdException   If invalid hrp, witness script or key.
+   */
+  static std::string EncodeBlindedSegwitAddress(
+      const std::string& hrp, const ByteData& witness_script,
+      const Pubkey& confidential_key);
+  /**
+   * @brief Decode a blinded segwit address. (blech32/blech32m)
+   * @param[in] hrp               blech32 hrp
+   * @param[in] address           blinded segwit address
+   * @param[out] witness_script   witness script buffer
+   *     (kMaxWitnessScriptSize bytes is enough)
+   * @param[in] buffer_size       witness script buffer size
+   * @param[out] written          witness script size
+   * @param[out] confidential_key confidential key buffer
+   *     (Pubkey::kCompressedPubkeySize bytes)
+   * @retval true   success
+   * @retval false  invalid address
+   */
+  static bool DecodeBlindedSegwitAddress(
+      const std::string& hrp, const std::string& address,
+      uint8_t* witness_script, size_t buffer_size, size_t* written,
+      uint8_t* confidential_key);
+#endif  // CFD_DISABLE_ELEMENTS
+
+ private:
+  Bech32Util();
+};
+
 }  // namespace core
 }  // namespace cfd
 
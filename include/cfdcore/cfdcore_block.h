@@ -60,12 +60,23 @@ class CFD_CORE_EXPORT Block {
    * @param[in] object    object
    */
   Block(const Block& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  Block(Block&& object) noexcept;
   /**
    * @brief copy constructor.
    * @param[in] object    object
    * @return object
    */
   Block& operator=(const Block& object);
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  Block& operator=(Block&& object) noexcept;
   /**
    * @brief Get a hex string.
    * @return hex string
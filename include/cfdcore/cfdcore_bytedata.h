@@ -8,7 +8,9 @@
 #ifndef CFD_CORE_INCLUDE_CFDCORE_CFDCORE_BYTEDATA_H_
 #define CFD_CORE_INCLUDE_CFDCORE_CFDCORE_BYTEDATA_H_
 
+#include <array>
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -19,10 +21,19 @@ namespace core {
 
 class ByteData160;
 class ByteData256;
+class ByteSpan;
+class Deserializer;
+class Serializer;
 
 /**
  * @class ByteData
  * @brief The variable size byte array data class.
+ * @details Data up to kInlineCapacity bytes is stored inline, and larger
+ *     data is held in a shared copy-on-write buffer. (The data pooled by
+ *     ScriptPool is held in the shared buffer regardless of the size.)
+ * @note ABI: the object layout differs from the older std::vector based
+ *     layout. Binaries that embed ByteData or the classes holding it
+ *     (Script, Txid, Block and so on) must be rebuilt with this header.
  */
 class CFD_CORE_EXPORT ByteData {
  public:
@@ -55,12 +66,29 @@ class CFD_CORE_EXPORT ByteData {
    * @param[in] single_byte    1-Byte data
    */
   explicit ByteData(const uint8_t single_byte);
+  /**
+   * @brief copy constructor.
+   * @details A large buffer is shared with the source object.
+   * @param[in] object    object
+   */
+  ByteData(const ByteData& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  ByteData(ByteData&& object) noexcept;
   /**
    * @brief copy constructor.
    * @param[in] object    object
    * @return object
    */
   ByteData& operator=(const ByteData& object);
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  ByteData& operator=(ByteData&& object) noexcept;
 
   /**
    * @brief Get a hex string.
@@ -129,7 +157,7 @@ class CFD_CORE_EXPORT ByteData {
    */
   template <class ByteDataClass>
   ByteData Join(const ByteDataClass& data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result = GetBytes();
     std::vector<uint8_t> insert_bytes = data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -156,7 +184,7 @@ class CFD_CORE_EXPORT ByteData {
    */
   template <class ByteDataClass>
   ByteData PushBack(const ByteDataClass& back_insert_data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result = GetBytes();
     std::vector<uint8_t> insert_bytes = back_insert_data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -169,7 +197,7 @@ class CFD_CORE_EXPORT ByteData {
    */
   template <class ByteDataClass>
   ByteData Concat(const ByteDataClass& data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result = GetBytes();
     std::vector<uint8_t> insert_bytes = data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -242,11 +270,59 @@ class CFD_CORE_EXPORT ByteData {
    */
   static bool IsLarge(const ByteData& source, const ByteData& destination);
 
+  /**
+   * @brief Maximum size of the data held without heap allocation.
+   * @details Scripts, pubkeys, hashes and signatures fit in this size.
+   */
+  static constexpr uint32_t kInlineCapacity = 40;
+
  private:
+  friend class ByteSpan;
+  friend class Deserializer;
+  friend class Serializer;
+  friend class ScriptPool;
+
+  /**
+   * @brief data size.
+   */
+  uint32_t size_;
+  /**
+   * @brief small buffer (use if shared_data_ is null).
+   */
+  uint8_t inline_data_[kInlineCapacity];
   /**
-   * @brief データbyte array.
+   * @brief shared buffer.
+   * @details Set if size_ > kInlineCapacity, or created by
+   *     CreateSharedData. The buffer is immutable while it is shared
+   *     (copy-on-write).
    */
-  std::vector<uint8_t> data_;
+  std::shared_ptr<std::vector<uint8_t>> shared_data_;
+
+  /**
+   * @brief Get the head address of the data.
+   * @return data address.
+   */
+  const uint8_t* GetDataAddress() const;
+  /**
+   * @brief Set the data.
+   * @param[in] buffer    Byte data buffer
+   * @param[in] size      Byte data size
+   */
+  void SetData(const uint8_t* buffer, size_t size);
+  /**
+   * @brief Append the data.
+   * @param[in] buffer    Byte data buffer
+   * @param[in] size      Byte data size
+   */
+  void AppendData(const uint8_t* buffer, size_t size);
+  /**
+   * @brief Create the data held in the shared buffer.
+   * @details The copies share the buffer even if the data is small.
+   * @param[in] buffer    Byte data buffer
+   * @param[in] size      Byte data size
+   * @return byte data
+   */
+  static ByteData CreateSharedData(const uint8_t* buffer, size_t size);
 };
 
 /**
@@ -277,6 +353,11 @@ class CFD_CORE_EXPORT ByteData160 {
    * @param[in] byte_data   Byte data
    */
   explicit ByteData160(const ByteData& byte_data);
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  ByteData160(const ByteData160& object);
   /**
    * @brief copy constructor.
    * @param[in] object    object
@@ -339,7 +420,7 @@ class CFD_CORE_EXPORT ByteData160 {
    */
   template <class ByteDataClass>
   ByteData Join(const ByteDataClass& data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result(data_.begin(), data_.end());
     std::vector<uint8_t> insert_bytes = data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -366,7 +447,7 @@ class CFD_CORE_EXPORT ByteData160 {
    */
   template <class ByteDataClass>
   ByteData PushBack(const ByteDataClass& back_insert_data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result(data_.begin(), data_.end());
     std::vector<uint8_t> insert_bytes = back_insert_data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -379,7 +460,7 @@ class CFD_CORE_EXPORT ByteData160 {
    */
   template <class ByteDataClass>
   ByteData Concat(const ByteDataClass& data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result(data_.begin(), data_.end());
     std::vector<uint8_t> insert_bytes = data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -412,10 +493,12 @@ class CFD_CORE_EXPORT ByteData160 {
   bool operator==(const ByteData160& object) const;
 
  private:
+  friend class Serializer;
+
   /**
    * @brief 20byte fixed data.
    */
-  std::vector<uint8_t> data_;
+  std::array<uint8_t, 20> data_;
 };
 
 /**
@@ -446,6 +529,11 @@ class CFD_CORE_EXPORT ByteData256 {
    * @param[in] byte_data   Byte data
    */
   explicit ByteData256(const ByteData& byte_data);
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  ByteData256(const ByteData256& object);
   /**
    * @brief copy constructor.
    * @param[in] object    object
@@ -508,7 +596,7 @@ class CFD_CORE_EXPORT ByteData256 {
    */
   template <class ByteDataClass>
   ByteData Join(const ByteDataClass& data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result(data_.begin(), data_.end());
     std::vector<uint8_t> insert_bytes = data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -535,7 +623,7 @@ class CFD_CORE_EXPORT ByteData256 {
    */
   template <class ByteDataClass>
   ByteData PushBack(const ByteDataClass& back_insert_data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result(data_.begin(), data_.end());
     std::vector<uint8_t> insert_bytes = back_insert_data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -548,7 +636,7 @@ class CFD_CORE_EXPORT ByteData256 {
    */
   template <class ByteDataClass>
   ByteData Concat(const ByteDataClass& data) const {
-    std::vector<uint8_t> result(data_);
+    std::vector<uint8_t> result(data_.begin(), data_.end());
     std::vector<uint8_t> insert_bytes = data.GetBytes();
     result.insert(result.end(), insert_bytes.begin(), insert_bytes.end());
     return ByteData(result);
@@ -581,10 +669,103 @@ class CFD_CORE_EXPORT ByteData256 {
   bool operator==(const ByteData256& object) const;
 
  private:
+  friend class Serializer;
+
   /**
    * @brief 32byte fixed data.
    */
-  std::vector<uint8_t> data_;
+  std::array<uint8_t, 32> data_;
+};
+
+/**
+ * @class ByteSpan
+ * @brief A non-owning view of a byte array.
+ * @details The view does not copy the data. The referenced buffer must
+ *     outlive the view and must not be modified while it is referenced.
+ */
+class CFD_CORE_EXPORT ByteSpan {
+ public:
+  /**
+   * @brief default constructor.
+   */
+  ByteSpan() : data_(nullptr), size_(0) {}
+  /**
+   * @brief constructor.
+   * @param[in] data    buffer
+   * @param[in] size    buffer size
+   */
+  ByteSpan(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+  /**
+   * @brief constructor.
+   * @param[in] vector  buffer
+   */
+  explicit ByteSpan(const std::vector<uint8_t>& vector)
+      : data_(vector.data()), size_(vector.size()) {}
+  /**
+   * @brief constructor.
+   * @param[in] byte_data   byte data
+   */
+  explicit ByteSpan(const ByteData& byte_data);
+
+  /**
+   * @brief Get the head address of the data.
+   * @return data address.
+   */
+  const uint8_t* data() const { return data_; }
+  /**
+   * @brief Get the data size.
+   * @return data size.
+   */
+  size_t size() const { return size_; }
+  /**
+   * @brief Check is data empty.
+   * @retval true   empty.
+   * @retval false  not empty.
+   */
+  bool empty() const { return size_ == 0; }
+  /**
+   * @brief Get the head iterator.
+   * @return head address.
+   */
+  const uint8_t* begin() const { return data_; }
+  /**
+   * @brief Get the tail iterator.
+   * @return tail address.
+   */
+  const uint8_t* end() const { return data_ + size_; }
+  /**
+   * @brief Get the byte at the index.
+   * @param[in] index   index
+   * @return byte
+   */
+  uint8_t operator[](size_t index) const { return data_[index]; }
+
+  /**
+   * @brief Get the partial view.
+   * @param[in] offset  offset
+   * @param[in] size    size
+   * @return partial view.
+   */
+  ByteSpan SubSpan(size_t offset, size_t size) const;
+  /**
+   * @brief Get a byte data object. (copy)
+   * @return byte data
+   */
+  ByteData GetData() const;
+  /**
+   * @brief Get a byte array. (copy)
+   * @return byte array.
+   */
+  std::vector<uint8_t> GetBytes() const;
+  /**
+   * @brief Get a hex string.
+   * @return hex string.
+   */
+  std::string GetHex() const;
+
+ private:
+  const uint8_t* data_;  //!< data address
+  size_t size_;          //!< data size
 };
 
 /**
@@ -612,6 +793,25 @@ class CFD_CORE_EXPORT Serializer {
    */
   static uint32_t GetVariableIntSize(uint64_t value);
 
+  /**
+   * @brief Create the serializer that only counts the serialize size.
+   * @return serializer object.
+   */
+  static Serializer CreateSizeCounter();
+  /**
+   * @brief Create the serializer that streams data into SHA-256.
+   * @details No intermediate buffer is used.
+   * @return serializer object.
+   */
+  static Serializer CreateSha256Sink();
+  /**
+   * @brief Create the serializer that streams data into tagged SHA-256.
+   * @details The hashed tag prefix (BIP-340) is processed at creation.
+   * @param[in] tag   tag string
+   * @return serializer object.
+   */
+  static Serializer CreateTaggedSha256Sink(const std::string& tag);
+
   /**
    * @brief constructor.
    */
@@ -621,6 +821,14 @@ class CFD_CORE_EXPORT Serializer {
    * @param[in] initial_size  initial buffer size.
    */
   explicit Serializer(uint32_t initial_size);
+  /**
+   * @brief constructor. (write to the caller buffer)
+   * @details The buffer is not owned by the serializer and is not grown.
+   *     Get the required size by the size counter in advance.
+   * @param[in] buffer        output buffer (caller buffer or arena)
+   * @param[in] buffer_size   output buffer size
+   */
+  Serializer(uint8_t* buffer, uint32_t buffer_size);
   /**
    * @brief destructor.
    */
@@ -755,16 +963,63 @@ class CFD_CORE_EXPORT Serializer {
    * @return byte array.
    */
   ByteData Output();
+  /**
+   * @brief Output SHA-256 of the serialized data.
+   * @details The sink mode returns the streamed hash. The buffer mode
+   *     hashes the written data without copying.
+   * @return SHA-256
+   */
+  ByteData256 OutputSha256();
+  /**
+   * @brief Output double SHA-256 of the serialized data.
+   * @return double SHA-256
+   */
+  ByteData256 OutputSha256d();
+  /**
+   * @brief get all write size.
+   * @return size (offset)
+   */
+  uint32_t GetWriteSize() const;
 
  protected:
+  //! output mode
+  enum OutputMode : uint8_t {
+    kOutputBuffer = 0,      //!< internal buffer
+    kOutputExternalBuffer,  //!< caller buffer
+    kOutputSizeCounter,     //!< count only
+    kOutputSha256,          //!< SHA-256 sink
+  };
+
   std::vector<uint8_t> buffer_;  //!< buffer
   uint32_t offset_;              //!< offset
+  OutputMode mode_;              //!< output mode
+  uint8_t* external_buffer_;     //!< caller buffer
+  uint32_t external_size_;       //!< caller buffer size
+  uint32_t hash_prefix_size_;    //!< hashed size at creation
+  uint32_t hash_state_[8];       //!< SHA-256 state
+  uint8_t hash_block_[64];       //!< SHA-256 pending block
 
+  /**
+   * @brief constructor.
+   * @param[in] mode  output mode
+   */
+  explicit Serializer(OutputMode mode);
   /**
    * @brief check need buffer size.
    * @param[in] need_size  need buffer size
    */
   void CheckNeedSize(uint32_t need_size);
+  /**
+   * @brief write bytes to the output.
+   * @param[in] buffer        buffer
+   * @param[in] buffer_size   buffer size
+   */
+  void WriteBytes(const uint8_t* buffer, uint32_t buffer_size);
+  /**
+   * @brief calculate SHA-256 of the serialized data.
+   * @param[out] hash   SHA-256 (32 bytes)
+   */
+  void CalculateSha256(uint8_t* hash) const;
 };
 
 /**
@@ -776,7 +1031,8 @@ class CFD_CORE_EXPORT Deserializer {
   /**
    * @brief constructor.
    */
-  Deserializer() : offset_(0) {}
+  Deserializer()
+      : buffer_(), offset_(0), read_data_(nullptr), read_size_(0) {}
   /**
    * @brief constructor.
    * @param[in] buffer     buffer
@@ -784,9 +1040,23 @@ class CFD_CORE_EXPORT Deserializer {
   explicit Deserializer(const std::vector<uint8_t>& buffer);
   /**
    * @brief constructor.
+   * @details The buffer is shared without copying.
    * @param[in] buffer     buffer
    */
   explicit Deserializer(const ByteData& buffer);
+  /**
+   * @brief constructor. (borrowed buffer)
+   * @details The buffer is not copied and must outlive the deserializer.
+   * @param[in] buffer     buffer
+   * @param[in] size       buffer size
+   */
+  Deserializer(const uint8_t* buffer, size_t size);
+  /**
+   * @brief constructor. (borrowed buffer)
+   * @details The buffer is not copied and must outlive the deserializer.
+   * @param[in] buffer     buffer
+   */
+  explicit Deserializer(const ByteSpan& buffer);
   /**
    * @brief destructor.
    */
@@ -852,6 +1122,40 @@ class CFD_CORE_EXPORT Deserializer {
    * @return buffer
    */
   ByteData ReadVariableData();
+  /**
+   * @brief read buffer without copying.
+   * @details The view refers to the deserializer buffer.
+   * @param[in] size   read size.
+   * @return buffer view
+   */
+  ByteSpan ReadSpan(uint32_t size);
+  /**
+   * @brief read variable buffer without copying.
+   * @details The view refers to the deserializer buffer.
+   * @return buffer view
+   */
+  ByteSpan ReadVariableSpan();
+  /**
+   * @brief read uint32 array.
+   * @param[out] output   uint32 array
+   * @param[in] count     read count
+   */
+  void ReadUint32Array(uint32_t* output, size_t count);
+  /**
+   * @brief read uint64 array.
+   * @param[out] output   uint64 array
+   * @param[in] count     read count
+   */
+  void ReadUint64Array(uint64_t* output, size_t count);
+  /**
+   * @brief skip the data.
+   * @param[in] size   skip size.
+   */
+  void Skip(uint32_t size);
+  /**
+   * @brief skip the variable buffer.
+   */
+  void SkipVariableBuffer();
 
   /**
    * @brief get all read size.
@@ -867,8 +1171,17 @@ class CFD_CORE_EXPORT Deserializer {
   bool HasEof();
 
  protected:
-  std::vector<uint8_t> buffer_;  //!< buffer
-  uint32_t offset_;              //!< offset
+  ByteData buffer_;           //!< buffer (empty if borrowed)
+  uint32_t offset_;           //!< offset
+  const uint8_t* read_data_;  //!< read target address
+  uint32_t read_size_;        //!< read target size
+
+  /**
+   * @brief set the read target.
+   * @param[in] buffer     buffer
+   * @param[in] size       buffer size
+   */
+  void SetReadData(const uint8_t* buffer, size_t size);
 
   /**
    * @brief check read offset size.
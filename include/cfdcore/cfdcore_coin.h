@@ -47,12 +47,23 @@ class CFD_CORE_EXPORT Txid {
    * @param[in] object    object
    */
   Txid(const Txid& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  Txid(Txid&& object) noexcept;
   /**
    * @brief copy constructor.
    * @param[in] object    object
    * @return object
    */
   Txid& operator=(const Txid& object);
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  Txid& operator=(Txid&& object) noexcept;
   /**
    * @brief Get a hex string.
    * @return hex string
@@ -113,12 +124,23 @@ class CFD_CORE_EXPORT BlockHash {
    * @param[in] object    object
    */
   BlockHash(const BlockHash& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  BlockHash(BlockHash&& object) noexcept;
   /**
    * @brief copy constructor.
    * @param[in] object    object
    * @return object
    */
   BlockHash& operator=(const BlockHash& object);
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  BlockHash& operator=(BlockHash&& object) noexcept;
   /**
    * @brief Get a hex string.
    * @return hex string
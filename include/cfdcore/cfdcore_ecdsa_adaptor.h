@@ -1,6 +1,7 @@
 // Copyright 2020 CryptoGarage
 
 #include <string>
+#include <vector>
 
 #include "cfdcore/cfdcore_bytedata.h"
 #include "cfdcore/cfdcore_common.h"
@@ -40,6 +41,45 @@ class CFD_CORE_EXPORT AdaptorSignature {
   static AdaptorSignature Encrypt(
       const ByteData256 &msg, const Privkey &sk, const Pubkey &encryption_key);
 
+  /**
+   * @brief Create adaptor signatures over the given messages using the same
+   * private key.
+   * @details The signatures are created on worker threads. The secret key
+   * is checked once and an invalid key throws. A failed item (e.g. an
+   * invalid encryption key) is left as an empty (invalid) signature
+   * instead of throwing.
+   *
+   * @param msgs the messages to create the signatures for.
+   * @param sk the secret key to create the signatures with.
+   * @param encryption_keys the adaptors to adapt the signatures with.
+   * @param thread_count worker thread count. (0: hardware concurrency)
+   * @return adaptor signature list. (same order as msgs)
+   */
+  static std::vector<AdaptorSignature> EncryptBatch(
+      const std::vector<ByteData256> &msgs, const Privkey &sk,
+      const std::vector<Pubkey> &encryption_keys, uint32_t thread_count = 0);
+
+  /**
+   * @brief Verify adaptor signatures for the same public key.
+   * @details The signatures are verified on worker threads. An invalid or
+   * unparsable item is reported in invalid_indexes instead of throwing.
+   *
+   * @param signatures the adaptor signatures.
+   * @param msgs the messages of the signatures.
+   * @param pubkey the public key of the signer.
+   * @param encryption_keys the adaptors of the signatures.
+   * @param invalid_indexes the indexes of the invalid signatures. (optional)
+   * @param thread_count worker thread count. (0: hardware concurrency)
+   * @retval true if all signatures are valid
+   * @retval false if any signature is invalid
+   */
+  static bool VerifyBatch(
+      const std::vector<AdaptorSignature> &signatures,
+      const std::vector<ByteData256> &msgs, const Pubkey &pubkey,
+      const std::vector<Pubkey> &encryption_keys,
+      std::vector<uint32_t> *invalid_indexes = nullptr,
+      uint32_t thread_count = 0);
+
   /**
    * @brief Construct a new Adaptor Signature object from ByteData
    *
@@ -59,12 +99,24 @@ class CFD_CORE_EXPORT AdaptorSignature {
    * @param signature the adaptor signature
    */
   AdaptorSignature(const AdaptorSignature &signature);
+  /**
+   * @brief Move constructor.
+   *
+   * @param signature the adaptor signature
+   */
+  AdaptorSignature(AdaptorSignature &&signature) noexcept;
   /**
    * @brief copy constructor.
    * @param signature the adaptor signature
    * @return adaptor signature object.
    */
   AdaptorSignature &operator=(const AdaptorSignature &signature) &;
+  /**
+   * @brief move assignment.
+   * @param signature the adaptor signature
+   * @return adaptor signature object.
+   */
+  AdaptorSignature &operator=(AdaptorSignature &&signature) & noexcept;
 
   /**
    * @brief "Decrypt" an adaptor signature using the provided secret, returning
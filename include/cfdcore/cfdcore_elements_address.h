@@ -58,6 +58,35 @@ class CFD_CORE_EXPORT ElementsConfidentialAddress {
    */
   static Privkey GetBlindingKey(
       const Privkey& master_blinding_key, const Script& locking_script);
+  /**
+   * @brief get default blinding keys.
+   * @details The HMAC key pads of the master blinding key are calculated
+   *     once and shared by all locking scripts.
+   * @param[in] master_blinding_key master blindingKey
+   * @param[in] locking_scripts     locking script list.
+   * @param[in] thread_count        worker thread count.
+   *     (0: use the hardware concurrency)
+   * @return blinding key list (same order as locking_scripts)
+   */
+  static std::vector<Privkey> GetBlindingKeys(
+      const Privkey& master_blinding_key,
+      const std::vector<Script>& locking_scripts, uint32_t thread_count = 0);
+
+  /**
+   * @brief Create confidential addresses.
+   * @details Use with AddressFactory::CreateBatch to create the unblinded
+   *     addresses.
+   * @param[in] unblinded_addresses   unblinded address list
+   * @param[in] confidential_keys     confidential key list
+   *     (same size as unblinded_addresses)
+   * @param[in] thread_count          worker thread count.
+   *     (0: use the hardware concurrency)
+   * @return confidential address list (same order as unblinded_addresses)
+   */
+  static std::vector<ElementsConfidentialAddress> CreateBatch(
+      const std::vector<Address>& unblinded_addresses,
+      const std::vector<ConfidentialKey>& confidential_keys,
+      uint32_t thread_count = 0);
 
   /**
    * @brief default constructor.
@@ -93,6 +122,11 @@ class CFD_CORE_EXPORT ElementsConfidentialAddress {
    * @param[in] object    object
    */
   ElementsConfidentialAddress(const ElementsConfidentialAddress& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  ElementsConfidentialAddress(ElementsConfidentialAddress&& object) noexcept;
   /**
    * @brief copy constructor.
    * @param[in] object    object
@@ -100,6 +134,13 @@ class CFD_CORE_EXPORT ElementsConfidentialAddress {
    */
   ElementsConfidentialAddress& operator=(
       const ElementsConfidentialAddress& object) &;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  ElementsConfidentialAddress& operator=(
+      ElementsConfidentialAddress&& object) & noexcept;
 
   /**
    * @brief Get UnblindedAddress
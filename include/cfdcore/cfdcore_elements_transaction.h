@@ -60,12 +60,23 @@ class CFD_CORE_EXPORT ConfidentialNonce {
    * @param[in] object    object
    */
   ConfidentialNonce(const ConfidentialNonce& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  ConfidentialNonce(ConfidentialNonce&& object) noexcept;
   /**
    * @brief copy constructor.
    * @param[in] object    object
    * @return object
    */
   ConfidentialNonce& operator=(const ConfidentialNonce& object);
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  ConfidentialNonce& operator=(ConfidentialNonce&& object) noexcept;
 
   /**
    * @brief Get byte data.
@@ -136,12 +147,23 @@ class CFD_CORE_EXPORT ConfidentialAssetId {
    * @param[in] object    object
    */
   ConfidentialAssetId(const ConfidentialAssetId& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  ConfidentialAssetId(ConfidentialAssetId&& object) noexcept;
   /**
    * @brief copy constructor.
    * @param[in] object    object
    * @return object
    */
   ConfidentialAssetId& operator=(const ConfidentialAssetId& object);
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  ConfidentialAssetId& operator=(ConfidentialAssetId&& object) noexcept;
 
   /**
    * @brief Get byte data.
@@ -232,12 +254,23 @@ class CFD_CORE_EXPORT ConfidentialValue {
    * @param[in] object    object
    */
   ConfidentialValue(const ConfidentialValue& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  ConfidentialValue(ConfidentialValue&& object) noexcept;
   /**
    * @brief copy constructor.
    * @param[in] object    object
    * @return object
    */
   ConfidentialValue& operator=(const ConfidentialValue& object);
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  ConfidentialValue& operator=(ConfidentialValue&& object) noexcept;
 
   /**
    * @brief Get byte data.
@@ -344,12 +377,23 @@ class CFD_CORE_EXPORT BlindFactor {
    * @param[in] object    object
    */
   BlindFactor(const BlindFactor& object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  BlindFactor(BlindFactor&& object) noexcept;
   /**
    * @brief copy constructor.
    * @param[in] object    object
    * @return object
    */
   BlindFactor& operator=(const BlindFactor& object);
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  BlindFactor& operator=(BlindFactor&& object) noexcept;
 
   /**
    * @brief Get byte data.
@@ -1093,6 +1137,12 @@ class CFD_CORE_EXPORT ConfidentialTransaction : public AbstractTransaction {
    * @param[in] transaction   transaction object
    */
   explicit ConfidentialTransaction(const ConfidentialTransaction& transaction);
+  /**
+   * @brief move constructor
+   * @details The moved-from object can only be assigned or destroyed.
+   * @param[in] transaction   transaction object
+   */
+  ConfidentialTransaction(ConfidentialTransaction&& transaction) noexcept;
   /**
    * @brief destructor
    */
@@ -1106,6 +1156,13 @@ class CFD_CORE_EXPORT ConfidentialTransaction : public AbstractTransaction {
    */
   ConfidentialTransaction& operator=(
       const ConfidentialTransaction& transaction) &;
+  /**
+   * @brief move assignment.
+   * @param[in] transaction   transaction object
+   * @return Confidential Transaction
+   */
+  ConfidentialTransaction& operator=(
+      ConfidentialTransaction&& transaction) & noexcept;
   /**
    * @brief Get TxIn.
    * @param[in] index   index
@@ -1618,6 +1675,15 @@ class CFD_CORE_EXPORT ConfidentialTransaction : public AbstractTransaction {
    */
   virtual uint32_t GetWallyFlag() const;
 
+  /**
+   * @brief Write the byte data of Transaction to the serializer.
+   * @details The data is written from the transaction without the
+   *     intermediate byte data.
+   * @param[in] has_witness       Flag to include witness
+   * @param[in,out] serializer    serializer
+   */
+  virtual void WriteByteData(bool has_witness, Serializer* serializer) const;
+
   /**
    * @brief Get Bitcoin Transaction information.
    * @param[in] bitcoin_tx_data     bitcoin transaction data
@@ -241,6 +241,21 @@ class CFD_CORE_EXPORT HDWallet {
   static bool CheckValidMnemonic(
       const std::vector<std::string>& mnemonic, const std::string& language);
 
+  /**
+   * @brief Generate seeds from multiple mnemonics.
+   * @details The PBKDF2 of all mnemonics is calculated together.
+   * @param[in] mnemonics               mnemonic vector list
+   * @param[in] passphrases             passphrase list (same count as mnemonics)
+   * @param[in] use_ideographic_space   Flag to separate with double-byte space
+   * @param[in] thread_count            worker thread count (0: auto)
+   * @return seed list
+   * @throws CfdException If the list count is unmatched.
+   */
+  static std::vector<ByteData> ConvertMnemonicToSeeds(
+      const std::vector<std::vector<std::string>>& mnemonics,
+      const std::vector<std::string>& passphrases,
+      bool use_ideographic_space = false, uint32_t thread_count = 0);
+
  private:
   ByteData seed_;  //!< seed
 
@@ -8,6 +8,7 @@
 #define CFD_CORE_INCLUDE_CFDCORE_CFDCORE_KEY_H_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -243,6 +244,9 @@ CFD_CORE_API void ClearCustomKeyFormatList();
 
 /**
  * @brief Data class representing PublicKey
+ * @note ABI: the object layout holds the parsed point cache, and the move
+ *     constructor and move assignment are added. Binaries that embed
+ *     Pubkey or the classes holding it must be rebuilt with this header.
  */
 class CFD_CORE_EXPORT Pubkey {
  public:
@@ -272,6 +276,30 @@ class CFD_CORE_EXPORT Pubkey {
    */
   explicit Pubkey(const std::string &hex_string);
 
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   */
+  Pubkey(const Pubkey &object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  Pubkey(Pubkey &&object) noexcept;
+
+  /**
+   * @brief copy constructor.
+   * @param[in] object    object
+   * @return object
+   */
+  Pubkey &operator=(const Pubkey &object);
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  Pubkey &operator=(Pubkey &&object) noexcept;
+
   /**
    * @brief Get HEX string.
    * @return HEX string.
@@ -457,10 +485,37 @@ class CFD_CORE_EXPORT Pubkey {
   Pubkey operator*=(const ByteData256 &right);
 
  private:
+  /**
+   * @brief parsed secp256k1 point.
+   */
+  struct PointCache;
+
   /**
    * @brief ByteData of PublicKey
    */
   ByteData data_;
+  /**
+   * @brief parsed point cache (lazily filled).
+   */
+  mutable std::shared_ptr<const PointCache> point_cache_;
+
+  /**
+   * @brief constructor with the parsed point.
+   * @param[in] byte_data     Public key ByteData instance
+   * @param[in] point_cache   parsed point of byte_data
+   */
+  Pubkey(
+      const ByteData &byte_data,
+      const std::shared_ptr<const PointCache> &point_cache);
+
+  /**
+   * @brief Get the parsed point.
+   * @details The point is parsed on the first call and shared
+   *     between the copied instances.
+   * @return parsed point
+   * @throw CfdException if the pubkey is not on the curve.
+   */
+  std::shared_ptr<const PointCache> GetPointCache() const;
 };
 
 /**
@@ -9,6 +9,7 @@
 #define CFD_CORE_INCLUDE_CFDCORE_CFDCORE_PSBT_H_
 
 #include <cstddef>
+#include <istream>
 #include <string>
 #include <vector>
 
@@ -176,6 +177,13 @@ class CFD_CORE_EXPORT Psbt {
    * @param[in] base64    base64 string.
    */
   explicit Psbt(const std::string& base64);
+  /**
+   * @brief constructor
+   * @details The stream is decoded in chunks and parsed without
+   *     the whole base64 string.
+   * @param[in] base64_stream   base64 string stream.
+   */
+  explicit Psbt(std::istream& base64_stream);
   /**
    * @brief constructor
    * @param[in] byte_data   byte data
@@ -197,6 +205,12 @@ class CFD_CORE_EXPORT Psbt {
    * @param[in] psbt   Psbt object.
    */
   Psbt(const Psbt& psbt);
+  /**
+   * @brief move constructor
+   * @details The moved-from object can only be assigned or destroyed.
+   * @param[in] psbt   Psbt object.
+   */
+  Psbt(Psbt&& psbt) noexcept;
   /**
    * @brief destructor
    */
@@ -208,6 +222,12 @@ class CFD_CORE_EXPORT Psbt {
    * @return Psbt object.
    */
   Psbt& operator=(const Psbt& psbt) &;
+  /**
+   * @brief move assignment.
+   * @param[in] psbt   Psbt object.
+   * @return Psbt object.
+   */
+  Psbt& operator=(Psbt&& psbt) & noexcept;
 
   /**
    * @brief Get base64 string.
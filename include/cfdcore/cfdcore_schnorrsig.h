@@ -226,12 +226,23 @@ class CFD_CORE_EXPORT SchnorrSignature {
    * @param[in] object the data representing the adaptor signature
    */
   SchnorrSignature(const SchnorrSignature &object);
+  /**
+   * @brief move constructor.
+   * @param[in] object the data representing the adaptor signature
+   */
+  SchnorrSignature(SchnorrSignature &&object) noexcept;
   /**
    * @brief copy constructor.
    * @param[in] object the data representing the adaptor signature
    * @return object
    */
   SchnorrSignature &operator=(const SchnorrSignature &object);
+  /**
+   * @brief move assignment.
+   * @param[in] object the data representing the adaptor signature
+   * @return object
+   */
+  SchnorrSignature &operator=(SchnorrSignature &&object) noexcept;
 
   /**
    * @brief Get the underlying ByteData object
@@ -363,6 +374,39 @@ class CFD_CORE_EXPORT SchnorrUtil {
       const std::vector<ByteData256> &msgs,
       const std::vector<SchnorrPubkey> &nonces, const SchnorrPubkey &pubkey);
 
+  /**
+   * @brief Compute the signature point of each message.
+   * @details The points are computed on worker threads. The result is the
+   *     per-digit point table for CombineSigPointList.
+   *
+   * @param msgs the set of messages that will be signed.
+   * @param nonces the public component of the nonces that will be used.
+   * @param pubkey the public key for which the signatures will be valid.
+   * @param thread_count worker thread count. (0: hardware concurrency)
+   * @return the signature point list.
+   */
+  static std::vector<Pubkey> ComputeSigPointList(
+      const std::vector<ByteData256> &msgs,
+      const std::vector<SchnorrPubkey> &nonces, const SchnorrPubkey &pubkey,
+      uint32_t thread_count = 0);
+
+  /**
+   * @brief Compute the sum of signature points for each outcome.
+   * @details Each outcome picks one point per digit from the table, and
+   *     can use only the leading digits (for a prefix of numeric outcomes).
+   *     The table is parsed once, and the outcomes are combined on worker
+   *     threads.
+   *
+   * @param digit_sig_points the signature points. ([digit][value])
+   * @param outcomes the digit values of each outcome. ([outcome][digit])
+   * @param thread_count worker thread count. (0: hardware concurrency)
+   * @return the signature point of each outcome.
+   */
+  static std::vector<Pubkey> CombineSigPointList(
+      const std::vector<std::vector<Pubkey>> &digit_sig_points,
+      const std::vector<std::vector<uint32_t>> &outcomes,
+      uint32_t thread_count = 0);
+
   /**
    * @brief Verify a Schnorr signature.
    *
@@ -375,6 +419,30 @@ class CFD_CORE_EXPORT SchnorrUtil {
   static bool Verify(
       const SchnorrSignature &signature, const ByteData256 &msg,
       const SchnorrPubkey &pubkey);
+
+  /**
+   * @brief Verify a set of Schnorr signatures.
+   * @details This runs N independent BIP340 verifications split across
+   *     worker threads, each with its own secp256k1 context. It is not the
+   *     BIP340 batch verification (one multi-scalar multiplication for all
+   *     signatures), which libsecp256k1 does not provide; the cost per
+   *     signature is the same as Verify. A run of the same pubkey is
+   *     parsed once.
+   *
+   * @param signatures the signatures to verify.
+   * @param msgs the messages to verify the signatures against.
+   * @param pubkeys the public keys to verify the signatures against.
+   * @param invalid_indexes the indexes of the invalid signatures. (optional)
+   * @param thread_count worker thread count. (0: hardware concurrency)
+   * @retval true if all signatures are valid
+   * @retval false if any signature is invalid
+   */
+  static bool VerifyBatch(
+      const std::vector<SchnorrSignature> &signatures,
+      const std::vector<ByteData256> &msgs,
+      const std::vector<SchnorrPubkey> &pubkeys,
+      std::vector<uint32_t> *invalid_indexes = nullptr,
+      uint32_t thread_count = 0);
 };
 
 // global operator overloading
@@ -10,7 +10,9 @@
 
 #include <cstddef>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "cfdcore/cfdcore_bytedata.h"
@@ -70,6 +72,22 @@ enum ScriptElementType {
   kElementNumber   //!< number
 };
 
+/**
+ * @brief standard locking script template type.
+ */
+enum StandardScriptType {
+  kNonStandardScript = 0,  //!< non standard script
+  kP2pkScript,             //!< pay to pubkey
+  kP2pkhScript,            //!< pay to pubkey hash
+  kP2shScript,             //!< pay to script hash
+  kMultisigScript,         //!< bare multisig
+  kP2wpkhScript,           //!< pay to witness pubkey hash
+  kP2wshScript,            //!< pay to witness script hash
+  kTaprootScript,          //!< taproot (segwit v1)
+  kWitnessUnknownScript,   //!< witness program of unknown version or size
+  kNullDataScript          //!< OP_RETURN with push only data
+};
+
 // clang-format off
 // @formatter:off
 /**
@@ -757,6 +775,11 @@ class CFD_CORE_EXPORT ScriptElement {
    * @param[in] element     object
    */
   ScriptElement(const ScriptElement &element);
+  /**
+   * @brief move constructor.
+   * @param[in] element     object
+   */
+  ScriptElement(ScriptElement &&element) noexcept;
   /**
    * @brief constructor.
    * @param[in] type     OP_CODE
@@ -795,6 +818,12 @@ class CFD_CORE_EXPORT ScriptElement {
    * @return object
    */
   ScriptElement &operator=(const ScriptElement &element);
+  /**
+   * @brief move assignment.
+   * @param[in] element     object
+   * @return object
+   */
+  ScriptElement &operator=(ScriptElement &&element) noexcept;
 
   /**
    * @brief Get the element type.
@@ -966,12 +995,23 @@ class CFD_CORE_EXPORT Script {
    * @param[in] object    object
    */
   Script(const Script &object);
+  /**
+   * @brief move constructor.
+   * @param[in] object    object
+   */
+  Script(Script &&object) noexcept;
   /**
    * @brief copy constructor.
    * @param[in] object    object
    * @return object
    */
   Script &operator=(const Script &object) &;
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  Script &operator=(Script &&object) & noexcept;
   /**
    * @brief get script.
    * @return script
@@ -1096,22 +1136,68 @@ class CFD_CORE_EXPORT Script {
    */
   WitnessVersion GetWitnessVersion() const;
 
+  /**
+   * @brief Classify the script by the standard templates.
+   * @details Matches the templates on the raw bytes, without decoding
+   *     the script elements.
+   * @param[out] payload    payload span (optional). It refers to the
+   *     script data of this object.
+   * @return standard script type.
+   * @see Script::Classify(const ByteSpan&, ByteSpan*)
+   */
+  StandardScriptType Classify(ByteSpan *payload = nullptr) const;
+
+  /**
+   * @brief Classify the script by the standard templates.
+   * @details The payload of each type is below.
+   *   - kP2pkScript: pubkey
+   *   - kP2pkhScript, kP2shScript, kP2wpkhScript: hash160
+   *   - kP2wshScript: sha256
+   *   - kTaprootScript: x-only pubkey
+   *   - kWitnessUnknownScript: witness program
+   *   - kMultisigScript: pubkey push area (between OP_m and OP_n)
+   *   - kNullDataScript: data after OP_RETURN
+   *   - kNonStandardScript: whole script
+   * @param[in] script      locking script.
+   * @param[out] payload    payload span (optional)
+   * @return standard script type.
+   */
+  static StandardScriptType Classify(
+      const ByteSpan &script, ByteSpan *payload = nullptr);
+
  private:
+  friend class ScriptPool;
+
   /// script byte data
   ByteData script_data_;
 
-  /// script stack
-  std::vector<ScriptElement> script_stack_;
+  /**
+   * @brief script stack.
+   * @details Decoded from script_data_ on the first access and shared
+   *     between copies. Accessed by the atomic shared_ptr functions.
+   */
+  mutable std::shared_ptr<const std::vector<ScriptElement>> script_stack_;
+
+  /// ignore script size check on decoding
+  bool ignore_size_check_;
 
   /// max byte size of script number
   static constexpr size_t kMaxScriptNumSize = 4;
 
   /**
-   * @brief set stack data.
+   * @brief get the script stack. (decode on the first access)
+   * @return script stack
+   */
+  const std::vector<ScriptElement> &GetStackData() const;
+
+  /**
+   * @brief decode stack data.
    * @param[in] bytedata            script byte array.
    * @param[in] ignore_size_check   ignore script size check.
+   * @return script stack
    */
-  void SetStackData(const ByteData &bytedata, bool ignore_size_check = false);
+  static std::vector<ScriptElement> DecodeStackData(
+      const ByteData &bytedata, bool ignore_size_check);
 
   /**
    * @brief Convert byte array to number.
@@ -1119,7 +1205,110 @@ class CFD_CORE_EXPORT Script {
    * @return converted number value
    * @see https://github.com/bitcoin/bitcoin/blob/c799976c86e2d65f129d106724fbefbf665d63d4/src/script/script.h#L359 // NOLINT
    */
-  int64_t ConvertToNumber(const std::vector<uint8_t> bytes);
+  static int64_t ConvertToNumber(const std::vector<uint8_t> &bytes);
+};
+
+/**
+ * @brief script interning pool.
+ * @details Identical script byte data is held once in the pool.
+ *     The scripts returned from the pool share the byte buffer (even if the
+ *     script is smaller than ByteData::kInlineCapacity) and the decoded
+ *     script stack, by the reference count. So the returned scripts are
+ *     valid after the pool is cleared or destroyed.
+ *     The script stack is decoded on the first access as usual.
+ *     The pool can be shared between threads.
+ */
+class CFD_CORE_EXPORT ScriptPool {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] max_size    maximum number of scripts (0 is unlimited).
+   *     If the pool is full, a script that is not in the pool is returned
+   *     without interning.
+   */
+  explicit ScriptPool(size_t max_size = 0);
+  /**
+   * @brief destructor.
+   */
+  virtual ~ScriptPool() {
+    // do nothing
+  }
+
+  /**
+   * @brief Get the interned script.
+   * @param[in] script_data   script byte data.
+   * @return script (shares the data with the pooled script)
+   */
+  Script Intern(const ByteSpan &script_data);
+  /**
+   * @brief Get the interned script.
+   * @param[in] script    script.
+   * @return script (shares the data with the pooled script)
+   */
+  Script Intern(const Script &script);
+
+  /**
+   * @brief Get the number of the pooled scripts.
+   * @return pooled script count.
+   */
+  size_t GetSize() const;
+  /**
+   * @brief Get the number of the Intern calls.
+   * @return intern count.
+   */
+  uint64_t GetInternCount() const;
+  /**
+   * @brief Get the number of the Intern calls that found a pooled script.
+   * @return hit count.
+   */
+  uint64_t GetHitCount() const;
+  /**
+   * @brief Get the total byte size of the pooled scripts.
+   * @return total byte size.
+   */
+  uint64_t GetByteSize() const;
+  /**
+   * @brief Remove all pooled scripts.
+   */
+  void Clear();
+
+ private:
+  /**
+   * @brief hash function of the script byte data.
+   */
+  struct ScriptDataHash {
+    /**
+     * @brief get the hash value.
+     * @param[in] data    script byte data.
+     * @return hash value.
+     */
+    size_t operator()(const ByteSpan &data) const;
+  };
+  /**
+   * @brief equal function of the script byte data.
+   */
+  struct ScriptDataEqual {
+    /**
+     * @brief compare the script byte data.
+     * @param[in] lhs    script byte data.
+     * @param[in] rhs    script byte data.
+     * @retval true   equal.
+     * @retval false  not equal.
+     */
+    bool operator()(const ByteSpan &lhs, const ByteSpan &rhs) const;
+  };
+
+  mutable std::mutex mutex_;  //!< exclusive control object
+  size_t max_size_;           //!< maximum number of scripts
+  uint64_t intern_count_;     //!< intern count
+  uint64_t hit_count_;        //!< hit count
+  uint64_t byte_size_;        //!< total byte size
+  /**
+   * @brief pooled scripts.
+   * @details The key refers to the shared buffer of the pooled script.
+   */
+  std::unordered_map<ByteSpan, Script, ScriptDataHash, ScriptDataEqual>
+      scripts_;
 };
 
 /**
@@ -1146,6 +1335,13 @@ class CFD_CORE_EXPORT ScriptBuilder {
    * @return script builder object.
    */
   ScriptBuilder &AppendString(const std::string &message);
+  /**
+   * @brief append the ASM string.
+   * @details Each whitespace separated token is appended as AppendString.
+   * @param[in] asm_string  ASM string. (ex. "OP_DUP OP_HASH160 0x1234...")
+   * @return script builder object.
+   */
+  ScriptBuilder &AppendAsm(const std::string &asm_string);
   /**
    * @brief append script operator.
    * @param[in] type      ScriptType.
@@ -0,0 +1,432 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_script_interpreter.h
+ *
+ * @brief Script interpreter for local spend validation.
+ */
+#ifndef CFD_CORE_INCLUDE_CFDCORE_CFDCORE_SCRIPT_INTERPRETER_H_
+#define CFD_CORE_INCLUDE_CFDCORE_CFDCORE_SCRIPT_INTERPRETER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cfdcore/cfdcore_amount.h"
+#include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_common.h"
+#include "cfdcore/cfdcore_script.h"
+#include "cfdcore/cfdcore_transaction.h"
+#include "cfdcore/cfdcore_transaction_common.h"
+#include "cfdcore/cfdcore_util.h"
+
+namespace cfd {
+namespace core {
+
+/**
+ * @brief script verification flags.
+ * @details The bit values are the same as the bitcoin core.
+ */
+enum ScriptVerifyFlag : uint32_t {
+  kScriptVerifyNone = 0,                     //!< none
+  kScriptVerifyP2sh = (1U << 0),             //!< BIP16
+  kScriptVerifyStrictEnc = (1U << 1),        //!< strict encoding
+  kScriptVerifyDerSig = (1U << 2),           //!< BIP66
+  kScriptVerifyLowS = (1U << 3),             //!< low S value
+  kScriptVerifyNullDummy = (1U << 4),        //!< BIP147
+  kScriptVerifySigPushOnly = (1U << 5),      //!< push only scriptSig
+  kScriptVerifyMinimalData = (1U << 6),      //!< minimal push and number
+  kScriptVerifyDiscourageUpgradableNops = (1U << 7),  //!< upgradable NOPs
+  kScriptVerifyCleanStack = (1U << 8),                //!< clean stack
+  kScriptVerifyCheckLockTimeVerify = (1U << 9),       //!< BIP65
+  kScriptVerifyCheckSequenceVerify = (1U << 10),      //!< BIP112
+  kScriptVerifyWitness = (1U << 11),                  //!< BIP141
+  //! upgradable witness program
+  kScriptVerifyDiscourageUpgradableWitnessProgram = (1U << 12),
+  kScriptVerifyMinimalIf = (1U << 13),          //!< minimal IF argument
+  kScriptVerifyNullFail = (1U << 14),           //!< empty failed signature
+  kScriptVerifyWitnessPubkeyType = (1U << 15),  //!< compressed witness key
+  kScriptVerifyConstScriptCode = (1U << 16),    //!< no FindAndDelete
+  kScriptVerifyTaproot = (1U << 17),            //!< BIP341, BIP342
+  //! upgradable taproot leaf version
+  kScriptVerifyDiscourageUpgradableTaprootVersion = (1U << 18),
+  kScriptVerifyDiscourageOpSuccess = (1U << 19),  //!< OP_SUCCESSx
+  //! upgradable tapscript pubkey type
+  kScriptVerifyDiscourageUpgradablePubkeyType = (1U << 20),
+};
+
+//! consensus rule flags (soft forks up to taproot)
+constexpr uint32_t kScriptVerifyConsensusFlags =
+    kScriptVerifyP2sh | kScriptVerifyDerSig | kScriptVerifyNullDummy |
+    kScriptVerifyCheckLockTimeVerify | kScriptVerifyCheckSequenceVerify |
+    kScriptVerifyWitness | kScriptVerifyTaproot;
+
+//! standard policy flags
+constexpr uint32_t kScriptVerifyStandardFlags =
+    kScriptVerifyConsensusFlags | kScriptVerifyStrictEnc |
+    kScriptVerifyMinimalData | kScriptVerifyDiscourageUpgradableNops |
+    kScriptVerifyCleanStack | kScriptVerifyMinimalIf |
+    kScriptVerifyNullFail | kScriptVerifyLowS |
+    kScriptVerifyDiscourageUpgradableWitnessProgram |
+    kScriptVerifyWitnessPubkeyType | kScriptVerifyConstScriptCode |
+    kScriptVerifyDiscourageUpgradableTaprootVersion |
+    kScriptVerifyDiscourageOpSuccess |
+    kScriptVerifyDiscourageUpgradablePubkeyType;
+
+/**
+ * @brief script verification error.
+ */
+enum ScriptError {
+  kScriptErrOk = 0,                   //!< success
+  kScriptErrUnknown,                  //!< unknown error
+  kScriptErrEvalFalse,                //!< false on the stack top
+  kScriptErrOpReturn,                 //!< OP_RETURN
+  kScriptErrScriptSize,               //!< script size
+  kScriptErrPushSize,                 //!< push size
+  kScriptErrOpCount,                  //!< operation count
+  kScriptErrStackSize,                //!< stack size
+  kScriptErrSigCount,                 //!< signature count
+  kScriptErrPubkeyCount,              //!< pubkey count
+  kScriptErrVerify,                   //!< OP_VERIFY
+  kScriptErrEqualVerify,              //!< OP_EQUALVERIFY
+  kScriptErrCheckMultisigVerify,      //!< OP_CHECKMULTISIGVERIFY
+  kScriptErrCheckSigVerify,           //!< OP_CHECKSIGVERIFY
+  kScriptErrNumEqualVerify,           //!< OP_NUMEQUALVERIFY
+  kScriptErrBadOpcode,                //!< bad opcode
+  kScriptErrDisabledOpcode,           //!< disabled opcode
+  kScriptErrInvalidStackOperation,    //!< stack operation
+  kScriptErrInvalidAltstackOperation, //!< altstack operation
+  kScriptErrUnbalancedConditional,    //!< unbalanced conditional
+  kScriptErrNegativeLocktime,         //!< negative locktime
+  kScriptErrUnsatisfiedLocktime,      //!< unsatisfied locktime
+  kScriptErrSigHashType,              //!< signature hash type
+  kScriptErrSigDer,                   //!< signature DER encoding
+  kScriptErrMinimalData,              //!< minimal data
+  kScriptErrSigPushOnly,              //!< scriptSig is not push only
+  kScriptErrSigHighS,                 //!< high S value
+  kScriptErrSigNullDummy,             //!< CHECKMULTISIG dummy
+  kScriptErrPubkeyType,               //!< pubkey type
+  kScriptErrCleanStack,               //!< clean stack
+  kScriptErrMinimalIf,                //!< minimal IF argument
+  kScriptErrSigNullFail,              //!< failed signature is not empty
+  kScriptErrDiscourageUpgradableNops,  //!< upgradable NOPs
+  //! upgradable witness program
+  kScriptErrDiscourageUpgradableWitnessProgram,
+  //! upgradable taproot leaf version
+  kScriptErrDiscourageUpgradableTaprootVersion,
+  kScriptErrDiscourageOpSuccess,  //!< OP_SUCCESSx
+  //! upgradable tapscript pubkey type
+  kScriptErrDiscourageUpgradablePubkeyType,
+  kScriptErrWitnessProgramWrongLength,  //!< witness program length
+  kScriptErrWitnessProgramWitnessEmpty, //!< empty witness
+  kScriptErrWitnessProgramMismatch,     //!< witness program mismatch
+  kScriptErrWitnessMalleated,           //!< scriptSig on native witness
+  kScriptErrWitnessMalleatedP2sh,       //!< scriptSig on P2SH witness
+  kScriptErrWitnessUnexpected,          //!< unexpected witness
+  kScriptErrWitnessPubkeyType,          //!< uncompressed witness key
+  kScriptErrSchnorrSigSize,             //!< schnorr signature size
+  kScriptErrSchnorrSigHashType,         //!< schnorr signature hash type
+  kScriptErrSchnorrSig,                 //!< schnorr signature
+  kScriptErrTaprootWrongControlSize,    //!< control block size
+  kScriptErrTapscriptValidationWeight,  //!< validation weight
+  kScriptErrTapscriptCheckMultisig,     //!< CHECKMULTISIG on tapscript
+  kScriptErrTapscriptMinimalIf,         //!< minimal IF on tapscript
+  kScriptErrOpCodeSeparator,            //!< OP_CODESEPARATOR
+  kScriptErrSigFindAndDelete,           //!< signature in scriptCode
+};
+
+/**
+ * @brief signature version.
+ */
+enum SigVersion {
+  kSigVersionBase = 0,   //!< legacy and P2SH
+  kSigVersionWitnessV0,  //!< segwit v0 (BIP143)
+  kSigVersionTaproot,    //!< taproot key path (BIP341)
+  kSigVersionTapscript,  //!< tapscript (BIP342)
+};
+
+/**
+ * @brief script execution data on taproot.
+ */
+struct ScriptExecutionData {
+  TapScriptData tap_script;          //!< tapleaf hash, OP_CODESEPARATOR pos
+  bool has_annex = false;            //!< annex flag
+  ByteData annex;                    //!< annex
+  int64_t validation_weight_left = 0;  //!< tapscript validation weight
+};
+
+/**
+ * @brief Signature hash context.
+ * @details Keeps the transaction data and the hashes shared by all inputs
+ *     (BIP143, BIP341). The object is not changed after the construction,
+ *     so it can be used from multiple threads.
+ */
+class CFD_CORE_EXPORT SigHashContext {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] transaction   transaction
+   * @param[in] utxo_list     spent outputs (same order as txin).
+   *     If empty, the amount and taproot data are not available.
+   */
+  explicit SigHashContext(
+      const Transaction& transaction,
+      const std::vector<TxOut>& utxo_list = std::vector<TxOut>());
+
+  /**
+   * @brief Get the txin count.
+   * @return txin count
+   */
+  uint32_t GetTxInCount() const;
+  /**
+   * @brief Get the txin.
+   * @param[in] txin_index  txin index
+   * @return txin
+   */
+  const TxInReference& GetTxIn(uint32_t txin_index) const;
+  /**
+   * @brief Check if the spent outputs exist.
+   * @retval true   exist
+   * @retval false  not exist
+   */
+  bool HasUtxo() const;
+  /**
+   * @brief Get the spent output.
+   * @param[in] txin_index  txin index
+   * @return spent output
+   */
+  const TxOut& GetUtxo(uint32_t txin_index) const;
+  /**
+   * @brief Get the transaction version.
+   * @return version
+   */
+  int32_t GetVersion() const;
+  /**
+   * @brief Get the transaction locktime.
+   * @return locktime
+   */
+  uint32_t GetLockTime() const;
+
+  /**
+   * @brief Get the signature hash for ECDSA.
+   * @param[in] txin_index    txin index
+   * @param[in] script_code   script code
+   * @param[in] sighash_type  sighash type
+   * @param[in] value         txin amount (witness v0 only)
+   * @param[in] version       witness version (kVersionNone or kVersion0)
+   * @return signature hash
+   */
+  ByteData256 GetSignatureHash(
+      uint32_t txin_index, const ByteData& script_code,
+      const SigHashType& sighash_type, const Amount& value = Amount(),
+      WitnessVersion version = WitnessVersion::kVersionNone) const;
+
+  /**
+   * @brief Get the signature hash for schnorr.
+   * @param[in] txin_index    txin index
+   * @param[in] sighash_type  sighash type
+   * @param[in] script_data   tapscript data (key path: nullptr)
+   * @param[in] annex         annex data
+   * @return signature hash
+   */
+  ByteData256 GetSchnorrSignatureHash(
+      uint32_t txin_index, const SigHashType& sighash_type,
+      const TapScriptData* script_data = nullptr,
+      const ByteData& annex = ByteData()) const;
+
+ private:
+  int32_t version_;                          ///< transaction version
+  uint32_t lock_time_;                       ///< transaction locktime
+  std::vector<TxInReference> txin_list_;     ///< txin list
+  std::vector<TxOutReference> txout_list_;   ///< txout list
+  std::vector<TxOut> utxo_list_;             ///< spent output list
+  ByteData256 prevouts_hash_;    ///< sha256 of all outpoints
+  ByteData256 sequences_hash_;   ///< sha256 of all sequences
+  ByteData256 outputs_hash_;     ///< sha256 of all outputs
+  ByteData256 amounts_hash_;     ///< sha256 of all spent amounts
+  ByteData256 scripts_hash_;     ///< sha256 of all spent scripts
+  ByteData256 prevouts_hash256_;   ///< double sha256 of all outpoints
+  ByteData256 sequences_hash256_;  ///< double sha256 of all sequences
+  ByteData256 outputs_hash256_;    ///< double sha256 of all outputs
+
+  /**
+   * @brief check txin index.
+   * @param[in] txin_index  txin index
+   */
+  void CheckTxInIndex(uint32_t txin_index) const;
+};
+
+/**
+ * @brief Signature checker interface for the script interpreter.
+ * @details The default implementation fails all checks.
+ */
+class CFD_CORE_EXPORT SignatureChecker {
+ public:
+  /**
+   * @brief destructor.
+   */
+  virtual ~SignatureChecker() {
+    // do nothing
+  }
+  /**
+   * @brief Check the ECDSA signature.
+   * @param[in] signature     signature (DER + sighash type)
+   * @param[in] pubkey        pubkey
+   * @param[in] script_code   script code
+   * @param[in] version       signature version
+   * @retval true   valid
+   * @retval false  invalid
+   */
+  virtual bool CheckEcdsaSignature(
+      const std::vector<uint8_t>& signature,
+      const std::vector<uint8_t>& pubkey,
+      const std::vector<uint8_t>& script_code, SigVersion version) const;
+  /**
+   * @brief Check the schnorr signature.
+   * @param[in] signature     signature (64 or 65 bytes)
+   * @param[in] pubkey        x-only pubkey
+   * @param[in] version       signature version
+   * @param[in] exec_data     execution data
+   * @param[out] error        error
+   * @retval true   valid
+   * @retval false  invalid
+   */
+  virtual bool CheckSchnorrSignature(
+      const std::vector<uint8_t>& signature,
+      const std::vector<uint8_t>& pubkey, SigVersion version,
+      const ScriptExecutionData& exec_data, ScriptError* error) const;
+  /**
+   * @brief Check the locktime. (OP_CHECKLOCKTIMEVERIFY)
+   * @param[in] lock_time   locktime on the script
+   * @retval true   satisfied
+   * @retval false  unsatisfied
+   */
+  virtual bool CheckLockTime(int64_t lock_time) const;
+  /**
+   * @brief Check the sequence. (OP_CHECKSEQUENCEVERIFY)
+   * @param[in] sequence    sequence on the script
+   * @retval true   satisfied
+   * @retval false  unsatisfied
+   */
+  virtual bool CheckSequence(int64_t sequence) const;
+};
+
+/**
+ * @brief Signature checker for the transaction input.
+ */
+class CFD_CORE_EXPORT TransactionSignatureChecker : public SignatureChecker {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] context       signature hash context
+   * @param[in] txin_index    txin index
+   */
+  TransactionSignatureChecker(
+      const SigHashContext* context, uint32_t txin_index);
+  /**
+   * @brief destructor.
+   */
+  virtual ~TransactionSignatureChecker() {
+    // do nothing
+  }
+
+  virtual bool CheckEcdsaSignature(
+      const std::vector<uint8_t>& signature,
+      const std::vector<uint8_t>& pubkey,
+      const std::vector<uint8_t>& script_code, SigVersion version) const;
+  virtual bool CheckSchnorrSignature(
+      const std::vector<uint8_t>& signature,
+      const std::vector<uint8_t>& pubkey, SigVersion version,
+      const ScriptExecutionData& exec_data, ScriptError* error) const;
+  virtual bool CheckLockTime(int64_t lock_time) const;
+  virtual bool CheckSequence(int64_t sequence) const;
+
+ private:
+  const SigHashContext* context_;  ///< signature hash context
+  uint32_t txin_index_;            ///< txin index
+};
+
+/**
+ * @brief Script interpreter.
+ * @details Verifies legacy, P2SH, segwit v0 and taproot (BIP341, BIP342)
+ *     spends with the rules of the bitcoin core.
+ */
+class CFD_CORE_EXPORT ScriptInterpreter {
+ public:
+  /**
+   * @brief Execute the script.
+   * @param[in,out] stack   script stack
+   * @param[in] script      script
+   * @param[in] flags       verification flags (ScriptVerifyFlag)
+   * @param[in] checker     signature checker
+   * @param[in] version     signature version (base or witness v0)
+   * @param[out] error      error
+   * @retval true   success
+   * @retval false  failed
+   */
+  static bool EvalScript(
+      std::vector<ByteData>* stack, const Script& script, uint32_t flags,
+      const SignatureChecker& checker,
+      SigVersion version = SigVersion::kSigVersionBase,
+      ScriptError* error = nullptr);
+
+  /**
+   * @brief Verify the unlocking script, witness and locking script.
+   * @param[in] unlocking_script  unlocking script (scriptSig)
+   * @param[in] locking_script    locking script (scriptPubkey)
+   * @param[in] witness           witness stack
+   * @param[in] flags             verification flags (ScriptVerifyFlag)
+   * @param[in] checker           signature checker
+   * @param[out] error            error
+   * @retval true   valid
+   * @retval false  invalid
+   */
+  static bool VerifyScript(
+      const Script& unlocking_script, const Script& locking_script,
+      const ScriptWitness& witness, uint32_t flags,
+      const SignatureChecker& checker, ScriptError* error = nullptr);
+
+  /**
+   * @brief Verify the transaction input.
+   * @param[in] context       signature hash context (with utxo)
+   * @param[in] txin_index    txin index
+   * @param[in] flags         verification flags (ScriptVerifyFlag)
+   * @param[out] error        error
+   * @retval true   valid
+   * @retval false  invalid
+   */
+  static bool VerifyInput(
+      const SigHashContext& context, uint32_t txin_index, uint32_t flags,
+      ScriptError* error = nullptr);
+
+  /**
+   * @brief Verify all inputs of the transaction.
+   * @details The inputs are verified on worker threads.
+   * @param[in] transaction     transaction
+   * @param[in] utxo_list       spent outputs (same order as txin)
+   * @param[in] flags           verification flags (ScriptVerifyFlag)
+   * @param[out] error_list     error of each input
+   * @param[in] thread_count    worker thread count (0: hardware concurrency)
+   * @retval true   all inputs are valid
+   * @retval false  invalid input exists
+   */
+  static bool VerifyTransaction(
+      const Transaction& transaction, const std::vector<TxOut>& utxo_list,
+      uint32_t flags, std::vector<ScriptError>* error_list = nullptr,
+      uint32_t thread_count = 0);
+
+  /**
+   * @brief Get the error message.
+   * @param[in] error   error
+   * @return error message
+   */
+  static std::string GetErrorString(ScriptError error);
+
+ private:
+  ScriptInterpreter();
+};
+
+}  // namespace core
+}  // namespace cfd
+
+#endif  // CFD_CORE_INCLUDE_CFDCORE_CFDCORE_SCRIPT_INTERPRETER_H_
@@ -49,6 +49,11 @@ class CFD_CORE_EXPORT TapBranch {
    * @param[in] branch    branch object
    */
   TapBranch(const TapBranch& branch);
+  /**
+   * @brief move constructor.
+   * @param[in] branch    branch object
+   */
+  TapBranch(TapBranch&& branch) noexcept;
   /**
    * @brief destructor.
    */
@@ -59,6 +64,12 @@ class CFD_CORE_EXPORT TapBranch {
    * @return object
    */
   TapBranch& operator=(const TapBranch& object);
+  /**
+   * @brief move assignment.
+   * @param[in] object    object
+   * @return object
+   */
+  TapBranch& operator=(TapBranch&& object) noexcept;
 
   /**
    * @brief Add branch.
@@ -284,6 +295,11 @@ class CFD_CORE_EXPORT TaprootScriptTree : public TapBranch {
    * @param[in] tap_tree    tree object
    */
   TaprootScriptTree(const TaprootScriptTree& tap_tree);
+  /**
+   * @brief move constructor.
+   * @param[in] tap_tree    tree object
+   */
+  TaprootScriptTree(TaprootScriptTree&& tap_tree) noexcept;
   /**
    * @brief destructor.
    */
@@ -294,6 +310,12 @@ class CFD_CORE_EXPORT TaprootScriptTree : public TapBranch {
    * @return object
    */
   TaprootScriptTree& operator=(const TaprootScriptTree& object) &;
+  /**
+   * @brief move assignment.
+   * @param[in] object    tree object
+   * @return object
+   */
+  TaprootScriptTree& operator=(TaprootScriptTree&& object) & noexcept;
 
   using TapBranch::AddBranch;
   /**
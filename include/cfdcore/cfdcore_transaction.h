@@ -199,6 +199,13 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
    * @param[in] byte_data   tx byte data
    */
   explicit Transaction(const ByteData& byte_data);
+  /**
+   * @brief constructor
+   * @details The locking scripts of TxOut are interned by the script pool.
+   * @param[in] byte_data     tx byte data
+   * @param[in] script_pool   script pool (nullptr is not interned)
+   */
+  explicit Transaction(const ByteData& byte_data, ScriptPool* script_pool);
   /**
    * @brief constructor
    * @param[in] hex_string    HEX string
@@ -209,6 +216,12 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
    * @param[in] transaction   transaction object.
    */
   Transaction(const Transaction& transaction);
+  /**
+   * @brief move constructor.
+   * @details The moved-from object can only be assigned or destroyed.
+   * @param[in] transaction   transaction object.
+   */
+  Transaction(Transaction&& transaction) noexcept;
   /**
    * @brief destructor.
    */
@@ -221,6 +234,12 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
    * @return transaction object.
    */
   Transaction& operator=(const Transaction& transaction) &;
+  /**
+   * @brief move assignment.
+   * @param[in] transaction   transaction object.
+   * @return transaction object.
+   */
+  Transaction& operator=(Transaction&& transaction) & noexcept;
 
   /**
    * @brief Get the total byte size of Transaction.
@@ -448,6 +467,15 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
    */
   virtual uint32_t GetWallyFlag() const;
 
+  /**
+   * @brief Write the byte data of Transaction to the serializer.
+   * @details The data is written from the transaction without the
+   *     intermediate byte data.
+   * @param[in] has_witness       Flag to include witness
+   * @param[in,out] serializer    serializer
+   */
+  virtual void WriteByteData(bool has_witness, Serializer* serializer) const;
+
  protected:
   std::vector<TxIn> vin_;    ///< TxIn array
   std::vector<TxOut> vout_;  ///< TxOut array
@@ -457,6 +485,12 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
    * @param[in] hex_string    HEX string of Transaction byte data
    */
   void SetFromHex(const std::string& hex_string);
+  /**
+   * @brief Set Transaction information from byte data.
+   * @param[in] data          Transaction byte data
+   * @param[in] script_pool   script pool for TxOut locking script (optional)
+   */
+  void SetFromBytes(const ByteSpan& data, ScriptPool* script_pool = nullptr);
 
  private:
   /**
@@ -499,24 +533,6 @@ class CFD_CORE_EXPORT Transaction : public AbstractTransaction {
    * @return ByteData
    */
   ByteData GetByteData(bool has_witness) const;
-  /**
-   * @brief Check the consistency of ByteData in the TxOut area and set to TxOut.
-   *
-   * Set to TxOut only if tx_pointer is not NULL.
-   * If tx_pointer is NULL, only consistency check is performed.
-   * @param[in] buffer         ByteData in the TxOut area
-   * @param[in] buf_size       ByteData size in the TxOut area
-   * @param[in] txout_num      Number of TxOut information in the TxOut area
-   * @param[in] txout_num_size TxOut information area size
-   * @param[out] tx_pointer    Transaction information buffer (nullable)
-   * @param[out] txout_list    TxOut array (nullable)
-   * @retval true   Consistency check OK, TxOut information copy OK
-   * @retval false  Consistency check NG or TxOut information copy failure
-   */
-  static bool CheckTxOutBuffer(
-      const uint8_t* buffer, size_t buf_size, uint64_t txout_num,
-      size_t txout_num_size, void* tx_pointer = nullptr,
-      std::vector<TxOut>* txout_list = nullptr);
 };
 
 }  // namespace core
@@ -557,6 +557,14 @@ class CFD_CORE_EXPORT AbstractTransaction {
    * @return byte data
    */
   virtual ByteData GetData() const;
+  /**
+   * @brief Write the byte data of Transaction to the serializer.
+   * @details Use the size counter serializer to get the required size,
+   *     and the caller buffer serializer to write without allocation.
+   * @param[in] has_witness       Flag to include witness
+   * @param[in,out] serializer    serializer
+   */
+  virtual void WriteByteData(bool has_witness, Serializer* serializer) const;
   /**
    * @brief Get the byte data of Transaction by converting to HEX character string.
    * @return hex string.
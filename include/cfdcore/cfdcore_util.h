@@ -583,6 +583,24 @@ class CFD_CORE_EXPORT CryptoUtil {
    */
   static ByteData DecryptAes256Cbc(
       const ByteData &key, const ByteData &iv, const ByteData &data);
+  /**
+   * @brief Encrypto ByteData with AES256-CTR.
+   * @param[in] key key array with 32Byte.
+   * @param[in] iv  initial counter block with 16Byte.
+   * @param[in] data target byte data.
+   * @return encrypted byte data.
+   */
+  static ByteData EncryptAes256Ctr(
+      const ByteData &key, const ByteData &iv, const ByteData &data);
+  /**
+   * @brief Decrypto ByteData with AES256-CTR.
+   * @param[in] key key array with 32Byte.
+   * @param[in] iv  initial counter block with 16Byte.
+   * @param[in] data target encrypted byte data.
+   * @return decrypted byte data.
+   */
+  static ByteData DecryptAes256Ctr(
+      const ByteData &key, const ByteData &iv, const ByteData &data);
   /**
    * @brief Calculate HMAC-SHA256 for ByteData.
    * @param[in] key Byte array data as a key
@@ -606,6 +624,32 @@ class CFD_CORE_EXPORT CryptoUtil {
    */
   static ByteData HmacSha512(
       const std::vector<uint8_t> &key, const ByteData &data);
+  /**
+   * @brief Calculate PBKDF2-HMAC-SHA512.
+   * @param[in] password    password
+   * @param[in] salt        salt
+   * @param[in] iterations  iteration count
+   * @param[in] key_size    output key size
+   * @return derived key
+   */
+  static ByteData Pbkdf2HmacSha512(
+      const ByteData &password, const ByteData &salt, uint32_t iterations,
+      size_t key_size);
+  /**
+   * @brief Calculate PBKDF2-HMAC-SHA512 for multiple passwords.
+   * @details The output blocks of all passwords are processed together
+   *     on multi-lane kernels and worker threads.
+   * @param[in] passwords     password list
+   * @param[in] salts         salt list (same count as passwords)
+   * @param[in] iterations    iteration count
+   * @param[in] key_size      output key size
+   * @param[in] thread_count  worker thread count (0: hardware concurrency)
+   * @return derived key list
+   */
+  static std::vector<ByteData> Pbkdf2HmacSha512Batch(
+      const std::vector<ByteData> &passwords,
+      const std::vector<ByteData> &salts, uint32_t iterations,
+      size_t key_size, uint32_t thread_count = 0);
   /**
    * @brief Normalize signature.
    * @param[in] signature  signature
@@ -660,6 +704,20 @@ class CFD_CORE_EXPORT CryptoUtil {
    * @return decoded ByteData
    */
   static ByteData DecodeBase58Check(const std::string &str);
+  /**
+   * @brief Base58 decode and checksum check the string to the buffer.
+   * @details This function does not allocate memory or throw an exception.
+   *     The decoded data with checksum must be 128 bytes or less.
+   * @param[in] str           Base58 encoded string
+   * @param[out] output       decoded data buffer
+   * @param[in] output_size   decoded data buffer size
+   * @param[out] written      decoded data size (without checksum)
+   * @retval true   success
+   * @retval false  invalid string, checksum unmatch or buffer shortage
+   */
+  static bool DecodeBase58Check(
+      const std::string &str, uint8_t *output, size_t output_size,
+      size_t *written);
   /**
    * @brief encode Base58.
    * @param[in] data  byte data
@@ -672,6 +730,27 @@ class CFD_CORE_EXPORT CryptoUtil {
    * @return Base58 encode string.
    */
   static std::string EncodeBase58Check(const ByteData &data);
+  /**
+   * @brief encode Base58 and append checksum for multiple data.
+   * @details Each string of the result is allocated. Use the overload with
+   *     the output buffer to encode the data with one allocation.
+   * @param[in] data_list  byte data list
+   * @return Base58 encode string list.
+   */
+  static std::vector<std::string> EncodeBase58CheckBatch(
+      const std::vector<ByteData> &data_list);
+  /**
+   * @brief encode Base58 and append checksum for multiple data to a buffer.
+   * @details The encoded strings are written to output back to back. The
+   *     string of data_list[i] is the range [offsets[i], offsets[i + 1]) of
+   *     output. output and offsets are allocated once for the whole batch.
+   * @param[in] data_list  byte data list
+   * @param[out] output    concatenated Base58 encode strings
+   * @param[out] offsets   string offsets (data_list.size() + 1 entries)
+   */
+  static void EncodeBase58CheckBatch(
+      const std::vector<ByteData> &data_list, std::string *output,
+      std::vector<size_t> *offsets);
 
   /**
    * @brief Perform a simple calculation of merkle root.
@@ -694,6 +773,304 @@ class CFD_CORE_EXPORT CryptoUtil {
   CryptoUtil();
 };
 
+/**
+ * @class HmacSha256Context
+ * @brief HMAC-SHA256 context with the precomputed key pads.
+ * @details Reuse this context when many data are keyed by the same key.
+ *     The context is immutable after construction, so it can be shared
+ *     between threads.
+ */
+class CFD_CORE_EXPORT HmacSha256Context {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] key   key
+   */
+  explicit HmacSha256Context(const std::vector<uint8_t> &key);
+  /**
+   * @brief constructor.
+   * @param[in] key   key
+   */
+  explicit HmacSha256Context(const ByteData &key);
+  /**
+   * @brief destructor.
+   */
+  ~HmacSha256Context();
+
+  /**
+   * @brief Calculate HMAC-SHA256.
+   * @param[in] data  input data
+   * @return HMAC-SHA256
+   */
+  ByteData256 Calculate(const ByteData &data) const;
+  /**
+   * @brief Calculate HMAC-SHA256.
+   * @param[in] data      input data
+   * @param[in] size      input data size
+   * @param[out] output   HMAC-SHA256 (32 bytes)
+   */
+  void Calculate(const uint8_t *data, size_t size, uint8_t *output) const;
+
+ private:
+  uint32_t inner_state_[8];  //!< SHA-256 state after the inner pad
+  uint32_t outer_state_[8];  //!< SHA-256 state after the outer pad
+};
+
+/**
+ * @class HmacSha512Context
+ * @brief HMAC-SHA512 context with the precomputed key pads.
+ * @details Reuse this context when many data are keyed by the same key.
+ *     The context is immutable after construction, so it can be shared
+ *     between threads.
+ */
+class CFD_CORE_EXPORT HmacSha512Context {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] key   key
+   */
+  explicit HmacSha512Context(const std::vector<uint8_t> &key);
+  /**
+   * @brief constructor.
+   * @param[in] key   key
+   */
+  explicit HmacSha512Context(const ByteData &key);
+  /**
+   * @brief destructor.
+   */
+  ~HmacSha512Context();
+
+  /**
+   * @brief Calculate HMAC-SHA512.
+   * @param[in] data  input data
+   * @return HMAC-SHA512
+   */
+  ByteData Calculate(const ByteData &data) const;
+  /**
+   * @brief Calculate HMAC-SHA512.
+   * @param[in] data      input data
+   * @param[in] size      input data size
+   * @param[out] output   HMAC-SHA512 (64 bytes)
+   */
+  void Calculate(const uint8_t *data, size_t size, uint8_t *output) const;
+
+ private:
+  uint64_t inner_state_[8];  //!< SHA-512 state after the inner pad
+  uint64_t outer_state_[8];  //!< SHA-512 state after the outer pad
+};
+
+/**
+ * @class Base64Encoder
+ * @brief Incremental Base64 encoder.
+ * @details Input can be split at any position.
+ */
+class CFD_CORE_EXPORT Base64Encoder {
+ public:
+  /**
+   * @brief constructor.
+   */
+  Base64Encoder();
+  /**
+   * @brief Encode a data chunk and append to the output.
+   * @param[in] data      data chunk
+   * @param[in] size      data chunk size
+   * @param[out] output   encoded string (append)
+   */
+  void Update(const uint8_t *data, size_t size, std::string *output);
+  /**
+   * @brief Encode a data chunk and append to the output.
+   * @param[in] data      data chunk
+   * @param[out] output   encoded string (append)
+   */
+  void Update(const ByteData &data, std::string *output);
+  /**
+   * @brief Flush the remaining data with padding.
+   * @details After this call, the encoder can be reused.
+   * @param[out] output   encoded string (append)
+   */
+  void Final(std::string *output);
+
+ private:
+  uint8_t pending_[3];   //!< remaining bytes of the last chunk
+  size_t pending_size_;  //!< remaining byte size
+};
+
+/**
+ * @class Base64Decoder
+ * @brief Incremental Base64 decoder.
+ * @details Input can be split at any position. Line breaks are ignored.
+ */
+class CFD_CORE_EXPORT Base64Decoder {
+ public:
+  /**
+   * @brief constructor.
+   */
+  Base64Decoder();
+  /**
+   * @brief Decode a string chunk and append to the output.
+   * @param[in] data      string chunk
+   * @param[in] size      string chunk size
+   * @param[out] output   decoded data (append)
+   * @throws CfdException   If invalid base64 string.
+   */
+  void Update(const char *data, size_t size, std::vector<uint8_t> *output);
+  /**
+   * @brief Decode a string chunk and append to the output.
+   * @param[in] data      string chunk
+   * @param[out] output   decoded data (append)
+   * @throws CfdException   If invalid base64 string.
+   */
+  void Update(const std::string &data, std::vector<uint8_t> *output);
+  /**
+   * @brief Check the end of the string.
+   * @details After this call, the decoder can be reused.
+   * @throws CfdException   If the string is not terminated.
+   */
+  void Final();
+
+ private:
+  char pending_[4];      //!< remaining characters of the last chunk
+  size_t pending_size_;  //!< remaining character size
+  bool is_padded_;       //!< padding is found
+};
+
+/**
+ * @class Aes256CbcEncryptor
+ * @brief Incremental AES-256-CBC encryptor. (PKCS#7 padding)
+ * @details Input can be split at any position. AES-NI is used if available.
+ */
+class CFD_CORE_EXPORT Aes256CbcEncryptor {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] key   key (32 bytes)
+   * @param[in] iv    initial vector (16 bytes)
+   * @throws CfdException   If invalid key or iv size.
+   */
+  Aes256CbcEncryptor(const ByteData &key, const ByteData &iv);
+  /**
+   * @brief destructor.
+   */
+  ~Aes256CbcEncryptor();
+
+  /**
+   * @brief Encrypt a data chunk and append to the output.
+   * @param[in] data      data chunk
+   * @param[in] size      data chunk size
+   * @param[out] output   encrypted data (append)
+   */
+  void Update(const uint8_t *data, size_t size, std::vector<uint8_t> *output);
+  /**
+   * @brief Encrypt a data chunk and append to the output.
+   * @param[in] data      data chunk
+   * @param[out] output   encrypted data (append)
+   */
+  void Update(const ByteData &data, std::vector<uint8_t> *output);
+  /**
+   * @brief Encrypt the remaining data with padding.
+   * @param[out] output   encrypted data (append)
+   */
+  void Final(std::vector<uint8_t> *output);
+
+ private:
+  uint8_t key_schedule_[480];  //!< round keys
+  uint8_t iv_[16];             //!< chaining value
+  uint8_t pending_[16];        //!< remaining bytes of the last chunk
+  size_t pending_size_;        //!< remaining byte size
+};
+
+/**
+ * @class Aes256CbcDecryptor
+ * @brief Incremental AES-256-CBC decryptor. (PKCS#7 padding)
+ * @details Input can be split at any position. The last block is kept
+ *     until Final() for removing the padding.
+ */
+class CFD_CORE_EXPORT Aes256CbcDecryptor {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] key   key (32 bytes)
+   * @param[in] iv    initial vector (16 bytes)
+   * @throws CfdException   If invalid key or iv size.
+   */
+  Aes256CbcDecryptor(const ByteData &key, const ByteData &iv);
+  /**
+   * @brief destructor.
+   */
+  ~Aes256CbcDecryptor();
+
+  /**
+   * @brief Decrypt a data chunk and append to the output.
+   * @param[in] data      data chunk
+   * @param[in] size      data chunk size
+   * @param[out] output   decrypted data (append)
+   */
+  void Update(const uint8_t *data, size_t size, std::vector<uint8_t> *output);
+  /**
+   * @brief Decrypt a data chunk and append to the output.
+   * @param[in] data      data chunk
+   * @param[out] output   decrypted data (append)
+   */
+  void Update(const ByteData &data, std::vector<uint8_t> *output);
+  /**
+   * @brief Decrypt the last block and remove the padding.
+   * @param[out] output   decrypted data (append)
+   * @throws CfdException   If invalid data size or padding.
+   */
+  void Final(std::vector<uint8_t> *output);
+
+ private:
+  uint8_t key_schedule_[480];  //!< round keys
+  uint8_t iv_[16];             //!< chaining value
+  uint8_t pending_[16];        //!< remaining bytes of the last chunk
+  size_t pending_size_;        //!< remaining byte size
+};
+
+/**
+ * @class Aes256CtrCipher
+ * @brief Incremental AES-256-CTR cipher.
+ * @details Encryption and decryption are the same operation.
+ *     The counter is the 128bit big-endian value of the initial vector.
+ *     Large chunks are processed on worker threads.
+ */
+class CFD_CORE_EXPORT Aes256CtrCipher {
+ public:
+  /**
+   * @brief constructor.
+   * @param[in] key           key (32 bytes)
+   * @param[in] iv            initial counter block (16 bytes)
+   * @param[in] thread_count  worker thread count (0: hardware concurrency)
+   * @throws CfdException   If invalid key or iv size.
+   */
+  Aes256CtrCipher(
+      const ByteData &key, const ByteData &iv, uint32_t thread_count = 0);
+  /**
+   * @brief destructor.
+   */
+  ~Aes256CtrCipher();
+
+  /**
+   * @brief Encrypt or decrypt a data chunk.
+   * @param[in] data      data chunk
+   * @param[in] size      data chunk size
+   * @param[out] output   output buffer (size bytes, can be the same as data)
+   */
+  void Update(const uint8_t *data, size_t size, uint8_t *output);
+  /**
+   * @brief Encrypt or decrypt a data chunk.
+   * @param[in] data      data chunk
+   * @return output data
+   */
+  ByteData Update(const ByteData &data);
+
+ private:
+  uint8_t key_schedule_[480];  //!< round keys
+  uint8_t counter_[16];        //!< next counter block
+  uint8_t keystream_[16];      //!< keystream of the current block
+  size_t keystream_offset_;    //!< used byte size of the keystream
+  uint32_t thread_count_;      //!< worker thread count
+};
+
 /**
  * @class RandomNumberUtil
  * @brief Utility class of random number related functions
@@ -742,12 +1119,38 @@ class CFD_CORE_EXPORT StringUtil {
    * @return byte data array.
    */
   static std::vector<uint8_t> StringToByte(const std::string &hex_str);
+  /**
+   * @brief Convert from hex character string to caller's buffer.
+   * @details This function does not allocate memory.
+   * @param[in] hex_str       HEX string
+   * @param[in] hex_size      HEX string length
+   * @param[out] output       output buffer (need hex_size / 2 bytes)
+   * @param[in] output_size   output buffer size
+   * @return written size.
+   * @throws CfdException   If invalid hex string or short buffer.
+   */
+  static size_t StringToByte(
+      const char *hex_str, size_t hex_size, uint8_t *output,
+      size_t output_size);
   /**
    * @brief Convert from byte data array to HEX character string.
    * @param[in] bytes byte data array
    * @return HEX string
    */
   static std::string ByteToString(const std::vector<uint8_t> &bytes);
+  /**
+   * @brief Convert from byte data buffer to caller's character buffer.
+   * @details This function does not allocate memory,
+   *     and does not write a null terminator.
+   * @param[in] bytes         byte data buffer
+   * @param[in] size          byte data size
+   * @param[out] output       output buffer (need size * 2 bytes)
+   * @param[in] output_size   output buffer size
+   * @return written size.
+   * @throws CfdException   If short buffer.
+   */
+  static size_t ByteToString(
+      const uint8_t *bytes, size_t size, char *output, size_t output_size);
   /**
    * @brief Convert to lower character.
    * @param[in] str     Character string
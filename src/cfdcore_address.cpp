@@ -7,8 +7,12 @@
 #include "cfdcore/cfdcore_address.h"
 
 #include <algorithm>
+#include <cstring>
 #include <map>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_elements_address.h"
@@ -16,8 +20,10 @@
 #include "cfdcore/cfdcore_script.h"
 #include "cfdcore/cfdcore_taproot.h"
 #include "cfdcore/cfdcore_util.h"
-#include "cfdcore_wally_util.h"  // NOLINT
-#include "univalue.h"            // NOLINT
+#include "cfdcore_sha2.h"         // NOLINT
+#include "cfdcore_thread_util.h"  // NOLINT
+#include "cfdcore_wally_util.h"   // NOLINT
+#include "univalue.h"             // NOLINT
 
 namespace cfd {
 namespace core {
@@ -47,122 +53,185 @@ static const NetType s_network_type_values[] = {
 // -----------------------------------------------------------------------------
 // AddressFormatData
 // -----------------------------------------------------------------------------
-AddressFormatData::AddressFormatData() : map_() {
-  // do nothing
+/**
+ * @brief Convert the network type name to NetType.
+ * @param[in] net_type    network type name
+ * @return network type
+ */
+static NetType ConvertNetType(const std::string& net_type) {
+  NetType result = NetType::kCustomChain;
+  if (net_type == kNettypeMainnet) {
+    result = NetType::kMainnet;
+  } else if (net_type == kNettypeTestnet) {
+    result = NetType::kTestnet;
+  } else if (net_type == kNettypeRegtest) {
+    result = NetType::kRegtest;
+  } else {
+#ifndef CFD_DISABLE_ELEMENTS
+    if (net_type == kNettypeLiquidV1) {
+      result = NetType::kLiquidV1;
+    } else if (net_type == kNettypeElementsRegtest) {
+      result = NetType::kElementsRegtest;
+    }
+#endif  // CFD_DISABLE_ELEMENTS
+  }
+  return result;
 }
 
-AddressFormatData::AddressFormatData(const std::string& default_format_name)
-    : map_() {
+/**
+ * @brief Decode the address prefix.
+ * @param[in] map_data    prefix setting map
+ * @param[in] key         mapping key
+ * @param[out] prefix     prefix
+ * @retval true   decoded
+ * @retval false  not exist or invalid
+ */
+static bool DecodeAddressPrefix(
+    const std::map<std::string, std::string>& map_data, const char* key,
+    uint8_t* prefix) {
+  auto ite = map_data.find(key);
+  if (ite == map_data.end()) return false;
+  try {
+    *prefix = static_cast<uint8_t>(std::stoi(ite->second, nullptr, 16));
+  } catch (const std::exception&) {
+    return false;
+  }
+  return true;
+}
+
+AddressFormatData::AddressFormatData() {
+  static const std::shared_ptr<const FormatBody> kEmptyBody =
+      CreateBody(std::map<std::string, std::string>());
+  body_ = kEmptyBody;
+}
+
+AddressFormatData::AddressFormatData(const std::string& default_format_name) {
+  std::map<std::string, std::string> map_data;
   if (default_format_name == kNettypeMainnet) {
-    map_.emplace(kNettype, kNettypeMainnet);
-    map_.emplace(kPrefixP2pkh, "00");
-    map_.emplace(kPrefixP2sh, "05");
-    map_.emplace(kPrefixBech32Hrp, "bc");
+    map_data.emplace(kNettype, kNettypeMainnet);
+    map_data.emplace(kPrefixP2pkh, "00");
+    map_data.emplace(kPrefixP2sh, "05");
+    map_data.emplace(kPrefixBech32Hrp, "bc");
   } else if (default_format_name == kNettypeTestnet) {
-    map_.emplace(kNettype, kNettypeTestnet);
-    map_.emplace(kPrefixP2pkh, "6f");
-    map_.emplace(kPrefixP2sh, "c4");
-    map_.emplace(kPrefixBech32Hrp, "tb");
+    map_data.emplace(kNettype, kNettypeTestnet);
+    map_data.emplace(kPrefixP2pkh, "6f");
+    map_data.emplace(kPrefixP2sh, "c4");
+    map_data.emplace(kPrefixBech32Hrp, "tb");
   } else if (default_format_name == kNettypeRegtest) {
-    map_.emplace(kNettype, kNettypeRegtest);
-    map_.emplace(kPrefixP2pkh, "6f");
-    map_.emplace(kPrefixP2sh, "c4");
-    map_.emplace(kPrefixBech32Hrp, "bcrt");
+    map_data.emplace(kNettype, kNettypeRegtest);
+    map_data.emplace(kPrefixP2pkh, "6f");
+    map_data.emplace(kPrefixP2sh, "c4");
+    map_data.emplace(kPrefixBech32Hrp, "bcrt");
   } else {
 #ifndef CFD_DISABLE_ELEMENTS
     if (default_format_name == kNettypeLiquidV1) {
-      map_.emplace(kNettype, kNettypeLiquidV1);
-      map_.emplace(kPrefixP2pkh, "39");
-      map_.emplace(kPrefixP2sh, "27");
-      map_.emplace(kPrefixBech32Hrp, "ex");
-      map_.emplace(kPrefixBlindP2pkh, "0c");
-      map_.emplace(kPrefixBlindBech32Hrp, "lq");
+      map_data.emplace(kNettype, kNettypeLiquidV1);
+      map_data.emplace(kPrefixP2pkh, "39");
+      map_data.emplace(kPrefixP2sh, "27");
+      map_data.emplace(kPrefixBech32Hrp, "ex");
+      map_data.emplace(kPrefixBlindP2pkh, "0c");
+      map_data.emplace(kPrefixBlindBech32Hrp, "lq");
     } else if (default_format_name == kNettypeElementsRegtest) {
-      map_.emplace(kNettype, kNettypeElementsRegtest);
-      map_.emplace(kPrefixP2pkh, "eb");
-      map_.emplace(kPrefixP2sh, "4b");
-      map_.emplace(kPrefixBech32Hrp, "ert");
-      map_.emplace(kPrefixBlindP2pkh, "04");
-      map_.emplace(kPrefixBlindBech32Hrp, "el");
+      map_data.emplace(kNettype, kNettypeElementsRegtest);
+      map_data.emplace(kPrefixP2pkh, "eb");
+      map_data.emplace(kPrefixP2sh, "4b");
+      map_data.emplace(kPrefixBech32Hrp, "ert");
+      map_data.emplace(kPrefixBlindP2pkh, "04");
+      map_data.emplace(kPrefixBlindBech32Hrp, "el");
     }
 #endif  // CFD_DISABLE_ELEMENTS
   }
+  body_ = CreateBody(map_data);
 }
 
 AddressFormatData::AddressFormatData(
     const std::map<std::string, std::string>& map_data)
-    : map_(map_data) {}
+    : body_(CreateBody(map_data)) {}
+
+std::shared_ptr<const AddressFormatData::FormatBody>
+AddressFormatData::CreateBody(
+    const std::map<std::string, std::string>& map_data) {
+  auto body = std::make_shared<FormatBody>();
+  body->map = map_data;
+  NetworkParams& params = body->params;
+  auto ite = map_data.find(kNettype);
+  params.has_net_type = (ite != map_data.end());
+  params.net_type = (params.has_net_type) ? ConvertNetType(ite->second)
+                                          : NetType::kCustomChain;
+  params.p2pkh_prefix = 0;
+  params.has_p2pkh_prefix =
+      DecodeAddressPrefix(map_data, kPrefixP2pkh, &params.p2pkh_prefix);
+  params.p2sh_prefix = 0;
+  params.has_p2sh_prefix =
+      DecodeAddressPrefix(map_data, kPrefixP2sh, &params.p2sh_prefix);
+  ite = map_data.find(kPrefixBech32Hrp);
+  if (ite != map_data.end()) params.bech32_hrp = ite->second;
+  params.blinded_p2pkh_prefix = 0;
+  params.has_blinded_p2pkh_prefix = DecodeAddressPrefix(
+      map_data, kPrefixBlindP2pkh, &params.blinded_p2pkh_prefix);
+  params.blinded_p2sh_prefix = 0;
+  params.has_blinded_p2sh_prefix = DecodeAddressPrefix(
+      map_data, kPrefixBlindP2sh, &params.blinded_p2sh_prefix);
+  ite = map_data.find(kPrefixBlindBech32Hrp);
+  if (ite != map_data.end()) params.blech32_hrp = ite->second;
+  return body;
+}
 
 bool AddressFormatData::IsFind(const std::string& key) const {
-  return map_.find(key) != map_.end();
+  return body_->map.find(key) != body_->map.end();
 }
 
 std::string AddressFormatData::GetString(const std::string& key) const {
-  if (map_.find(key) == map_.end()) {
+  auto ite = body_->map.find(key);
+  if (ite == body_->map.end()) {
     throw CfdException(
         CfdError::kCfdOutOfRangeError, "unknown key. key=" + key);
   }
-  return map_.at(key);
+  return ite->second;
 }
 
 uint32_t AddressFormatData::GetValue(const std::string& key) const {
-  if (map_.find(key) == map_.end()) {
+  auto ite = body_->map.find(key);
+  if (ite == body_->map.end()) {
     throw CfdException(
         CfdError::kCfdOutOfRangeError, "unknown key. key=" + key);
   }
-  return std::stoi(map_.at(key), nullptr, 16);
+  return std::stoi(ite->second, nullptr, 16);
 }
 
 uint8_t AddressFormatData::GetP2pkhPrefix() const {
+  if (body_->params.has_p2pkh_prefix) return body_->params.p2pkh_prefix;
   return static_cast<uint8_t>(GetValue(kPrefixP2pkh));
 }
 
 uint8_t AddressFormatData::GetP2shPrefix() const {
+  if (body_->params.has_p2sh_prefix) return body_->params.p2sh_prefix;
   return static_cast<uint8_t>(GetValue(kPrefixP2sh));
 }
 
 std::string AddressFormatData::GetBech32Hrp() const {
-  if (map_.find(kPrefixBech32Hrp) == map_.end()) {
-    return "";
-  }
-  return GetString(kPrefixBech32Hrp);
+  return body_->params.bech32_hrp;
 }
 
 NetType AddressFormatData::GetNetType() const {
-  std::string net_type = GetString(kNettype);
-  NetType result = NetType::kCustomChain;
-  if (net_type == kNettypeMainnet) {
-    result = NetType::kMainnet;
-  } else if (net_type == kNettypeTestnet) {
-    result = NetType::kTestnet;
-  } else if (net_type == kNettypeRegtest) {
-    result = NetType::kRegtest;
-  } else {
-#ifndef CFD_DISABLE_ELEMENTS
-    if (net_type == kNettypeLiquidV1) {
-      result = NetType::kLiquidV1;
-    } else if (net_type == kNettypeElementsRegtest) {
-      result = NetType::kElementsRegtest;
-    }
-#endif  // CFD_DISABLE_ELEMENTS
-  }
-  return result;
+  if (!body_->params.has_net_type) GetString(kNettype);  // throw
+  return body_->params.net_type;
 }
 
 bool AddressFormatData::IsValid() const {
   static const std::vector<const char*> key_list = {
       kNettype, kPrefixP2pkh, kPrefixP2sh, kPrefixBech32Hrp};
   for (const char* key : key_list) {
-    if (map_.find(key) == map_.end()) return false;
+    if (body_->map.find(key) == body_->map.end()) return false;
   }
   try {
-    if (map_.find(kNettype)->second.empty()) return false;
+    if (body_->map.find(kNettype)->second.empty()) return false;
 
-    auto p2pkh = ByteData(map_.find(kPrefixP2pkh)->second);
+    auto p2pkh = ByteData(body_->map.find(kPrefixP2pkh)->second);
     if (p2pkh.GetDataSize() != 1) return false;
-    auto p2sh = ByteData(map_.find(kPrefixP2sh)->second);
+    auto p2sh = ByteData(body_->map.find(kPrefixP2sh)->second);
     if (p2sh.GetDataSize() != 1) return false;
-    auto& bech32 = map_.find(kPrefixBech32Hrp)->second;
+    auto& bech32 = body_->map.find(kPrefixBech32Hrp)->second;
     if (bech32.empty() || (bech32.size() > 84)) return false;
   } catch (const CfdException&) {
     return false;
@@ -180,16 +249,16 @@ bool AddressFormatData::IsValidElements() const {
   if (!IsValid()) return false;
 
   for (const char* key : key_list) {
-    if (map_.find(key) == map_.end()) return false;
+    if (body_->map.find(key) == body_->map.end()) return false;
   }
   try {
-    auto blind_p2pkh = ByteData(map_.find(kPrefixBlindP2pkh)->second);
+    auto blind_p2pkh = ByteData(body_->map.find(kPrefixBlindP2pkh)->second);
     if (blind_p2pkh.GetDataSize() != 1) return false;
-    if (map_.find(kPrefixBlindP2sh) != map_.end()) {
-      auto blind_p2sh = ByteData(map_.find(kPrefixBlindP2sh)->second);
+    if (body_->map.find(kPrefixBlindP2sh) != body_->map.end()) {
+      auto blind_p2sh = ByteData(body_->map.find(kPrefixBlindP2sh)->second);
       if (blind_p2sh.GetDataSize() != 1) return false;
     }
-    const auto& lbech32 = map_.find(kPrefixBlindBech32Hrp)->second;
+    const auto& lbech32 = body_->map.find(kPrefixBlindBech32Hrp)->second;
     if (lbech32.empty() || (lbech32.size() > 995)) return false;
   } catch (const CfdException&) {
     return false;
@@ -249,37 +318,212 @@ std::vector<AddressFormatData> AddressFormatData::ConvertListFromJson(
   return result;
 }
 
-//! bitcoin address format list
-const std::vector<AddressFormatData> kBitcoinAddressFormatList = {
-    AddressFormatData(kNettypeMainnet), AddressFormatData(kNettypeTestnet),
-    AddressFormatData(kNettypeRegtest)};
-//! custom bitcoin address format list
-static std::vector<AddressFormatData> g_custom_btc_addr_format_list;
+/**
+ * @brief The address format table compiled from the format list.
+ * @details The table is immutable after compile.
+ */
+struct AddressFormatTable {
+  std::vector<AddressFormatData> format_list;  //!< format list
+  //! format list index by network type (-1: not exist)
+  int net_type_index[NetType::kNetTypeNum + 1];
+  //! format list index by base58 prefix (-1: not exist)
+  int base58_index[256];
+  //! base58 prefix is p2sh
+  bool base58_is_p2sh[256];
+  //! format list index by bech32 hrp (sorted by hrp)
+  std::vector<std::pair<std::string, size_t>> hrp_index;
+};
+
+/**
+ * @brief Compare the bech32 hrp of the table with the hrp buffer.
+ * @param[in] entry       hrp index entry
+ * @param[in] hrp         hrp buffer
+ * @param[in] hrp_size    hrp size
+ * @retval negative   entry is less than the hrp
+ * @retval 0          equal
+ * @retval positive   entry is greater than the hrp
+ */
+static int CompareBech32Hrp(
+    const std::pair<std::string, size_t>& entry, const char* hrp,
+    size_t hrp_size) {
+  return entry.first.compare(0, std::string::npos, hrp, hrp_size);
+}
+
+/**
+ * @brief Find the format list index by the bech32 hrp.
+ * @param[in] table       address format table
+ * @param[in] hrp         hrp buffer (lower case)
+ * @param[in] hrp_size    hrp size
+ * @return format list index (-1: not exist)
+ */
+static int FindBech32HrpIndex(
+    const AddressFormatTable& table, const char* hrp, size_t hrp_size) {
+  auto ite = std::lower_bound(
+      table.hrp_index.begin(), table.hrp_index.end(), hrp_size,
+      [hrp](const std::pair<std::string, size_t>& entry, size_t size) {
+        return CompareBech32Hrp(entry, hrp, size) < 0;
+      });
+  if ((ite == table.hrp_index.end()) ||
+      (CompareBech32Hrp(*ite, hrp, hrp_size) != 0)) {
+    return -1;
+  }
+  return static_cast<int>(ite->second);
+}
+
+/**
+ * @brief Compile the address format table.
+ * @details If the prefix is duplicated, the first format has priority
+ *     (and the p2sh prefix has priority over the p2pkh prefix).
+ * @param[in] format_list   address format list
+ * @return address format table
+ */
+static std::shared_ptr<const AddressFormatTable> CompileAddressFormatTable(
+    const std::vector<AddressFormatData>& format_list) {
+  auto table = std::make_shared<AddressFormatTable>();
+  table->format_list = format_list;
+  std::fill(
+      std::begin(table->net_type_index), std::end(table->net_type_index), -1);
+  std::fill(
+      std::begin(table->base58_index), std::end(table->base58_index), -1);
+  std::fill(
+      std::begin(table->base58_is_p2sh), std::end(table->base58_is_p2sh),
+      false);
+  for (size_t index = 0; index < format_list.size(); ++index) {
+    const NetworkParams& params = format_list[index].GetNetworkParams();
+    int list_index = static_cast<int>(index);
+    if (params.has_net_type &&
+        (table->net_type_index[params.net_type] < 0)) {
+      table->net_type_index[params.net_type] = list_index;
+    }
+    if (params.has_p2sh_prefix &&
+        (table->base58_index[params.p2sh_prefix] < 0)) {
+      table->base58_index[params.p2sh_prefix] = list_index;
+      table->base58_is_p2sh[params.p2sh_prefix] = true;
+    }
+    if (params.has_p2pkh_prefix &&
+        (table->base58_index[params.p2pkh_prefix] < 0)) {
+      table->base58_index[params.p2pkh_prefix] = list_index;
+    }
+    if (!params.bech32_hrp.empty()) {
+      table->hrp_index.emplace_back(params.bech32_hrp, index);
+    }
+  }
+  // sort by hrp. (the first format is kept on the same hrp)
+  auto& hrp_index = table->hrp_index;
+  std::stable_sort(
+      hrp_index.begin(), hrp_index.end(),
+      [](const std::pair<std::string, size_t>& lhs,
+         const std::pair<std::string, size_t>& rhs) {
+        return lhs.first < rhs.first;
+      });
+  hrp_index.erase(
+      std::unique(
+          hrp_index.begin(), hrp_index.end(),
+          [](const std::pair<std::string, size_t>& lhs,
+             const std::pair<std::string, size_t>& rhs) {
+            return lhs.first == rhs.first;
+          }),
+      hrp_index.end());
+  return table;
+}
+
+/**
+ * @brief The custom address format snapshot.
+ * @details The snapshot is immutable after it is published.
+ */
+struct CustomAddressFormat {
+  //! custom bitcoin address format table
+  std::shared_ptr<const AddressFormatTable> btc_table;
+#ifndef CFD_DISABLE_ELEMENTS
+  //! custom elements address format table
+  std::shared_ptr<const AddressFormatTable> elm_table;
+#endif  // CFD_DISABLE_ELEMENTS
+};
+
+/**
+ * @brief custom address format snapshot.
+ * @details Access only with std::atomic_load / std::atomic_store.
+ *     The readers keep using the snapshot they loaded even if it is
+ *     replaced or cleared.
+ */
+static std::shared_ptr<const CustomAddressFormat> g_custom_addr_format;
+
+/**
+ * @brief Get the bitcoin address format table.
+ * @return address format table (custom format table if it is set)
+ */
+static std::shared_ptr<const AddressFormatTable>
+GetBitcoinAddressFormatTable() {
+  static const std::shared_ptr<const AddressFormatTable> kDefaultTable =
+      CompileAddressFormatTable(
+          {AddressFormatData(kNettypeMainnet),
+           AddressFormatData(kNettypeTestnet),
+           AddressFormatData(kNettypeRegtest)});
+  auto custom_format = std::atomic_load(&g_custom_addr_format);
+  if (custom_format && custom_format->btc_table) {
+    return custom_format->btc_table;
+  }
+  return kDefaultTable;
+}
 
 #ifndef CFD_DISABLE_ELEMENTS
-//! elements address format list
-const std::vector<AddressFormatData> kElementsAddressFormatList = {
-    AddressFormatData(kNettypeLiquidV1),
-    AddressFormatData(kNettypeElementsRegtest)};
-//! custom elements address format list
-static std::vector<AddressFormatData> g_custom_elm_addr_format_list;
+/**
+ * @brief Get the elements address format table.
+ * @return address format table (custom format table if it is set)
+ */
+static std::shared_ptr<const AddressFormatTable>
+GetElementsAddressFormatTable() {
+  static const std::shared_ptr<const AddressFormatTable> kDefaultTable =
+      CompileAddressFormatTable(
+          {AddressFormatData(kNettypeLiquidV1),
+           AddressFormatData(kNettypeElementsRegtest)});
+  auto custom_format = std::atomic_load(&g_custom_addr_format);
+  if (custom_format && custom_format->elm_table) {
+    return custom_format->elm_table;
+  }
+  return kDefaultTable;
+}
 #endif  // CFD_DISABLE_ELEMENTS
 
+/**
+ * @brief Get the bitcoin address format data of the network type.
+ * @param[in] net_type    network type
+ * @return address format data
+ */
+static AddressFormatData GetBitcoinAddressFormatData(NetType net_type) {
+  if ((net_type < 0) || (net_type > NetType::kNetTypeNum)) {
+    warn(CFD_LOG_SOURCE, "illegal network type. type={}", net_type);
+    throw CfdException(kCfdIllegalArgumentError, "illegal network type.");
+  }
+  auto table = GetBitcoinAddressFormatTable();
+  int index = table->net_type_index[net_type];
+  if (index < 0) {
+    warn(CFD_LOG_SOURCE, "target address format unknown. type={}", net_type);
+    throw CfdException(
+        kCfdIllegalArgumentError, "target address format unknown error.");
+  }
+  return table->format_list[index];
+}
+
 void SetCustomAddressFormatList(const std::vector<AddressFormatData>& list) {
-  if ((!list.empty()) && g_custom_btc_addr_format_list.empty()) {
+  if ((!list.empty()) && (!std::atomic_load(&g_custom_addr_format))) {
+    std::vector<AddressFormatData> btc_format_list;
+#ifndef CFD_DISABLE_ELEMENTS
+    std::vector<AddressFormatData> elm_format_list;
+#endif  // CFD_DISABLE_ELEMENTS
     std::vector<NetType> added_types;
     for (const auto& item : list) {
       auto nettype = item.GetNetType();
       if ((nettype == NetType::kMainnet) || (nettype == NetType::kTestnet) ||
           (nettype == NetType::kRegtest)) {
         if (item.IsValid()) {
-          g_custom_btc_addr_format_list.emplace_back(item);
+          btc_format_list.emplace_back(item);
           added_types.push_back(nettype);
         }
       } else {
 #ifndef CFD_DISABLE_ELEMENTS
         if (item.IsValidElements()) {
-          g_custom_elm_addr_format_list.emplace_back(item);
+          elm_format_list.emplace_back(item);
           added_types.push_back(nettype);
         }
 #endif  // CFD_DISABLE_ELEMENTS
@@ -298,42 +542,53 @@ void SetCustomAddressFormatList(const std::vector<AddressFormatData>& list) {
       if (is_find) {
         // do nothing
       } else if (s_network_type_values[index] <= NetType::kRegtest) {
-        if (!g_custom_btc_addr_format_list.empty()) {
-          g_custom_btc_addr_format_list.emplace_back(
+        if (!btc_format_list.empty()) {
+          btc_format_list.emplace_back(
               AddressFormatData(s_network_type_names[index]));
         }
       } else {
 #ifndef CFD_DISABLE_ELEMENTS
-        if (!g_custom_elm_addr_format_list.empty()) {
-          g_custom_elm_addr_format_list.emplace_back(
+        if (!elm_format_list.empty()) {
+          elm_format_list.emplace_back(
               AddressFormatData(s_network_type_names[index]));
         }
 #endif  // CFD_DISABLE_ELEMENTS
       }
     }
+
+    auto custom_format = std::make_shared<CustomAddressFormat>();
+    bool is_empty = btc_format_list.empty();
+    if (!btc_format_list.empty()) {
+      custom_format->btc_table = CompileAddressFormatTable(btc_format_list);
+    }
+#ifndef CFD_DISABLE_ELEMENTS
+    if (!elm_format_list.empty()) {
+      custom_format->elm_table = CompileAddressFormatTable(elm_format_list);
+      is_empty = false;
+    }
+#endif  // CFD_DISABLE_ELEMENTS
+    if (!is_empty) {
+      // publish the snapshot only if it is not set yet.
+      std::shared_ptr<const CustomAddressFormat> expected;
+      std::shared_ptr<const CustomAddressFormat> desired = custom_format;
+      std::atomic_compare_exchange_strong(
+          &g_custom_addr_format, &expected, desired);
+    }
   }
 }
 
 void ClearCustomAddressFormatList() {
-  g_custom_btc_addr_format_list.clear();
-#ifndef CFD_DISABLE_ELEMENTS
-  g_custom_elm_addr_format_list.clear();
-#endif  // CFD_DISABLE_ELEMENTS
+  std::atomic_store(
+      &g_custom_addr_format, std::shared_ptr<const CustomAddressFormat>());
 }
 
 std::vector<AddressFormatData> GetBitcoinAddressFormatList() {
-  if (!g_custom_btc_addr_format_list.empty()) {
-    return g_custom_btc_addr_format_list;
-  }
-  return kBitcoinAddressFormatList;
+  return GetBitcoinAddressFormatTable()->format_list;
 }
 
 #ifndef CFD_DISABLE_ELEMENTS
 std::vector<AddressFormatData> GetElementsAddressFormatList() {
-  if (!g_custom_elm_addr_format_list.empty()) {
-    return g_custom_elm_addr_format_list;
-  }
-  return kElementsAddressFormatList;
+  return GetElementsAddressFormatTable()->format_list;
 }
 #endif  // CFD_DISABLE_ELEMENTS
 
@@ -384,6 +639,37 @@ Address& Address::operator=(const Address& object) {
   return *this;
 }
 
+Address::Address(Address&& object) noexcept
+    : type_(object.type_),
+      addr_type_(object.addr_type_),
+      witness_ver_(object.witness_ver_),
+      address_(std::move(object.address_)),
+      hash_(std::move(object.hash_)),
+      pubkey_(std::move(object.pubkey_)),
+      schnorr_pubkey_(std::move(object.schnorr_pubkey_)),
+      script_tree_(std::move(object.script_tree_)),
+      redeem_script_(std::move(object.redeem_script_)) {
+  memcpy(checksum_, object.checksum_, sizeof(checksum_));
+  format_data_ = std::move(object.format_data_);
+}
+
+Address& Address::operator=(Address&& object) noexcept {
+  if (this != &object) {
+    type_ = object.type_;
+    addr_type_ = object.addr_type_;
+    witness_ver_ = object.witness_ver_;
+    address_ = std::move(object.address_);
+    hash_ = std::move(object.hash_);
+    pubkey_ = std::move(object.pubkey_);
+    schnorr_pubkey_ = std::move(object.schnorr_pubkey_);
+    script_tree_ = std::move(object.script_tree_);
+    redeem_script_ = std::move(object.redeem_script_);
+    memcpy(checksum_, object.checksum_, sizeof(checksum_));
+    format_data_ = std::move(object.format_data_);
+  }
+  return *this;
+}
+
 Address::Address(const std::string& address_string)
     : type_(kMainnet),
       addr_type_(kP2shAddress),
@@ -976,30 +1262,13 @@ void Address::CalculateP2SH(const ByteData160& hash_data, uint8_t prefix) {
   // Add first to the list the Address Prefix
   uint8_t addr_prefix = prefix;
   if ((addr_prefix == 0) && (kMainnet <= type_) && (type_ <= kRegtest)) {
-    auto prefix_list = GetBitcoinAddressFormatList();
-    addr_prefix = prefix_list[type_].GetP2shPrefix();
-    format_data_ = prefix_list[type_];
+    format_data_ = GetBitcoinAddressFormatData(type_);
+    addr_prefix = format_data_.GetP2shPrefix();
     SetNetType(format_data_);
   }
   address_data.insert(address_data.begin(), addr_prefix);
 
-  char* output = NULL;
-  uint32_t flags = BASE58_FLAG_CHECKSUM;
-  int ret = wally_base58_from_bytes(
-      address_data.data(), address_data.size(), flags, &output);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_base58_from_bytes error. ret={}.", ret);
-    info(
-        CFD_LOG_SOURCE, "input hash={}",
-        StringUtil::ByteToString(address_data));
-    if (ret == WALLY_EINVAL) {
-      throw CfdException(kCfdIllegalArgumentError, "Base58 encode error.");
-    } else {
-      throw CfdException(kCfdInternalError, "Base58 encode error.");
-    }
-  }
-
-  address_ = WallyUtil::ConvertStringAndFree(output);
+  address_ = CryptoUtil::EncodeBase58Check(ByteData(address_data));
 }
 
 void Address::CalculateP2PKH(uint8_t prefix) {
@@ -1017,31 +1286,14 @@ void Address::CalculateP2PKH(const ByteData160& hash_data, uint8_t prefix) {
   // 　refer bitcoin definition
   uint8_t addr_prefix = prefix;
   if ((addr_prefix == 0) && (kMainnet <= type_) && (type_ <= kRegtest)) {
-    auto prefix_list = GetBitcoinAddressFormatList();
-    addr_prefix = prefix_list[type_].GetP2pkhPrefix();
-    format_data_ = prefix_list[type_];
+    format_data_ = GetBitcoinAddressFormatData(type_);
+    addr_prefix = format_data_.GetP2pkhPrefix();
     SetNetType(format_data_);
   }
   pubkey_hash.insert(pubkey_hash.begin(), addr_prefix);
 
   // Base58check
-  char* output = NULL;
-  uint32_t flags = BASE58_FLAG_CHECKSUM;
-  int ret = wally_base58_from_bytes(
-      pubkey_hash.data(), pubkey_hash.size(), flags, &output);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_base58_from_bytes error. ret={}.", ret);
-    info(
-        CFD_LOG_SOURCE, "input hash={}",
-        StringUtil::ByteToString(pubkey_hash));
-    if (ret == WALLY_EINVAL) {
-      throw CfdException(kCfdIllegalArgumentError, "Base58 encode error.");
-    } else {
-      throw CfdException(kCfdInternalError, "Base58 encode error.");
-    }
-  }
-
-  address_ = WallyUtil::ConvertStringAndFree(output);
+  address_ = CryptoUtil::EncodeBase58Check(ByteData(pubkey_hash));
 }
 
 void Address::CalculateP2WSH(const std::string& bech32_hrp) {
@@ -1064,29 +1316,12 @@ void Address::CalculateP2WSH(
 
   std::string human_code = bech32_hrp;
   if (human_code.empty() && (kMainnet <= type_) && (type_ <= kRegtest)) {
-    auto prefix_list = GetBitcoinAddressFormatList();
-    human_code = prefix_list[type_].GetBech32Hrp();
-    format_data_ = prefix_list[type_];
+    format_data_ = GetBitcoinAddressFormatData(type_);
+    human_code = format_data_.GetBech32Hrp();
     SetNetType(format_data_);
   }
-  char* output = NULL;
   // segwit
-  int ret = wally_addr_segwit_from_bytes(
-      segwit_data.data(), segwit_data.size(), human_code.data(), 0, &output);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_addr_segwit_from_bytes error. ret={}.", ret);
-    info(
-        CFD_LOG_SOURCE, "input hash={}",
-        StringUtil::ByteToString(segwit_data));
-    if (ret == WALLY_EINVAL) {
-      throw CfdException(
-          kCfdIllegalArgumentError, "Segwit-address create error.");
-    } else {
-      throw CfdException(kCfdInternalError, "Segwit-address create error.");
-    }
-  }
-
-  address_ = WallyUtil::ConvertStringAndFree(output);
+  address_ = Bech32Util::EncodeSegwitAddress(human_code, ByteData(segwit_data));
 }
 
 void Address::CalculateP2WPKH(const std::string& bech32_hrp) {
@@ -1104,29 +1339,12 @@ void Address::CalculateP2WPKH(
 
   std::string human_code = bech32_hrp;
   if (human_code.empty() && (kMainnet <= type_) && (type_ <= kRegtest)) {
-    auto prefix_list = GetBitcoinAddressFormatList();
-    human_code = prefix_list[type_].GetBech32Hrp();
-    format_data_ = prefix_list[type_];
+    format_data_ = GetBitcoinAddressFormatData(type_);
+    human_code = format_data_.GetBech32Hrp();
     SetNetType(format_data_);
   }
-  char* output = NULL;
   // segwit
-  int ret = wally_addr_segwit_from_bytes(
-      pubkey_hash.data(), pubkey_hash.size(), human_code.data(), 0, &output);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_addr_segwit_from_bytes error. ret={}.", ret);
-    info(
-        CFD_LOG_SOURCE, "input hash={}",
-        StringUtil::ByteToString(pubkey_hash));
-    if (ret == WALLY_EINVAL) {
-      throw CfdException(
-          kCfdIllegalArgumentError, "Segwit-address create error.");
-    } else {
-      throw CfdException(kCfdInternalError, "Segwit-address create error.");
-    }
-  }
-
-  address_ = WallyUtil::ConvertStringAndFree(output);
+  address_ = Bech32Util::EncodeSegwitAddress(human_code, ByteData(pubkey_hash));
 }
 
 void Address::CalculateTaproot(const std::string& bech32_hrp) {
@@ -1145,28 +1363,11 @@ void Address::CalculateBech32m(
 
   std::string human_code = bech32_hrp;
   if (human_code.empty() && (kMainnet <= type_) && (type_ <= kRegtest)) {
-    auto prefix_list = GetBitcoinAddressFormatList();
-    human_code = prefix_list[type_].GetBech32Hrp();
-    format_data_ = prefix_list[type_];
+    format_data_ = GetBitcoinAddressFormatData(type_);
+    human_code = format_data_.GetBech32Hrp();
     SetNetType(format_data_);
   }
-  char* output = NULL;
-  int ret = wally_addr_segwit_from_bytes(
-      pubkey_hash.data(), pubkey_hash.size(), human_code.data(), 0, &output);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_addr_segwit_from_bytes error. ret={}.", ret);
-    info(
-        CFD_LOG_SOURCE, "input hash={}",
-        StringUtil::ByteToString(pubkey_hash));
-    if (ret == WALLY_EINVAL) {
-      throw CfdException(
-          kCfdIllegalArgumentError, "Segwit-address create error.");
-    } else {
-      throw CfdException(kCfdInternalError, "Segwit-address create error.");
-    }
-  }
-
-  address_ = WallyUtil::ConvertStringAndFree(output);
+  address_ = Bech32Util::EncodeSegwitAddress(human_code, ByteData(pubkey_hash));
 }
 
 void Address::DecodeAddress(
@@ -1180,7 +1381,7 @@ void Address::DecodeAddress(
 
   std::string bs58 = address_string;
   std::string segwit_prefix = "";
-  int ret = -1;
+  std::shared_ptr<const AddressFormatTable> table;
 
   if (network_parameters != nullptr) {
     for (const AddressFormatData& param : *network_parameters) {
@@ -1194,11 +1395,14 @@ void Address::DecodeAddress(
       }
     }
   } else {
-    for (const auto& param : GetBitcoinAddressFormatList()) {
-      if (StartsWith(bs58, param.GetBech32Hrp())) {
-        segwit_prefix = param.GetBech32Hrp();
-        format_data_ = param;
-        break;
+    // the bech32 hrp is before the last separator.
+    table = GetBitcoinAddressFormatTable();
+    size_t separator = bs58.rfind(kBech32Separator);
+    if ((separator != std::string::npos) && (separator != 0)) {
+      int index = FindBech32HrpIndex(*table, bs58.data(), separator);
+      if (index >= 0) {
+        format_data_ = table->format_list[index];
+        segwit_prefix = format_data_.GetBech32Hrp();
       }
     }
   }
@@ -1208,18 +1412,12 @@ void Address::DecodeAddress(
 
   if (!segwit_prefix.empty()) {
     // Bech32 Address
-    ret = wally_addr_segwit_to_bytes(
-        bs58.data(), segwit_prefix.data(), 0, data_part.data(),
-        data_part.size(), &written);
-
-    if (ret != WALLY_OK) {
-      warn(CFD_LOG_SOURCE, "wally_addr_segwit_to_bytes error. ret={}.", ret);
-      if (ret == WALLY_EINVAL) {
-        throw CfdException(
-            kCfdIllegalArgumentError, "Segwit-address decode error.");
-      } else {
-        throw CfdException(kCfdInternalError, "Segwit-address decode error.");
-      }
+    if (!Bech32Util::DecodeSegwitAddress(
+            segwit_prefix, bs58, data_part.data(), data_part.size(),
+            &written)) {
+      warn(CFD_LOG_SOURCE, "DecodeSegwitAddress error. address={}.", bs58);
+      throw CfdException(
+          kCfdIllegalArgumentError, "Segwit-address decode error.");
     }
 
     data_part.resize(written);
@@ -1247,19 +1445,16 @@ void Address::DecodeAddress(
     data_part.erase(data_part.begin(), data_part.begin() + 2);
 
   } else {
-    ret = wally_base58_to_bytes(
-        bs58.data(), BASE58_FLAG_CHECKSUM, data_part.data(), data_part.size(),
-        &written);
-    if (ret != WALLY_OK) {
-      warn(CFD_LOG_SOURCE, "wally_base58_to_bytes error. ret={}.", ret);
-      if (ret == WALLY_EINVAL) {
-        throw CfdException(kCfdIllegalArgumentError, "Base58 decode error.");
-      } else {
-        throw CfdException(kCfdInternalError, "Base58 decode error.");
-      }
+    try {
+      data_part = CryptoUtil::DecodeBase58Check(bs58).GetBytes();
+    } catch (const CfdException& except) {
+      warn(CFD_LOG_SOURCE, "DecodeBase58Check error. {}", except.what());
+      throw CfdException(kCfdIllegalArgumentError, "Base58 decode error.");
+    }
+    if (data_part.empty()) {
+      warn(CFD_LOG_SOURCE, "Base58 address is empty.");
+      throw CfdException(kCfdIllegalArgumentError, "Base58 decode error.");
     }
-
-    data_part.resize(written);
 
     bool find_address_type = false;
     if (network_parameters != nullptr) {
@@ -1277,18 +1472,13 @@ void Address::DecodeAddress(
         }
       }
     } else {
-      for (const auto& param : GetBitcoinAddressFormatList()) {
-        if (data_part[0] == param.GetP2shPrefix()) {
-          SetAddressType(kP2shAddress);
-          find_address_type = true;
-          format_data_ = param;
-          break;
-        } else if (data_part[0] == param.GetP2pkhPrefix()) {
-          SetAddressType(kP2pkhAddress);
-          find_address_type = true;
-          format_data_ = param;
-          break;
-        }
+      int index = table->base58_index[data_part[0]];
+      if (index >= 0) {
+        SetAddressType(
+            (table->base58_is_p2sh[data_part[0]]) ? kP2shAddress
+                                                  : kP2pkhAddress);
+        find_address_type = true;
+        format_data_ = table->format_list[index];
       }
     }
     if (!find_address_type) {
@@ -1421,5 +1611,848 @@ Address Address::GetPegoutAddress(
   }
 }
 
+/// bech32 hrp maximum length of the address parser
+static constexpr size_t kParseHrpMaxLength = 83;
+
+/**
+ * @brief Parse the address string.
+ * @param[in] address_string      address string
+ * @param[in] table               address format table
+ *     (nullptr: use network_parameters)
+ * @param[in] network_parameters  network prefix list
+ * @param[out] result             parse result
+ */
+static void ParseAddressString(
+    const std::string& address_string, const AddressFormatTable* table,
+    const std::vector<AddressFormatData>* network_parameters,
+    AddressParseResult* result) {
+  uint8_t* script = result->locking_script;
+
+  // the bech32 hrp is before the last separator.
+  size_t separator = address_string.rfind('1');
+  if ((separator != std::string::npos) && (separator != 0) &&
+      (separator <= kParseHrpMaxLength)) {
+    char hrp_buffer[kParseHrpMaxLength];
+    for (size_t index = 0; index < separator; ++index) {
+      char character = address_string[index];
+      if ((character >= 'A') && (character <= 'Z')) {
+        character += ('a' - 'A');
+      }
+      hrp_buffer[index] = character;
+    }
+
+    const NetworkParams* params = nullptr;
+    if (table != nullptr) {
+      int index = FindBech32HrpIndex(*table, hrp_buffer, separator);
+      if (index >= 0) {
+        params = &table->format_list[index].GetNetworkParams();
+      }
+    } else {
+      for (const auto& format_data : *network_parameters) {
+        const std::string& bech32_hrp =
+            format_data.GetNetworkParams().bech32_hrp;
+        if (bech32_hrp.compare(0, std::string::npos, hrp_buffer, separator) ==
+            0) {
+          params = &format_data.GetNetworkParams();
+          break;
+        }
+      }
+    }
+
+    if (params != nullptr) {
+      size_t written = 0;
+      if ((!params->has_net_type) ||
+          (!Bech32Util::DecodeSegwitAddress(
+              hrp_buffer, separator, address_string, script,
+              kMaxAddressLockingScriptSize, &written))) {
+        return;
+      }
+      uint8_t version =
+          (script[0] == 0) ? 0 : static_cast<uint8_t>(script[0] - (kOp_1 - 1));
+      AddressType address_type = kWitnessUnknown;
+      if (version == 0) {
+        address_type = (written == kScriptHashP2wpkhLength) ? kP2wpkhAddress
+                                                            : kP2wshAddress;
+      } else if (version == 1) {
+        if (written != (SchnorrPubkey::kSchnorrPubkeySize + 2)) return;
+        address_type = kTaprootAddress;
+      }
+      result->net_type = params->net_type;
+      result->address_type = address_type;
+      result->witness_version = static_cast<WitnessVersion>(version);
+      result->locking_script_size = static_cast<uint32_t>(written);
+      result->error = kCfdSuccess;
+      return;
+    }
+  }
+
+  // base58: prefix + hash160
+  uint8_t data[kByteData160Length + 1];
+  size_t written = 0;
+  if ((!CryptoUtil::DecodeBase58Check(
+          address_string, data, sizeof(data), &written)) ||
+      (written != sizeof(data))) {
+    return;
+  }
+  uint8_t prefix = data[0];
+  const NetworkParams* params = nullptr;
+  bool is_p2sh = false;
+  if (table != nullptr) {
+    int index = table->base58_index[prefix];
+    if (index >= 0) {
+      params = &table->format_list[index].GetNetworkParams();
+      is_p2sh = table->base58_is_p2sh[prefix];
+    }
+  } else {
+    for (const auto& format_data : *network_parameters) {
+      const NetworkParams& target = format_data.GetNetworkParams();
+      if (target.has_p2sh_prefix && (target.p2sh_prefix == prefix)) {
+        params = &target;
+        is_p2sh = true;
+        break;
+      } else if (target.has_p2pkh_prefix && (target.p2pkh_prefix == prefix)) {
+        params = &target;
+        break;
+      }
+    }
+  }
+  if ((params == nullptr) || (!params->has_net_type)) return;
+
+  size_t offset = 0;
+  if (is_p2sh) {
+    script[offset++] = kOpHash160;
+    script[offset++] = static_cast<uint8_t>(kByteData160Length);
+    memcpy(&script[offset], &data[1], kByteData160Length);
+    offset += kByteData160Length;
+    script[offset++] = kOpEqual;
+  } else {
+    script[offset++] = kOpDup;
+    script[offset++] = kOpHash160;
+    script[offset++] = static_cast<uint8_t>(kByteData160Length);
+    memcpy(&script[offset], &data[1], kByteData160Length);
+    offset += kByteData160Length;
+    script[offset++] = kOpEqualVerify;
+    script[offset++] = kOpCheckSig;
+  }
+  result->net_type = params->net_type;
+  result->address_type = (is_p2sh) ? kP2shAddress : kP2pkhAddress;
+  result->witness_version = kVersionNone;
+  result->locking_script_size = static_cast<uint32_t>(offset);
+  result->error = kCfdSuccess;
+}
+
+AddressParseResult Address::Parse(const std::string& address_string) {
+  AddressParseResult result;
+  memset(&result, 0, sizeof(result));
+  result.error = kCfdIllegalArgumentError;
+  result.witness_version = kVersionNone;
+  try {
+    auto table = GetBitcoinAddressFormatTable();
+    ParseAddressString(address_string, table.get(), nullptr, &result);
+  } catch (const CfdException& except) {
+    result.error = except.GetErrorCode();
+  } catch (...) {
+    result.error = kCfdUnknownError;
+  }
+  return result;
+}
+
+AddressParseResult Address::Parse(
+    const std::string& address_string,
+    const std::vector<AddressFormatData>& network_parameters) {
+  AddressParseResult result;
+  memset(&result, 0, sizeof(result));
+  result.error = kCfdIllegalArgumentError;
+  result.witness_version = kVersionNone;
+  try {
+    ParseAddressString(address_string, nullptr, &network_parameters, &result);
+  } catch (const CfdException& except) {
+    result.error = except.GetErrorCode();
+  } catch (...) {
+    result.error = kCfdUnknownError;
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+// AddressFactory
+// -----------------------------------------------------------------------------
+/// minimum address count per address factory worker thread
+static constexpr size_t kAddressCountPerThread = 128;
+
+/**
+ * @brief Calculate SHA-256 of the data list.
+ * @details The single block data is calculated on SIMD lanes.
+ * @param[in] data_list   data list
+ * @param[out] hashes     hash list (data_list.size() * 32 bytes)
+ */
+static void CalculateSha256List(
+    const std::vector<ByteData>& data_list, uint8_t* hashes) {
+  std::vector<const uint8_t*> messages;
+  std::vector<size_t> sizes;
+  std::vector<size_t> positions;
+  messages.reserve(data_list.size());
+  sizes.reserve(data_list.size());
+  positions.reserve(data_list.size());
+  uint32_t state[kSha256StateSize];
+  for (size_t index = 0; index < data_list.size(); ++index) {
+    ByteSpan data(data_list[index]);
+    if (data.size() <= kSha256SingleBlockMaxSize) {
+      messages.push_back(data.data());
+      sizes.push_back(data.size());
+      positions.push_back(index);
+    } else {
+      Sha256Initialize(state);
+      Sha256Finalize(
+          state, data.data(), data.size(), data.size(),
+          hashes + index * kByteData256Length);
+    }
+  }
+
+  std::vector<uint8_t> batch_hashes(messages.size() * kByteData256Length);
+  Sha256SingleBlockBatch(
+      messages.data(), sizes.data(), messages.size(), batch_hashes.data());
+  for (size_t index = 0; index < positions.size(); ++index) {
+    memcpy(
+        hashes + positions[index] * kByteData256Length,
+        &batch_hashes[index * kByteData256Length], kByteData256Length);
+  }
+}
+
+/**
+ * @brief Calculate RIPEMD-160 of the SHA-256 hash list.
+ * @param[in] sha256_list   SHA-256 hash list (count * 32 bytes)
+ * @param[in] count         hash count
+ * @param[out] hashes       hash list (count * 20 bytes)
+ */
+static void CalculateRipemd160List(
+    const uint8_t* sha256_list, size_t count, uint8_t* hashes) {
+  for (size_t index = 0; index < count; ++index) {
+    int ret = wally_ripemd160(
+        sha256_list + index * kByteData256Length, kByteData256Length,
+        hashes + index * kByteData160Length, kByteData160Length);
+    if (ret != WALLY_OK) {
+      warn(CFD_LOG_SOURCE, "wally_ripemd160 NG[{}].", ret);
+      throw CfdException(kCfdIllegalStateError, "hash160 calc error.");
+    }
+  }
+}
+
+std::vector<Address> AddressFactory::CreateBatch(
+    NetType net_type, AddressType address_type,
+    const std::vector<Pubkey>& pubkeys, uint32_t thread_count) {
+  return CreateAddressList(
+      net_type, address_type, &pubkeys, nullptr,
+      GetBitcoinAddressFormatTable()->format_list, thread_count);
+}
+
+std::vector<Address> AddressFactory::CreateBatch(
+    NetType net_type, AddressType address_type,
+    const std::vector<Pubkey>& pubkeys,
+    const std::vector<AddressFormatData>& network_parameters,
+    uint32_t thread_count) {
+  return CreateAddressList(
+      net_type, address_type, &pubkeys, nullptr, network_parameters,
+      thread_count);
+}
+
+std::vector<Address> AddressFactory::CreateBatch(
+    NetType net_type, AddressType address_type,
+    const std::vector<Script>& scripts, uint32_t thread_count) {
+  return CreateAddressList(
+      net_type, address_type, nullptr, &scripts,
+      GetBitcoinAddressFormatTable()->format_list, thread_count);
+}
+
+std::vector<Address> AddressFactory::CreateBatch(
+    NetType net_type, AddressType address_type,
+    const std::vector<Script>& scripts,
+    const std::vector<AddressFormatData>& network_parameters,
+    uint32_t thread_count) {
+  return CreateAddressList(
+      net_type, address_type, nullptr, &scripts, network_parameters,
+      thread_count);
+}
+
+std::vector<Address> AddressFactory::CreateAddressList(
+    NetType net_type, AddressType address_type,
+    const std::vector<Pubkey>* pubkeys, const std::vector<Script>* scripts,
+    const std::vector<AddressFormatData>& network_parameters,
+    uint32_t thread_count) {
+  bool is_pubkey = (pubkeys != nullptr);
+  bool is_supported = false;
+  if (is_pubkey) {
+    is_supported = (address_type == kP2pkhAddress) ||
+                   (address_type == kP2wpkhAddress) ||
+                   (address_type == kP2shP2wpkhAddress);
+  } else {
+    is_supported = (address_type == kP2shAddress) ||
+                   (address_type == kP2wshAddress) ||
+                   (address_type == kP2shP2wshAddress);
+  }
+  if (!is_supported) {
+    warn(CFD_LOG_SOURCE, "unsupported address type. type={}", address_type);
+    throw CfdException(
+        kCfdIllegalArgumentError, "Unsupported address type.");
+  }
+
+  const AddressFormatData format_data =
+      Address::GetTargetFormatData(network_parameters, net_type);
+  const bool is_segwit =
+      (address_type == kP2wpkhAddress) || (address_type == kP2wshAddress);
+  const bool is_wrapped = (address_type == kP2shP2wpkhAddress) ||
+                          (address_type == kP2shP2wshAddress);
+  uint8_t prefix = 0;
+  std::string hrp;
+  if (is_segwit) {
+    hrp = format_data.GetBech32Hrp();
+  } else if (address_type == kP2pkhAddress) {
+    prefix = format_data.GetP2pkhPrefix();
+  } else {
+    prefix = format_data.GetP2shPrefix();
+  }
+
+  size_t count = (is_pubkey) ? pubkeys->size() : scripts->size();
+  info(
+      CFD_LOG_SOURCE, "call AddressFactory::CreateBatch({},{},{})", net_type,
+      address_type, count);
+  std::vector<Address> result(count);
+  auto create = [&](size_t begin, size_t end) {
+    size_t size = end - begin;
+    std::vector<ByteData> data_list(size);
+    for (size_t index = 0; index < size; ++index) {
+      data_list[index] = (is_pubkey) ? (*pubkeys)[begin + index].GetData()
+                                     : (*scripts)[begin + index].GetData();
+    }
+    std::vector<uint8_t> sha256_list(size * kByteData256Length);
+    CalculateSha256List(data_list, sha256_list.data());
+
+    // p2wsh uses sha256, and the others use hash160.
+    size_t hash_size = kByteData160Length;
+    std::vector<uint8_t> hash_list(size * kByteData160Length);
+    if (address_type == kP2wshAddress) {
+      hash_size = kByteData256Length;
+      hash_list.swap(sha256_list);
+    } else if (address_type != kP2shP2wshAddress) {
+      CalculateRipemd160List(sha256_list.data(), size, hash_list.data());
+    }
+
+    std::vector<Script> wrapped_scripts;
+    if (is_wrapped) {
+      // redeem script is the witness program.
+      const uint8_t* program_list = (address_type == kP2shP2wpkhAddress)
+                                        ? hash_list.data()
+                                        : sha256_list.data();
+      size_t program_size = (address_type == kP2shP2wpkhAddress)
+                                ? kByteData160Length
+                                : kByteData256Length;
+      uint8_t program[kByteData256Length + 2];
+      program[0] = static_cast<uint8_t>(kOp_0);
+      program[1] = static_cast<uint8_t>(program_size);
+      wrapped_scripts.resize(size);
+      for (size_t index = 0; index < size; ++index) {
+        memcpy(
+            &program[2], program_list + index * program_size, program_size);
+        data_list[index] =
+            ByteData(program, static_cast<uint32_t>(program_size + 2));
+        wrapped_scripts[index] = Script(data_list[index]);
+      }
+      CalculateSha256List(data_list, sha256_list.data());
+      CalculateRipemd160List(sha256_list.data(), size, hash_list.data());
+    }
+
+    std::vector<ByteData> encode_list(size);
+    for (size_t index = 0; index < size; ++index) {
+      uint8_t buffer[kByteData256Length + 2];
+      size_t offset = 0;
+      if (is_segwit) {
+        buffer[offset++] = static_cast<uint8_t>(kOp_0);
+        buffer[offset++] = static_cast<uint8_t>(hash_size);
+      } else {
+        buffer[offset++] = prefix;
+      }
+      memcpy(&buffer[offset], &hash_list[index * hash_size], hash_size);
+      encode_list[index] =
+          ByteData(buffer, static_cast<uint32_t>(offset + hash_size));
+    }
+    std::vector<std::string> addresses =
+        (is_segwit) ? Bech32Util::EncodeSegwitAddresses(hrp, encode_list)
+                    : CryptoUtil::EncodeBase58CheckBatch(encode_list);
+
+    for (size_t index = 0; index < size; ++index) {
+      Address& address = result[begin + index];
+      address.type_ = format_data.GetNetType();
+      address.addr_type_ = address_type;
+      address.witness_ver_ = (is_segwit) ? kVersion0 : kVersionNone;
+      address.address_.swap(addresses[index]);
+      address.hash_ = ByteData(
+          &hash_list[index * hash_size], static_cast<uint32_t>(hash_size));
+      if (is_pubkey) {
+        address.pubkey_ = (*pubkeys)[begin + index];
+      } else {
+        address.redeem_script_ = (*scripts)[begin + index];
+      }
+      if (is_wrapped) address.redeem_script_ = wrapped_scripts[index];
+      address.format_data_ = format_data;
+    }
+  };
+
+  ParallelFor(count, thread_count, kAddressCountPerThread, create);
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+// Bech32Util
+// -----------------------------------------------------------------------------
+//! bech32 character table
+static constexpr const char kBech32CharTable[] =
+    "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+//! bech32 value table (0xff is invalid character)
+static constexpr uint8_t kBech32ValueTable[128] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0x0f, 0xff, 0x0a, 0x11, 0x15, 0x14, 0x1a, 0x1e, 0x07, 0x05, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x1d, 0xff, 0x18, 0x0d, 0x19, 0x09, 0x08,
+    0x17, 0xff, 0x12, 0x16, 0x1f, 0x1b, 0x13, 0xff, 0x01, 0x00, 0x03, 0x10,
+    0x0b, 0x1c, 0x0c, 0x0e, 0x06, 0x04, 0x02, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x1d, 0xff, 0x18, 0x0d, 0x19, 0x09, 0x08, 0x17, 0xff, 0x12, 0x16,
+    0x1f, 0x1b, 0x13, 0xff, 0x01, 0x00, 0x03, 0x10, 0x0b, 0x1c, 0x0c, 0x0e,
+    0x06, 0x04, 0x02, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+//! bech32 delimiter
+static constexpr char kBech32Delimiter = '1';
+//! maximum blech32 payload size (confidential key + witness program)
+static constexpr size_t kBlech32MaxPayloadSize =
+    Pubkey::kCompressedPubkeySize + Bech32Util::kMaxWitnessProgramSize;
+//! maximum size of 5bit data (blech32: version + payload + checksum)
+static constexpr size_t kBech32MaxDataSize =
+    1 + (((kBlech32MaxPayloadSize * 8) + 4) / 5) + 12;
+
+/**
+ * @brief bech32 checksum calculator.
+ */
+struct Bech32Checksum {
+  using Type = uint32_t;                           //!< checksum type
+  static constexpr size_t kChecksumSize = 6;       //!< checksum length
+  static constexpr size_t kMaxLength = 90;         //!< maximum length
+  static constexpr Type kBech32Const = 1;          //!< bech32 constant
+  static constexpr Type kBech32mConst = 0x2bc830a3;  //!< bech32m constant
+  //! generator table (index: top 5bit)
+  static constexpr Type kGeneratorTable[32] = {
+      0x00000000, 0x3b6a57b2, 0x26508e6d, 0x1d3ad9df, 0x1ea119fa, 0x25cb4e48,
+      0x38f19797, 0x039bc025, 0x3d4233dd, 0x0628646f, 0x1b12bdb0, 0x2078ea02,
+      0x23e32a27, 0x18897d95, 0x05b3a44a, 0x3ed9f3f8, 0x2a1462b3, 0x117e3501,
+      0x0c44ecde, 0x372ebb6c, 0x34b57b49, 0x0fdf2cfb, 0x12e5f524, 0x298fa296,
+      0x1756516e, 0x2c3c06dc, 0x3106df03, 0x0a6c88b1, 0x09f74894, 0x329d1f26,
+      0x2fa7c6f9, 0x14cd914b,
+  };
+  /**
+   * @brief Update the checksum.
+   * @param[in] checksum  checksum
+   * @param[in] value     5bit value
+   * @return checksum
+   */
+  static inline Type Update(Type checksum, uint8_t value) {
+    return ((checksum & 0x1ffffff) << 5) ^ value ^
+           kGeneratorTable[checksum >> 25];
+  }
+};
+constexpr Bech32Checksum::Type Bech32Checksum::kGeneratorTable[32];
+
+#ifndef CFD_DISABLE_ELEMENTS
+/**
+ * @brief blech32 checksum calculator.
+ */
+struct Blech32Checksum {
+  using Type = uint64_t;                              //!< checksum type
+  static constexpr size_t kChecksumSize = 12;         //!< checksum length
+  static constexpr size_t kMaxLength = 1000;          //!< maximum length
+  static constexpr Type kBech32Const = 1;             //!< blech32 constant
+  static constexpr Type kBech32mConst = 0x455972a3350f7a1;  //!< blech32m
+  //! generator table (index: top 5bit)
+  static constexpr Type kGeneratorTable[32] = {
+      0x00000000000000, 0x7d52fba40bd886, 0x5e8dbf1a03950c, 0x23df44be084d8a,
+      0x1c3a3c74072a18, 0x6168c7d00cf29e, 0x42b7836e04bf14, 0x3fe578ca0f6792,
+      0x385d72fa0e5139, 0x450f895e0589bf, 0x66d0cde00dc435, 0x1b823644061cb3,
+      0x24674e8e097b21, 0x5935b52a02a3a7, 0x7aeaf1940aee2d, 0x07b80a300136ab,
+      0x7093e5a608865b, 0x0dc11e02035edd, 0x2e1e5abc0b1357, 0x534ca11800cbd1,
+      0x6ca9d9d20fac43, 0x11fb22760474c5, 0x322466c80c394f, 0x4f769d6c07e1c9,
+      0x48ce975c06d762, 0x359c6cf80d0fe4, 0x1643284605426e, 0x6b11d3e20e9ae8,
+      0x54f4ab2801fd7a, 0x29a6508c0a25fc, 0x0a791432026876, 0x772bef9609b0f0,
+  };
+  /**
+   * @brief Update the checksum.
+   * @param[in] checksum  checksum
+   * @param[in] value     5bit value
+   * @return checksum
+   */
+  static inline Type Update(Type checksum, uint8_t value) {
+    return ((checksum & 0x7fffffffffffff) << 5) ^ value ^
+           kGeneratorTable[checksum >> 55];
+  }
+};
+constexpr Blech32Checksum::Type Blech32Checksum::kGeneratorTable[32];
+#endif  // CFD_DISABLE_ELEMENTS
+
+/**
+ * @brief Calculate the checksum state of hrp.
+ * @details The upper case characters are treated as lower case.
+ * @param[in] hrp       hrp
+ * @param[in] hrp_size  hrp size
+ * @return checksum state
+ */
+template <class Checksum>
+static typename Checksum::Type GetBech32HrpChecksum(
+    const char* hrp, size_t hrp_size) {
+  typename Checksum::Type checksum = 1;
+  for (size_t index = 0; index < hrp_size; ++index) {
+    char character = hrp[index];
+    if ((character >= 'A') && (character <= 'Z')) character += ('a' - 'A');
+    checksum = Checksum::Update(checksum, static_cast<uint8_t>(character) >> 5);
+  }
+  checksum = Checksum::Update(checksum, 0);
+  for (size_t index = 0; index < hrp_size; ++index) {
+    checksum = Checksum::Update(checksum, hrp[index] & 0x1f);
+  }
+  return checksum;
+}
+
+/**
+ * @brief Convert the hrp to lower case with validation.
+ * @param[in] hrp   hrp
+ * @return lower case hrp
+ * @throws CfdException   If invalid hrp.
+ */
+static std::string ConvertBech32Hrp(const std::string& hrp) {
+  std::string result = hrp;
+  bool is_valid = !hrp.empty();
+  for (auto& character : result) {
+    if ((character < 33) || (character > 126)) is_valid = false;
+    if ((character >= 'A') && (character <= 'Z')) character += ('a' - 'A');
+  }
+  if (!is_valid) {
+    warn(CFD_LOG_SOURCE, "invalid bech32 hrp. hrp={}", hrp);
+    throw CfdException(kCfdIllegalArgumentError, "Invalid bech32 hrp.");
+  }
+  return result;
+}
+
+/**
+ * @brief Convert the bit group size.
+ * @param[in] input         input data
+ * @param[in] input_size    input data size
+ * @param[out] output       output data
+ * @param[in,out] output_size  output data size
+ * @param[in] is_padding    padding flag (true: 8bit to 5bit)
+ * @retval true   success
+ * @retval false  invalid padding
+ */
+template <int kFromBits, int kToBits>
+static bool ConvertBech32Bits(
+    const uint8_t* input, size_t input_size, uint8_t* output,
+    size_t* output_size, bool is_padding) {
+  static constexpr uint32_t kMaxValue = (1 << kToBits) - 1;
+  uint32_t accumulator = 0;
+  int bits = 0;
+  size_t size = *output_size;
+  for (size_t index = 0; index < input_size; ++index) {
+    accumulator = (accumulator << kFromBits) | input[index];
+    bits += kFromBits;
+    while (bits >= kToBits) {
+      bits -= kToBits;
+      output[size++] = (accumulator >> bits) & kMaxValue;
+    }
+  }
+  if (is_padding) {
+    if (bits != 0) output[size++] = (accumulator << (kToBits - bits)) & kMaxValue;
+  } else if ((bits >= kFromBits) ||
+             (((accumulator << (kToBits - bits)) & kMaxValue) != 0)) {
+    return false;
+  }
+  *output_size = size;
+  return true;
+}
+
+/**
+ * @brief Split the witness script into version and program.
+ * @param[in] witness_script  witness script
+ * @param[out] version        witness version
+ * @param[out] program        witness program
+ * @param[out] program_size   witness program size
+ * @throws CfdException   If invalid witness script.
+ */
+static void SplitWitnessScript(
+    const std::vector<uint8_t>& witness_script, uint8_t* version,
+    const uint8_t** program, size_t* program_size) {
+  bool is_valid = false;
+  if ((witness_script.size() >= 4) &&
+      (witness_script.size() <= Bech32Util::kMaxWitnessScriptSize) &&
+      (witness_script[1] == witness_script.size() - 2)) {
+    uint8_t op_code = witness_script[0];
+    if (op_code == 0) {
+      *version = 0;
+      is_valid =
+          ((witness_script[1] == kByteData160Length) ||
+           (witness_script[1] == kByteData256Length));
+    } else if ((op_code >= kOp_1) && (op_code <= kOp_16)) {
+      *version = static_cast<uint8_t>(op_code - (kOp_1 - 1));
+      is_valid = true;
+    }
+  }
+  if (!is_valid) {
+    warn(CFD_LOG_SOURCE, "invalid witness script.");
+    throw CfdException(
+        kCfdIllegalArgumentError, "Segwit-address create error.");
+  }
+  *program = &witness_script[2];
+  *program_size = witness_script.size() - 2;
+}
+
+/**
+ * @brief Encode to bech32 and append to the string.
+ * @param[in] hrp           hrp (lower case)
+ * @param[in] hrp_checksum  checksum state of hrp
+ * @param[in] data          5bit data
+ * @param[in] data_size     5bit data size
+ * @param[out] output       output string
+ */
+template <class Checksum>
+static void EncodeBech32Data(
+    const std::string& hrp, typename Checksum::Type hrp_checksum,
+    const uint8_t* data, size_t data_size, std::string* output) {
+  typename Checksum::Type checksum = hrp_checksum;
+  output->reserve(hrp.size() + 1 + data_size + Checksum::kChecksumSize);
+  output->append(hrp);
+  output->push_back(kBech32Delimiter);
+  for (size_t index = 0; index < data_size; ++index) {
+    checksum = Checksum::Update(checksum, data[index]);
+    output->push_back(kBech32CharTable[data[index]]);
+  }
+  for (size_t index = 0; index < Checksum::kChecksumSize; ++index) {
+    checksum = Checksum::Update(checksum, 0);
+  }
+  // witness version 0 is bech32, other is bech32m.
+  checksum ^= (data[0] == 0) ? Checksum::kBech32Const : Checksum::kBech32mConst;
+  for (size_t index = 0; index < Checksum::kChecksumSize; ++index) {
+    size_t shift = 5 * (Checksum::kChecksumSize - 1 - index);
+    output->push_back(kBech32CharTable[(checksum >> shift) & 0x1f]);
+  }
+}
+
+/**
+ * @brief Decode from bech32.
+ * @param[in] hrp         hrp
+ * @param[in] hrp_size    hrp size
+ * @param[in] address     bech32 string
+ * @param[out] data       5bit data (without checksum)
+ * @param[out] data_size  5bit data size
+ * @retval true   success
+ * @retval false  invalid string
+ */
+template <class Checksum>
+static bool DecodeBech32Data(
+    const char* hrp, size_t hrp_size, const std::string& address,
+    uint8_t* data, size_t* data_size) {
+  if ((hrp == nullptr) || (address.size() > Checksum::kMaxLength) ||
+      (hrp_size == 0) ||
+      (address.size() < hrp_size + 1 + Checksum::kChecksumSize + 1) ||
+      (address.size() - hrp_size - 1 > kBech32MaxDataSize) ||
+      (address.rfind(kBech32Delimiter) != hrp_size)) {
+    return false;
+  }
+
+  bool has_lower = false;
+  bool has_upper = false;
+  for (size_t index = 0; index < hrp_size; ++index) {
+    char character = address[index];
+    if ((character < 33) || (character > 126)) return false;
+    if ((character >= 'A') && (character <= 'Z')) {
+      has_upper = true;
+      character += ('a' - 'A');
+    } else if ((character >= 'a') && (character <= 'z')) {
+      has_lower = true;
+    }
+    char hrp_char = hrp[index];
+    if ((hrp_char >= 'A') && (hrp_char <= 'Z')) hrp_char += ('a' - 'A');
+    if (character != hrp_char) return false;
+  }
+  typename Checksum::Type checksum =
+      GetBech32HrpChecksum<Checksum>(address.data(), hrp_size);
+
+  size_t size = 0;
+  for (size_t index = hrp_size + 1; index < address.size(); ++index) {
+    uint8_t character = static_cast<uint8_t>(address[index]);
+    if ((character >= 'A') && (character <= 'Z')) has_upper = true;
+    if ((character >= 'a') && (character <= 'z')) has_lower = true;
+    uint8_t value = (character < 128) ? kBech32ValueTable[character] : 0xff;
+    if (value == 0xff) return false;
+    checksum = Checksum::Update(checksum, value);
+    data[size++] = value;
+  }
+  if (has_lower && has_upper) return false;
+
+  size -= Checksum::kChecksumSize;
+  typename Checksum::Type expect_const =
+      (data[0] == 0) ? Checksum::kBech32Const : Checksum::kBech32mConst;
+  if (checksum != expect_const) return false;
+  *data_size = size;
+  return true;
+}
+
+/**
+ * @brief Set the witness script.
+ * @param[in] version         witness version
+ * @param[in] program         witness program
+ * @param[in] program_size    witness program size
+ * @param[out] witness_script witness script buffer
+ * @param[in] buffer_size     witness script buffer size
+ * @param[out] written        witness script size
+ * @retval true   success
+ * @retval false  invalid program
+ */
+static bool SetWitnessScript(
+    uint8_t version, const uint8_t* program, size_t program_size,
+    uint8_t* witness_script, size_t buffer_size, size_t* written) {
+  if ((version > 16) || (program_size < 2) ||
+      (program_size > Bech32Util::kMaxWitnessProgramSize) ||
+      ((version == 0) && (program_size != kByteData160Length) &&
+       (program_size != kByteData256Length)) ||
+      (buffer_size < program_size + 2)) {
+    return false;
+  }
+  witness_script[0] =
+      (version == 0) ? 0 : static_cast<uint8_t>(version + (kOp_1 - 1));
+  witness_script[1] = static_cast<uint8_t>(program_size);
+  memcpy(&witness_script[2], program, program_size);
+  if (written != nullptr) *written = program_size + 2;
+  return true;
+}
+
+std::string Bech32Util::EncodeSegwitAddress(
+    const std::string& hrp, const ByteData& witness_script) {
+  return EncodeSegwitAddresses(hrp, {witness_script})[0];
+}
+
+std::vector<std::string> Bech32Util::EncodeSegwitAddresses(
+    const std::string& hrp,
+    const std::vector<ByteData>& witness_script_list) {
+  std::string lower_hrp = ConvertBech32Hrp(hrp);
+  // hrp's checksum state is common.
+  Bech32Checksum::Type hrp_checksum = GetBech32HrpChecksum<Bech32Checksum>(
+      lower_hrp.data(), lower_hrp.size());
+
+  std::vector<std::string> result(witness_script_list.size());
+  uint8_t data[kBech32MaxDataSize];
+  uint8_t version = 0;
+  const uint8_t* program = nullptr;
+  size_t program_size = 0;
+  for (size_t index = 0; index < witness_script_list.size(); ++index) {
+    std::vector<uint8_t> witness_script =
+        witness_script_list[index].GetBytes();
+    SplitWitnessScript(witness_script, &version, &program, &program_size);
+    data[0] = version;
+    size_t data_size = 1;
+    ConvertBech32Bits<8, 5>(program, program_size, data, &data_size, true);
+    EncodeBech32Data<Bech32Checksum>(
+        lower_hrp, hrp_checksum, data, data_size, &result[index]);
+    if (result[index].size() > Bech32Checksum::kMaxLength) {
+      warn(CFD_LOG_SOURCE, "segwit address is too long.");
+      throw CfdException(
+          kCfdIllegalArgumentError, "Segwit-address create error.");
+    }
+  }
+  return result;
+}
+
+bool Bech32Util::DecodeSegwitAddress(
+    const std::string& hrp, const std::string& address,
+    uint8_t* witness_script, size_t buffer_size, size_t* written) {
+  return DecodeSegwitAddress(
+      hrp.data(), hrp.size(), address, witness_script, buffer_size, written);
+}
+
+bool Bech32Util::DecodeSegwitAddress(
+    const char* hrp, size_t hrp_size, const std::string& address,
+    uint8_t* witness_script, size_t buffer_size, size_t* written) {
+  uint8_t data[kBech32MaxDataSize];
+  size_t data_size = 0;
+  uint8_t program[kBech32MaxDataSize];
+  size_t program_size = 0;
+  if ((witness_script == nullptr) ||
+      (!DecodeBech32Data<Bech32Checksum>(
+          hrp, hrp_size, address, data, &data_size)) ||
+      (data_size == 0) ||
+      (!ConvertBech32Bits<5, 8>(
+          &data[1], data_size - 1, program, &program_size, false))) {
+    return false;
+  }
+  return SetWitnessScript(
+      data[0], program, program_size, witness_script, buffer_size, written);
+}
+
+#ifndef CFD_DISABLE_ELEMENTS
+std::string Bech32Util::EncodeBlindedSegwitAddress(
+    const std::string& hrp, const ByteData& witness_script,
+    const Pubkey& confidential_key) {
+  std::string lower_hrp = ConvertBech32Hrp(hrp);
+  std::vector<uint8_t> key = confidential_key.GetData().GetBytes();
+  if (key.size() != Pubkey::kCompressedPubkeySize) {
+    warn(CFD_LOG_SOURCE, "confidential key is not compressed.");
+    throw CfdException(
+        kCfdIllegalArgumentError, "Segwit-address create error.");
+  }
+  std::vector<uint8_t> script = witness_script.GetBytes();
+  uint8_t version = 0;
+  const uint8_t* program = nullptr;
+  size_t program_size = 0;
+  SplitWitnessScript(script, &version, &program, &program_size);
+
+  // confidential key + witness program
+  std::vector<uint8_t> payload(key);
+  payload.insert(payload.end(), program, program + program_size);
+  uint8_t data[kBech32MaxDataSize];
+  data[0] = version;
+  size_t data_size = 1;
+  ConvertBech32Bits<8, 5>(
+      payload.data(), payload.size(), data, &data_size, true);
+  std::string result;
+  EncodeBech32Data<Blech32Checksum>(
+      lower_hrp,
+      GetBech32HrpChecksum<Blech32Checksum>(
+          lower_hrp.data(), lower_hrp.size()),
+      data, data_size, &result);
+  return result;
+}
+
+bool Bech32Util::DecodeBlindedSegwitAddress(
+    const std::string& hrp, const std::string& address,
+    uint8_t* witness_script, size_t buffer_size, size_t* written,
+    uint8_t* confidential_key) {
+  uint8_t data[kBech32MaxDataSize];
+  size_t data_size = 0;
+  uint8_t payload[kBech32MaxDataSize];
+  size_t payload_size = 0;
+  if ((witness_script == nullptr) || (confidential_key == nullptr) ||
+      (!DecodeBech32Data<Blech32Checksum>(
+          hrp.data(), hrp.size(), address, data, &data_size)) ||
+      (data_size == 0) ||
+      (!ConvertBech32Bits<5, 8>(
+          &data[1], data_size - 1, payload, &payload_size, false)) ||
+      (payload_size <= Pubkey::kCompressedPubkeySize)) {
+    return false;
+  }
+  if (!SetWitnessScript(
+          data[0], &payload[Pubkey::kCompressedPubkeySize],
+          payload_size - Pubkey::kCompressedPubkeySize, witness_script,
+          buffer_size, written)) {
+    return false;
+  }
+  memcpy(confidential_key, payload, Pubkey::kCompressedPubkeySize);
+  return true;
+}
+#endif  // CFD_DISABLE_ELEMENTS
+
 }  // namespace core
 }  // namespace cfd
@@ -0,0 +1,747 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_aes.cpp
+ *
+ * @brief AES-256 block functions for streaming cipher contexts.
+ */
+#include "cfdcore_aes.h"  // NOLINT
+
+#include <cstring>
+
+#include "cfdcore_cpu.h"  // NOLINT
+
+namespace cfd {
+namespace core {
+
+/// block count of the keystream buffer
+static constexpr size_t kAesCtrBufferBlockCount = 32;
+
+// ----------------------------------------------------------------------------
+// constant-time software implementation
+// ----------------------------------------------------------------------------
+// 4 blocks are bitsliced into 8 planes. (plane k has the bit k of 64 bytes)
+// The bit index of a plane is the byte index of the blocks, and the S-box is
+// calculated by the GF(2^8) inversion without table lookup.
+
+/// bitsliced block count
+static constexpr size_t kBitsliceBlockCount = 4;
+/// bitsliced plane count
+static constexpr size_t kBitslicePlaneCount = 8;
+/// row 0 mask of the bitsliced plane
+static constexpr uint64_t kBitsliceRowMask = 0x1111111111111111ULL;
+/// lowest bit of each 16bit lane (a block)
+static constexpr uint64_t kBitsliceBlockLowBit = 0x0001000100010001ULL;
+
+/**
+ * @brief Transpose the 8x8 bit matrix.
+ * @details The bit (8 * i + j) is moved to the bit (8 * j + i).
+ * @param[in] value   value
+ * @return value
+ */
+static inline uint64_t Transpose8x8(uint64_t value) {
+  uint64_t temp = (value ^ (value >> 7)) & 0x00aa00aa00aa00aaULL;
+  value ^= temp ^ (temp << 7);
+  temp = (value ^ (value >> 14)) & 0x0000cccc0000ccccULL;
+  value ^= temp ^ (temp << 14);
+  temp = (value ^ (value >> 28)) & 0x00000000f0f0f0f0ULL;
+  value ^= temp ^ (temp << 28);
+  return value;
+}
+
+/**
+ * @brief Convert 4 blocks to the bitsliced planes.
+ * @param[in] blocks    blocks (64 bytes)
+ * @param[out] planes   planes
+ */
+static void BitsliceBlocks(const uint8_t *blocks, uint64_t *planes) {
+  for (size_t bit = 0; bit < kBitslicePlaneCount; ++bit) planes[bit] = 0;
+  for (size_t word = 0; word < kBitslicePlaneCount; ++word) {
+    uint64_t value = 0;
+    for (size_t index = 0; index < 8; ++index) {
+      value |= static_cast<uint64_t>(blocks[word * 8 + index]) << (index * 8);
+    }
+    value = Transpose8x8(value);
+    for (size_t bit = 0; bit < kBitslicePlaneCount; ++bit) {
+      planes[bit] |= ((value >> (bit * 8)) & 0xff) << (word * 8);
+    }
+  }
+}
+
+/**
+ * @brief Convert the bitsliced planes to 4 blocks.
+ * @param[in] planes    planes
+ * @param[out] blocks   blocks (64 bytes)
+ */
+static void UnbitsliceBlocks(const uint64_t *planes, uint8_t *blocks) {
+  for (size_t word = 0; word < kBitslicePlaneCount; ++word) {
+    uint64_t value = 0;
+    for (size_t bit = 0; bit < kBitslicePlaneCount; ++bit) {
+      value |= ((planes[bit] >> (word * 8)) & 0xff) << (bit * 8);
+    }
+    value = Transpose8x8(value);
+    for (size_t index = 0; index < 8; ++index) {
+      blocks[word * 8 + index] = static_cast<uint8_t>(value >> (index * 8));
+    }
+  }
+}
+
+/**
+ * @brief Multiply in GF(2^8). (bitsliced)
+ * @param[in] left      planes
+ * @param[in] right     planes
+ * @param[out] output   planes (can be the same as the input)
+ */
+static void GfMultiplyBitsliced(
+    const uint64_t *left, const uint64_t *right, uint64_t *output) {
+  const uint64_t a0 = left[0], a1 = left[1], a2 = left[2], a3 = left[3];
+  const uint64_t a4 = left[4], a5 = left[5], a6 = left[6], a7 = left[7];
+  const uint64_t b0 = right[0], b1 = right[1], b2 = right[2], b3 = right[3];
+  const uint64_t b4 = right[4], b5 = right[5], b6 = right[6], b7 = right[7];
+  const uint64_t c0 = (a0 & b0);
+  const uint64_t c1 = (a0 & b1) ^ (a1 & b0);
+  const uint64_t c2 = (a0 & b2) ^ (a1 & b1) ^ (a2 & b0);
+  const uint64_t c3 = (a0 & b3) ^ (a1 & b2) ^ (a2 & b1) ^ (a3 & b0);
+  const uint64_t c4 = (a0 & b4) ^ (a1 & b3) ^ (a2 & b2) ^ (a3 & b1) ^ (a4 & b0);
+  const uint64_t c5 =
+      (a0 & b5) ^ (a1 & b4) ^ (a2 & b3) ^ (a3 & b2) ^ (a4 & b1) ^ (a5 & b0);
+  const uint64_t c6 =
+      (a0 & b6) ^ (a1 & b5) ^ (a2 & b4) ^ (a3 & b3) ^ (a4 & b2) ^ (a5 & b1) ^
+      (a6 & b0);
+  const uint64_t c7 =
+      (a0 & b7) ^ (a1 & b6) ^ (a2 & b5) ^ (a3 & b4) ^ (a4 & b3) ^ (a5 & b2) ^
+      (a6 & b1) ^ (a7 & b0);
+  const uint64_t c8 =
+      (a1 & b7) ^ (a2 & b6) ^ (a3 & b5) ^ (a4 & b4) ^ (a5 & b3) ^ (a6 & b2) ^
+      (a7 & b1);
+  const uint64_t c9 =
+      (a2 & b7) ^ (a3 & b6) ^ (a4 & b5) ^ (a5 & b4) ^ (a6 & b3) ^ (a7 & b2);
+  const uint64_t c10 =
+      (a3 & b7) ^ (a4 & b6) ^ (a5 & b5) ^ (a6 & b4) ^ (a7 & b3);
+  const uint64_t c11 = (a4 & b7) ^ (a5 & b6) ^ (a6 & b5) ^ (a7 & b4);
+  const uint64_t c12 = (a5 & b7) ^ (a6 & b6) ^ (a7 & b5);
+  const uint64_t c13 = (a6 & b7) ^ (a7 & b6);
+  const uint64_t c14 = (a7 & b7);
+  // x^8 = x^4 + x^3 + x + 1
+  output[0] = c0 ^ c8 ^ c12 ^ c13;
+  output[1] = c1 ^ c8 ^ c9 ^ c12 ^ c14;
+  output[2] = c2 ^ c9 ^ c10 ^ c13;
+  output[3] = c3 ^ c8 ^ c10 ^ c11 ^ c12 ^ c13 ^ c14;
+  output[4] = c4 ^ c8 ^ c9 ^ c11 ^ c14;
+  output[5] = c5 ^ c9 ^ c10 ^ c12;
+  output[6] = c6 ^ c10 ^ c11 ^ c13;
+  output[7] = c7 ^ c11 ^ c12 ^ c14;
+}
+
+/**
+ * @brief Square in GF(2^8). (bitsliced)
+ * @param[in] value     planes
+ * @param[out] output   planes (can be the same as the input)
+ */
+static void GfSquareBitsliced(const uint64_t *value, uint64_t *output) {
+  // squaring is linear in GF(2^8).
+  const uint64_t a0 = value[0], a1 = value[1], a2 = value[2], a3 = value[3];
+  const uint64_t a4 = value[4], a5 = value[5], a6 = value[6], a7 = value[7];
+  output[0] = a0 ^ a4 ^ a6;
+  output[1] = a4 ^ a6 ^ a7;
+  output[2] = a1 ^ a5;
+  output[3] = a4 ^ a5 ^ a6 ^ a7;
+  output[4] = a2 ^ a4 ^ a7;
+  output[5] = a5 ^ a6;
+  output[6] = a3 ^ a5;
+  output[7] = a6 ^ a7;
+}
+
+/**
+ * @brief Invert in GF(2^8) as x^254. (bitsliced)
+ * @param[in,out] planes    planes (0 is mapped to 0)
+ */
+static void GfInvertBitsliced(uint64_t *planes) {
+  uint64_t x2[kBitslicePlaneCount];
+  uint64_t x3[kBitslicePlaneCount];
+  uint64_t x12[kBitslicePlaneCount];
+  uint64_t work[kBitslicePlaneCount];
+  GfSquareBitsliced(planes, x2);
+  GfMultiplyBitsliced(x2, planes, x3);
+  GfSquareBitsliced(x3, x12);
+  GfSquareBitsliced(x12, x12);
+  GfMultiplyBitsliced(x12, x3, work);  // x^15
+  for (int count = 0; count < 4; ++count) {
+    GfSquareBitsliced(work, work);  // x^240
+  }
+  GfMultiplyBitsliced(work, x12, work);    // x^252
+  GfMultiplyBitsliced(work, x2, planes);   // x^254
+}
+
+/**
+ * @brief Apply the S-box. (bitsliced)
+ * @param[in,out] planes    planes
+ */
+static void SubBytesBitsliced(uint64_t *planes) {
+  GfInvertBitsliced(planes);
+  uint64_t inverse[kBitslicePlaneCount];
+  memcpy(inverse, planes, sizeof(inverse));
+  for (size_t bit = 0; bit < kBitslicePlaneCount; ++bit) {
+    planes[bit] = inverse[bit] ^ inverse[(bit + 7) % 8] ^
+                  inverse[(bit + 6) % 8] ^ inverse[(bit + 5) % 8] ^
+                  inverse[(bit + 4) % 8];
+  }
+  // 0x63
+  planes[0] = ~planes[0];
+  planes[1] = ~planes[1];
+  planes[5] = ~planes[5];
+  planes[6] = ~planes[6];
+}
+
+/**
+ * @brief Apply the inverse S-box. (bitsliced)
+ * @param[in,out] planes    planes
+ */
+static void InvSubBytesBitsliced(uint64_t *planes) {
+  uint64_t value[kBitslicePlaneCount];
+  memcpy(value, planes, sizeof(value));
+  for (size_t bit = 0; bit < kBitslicePlaneCount; ++bit) {
+    planes[bit] =
+        value[(bit + 7) % 8] ^ value[(bit + 5) % 8] ^ value[(bit + 2) % 8];
+  }
+  // 0x05
+  planes[0] = ~planes[0];
+  planes[2] = ~planes[2];
+  GfInvertBitsliced(planes);
+}
+
+/**
+ * @brief Rotate the columns in each block. (bitsliced)
+ * @param[in] value   plane
+ * @param[in] count   rotate bit count (4: 1 column)
+ * @return plane
+ */
+static inline uint64_t RotateColumnsBitsliced(uint64_t value, int count) {
+  const uint64_t low_mask = kBitsliceBlockLowBit * (0xffffU >> count);
+  return ((value >> count) & low_mask) | ((value << (16 - count)) & ~low_mask);
+}
+
+/**
+ * @brief Apply ShiftRows (or InvShiftRows). (bitsliced)
+ * @param[in,out] planes  planes
+ * @param[in] is_inverse  use InvShiftRows
+ */
+static void ShiftRowsBitsliced(uint64_t *planes, bool is_inverse) {
+  const int row1_count = (is_inverse) ? 12 : 4;
+  const int row3_count = (is_inverse) ? 4 : 12;
+  for (size_t bit = 0; bit < kBitslicePlaneCount; ++bit) {
+    const uint64_t value = planes[bit];
+    planes[bit] =
+        (value & kBitsliceRowMask) |
+        (RotateColumnsBitsliced(value, row1_count) & (kBitsliceRowMask << 1)) |
+        (RotateColumnsBitsliced(value, 8) & (kBitsliceRowMask << 2)) |
+        (RotateColumnsBitsliced(value, row3_count) & (kBitsliceRowMask << 3));
+  }
+}
+
+/**
+ * @brief Rotate the rows in each column. (bitsliced)
+ * @details The row r gets the byte of the row (r + 1) % 4.
+ * @param[in] value   plane
+ * @return plane
+ */
+static inline uint64_t RotateRowsBitsliced(uint64_t value) {
+  return ((value >> 1) & 0x7777777777777777ULL) |
+         ((value << 3) & 0x8888888888888888ULL);
+}
+
+/**
+ * @brief Multiply by x in GF(2^8). (bitsliced)
+ * @param[in,out] planes    planes
+ */
+static inline void XtimeBitsliced(uint64_t *planes) {
+  const uint64_t high = planes[7];
+  for (size_t bit = 7; bit > 0; --bit) planes[bit] = planes[bit - 1];
+  planes[0] = high;
+  planes[1] ^= high;
+  planes[3] ^= high;
+  planes[4] ^= high;
+}
+
+/**
+ * @brief Apply MixColumns. (bitsliced)
+ * @param[in,out] planes    planes
+ */
+static void MixColumnsBitsliced(uint64_t *planes) {
+  uint64_t sum[kBitslicePlaneCount];
+  uint64_t pair[kBitslicePlaneCount];
+  for (size_t bit = 0; bit < kBitslicePlaneCount; ++bit) {
+    const uint64_t row1 = RotateRowsBitsliced(planes[bit]);
+    const uint64_t row2 = RotateRowsBitsliced(row1);
+    const uint64_t row3 = RotateRowsBitsliced(row2);
+    sum[bit] = row1 ^ row2 ^ row3;
+    pair[bit] = planes[bit] ^ row1;
+  }
+  XtimeBitsliced(pair);
+  for (size_t bit = 0; bit < kBitslicePlaneCount; ++bit) {
+    planes[bit] = sum[bit] ^ pair[bit];
+  }
+}
+
+/**
+ * @brief Apply InvMixColumns. (bitsliced)
+ * @param[in,out] planes    planes
+ */
+static void InvMixColumnsBitsliced(uint64_t *planes) {
+  uint64_t pair[kBitslicePlaneCount];
+  for (size_t bit = 0; bit < kBitslicePlaneCount; ++bit) {
+    pair[bit] =
+        planes[bit] ^ RotateRowsBitsliced(RotateRowsBitsliced(planes[bit]));
+  }
+  XtimeBitsliced(pair);
+  XtimeBitsliced(pair);
+  for (size_t bit = 0; bit < kBitslicePlaneCount; ++bit) {
+    planes[bit] ^= pair[bit];
+  }
+  MixColumnsBitsliced(planes);
+}
+
+/**
+ * @brief Convert the round keys to the bitsliced planes.
+ * @param[in] round_keys    round keys
+ * @param[out] key_planes   planes ((round count + 1) * 8)
+ */
+static void BitsliceRoundKeys(const uint8_t *round_keys, uint64_t *key_planes) {
+  uint8_t blocks[kBitsliceBlockCount * kAesBlockSize];
+  for (size_t round = 0; round <= kAes256RoundCount; ++round) {
+    for (size_t block = 0; block < kBitsliceBlockCount; ++block) {
+      memcpy(
+          blocks + block * kAesBlockSize, round_keys + round * kAesBlockSize,
+          kAesBlockSize);
+    }
+    BitsliceBlocks(blocks, key_planes + round * kBitslicePlaneCount);
+  }
+  memset(blocks, 0, sizeof(blocks));
+}
+
+/**
+ * @brief XOR the round key. (bitsliced)
+ * @param[in,out] planes    planes
+ * @param[in] key_planes    round key planes
+ */
+static inline void AddRoundKeyBitsliced(
+    uint64_t *planes, const uint64_t *key_planes) {
+  for (size_t bit = 0; bit < kBitslicePlaneCount; ++bit) {
+    planes[bit] ^= key_planes[bit];
+  }
+}
+
+/**
+ * @brief Encrypt 4 blocks. (software)
+ * @param[in] key_planes    encrypt round key planes
+ * @param[in,out] blocks    blocks (64 bytes)
+ */
+static void EncryptBlocksSoftware(const uint64_t *key_planes, uint8_t *blocks) {
+  uint64_t planes[kBitslicePlaneCount];
+  BitsliceBlocks(blocks, planes);
+  AddRoundKeyBitsliced(planes, key_planes);
+  for (size_t round = 1; round <= kAes256RoundCount; ++round) {
+    SubBytesBitsliced(planes);
+    ShiftRowsBitsliced(planes, false);
+    if (round != kAes256RoundCount) MixColumnsBitsliced(planes);
+    AddRoundKeyBitsliced(planes, key_planes + round * kBitslicePlaneCount);
+  }
+  UnbitsliceBlocks(planes, blocks);
+}
+
+/**
+ * @brief Decrypt 4 blocks with the equivalent inverse cipher. (software)
+ * @param[in] key_planes    decrypt round key planes
+ * @param[in,out] blocks    blocks (64 bytes)
+ */
+static void DecryptBlocksSoftware(const uint64_t *key_planes, uint8_t *blocks) {
+  uint64_t planes[kBitslicePlaneCount];
+  BitsliceBlocks(blocks, planes);
+  AddRoundKeyBitsliced(planes, key_planes);
+  for (size_t round = 1; round <= kAes256RoundCount; ++round) {
+    InvSubBytesBitsliced(planes);
+    ShiftRowsBitsliced(planes, true);
+    if (round != kAes256RoundCount) InvMixColumnsBitsliced(planes);
+    AddRoundKeyBitsliced(planes, key_planes + round * kBitslicePlaneCount);
+  }
+  UnbitsliceBlocks(planes, blocks);
+}
+
+/**
+ * @brief XOR the block.
+ * @param[in,out] block   block
+ * @param[in] value       value block
+ */
+static inline void XorBlock(uint8_t *block, const uint8_t *value) {
+  for (size_t index = 0; index < kAesBlockSize; ++index) {
+    block[index] ^= value[index];
+  }
+}
+
+// ----------------------------------------------------------------------------
+// AES-NI implementation
+// ----------------------------------------------------------------------------
+#ifdef CFD_CORE_USE_X86_SIMD
+/// AES-NI interleaved block count
+static constexpr size_t kAesNiBlockCount = 8;
+
+/**
+ * @brief Load the round keys. (AES-NI)
+ * @param[in] round_keys    round keys
+ * @param[out] keys         round key vectors
+ */
+__attribute__((target("aes,sse2"))) static inline void LoadRoundKeysAesNi(
+    const uint8_t *round_keys, __m128i *keys) {
+  for (size_t round = 0; round <= kAes256RoundCount; ++round) {
+    keys[round] = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(round_keys + round * kAesBlockSize));
+  }
+}
+
+/**
+ * @brief Encrypt a block. (AES-NI)
+ * @param[in] keys    round key vectors
+ * @param[in] block   block
+ * @return encrypted block
+ */
+__attribute__((target("aes,sse2"))) static inline __m128i EncryptBlockAesNi(
+    const __m128i *keys, __m128i block) {
+  block = _mm_xor_si128(block, keys[0]);
+  for (size_t round = 1; round < kAes256RoundCount; ++round) {
+    block = _mm_aesenc_si128(block, keys[round]);
+  }
+  return _mm_aesenclast_si128(block, keys[kAes256RoundCount]);
+}
+
+/**
+ * @brief Encrypt blocks. (AES-NI, ECB)
+ * @param[in] round_keys  encrypt round keys
+ * @param[in] input       input blocks
+ * @param[out] output     output blocks
+ * @param[in] count       block count
+ */
+__attribute__((target("aes,sse2"))) static void EncryptBlocksAesNi(
+    const uint8_t *round_keys, const uint8_t *input, uint8_t *output,
+    size_t count) {
+  __m128i keys[kAes256RoundCount + 1];
+  LoadRoundKeysAesNi(round_keys, keys);
+  size_t index = 0;
+  for (; index + kAesNiBlockCount <= count; index += kAesNiBlockCount) {
+    __m128i blocks[kAesNiBlockCount];
+    for (size_t lane = 0; lane < kAesNiBlockCount; ++lane) {
+      blocks[lane] = _mm_xor_si128(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+              input + (index + lane) * kAesBlockSize)),
+          keys[0]);
+    }
+    for (size_t round = 1; round < kAes256RoundCount; ++round) {
+      for (size_t lane = 0; lane < kAesNiBlockCount; ++lane) {
+        blocks[lane] = _mm_aesenc_si128(blocks[lane], keys[round]);
+      }
+    }
+    for (size_t lane = 0; lane < kAesNiBlockCount; ++lane) {
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i *>(output + (index + lane) * kAesBlockSize),
+          _mm_aesenclast_si128(blocks[lane], keys[kAes256RoundCount]));
+    }
+  }
+  for (; index < count; ++index) {
+    __m128i block = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(input + index * kAesBlockSize));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(output + index * kAesBlockSize),
+        EncryptBlockAesNi(keys, block));
+  }
+}
+
+/**
+ * @brief Encrypt blocks with the CBC mode. (AES-NI)
+ * @param[in] round_keys  encrypt round keys
+ * @param[in,out] iv      initial vector
+ * @param[in] input       input blocks
+ * @param[out] output     output blocks
+ * @param[in] count       block count
+ */
+__attribute__((target("aes,sse2"))) static void CbcEncryptAesNi(
+    const uint8_t *round_keys, uint8_t *iv, const uint8_t *input,
+    uint8_t *output, size_t count) {
+  __m128i keys[kAes256RoundCount + 1];
+  LoadRoundKeysAesNi(round_keys, keys);
+  __m128i chain = _mm_loadu_si128(reinterpret_cast<const __m128i *>(iv));
+  for (size_t index = 0; index < count; ++index) {
+    __m128i block = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(input + index * kAesBlockSize));
+    chain = EncryptBlockAesNi(keys, _mm_xor_si128(block, chain));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(output + index * kAesBlockSize), chain);
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(iv), chain);
+}
+
+/**
+ * @brief Decrypt blocks with the CBC mode. (AES-NI)
+ * @param[in] round_keys  decrypt round keys
+ * @param[in,out] iv      initial vector
+ * @param[in] input       input blocks
+ * @param[out] output     output blocks
+ * @param[in] count       block count
+ */
+__attribute__((target("aes,sse2"))) static void CbcDecryptAesNi(
+    const uint8_t *round_keys, uint8_t *iv, const uint8_t *input,
+    uint8_t *output, size_t count) {
+  __m128i keys[kAes256RoundCount + 1];
+  LoadRoundKeysAesNi(round_keys, keys);
+  __m128i chain = _mm_loadu_si128(reinterpret_cast<const __m128i *>(iv));
+  size_t index = 0;
+  for (; index + kAesNiBlockCount <= count; index += kAesNiBlockCount) {
+    __m128i cipher[kAesNiBlockCount];
+    __m128i blocks[kAesNiBlockCount];
+    for (size_t lane = 0; lane < kAesNiBlockCount; ++lane) {
+      cipher[lane] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+          input + (index + lane) * kAesBlockSize));
+      blocks[lane] = _mm_xor_si128(cipher[lane], keys[0]);
+    }
+    for (size_t round = 1; round < kAes256RoundCount; ++round) {
+      for (size_t lane = 0; lane < kAesNiBlockCount; ++lane) {
+        blocks[lane] = _mm_aesdec_si128(blocks[lane], keys[round]);
+      }
+    }
+    for (size_t lane = 0; lane < kAesNiBlockCount; ++lane) {
+      __m128i plain =
+          _mm_aesdeclast_si128(blocks[lane], keys[kAes256RoundCount]);
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i *>(output + (index + lane) * kAesBlockSize),
+          _mm_xor_si128(plain, chain));
+      chain = cipher[lane];
+    }
+  }
+  for (; index < count; ++index) {
+    __m128i cipher = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(input + index * kAesBlockSize));
+    __m128i block = _mm_xor_si128(cipher, keys[0]);
+    for (size_t round = 1; round < kAes256RoundCount; ++round) {
+      block = _mm_aesdec_si128(block, keys[round]);
+    }
+    block = _mm_aesdeclast_si128(block, keys[kAes256RoundCount]);
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(output + index * kAesBlockSize),
+        _mm_xor_si128(block, chain));
+    chain = cipher;
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(iv), chain);
+}
+
+/**
+ * @brief Convert the encrypt round keys to the decrypt round keys. (AES-NI)
+ * @param[in] encrypt_keys  encrypt round keys
+ * @param[out] decrypt_keys decrypt round keys
+ */
+__attribute__((target("aes,sse2"))) static void InvertRoundKeysAesNi(
+    const uint8_t *encrypt_keys, uint8_t *decrypt_keys) {
+  for (size_t round = 0; round <= kAes256RoundCount; ++round) {
+    __m128i key = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+        encrypt_keys + (kAes256RoundCount - round) * kAesBlockSize));
+    if ((round != 0) && (round != kAes256RoundCount)) {
+      key = _mm_aesimc_si128(key);
+    }
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(decrypt_keys + round * kAesBlockSize),
+        key);
+  }
+}
+#endif  // CFD_CORE_USE_X86_SIMD
+
+// ----------------------------------------------------------------------------
+// functions
+// ----------------------------------------------------------------------------
+/**
+ * @brief Apply the round key operation to a round key. (software)
+ * @param[in,out] round_key   round key (16 bytes)
+ * @param[in] use_sub_bytes   apply SubBytes (for key expansion)
+ */
+static void TransformRoundKeySoftware(uint8_t *round_key, bool use_sub_bytes) {
+  uint8_t blocks[kBitsliceBlockCount * kAesBlockSize] = {0};
+  uint64_t planes[kBitslicePlaneCount];
+  memcpy(blocks, round_key, kAesBlockSize);
+  BitsliceBlocks(blocks, planes);
+  if (use_sub_bytes) {
+    SubBytesBitsliced(planes);
+  } else {
+    InvMixColumnsBitsliced(planes);
+  }
+  UnbitsliceBlocks(planes, blocks);
+  memcpy(round_key, blocks, kAesBlockSize);
+  memset(blocks, 0, sizeof(blocks));
+  memset(planes, 0, sizeof(planes));
+}
+
+void Aes256ExpandKey(const uint8_t *key, uint8_t *key_schedule) {
+  static constexpr size_t kKeyWordCount = kAes256KeySize / 4;
+  static constexpr size_t kWordCount = kAes256RoundKeySize / 4;
+  uint8_t *encrypt_keys = key_schedule;
+  uint8_t *decrypt_keys = key_schedule + kAes256RoundKeySize;
+  memcpy(encrypt_keys, key, kAes256KeySize);
+
+  // AES-256 uses the round constant up to 0x40.
+  uint8_t round_constant = 0x01;
+  for (size_t index = kKeyWordCount; index < kWordCount; ++index) {
+    uint8_t temp[kAesBlockSize] = {0};
+    memcpy(temp, encrypt_keys + (index - 1) * 4, 4);
+    if ((index % kKeyWordCount) == 0) {
+      const uint8_t first = temp[0];
+      temp[0] = temp[1];
+      temp[1] = temp[2];
+      temp[2] = temp[3];
+      temp[3] = first;
+    }
+    if ((index % kKeyWordCount) == 0 || (index % kKeyWordCount) == 4) {
+      TransformRoundKeySoftware(temp, true);
+    }
+    if ((index % kKeyWordCount) == 0) {
+      temp[0] ^= round_constant;
+      round_constant = static_cast<uint8_t>(round_constant << 1);
+    }
+    for (size_t byte = 0; byte < 4; ++byte) {
+      encrypt_keys[index * 4 + byte] =
+          encrypt_keys[(index - kKeyWordCount) * 4 + byte] ^ temp[byte];
+    }
+    memset(temp, 0, sizeof(temp));
+  }
+
+#ifdef CFD_CORE_USE_X86_SIMD
+  if (IsSupportAesNi()) {
+    InvertRoundKeysAesNi(encrypt_keys, decrypt_keys);
+    return;
+  }
+#endif  // CFD_CORE_USE_X86_SIMD
+  for (size_t round = 0; round <= kAes256RoundCount; ++round) {
+    uint8_t *target = decrypt_keys + round * kAesBlockSize;
+    memcpy(
+        target, encrypt_keys + (kAes256RoundCount - round) * kAesBlockSize,
+        kAesBlockSize);
+    if ((round != 0) && (round != kAes256RoundCount)) {
+      TransformRoundKeySoftware(target, false);
+    }
+  }
+}
+
+void Aes256CbcEncrypt(
+    const uint8_t *key_schedule, uint8_t *iv, const uint8_t *input,
+    uint8_t *output, size_t count) {
+#ifdef CFD_CORE_USE_X86_SIMD
+  if (IsSupportAesNi()) {
+    CbcEncryptAesNi(key_schedule, iv, input, output, count);
+    return;
+  }
+#endif  // CFD_CORE_USE_X86_SIMD
+  uint64_t key_planes[(kAes256RoundCount + 1) * kBitslicePlaneCount];
+  uint8_t blocks[kBitsliceBlockCount * kAesBlockSize] = {0};
+  BitsliceRoundKeys(key_schedule, key_planes);
+  // CBC encryption is sequential, so only the first lane is used.
+  for (size_t index = 0; index < count; ++index) {
+    memcpy(blocks, input + index * kAesBlockSize, kAesBlockSize);
+    XorBlock(blocks, iv);
+    EncryptBlocksSoftware(key_planes, blocks);
+    memcpy(output + index * kAesBlockSize, blocks, kAesBlockSize);
+    memcpy(iv, blocks, kAesBlockSize);
+  }
+  memset(key_planes, 0, sizeof(key_planes));
+  memset(blocks, 0, sizeof(blocks));
+}
+
+void Aes256CbcDecrypt(
+    const uint8_t *key_schedule, uint8_t *iv, const uint8_t *input,
+    uint8_t *output, size_t count) {
+  const uint8_t *decrypt_keys = key_schedule + kAes256RoundKeySize;
+#ifdef CFD_CORE_USE_X86_SIMD
+  if (IsSupportAesNi()) {
+    CbcDecryptAesNi(decrypt_keys, iv, input, output, count);
+    return;
+  }
+#endif  // CFD_CORE_USE_X86_SIMD
+  uint64_t key_planes[(kAes256RoundCount + 1) * kBitslicePlaneCount];
+  uint8_t cipher[kBitsliceBlockCount * kAesBlockSize];
+  uint8_t blocks[kBitsliceBlockCount * kAesBlockSize] = {0};
+  BitsliceRoundKeys(decrypt_keys, key_planes);
+  for (size_t index = 0; index < count; index += kBitsliceBlockCount) {
+    const size_t block_count = (count - index < kBitsliceBlockCount)
+                                   ? count - index
+                                   : kBitsliceBlockCount;
+    const size_t size = block_count * kAesBlockSize;
+    memcpy(cipher, input + index * kAesBlockSize, size);
+    memcpy(blocks, cipher, size);
+    DecryptBlocksSoftware(key_planes, blocks);
+    XorBlock(blocks, iv);
+    for (size_t lane = 1; lane < block_count; ++lane) {
+      XorBlock(
+          blocks + lane * kAesBlockSize, cipher + (lane - 1) * kAesBlockSize);
+    }
+    memcpy(output + index * kAesBlockSize, blocks, size);
+    memcpy(iv, cipher + size - kAesBlockSize, kAesBlockSize);
+  }
+  memset(key_planes, 0, sizeof(key_planes));
+  memset(blocks, 0, sizeof(blocks));
+}
+
+void Aes256CtrTransform(
+    const uint8_t *key_schedule, const uint8_t *counter, const uint8_t *input,
+    uint8_t *output, size_t count) {
+  uint8_t current[kAesBlockSize];
+  uint8_t keystream[kAesCtrBufferBlockCount * kAesBlockSize] = {0};
+  uint64_t key_planes[(kAes256RoundCount + 1) * kBitslicePlaneCount];
+  bool use_aesni = false;
+#ifdef CFD_CORE_USE_X86_SIMD
+  use_aesni = IsSupportAesNi();
+#endif  // CFD_CORE_USE_X86_SIMD
+  if (!use_aesni) BitsliceRoundKeys(key_schedule, key_planes);
+
+  memcpy(current, counter, sizeof(current));
+  for (size_t offset = 0; offset < count;
+       offset += kAesCtrBufferBlockCount) {
+    const size_t block_count = (count - offset < kAesCtrBufferBlockCount)
+                                   ? count - offset
+                                   : kAesCtrBufferBlockCount;
+    for (size_t index = 0; index < block_count; ++index) {
+      memcpy(keystream + index * kAesBlockSize, current, kAesBlockSize);
+      AddAesCounter(current, 1);
+    }
+#ifdef CFD_CORE_USE_X86_SIMD
+    if (use_aesni) {
+      EncryptBlocksAesNi(key_schedule, keystream, keystream, block_count);
+    }
+#endif  // CFD_CORE_USE_X86_SIMD
+    if (!use_aesni) {
+      for (size_t index = 0; index < block_count;
+           index += kBitsliceBlockCount) {
+        EncryptBlocksSoftware(key_planes, keystream + index * kAesBlockSize);
+      }
+    }
+    const size_t size = block_count * kAesBlockSize;
+    const uint8_t *source = input + offset * kAesBlockSize;
+    uint8_t *target = output + offset * kAesBlockSize;
+    for (size_t index = 0; index < size; ++index) {
+      target[index] = source[index] ^ keystream[index];
+    }
+  }
+  memset(keystream, 0, sizeof(keystream));
+  if (!use_aesni) memset(key_planes, 0, sizeof(key_planes));
+}
+
+void AddAesCounter(uint8_t *counter, uint64_t value) {
+  uint64_t low = 0;
+  for (size_t index = 8; index < kAesBlockSize; ++index) {
+    low = (low << 8) | counter[index];
+  }
+  uint64_t sum = low + value;
+  bool has_carry = (sum < low);
+  for (size_t index = kAesBlockSize; index > 8; --index) {
+    counter[index - 1] = static_cast<uint8_t>(sum);
+    sum >>= 8;
+  }
+  for (size_t index = 8; (index > 0) && has_carry; --index) {
+    ++counter[index - 1];
+    has_carry = (counter[index - 1] == 0);
+  }
+}
+
+}  // namespace core
+}  // namespace cfd
@@ -0,0 +1,82 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_aes.h
+ * @brief AES-256 block functions for streaming cipher contexts.
+ *
+ */
+#ifndef CFD_CORE_SRC_CFDCORE_AES_H_
+#define CFD_CORE_SRC_CFDCORE_AES_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cfd {
+namespace core {
+
+//! AES block size
+constexpr size_t kAesBlockSize = 16;
+//! AES-256 key size
+constexpr size_t kAes256KeySize = 32;
+//! AES-256 round count
+constexpr size_t kAes256RoundCount = 14;
+//! AES-256 round key size (for one direction)
+constexpr size_t kAes256RoundKeySize = (kAes256RoundCount + 1) * kAesBlockSize;
+//! AES-256 key schedule size (encrypt round keys + decrypt round keys)
+constexpr size_t kAes256KeyScheduleSize = kAes256RoundKeySize * 2;
+
+/**
+ * @brief Expand the AES-256 key.
+ * @details The schedule has the encrypt round keys and the decrypt round
+ *     keys for the equivalent inverse cipher.
+ * @param[in] key             key (32 bytes)
+ * @param[out] key_schedule   key schedule (kAes256KeyScheduleSize)
+ */
+void Aes256ExpandKey(const uint8_t *key, uint8_t *key_schedule);
+
+/**
+ * @brief Encrypt blocks with the AES-256 CBC mode.
+ * @param[in] key_schedule  key schedule
+ * @param[in,out] iv        initial vector (updated to the last block)
+ * @param[in] input         plain blocks
+ * @param[out] output       cipher blocks (can be the same as input)
+ * @param[in] count         block count
+ */
+void Aes256CbcEncrypt(
+    const uint8_t *key_schedule, uint8_t *iv, const uint8_t *input,
+    uint8_t *output, size_t count);
+
+/**
+ * @brief Decrypt blocks with the AES-256 CBC mode.
+ * @param[in] key_schedule  key schedule
+ * @param[in,out] iv        initial vector (updated to the last block)
+ * @param[in] input         cipher blocks
+ * @param[out] output       plain blocks (can be the same as input)
+ * @param[in] count         block count
+ */
+void Aes256CbcDecrypt(
+    const uint8_t *key_schedule, uint8_t *iv, const uint8_t *input,
+    uint8_t *output, size_t count);
+
+/**
+ * @brief Apply the AES-256 CTR keystream to blocks.
+ * @param[in] key_schedule  key schedule
+ * @param[in] counter       counter block of the first block
+ * @param[in] input         input blocks
+ * @param[out] output       output blocks (can be the same as input)
+ * @param[in] count         block count
+ */
+void Aes256CtrTransform(
+    const uint8_t *key_schedule, const uint8_t *counter, const uint8_t *input,
+    uint8_t *output, size_t count);
+
+/**
+ * @brief Add the value to the 128bit big-endian counter block.
+ * @param[in,out] counter   counter block
+ * @param[in] value         value
+ */
+void AddAesCounter(uint8_t *counter, uint64_t value);
+
+}  // namespace core
+}  // namespace cfd
+
+#endif  // CFD_CORE_SRC_CFDCORE_AES_H_
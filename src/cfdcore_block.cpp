@@ -9,6 +9,7 @@
 #include "cfdcore/cfdcore_block.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_exception.h"
@@ -25,6 +26,9 @@ using logger::warn;
 // -----------------------------------------------------------------------------
 // Internal file functions
 // -----------------------------------------------------------------------------
+//! block header size
+static constexpr uint32_t kBlockHeaderSize = 80;
+
 /**
  * @brief calculate tree width
  * @param[in] transaction_count     transaction count
@@ -49,6 +53,84 @@ static ByteData BitsToBytes(const std::vector<bool>& bits) {
   return ByteData(ret);
 }
 
+/**
+ * @brief Write the block header.
+ * @param[in] header          block header
+ * @param[in,out] serializer  serializer
+ */
+static void WriteBlockHeader(
+    const BlockHeader& header, Serializer* serializer) {
+  serializer->AddDirectNumber(header.version);
+  serializer->AddDirectBytes(header.prev_block_hash.GetData());
+  serializer->AddDirectBytes(header.merkle_root_hash.GetData());
+  serializer->AddDirectNumber(header.time);
+  serializer->AddDirectNumber(header.bits);
+  serializer->AddDirectNumber(header.nonce);
+}
+
+/**
+ * @brief Read the transaction in the block.
+ * @details The transaction is not parsed into the object. The txid is
+ *     calculated from the non-witness area of the serialized data.
+ * @param[in,out] parser    deserializer
+ * @param[out] txid         txid
+ * @return transaction data view
+ */
+static ByteSpan ReadBlockTransaction(Deserializer* parser, Txid* txid) {
+  static constexpr uint8_t kWitnessFlag = 1;
+  uint32_t start_offset = parser->GetReadSize();
+  const uint8_t* tx_data = parser->ReadSpan(sizeof(uint32_t)).data();
+  uint32_t body_offset = sizeof(uint32_t);
+
+  uint8_t flag = 0;
+  uint64_t txin_count = parser->ReadVariableInt();
+  uint64_t txout_count = 0;
+  if (txin_count == 0) {
+    // marker
+    flag = parser->ReadUint8();
+    if ((flag & ~kWitnessFlag) != 0) {
+      warn(CFD_LOG_SOURCE, "unknown transaction flag.");
+      throw CfdException(
+          kCfdIllegalArgumentError, "block transaction data invalid.");
+    }
+    if (flag != 0) {
+      // the non-witness data does not have the marker and the flag.
+      body_offset = parser->GetReadSize() - start_offset;
+      txin_count = parser->ReadVariableInt();
+    }
+  }
+  for (uint64_t index = 0; index < txin_count; ++index) {
+    parser->Skip(32 + sizeof(uint32_t));  // outpoint
+    parser->SkipVariableBuffer();         // unlocking script
+    parser->Skip(sizeof(uint32_t));       // sequence
+  }
+  if ((txin_count != 0) || (flag != 0)) {
+    txout_count = parser->ReadVariableInt();
+  }
+  for (uint64_t index = 0; index < txout_count; ++index) {
+    parser->Skip(sizeof(uint64_t));  // amount
+    parser->SkipVariableBuffer();    // locking script
+  }
+  uint32_t body_end_offset = parser->GetReadSize() - start_offset;
+  if (flag != 0) {
+    for (uint64_t index = 0; index < txin_count; ++index) {
+      uint64_t stack_count = parser->ReadVariableInt();
+      for (uint64_t stack = 0; stack < stack_count; ++stack) {
+        parser->SkipVariableBuffer();
+      }
+    }
+  }
+  uint32_t locktime_offset = parser->GetReadSize() - start_offset;
+  parser->Skip(sizeof(uint32_t));
+
+  Serializer sink = Serializer::CreateSha256Sink();
+  sink.AddDirectBytes(tx_data, sizeof(uint32_t));
+  sink.AddDirectBytes(tx_data + body_offset, body_end_offset - body_offset);
+  sink.AddDirectBytes(tx_data + locktime_offset, sizeof(uint32_t));
+  *txid = Txid(sink.OutputSha256d());
+  return ByteSpan(tx_data, parser->GetReadSize() - start_offset);
+}
+
 // -----------------------------------------------------------------------------
 // Block
 // -----------------------------------------------------------------------------
@@ -57,27 +139,22 @@ Block::Block() : data_() {
 }
 
 Block::Block(const ByteData& data) : data_(data) {
-  Deserializer dec(data);
+  ByteSpan block_data(data_);
+  Deserializer dec(block_data);
   header_.version = dec.ReadUint32();
   header_.prev_block_hash = BlockHash(dec.ReadBuffer(32));
   header_.merkle_root_hash = BlockHash(dec.ReadBuffer(32));
-  header_.time = dec.ReadUint32();
-  header_.bits = dec.ReadUint32();
-  header_.nonce = dec.ReadUint32();
+  uint32_t values[3];
+  dec.ReadUint32Array(values, 3);
+  header_.time = values[0];
+  header_.bits = values[1];
+  header_.nonce = values[2];
   uint64_t tx_count = dec.ReadVariableInt();
-  size_t read_size = data.GetDataSize() - dec.GetReadSize();
-  auto txs = ByteData(dec.ReadBuffer(static_cast<uint32_t>(read_size)));
   for (uint64_t index = 0; index < tx_count; ++index) {
-    Transaction tx(txs);
-    auto tx_data = tx.GetData();
-    uint32_t cur_size = static_cast<uint32_t>(tx_data.GetDataSize());
-    uint32_t unread_size = static_cast<uint32_t>(txs.GetDataSize()) - cur_size;
-    if (unread_size != 0) {
-      auto arr = txs.SplitData(std::vector<uint32_t>{cur_size, unread_size});
-      txs = arr[1];
-    }
-    txs_.emplace_back(tx_data);
-    txids_.emplace_back(tx.GetTxid());
+    Txid txid;
+    ByteSpan tx_data = ReadBlockTransaction(&dec, &txid);
+    txs_.emplace_back(tx_data.GetData());
+    txids_.emplace_back(txid);
   }
 }
 
@@ -100,12 +177,32 @@ Block& Block::operator=(const Block& object) {
   return *this;
 }
 
+Block::Block(Block&& object) noexcept
+    : data_(std::move(object.data_)),
+      header_(std::move(object.header_)),
+      txs_(std::move(object.txs_)),
+      txids_(std::move(object.txids_)) {
+  // do nothing
+}
+
+Block& Block::operator=(Block&& object) noexcept {
+  if (this != &object) {
+    data_ = std::move(object.data_);
+    header_ = std::move(object.header_);
+    txs_ = std::move(object.txs_);
+    txids_ = std::move(object.txids_);
+  }
+  return *this;
+}
+
 std::string Block::GetHex() const { return data_.GetHex(); }
 
 ByteData Block::GetData() const { return data_; }
 
 BlockHash Block::GetBlockHash() const {
-  return BlockHash(HashUtil::Sha256D(SerializeBlockHeader()));
+  Serializer sink = Serializer::CreateSha256Sink();
+  WriteBlockHeader(header_, &sink);
+  return BlockHash(sink.OutputSha256d());
 }
 
 Txid Block::GetTxid(uint32_t index) const {
@@ -143,13 +240,8 @@ uint32_t Block::GetTransactionCount() const {
 BlockHeader Block::GetBlockHeader() const { return header_; }
 
 ByteData Block::SerializeBlockHeader() const {
-  Serializer obj;
-  obj.AddDirectNumber(header_.version);
-  obj.AddDirectBytes(header_.prev_block_hash.GetData());
-  obj.AddDirectBytes(header_.merkle_root_hash.GetData());
-  obj.AddDirectNumber(header_.time);
-  obj.AddDirectNumber(header_.bits);
-  obj.AddDirectNumber(header_.nonce);
+  Serializer obj(kBlockHeaderSize);
+  WriteBlockHeader(header_, &obj);
   return obj.Output();
 }
 
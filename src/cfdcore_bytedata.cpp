@@ -6,13 +6,17 @@
  */
 #include "cfdcore/cfdcore_bytedata.h"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "cfdcore/cfdcore_exception.h"
 #include "cfdcore/cfdcore_logger.h"
 #include "cfdcore/cfdcore_util.h"
+#include "cfdcore_sha2.h"  // NOLINT
 
 namespace cfd {
 namespace core {
@@ -48,21 +52,36 @@ static bool IsBigEndian() {
 //////////////////////////////////
 /// ByteData
 //////////////////////////////////
-ByteData::ByteData() : data_(0) {
+constexpr uint32_t ByteData::kInlineCapacity;
+
+ByteData::ByteData() : size_(0), shared_data_() {
   // do nothing
 }
 
-ByteData::ByteData(const std::vector<uint8_t>& vector) : data_(vector) {
-  if (data_.size() > std::numeric_limits<uint32_t>::max()) {
+ByteData::ByteData(const std::vector<uint8_t>& vector)
+    : size_(0), shared_data_() {
+  if (vector.size() > std::numeric_limits<uint32_t>::max()) {
     warn(CFD_LOG_SOURCE, "It exceeds the handling size.");
     throw CfdException(kCfdIllegalStateError, "It exceeds the handling size.");
   }
+  SetData(vector.data(), vector.size());
 }
 
-ByteData::ByteData(const std::string& hex)
-    : data_(StringUtil::StringToByte(hex)) {}
+ByteData::ByteData(const std::string& hex) : size_(0), shared_data_() {
+  size_t size = hex.size() / 2;
+  if (hex.size() > (static_cast<size_t>(kInlineCapacity) * 2)) {
+    auto data = std::make_shared<std::vector<uint8_t>>(size);
+    StringUtil::StringToByte(hex.data(), hex.size(), data->data(), size);
+    shared_data_ = data;
+  } else {
+    StringUtil::StringToByte(
+        hex.data(), hex.size(), inline_data_, sizeof(inline_data_));
+  }
+  size_ = static_cast<uint32_t>(size);
+}
 
-ByteData::ByteData(const uint8_t* buffer, uint32_t size) : data_(size) {
+ByteData::ByteData(const uint8_t* buffer, uint32_t size)
+    : size_(0), shared_data_() {
   if (buffer == nullptr) {
     if (size == 0) {
       // create empty buffer
@@ -71,51 +90,144 @@ ByteData::ByteData(const uint8_t* buffer, uint32_t size) : data_(size) {
       throw CfdException(kCfdIllegalArgumentError, "buffer is null.");
     }
   } else if (size != 0) {
-    data_.resize(size);
-    memcpy(data_.data(), buffer, size);
+    SetData(buffer, size);
+  }
+}
+
+ByteData::ByteData(const uint8_t single_byte) : size_(1), shared_data_() {
+  inline_data_[0] = single_byte;
+}
+
+ByteData::ByteData(const ByteData& object)
+    : size_(object.size_), shared_data_(object.shared_data_) {
+  if (!shared_data_) {
+    memcpy(inline_data_, object.inline_data_, size_);
   }
 }
 
-ByteData::ByteData(const uint8_t single_byte) : data_(1) {
-  data_[0] = single_byte;
+ByteData::ByteData(ByteData&& object) noexcept
+    : size_(object.size_), shared_data_(std::move(object.shared_data_)) {
+  if (!shared_data_) {
+    memcpy(inline_data_, object.inline_data_, size_);
+  }
+  object.size_ = 0;
 }
 
 ByteData& ByteData::operator=(const ByteData& object) {
-  data_ = object.data_;
+  if (this != &object) {
+    size_ = object.size_;
+    shared_data_ = object.shared_data_;
+    if (!shared_data_) {
+      memcpy(inline_data_, object.inline_data_, size_);
+    }
+  }
   return *this;
 }
 
+ByteData& ByteData::operator=(ByteData&& object) noexcept {
+  if (this != &object) {
+    size_ = object.size_;
+    shared_data_ = std::move(object.shared_data_);
+    if (!shared_data_) {
+      memcpy(inline_data_, object.inline_data_, size_);
+    }
+    object.size_ = 0;
+  }
+  return *this;
+}
+
+const uint8_t* ByteData::GetDataAddress() const {
+  if (!shared_data_) return inline_data_;
+  return shared_data_->data();
+}
+
+void ByteData::SetData(const uint8_t* buffer, size_t size) {
+  if (size <= kInlineCapacity) {
+    shared_data_.reset();
+    if (size != 0) memcpy(inline_data_, buffer, size);
+  } else {
+    shared_data_ =
+        std::make_shared<std::vector<uint8_t>>(buffer, buffer + size);
+  }
+  size_ = static_cast<uint32_t>(size);
+}
+
+void ByteData::AppendData(const uint8_t* buffer, size_t size) {
+  if (size == 0) return;
+  size_t total_size = static_cast<size_t>(size_) + size;
+  if (total_size > std::numeric_limits<uint32_t>::max()) {
+    warn(CFD_LOG_SOURCE, "It exceeds the handling size.");
+    throw CfdException(kCfdIllegalStateError, "It exceeds the handling size.");
+  }
+
+  if (!shared_data_ && (total_size <= kInlineCapacity)) {
+    memcpy(&inline_data_[size_], buffer, size);
+  } else if (!shared_data_) {
+    auto data = std::make_shared<std::vector<uint8_t>>();
+    data->reserve(total_size + 8);
+    data->insert(data->end(), inline_data_, inline_data_ + size_);
+    data->insert(data->end(), buffer, buffer + size);
+    shared_data_ = data;
+  } else if (shared_data_.use_count() == 1) {
+    // not shared. update directly.
+    shared_data_->reserve(total_size + 8);
+    shared_data_->insert(shared_data_->end(), buffer, buffer + size);
+  } else {
+    // copy-on-write
+    auto data = std::make_shared<std::vector<uint8_t>>();
+    data->reserve(total_size + 8);
+    data->insert(data->end(), shared_data_->begin(), shared_data_->end());
+    data->insert(data->end(), buffer, buffer + size);
+    shared_data_ = data;
+  }
+  size_ = static_cast<uint32_t>(total_size);
+}
+
+ByteData ByteData::CreateSharedData(const uint8_t* buffer, size_t size) {
+  ByteData result;
+  if (size != 0) {
+    result.shared_data_ =
+        std::make_shared<std::vector<uint8_t>>(buffer, buffer + size);
+    result.size_ = static_cast<uint32_t>(size);
+  }
+  return result;
+}
+
 std::string ByteData::GetHex() const {
-  return StringUtil::ByteToString(data_);
+  std::string hex(static_cast<size_t>(size_) * 2, '\0');
+  if (size_ != 0) {
+    StringUtil::ByteToString(GetDataAddress(), size_, &hex[0], hex.size());
+  }
+  return hex;
 }
 
-std::vector<uint8_t> ByteData::GetBytes() const { return data_; }
+std::vector<uint8_t> ByteData::GetBytes() const {
+  const uint8_t* data = GetDataAddress();
+  return std::vector<uint8_t>(data, data + size_);
+}
 
-size_t ByteData::GetDataSize() const { return data_.size(); }
+size_t ByteData::GetDataSize() const { return size_; }
 
 bool ByteData::Empty() const { return IsEmpty(); }
 
-bool ByteData::IsEmpty() const { return data_.size() == 0; }
+bool ByteData::IsEmpty() const { return size_ == 0; }
 
 bool ByteData::Equals(const ByteData& bytedata) const {
-  if (data_ == bytedata.data_) {
-    return true;
-  }
-  return false;
+  return (*this == bytedata);
 }
 
 uint8_t ByteData::GetHeadData() const {
-  return (data_.empty()) ? 0 : data_[0];
+  return (size_ == 0) ? 0 : GetDataAddress()[0];
 }
 
 ByteData ByteData::Serialize() const {
-  Serializer obj(static_cast<uint32_t>(data_.size()));
-  obj.AddVariableBuffer(data_.data(), static_cast<uint32_t>(data_.size()));
+  Serializer obj(size_);
+  obj.AddVariableBuffer(GetDataAddress(), size_);
   return obj.Output();
 }
 
 size_t ByteData::GetSerializeSize() const {
-  return Serializer::GetVariableIntSize(data_.size()) + data_.size();
+  return Serializer::GetVariableIntSize(size_) + size_;
 }
 
 ByteData ByteData::GetVariableInt(uint64_t v) {
@@ -125,14 +237,18 @@ ByteData ByteData::GetVariableInt(uint64_t v) {
 }
 
 bool ByteData::IsLarge(const ByteData& source, const ByteData& destination) {
-  return source.data_ < destination.data_;
+  const uint8_t* src = source.GetDataAddress();
+  const uint8_t* dest = destination.GetDataAddress();
+  return std::lexicographical_compare(
+      src, src + source.size_, dest, dest + destination.size_);
 }
 
 std::vector<ByteData> ByteData::SplitData(
     const std::vector<uint32_t>& split_size_list) const {
   std::vector<ByteData> result;
+  const uint8_t* data = GetDataAddress();
   uint32_t offset = 0;
-  uint32_t max = static_cast<uint32_t>(data_.size());
+  uint32_t max = size_;
   for (uint32_t size : split_size_list) {
     if (size == 0) {
       result.emplace_back(ByteData());
@@ -140,7 +256,7 @@ std::vector<ByteData> ByteData::SplitData(
       throw CfdException(
           kCfdIllegalArgumentError, "total size is maximum over.");
     } else {
-      result.emplace_back(&data_[offset], size);
+      result.emplace_back(&data[offset], size);
       offset += size;
     }
   }
@@ -154,78 +270,84 @@ ByteData ByteData::SplitData(uint32_t size_from_top) const {
 
 void ByteData::Push(const ByteData& back_insert_data) {
   if (back_insert_data.IsEmpty()) return;
-  const std::vector<uint8_t>& insert_bytes = back_insert_data.data_;
-  data_.reserve(data_.size() + insert_bytes.size() + 8);
-  std::copy(
-      insert_bytes.begin(), insert_bytes.end(), std::back_inserter(data_));
+  if (this == &back_insert_data) {
+    ByteData copy_data(back_insert_data.GetBytes());
+    AppendData(copy_data.GetDataAddress(), copy_data.size_);
+  } else {
+    AppendData(back_insert_data.GetDataAddress(), back_insert_data.size_);
+  }
 }
 
 void ByteData::Push(const ByteData160& back_insert_data) {
   std::vector<uint8_t> insert_bytes = back_insert_data.GetBytes();
-  data_.reserve(data_.size() + insert_bytes.size() + 8);
-  std::copy(
-      insert_bytes.begin(), insert_bytes.end(), std::back_inserter(data_));
+  AppendData(insert_bytes.data(), insert_bytes.size());
 }
 
 void ByteData::Push(const ByteData256& back_insert_data) {
   std::vector<uint8_t> insert_bytes = back_insert_data.GetBytes();
-  data_.reserve(data_.size() + insert_bytes.size() + 8);
-  std::copy(
-      insert_bytes.begin(), insert_bytes.end(), std::back_inserter(data_));
+  AppendData(insert_bytes.data(), insert_bytes.size());
 }
 
 bool ByteData::operator==(const ByteData& object) const {
-  return (data_ == object.data_);
+  if (size_ != object.size_) return false;
+  if (size_ == 0) return true;
+  if (shared_data_ && (shared_data_ == object.shared_data_)) {
+    return true;
+  }
+  return memcmp(GetDataAddress(), object.GetDataAddress(), size_) == 0;
 }
 
 //////////////////////////////////
 /// ByteData160
 //////////////////////////////////
-ByteData160::ByteData160() : data_(std::vector<uint8_t>(kByteData160Length)) {
-  memset(data_.data(), 0, data_.size());
-}
+ByteData160::ByteData160() : data_() { data_.fill(0); }
 
-ByteData160::ByteData160(const std::vector<uint8_t>& vector)
-    : data_(std::vector<uint8_t>(kByteData160Length)) {
+ByteData160::ByteData160(const std::vector<uint8_t>& vector) : data_() {
   if (vector.size() != kByteData160Length) {
     warn(CFD_LOG_SOURCE, "ByteData160 size unmatch. size={}.", vector.size());
     throw CfdException(
         CfdError::kCfdIllegalArgumentError, "ByteData160 size unmatch.");
   }
-  data_ = vector;
+  memcpy(data_.data(), vector.data(), data_.size());
 }
 
-ByteData160::ByteData160(const std::string& hex)
-    : data_(std::vector<uint8_t>(kByteData160Length)) {
+ByteData160::ByteData160(const std::string& hex) : data_() {
   std::vector<uint8_t> vector = StringUtil::StringToByte(hex);
   if (vector.size() != kByteData160Length) {
     warn(CFD_LOG_SOURCE, "ByteData160 size unmatch. size={}.", vector.size());
     throw CfdException(
         CfdError::kCfdIllegalArgumentError, "ByteData160 size unmatch.");
   }
-  data_ = vector;
+  memcpy(data_.data(), vector.data(), data_.size());
 }
 
 ByteData160::ByteData160(const ByteData& byte_data)
     : ByteData160(byte_data.GetBytes()) {}
 
+ByteData160::ByteData160(const ByteData160& object) : data_(object.data_) {}
+
 ByteData160& ByteData160::operator=(const ByteData160& object) {
   data_ = object.data_;
   return *this;
 }
 
 std::string ByteData160::GetHex() const {
-  return StringUtil::ByteToString(data_);
+  std::string hex(data_.size() * 2, '\0');
+  StringUtil::ByteToString(data_.data(), data_.size(), &hex[0], hex.size());
+  return hex;
 }
 
-std::vector<uint8_t> ByteData160::GetBytes() const { return data_; }
+std::vector<uint8_t> ByteData160::GetBytes() const {
+  return std::vector<uint8_t>(data_.begin(), data_.end());
+}
 
 bool ByteData160::Empty() const { return IsEmpty(); }
 
 bool ByteData160::IsEmpty() const {
-  std::vector<uint8_t> data(kByteData160Length);
-  memset(data.data(), 0, data.size());
-  return data_ == data;
+  for (const auto& byte_data : data_) {
+    if (byte_data != 0) return false;
+  }
+  return true;
 }
 
 bool ByteData160::Equals(const ByteData160& bytedata) const {
@@ -235,7 +357,9 @@ bool ByteData160::Equals(const ByteData160& bytedata) const {
   return false;
 }
 
-ByteData ByteData160::GetData() const { return ByteData(data_); }
+ByteData ByteData160::GetData() const {
+  return ByteData(data_.data(), static_cast<uint32_t>(data_.size()));
+}
 
 uint8_t ByteData160::GetHeadData() const { return data_[0]; }
 
@@ -252,36 +376,36 @@ bool ByteData160::operator==(const ByteData160& object) const {
 //////////////////////////////////
 /// ByteData256
 //////////////////////////////////
-ByteData256::ByteData256() : data_(std::vector<uint8_t>(kByteData256Length)) {
-  memset(data_.data(), 0, data_.size());
-}
+ByteData256::ByteData256() : data_() { data_.fill(0); }
 
-ByteData256::ByteData256(const std::vector<uint8_t>& vector)
-    : data_(std::vector<uint8_t>(kByteData256Length)) {
+ByteData256::ByteData256(const std::vector<uint8_t>& vector) : data_() {
   if (vector.size() != kByteData256Length) {
     warn(CFD_LOG_SOURCE, "ByteData256 size unmatch. size={}.", vector.size());
     throw CfdException(
         CfdError::kCfdIllegalArgumentError, "ByteData256 size unmatch.");
   }
-  data_ = vector;
+  memcpy(data_.data(), vector.data(), data_.size());
 }
 
-ByteData256::ByteData256(const std::string& hex)
-    : data_(std::vector<uint8_t>(kByteData256Length)) {
+ByteData256::ByteData256(const std::string& hex) : data_() {
   std::vector<uint8_t> vector = StringUtil::StringToByte(hex);
   if (vector.size() != kByteData256Length) {
     warn(CFD_LOG_SOURCE, "ByteData256 size unmatch. size={}.", vector.size());
     throw CfdException(
         CfdError::kCfdIllegalArgumentError, "ByteData256 size unmatch.");
   }
-  data_ = vector;
+  memcpy(data_.data(), vector.data(), data_.size());
 }
 
 ByteData256::ByteData256(const ByteData& byte_data)
     : ByteData256(byte_data.GetBytes()) {}
 
+ByteData256::ByteData256(const ByteData256& object) : data_(object.data_) {}
+
 std::string ByteData256::GetHex() const {
-  return StringUtil::ByteToString(data_);
+  std::string hex(data_.size() * 2, '\0');
+  StringUtil::ByteToString(data_.data(), data_.size(), &hex[0], hex.size());
+  return hex;
 }
 
 ByteData256& ByteData256::operator=(const ByteData256& object) {
@@ -289,14 +413,17 @@ ByteData256& ByteData256::operator=(const ByteData256& object) {
   return *this;
 }
 
-std::vector<uint8_t> ByteData256::GetBytes() const { return data_; }
+std::vector<uint8_t> ByteData256::GetBytes() const {
+  return std::vector<uint8_t>(data_.begin(), data_.end());
+}
 
 bool ByteData256::Empty() const { return IsEmpty(); }
 
 bool ByteData256::IsEmpty() const {
-  std::vector<uint8_t> data(kByteData256Length);
-  memset(data.data(), 0, data.size());
-  return data_ == data;
+  for (const auto& byte_data : data_) {
+    if (byte_data != 0) return false;
+  }
+  return true;
 }
 
 bool ByteData256::Equals(const ByteData256& bytedata) const {
@@ -306,7 +433,9 @@ bool ByteData256::Equals(const ByteData256& bytedata) const {
   return false;
 }
 
-ByteData ByteData256::GetData() const { return ByteData(data_); }
+ByteData ByteData256::GetData() const {
+  return ByteData(data_.data(), static_cast<uint32_t>(data_.size()));
+}
 
 uint8_t ByteData256::GetHeadData() const { return data_[0]; }
 
@@ -323,30 +452,83 @@ bool ByteData256::operator==(const ByteData256& object) const {
 //////////////////////////////////
 /// Serializer
 //////////////////////////////////
-Serializer::Serializer() : buffer_(8), offset_(0) {
-  // do nothing
+Serializer::Serializer() : Serializer(kOutputBuffer) { buffer_.resize(8); }
+
+Serializer::Serializer(uint32_t initial_size) : Serializer(kOutputBuffer) {
+  buffer_.resize(static_cast<size_t>(initial_size) + 9);
 }
 
-Serializer::Serializer(uint32_t initial_size)
-    : buffer_(static_cast<size_t>(initial_size) + 9), offset_(0) {
-  // do nothing
+Serializer::Serializer(uint8_t* buffer, uint32_t buffer_size)
+    : Serializer(kOutputExternalBuffer) {
+  if ((buffer == nullptr) && (buffer_size != 0)) {
+    warn(CFD_LOG_SOURCE, "Serializer buffer is null.");
+    throw CfdException(
+        kCfdIllegalArgumentError, "Serializer buffer is null.");
+  }
+  external_buffer_ = buffer;
+  external_size_ = buffer_size;
+}
+
+Serializer::Serializer(OutputMode mode)
+    : buffer_(),
+      offset_(0),
+      mode_(mode),
+      external_buffer_(nullptr),
+      external_size_(0),
+      hash_prefix_size_(0),
+      hash_state_(),
+      hash_block_() {
+  if (mode == kOutputSha256) Sha256Initialize(hash_state_);
 }
 
 Serializer::Serializer(const Serializer& object)
-    : buffer_(object.buffer_), offset_(object.offset_) {
-  // do nothing
+    : buffer_(object.buffer_),
+      offset_(object.offset_),
+      mode_(object.mode_),
+      external_buffer_(object.external_buffer_),
+      external_size_(object.external_size_),
+      hash_prefix_size_(object.hash_prefix_size_) {
+  memcpy(hash_state_, object.hash_state_, sizeof(hash_state_));
+  memcpy(hash_block_, object.hash_block_, sizeof(hash_block_));
 }
 
 Serializer& Serializer::operator=(const Serializer& object) {
   if (this != &object) {
     buffer_ = object.buffer_;
     offset_ = object.offset_;
+    mode_ = object.mode_;
+    external_buffer_ = object.external_buffer_;
+    external_size_ = object.external_size_;
+    hash_prefix_size_ = object.hash_prefix_size_;
+    memcpy(hash_state_, object.hash_state_, sizeof(hash_state_));
+    memcpy(hash_block_, object.hash_block_, sizeof(hash_block_));
   }
   return *this;
 }
 
 bool Serializer::IsBigEndian() { return cfd::core::IsBigEndian(); }
 
+Serializer Serializer::CreateSizeCounter() {
+  return Serializer(kOutputSizeCounter);
+}
+
+Serializer Serializer::CreateSha256Sink() { return Serializer(kOutputSha256); }
+
+Serializer Serializer::CreateTaggedSha256Sink(const std::string& tag) {
+  uint8_t block[kSha256BlockSize];
+  uint32_t state[kSha256StateSize];
+  Sha256Initialize(state);
+  Sha256Finalize(
+      state, reinterpret_cast<const uint8_t*>(tag.data()), tag.size(),
+      tag.size(), block);
+  memcpy(&block[kSha256BlockSize / 2], block, kSha256BlockSize / 2);
+
+  Serializer obj(kOutputSha256);
+  Sha256Transform(obj.hash_state_, block, 1);
+  obj.hash_prefix_size_ = kSha256BlockSize;
+  return obj;
+}
+
 void Serializer::CheckNeedSize(uint32_t need_size) {
   size_t check_need_size = need_size;
   size_t size = buffer_.size() - static_cast<size_t>(offset_);
@@ -359,6 +541,54 @@ void Serializer::CheckNeedSize(uint32_t need_size) {
   }
 }
 
+void Serializer::WriteBytes(const uint8_t* buffer, uint32_t buffer_size) {
+  if (buffer_size > std::numeric_limits<uint32_t>::max() - offset_) {
+    warn(CFD_LOG_SOURCE, "It exceeds the handling size.");
+    throw CfdException(kCfdIllegalStateError, "It exceeds the handling size.");
+  }
+
+  switch (mode_) {
+    case kOutputExternalBuffer:
+      if (buffer_size > external_size_ - offset_) {
+        warn(CFD_LOG_SOURCE, "It exceeds the buffer size.");
+        throw CfdException(
+            kCfdIllegalStateError, "It exceeds the buffer size.");
+      }
+      memcpy(&external_buffer_[offset_], buffer, buffer_size);
+      break;
+    case kOutputSizeCounter:
+      break;
+    case kOutputSha256: {
+      const uint8_t* data = buffer;
+      size_t size = buffer_size;
+      size_t pending = offset_ % kSha256BlockSize;
+      if (pending != 0) {
+        size_t copy_size = std::min(kSha256BlockSize - pending, size);
+        memcpy(&hash_block_[pending], data, copy_size);
+        data += copy_size;
+        size -= copy_size;
+        if ((pending + copy_size) == kSha256BlockSize) {
+          Sha256Transform(hash_state_, hash_block_, 1);
+        }
+      }
+      size_t block_count = size / kSha256BlockSize;
+      if (block_count != 0) {
+        Sha256Transform(hash_state_, data, block_count);
+        data += block_count * kSha256BlockSize;
+        size -= block_count * kSha256BlockSize;
+      }
+      if (size != 0) memcpy(hash_block_, data, size);
+      break;
+    }
+    case kOutputBuffer:
+    default:
+      CheckNeedSize(buffer_size);
+      memcpy(&buffer_.data()[offset_], buffer, buffer_size);
+      break;
+  }
+  offset_ += buffer_size;
+}
+
 uint32_t Serializer::GetVariableIntSize(uint64_t value) {
   if (value <= kViMax8)
     return 1;
@@ -372,62 +602,61 @@ uint32_t Serializer::GetVariableIntSize(uint64_t value) {
 
 void Serializer::AddVariableInt(uint64_t value) {
   // TODO(k-matsuzawa) need endian support.
-  CheckNeedSize(9);
-  uint8_t* buf = &buffer_.data()[offset_];
+  uint8_t buf[9];
+  uint32_t size;
   if (value <= kViMax8) {
-    *buf = static_cast<uint8_t>(value);
-    ++offset_;
+    buf[0] = static_cast<uint8_t>(value);
+    size = 1;
   } else if (value <= std::numeric_limits<uint16_t>::max()) {
-    *buf = kViTag16;
-    ++buf;
+    buf[0] = kViTag16;
     uint16_t v16 = static_cast<uint16_t>(value);
-    memcpy(buf, &v16, sizeof(v16));
-    offset_ += sizeof(v16) + 1;
+    memcpy(&buf[1], &v16, sizeof(v16));
+    size = sizeof(v16) + 1;
   } else if (value <= std::numeric_limits<uint32_t>::max()) {
-    *buf = kViTag32;
-    ++buf;
+    buf[0] = kViTag32;
     uint32_t v32 = static_cast<uint32_t>(value);
-    memcpy(buf, &v32, sizeof(v32));
-    offset_ += sizeof(v32) + 1;
+    memcpy(&buf[1], &v32, sizeof(v32));
+    size = sizeof(v32) + 1;
   } else {
-    *buf = kViTag64;
-    ++buf;
+    buf[0] = kViTag64;
     uint64_t v64 = value;
-    memcpy(buf, &v64, sizeof(v64));
-    offset_ += sizeof(v64) + 1;
+    memcpy(&buf[1], &v64, sizeof(v64));
+    size = sizeof(v64) + 1;
   }
+  WriteBytes(buf, size);
 }
 
 void Serializer::AddVariableBuffer(const ByteData& buffer) {
-  auto buf = buffer.GetBytes();
-  if (buf.size() > std::numeric_limits<uint32_t>::max()) {
+  if (buffer.GetDataSize() > std::numeric_limits<uint32_t>::max()) {
     warn(CFD_LOG_SOURCE, "It exceeds the handling size.");
     throw CfdException(kCfdIllegalStateError, "It exceeds the handling size.");
   }
-  AddVariableBuffer(buf.data(), static_cast<uint32_t>(buf.size()));
+  AddVariableBuffer(
+      buffer.GetDataAddress(), static_cast<uint32_t>(buffer.GetDataSize()));
 }
 
 void Serializer::AddPrefixBuffer(uint64_t prefix, const ByteData& buffer) {
-  auto buf = buffer.GetBytes();
-  if (buf.size() > std::numeric_limits<uint32_t>::max()) {
+  if (buffer.GetDataSize() > std::numeric_limits<uint32_t>::max()) {
     warn(CFD_LOG_SOURCE, "It exceeds the handling size.");
     throw CfdException(kCfdIllegalStateError, "It exceeds the handling size.");
   }
-  AddPrefixBuffer(prefix, buf.data(), static_cast<uint32_t>(buf.size()));
+  AddPrefixBuffer(
+      prefix, buffer.GetDataAddress(),
+      static_cast<uint32_t>(buffer.GetDataSize()));
 }
 
 void Serializer::AddDirectBytes(const ByteData& buffer) {
-  auto buf = buffer.GetBytes();
-  if (buf.size() > std::numeric_limits<uint32_t>::max()) {
+  if (buffer.GetDataSize() > std::numeric_limits<uint32_t>::max()) {
     warn(CFD_LOG_SOURCE, "It exceeds the handling size.");
     throw CfdException(kCfdIllegalStateError, "It exceeds the handling size.");
   }
-  AddDirectBytes(buf.data(), static_cast<uint32_t>(buf.size()));
+  AddDirectBytes(
+      buffer.GetDataAddress(), static_cast<uint32_t>(buffer.GetDataSize()));
 }
 
 void Serializer::AddDirectBytes(const ByteData256& buffer) {
-  auto buf = buffer.GetBytes();
-  AddDirectBytes(buf.data(), static_cast<uint32_t>(buf.size()));
+  AddDirectBytes(
+      buffer.data_.data(), static_cast<uint32_t>(buffer.data_.size()));
 }
 
 void Serializer::AddVariableBuffer(
@@ -446,59 +675,43 @@ void Serializer::AddPrefixBuffer(
 
 void Serializer::AddDirectBytes(const uint8_t* buffer, uint32_t buffer_size) {
   if ((buffer != nullptr) && (buffer_size != 0)) {
-    CheckNeedSize(buffer_size);
-    uint8_t* buf = &buffer_.data()[offset_];
-    memcpy(buf, buffer, buffer_size);
-    offset_ += buffer_size;
+    WriteBytes(buffer, buffer_size);
   }
 }
 
 void Serializer::AddDirectByte(uint8_t byte_data) {
-  CheckNeedSize(4);
-  uint8_t* buf = &buffer_.data()[offset_];
-  *buf = byte_data;
-  ++offset_;
+  WriteBytes(&byte_data, 1);
 }
 
 void Serializer::AddDirectNumber(uint32_t number) {
-  CheckNeedSize(sizeof(number));
-  uint8_t* buf = &buffer_.data()[offset_];
+  uint8_t buf[sizeof(number)];
   // TODO(k-matsuzawa) need endian support.
   memcpy(buf, &number, sizeof(number));
-  offset_ += sizeof(number);
+  WriteBytes(buf, sizeof(buf));
 }
 
 void Serializer::AddDirectNumber(uint64_t number) {
-  CheckNeedSize(sizeof(number));
-  uint8_t* buf = &buffer_.data()[offset_];
+  uint8_t buf[sizeof(number)];
   // TODO(k-matsuzawa) need endian support.
   memcpy(buf, &number, sizeof(number));
-  offset_ += sizeof(number);
+  WriteBytes(buf, sizeof(buf));
 }
 
 void Serializer::AddDirectNumber(int64_t number) {
-  CheckNeedSize(sizeof(number));
-  uint8_t* buf = &buffer_.data()[offset_];
+  uint8_t buf[sizeof(number)];
   // TODO(k-matsuzawa) need endian support.
   memcpy(buf, &number, sizeof(number));
-  offset_ += sizeof(number);
+  WriteBytes(buf, sizeof(buf));
 }
 
 void Serializer::AddDirectBigEndianNumber(uint32_t number) {
-  CheckNeedSize(sizeof(number));
-  uint8_t* buf = &buffer_.data()[offset_];
-  if (IsBigEndian()) {
-    memcpy(buf, &number, sizeof(number));
-  } else {
-    uint8_t tmp_buf[4] = {
-        static_cast<uint8_t>((number & 0xff000000) >> 24),
-        static_cast<uint8_t>((number & 0x00ff0000) >> 16),
-        static_cast<uint8_t>((number & 0x0000ff00) >> 8),
-        static_cast<uint8_t>(number & 0x000000ff),
-    };
-    memcpy(buf, tmp_buf, sizeof(tmp_buf));
-  }
-  offset_ += sizeof(number);
+  uint8_t buf[sizeof(number)] = {
+      static_cast<uint8_t>((number & 0xff000000) >> 24),
+      static_cast<uint8_t>((number & 0x00ff0000) >> 16),
+      static_cast<uint8_t>((number & 0x0000ff00) >> 8),
+      static_cast<uint8_t>(number & 0x000000ff),
+  };
+  WriteBytes(buf, sizeof(buf));
 }
 
 Serializer& Serializer::operator<<(const ByteData& buffer) {
@@ -531,149 +744,315 @@ Serializer& Serializer::operator<<(int64_t number) {
   return *this;
 }
 
-ByteData Serializer::Output() { return ByteData(buffer_.data(), offset_); }
+ByteData Serializer::Output() {
+  if (mode_ == kOutputExternalBuffer) {
+    return ByteData(external_buffer_, offset_);
+  } else if (mode_ != kOutputBuffer) {
+    warn(CFD_LOG_SOURCE, "Serializer has no output buffer.");
+    throw CfdException(
+        kCfdIllegalStateError, "Serializer has no output buffer.");
+  }
+  return ByteData(buffer_.data(), offset_);
+}
 
-Deserializer::Deserializer(const std::vector<uint8_t>& buffer)
-    : buffer_(buffer), offset_(0) {
+ByteData256 Serializer::OutputSha256() {
+  ByteData256 result;
+  CalculateSha256(result.data_.data());
+  return result;
+}
+
+ByteData256 Serializer::OutputSha256d() {
+  uint8_t hash[kSha256StateSize * sizeof(uint32_t)];
+  CalculateSha256(hash);
+  uint32_t state[kSha256StateSize];
+  Sha256Initialize(state);
+  ByteData256 result;
+  Sha256Finalize(state, hash, sizeof(hash), sizeof(hash), result.data_.data());
+  return result;
+}
+
+uint32_t Serializer::GetWriteSize() const { return offset_; }
+
+void Serializer::CalculateSha256(uint8_t* hash) const {
+  if (mode_ == kOutputSha256) {
+    Sha256Finalize(
+        hash_state_, hash_block_, offset_ % kSha256BlockSize,
+        static_cast<uint64_t>(hash_prefix_size_) + offset_, hash);
+  } else if (mode_ == kOutputSizeCounter) {
+    warn(CFD_LOG_SOURCE, "Serializer has no output buffer.");
+    throw CfdException(
+        kCfdIllegalStateError, "Serializer has no output buffer.");
+  } else {
+    const uint8_t* data = (mode_ == kOutputExternalBuffer) ? external_buffer_
+                                                           : buffer_.data();
+    uint32_t state[kSha256StateSize];
+    Sha256Initialize(state);
+    Sha256Finalize(state, data, offset_, offset_, hash);
+  }
+}
+
+//////////////////////////////////
+/// ByteSpan
+//////////////////////////////////
+ByteSpan::ByteSpan(const ByteData& byte_data)
+    : data_(byte_data.GetDataAddress()), size_(byte_data.GetDataSize()) {
   // do nothing
 }
 
+ByteSpan ByteSpan::SubSpan(size_t offset, size_t size) const {
+  if ((offset > size_) || (size > (size_ - offset))) {
+    warn(CFD_LOG_SOURCE, "ByteSpan out of range.");
+    throw CfdException(kCfdOutOfRangeError, "ByteSpan out of range.");
+  }
+  return ByteSpan(data_ + offset, size);
+}
+
+ByteData ByteSpan::GetData() const {
+  ByteData result;
+  result.SetData(data_, size_);
+  return result;
+}
+
+std::vector<uint8_t> ByteSpan::GetBytes() const {
+  return std::vector<uint8_t>(data_, data_ + size_);
+}
+
+std::string ByteSpan::GetHex() const {
+  std::string hex(size_ * 2, '\0');
+  if (size_ != 0) {
+    StringUtil::ByteToString(data_, size_, &hex[0], hex.size());
+  }
+  return hex;
+}
+
+//////////////////////////////////
+/// Deserializer
+//////////////////////////////////
+/**
+ * @brief Load the little endian number.
+ * @details The byte order is resolved at compile time.
+ * @param[in] data  data
+ * @return number
+ */
+template <typename T>
+static inline T LoadLittleEndian(const uint8_t* data) {
+  T value;
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && \
+    (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  value = 0;
+  for (size_t index = sizeof(T); index > 0; --index) {
+    value = static_cast<T>((value << 8) | data[index - 1]);
+  }
+#else
+  memcpy(&value, data, sizeof(value));
+#endif
+  return value;
+}
+
+/**
+ * @brief Load the big endian number.
+ * @details Compilers lower this loop to a byte swap load.
+ * @param[in] data  data
+ * @return number
+ */
+template <typename T>
+static inline T LoadBigEndian(const uint8_t* data) {
+  T value = 0;
+  for (size_t index = 0; index < sizeof(T); ++index) {
+    value = static_cast<T>((value << 8) | data[index]);
+  }
+  return value;
+}
+
+Deserializer::Deserializer(const std::vector<uint8_t>& buffer)
+    : buffer_(buffer), offset_(0), read_data_(nullptr), read_size_(0) {
+  SetReadData(buffer_.GetDataAddress(), buffer_.GetDataSize());
+}
+
 Deserializer::Deserializer(const ByteData& buffer)
-    : Deserializer(buffer.GetBytes()) {
+    : buffer_(buffer), offset_(0), read_data_(nullptr), read_size_(0) {
+  SetReadData(buffer_.GetDataAddress(), buffer_.GetDataSize());
+}
+
+Deserializer::Deserializer(const uint8_t* buffer, size_t size)
+    : buffer_(), offset_(0), read_data_(nullptr), read_size_(0) {
+  if ((buffer == nullptr) && (size != 0)) {
+    warn(CFD_LOG_SOURCE, "Deserializer buffer is null.");
+    throw CfdException(
+        kCfdIllegalArgumentError, "Deserializer buffer is null.");
+  }
+  SetReadData(buffer, size);
+}
+
+Deserializer::Deserializer(const ByteSpan& buffer)
+    : Deserializer(buffer.data(), buffer.size()) {
   // do nothing
 }
 
 Deserializer::Deserializer(const Deserializer& object)
-    : buffer_(object.buffer_), offset_(object.offset_) {
-  // do nothing
+    : buffer_(object.buffer_),
+      offset_(object.offset_),
+      read_data_(object.read_data_),
+      read_size_(object.read_size_) {
+  if (object.read_data_ == object.buffer_.GetDataAddress()) {
+    read_data_ = buffer_.GetDataAddress();
+  }
 }
 
 Deserializer& Deserializer::operator=(const Deserializer& object) {
   if (this != &object) {
     buffer_ = object.buffer_;
     offset_ = object.offset_;
+    read_size_ = object.read_size_;
+    if (object.read_data_ == object.buffer_.GetDataAddress()) {
+      read_data_ = buffer_.GetDataAddress();
+    } else {
+      read_data_ = object.read_data_;
+    }
   }
   return *this;
 }
 
+void Deserializer::SetReadData(const uint8_t* buffer, size_t size) {
+  if (size > std::numeric_limits<uint32_t>::max()) {
+    warn(CFD_LOG_SOURCE, "It exceeds the handling size.");
+    throw CfdException(kCfdIllegalStateError, "It exceeds the handling size.");
+  }
+  read_data_ = buffer;
+  read_size_ = static_cast<uint32_t>(size);
+}
+
 uint64_t Deserializer::ReadUint64() {
-  uint64_t result = 0;
-  CheckReadSize(sizeof(result));
-  memcpy(&result, &buffer_.data()[offset_], sizeof(result));
+  CheckReadSize(sizeof(uint64_t));
+  uint64_t result = LoadLittleEndian<uint64_t>(read_data_ + offset_);
   offset_ += sizeof(result);
   return result;
 }
 
 uint32_t Deserializer::ReadUint32() {
-  uint32_t result = 0;
-  CheckReadSize(sizeof(result));
-  memcpy(&result, &buffer_.data()[offset_], sizeof(result));
+  CheckReadSize(sizeof(uint32_t));
+  uint32_t result = LoadLittleEndian<uint32_t>(read_data_ + offset_);
   offset_ += sizeof(result);
   return result;
 }
 
 uint8_t Deserializer::ReadUint8() {
-  uint8_t result = 0;
-  CheckReadSize(sizeof(result));
-  memcpy(&result, &buffer_.data()[offset_], sizeof(result));
+  CheckReadSize(sizeof(uint8_t));
+  uint8_t result = read_data_[offset_];
   offset_ += sizeof(result);
   return result;
 }
 
 uint32_t Deserializer::ReadUint32FromBigEndian() {
-  uint32_t result = 0;
-  CheckReadSize(sizeof(result));
-  if (IsBigEndian()) {
-    memcpy(&result, &buffer_.data()[offset_], sizeof(result));
-  } else {
-    uint8_t tmp_buf[4];
-    memcpy(tmp_buf, &buffer_.data()[offset_], sizeof(tmp_buf));
-    result = static_cast<uint32_t>(tmp_buf[3] & 0x000000ff) +
-             static_cast<uint32_t>((tmp_buf[2] << 8) & 0x0000ff00) +
-             static_cast<uint32_t>((tmp_buf[1] << 16) & 0x00ff0000) +
-             static_cast<uint32_t>((tmp_buf[0] << 24) & 0xff000000);
-  }
+  CheckReadSize(sizeof(uint32_t));
+  uint32_t result = LoadBigEndian<uint32_t>(read_data_ + offset_);
   offset_ += sizeof(result);
   return result;
 }
 
 uint64_t Deserializer::ReadVariableInt() {
   CheckReadSize(1);
-  const uint8_t* buf = buffer_.data() + offset_;
+  const uint8_t* buf = read_data_ + offset_;
   uint64_t value = 0;
   if (*buf <= Serializer::kViMax8) {
     value = *buf;
     offset_ += 1;
   } else if (*buf == Serializer::kViTag16) {
     CheckReadSize(3);
-    ++buf;
-    uint16_t num;
-    memcpy(&num, buf, sizeof(num));
-    value = num;
-    offset_ += 1 + sizeof(num);
+    value = LoadLittleEndian<uint16_t>(buf + 1);
+    offset_ += 1 + sizeof(uint16_t);
   } else if (*buf == Serializer::kViTag32) {
     CheckReadSize(5);
-    ++buf;
-    uint32_t num;
-    memcpy(&num, buf, sizeof(num));
-    value = num;
-    offset_ += 1 + sizeof(num);
+    value = LoadLittleEndian<uint32_t>(buf + 1);
+    offset_ += 1 + sizeof(uint32_t);
   } else {
     CheckReadSize(9);
-    ++buf;
-    uint64_t num;
-    memcpy(&num, buf, sizeof(num));
-    value = num;
-    offset_ += 1 + sizeof(num);
+    value = LoadLittleEndian<uint64_t>(buf + 1);
+    offset_ += 1 + sizeof(uint64_t);
   }
   return value;
 }
 
 std::vector<uint8_t> Deserializer::ReadBuffer(uint32_t size) {
-  CheckReadSize(size);
-  std::vector<uint8_t> result(size);
-  memcpy(result.data(), &buffer_.data()[offset_], size);
-  offset_ += size;
-  return result;
+  ByteSpan span = ReadSpan(size);
+  return std::vector<uint8_t>(span.begin(), span.end());
 }
 
 void Deserializer::ReadArray(uint8_t* output, size_t size) {
   if (output != nullptr) {
     CheckReadSize(size);
-    memcpy(output, &buffer_.data()[offset_], size);
+    if (size != 0) memcpy(output, read_data_ + offset_, size);
     offset_ += static_cast<uint32_t>(size);
   }
 }
 
 std::vector<uint8_t> Deserializer::ReadVariableBuffer() {
-  // TODO(k-matsuzawa) need endian support.
+  ByteSpan span = ReadVariableSpan();
+  return std::vector<uint8_t>(span.begin(), span.end());
+}
+
+ByteData Deserializer::ReadVariableData() {
+  return ReadVariableSpan().GetData();
+}
+
+ByteSpan Deserializer::ReadSpan(uint32_t size) {
+  CheckReadSize(size);
+  ByteSpan result(read_data_ + offset_, size);
+  offset_ += size;
+  return result;
+}
+
+ByteSpan Deserializer::ReadVariableSpan() {
   uint64_t data_size = ReadVariableInt();
-  if (data_size == 0) {
-    return std::vector<uint8_t>();
-  }
   CheckReadSize(data_size);
-
-  uint8_t* buf = buffer_.data() + offset_;
-  std::vector<uint8_t> result(data_size);
-  memcpy(result.data(), buf, data_size);
+  ByteSpan result(read_data_ + offset_, static_cast<size_t>(data_size));
   offset_ += static_cast<uint32_t>(data_size);
   return result;
 }
 
-ByteData Deserializer::ReadVariableData() {
-  return ByteData(ReadVariableBuffer());
+void Deserializer::ReadUint32Array(uint32_t* output, size_t count) {
+  if ((output != nullptr) && (count != 0)) {
+    CheckReadSize(static_cast<uint64_t>(count) * sizeof(uint32_t));
+    const uint8_t* buf = read_data_ + offset_;
+    for (size_t index = 0; index < count; ++index) {
+      output[index] = LoadLittleEndian<uint32_t>(buf + index * 4);
+    }
+    offset_ += static_cast<uint32_t>(count * sizeof(uint32_t));
+  }
+}
+
+void Deserializer::ReadUint64Array(uint64_t* output, size_t count) {
+  if ((output != nullptr) && (count != 0)) {
+    CheckReadSize(static_cast<uint64_t>(count) * sizeof(uint64_t));
+    const uint8_t* buf = read_data_ + offset_;
+    for (size_t index = 0; index < count; ++index) {
+      output[index] = LoadLittleEndian<uint64_t>(buf + index * 8);
+    }
+    offset_ += static_cast<uint32_t>(count * sizeof(uint64_t));
+  }
+}
+
+void Deserializer::Skip(uint32_t size) {
+  CheckReadSize(size);
+  offset_ += size;
+}
+
+void Deserializer::SkipVariableBuffer() {
+  uint64_t data_size = ReadVariableInt();
+  CheckReadSize(data_size);
+  offset_ += static_cast<uint32_t>(data_size);
 }
 
 uint32_t Deserializer::GetReadSize() { return offset_; }
 
-bool Deserializer::HasEof() { return (buffer_.size() <= offset_); }
+bool Deserializer::HasEof() { return (read_size_ <= offset_); }
 
 void Deserializer::CheckReadSize(uint64_t size) {
   if (size > std::numeric_limits<uint32_t>::max()) {
     warn(CFD_LOG_SOURCE, "It exceeds the handling size.");
     throw CfdException(kCfdIllegalStateError, "It exceeds the handling size.");
   }
-  if (buffer_.size() < (offset_ + size)) {
+  if ((read_size_ < offset_) || ((read_size_ - offset_) < size)) {
     warn(CFD_LOG_SOURCE, "deserialize buffer EOF.");
     throw CfdException(kCfdIllegalStateError, "deserialize buffer EOF.");
   }
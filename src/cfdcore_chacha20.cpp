@@ -0,0 +1,112 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_chacha20.cpp
+ *
+ * @brief ChaCha20 block function for the random number generator.
+ */
+#include "cfdcore_chacha20.h"  // NOLINT
+
+namespace cfd {
+namespace core {
+
+/// ChaCha20 state word count
+static constexpr size_t kChaCha20StateSize = 16;
+/// ChaCha20 double round count
+static constexpr size_t kChaCha20DoubleRoundCount = 10;
+
+/**
+ * @brief Read the 32bit little-endian value.
+ * @param[in] data    data (4 bytes)
+ * @return value
+ */
+static inline uint32_t ReadLe32(const uint8_t *data) {
+  return static_cast<uint32_t>(data[0]) |
+         (static_cast<uint32_t>(data[1]) << 8) |
+         (static_cast<uint32_t>(data[2]) << 16) |
+         (static_cast<uint32_t>(data[3]) << 24);
+}
+
+/**
+ * @brief Write the 32bit little-endian value.
+ * @param[in] value   value
+ * @param[out] data   data (4 bytes)
+ */
+static inline void WriteLe32(uint32_t value, uint8_t *data) {
+  data[0] = static_cast<uint8_t>(value);
+  data[1] = static_cast<uint8_t>(value >> 8);
+  data[2] = static_cast<uint8_t>(value >> 16);
+  data[3] = static_cast<uint8_t>(value >> 24);
+}
+
+/**
+ * @brief Rotate the 32bit value to the left.
+ * @param[in] value   value
+ * @param[in] count   rotate bit count
+ * @return value
+ */
+static inline uint32_t RotateLeft32(uint32_t value, int count) {
+  return (value << count) | (value >> (32 - count));
+}
+
+/**
+ * @brief Apply the ChaCha quarter round.
+ * @param[in,out] x   state
+ * @param[in] a       index a
+ * @param[in] b       index b
+ * @param[in] c       index c
+ * @param[in] d       index d
+ */
+static inline void QuarterRound(
+    uint32_t *x, size_t a, size_t b, size_t c, size_t d) {
+  x[a] += x[b];
+  x[d] = RotateLeft32(x[d] ^ x[a], 16);
+  x[c] += x[d];
+  x[b] = RotateLeft32(x[b] ^ x[c], 12);
+  x[a] += x[b];
+  x[d] = RotateLeft32(x[d] ^ x[a], 8);
+  x[c] += x[d];
+  x[b] = RotateLeft32(x[b] ^ x[c], 7);
+}
+
+void ChaCha20Keystream(
+    const uint8_t *key, const uint8_t *nonce, uint32_t counter,
+    uint8_t *output, size_t count) {
+  uint32_t state[kChaCha20StateSize];
+  // "expand 32-byte k"
+  state[0] = 0x61707865;
+  state[1] = 0x3320646e;
+  state[2] = 0x79622d32;
+  state[3] = 0x6b206574;
+  for (size_t index = 0; index < 8; ++index) {
+    state[4 + index] = ReadLe32(key + index * 4);
+  }
+  state[12] = counter;
+  for (size_t index = 0; index < 3; ++index) {
+    state[13 + index] = ReadLe32(nonce + index * 4);
+  }
+
+  uint32_t work[kChaCha20StateSize];
+  for (size_t block = 0; block < count; ++block) {
+    for (size_t index = 0; index < kChaCha20StateSize; ++index) {
+      work[index] = state[index];
+    }
+    for (size_t round = 0; round < kChaCha20DoubleRoundCount; ++round) {
+      QuarterRound(work, 0, 4, 8, 12);
+      QuarterRound(work, 1, 5, 9, 13);
+      QuarterRound(work, 2, 6, 10, 14);
+      QuarterRound(work, 3, 7, 11, 15);
+      QuarterRound(work, 0, 5, 10, 15);
+      QuarterRound(work, 1, 6, 11, 12);
+      QuarterRound(work, 2, 7, 8, 13);
+      QuarterRound(work, 3, 4, 9, 14);
+    }
+    uint8_t *block_output = output + block * kChaCha20BlockSize;
+    for (size_t index = 0; index < kChaCha20StateSize; ++index) {
+      WriteLe32(work[index] + state[index], block_output + index * 4);
+    }
+    ++state[12];
+  }
+}
+
+}  // namespace core
+}  // namespace cfd
@@ -0,0 +1,38 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_chacha20.h
+ * @brief ChaCha20 block function for the random number generator.
+ *
+ */
+#ifndef CFD_CORE_SRC_CFDCORE_CHACHA20_H_
+#define CFD_CORE_SRC_CFDCORE_CHACHA20_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cfd {
+namespace core {
+
+//! ChaCha20 block size
+constexpr size_t kChaCha20BlockSize = 64;
+//! ChaCha20 key size
+constexpr size_t kChaCha20KeySize = 32;
+//! ChaCha20 nonce size (RFC 8439)
+constexpr size_t kChaCha20NonceSize = 12;
+
+/**
+ * @brief Generate the ChaCha20 keystream blocks. (RFC 8439)
+ * @param[in] key       key (32 bytes)
+ * @param[in] nonce     nonce (12 bytes)
+ * @param[in] counter   block counter of the first block
+ * @param[out] output   keystream (count * kChaCha20BlockSize bytes)
+ * @param[in] count     block count
+ */
+void ChaCha20Keystream(
+    const uint8_t *key, const uint8_t *nonce, uint32_t counter,
+    uint8_t *output, size_t count);
+
+}  // namespace core
+}  // namespace cfd
+
+#endif  // CFD_CORE_SRC_CFDCORE_CHACHA20_H_
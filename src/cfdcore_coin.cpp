@@ -7,6 +7,7 @@
 #include "cfdcore/cfdcore_coin.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_exception.h"
@@ -42,6 +43,8 @@ Txid::Txid(const ByteData256& data) : data_(ByteData(data.GetBytes())) {
 
 Txid::Txid(const Txid& object) { data_ = object.data_; }
 
+Txid::Txid(Txid&& object) noexcept : data_(std::move(object.data_)) {}
+
 Txid& Txid::operator=(const Txid& object) {
   if (this != &object) {
     data_ = object.data_;
@@ -49,6 +52,13 @@ Txid& Txid::operator=(const Txid& object) {
   return *this;
 }
 
+Txid& Txid::operator=(Txid&& object) noexcept {
+  if (this != &object) {
+    data_ = std::move(object.data_);
+  }
+  return *this;
+}
+
 const std::string Txid::GetHex() const {
   const std::vector<uint8_t>& data = data_.GetBytes();
   std::vector<uint8_t> reverse_buffer(data.crbegin(), data.crend());
@@ -91,6 +101,9 @@ BlockHash::BlockHash(const ByteData256& data)
 
 BlockHash::BlockHash(const BlockHash& object) { data_ = object.data_; }
 
+BlockHash::BlockHash(BlockHash&& object) noexcept
+    : data_(std::move(object.data_)) {}
+
 BlockHash& BlockHash::operator=(const BlockHash& object) {
   if (this != &object) {
     data_ = object.data_;
@@ -98,6 +111,13 @@ BlockHash& BlockHash::operator=(const BlockHash& object) {
   return *this;
 }
 
+BlockHash& BlockHash::operator=(BlockHash&& object) noexcept {
+  if (this != &object) {
+    data_ = std::move(object.data_);
+  }
+  return *this;
+}
+
 const std::string BlockHash::GetHex() const {
   const std::vector<uint8_t>& data = data_.GetBytes();
   std::vector<uint8_t> reverse_buffer(data.crbegin(), data.crend());
@@ -0,0 +1,40 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_cpu.cpp
+ *
+ * @brief CPU feature detection for the SIMD implementations.
+ *
+ */
+#include "cfdcore_cpu.h"  // NOLINT
+
+namespace cfd {
+namespace core {
+
+#ifdef CFD_CORE_USE_X86_SIMD
+bool IsSupportAesNi() {
+  static const bool kIsSupport = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("aes") != 0;
+  }();
+  return kIsSupport;
+}
+
+bool IsSupportSsse3() {
+  static const bool kIsSupport = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") != 0;
+  }();
+  return kIsSupport;
+}
+
+bool IsSupportAvx2() {
+  static const bool kIsSupport = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+  return kIsSupport;
+}
+#endif  // CFD_CORE_USE_X86_SIMD
+
+}  // namespace core
+}  // namespace cfd
@@ -0,0 +1,46 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_cpu.h
+ *
+ * @brief CPU feature detection for the SIMD implementations.
+ *
+ */
+#ifndef CFD_CORE_SRC_CFDCORE_CPU_H_
+#define CFD_CORE_SRC_CFDCORE_CPU_H_
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+#define CFD_CORE_USE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace cfd {
+namespace core {
+
+#ifdef CFD_CORE_USE_X86_SIMD
+/**
+ * @brief Check the AES-NI support.
+ * @retval true   supported
+ * @retval false  not supported
+ */
+bool IsSupportAesNi();
+
+/**
+ * @brief Check the SSSE3 support.
+ * @retval true   supported
+ * @retval false  not supported
+ */
+bool IsSupportSsse3();
+
+/**
+ * @brief Check the AVX2 support.
+ * @retval true   supported
+ * @retval false  not supported
+ */
+bool IsSupportAvx2();
+#endif  // CFD_CORE_USE_X86_SIMD
+
+}  // namespace core
+}  // namespace cfd
+
+#endif  // CFD_CORE_SRC_CFDCORE_CPU_H_
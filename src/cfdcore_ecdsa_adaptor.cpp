@@ -4,9 +4,12 @@
 
 #include <cstring>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_exception.h"
+#include "cfdcore_manager.h"          // NOLINT
+#include "cfdcore_thread_util.h"      // NOLINT
 #include "secp256k1.h"                // NOLINT
 #include "secp256k1_ecdsa_adaptor.h"  // NOLINT
 #include "secp256k1_util.h"           // NOLINT
@@ -20,6 +23,26 @@ using cfd::core::ByteData256;
 using cfd::core::CfdError;
 using cfd::core::CfdException;
 
+//! minimum signature count per worker thread of the batch functions
+static constexpr size_t kAdaptorBatchMinUnit = 8;
+
+/**
+ * @brief Parse the pubkey without throwing.
+ * @param[in] ctx       secp256k1 context
+ * @param[in] pubkey    pubkey
+ * @param[out] result   parsed pubkey
+ * @retval true   success
+ * @retval false  invalid pubkey
+ */
+static bool TryParsePubkey(
+    const secp256k1_context *ctx, const Pubkey &pubkey,
+    secp256k1_pubkey *result) {
+  const auto pubkey_bytes = pubkey.GetData().GetBytes();
+  return (!pubkey_bytes.empty()) &&
+         (secp256k1_ec_pubkey_parse(
+              ctx, result, pubkey_bytes.data(), pubkey_bytes.size()) == 1);
+}
+
 // ------------------------
 // AdaptorSignature
 // ------------------------
@@ -43,9 +66,20 @@ AdaptorSignature &AdaptorSignature::operator=(
   return *this;
 }
 
+AdaptorSignature::AdaptorSignature(AdaptorSignature &&signature) noexcept
+    : data_(std::move(signature.data_)) {
+  // do nothing
+}
+
+AdaptorSignature &AdaptorSignature::operator=(
+    AdaptorSignature &&signature) & noexcept {
+  if (this != &signature) data_ = std::move(signature.data_);
+  return *this;
+}
+
 AdaptorSignature AdaptorSignature::Encrypt(
     const ByteData256 &msg, const Privkey &sk, const Pubkey &encryption_key) {
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   std::vector<uint8_t> adaptor_sig_raw(
       AdaptorSignature::kAdaptorSignatureSize);
   auto adaptor_key = ParsePubkey(encryption_key);
@@ -60,12 +94,97 @@ AdaptorSignature AdaptorSignature::Encrypt(
   return AdaptorSignature(adaptor_sig_raw);
 }
 
+std::vector<AdaptorSignature> AdaptorSignature::EncryptBatch(
+    const std::vector<ByteData256> &msgs, const Privkey &sk,
+    const std::vector<Pubkey> &encryption_keys, uint32_t thread_count) {
+  if (msgs.size() != encryption_keys.size()) {
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError,
+        "Expected same number of messages and encryption keys.");
+  }
+
+  if (!sk.IsValid()) {
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid secret key.");
+  }
+
+  // the signer key is shared by all workers.
+  std::vector<uint8_t> sk_bytes = sk.GetData().GetBytes();
+  std::vector<AdaptorSignature> result(msgs.size());
+  try {
+    ParallelFor(
+        msgs.size(), thread_count, kAdaptorBatchMinUnit,
+        [&msgs, &sk_bytes, &encryption_keys, &result](
+            size_t begin, size_t end) {
+          auto ctx = GetSecp256k1Context();
+          std::vector<uint8_t> adaptor_sig_raw(
+              AdaptorSignature::kAdaptorSignatureSize);
+          secp256k1_pubkey adaptor_key;
+          for (size_t index = begin; index < end; ++index) {
+            if (!TryParsePubkey(ctx, encryption_keys[index], &adaptor_key)) {
+              continue;
+            }
+            auto ret = secp256k1_ecdsa_adaptor_encrypt(
+                ctx, adaptor_sig_raw.data(), sk_bytes.data(), &adaptor_key,
+                msgs[index].GetBytes().data(), nullptr, nullptr);
+            if (ret == 1) {
+              result[index].data_ = ByteData(adaptor_sig_raw);
+            }
+          }
+        });
+  } catch (...) {
+    wally_bzero(sk_bytes.data(), sk_bytes.size());
+    throw;
+  }
+  wally_bzero(sk_bytes.data(), sk_bytes.size());
+  return result;
+}
+
+bool AdaptorSignature::VerifyBatch(
+    const std::vector<AdaptorSignature> &signatures,
+    const std::vector<ByteData256> &msgs, const Pubkey &pubkey,
+    const std::vector<Pubkey> &encryption_keys,
+    std::vector<uint32_t> *invalid_indexes, uint32_t thread_count) {
+  if ((signatures.size() != msgs.size()) ||
+      (signatures.size() != encryption_keys.size())) {
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError,
+        "Expected same number of signatures, messages and encryption keys.");
+  }
+
+  std::vector<uint8_t> results(signatures.size(), 0);
+  secp256k1_pubkey secp_pubkey;
+  if (TryParsePubkey(GetSecp256k1Context(), pubkey, &secp_pubkey)) {
+    ParallelFor(
+        signatures.size(), thread_count, kAdaptorBatchMinUnit,
+        [&signatures, &msgs, &secp_pubkey, &encryption_keys, &results](
+            size_t begin, size_t end) {
+          auto ctx = GetSecp256k1Context();
+          secp256k1_pubkey secp_adaptor;
+          for (size_t index = begin; index < end; ++index) {
+            if ((!signatures[index].IsValid()) ||
+                (!TryParsePubkey(
+                    ctx, encryption_keys[index], &secp_adaptor))) {
+              continue;
+            }
+            results[index] = static_cast<uint8_t>(
+                secp256k1_ecdsa_adaptor_verify(
+                    ctx, signatures[index].data_.GetBytes().data(),
+                    &secp_pubkey, msgs[index].GetBytes().data(),
+                    &secp_adaptor) == 1);
+          }
+        });
+  }
+
+  return CollectBatchResult(results, invalid_indexes);
+}
+
 ByteData AdaptorSignature::Decrypt(const Privkey &sk) const {
   if (!IsValid()) {
     throw CfdException(
         CfdError::kCfdIllegalStateError, "Invalid adaptor signature.");
   }
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   secp256k1_ecdsa_signature secp_signature;
   auto ret = secp256k1_ecdsa_adaptor_decrypt(
       ctx, &secp_signature, sk.GetData().GetBytes().data(),
@@ -93,7 +212,7 @@ Privkey AdaptorSignature::Recover(
     throw CfdException(
         CfdError::kCfdIllegalStateError, "Invalid adaptor signature.");
   }
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   std::vector<uint8_t> secret(Privkey::kPrivkeySize);
   auto secp_sig = ParseSignature(signature);
   auto secp_adaptor = ParsePubkey(encryption_key);
@@ -115,7 +234,7 @@ bool AdaptorSignature::Verify(
     throw CfdException(
         CfdError::kCfdIllegalStateError, "Invalid adaptor signature.");
   }
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   auto secp_pubkey = ParsePubkey(pubkey);
   auto secp_adaptor = ParsePubkey(encryption_key);
   return secp256k1_ecdsa_adaptor_verify(
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_bytedata.h"
@@ -17,6 +18,7 @@
 #include "cfdcore/cfdcore_logger.h"
 #include "cfdcore/cfdcore_script.h"
 #include "cfdcore/cfdcore_util.h"
+#include "cfdcore_thread_util.h"  // NOLINT
 #include "cfdcore_wally_util.h"  // NOLINT
 
 namespace cfd {
@@ -43,14 +45,14 @@ struct ElementsBlindAddressFormat {
  * @brief get Blind address key pair list.
  * @return Blind address key pair list.
  */
-static std::vector<ElementsBlindAddressFormat> GetBlindKeyPair() {
-  std::vector<ElementsBlindAddressFormat> result = {
+static const std::vector<ElementsBlindAddressFormat>& GetBlindKeyPair() {
+  static const std::vector<ElementsBlindAddressFormat> kBlindKeyPair = {
       {AddressType::kP2pkhAddress, kPrefixP2pkh, kPrefixBlindP2pkh, false},
       {AddressType::kP2shAddress, kPrefixP2sh, kPrefixBlindP2sh, false},
       {AddressType::kWitnessUnknown, kPrefixBech32Hrp, kPrefixBlindBech32Hrp,
        true},
   };
-  return result;
+  return kBlindKeyPair;
 }
 
 // -----------------------------------------------------------------------------
@@ -63,6 +65,68 @@ Privkey ElementsConfidentialAddress::GetBlindingKey(
   return Privkey(data);
 }
 
+/// minimum script count per blinding key worker thread
+static constexpr size_t kBlindingKeyCountPerThread = 256;
+
+std::vector<Privkey> ElementsConfidentialAddress::GetBlindingKeys(
+    const Privkey& master_blinding_key,
+    const std::vector<Script>& locking_scripts, uint32_t thread_count) {
+  const HmacSha256Context context(master_blinding_key.GetData());
+  std::vector<Privkey> result(locking_scripts.size());
+  auto calculate = [&context, &locking_scripts, &result](
+                       size_t begin, size_t end) {
+    uint8_t hmac[kByteData256Length];
+    for (size_t index = begin; index < end; ++index) {
+      const std::vector<uint8_t> script =
+          locking_scripts[index].GetData().GetBytes();
+      context.Calculate(script.data(), script.size(), hmac);
+      const ByteData key(hmac, sizeof(hmac));
+      wally_bzero(hmac, sizeof(hmac));
+      result[index] = Privkey(key);
+    }
+  };
+
+  ParallelFor(
+      locking_scripts.size(), thread_count, kBlindingKeyCountPerThread,
+      calculate);
+  return result;
+}
+
+/// minimum address count per confidential address worker thread
+static constexpr size_t kConfidentialAddressCountPerThread = 128;
+
+std::vector<ElementsConfidentialAddress>
+ElementsConfidentialAddress::CreateBatch(
+    const std::vector<Address>& unblinded_addresses,
+    const std::vector<ConfidentialKey>& confidential_keys,
+    uint32_t thread_count) {
+  if (unblinded_addresses.size() != confidential_keys.size()) {
+    warn(
+        CFD_LOG_SOURCE,
+        "unmatch list size. address count={}, confidential key count={}",
+        unblinded_addresses.size(), confidential_keys.size());
+    throw CfdException(
+        kCfdIllegalArgumentError,
+        "Unmatch address and confidential key list size.");
+  }
+  std::vector<ElementsConfidentialAddress> result(unblinded_addresses.size());
+  auto create = [&unblinded_addresses, &confidential_keys, &result](
+                    size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      ElementsConfidentialAddress& address = result[index];
+      address.unblinded_address_ = unblinded_addresses[index];
+      address.confidential_key_ = confidential_keys[index];
+      address.CalculateAddress(
+          address.unblinded_address_, address.confidential_key_);
+    }
+  };
+
+  ParallelFor(
+      unblinded_addresses.size(), thread_count,
+      kConfidentialAddressCountPerThread, create);
+  return result;
+}
+
 ElementsConfidentialAddress::ElementsConfidentialAddress()
     : unblinded_address_(), confidential_key_(), address_() {
   // do nothing
@@ -110,11 +174,30 @@ ElementsConfidentialAddress& ElementsConfidentialAddress::operator=(
   return *this;
 }
 
+ElementsConfidentialAddress::ElementsConfidentialAddress(
+    ElementsConfidentialAddress&& object) noexcept
+    : unblinded_address_(std::move(object.unblinded_address_)),
+      confidential_key_(std::move(object.confidential_key_)),
+      address_(std::move(object.address_)) {
+  // do nothing
+}
+
+ElementsConfidentialAddress& ElementsConfidentialAddress::operator=(
+    ElementsConfidentialAddress&& object) & noexcept {
+  if (this != &object) {
+    unblinded_address_ = std::move(object.unblinded_address_);
+    confidential_key_ = std::move(object.confidential_key_);
+    address_ = std::move(object.address_);
+  }
+  return *this;
+}
+
 void ElementsConfidentialAddress::DecodeAddress(
     const std::string& confidential_address,
     const std::vector<AddressFormatData>& prefix_list) {
   std::vector<uint8_t> pubkey_data(Pubkey::kCompressedPubkeySize);
   std::string address;
+  std::string segwit_address;
   char* output = nullptr;
 
   if (confidential_address.empty()) {
@@ -132,29 +215,41 @@ void ElementsConfidentialAddress::DecodeAddress(
   std::string hrp;
   bool is_find_blinded_prefix = false;
   for (const auto& data : prefix_list) {
+    const NetworkParams& params = data.GetNetworkParams();
     for (const auto& format : GetBlindKeyPair()) {
       try {
         output = nullptr;
 
         // Get confidential_key
         if (format.is_segwit) {
-          hrp = data.GetString(format.blinded_prefix_key);
+          if (params.blech32_hrp.empty()) continue;
+          hrp = params.blech32_hrp;
           is_find_blinded_prefix = true;
-          ret = wally_confidential_addr_segwit_to_ec_public_key(
-              confidential_address.c_str(), hrp.c_str(), pubkey_data.data(),
-              pubkey_data.size());
-          if (ret != WALLY_OK) {
-            trace(CFD_LOG_SOURCE, "fail libwally. ret={} prefix={}", ret, hrp);
+          uint8_t witness_script[Bech32Util::kMaxWitnessScriptSize];
+          size_t written = 0;
+          if (Bech32Util::DecodeBlindedSegwitAddress(
+                  hrp, confidential_address, witness_script,
+                  sizeof(witness_script), &written, pubkey_data.data())) {
+            // unblinded address is made from the same witness program.
+            segwit_address = Bech32Util::EncodeSegwitAddress(
+                params.bech32_hrp,
+                ByteData(witness_script, static_cast<uint32_t>(written)));
+            ret = WALLY_OK;
+          } else {
+            ret = WALLY_EINVAL;
+            trace(CFD_LOG_SOURCE, "fail blech32 decode. prefix={}", hrp);
             trace(
                 CFD_LOG_SOURCE, "confidential_address={}",
                 confidential_address);
           }
         } else {
-          if ((format.blinded_prefix_key == kPrefixBlindP2sh) &&
-              (!data.IsFind(format.blinded_prefix_key))) {
-            continue;
+          if (format.address_type == AddressType::kP2shAddress) {
+            if (!params.has_blinded_p2sh_prefix) continue;
+            prefix = params.blinded_p2sh_prefix;
+          } else {
+            if (!params.has_blinded_p2pkh_prefix) continue;
+            prefix = params.blinded_p2pkh_prefix;
           }
-          prefix = data.GetValue(format.blinded_prefix_key);
           is_find_blinded_prefix = true;
           ret = wally_confidential_addr_to_ec_public_key(
               confidential_address.c_str(), prefix, pubkey_data.data(),
@@ -172,14 +267,7 @@ void ElementsConfidentialAddress::DecodeAddress(
         if (ret != WALLY_OK) {
           // do nothing
         } else if (format.is_segwit) {
-          ret = wally_confidential_addr_to_addr_segwit(
-              confidential_address.c_str(), hrp.c_str(),
-              data.GetString(format.prefix_key).c_str(), &output);
-          if (ret != WALLY_OK) {
-            trace(
-                CFD_LOG_SOURCE, "fail libwally. ret={} prefix={}", ret,
-                data.GetString(format.prefix_key).c_str());
-          }
+          address = segwit_address;
         } else {
           ret = wally_confidential_addr_to_addr(
               confidential_address.c_str(), prefix, &output);
@@ -191,7 +279,9 @@ void ElementsConfidentialAddress::DecodeAddress(
         }
 
         if (ret == WALLY_OK) {
-          address = WallyUtil::ConvertStringAndFree(output);
+          if (!format.is_segwit) {
+            address = WallyUtil::ConvertStringAndFree(output);
+          }
           unblinded_address_ = Address(address, data);
           confidential_key_ = ConfidentialKey(ByteData(pubkey_data));
           address_ = confidential_address;
@@ -260,6 +350,7 @@ void ElementsConfidentialAddress::CalculateAddress(
   uint32_t prefix;
   std::string hrp;
   AddressFormatData data = unblinded_address.GetAddressFormatData();
+  const NetworkParams& params = data.GetNetworkParams();
   std::string address = unblinded_address.GetAddress();
   AddressType type = unblinded_address.GetAddressType();
   if ((type == AddressType::kP2shP2wpkhAddress) ||
@@ -272,21 +363,33 @@ void ElementsConfidentialAddress::CalculateAddress(
 
       // Get confidential_key
       if (format.is_segwit) {
-        hrp = data.GetString(format.blinded_prefix_key);
-        ret = wally_confidential_addr_from_addr_segwit(
-            address.c_str(), data.GetString(format.prefix_key).c_str(),
-            hrp.c_str(), pubkey_data.data(), pubkey_data.size(), &output);
-        if (ret != WALLY_OK) {
-          trace(CFD_LOG_SOURCE, "fail libwally. ret={}", ret);
+        if (params.blech32_hrp.empty()) continue;
+        hrp = params.blech32_hrp;
+        uint8_t witness_script[Bech32Util::kMaxWitnessScriptSize];
+        size_t written = 0;
+        if (Bech32Util::DecodeSegwitAddress(
+                params.bech32_hrp, address, witness_script,
+                sizeof(witness_script), &written)) {
+          address_ = Bech32Util::EncodeBlindedSegwitAddress(
+              hrp, ByteData(witness_script, static_cast<uint32_t>(written)),
+              confidential_key);
+          confidential_key_ = confidential_key;
+          unblinded_address_ = unblinded_address;
+          return;
         }
+        trace(CFD_LOG_SOURCE, "fail bech32 decode. address={}", address);
+        continue;
       } else if (format.address_type != type) {
         continue;
       } else {
         if ((format.address_type == AddressType::kP2shAddress) &&
-            (!data.IsFind(format.blinded_prefix_key))) {
-          prefix = data.GetValue(kPrefixBlindP2pkh);
+            params.has_blinded_p2sh_prefix) {
+          prefix = params.blinded_p2sh_prefix;
+        } else if (params.has_blinded_p2pkh_prefix) {
+          // p2sh uses the p2pkh prefix if the p2sh prefix is not set.
+          prefix = params.blinded_p2pkh_prefix;
         } else {
-          prefix = data.GetValue(format.blinded_prefix_key);
+          continue;
         }
         ret = wally_confidential_addr_from_addr(
             address.c_str(), prefix, pubkey_data.data(), pubkey_data.size(),
@@ -12,6 +12,7 @@
 #include <limits>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_bytedata.h"
@@ -92,6 +93,37 @@ static uint32_t GetSerializedSize(uint32_t size) {
   }
 }
 
+/**
+ * @brief Write the confidential commitment of the wally tx.
+ * @param[in] buffer            commitment buffer
+ * @param[in] buffer_size       commitment size
+ * @param[in,out] serializer    serializer
+ */
+static void WriteConfidentialCommitment(
+    const uint8_t *buffer, size_t buffer_size, Serializer *serializer) {
+  if ((buffer == nullptr) || (buffer_size == 0)) {
+    serializer->AddDirectByte(0);  // version is 0
+  } else {
+    serializer->AddDirectBytes(buffer, static_cast<uint32_t>(buffer_size));
+  }
+}
+
+/**
+ * @brief Write the witness stack of the wally tx.
+ * @param[in] stack             witness stack
+ * @param[in,out] serializer    serializer
+ */
+static void WriteWitnessStack(
+    const struct wally_tx_witness_stack *stack, Serializer *serializer) {
+  size_t num_items = (stack != nullptr) ? stack->num_items : 0;
+  serializer->AddVariableInt(num_items);
+  for (size_t index = 0; index < num_items; ++index) {
+    const struct wally_tx_witness_item *item = stack->items + index;
+    serializer->AddVariableBuffer(
+        item->witness, static_cast<uint32_t>(item->witness_len));
+  }
+}
+
 /**
  * @brief rangeProofなどを生成する。
  * @param[in] value             amount
@@ -320,6 +352,20 @@ ConfidentialNonce &ConfidentialNonce::operator=(
   return *this;
 }
 
+ConfidentialNonce::ConfidentialNonce(ConfidentialNonce &&object) noexcept
+    : data_(std::move(object.data_)), version_(object.version_) {
+  // do nothing
+}
+
+ConfidentialNonce &ConfidentialNonce::operator=(
+    ConfidentialNonce &&object) noexcept {
+  if (this != &object) {
+    data_ = std::move(object.data_);
+    version_ = object.version_;
+  }
+  return *this;
+}
+
 void ConfidentialNonce::CheckVersion(uint8_t version) {
   if ((version != 0) && (version != 1) && (version != 2) && (version != 3)) {
     warn(CFD_LOG_SOURCE, "Nonce version Invalid. version={}.", version);
@@ -438,6 +484,20 @@ ConfidentialAssetId &ConfidentialAssetId::operator=(
   return *this;
 }
 
+ConfidentialAssetId::ConfidentialAssetId(ConfidentialAssetId &&object) noexcept
+    : data_(std::move(object.data_)), version_(object.version_) {
+  // do nothing
+}
+
+ConfidentialAssetId &ConfidentialAssetId::operator=(
+    ConfidentialAssetId &&object) noexcept {
+  if (this != &object) {
+    data_ = std::move(object.data_);
+    version_ = object.version_;
+  }
+  return *this;
+}
+
 void ConfidentialAssetId::CheckVersion(uint8_t version) {
   if ((version != 0) && (version != 1) && (version != 0x0a) &&
       (version != 0x0b)) {
@@ -597,6 +657,20 @@ ConfidentialValue &ConfidentialValue::operator=(
   return *this;
 }
 
+ConfidentialValue::ConfidentialValue(ConfidentialValue &&object) noexcept
+    : data_(std::move(object.data_)), version_(object.version_) {
+  // do nothing
+}
+
+ConfidentialValue &ConfidentialValue::operator=(
+    ConfidentialValue &&object) noexcept {
+  if (this != &object) {
+    data_ = std::move(object.data_);
+    version_ = object.version_;
+  }
+  return *this;
+}
+
 ConfidentialValue::ConfidentialValue(const Amount &amount)
     : ConfidentialValue(ConvertToConfidentialValue(amount)) {
   // do nothing
@@ -719,6 +793,11 @@ BlindFactor::BlindFactor(const ByteData256 &byte_data) : data_(byte_data) {
 
 BlindFactor::BlindFactor(const BlindFactor &object) { data_ = object.data_; }
 
+BlindFactor::BlindFactor(BlindFactor &&object) noexcept
+    : data_(std::move(object.data_)) {
+  // do nothing
+}
+
 BlindFactor &BlindFactor::operator=(const BlindFactor &object) {
   if (this != &object) {
     data_ = object.data_;
@@ -726,6 +805,13 @@ BlindFactor &BlindFactor::operator=(const BlindFactor &object) {
   return *this;
 }
 
+BlindFactor &BlindFactor::operator=(BlindFactor &&object) noexcept {
+  if (this != &object) {
+    data_ = std::move(object.data_);
+  }
+  return *this;
+}
+
 ByteData256 BlindFactor::GetData() const { return data_; }
 
 std::string BlindFactor::GetHex() const {
@@ -1321,6 +1407,14 @@ ConfidentialTransaction::ConfidentialTransaction(
   // copy constructor
 }
 
+ConfidentialTransaction::ConfidentialTransaction(
+    ConfidentialTransaction &&transaction) noexcept
+    : vin_(std::move(transaction.vin_)),
+      vout_(std::move(transaction.vout_)) {
+  wally_tx_pointer_ = transaction.wally_tx_pointer_;
+  transaction.wally_tx_pointer_ = NULL;
+}
+
 void ConfidentialTransaction::SetFromHex(const std::string &hex_string) {
   void *original_address = wally_tx_pointer_;
   std::vector<ConfidentialTxIn> vin_work;
@@ -1453,6 +1547,17 @@ ConfidentialTransaction &ConfidentialTransaction::operator=(
   return *this;
 }
 
+ConfidentialTransaction &ConfidentialTransaction::operator=(
+    ConfidentialTransaction &&transaction) & noexcept {
+  if (this != &transaction) {
+    // the old buffer is freed by the moved-from object
+    std::swap(wally_tx_pointer_, transaction.wally_tx_pointer_);
+    vin_.swap(transaction.vin_);
+    vout_.swap(transaction.vout_);
+  }
+  return *this;
+}
+
 uint32_t ConfidentialTransaction::GetTotalSize() const {
   static constexpr uint32_t kMinimumConfidentialTxSize = 11;
   uint32_t length = AbstractTransaction::GetTotalSize();
@@ -3186,23 +3291,21 @@ ByteData256 ConfidentialTransaction::GetElementsSchnorrSignatureHash(
   }
   ext_flag |= has_tap_script;
 
-  Serializer builder;
-  auto top = HashUtil::Sha256("TapSighash/elements");
-  builder.AddDirectBytes(top);
-  builder.AddDirectBytes(top);  // double data
+  Serializer builder =
+      Serializer::CreateTaggedSha256Sink("TapSighash/elements");
   builder.AddDirectBytes(genesis_block_hash.GetData());
   builder.AddDirectBytes(genesis_block_hash.GetData());  // double data
   builder.AddDirectByte(static_cast<uint8_t>(sighash_type.GetSigHashFlag()));
   builder.AddDirectNumber(static_cast<uint32_t>(GetVersion()));
   builder.AddDirectNumber(GetLockTime());
   if (!is_anyone_can_pay) {
-    Serializer outpoint_flags_buf;
-    Serializer prevouts_buf;
-    Serializer spent_buf;
-    Serializer scripts_buf;
-    Serializer sequences_buf;
-    Serializer issuance_buf;
-    Serializer issuance_rangeproof_buf;
+    Serializer outpoint_flags_buf = Serializer::CreateSha256Sink();
+    Serializer prevouts_buf = Serializer::CreateSha256Sink();
+    Serializer spent_buf = Serializer::CreateSha256Sink();
+    Serializer scripts_buf = Serializer::CreateSha256Sink();
+    Serializer sequences_buf = Serializer::CreateSha256Sink();
+    Serializer issuance_buf = Serializer::CreateSha256Sink();
+    Serializer issuance_rangeproof_buf = Serializer::CreateSha256Sink();
     for (size_t index = 0; index < vin_.size(); ++index) {
       outpoint_flags_buf.AddDirectByte(vin_[index].GetOutPointFlag());
       prevouts_buf.AddDirectBytes(vin_[index].GetTxid().GetData());
@@ -3229,17 +3332,17 @@ ByteData256 ConfidentialTransaction::GetElementsSchnorrSignatureHash(
       issuance_rangeproof_buf.AddVariableBuffer(
           vin_[index].GetInflationKeysRangeproof());
     }
-    builder.AddDirectBytes(HashUtil::Sha256(outpoint_flags_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(prevouts_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(spent_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(scripts_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(sequences_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(issuance_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(issuance_rangeproof_buf.Output()));
+    builder.AddDirectBytes(outpoint_flags_buf.OutputSha256());
+    builder.AddDirectBytes(prevouts_buf.OutputSha256());
+    builder.AddDirectBytes(spent_buf.OutputSha256());
+    builder.AddDirectBytes(scripts_buf.OutputSha256());
+    builder.AddDirectBytes(sequences_buf.OutputSha256());
+    builder.AddDirectBytes(issuance_buf.OutputSha256());
+    builder.AddDirectBytes(issuance_rangeproof_buf.OutputSha256());
   }
   if (has_sighash_all) {
-    Serializer outputs_buf;
-    Serializer rangeproof_buf;
+    Serializer outputs_buf = Serializer::CreateSha256Sink();
+    Serializer rangeproof_buf = Serializer::CreateSha256Sink();
     for (const auto &txout : vout_) {
       outputs_buf.AddDirectBytes(txout.GetAsset().GetData());
       outputs_buf.AddDirectBytes(
@@ -3249,8 +3352,8 @@ ByteData256 ConfidentialTransaction::GetElementsSchnorrSignatureHash(
       rangeproof_buf.AddVariableBuffer(txout.GetSurjectionProof());
       rangeproof_buf.AddVariableBuffer(txout.GetRangeProof());
     }
-    builder.AddDirectBytes(HashUtil::Sha256(outputs_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(rangeproof_buf.Output()));
+    builder.AddDirectBytes(outputs_buf.OutputSha256());
+    builder.AddDirectBytes(rangeproof_buf.OutputSha256());
   }
 
   uint8_t spend_type = (ext_flag << 1) + (annex.IsEmpty() ? 0 : 1);
@@ -3276,22 +3379,25 @@ ByteData256 ConfidentialTransaction::GetElementsSchnorrSignatureHash(
       builder.AddDirectBytes(
           vin_[txin_index].GetInflationKeys().GetSerializeData());
       // issuance rangeproof
-      Serializer rangeproof_buf;
+      Serializer rangeproof_buf = Serializer::CreateSha256Sink();
       rangeproof_buf.AddVariableBuffer(
           vin_[txin_index].GetIssuanceAmountRangeproof());
       rangeproof_buf.AddVariableBuffer(
           vin_[txin_index].GetInflationKeysRangeproof());
-      builder.AddDirectBytes(HashUtil::Sha256(rangeproof_buf.Output()));
+      builder.AddDirectBytes(rangeproof_buf.OutputSha256());
     }
   } else {
     builder.AddDirectNumber(txin_index);
   }
 
-  if (!annex.IsEmpty()) builder.AddDirectBytes(HashUtil::Sha256(annex));
+  if (!annex.IsEmpty()) {
+    // sha_annex: SHA256(compact_size(size of annex) || annex)
+    builder.AddDirectBytes(HashUtil::Sha256(annex.Serialize()));
+  }
 
   if (sighash_type.GetSigHashAlgorithm() == SigHashAlgorithm::kSigHashSingle) {
     CheckTxOutIndex(txin_index, __LINE__, __FUNCTION__);
-    Serializer outputs_buf;
+    Serializer outputs_buf = Serializer::CreateSha256Sink();
     outputs_buf.AddDirectBytes(vout_[txin_index].GetAsset().GetData());
     outputs_buf.AddDirectBytes(
         vout_[txin_index].GetConfidentialValue().GetSerializeData());
@@ -3299,12 +3405,12 @@ ByteData256 ConfidentialTransaction::GetElementsSchnorrSignatureHash(
         vout_[txin_index].GetNonce().GetSerializeData());
     outputs_buf.AddVariableBuffer(
         vout_[txin_index].GetLockingScript().GetData());
-    builder.AddDirectBytes(HashUtil::Sha256(outputs_buf.Output()));
+    builder.AddDirectBytes(outputs_buf.OutputSha256());
 
-    Serializer rangeproof_buf;
+    Serializer rangeproof_buf = Serializer::CreateSha256Sink();
     rangeproof_buf.AddVariableBuffer(vout_[txin_index].GetSurjectionProof());
     rangeproof_buf.AddVariableBuffer(vout_[txin_index].GetRangeProof());
-    builder.AddDirectBytes(HashUtil::Sha256(rangeproof_buf.Output()));
+    builder.AddDirectBytes(rangeproof_buf.OutputSha256());
   }
 
   if (has_tap_script == 1) {
@@ -3312,7 +3418,7 @@ ByteData256 ConfidentialTransaction::GetElementsSchnorrSignatureHash(
     builder.AddDirectByte(key_version);
     builder.AddDirectNumber(script_data->code_separator_position);
   }
-  return HashUtil::Sha256(builder.Output());
+  return builder.OutputSha256();
 }
 
 void ConfidentialTransaction::RandomSortTxOut() {
@@ -3952,6 +4058,83 @@ ByteData ConfidentialTransaction::GetByteData(bool has_witness) const {
   return ByteData(buffer);
 }
 
+void ConfidentialTransaction::WriteByteData(
+    bool has_witness, Serializer *serializer) const {
+  if (serializer == nullptr) {
+    warn(CFD_LOG_SOURCE, "serializer is null.");
+    throw CfdException(kCfdIllegalArgumentError, "serializer is null.");
+  }
+  const struct wally_tx *tx_pointer =
+      static_cast<const struct wally_tx *>(wally_tx_pointer_);
+  if ((tx_pointer->num_inputs == 0) || (tx_pointer->num_outputs == 0)) {
+    // libwally can not serialize it. use the own conversion.
+    AbstractTransaction::WriteByteData(has_witness, serializer);
+    return;
+  }
+  bool is_witness = has_witness && HasWitness();
+
+  serializer->AddDirectNumber(tx_pointer->version);
+  serializer->AddDirectByte((is_witness) ? 1 : 0);
+
+  serializer->AddVariableInt(tx_pointer->num_inputs);
+  for (size_t index = 0; index < tx_pointer->num_inputs; ++index) {
+    const struct wally_tx_input *input = tx_pointer->inputs + index;
+    bool is_issuance = (input->features & kTxInFeatureIssuance) != 0;
+    uint32_t vout = input->index;
+    if (is_issuance) vout |= static_cast<uint32_t>(WALLY_TX_ISSUANCE_FLAG);
+    if ((input->features & kTxInFeaturePegin) != 0) {
+      vout |= static_cast<uint32_t>(WALLY_TX_PEGIN_FLAG);
+    }
+    serializer->AddDirectBytes(input->txhash, sizeof(input->txhash));
+    serializer->AddDirectNumber(vout);
+    serializer->AddVariableBuffer(
+        input->script, static_cast<uint32_t>(input->script_len));
+    serializer->AddDirectNumber(input->sequence);
+    if (is_issuance) {
+      serializer->AddDirectBytes(
+          input->blinding_nonce, sizeof(input->blinding_nonce));
+      serializer->AddDirectBytes(input->entropy, sizeof(input->entropy));
+      WriteConfidentialCommitment(
+          input->issuance_amount, input->issuance_amount_len, serializer);
+      WriteConfidentialCommitment(
+          input->inflation_keys, input->inflation_keys_len, serializer);
+    }
+  }
+
+  serializer->AddVariableInt(tx_pointer->num_outputs);
+  for (size_t index = 0; index < tx_pointer->num_outputs; ++index) {
+    const struct wally_tx_output *output = tx_pointer->outputs + index;
+    WriteConfidentialCommitment(output->asset, output->asset_len, serializer);
+    WriteConfidentialCommitment(output->value, output->value_len, serializer);
+    WriteConfidentialCommitment(output->nonce, output->nonce_len, serializer);
+    serializer->AddVariableBuffer(
+        output->script, static_cast<uint32_t>(output->script_len));
+  }
+  serializer->AddDirectNumber(tx_pointer->locktime);
+
+  if (is_witness) {
+    for (size_t index = 0; index < tx_pointer->num_inputs; ++index) {
+      const struct wally_tx_input *input = tx_pointer->inputs + index;
+      serializer->AddVariableBuffer(
+          input->issuance_amount_rangeproof,
+          static_cast<uint32_t>(input->issuance_amount_rangeproof_len));
+      serializer->AddVariableBuffer(
+          input->inflation_keys_rangeproof,
+          static_cast<uint32_t>(input->inflation_keys_rangeproof_len));
+      WriteWitnessStack(input->witness, serializer);
+      WriteWitnessStack(input->pegin_witness, serializer);
+    }
+    for (size_t index = 0; index < tx_pointer->num_outputs; ++index) {
+      const struct wally_tx_output *output = tx_pointer->outputs + index;
+      serializer->AddVariableBuffer(
+          output->surjectionproof,
+          static_cast<uint32_t>(output->surjectionproof_len));
+      serializer->AddVariableBuffer(
+          output->rangeproof, static_cast<uint32_t>(output->rangeproof_len));
+    }
+  }
+}
+
 uint32_t ConfidentialTransaction::GetWallyFlag() const {
   return WALLY_TX_FLAG_USE_WITNESS | WALLY_TX_FLAG_USE_ELEMENTS;
 }
@@ -35,6 +35,10 @@ using logger::warn;
 static constexpr const char* kEmptySeedStr =
     "00000000000000000000000000000000000000000000000000000000000000000000000"
     "000000000000000000000000000000000000000000000000000000000";  // NOLINT
+/// BIP39 seed salt prefix
+static constexpr const char* kMnemonicSaltPrefix = "mnemonic";
+/// BIP39 seed PBKDF2 iteration count
+static constexpr uint32_t kMnemonicSeedIterations = 2048;
 
 /**
  * @brief Get an array from a string path.
@@ -289,11 +293,44 @@ bool HDWallet::CheckSupportedLanguages(const std::string& language) {
       std::find(slangs.cbegin(), slangs.cend(), language) != slangs.cend());
 }
 
+std::vector<ByteData> HDWallet::ConvertMnemonicToSeeds(
+    const std::vector<std::vector<std::string>>& mnemonics,
+    const std::vector<std::string>& passphrases, bool use_ideographic_space,
+    uint32_t thread_count) {
+  if (mnemonics.size() != passphrases.size()) {
+    warn(
+        CFD_LOG_SOURCE, "Unmatch mnemonic list size. mnemonic={}, pass={}",
+        mnemonics.size(), passphrases.size());
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError,
+        "Unmatch mnemonic and passphrase count.");
+  }
+  std::vector<ByteData> sentences;
+  std::vector<ByteData> salts;
+  sentences.reserve(mnemonics.size());
+  salts.reserve(mnemonics.size());
+  for (size_t index = 0; index < mnemonics.size(); ++index) {
+    std::string sentence =
+        WallyUtil::JoinMnemonic(mnemonics[index], use_ideographic_space);
+    std::string salt = kMnemonicSaltPrefix + passphrases[index];
+    sentences.emplace_back(
+        reinterpret_cast<const uint8_t*>(sentence.data()),
+        static_cast<uint32_t>(sentence.size()));
+    salts.emplace_back(
+        reinterpret_cast<const uint8_t*>(salt.data()),
+        static_cast<uint32_t>(salt.size()));
+  }
+  return CryptoUtil::Pbkdf2HmacSha512Batch(
+      sentences, salts, kMnemonicSeedIterations, kSeed512Size, thread_count);
+}
+
 ByteData HDWallet::ConvertMnemonicToSeed(
     const std::vector<std::string>& mnemonic, const std::string& passphrase,
     bool use_ideographic_space) {
-  return WallyUtil::ConvertMnemonicToSeed(
-      mnemonic, passphrase, use_ideographic_space);
+  std::vector<ByteData> seeds = ConvertMnemonicToSeeds(
+      std::vector<std::vector<std::string>>{mnemonic},
+      std::vector<std::string>{passphrase}, use_ideographic_space, 1);
+  return seeds[0];
 }
 
 // ----------------------------------------------------------------------------
@@ -8,7 +8,9 @@
 #include "cfdcore/cfdcore_key.h"
 
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_bytedata.h"
@@ -16,6 +18,7 @@
 #include "cfdcore/cfdcore_logger.h"
 #include "cfdcore/cfdcore_transaction_common.h"
 #include "cfdcore/cfdcore_util.h"
+#include "cfdcore_manager.h"     // NOLINT
 #include "cfdcore_wally_util.h"  // NOLINT
 #include "univalue.h"            // NOLINT
 
@@ -388,7 +391,14 @@ std::vector<KeyFormatData> KeyFormatData::ConvertListFromJson(
 // ----------------------------------------------------------------------------
 // Public Key
 // ----------------------------------------------------------------------------
-Pubkey::Pubkey() : data_() {}
+/**
+ * @brief parsed secp256k1 point.
+ */
+struct Pubkey::PointCache {
+  uint8_t point[kSecp256k1PubkeyPointSize];  //!< secp256k1_pubkey data
+};
+
+Pubkey::Pubkey() : data_(), point_cache_() {}
 
 bool Pubkey::IsValid(const ByteData &byte_data) {
   const std::vector<uint8_t> &buffer = byte_data.GetBytes();
@@ -415,6 +425,62 @@ Pubkey::Pubkey(const std::string &hex_string) : Pubkey(ByteData(hex_string)) {
   // do nothing
 }
 
+Pubkey::Pubkey(const Pubkey &object)
+    : data_(object.data_),
+      point_cache_(std::atomic_load(&object.point_cache_)) {
+  // do nothing
+}
+
+Pubkey::Pubkey(Pubkey &&object) noexcept
+    : data_(std::move(object.data_)),
+      point_cache_(std::move(object.point_cache_)) {
+  // do nothing
+}
+
+Pubkey &Pubkey::operator=(const Pubkey &object) {
+  if (this != &object) {
+    data_ = object.data_;
+    std::atomic_store(&point_cache_, std::atomic_load(&object.point_cache_));
+  }
+  return *this;
+}
+
+Pubkey &Pubkey::operator=(Pubkey &&object) noexcept {
+  if (this != &object) {
+    data_ = std::move(object.data_);
+    point_cache_ = std::move(object.point_cache_);
+  }
+  return *this;
+}
+
+Pubkey::Pubkey(
+    const ByteData &byte_data,
+    const std::shared_ptr<const PointCache> &point_cache)
+    : data_(byte_data), point_cache_(point_cache) {
+  // do nothing
+}
+
+std::shared_ptr<const Pubkey::PointCache> Pubkey::GetPointCache() const {
+  std::shared_ptr<const PointCache> cache = std::atomic_load(&point_cache_);
+  if (cache) return cache;
+
+  auto parsed = std::make_shared<PointCache>();
+  Secp256k1 secp256k1(GetSecp256k1Context());
+  if (!IsValid() ||
+      !secp256k1.ParsePubkeySecp256k1Ec(data_, parsed->point)) {
+    warn(CFD_LOG_SOURCE, "Secp256k1 pubkey parse Error.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Secp256k1 pubkey parse Error.");
+  }
+  // If another thread has already filled the cache, use that one.
+  cache = parsed;
+  std::shared_ptr<const PointCache> current;
+  if (!std::atomic_compare_exchange_strong(&point_cache_, &current, cache)) {
+    cache = current;
+  }
+  return cache;
+}
+
 std::string Pubkey::GetHex() const { return data_.GetHex(); }
 
 ByteData Pubkey::GetData() const { return data_.GetBytes(); }
@@ -458,34 +524,65 @@ ByteData Pubkey::GetFingerprint(uint32_t get_size) const {
 }
 
 Pubkey Pubkey::CombinePubkey(const std::vector<Pubkey> &pubkeys) {
-  std::vector<ByteData> data_list;
+  std::vector<std::shared_ptr<const PointCache>> cache_list;
+  std::vector<const uint8_t *> point_list;
+  cache_list.reserve(pubkeys.size());
+  point_list.reserve(pubkeys.size());
   for (const auto &pubkey : pubkeys) {
-    data_list.push_back(pubkey.GetData());
+    cache_list.push_back(pubkey.GetPointCache());
+    point_list.push_back(cache_list.back()->point);
   }
-  return Pubkey(WallyUtil::CombinePubkeySecp256k1Ec(data_list));
+
+  Secp256k1 secp256k1(GetSecp256k1Context());
+  auto combined = std::make_shared<PointCache>();
+  secp256k1.CombinePubkeyPointSecp256k1Ec(point_list, combined->point);
+  return Pubkey(
+      secp256k1.SerializePubkeySecp256k1Ec(combined->point, true), combined);
 }
 
 Pubkey Pubkey::CombinePubkey(const Pubkey &pubkey, const Pubkey &message_key) {
-  std::vector<ByteData> data_list;
-  data_list.push_back(pubkey.GetData());
-  data_list.push_back(message_key.GetData());
-
-  return Pubkey(WallyUtil::CombinePubkeySecp256k1Ec(data_list));
+  return CombinePubkey(std::vector<Pubkey>{pubkey, message_key});
 }
 
 Pubkey Pubkey::CreateTweakAdd(const ByteData256 &tweak) const {
-  ByteData tweak_added = WallyUtil::AddTweakPubkey(data_, tweak);
-  return Pubkey(tweak_added);
+  if (!IsCompress()) {
+    // uncompressed pubkey is not supported.
+    return Pubkey(WallyUtil::AddTweakPubkey(data_, tweak));
+  }
+  auto cache = GetPointCache();
+  Secp256k1 secp256k1(GetSecp256k1Context());
+  auto tweaked = std::make_shared<PointCache>();
+  secp256k1.AddTweakPubkeyPointSecp256k1Ec(
+      cache->point, ByteData(tweak.GetBytes()), tweaked->point);
+  return Pubkey(
+      secp256k1.SerializePubkeySecp256k1Ec(tweaked->point, true), tweaked);
 }
 
 Pubkey Pubkey::CreateTweakMul(const ByteData256 &tweak) const {
-  ByteData tweak_muled = WallyUtil::MulTweakPubkey(data_, tweak);
-  return Pubkey(tweak_muled);
+  if (!IsCompress()) {
+    // uncompressed pubkey is not supported.
+    return Pubkey(WallyUtil::MulTweakPubkey(data_, tweak));
+  }
+  auto cache = GetPointCache();
+  Secp256k1 secp256k1(GetSecp256k1Context());
+  auto tweaked = std::make_shared<PointCache>();
+  secp256k1.MulTweakPubkeyPointSecp256k1Ec(
+      cache->point, ByteData(tweak.GetBytes()), tweaked->point);
+  return Pubkey(
+      secp256k1.SerializePubkeySecp256k1Ec(tweaked->point, true), tweaked);
 }
 
 Pubkey Pubkey::CreateNegate() const {
-  ByteData negated = WallyUtil::NegatePubkey(data_);
-  return Pubkey(negated);
+  if (!IsCompress()) {
+    // uncompressed pubkey is not supported.
+    return Pubkey(WallyUtil::NegatePubkey(data_));
+  }
+  auto cache = GetPointCache();
+  Secp256k1 secp256k1(GetSecp256k1Context());
+  auto negated = std::make_shared<PointCache>();
+  secp256k1.NegatePubkeyPointSecp256k1Ec(cache->point, negated->point);
+  return Pubkey(
+      secp256k1.SerializePubkeySecp256k1Ec(negated->point, true), negated);
 }
 
 Pubkey Pubkey::Compress() const {
@@ -493,8 +590,11 @@ Pubkey Pubkey::Compress() const {
     return *this;
   }
 
-  ByteData compress_data = WallyUtil::CompressPubkey(data_);
-  return Pubkey(compress_data);
+  // same point. share the parsed cache.
+  auto cache = GetPointCache();
+  Secp256k1 secp256k1(GetSecp256k1Context());
+  return Pubkey(
+      secp256k1.SerializePubkeySecp256k1Ec(cache->point, true), cache);
 }
 
 Pubkey Pubkey::Uncompress() const {
@@ -504,17 +604,10 @@ Pubkey Pubkey::Uncompress() const {
 
   // The conversion from uncompress to compress is irreversible.
   // (if convert compress to uncompress, prefix is '04'. Not '06' or '07'.)
-  std::vector<uint8_t> decompress_data(EC_PUBLIC_KEY_UNCOMPRESSED_LEN);
-  std::vector<uint8_t> data = data_.GetBytes();
-  int ret = wally_ec_public_key_decompress(
-      data.data(), data.size(), decompress_data.data(),
-      decompress_data.size());
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_ec_public_key_decompress error. ret={}", ret);
-    throw CfdException(
-        CfdError::kCfdIllegalArgumentError, "Failed to uncompress pubkey.");
-  }
-  return Pubkey(decompress_data);
+  auto cache = GetPointCache();
+  Secp256k1 secp256k1(GetSecp256k1Context());
+  return Pubkey(
+      secp256k1.SerializePubkeySecp256k1Ec(cache->point, false), cache);
 }
 
 bool Pubkey::IsLarge(const Pubkey &source, const Pubkey &destination) {
@@ -523,7 +616,15 @@ bool Pubkey::IsLarge(const Pubkey &source, const Pubkey &destination) {
 
 bool Pubkey::VerifyEcSignature(
     const ByteData256 &signature_hash, const ByteData &signature) const {
-  return SignatureUtil::VerifyEcSignature(signature_hash, *this, signature);
+  std::shared_ptr<const PointCache> cache;
+  try {
+    cache = GetPointCache();
+  } catch (const CfdException &) {
+    return false;
+  }
+  Secp256k1 secp256k1(GetSecp256k1Context());
+  return secp256k1.VerifyEcdsaSecp256k1Ec(
+      cache->point, ByteData(signature_hash.GetBytes()), signature);
 }
 
 bool Pubkey::VerifyBitcoinMessage(
@@ -690,35 +791,36 @@ std::string Privkey::GetWif() const {
 
 Privkey Privkey::FromWif(
     const std::string &wif, NetType net_type, bool is_compressed) {
+  // prefix(1) + privkey(32) + compressed flag(1, option)
+  uint8_t buf[kPrivkeySize + 2] = {};
+  size_t written = 0;
+  bool is_decoded =
+      CryptoUtil::DecodeBase58Check(wif, buf, sizeof(buf), &written);
   std::vector<uint8_t> privkey(kPrivkeySize);
+  if (is_decoded && (written > kPrivkeySize)) {
+    memcpy(privkey.data(), &buf[1], privkey.size());
+  }
+  uint32_t prefix = buf[0];
+  bool is_wif_compressed =
+      (written == sizeof(buf)) && (buf[kPrivkeySize + 1] == 0x01);
+  bool is_wif_size = is_wif_compressed || (written == (kPrivkeySize + 1));
+  wally_bzero(buf, sizeof(buf));
+
   NetType temp_net_type = net_type;
   bool is_temp_compressed = is_compressed;
   if (net_type == NetType::kCustomChain) {
     // auto analyze
-    size_t written = 0;
-    size_t uncompressed = 0;
-    std::vector<uint8_t> buf(2 + EC_PRIVATE_KEY_LEN + BASE58_CHECKSUM_LEN);
-    int ret = wally_base58_to_bytes(
-        wif.data(), BASE58_FLAG_CHECKSUM, buf.data(), buf.size(), &written);
-    if (ret != WALLY_OK) {
-      warn(
-          CFD_LOG_SOURCE, "wally_base58_to_bytes error. ret={} wif={}.", ret,
-          wif);
+    if (!is_decoded) {
+      warn(CFD_LOG_SOURCE, "DecodeBase58Check error. wif={}.", wif);
       throw CfdException(
           CfdError::kCfdIllegalArgumentError, "Error decode base58 WIF.");
     }
-    ret = wally_wif_is_uncompressed(wif.data(), &uncompressed);
-    if (ret != WALLY_OK) {
-      warn(
-          CFD_LOG_SOURCE, "wally_wif_is_uncompressed error. ret={} wif={}.",
-          ret, wif);
+    if (!is_wif_size) {
+      warn(CFD_LOG_SOURCE, "Invalid WIF size. size={} wif={}.", written, wif);
       throw CfdException(
           CfdError::kCfdIllegalArgumentError, "Error WIF is uncompressed.");
     }
 
-    uint32_t prefix = buf[0];
-    memcpy(privkey.data(), &buf[1], privkey.size());
-
     bool has_prefix = false;
     for (const auto &format : GetKeyFormatList()) {
       if (format.GetWifPrefix() == prefix) {
@@ -732,25 +834,18 @@ Privkey Privkey::FromWif(
           CfdError::kCfdIllegalArgumentError,
           "Failed to parse WIF. unsupported WIF prefix.");
     }
-    is_temp_compressed = (uncompressed == 0) ? true : false;
+    is_temp_compressed = is_wif_compressed;
   } else {
     auto format_data = GetKeyFormatData(net_type);
-    uint32_t prefix = format_data.GetWifPrefix();
-    uint32_t flags =
-        (is_compressed ? WALLY_WIF_FLAG_COMPRESSED
-                       : WALLY_WIF_FLAG_UNCOMPRESSED);
-
-    int ret = wally_wif_to_bytes(
-        wif.data(), prefix, flags, privkey.data(), kPrivkeySize);
-    if (ret != WALLY_OK) {
+    if ((!is_decoded) || (!is_wif_size) ||
+        (prefix != format_data.GetWifPrefix()) ||
+        (is_wif_compressed != is_compressed)) {
       warn(
-          CFD_LOG_SOURCE, "wally_wif_to_bytes error. ret={} wif={}.", ret,
-          wif);
+          CFD_LOG_SOURCE, "Invalid WIF. decoded={} size={} prefix={} wif={}.",
+          is_decoded, written, prefix, wif);
       throw CfdException(
           CfdError::kCfdIllegalArgumentError, "Error WIF to Private key.");
     }
-    temp_net_type = net_type;
-    is_temp_compressed = is_compressed;
   }
 
   if (!IsValid(privkey)) {
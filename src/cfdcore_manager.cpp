@@ -6,6 +6,7 @@
  */
 #include "cfdcore_manager.h"  // NOLINT
 
+#include <thread>  // NOLINT
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -36,6 +37,14 @@ uint64_t GetSupportedFunction() {
   return core_instance.GetSupportedFunction();
 }
 
+struct secp256k1_context_struct* GetSecp256k1Context() {
+  void* context = core_instance.GetSecp256k1Context();
+  if (context != nullptr) {
+    return static_cast<struct secp256k1_context_struct*>(context);
+  }
+  return wally_get_secp_context();
+}
+
 // -----------------------------------------------------------------------------
 // Management
 // -----------------------------------------------------------------------------
@@ -67,6 +76,9 @@ void CfdCoreManager::Initialize(CfdCoreHandle* handle_address) {
         throw CfdException(
             kCfdIllegalStateError, "Failed to secp_randomize error.");
       }
+      // Each thread signs with its own clone of the randomized context.
+      secp256k1_context_pool_.Initialize(
+          wally_get_secp_context(), std::thread::hardware_concurrency());
 #if 0
       int wally_ret = wally_init(0);
       if (wally_ret != WALLY_OK) {
@@ -118,6 +130,7 @@ void CfdCoreManager::Finalize(
     if (handle_list_.empty()) {
       // Perform end processing
       FinalizeLogger(is_finish_process);
+      secp256k1_context_pool_.Finalize();
       wally_cleanup(0);
 #if 0
       hid_exit();
@@ -127,6 +140,10 @@ void CfdCoreManager::Finalize(
   }
 }
 
+void* CfdCoreManager::GetSecp256k1Context() {
+  return secp256k1_context_pool_.GetContext();
+}
+
 uint64_t CfdCoreManager::GetSupportedFunction() {
   uint64_t support_function = 0;
 
@@ -142,7 +159,11 @@ uint64_t CfdCoreManager::GetSupportedFunction() {
 }
 
 CfdCoreManager::CfdCoreManager()
-    : handle_list_(), initialized_(false), finalized_(false), mutex_() {
+    : handle_list_(),
+      initialized_(false),
+      finalized_(false),
+      mutex_(),
+      secp256k1_context_pool_() {
   // do nothing
 }
 
@@ -13,10 +13,21 @@
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
+#include "cfdcore_secp256k1.h"  // NOLINT
+
+struct secp256k1_context_struct;
 
 namespace cfd {
 namespace core {
 
+/**
+ * @brief Get the secp256k1 context for the current thread.
+ * @details Before the initialization of cfdcore, returns the global context
+ *     of libwally.
+ * @return secp256k1 context
+ */
+struct secp256k1_context_struct* GetSecp256k1Context();
+
 /**
  * @brief cfdcore manaement class
  */
@@ -47,12 +58,18 @@ class CfdCoreManager {
    * @return LibraryFunction bitflag.
    */
   uint64_t GetSupportedFunction();
+  /**
+   * @brief get the secp256k1 context for the current thread.
+   * @return context. (nullptr if not initialized)
+   */
+  void* GetSecp256k1Context();
 
  protected:
   std::vector<int*> handle_list_;  ///< Handle list
   bool initialized_;               ///< Initalized flag
   bool finalized_;                 ///< Finalized flag
   std::mutex mutex_;               ///< Exclusive control object
+  Secp256k1ContextPool secp256k1_context_pool_;  ///< secp256k1 context pool
 };
 
 }  // namespace core
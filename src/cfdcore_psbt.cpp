@@ -7,8 +7,10 @@
 #include "cfdcore/cfdcore_psbt.h"
 
 #include <algorithm>
+#include <istream>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_address.h"
@@ -1018,14 +1020,14 @@ static uint8_t SetPsbtInput(
       throw CfdException(
           kCfdIllegalArgumentError, "psbt invalid key format error.");
     }
-    // TODO(k-matsuzawa) need endian support.
-    Deserializer parser(value);
+    Deserializer parser(value.data(), value.size());
     uint64_t amount = parser.ReadUint64();
-    auto script = parser.ReadVariableBuffer();
+    ByteSpan script = parser.ReadVariableSpan();
     struct wally_tx_output txout;
     memset(&txout, 0, sizeof(txout));
     txout.satoshi = static_cast<uint64_t>(amount);
-    txout.script = script.data();
+    // the script is only read (copied) by libwally.
+    txout.script = const_cast<uint8_t *>(script.data());
     txout.script_len = script.size();
     ret = wally_psbt_input_set_witness_utxo(input, &txout);
     if (ret != WALLY_OK) {
@@ -1143,11 +1145,11 @@ static uint8_t SetPsbtInput(
       throw CfdException(
           kCfdIllegalArgumentError, "psbt invalid key format error.");
     }
-    Deserializer parser(value);
+    Deserializer parser(value.data(), value.size());
     uint64_t num = parser.ReadVariableInt();
-    std::vector<std::vector<uint8_t>> stack_list(num);
+    std::vector<ByteSpan> stack_list;
     for (uint64_t idx = 0; idx < num; ++idx) {
-      stack_list[idx] = parser.ReadVariableBuffer();
+      stack_list.push_back(parser.ReadVariableSpan());
     }
 
     struct wally_tx_witness_stack *stack = nullptr;
@@ -1589,14 +1591,13 @@ static void ParsePsbtOutput(
 
 /**
  * @brief parse psbt data.
- * @param[in] data     psbt binary data
+ * @param[in] bytes    psbt binary data
  * @return psbt object
  */
-struct wally_psbt *ParsePsbtData(const ByteData &data) {
+struct wally_psbt *ParsePsbtData(const std::vector<uint8_t> &bytes) {
   static const uint8_t kPsbtMagic[] = {'p', 's', 'b', 't', 0xff};
 
   struct wally_psbt *psbt = nullptr;
-  std::vector<uint8_t> bytes = data.GetBytes();
   int ret = wally_psbt_from_bytes(bytes.data(), bytes.size(), &psbt);
   if (ret == WALLY_OK) {
     if ((psbt->num_inputs != 0) || (psbt->num_outputs != 0)) {
@@ -1617,7 +1618,7 @@ struct wally_psbt *ParsePsbtData(const ByteData &data) {
     throw CfdException(kCfdInternalError, "psbt from bytes error.");
   }
 
-  Deserializer parser(data);
+  Deserializer parser(bytes.data(), bytes.size());
   uint8_t magic[sizeof(kPsbtMagic)];
   memset(magic, 0, sizeof(magic));
   if (bytes.size() > 5) parser.ReadArray(magic, sizeof(magic));
@@ -1793,13 +1794,14 @@ Psbt::Psbt(uint32_t psbt_version, uint32_t version, uint32_t lock_time) {
   base_tx_ = RebuildTransaction(wally_psbt_pointer_);
 }
 
-Psbt::Psbt(const std::string &base64)
-    : Psbt(CryptoUtil::DecodeBase64(base64)) {
-  // do nothing
-}
-
-Psbt::Psbt(const ByteData &byte_data) {
-  struct wally_psbt *psbt_pointer = ParsePsbtData(byte_data);
+/**
+ * @brief parse bitcoin psbt data.
+ * @param[in] bytes    psbt binary data
+ * @return psbt object
+ */
+static struct wally_psbt *ParseBitcoinPsbtData(
+    const std::vector<uint8_t> &bytes) {
+  struct wally_psbt *psbt_pointer = ParsePsbtData(bytes);
   size_t is_elements = 0;
   int ret = wally_psbt_is_elements(psbt_pointer, &is_elements);
   if (ret != WALLY_OK) {
@@ -1812,7 +1814,63 @@ Psbt::Psbt(const ByteData &byte_data) {
     warn(CFD_LOG_SOURCE, "psbt elements format.");
     throw CfdException(kCfdInternalError, "psbt bitcoin tx format error.");
   }
-  wally_psbt_pointer_ = psbt_pointer;
+  return psbt_pointer;
+}
+
+/// Base64 stream read size
+static constexpr size_t kPsbtBase64ReadSize = 64 * 1024;
+
+/**
+ * @brief Throw the psbt base64 decode error.
+ * @param[in] except    decoder exception
+ */
+static void ThrowPsbtBase64Error(const CfdException &except) {
+  warn(CFD_LOG_SOURCE, "psbt base64 decode error. {}", except.what());
+  throw CfdException(kCfdIllegalArgumentError, "psbt base64 decode error.");
+}
+
+Psbt::Psbt(const std::string &base64) {
+  std::vector<uint8_t> bytes;
+  try {
+    Base64Decoder decoder;
+    decoder.Update(base64, &bytes);
+    decoder.Final();
+  } catch (const CfdException &except) {
+    ThrowPsbtBase64Error(except);
+  }
+  wally_psbt_pointer_ = ParseBitcoinPsbtData(bytes);
+  base_tx_ = RebuildTransaction(wally_psbt_pointer_);
+}
+
+Psbt::Psbt(std::istream &base64_stream) {
+  std::vector<uint8_t> bytes;
+  std::streampos begin = base64_stream.tellg();
+  if ((begin != std::streampos(-1)) &&
+      base64_stream.seekg(0, std::ios::end)) {
+    std::streamoff size = base64_stream.tellg() - begin;
+    base64_stream.seekg(begin);
+    if (size > 0) bytes.reserve(static_cast<size_t>(size) / 4 * 3 + 4);
+  }
+  base64_stream.clear();
+
+  try {
+    Base64Decoder decoder;
+    std::vector<char> buffer(kPsbtBase64ReadSize);
+    while (base64_stream.read(buffer.data(), buffer.size()) ||
+           (base64_stream.gcount() > 0)) {
+      decoder.Update(
+          buffer.data(), static_cast<size_t>(base64_stream.gcount()), &bytes);
+    }
+    decoder.Final();
+  } catch (const CfdException &except) {
+    ThrowPsbtBase64Error(except);
+  }
+  wally_psbt_pointer_ = ParseBitcoinPsbtData(bytes);
+  base_tx_ = RebuildTransaction(wally_psbt_pointer_);
+}
+
+Psbt::Psbt(const ByteData &byte_data) {
+  wally_psbt_pointer_ = ParseBitcoinPsbtData(byte_data.GetBytes());
   base_tx_ = RebuildTransaction(wally_psbt_pointer_);
 }
 
@@ -1919,6 +1977,21 @@ Psbt &Psbt::operator=(const Psbt &psbt) & {
   return *this;
 }
 
+Psbt::Psbt(Psbt &&psbt) noexcept
+    : wally_psbt_pointer_(psbt.wally_psbt_pointer_),
+      base_tx_(std::move(psbt.base_tx_)) {
+  psbt.wally_psbt_pointer_ = nullptr;
+}
+
+Psbt &Psbt::operator=(Psbt &&psbt) & noexcept {
+  if (this != &psbt) {
+    // the old psbt is freed by the moved-from object
+    std::swap(wally_psbt_pointer_, psbt.wally_psbt_pointer_);
+    base_tx_ = std::move(psbt.base_tx_);
+  }
+  return *this;
+}
+
 void Psbt::FreeWallyPsbtAddress(const void *wally_psbt_pointer) {
   if (wally_psbt_pointer != nullptr) {
     struct wally_psbt *psbt_pointer = nullptr;
@@ -0,0 +1,109 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_random.cpp
+ *
+ * @brief System random source.
+ */
+#include "cfdcore_random.h"  // NOLINT
+
+#include <algorithm>
+#include <cerrno>
+
+#include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_logger.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#define RtlGenRandom SystemFunction036
+extern "C" BOOLEAN NTAPI RtlGenRandom(PVOID buffer, ULONG buffer_length);
+#if defined(_MSC_VER)
+#pragma comment(lib, "advapi32.lib")
+#endif
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#elif defined(__APPLE__)
+#include <sys/random.h>
+#endif
+#endif
+
+namespace cfd {
+namespace core {
+
+using logger::warn;
+
+#if !defined(_WIN32)
+/**
+ * @brief Read random bytes from /dev/urandom.
+ * @param[out] output   output buffer
+ * @param[in] size      output size
+ * @return read size
+ */
+static size_t ReadUrandom(uint8_t *output, size_t size) {
+  int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return 0;
+  size_t offset = 0;
+  while (offset < size) {
+    ssize_t ret = read(fd, output + offset, size - offset);
+    if (ret > 0) {
+      offset += static_cast<size_t>(ret);
+    } else if ((ret < 0) && (errno == EINTR)) {
+      continue;
+    } else {
+      break;
+    }
+  }
+  close(fd);
+  return offset;
+}
+#endif
+
+void GetSystemRandomBytes(uint8_t *output, size_t size) {
+  size_t offset = 0;
+#if defined(__linux__) && defined(SYS_getrandom)
+  while (offset < size) {
+    auto ret = syscall(SYS_getrandom, output + offset, size - offset, 0);
+    if (ret > 0) {
+      offset += static_cast<size_t>(ret);
+    } else if ((ret < 0) && (errno == EINTR)) {
+      continue;
+    } else {
+      break;  // old kernel. (fall back to /dev/urandom)
+    }
+  }
+#elif defined(__APPLE__)
+  while (offset < size) {
+    size_t chunk_size = std::min<size_t>(size - offset, 256);
+    if (getentropy(output + offset, chunk_size) != 0) break;
+    offset += chunk_size;
+  }
+#elif defined(_WIN32)
+  while (offset < size) {
+    ULONG chunk_size =
+        static_cast<ULONG>(std::min<size_t>(size - offset, 0x10000));
+    if (!RtlGenRandom(output + offset, chunk_size)) break;
+    offset += chunk_size;
+  }
+#endif
+#if !defined(_WIN32)
+  if (offset < size) {
+    offset += ReadUrandom(output + offset, size - offset);
+  }
+#endif
+  if (offset < size) {
+    warn(CFD_LOG_SOURCE, "system random source is unavailable.");
+    throw CfdException(
+        kCfdIllegalStateError, "Failed to get the system random.");
+  }
+}
+
+}  // namespace core
+}  // namespace cfd
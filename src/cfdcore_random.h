@@ -0,0 +1,45 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_random.h
+ * @brief System random source.
+ *
+ */
+#ifndef CFD_CORE_SRC_CFDCORE_RANDOM_H_
+#define CFD_CORE_SRC_CFDCORE_RANDOM_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cfd {
+namespace core {
+
+/**
+ * @brief Get random bytes from the system.
+ * @details It reads the OS random source directly (getrandom, getentropy,
+ *     /dev/urandom or RtlGenRandom), and is not affected by
+ *     SetRandomDeterministicSeed.
+ * @param[out] output   output buffer
+ * @param[in] size      output size
+ * @throws CfdException   If the system random source is unavailable.
+ */
+void GetSystemRandomBytes(uint8_t *output, size_t size);
+
+/**
+ * @brief Set a deterministic seed to the random generator of this thread.
+ * @details This is for testing. RandomNumberUtil of this thread becomes
+ *     reproducible until ResetRandomSeed is called. Other threads are not
+ *     affected.
+ * @param[in] seed    seed (32 bytes)
+ */
+void SetRandomDeterministicSeed(const uint8_t *seed);
+
+/**
+ * @brief Reseed the random generator of this thread from the system.
+ * @details The deterministic seed mode of this thread is cleared.
+ */
+void ResetRandomSeed();
+
+}  // namespace core
+}  // namespace cfd
+
+#endif  // CFD_CORE_SRC_CFDCORE_RANDOM_H_
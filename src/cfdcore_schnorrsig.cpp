@@ -4,10 +4,14 @@
 
 #include <cstring>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_exception.h"
 #include "cfdcore/cfdcore_util.h"
+#include "cfdcore_manager.h"       // NOLINT
+#include "cfdcore_sha2.h"          // NOLINT
+#include "cfdcore_thread_util.h"   // NOLINT
 #include "secp256k1.h"             // NOLINT
 #include "secp256k1_schnorrsig.h"  // NOLINT
 #include "secp256k1_util.h"        // NOLINT
@@ -22,6 +26,15 @@ using cfd::core::CfdError;
 using cfd::core::CfdException;
 using cfd::core::HashUtil;
 
+//! minimum signature count per worker thread of VerifyBatch
+static constexpr size_t kVerifyBatchMinUnit = 16;
+//! minimum point count per worker thread of ComputeSigPointList
+static constexpr size_t kSigPointMinUnit = 16;
+//! minimum outcome count per worker thread of CombineSigPointList
+static constexpr size_t kCombineSigPointMinUnit = 256;
+//! BIP340 challenge tag
+static constexpr const char *const kBip340ChallengeTag = "BIP0340/challenge";
+
 // ----------------------------------------------------------------------------
 // SchnorrSignature
 // ----------------------------------------------------------------------------
@@ -54,6 +67,11 @@ SchnorrSignature::SchnorrSignature(const SchnorrSignature &object) {
   sighash_type_ = object.sighash_type_;
 }
 
+SchnorrSignature::SchnorrSignature(SchnorrSignature &&object) noexcept
+    : data_(std::move(object.data_)), sighash_type_(object.sighash_type_) {
+  // do nothing
+}
+
 SchnorrSignature &SchnorrSignature::operator=(const SchnorrSignature &object) {
   if (this != &object) {
     data_ = object.data_;
@@ -62,6 +80,15 @@ SchnorrSignature &SchnorrSignature::operator=(const SchnorrSignature &object) {
   return *this;
 }
 
+SchnorrSignature &SchnorrSignature::operator=(
+    SchnorrSignature &&object) noexcept {
+  if (this != &object) {
+    data_ = std::move(object.data_);
+    sighash_type_ = object.sighash_type_;
+  }
+  return *this;
+}
+
 ByteData SchnorrSignature::GetData(bool append_sighash_type) const {
   if ((!append_sighash_type) || (sighash_type_.GetSigHashFlag() == 0) ||
       (data_.GetDataSize() != SchnorrSignature::kSchnorrSignatureSize)) {
@@ -147,7 +174,7 @@ SchnorrPubkey::SchnorrPubkey(const std::string &data)
 
 SchnorrPubkey SchnorrPubkey::FromPrivkey(
     const Privkey &privkey, bool *parity) {
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   secp256k1_keypair keypair;
   auto ret = secp256k1_keypair_create(
       ctx, &keypair, privkey.GetData().GetBytes().data());
@@ -178,7 +205,7 @@ SchnorrPubkey SchnorrPubkey::CreateTweakAddFromPrivkey(
     const Privkey &privkey, const ByteData256 &tweak, Privkey *tweaked_privkey,
     bool *parity) {
   std::vector<uint8_t> tweak_bytes = tweak.GetBytes();
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
 
   secp256k1_keypair keypair;
   auto ret = secp256k1_keypair_create(
@@ -323,7 +350,7 @@ const secp256k1_nonce_function_hardened ConstantNonce = ConstantNonceFunction;
 SchnorrSignature SignCommon(
     const ByteData256 &msg, const Privkey &sk,
     const secp256k1_nonce_function_hardened *nonce_fn, const ByteData ndata) {
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   secp256k1_keypair keypair;
   auto ret =
       secp256k1_keypair_create(ctx, &keypair, sk.GetData().GetBytes().data());
@@ -362,6 +389,102 @@ SchnorrSignature SignCommon(
   return SchnorrSignature(raw_sig);
 }
 
+/**
+ * @brief SHA-256 state after the BIP340 challenge tag prefix.
+ */
+struct Bip340ChallengeMidstate {
+  uint32_t state[kSha256StateSize];  //!< hash state
+};
+
+/**
+ * @brief Get the SHA-256 state after the BIP340 challenge tag prefix.
+ * @return hash state
+ */
+static const Bip340ChallengeMidstate &GetBip340ChallengeMidstate() {
+  static const Bip340ChallengeMidstate midstate = []() {
+    Bip340ChallengeMidstate result;
+    auto tag = HashUtil::Sha256(std::string(kBip340ChallengeTag)).GetBytes();
+    uint8_t prefix[kSha256BlockSize];
+    memcpy(prefix, tag.data(), tag.size());
+    memcpy(prefix + tag.size(), tag.data(), tag.size());
+    Sha256Initialize(result.state);
+    Sha256Transform(result.state, prefix, 1);
+    return result;
+  }();
+  return midstate;
+}
+
+/**
+ * @brief Compute the BIP340 challenge: hash(R || X || m).
+ * @param[in] nonce       nonce x-only pubkey (32 bytes)
+ * @param[in] pubkey      x-only pubkey (32 bytes)
+ * @param[in] msg         message (32 bytes)
+ * @param[out] challenge  challenge (32 bytes)
+ */
+static void ComputeBip340Challenge(
+    const uint8_t *nonce, const uint8_t *pubkey, const uint8_t *msg,
+    uint8_t *challenge) {
+  uint8_t data[kByteData256Length * 3];
+  memcpy(data, nonce, kByteData256Length);
+  memcpy(data + kByteData256Length, pubkey, kByteData256Length);
+  memcpy(data + kByteData256Length * 2, msg, kByteData256Length);
+  Sha256Finalize(
+      GetBip340ChallengeMidstate().state, data, sizeof(data),
+      kSha256BlockSize + sizeof(data), challenge);
+}
+
+/**
+ * @brief Parse the x-only pubkey as the point with even y.
+ * @param[in] ctx       secp256k1 context
+ * @param[in] pubkey    x-only pubkey (32 bytes)
+ * @return point
+ */
+static secp256k1_pubkey ParseEvenYPoint(
+    const secp256k1_context *ctx, const uint8_t *pubkey) {
+  uint8_t compressed[Pubkey::kCompressedPubkeySize];
+  compressed[0] = 0x02;
+  memcpy(compressed + 1, pubkey, kByteData256Length);
+  secp256k1_pubkey result;
+  if (secp256k1_ec_pubkey_parse(ctx, &result, compressed, sizeof(compressed)) !=
+      1) {
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Secp256k1 pubkey parse error");
+  }
+  return result;
+}
+
+/**
+ * @brief Serialize the point to the compressed pubkey.
+ * @param[in] ctx       secp256k1 context
+ * @param[in] point     point
+ * @return pubkey
+ */
+static Pubkey SerializePoint(
+    const secp256k1_context *ctx, const secp256k1_pubkey &point) {
+  std::vector<uint8_t> bytes(Pubkey::kCompressedPubkeySize);
+  size_t size = bytes.size();
+  if (secp256k1_ec_pubkey_serialize(
+          ctx, bytes.data(), &size, &point, SECP256K1_EC_COMPRESSED) != 1) {
+    throw CfdException(
+        CfdError::kCfdInternalError, "Secp256k1 pubkey serialize error");
+  }
+  return Pubkey(ByteData(bytes));
+}
+
+/**
+ * @brief Get the x-only pubkey bytes.
+ * @param[in] pubkey    x-only pubkey
+ * @return pubkey bytes (32 bytes)
+ */
+static std::vector<uint8_t> GetXOnlyPubkeyBytes(const SchnorrPubkey &pubkey) {
+  std::vector<uint8_t> bytes = pubkey.GetData().GetBytes();
+  if (bytes.size() != SchnorrPubkey::kSchnorrPubkeySize) {
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid Schnorr pubkey data.");
+  }
+  return bytes;
+}
+
 SchnorrSignature SchnorrUtil::Sign(const ByteData256 &msg, const Privkey &sk) {
   return SignCommon(msg, sk, nullptr, ByteData());
 }
@@ -379,7 +502,7 @@ SchnorrSignature SchnorrUtil::SignWithNonce(
 Pubkey SchnorrUtil::ComputeSigPoint(
     const ByteData256 &msg, const SchnorrPubkey &nonce,
     const SchnorrPubkey &pubkey) {
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   secp256k1_xonly_pubkey xonly_pubkey = ParseXOnlyPubkey(pubkey);
 
   secp256k1_xonly_pubkey secp_nonce = ParseXOnlyPubkey(nonce);
@@ -407,49 +530,200 @@ Pubkey SchnorrUtil::ComputeSigPointBatch(
         "message.");
   }
 
-  Pubkey rs;
+  auto ctx = GetSecp256k1Context();
+  std::vector<uint8_t> pubkey_bytes = GetXOnlyPubkeyBytes(pubkey);
 
-  if (msgs.size() == 1) {
-    rs = Pubkey(ByteData("02").Concat(nonces[0].GetData()));
-  } else {
-    std::vector<Pubkey> pub_nonces;
-    for (const auto &nonce : nonces) {
-      pub_nonces.push_back(Pubkey(ByteData("02").Concat(nonce.GetData())));
-    }
-    rs = Pubkey::CombinePubkey(pub_nonces);
-  }
-
-  auto bip340_challenge = ByteData(
-      "7bb52d7a9fef58323eb1bf7a407db382d2f3f2d81bb1224f49fe518f6d48d37c7bb52d7"
-      "a9fef58323eb1bf7a407db382d2f3f2d81bb1224f49fe518f6d48d37c");
-  Privkey res;
+  // S = (R_0 + ... + R_n) + X * (e_0 + ... + e_n)
+  std::vector<secp256k1_pubkey> points(msgs.size() + 1);
+  uint8_t challenge_sum[kByteData256Length];
   for (size_t i = 0; i < msgs.size(); i++) {
-    auto m_tagged_hash =
-        HashUtil::Sha256(bip340_challenge.Concat(nonces[i].GetData())
-                             .Concat(pubkey.GetData())
-                             .Concat(msgs[i]));
+    std::vector<uint8_t> nonce_bytes = GetXOnlyPubkeyBytes(nonces[i]);
+    points[i] = ParseEvenYPoint(ctx, nonce_bytes.data());
+
+    uint8_t challenge[kByteData256Length];
+    ComputeBip340Challenge(
+        nonce_bytes.data(), pubkey_bytes.data(), msgs[i].GetBytes().data(),
+        challenge);
+    int ret = 1;
     if (i == 0) {
-      res = Privkey(m_tagged_hash);
+      memcpy(challenge_sum, challenge, sizeof(challenge_sum));
+      ret = secp256k1_ec_seckey_verify(ctx, challenge_sum);
     } else {
-      res = res.CreateTweakAdd(m_tagged_hash);
+      ret = secp256k1_ec_privkey_tweak_add(ctx, challenge_sum, challenge);
+    }
+    if (ret != 1) {
+      throw CfdException(
+          CfdError::kCfdInternalError, "Could not compute sigpoint");
     }
   }
 
-  auto xe = Pubkey(ByteData("02").Concat(pubkey.GetData()))
-                .CreateTweakMul(ByteData256(res.GetData()));
+  secp256k1_pubkey &xe = points.back();
+  xe = ParseEvenYPoint(ctx, pubkey_bytes.data());
+  if (secp256k1_ec_pubkey_tweak_mul(ctx, &xe, challenge_sum) != 1) {
+    throw CfdException(
+        CfdError::kCfdInternalError, "Could not compute sigpoint");
+  }
+
+  std::vector<const secp256k1_pubkey *> point_ptrs(points.size());
+  for (size_t i = 0; i < points.size(); i++) point_ptrs[i] = &points[i];
+  secp256k1_pubkey sig_point;
+  if (secp256k1_ec_pubkey_combine(
+          ctx, &sig_point, point_ptrs.data(), point_ptrs.size()) != 1) {
+    throw CfdException(
+        CfdError::kCfdInternalError, "Could not compute sigpoint");
+  }
+  return SerializePoint(ctx, sig_point);
+}
+
+std::vector<Pubkey> SchnorrUtil::ComputeSigPointList(
+    const std::vector<ByteData256> &msgs,
+    const std::vector<SchnorrPubkey> &nonces, const SchnorrPubkey &pubkey,
+    uint32_t thread_count) {
+  if (msgs.size() != nonces.size()) {
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError,
+        "Expected same number of messages and nonces.");
+  }
+
+  std::vector<uint8_t> pubkey_bytes = GetXOnlyPubkeyBytes(pubkey);
+  const secp256k1_pubkey base_point =
+      ParseEvenYPoint(GetSecp256k1Context(), pubkey_bytes.data());
+
+  std::vector<Pubkey> result(msgs.size());
+  ParallelFor(
+      msgs.size(), thread_count, kSigPointMinUnit,
+      [&msgs, &nonces, &pubkey_bytes, &base_point, &result](
+          size_t begin, size_t end) {
+        auto ctx = GetSecp256k1Context();
+        for (size_t i = begin; i < end; ++i) {
+          std::vector<uint8_t> nonce_bytes = GetXOnlyPubkeyBytes(nonces[i]);
+          uint8_t challenge[kByteData256Length];
+          ComputeBip340Challenge(
+              nonce_bytes.data(), pubkey_bytes.data(),
+              msgs[i].GetBytes().data(), challenge);
+
+          secp256k1_pubkey points[2];
+          points[0] = ParseEvenYPoint(ctx, nonce_bytes.data());
+          points[1] = base_point;
+          if (secp256k1_ec_pubkey_tweak_mul(ctx, &points[1], challenge) !=
+              1) {
+            throw CfdException(
+                CfdError::kCfdInternalError, "Could not compute sigpoint");
+          }
+          const secp256k1_pubkey *point_ptrs[2] = {&points[0], &points[1]};
+          secp256k1_pubkey sig_point;
+          if (secp256k1_ec_pubkey_combine(ctx, &sig_point, point_ptrs, 2) !=
+              1) {
+            throw CfdException(
+                CfdError::kCfdInternalError, "Could not compute sigpoint");
+          }
+          result[i] = SerializePoint(ctx, sig_point);
+        }
+      });
+  return result;
+}
+
+std::vector<Pubkey> SchnorrUtil::CombineSigPointList(
+    const std::vector<std::vector<Pubkey>> &digit_sig_points,
+    const std::vector<std::vector<uint32_t>> &outcomes,
+    uint32_t thread_count) {
+  // parse the shared table once.
+  std::vector<std::vector<secp256k1_pubkey>> table(digit_sig_points.size());
+  for (size_t digit = 0; digit < digit_sig_points.size(); ++digit) {
+    for (const auto &sig_point : digit_sig_points[digit]) {
+      table[digit].push_back(ParsePubkey(sig_point));
+    }
+  }
+  for (const auto &outcome : outcomes) {
+    if (outcome.empty() || (outcome.size() > table.size())) {
+      throw CfdException(
+          CfdError::kCfdIllegalArgumentError, "Invalid outcome digit count.");
+    }
+    for (size_t digit = 0; digit < outcome.size(); ++digit) {
+      if (outcome[digit] >= table[digit].size()) {
+        throw CfdException(
+            CfdError::kCfdOutOfRangeError, "Outcome digit value out of range.");
+      }
+    }
+  }
 
-  return Pubkey::CombinePubkey({rs, xe});
+  std::vector<Pubkey> result(outcomes.size());
+  ParallelFor(
+      outcomes.size(), thread_count, kCombineSigPointMinUnit,
+      [&table, &outcomes, &result](size_t begin, size_t end) {
+        auto ctx = GetSecp256k1Context();
+        std::vector<const secp256k1_pubkey *> point_ptrs(table.size());
+        for (size_t index = begin; index < end; ++index) {
+          const auto &outcome = outcomes[index];
+          for (size_t digit = 0; digit < outcome.size(); ++digit) {
+            point_ptrs[digit] = &table[digit][outcome[digit]];
+          }
+          secp256k1_pubkey sig_point;
+          if (secp256k1_ec_pubkey_combine(
+                  ctx, &sig_point, point_ptrs.data(), outcome.size()) != 1) {
+            throw CfdException(
+                CfdError::kCfdInternalError, "Could not combine sigpoints");
+          }
+          result[index] = SerializePoint(ctx, sig_point);
+        }
+      });
+  return result;
 }
 
 bool SchnorrUtil::Verify(
     const SchnorrSignature &signature, const ByteData256 &msg,
     const SchnorrPubkey &pubkey) {
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   secp256k1_xonly_pubkey xonly_pubkey = ParseXOnlyPubkey(pubkey);
   return 1 == secp256k1_schnorrsig_verify(
                   ctx, signature.GetData().GetBytes().data(),
                   msg.GetBytes().data(), kByteData256Length, &xonly_pubkey);
 }
 
+bool SchnorrUtil::VerifyBatch(
+    const std::vector<SchnorrSignature> &signatures,
+    const std::vector<ByteData256> &msgs,
+    const std::vector<SchnorrPubkey> &pubkeys,
+    std::vector<uint32_t> *invalid_indexes, uint32_t thread_count) {
+  if ((signatures.size() != msgs.size()) ||
+      (signatures.size() != pubkeys.size())) {
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError,
+        "Expected same number of signatures, messages and pubkeys.");
+  }
+
+  std::vector<uint8_t> results(signatures.size(), 0);
+  ParallelFor(
+      signatures.size(), thread_count, kVerifyBatchMinUnit,
+      [&signatures, &msgs, &pubkeys, &results](size_t begin, size_t end) {
+        auto ctx = GetSecp256k1Context();
+        secp256k1_xonly_pubkey xonly_pubkey;
+        const SchnorrPubkey *parsed_pubkey = nullptr;
+        bool is_valid_pubkey = false;
+        for (size_t index = begin; index < end; ++index) {
+          const SchnorrPubkey &pubkey = pubkeys[index];
+          if ((parsed_pubkey == nullptr) ||
+              (!parsed_pubkey->Equals(pubkey))) {
+            const auto &pubkey_bytes = pubkey.GetData().GetBytes();
+            is_valid_pubkey =
+                (pubkey_bytes.size() == SchnorrPubkey::kSchnorrPubkeySize) &&
+                (secp256k1_xonly_pubkey_parse(
+                     ctx, &xonly_pubkey, pubkey_bytes.data()) == 1);
+            parsed_pubkey = &pubkey;
+          }
+          const auto &sig_bytes = signatures[index].GetData().GetBytes();
+          if ((!is_valid_pubkey) ||
+              (sig_bytes.size() != SchnorrSignature::kSchnorrSignatureSize)) {
+            continue;
+          }
+          results[index] = static_cast<uint8_t>(secp256k1_schnorrsig_verify(
+              ctx, sig_bytes.data(), msgs[index].GetBytes().data(),
+              kByteData256Length, &xonly_pubkey));
+        }
+      });
+
+  return CollectBatchResult(results, invalid_indexes);
+}
+
 }  // namespace core
 }  // namespace cfd
@@ -8,10 +8,10 @@
 #include "cfdcore/cfdcore_script.h"
 
 #include <algorithm>
+#include <cctype>
 #include <cstdlib>
-#include <map>
+#include <cstring>
 #include <memory>
-#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -31,11 +31,751 @@ using logger::warn;
 // -----------------------------------------------------------------------------
 // ScriptOperator
 // -----------------------------------------------------------------------------
-// operator object-enum mapping
-/// a map to search ScriptOperator using ScriptType.
-static std::map<ScriptType, ScriptOperator> g_operator_map;
-/// a map to search ScriptOperator using OP_CODE text.
-static std::map<std::string, ScriptOperator> g_operator_text_map;
+/// opcode flag: push operator (OP_0 - OP_16)
+static constexpr uint8_t kOpcodeFlagPush = 0x01;
+/// opcode flag: data push operator (0x01 - OP_PUSHDATA4)
+static constexpr uint8_t kOpcodeFlagPushData = 0x02;
+/// opcode flag: OP_SUCCESSx on the bitcoin tapscript (BIP-342)
+static constexpr uint8_t kOpcodeFlagSuccess = 0x04;
+/// opcode flag: OP_SUCCESSx on the elements tapscript
+static constexpr uint8_t kOpcodeFlagSuccessElements = 0x08;
+/// opcode flag: uses one script number on the stack top.
+static constexpr uint8_t kOpcodeFlagScriptNum1 = 0x10;
+/// opcode flag: uses two script numbers on the stack top.
+static constexpr uint8_t kOpcodeFlagScriptNum2 = 0x20;
+/// opcode flag: uses three script numbers on the stack top.
+static constexpr uint8_t kOpcodeFlagScriptNum3 = 0x40;
+
+#ifndef CFD_DISABLE_ELEMENTS
+#define CFD_OPCODE_NAME(elements_name, bitcoin_name) elements_name
+#define CFD_OPCODE_FLAG(elements_flag) (elements_flag)
+#else
+#define CFD_OPCODE_NAME(elements_name, bitcoin_name) bitcoin_name
+#define CFD_OPCODE_FLAG(elements_flag) 0
+#endif  // CFD_DISABLE_ELEMENTS
+
+/**
+ * @brief opcode table entry.
+ */
+struct OpcodeInfo {
+  const char* name;  //!< op_code text (nullptr: direct push size)
+  uint8_t flags;     //!< opcode flags
+};
+
+/// opcode table indexed by the op_code byte.
+// clang-format off
+static constexpr OpcodeInfo kOpcodeTable[256] = {
+    {"0", kOpcodeFlagPush},  // 0x00
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x01
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x02
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x03
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x04
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x05
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x06
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x07
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x08
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x09
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x0a
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x0b
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x0c
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x0d
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x0e
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x0f
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x10
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x11
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x12
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x13
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x14
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x15
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x16
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x17
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x18
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x19
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x1a
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x1b
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x1c
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x1d
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x1e
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x1f
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x20
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x21
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x22
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x23
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x24
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x25
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x26
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x27
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x28
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x29
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x2a
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x2b
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x2c
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x2d
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x2e
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x2f
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x30
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x31
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x32
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x33
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x34
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x35
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x36
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x37
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x38
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x39
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x3a
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x3b
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x3c
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x3d
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x3e
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x3f
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x40
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x41
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x42
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x43
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x44
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x45
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x46
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x47
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x48
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x49
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x4a
+    {nullptr, kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x4b
+    {"OP_PUSHDATA1", kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x4c
+    {"OP_PUSHDATA2", kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x4d
+    {"OP_PUSHDATA4", kOpcodeFlagPush | kOpcodeFlagPushData},  // 0x4e
+    {"-1", kOpcodeFlagPush},  // 0x4f
+    {"OP_RESERVED",  // 0x50
+     kOpcodeFlagPush | kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},
+    {"1", kOpcodeFlagPush},  // 0x51
+    {"2", kOpcodeFlagPush},  // 0x52
+    {"3", kOpcodeFlagPush},  // 0x53
+    {"4", kOpcodeFlagPush},  // 0x54
+    {"5", kOpcodeFlagPush},  // 0x55
+    {"6", kOpcodeFlagPush},  // 0x56
+    {"7", kOpcodeFlagPush},  // 0x57
+    {"8", kOpcodeFlagPush},  // 0x58
+    {"9", kOpcodeFlagPush},  // 0x59
+    {"10", kOpcodeFlagPush},  // 0x5a
+    {"11", kOpcodeFlagPush},  // 0x5b
+    {"12", kOpcodeFlagPush},  // 0x5c
+    {"13", kOpcodeFlagPush},  // 0x5d
+    {"14", kOpcodeFlagPush},  // 0x5e
+    {"15", kOpcodeFlagPush},  // 0x5f
+    {"16", kOpcodeFlagPush},  // 0x60
+    {"OP_NOP", 0},  // 0x61
+    {"OP_VER", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x62
+    {"OP_IF", 0},  // 0x63
+    {"OP_NOTIF", 0},  // 0x64
+    {"OP_VERIF", 0},  // 0x65
+    {"OP_VERNOTIF", 0},  // 0x66
+    {"OP_ELSE", 0},  // 0x67
+    {"OP_ENDIF", 0},  // 0x68
+    {"OP_VERIFY", 0},  // 0x69
+    {"OP_RETURN", 0},  // 0x6a
+    {"OP_TOALTSTACK", 0},  // 0x6b
+    {"OP_FROMALTSTACK", 0},  // 0x6c
+    {"OP_2DROP", 0},  // 0x6d
+    {"OP_2DUP", 0},  // 0x6e
+    {"OP_3DUP", 0},  // 0x6f
+    {"OP_2OVER", 0},  // 0x70
+    {"OP_2ROT", 0},  // 0x71
+    {"OP_2SWAP", 0},  // 0x72
+    {"OP_IFDUP", 0},  // 0x73
+    {"OP_DEPTH", 0},  // 0x74
+    {"OP_DROP", 0},  // 0x75
+    {"OP_DUP", 0},  // 0x76
+    {"OP_NIP", 0},  // 0x77
+    {"OP_OVER", 0},  // 0x78
+    {"OP_PICK", kOpcodeFlagScriptNum1},  // 0x79
+    {"OP_ROLL", kOpcodeFlagScriptNum1},  // 0x7a
+    {"OP_ROT", 0},  // 0x7b
+    {"OP_SWAP", 0},  // 0x7c
+    {"OP_TUCK", 0},  // 0x7d
+    {"OP_CAT", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x7e
+    {"OP_SUBSTR", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x7f
+    {"OP_LEFT", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x80
+    {"OP_RIGHT", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x81
+    {"OP_SIZE", 0},  // 0x82
+    {"OP_INVERT", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x83
+    {"OP_AND", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x84
+    {"OP_OR", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x85
+    {"OP_XOR", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x86
+    {"OP_EQUAL", 0},  // 0x87
+    {"OP_EQUALVERIFY", 0},  // 0x88
+    {"OP_RESERVED1", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x89
+    {"OP_RESERVED2", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x8a
+    {"OP_1ADD", kOpcodeFlagScriptNum1},  // 0x8b
+    {"OP_1SUB", kOpcodeFlagScriptNum1},  // 0x8c
+    {"OP_2MUL", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x8d
+    {"OP_2DIV", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x8e
+    {"OP_NEGATE", kOpcodeFlagScriptNum1},  // 0x8f
+    {"OP_ABS", kOpcodeFlagScriptNum1},  // 0x90
+    {"OP_NOT", kOpcodeFlagScriptNum1},  // 0x91
+    {"OP_0NOTEQUAL", kOpcodeFlagScriptNum1},  // 0x92
+    {"OP_ADD", kOpcodeFlagScriptNum2},  // 0x93
+    {"OP_SUB", kOpcodeFlagScriptNum2},  // 0x94
+    {"OP_MUL", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x95
+    {"OP_DIV", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x96
+    {"OP_MOD", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x97
+    {"OP_LSHIFT", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x98
+    {"OP_RSHIFT", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0x99
+    {"OP_BOOLAND", kOpcodeFlagScriptNum2},  // 0x9a
+    {"OP_BOOLOR", kOpcodeFlagScriptNum2},  // 0x9b
+    {"OP_NUMEQUAL", kOpcodeFlagScriptNum2},  // 0x9c
+    {"OP_NUMEQUALVERIFY", kOpcodeFlagScriptNum2},  // 0x9d
+    {"OP_NUMNOTEQUAL", kOpcodeFlagScriptNum2},  // 0x9e
+    {"OP_LESSTHAN", kOpcodeFlagScriptNum2},  // 0x9f
+    {"OP_GREATERTHAN", kOpcodeFlagScriptNum2},  // 0xa0
+    {"OP_LESSTHANOREQUAL", kOpcodeFlagScriptNum2},  // 0xa1
+    {"OP_GREATERTHANOREQUAL", kOpcodeFlagScriptNum2},  // 0xa2
+    {"OP_MIN", kOpcodeFlagScriptNum2},  // 0xa3
+    {"OP_MAX", kOpcodeFlagScriptNum2},  // 0xa4
+    {"OP_WITHIN", kOpcodeFlagScriptNum3},  // 0xa5
+    {"OP_RIPEMD160", 0},  // 0xa6
+    {"OP_SHA1", 0},  // 0xa7
+    {"OP_SHA256", 0},  // 0xa8
+    {"OP_HASH160", 0},  // 0xa9
+    {"OP_HASH256", 0},  // 0xaa
+    {"OP_CODESEPARATOR", 0},  // 0xab
+    {"OP_CHECKSIG", 0},  // 0xac
+    {"OP_CHECKSIGVERIFY", 0},  // 0xad
+    {"OP_CHECKMULTISIG", 0},  // 0xae
+    {"OP_CHECKMULTISIGVERIFY", 0},  // 0xaf
+    {"OP_NOP1", 0},  // 0xb0
+    {"OP_CHECKLOCKTIMEVERIFY", kOpcodeFlagScriptNum1},  // 0xb1
+    {"OP_CHECKSEQUENCEVERIFY", kOpcodeFlagScriptNum1},  // 0xb2
+    {"OP_NOP4", 0},  // 0xb3
+    {"OP_NOP5", 0},  // 0xb4
+    {"OP_NOP6", 0},  // 0xb5
+    {"OP_NOP7", 0},  // 0xb6
+    {"OP_NOP8", 0},  // 0xb7
+    {"OP_NOP9", 0},  // 0xb8
+    {"OP_NOP10", 0},  // 0xb9
+    {"OP_CHECKSIGADD", kOpcodeFlagScriptNum3},  // 0xba
+    {"OP_SUCCESS187", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xbb
+    {"OP_SUCCESS188", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xbc
+    {"OP_SUCCESS189", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xbd
+    {"OP_SUCCESS190", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xbe
+    {"OP_SUCCESS191", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xbf
+    {CFD_OPCODE_NAME("OP_DETERMINISTICRANDOM", "OP_SUCCESS192"),  // 0xc0
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum3)},
+    {CFD_OPCODE_NAME("OP_CHECKSIGFROMSTACK", "OP_SUCCESS193"),  // 0xc1
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum3)},
+    {CFD_OPCODE_NAME("OP_CHECKSIGFROMSTACKVERIFY", "OP_SUCCESS194"),  // 0xc2
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum3)},
+    {"OP_SUCCESS195", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xc3
+    {CFD_OPCODE_NAME("OP_SHA256INITIALIZE", "OP_SUCCESS196"),  // 0xc4
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_SHA256UPDATE", "OP_SUCCESS197"),  // 0xc5
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum2)},
+    {CFD_OPCODE_NAME("OP_SHA256FINALIZE", "OP_SUCCESS198"),  // 0xc6
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum2)},
+    {CFD_OPCODE_NAME("OP_INSPECTINPUTOUTPOINT", "OP_SUCCESS199"),  // 0xc7
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_INSPECTINPUTASSET", "OP_SUCCESS200"),  // 0xc8
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_INSPECTINPUTVALUE", "OP_SUCCESS201"),  // 0xc9
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_INSPECTINPUTSCRIPTPUBKEY", "OP_SUCCESS202"),  // 0xca
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_INSPECTINPUTSEQUENCE", "OP_SUCCESS203"),  // 0xcb
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_INSPECTINPUTISSUANCE", "OP_SUCCESS204"),  // 0xcc
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_PUSHCURRENTINPUTINDEX", "OP_SUCCESS205"),  // 0xcd
+     kOpcodeFlagSuccess},
+    {CFD_OPCODE_NAME("OP_INSPECTOUTPUTASSET", "OP_SUCCESS206"),  // 0xce
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_INSPECTOUTPUTVALUE", "OP_SUCCESS207"),  // 0xcf
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_INSPECTOUTPUTNONCE", "OP_SUCCESS208"),  // 0xd0
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_INSPECTOUTPUTSCRIPTPUBKEY", "OP_SUCCESS209"),  // 0xd1
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_INSPECTVERSION", "OP_SUCCESS210"),  // 0xd2
+     kOpcodeFlagSuccess},
+    {CFD_OPCODE_NAME("OP_INSPECTLOCKTIME", "OP_SUCCESS211"),  // 0xd3
+     kOpcodeFlagSuccess},
+    {CFD_OPCODE_NAME("OP_INSPECTNUMINPUTS", "OP_SUCCESS212"),  // 0xd4
+     kOpcodeFlagSuccess},
+    {CFD_OPCODE_NAME("OP_INSPECTNUMOUTPUTS", "OP_SUCCESS213"),  // 0xd5
+     kOpcodeFlagSuccess},
+    {CFD_OPCODE_NAME("OP_TXWEIGHT", "OP_SUCCESS214"),  // 0xd6
+     kOpcodeFlagSuccess},
+    {CFD_OPCODE_NAME("OP_ADD64", "OP_SUCCESS215"),  // 0xd7
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum2)},
+    {CFD_OPCODE_NAME("OP_SUB64", "OP_SUCCESS216"),  // 0xd8
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum2)},
+    {CFD_OPCODE_NAME("OP_MUL64", "OP_SUCCESS217"),  // 0xd9
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum2)},
+    {CFD_OPCODE_NAME("OP_DIV64", "OP_SUCCESS218"),  // 0xda
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum2)},
+    {CFD_OPCODE_NAME("OP_NEG64", "OP_SUCCESS219"),  // 0xdb
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_LESSTHAN64", "OP_SUCCESS220"),  // 0xdc
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum2)},
+    {CFD_OPCODE_NAME("OP_LESSTHANOREQUAL64", "OP_SUCCESS221"),  // 0xdd
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum2)},
+    {CFD_OPCODE_NAME("OP_GREATERTHAN64", "OP_SUCCESS222"),  // 0xde
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum2)},
+    {CFD_OPCODE_NAME("OP_GREATERTHANOREQUAL64", "OP_SUCCESS223"),  // 0xdf
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum2)},
+    {CFD_OPCODE_NAME("OP_SCRIPTNUMTOLE64", "OP_SUCCESS224"),  // 0xe0
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_LE64TOSCRIPTNUM", "OP_SUCCESS225"),  // 0xe1
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_LE32TOLE64", "OP_SUCCESS226"),  // 0xe2
+     kOpcodeFlagSuccess | CFD_OPCODE_FLAG(kOpcodeFlagScriptNum1)},
+    {CFD_OPCODE_NAME("OP_ECMULSCALARVERIFY", "OP_SUCCESS227"),  // 0xe3
+     kOpcodeFlagSuccess},
+    {CFD_OPCODE_NAME("OP_TWEAKVERIFY", "OP_SUCCESS228"),  // 0xe4
+     kOpcodeFlagSuccess},
+    {"OP_SUCCESS229", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xe5
+    {"OP_SUCCESS230", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xe6
+    {"OP_SUCCESS231", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xe7
+    {"OP_SUCCESS232", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xe8
+    {"OP_SUCCESS233", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xe9
+    {"OP_SUCCESS234", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xea
+    {"OP_SUCCESS235", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xeb
+    {"OP_SUCCESS236", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xec
+    {"OP_SUCCESS237", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xed
+    {"OP_SUCCESS238", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xee
+    {"OP_SUCCESS239", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xef
+    {"OP_SUCCESS240", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xf0
+    {"OP_SUCCESS241", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xf1
+    {"OP_SUCCESS242", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xf2
+    {"OP_SUCCESS243", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xf3
+    {"OP_SUCCESS244", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xf4
+    {"OP_SUCCESS245", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xf5
+    {"OP_SUCCESS246", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xf6
+    {"OP_SUCCESS247", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xf7
+    {"OP_SUCCESS248", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xf8
+    {"OP_SUCCESS249", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xf9
+    {"OP_SUCCESS250", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xfa
+    {"OP_SUCCESS251", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xfb
+    {"OP_SUCCESS252", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xfc
+    {"OP_SUCCESS253", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xfd
+    {"OP_SUCCESS254", kOpcodeFlagSuccess | kOpcodeFlagSuccessElements},  // 0xfe
+    {"OP_INVALIDOPCODE", 0},  // 0xff
+};
+// clang-format on
+
+#undef CFD_OPCODE_NAME
+#undef CFD_OPCODE_FLAG
+
+/**
+ * @brief opcode text table entry.
+ */
+struct OpcodeName {
+  const char* name;  //!< op_code text
+  ScriptType type;   //!< script type
+  bool is_alias;     //!< alias text (operator uses the opcode table text)
+};
+
+/// all op_code texts accepted by ScriptOperator::Get.
+static const OpcodeName kOpcodeNameTable[] = {
+    {"0", kOp_0, false},
+    {"OP_FALSE", kOpFalse, false},
+    {"OP_PUSHDATA1", kOpPushData1, false},
+    {"OP_PUSHDATA2", kOpPushData2, false},
+    {"OP_PUSHDATA4", kOpPushData4, false},
+    {"-1", kOp1Negate, false},
+    {"OP_RESERVED", kOpReserved, false},
+    {"1", kOp_1, false},
+    {"OP_TRUE", kOpTrue, false},
+    {"2", kOp_2, false},
+    {"3", kOp_3, false},
+    {"4", kOp_4, false},
+    {"5", kOp_5, false},
+    {"6", kOp_6, false},
+    {"7", kOp_7, false},
+    {"8", kOp_8, false},
+    {"9", kOp_9, false},
+    {"10", kOp_10, false},
+    {"11", kOp_11, false},
+    {"12", kOp_12, false},
+    {"13", kOp_13, false},
+    {"14", kOp_14, false},
+    {"15", kOp_15, false},
+    {"16", kOp_16, false},
+    {"OP_NOP", kOpNop, false},
+    {"OP_VER", kOpVer, false},
+    {"OP_IF", kOpIf, false},
+    {"OP_NOTIF", kOpNotIf, false},
+    {"OP_VERIF", kOpVerIf, false},
+    {"OP_VERNOTIF", kOpVerNotIf, false},
+    {"OP_ELSE", kOpElse, false},
+    {"OP_ENDIF", kOpEndIf, false},
+    {"OP_VERIFY", kOpVerify, false},
+    {"OP_RETURN", kOpReturn, false},
+    {"OP_TOALTSTACK", kOpToAltStack, false},
+    {"OP_FROMALTSTACK", kOpFromAltStack, false},
+    {"OP_2DROP", kOp2Drop, false},
+    {"OP_2DUP", kOp2Dup, false},
+    {"OP_3DUP", kOp3Dup, false},
+    {"OP_2OVER", kOp2Over, false},
+    {"OP_2ROT", kOp2Rot, false},
+    {"OP_2SWAP", kOp2Swap, false},
+    {"OP_IFDUP", kOpIfDup, false},
+    {"OP_DEPTH", kOpDepth, false},
+    {"OP_DROP", kOpDrop, false},
+    {"OP_DUP", kOpDup, false},
+    {"OP_NIP", kOpNip, false},
+    {"OP_OVER", kOpOver, false},
+    {"OP_PICK", kOpPick, false},
+    {"OP_ROLL", kOpRoll, false},
+    {"OP_ROT", kOpRot, false},
+    {"OP_SWAP", kOpSwap, false},
+    {"OP_TUCK", kOpTuck, false},
+    {"OP_CAT", kOpCat, false},
+    {"OP_SUBSTR", kOpSubstr, false},
+    {"OP_LEFT", kOpLeft, false},
+    {"OP_RIGHT", kOpRight, false},
+    {"OP_SIZE", kOpSize, false},
+    {"OP_INVERT", kOpInvert, false},
+    {"OP_AND", kOpAnd, false},
+    {"OP_OR", kOpOr, false},
+    {"OP_XOR", kOpXor, false},
+    {"OP_EQUAL", kOpEqual, false},
+    {"OP_EQUALVERIFY", kOpEqualVerify, false},
+    {"OP_RESERVED1", kOpReserved1, false},
+    {"OP_RESERVED2", kOpReserved2, false},
+    {"OP_1ADD", kOp1Add, false},
+    {"OP_1SUB", kOp1Sub, false},
+    {"OP_2MUL", kOp2Mul, false},
+    {"OP_2DIV", kOp2Div, false},
+    {"OP_NEGATE", kOpNegate, false},
+    {"OP_ABS", kOpAbs, false},
+    {"OP_NOT", kOpNot, false},
+    {"OP_0NOTEQUAL", kOp0NotEqual, false},
+    {"OP_ADD", kOpAdd, false},
+    {"OP_SUB", kOpSub, false},
+    {"OP_MUL", kOpMul, false},
+    {"OP_DIV", kOpDiv, false},
+    {"OP_MOD", kOpMod, false},
+    {"OP_LSHIFT", kOpLShift, false},
+    {"OP_RSHIFT", kOpRShift, false},
+    {"OP_BOOLAND", kOpBoolAnd, false},
+    {"OP_BOOLOR", kOpBoolOr, false},
+    {"OP_NUMEQUAL", kOpNumEqual, false},
+    {"OP_NUMEQUALVERIFY", kOpNumEqualVerify, false},
+    {"OP_NUMNOTEQUAL", kOpNumNotEqual, false},
+    {"OP_LESSTHAN", kOpLessThan, false},
+    {"OP_GREATERTHAN", kOpGreaterThan, false},
+    {"OP_LESSTHANOREQUAL", kOpLessThanOrEqual, false},
+    {"OP_GREATERTHANOREQUAL", kOpGreaterThanOrEqual, false},
+    {"OP_MIN", kOpMin, false},
+    {"OP_MAX", kOpMax, false},
+    {"OP_WITHIN", kOpWithIn, false},
+    {"OP_RIPEMD160", kOpRipemd, false},
+    {"OP_SHA1", kOpSha1, false},
+    {"OP_SHA256", kOpSha256, false},
+    {"OP_HASH160", kOpHash160, false},
+    {"OP_HASH256", kOpHash256, false},
+    {"OP_CODESEPARATOR", kOpCodeSeparator, false},
+    {"OP_CHECKSIG", kOpCheckSig, false},
+    {"OP_CHECKSIGVERIFY", kOpCheckSigVerify, false},
+    {"OP_CHECKMULTISIG", kOpCheckMultiSig, false},
+    {"OP_CHECKMULTISIGVERIFY", kOpCheckMultiSigVerify, false},
+    {"OP_NOP1", kOpNop1, false},
+    {"OP_CHECKLOCKTIMEVERIFY", kOpCheckLockTimeVerify, false},
+    {"OP_NOP2", kOpNop2, false},
+    {"OP_CHECKSEQUENCEVERIFY", kOpCheckSequenceVerify, false},
+    {"OP_NOP3", kOpNop3, false},
+    {"OP_NOP4", kOpNop4, false},
+    {"OP_NOP5", kOpNop5, false},
+    {"OP_NOP6", kOpNop6, false},
+    {"OP_NOP7", kOpNop7, false},
+    {"OP_NOP8", kOpNop8, false},
+    {"OP_NOP9", kOpNop9, false},
+    {"OP_NOP10", kOpNop10, false},
+    {"OP_CHECKSIGADD", kOpCheckSigAdd, false},
+    {"OP_INVALIDOPCODE", kOpInvalidOpCode, false},
+#ifndef CFD_DISABLE_ELEMENTS
+    {"OP_DETERMINISTICRANDOM", kOpDeterministricRandom, false},
+    {"OP_CHECKSIGFROMSTACK", kOpCheckSigFromStack, false},
+    {"OP_CHECKSIGFROMSTACKVERIFY", kOpCheckSigFromStackVerify, false},
+    {"OP_SHA256INITIALIZE", kOpSha256Initialize, false},
+    {"OP_SHA256UPDATE", kOpSha256Update, false},
+    {"OP_SHA256FINALIZE", kOpSha256Finalize, false},
+    {"OP_INSPECTINPUTOUTPOINT", kOpInspectInputOutPint, false},
+    {"OP_INSPECTINPUTASSET", kOpInspectInputAsset, false},
+    {"OP_INSPECTINPUTVALUE", kOpInspectInputValue, false},
+    {"OP_INSPECTINPUTSCRIPTPUBKEY", kOpInspectInputScriptPubkey, false},
+    {"OP_INSPECTINPUTSEQUENCE", kOpInspectInputSequence, false},
+    {"OP_INSPECTINPUTISSUANCE", kOpInspectInputIssuance, false},
+    {"OP_PUSHCURRENTINPUTINDEX", kOpPushCurrentInputIndex, false},
+    {"OP_INSPECTOUTPUTASSET", kOpInspectOutputAsset, false},
+    {"OP_INSPECTOUTPUTVALUE", kOpInspectOutputValue, false},
+    {"OP_INSPECTOUTPUTNONCE", kOpInspectOutputNonce, false},
+    {"OP_INSPECTOUTPUTSCRIPTPUBKEY", kOpInspectOutputScriptPubkey, false},
+    {"OP_INSPECTVERSION", kOpInspectVersion, false},
+    {"OP_INSPECTLOCKTIME", kOpInspectLocktime, false},
+    {"OP_INSPECTNUMINPUTS", kOpInspectNumInputs, false},
+    {"OP_INSPECTNUMOUTPUTS", kOpInspectNumOutputs, false},
+    {"OP_TXWEIGHT", kOpTxWeight, false},
+    {"OP_ADD64", kOpAdd64, false},
+    {"OP_SUB64", kOpSub64, false},
+    {"OP_MUL64", kOpMul64, false},
+    {"OP_DIV64", kOpDiv64, false},
+    {"OP_NEG64", kOpNeg64, false},
+    {"OP_LESSTHAN64", kOpLessThan64, false},
+    {"OP_LESSTHANOREQUAL64", kOpLessThanOrEqual64, false},
+    {"OP_GREATERTHAN64", kOpGreaterThan64, false},
+    {"OP_GREATERTHANOREQUAL64", kOpGreaterThanOrEqual64, false},
+    {"OP_SCRIPTNUMTOLE64", kOpScriptNumToLE64, false},
+    {"OP_LE64TOSCRIPTNUM", kOpLE64ToScriptNum, false},
+    {"OP_LE32TOLE64", kOpLE32ToLE64, false},
+    {"OP_ECMULSCALARVERIFY", kOpEcMulScalarVerify, false},
+    {"OP_TWEAKVERIFY", kOpTweakVerify, false},
+#endif  // CFD_DISABLE_ELEMENTS
+    {"OP_SUCCESS80", kOpSuccess80, false},
+    {"OP_SUCCESS98", kOpSuccess98, false},
+    {"OP_SUCCESS126", kOpSuccess126, false},
+    {"OP_SUCCESS127", kOpSuccess127, false},
+    {"OP_SUCCESS128", kOpSuccess128, false},
+    {"OP_SUCCESS129", kOpSuccess129, false},
+    {"OP_SUCCESS131", kOpSuccess131, false},
+    {"OP_SUCCESS132", kOpSuccess132, false},
+    {"OP_SUCCESS133", kOpSuccess133, false},
+    {"OP_SUCCESS134", kOpSuccess134, false},
+    {"OP_SUCCESS137", kOpSuccess137, false},
+    {"OP_SUCCESS138", kOpSuccess138, false},
+    {"OP_SUCCESS141", kOpSuccess141, false},
+    {"OP_SUCCESS142", kOpSuccess142, false},
+    {"OP_SUCCESS149", kOpSuccess149, false},
+    {"OP_SUCCESS150", kOpSuccess150, false},
+    {"OP_SUCCESS151", kOpSuccess151, false},
+    {"OP_SUCCESS152", kOpSuccess152, false},
+    {"OP_SUCCESS153", kOpSuccess153, false},
+    {"OP_SUCCESS187", kOpSuccess187, false},
+    {"OP_SUCCESS188", kOpSuccess188, false},
+    {"OP_SUCCESS189", kOpSuccess189, false},
+    {"OP_SUCCESS190", kOpSuccess190, false},
+    {"OP_SUCCESS191", kOpSuccess191, false},
+    {"OP_SUCCESS192", kOpSuccess192, false},
+    {"OP_SUCCESS193", kOpSuccess193, false},
+    {"OP_SUCCESS194", kOpSuccess194, false},
+    {"OP_SUCCESS195", kOpSuccess195, false},
+    {"OP_SUCCESS196", kOpSuccess196, false},
+    {"OP_SUCCESS197", kOpSuccess197, false},
+    {"OP_SUCCESS198", kOpSuccess198, false},
+    {"OP_SUCCESS199", kOpSuccess199, false},
+    {"OP_SUCCESS200", kOpSuccess200, false},
+    {"OP_SUCCESS201", kOpSuccess201, false},
+    {"OP_SUCCESS202", kOpSuccess202, false},
+    {"OP_SUCCESS203", kOpSuccess203, false},
+    {"OP_SUCCESS204", kOpSuccess204, false},
+    {"OP_SUCCESS205", kOpSuccess205, false},
+    {"OP_SUCCESS206", kOpSuccess206, false},
+    {"OP_SUCCESS207", kOpSuccess207, false},
+    {"OP_SUCCESS208", kOpSuccess208, false},
+    {"OP_SUCCESS209", kOpSuccess209, false},
+    {"OP_SUCCESS210", kOpSuccess210, false},
+    {"OP_SUCCESS211", kOpSuccess211, false},
+    {"OP_SUCCESS212", kOpSuccess212, false},
+    {"OP_SUCCESS213", kOpSuccess213, false},
+    {"OP_SUCCESS214", kOpSuccess214, false},
+    {"OP_SUCCESS215", kOpSuccess215, false},
+    {"OP_SUCCESS216", kOpSuccess216, false},
+    {"OP_SUCCESS217", kOpSuccess217, false},
+    {"OP_SUCCESS218", kOpSuccess218, false},
+    {"OP_SUCCESS219", kOpSuccess219, false},
+    {"OP_SUCCESS220", kOpSuccess220, false},
+    {"OP_SUCCESS221", kOpSuccess221, false},
+    {"OP_SUCCESS222", kOpSuccess222, false},
+    {"OP_SUCCESS223", kOpSuccess223, false},
+    {"OP_SUCCESS224", kOpSuccess224, false},
+    {"OP_SUCCESS225", kOpSuccess225, false},
+    {"OP_SUCCESS226", kOpSuccess226, false},
+    {"OP_SUCCESS227", kOpSuccess227, false},
+    {"OP_SUCCESS228", kOpSuccess228, false},
+    {"OP_SUCCESS229", kOpSuccess229, false},
+    {"OP_SUCCESS230", kOpSuccess230, false},
+    {"OP_SUCCESS231", kOpSuccess231, false},
+    {"OP_SUCCESS232", kOpSuccess232, false},
+    {"OP_SUCCESS233", kOpSuccess233, false},
+    {"OP_SUCCESS234", kOpSuccess234, false},
+    {"OP_SUCCESS235", kOpSuccess235, false},
+    {"OP_SUCCESS236", kOpSuccess236, false},
+    {"OP_SUCCESS237", kOpSuccess237, false},
+    {"OP_SUCCESS238", kOpSuccess238, false},
+    {"OP_SUCCESS239", kOpSuccess239, false},
+    {"OP_SUCCESS240", kOpSuccess240, false},
+    {"OP_SUCCESS241", kOpSuccess241, false},
+    {"OP_SUCCESS242", kOpSuccess242, false},
+    {"OP_SUCCESS243", kOpSuccess243, false},
+    {"OP_SUCCESS244", kOpSuccess244, false},
+    {"OP_SUCCESS245", kOpSuccess245, false},
+    {"OP_SUCCESS246", kOpSuccess246, false},
+    {"OP_SUCCESS247", kOpSuccess247, false},
+    {"OP_SUCCESS248", kOpSuccess248, false},
+    {"OP_SUCCESS249", kOpSuccess249, false},
+    {"OP_SUCCESS250", kOpSuccess250, false},
+    {"OP_SUCCESS251", kOpSuccess251, false},
+    {"OP_SUCCESS252", kOpSuccess252, false},
+    {"OP_SUCCESS253", kOpSuccess253, false},
+    {"OP_SUCCESS254", kOpSuccess254, false},
+    // OP_CODE style aliases of the number operators
+    {"OP_0", kOp_0, true},
+    {"OP_1NEGATE", kOp1Negate, true},
+    {"OP_1", kOp_1, true},
+    {"OP_2", kOp_2, true},
+    {"OP_3", kOp_3, true},
+    {"OP_4", kOp_4, true},
+    {"OP_5", kOp_5, true},
+    {"OP_6", kOp_6, true},
+    {"OP_7", kOp_7, true},
+    {"OP_8", kOp_8, true},
+    {"OP_9", kOp_9, true},
+    {"OP_10", kOp_10, true},
+    {"OP_11", kOp_11, true},
+    {"OP_12", kOp_12, true},
+    {"OP_13", kOp_13, true},
+    {"OP_14", kOp_14, true},
+    {"OP_15", kOp_15, true},
+    {"OP_16", kOp_16, true},
+};
+
+/**
+ * @brief perfect hash index of the opcode text table.
+ * @details The index is built by hash and displace at first use.
+ *     A lookup is two hashes and a single string compare.
+ */
+class OpcodeNameIndex {
+ public:
+  /**
+   * @brief constructor.
+   */
+  OpcodeNameIndex();
+
+  /**
+   * @brief find the opcode text entry.
+   * @param[in] text    op_code text
+   * @param[in] size    text size
+   * @return opcode text entry (nullptr: not found)
+   */
+  const OpcodeName* Find(const char* text, size_t size) const;
+
+ private:
+  static constexpr uint32_t kBucketCount = 128;  //!< bucket count
+  static constexpr uint32_t kSlotCount = 512;    //!< slot count
+
+  uint16_t displacements_[kBucketCount];  //!< bucket hash seed (0: empty)
+  int16_t slots_[kSlotCount];             //!< name table index (-1: empty)
+
+  /**
+   * @brief get the text hash.
+   * @param[in] text    op_code text
+   * @param[in] size    text size
+   * @param[in] seed    hash seed
+   * @return hash value
+   */
+  static uint32_t Hash(const char* text, size_t size, uint32_t seed);
+};
+
+OpcodeNameIndex::OpcodeNameIndex() {
+  static constexpr size_t kNameCount =
+      sizeof(kOpcodeNameTable) / sizeof(kOpcodeNameTable[0]);
+  std::vector<std::vector<uint16_t>> buckets(kBucketCount);
+  for (size_t index = 0; index < kNameCount; ++index) {
+    const char* name = kOpcodeNameTable[index].name;
+    uint32_t bucket = Hash(name, strlen(name), 0) % kBucketCount;
+    buckets[bucket].push_back(static_cast<uint16_t>(index));
+  }
+  std::vector<uint32_t> order(kBucketCount);
+  for (uint32_t index = 0; index < kBucketCount; ++index) order[index] = index;
+  std::stable_sort(
+      order.begin(), order.end(), [&buckets](uint32_t lhs, uint32_t rhs) {
+        return buckets[lhs].size() > buckets[rhs].size();
+      });
+
+  memset(displacements_, 0, sizeof(displacements_));
+  for (uint32_t index = 0; index < kSlotCount; ++index) slots_[index] = -1;
+
+  // place the large buckets first, then search a collision-free seed.
+  std::vector<uint32_t> positions;
+  for (uint32_t bucket : order) {
+    const std::vector<uint16_t>& keys = buckets[bucket];
+    if (keys.empty()) break;
+    uint32_t seed = 1;
+    for (; seed <= 0xffff; ++seed) {
+      positions.clear();
+      for (uint16_t key : keys) {
+        const char* name = kOpcodeNameTable[key].name;
+        uint32_t position = Hash(name, strlen(name), seed) % kSlotCount;
+        if ((slots_[position] >= 0) ||
+            (std::find(positions.begin(), positions.end(), position) !=
+             positions.end())) {
+          break;
+        }
+        positions.push_back(position);
+      }
+      if (positions.size() == keys.size()) break;
+    }
+    if (seed > 0xffff) {
+      warn(CFD_LOG_SOURCE, "opcode name index build failed.");
+      throw CfdException(
+          CfdError::kCfdInternalError, "opcode name index build failed.");
+    }
+    displacements_[bucket] = static_cast<uint16_t>(seed);
+    for (size_t index = 0; index < keys.size(); ++index) {
+      slots_[positions[index]] = static_cast<int16_t>(keys[index]);
+    }
+  }
+}
+
+const OpcodeName* OpcodeNameIndex::Find(const char* text, size_t size) const {
+  uint32_t seed = displacements_[Hash(text, size, 0) % kBucketCount];
+  if (seed == 0) return nullptr;
+  int16_t slot = slots_[Hash(text, size, seed) % kSlotCount];
+  if (slot < 0) return nullptr;
+  const OpcodeName* entry = &kOpcodeNameTable[slot];
+  if ((strncmp(entry->name, text, size) != 0) || (entry->name[size] != '\0')) {
+    return nullptr;
+  }
+  return entry;
+}
+
+uint32_t OpcodeNameIndex::Hash(const char* text, size_t size, uint32_t seed) {
+  // FNV-1a with a seed, and the murmur3 finalizer.
+  uint32_t hash = 2166136261U ^ (seed * 0x9e3779b9U);
+  for (size_t index = 0; index < size; ++index) {
+    hash ^= static_cast<uint8_t>(text[index]);
+    hash *= 16777619U;
+  }
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bU;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35U;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+/**
+ * @brief find the opcode text entry.
+ * @param[in] text    op_code text
+ * @param[in] size    text size
+ * @return opcode text entry (nullptr: not found)
+ */
+static const OpcodeName* FindOpcodeName(const char* text, size_t size) {
+  static const OpcodeNameIndex kIndex;
+  return kIndex.Find(text, size);
+}
+
+/**
+ * @brief get the op_code text.
+ * @param[in] type    script type
+ * @return op_code text ("UNKNOWN": unregistered op_code)
+ */
+static const char* GetOpcodeText(ScriptType type) {
+  uint32_t value = static_cast<uint32_t>(type);
+  if ((value < 256) && (kOpcodeTable[value].name != nullptr)) {
+    return kOpcodeTable[value].name;
+  }
+  return "UNKNOWN";
+}
 
 const ScriptOperator ScriptOperator::OP_0(kOp_0, "0");
 const ScriptOperator ScriptOperator::OP_FALSE(kOpFalse, "OP_FALSE");
@@ -421,25 +1161,13 @@ const ScriptOperator ScriptOperator::OP_SUCCESS254(
     kOpSuccess254, "OP_SUCCESS254");
 
 ScriptOperator::ScriptOperator(ScriptType data_type)
-    : ScriptOperator(data_type, "") {
+    : data_type_(data_type), text_data_(GetOpcodeText(data_type)) {
   // do nothing
 }
 
 ScriptOperator::ScriptOperator(ScriptType data_type, const std::string& text)
     : data_type_(data_type), text_data_(text) {
-  // map register the const definition at production timing
-  if (text.empty()) {
-    if (!g_operator_map.empty()) {
-      text_data_ = ToString();
-    }
-  } else {
-    if (g_operator_map.find(data_type_) == g_operator_map.end()) {
-      g_operator_map.emplace(data_type_, *this);
-    }
-    if (g_operator_text_map.find(text_data_) == g_operator_text_map.end()) {
-      g_operator_text_map.emplace(text_data_, *this);
-    }
-  }
+  // do nothing
 }
 
 bool ScriptOperator::Equals(const ScriptOperator& object) const {
@@ -447,16 +1175,7 @@ bool ScriptOperator::Equals(const ScriptOperator& object) const {
 }
 
 std::string ScriptOperator::ToString() const {
-  if (text_data_.empty()) {
-    if (!g_operator_map.empty()) {
-      decltype(g_operator_map)::const_iterator ite =
-          g_operator_map.find(data_type_);
-      if (ite != g_operator_map.end()) {
-        return ite->second.ToString();
-      }
-    }
-    return "UNKNOWN";
-  }
+  if (text_data_.empty()) return GetOpcodeText(data_type_);
   return text_data_;
 }
 
@@ -480,69 +1199,32 @@ std::string ScriptOperator::ToCodeString() const {
 
 bool ScriptOperator::IsPushOperator() const {
   // OP_RESERVED is treated as Push command (bitcoincore)
-  if ((data_type_ >= ScriptType::kOp_0) &&
-      (data_type_ <= ScriptType::kOp_16)) {
-    return true;
-  }
-  return false;
+  uint32_t value = static_cast<uint32_t>(data_type_);
+  return (value < 256) && ((kOpcodeTable[value].flags & kOpcodeFlagPush) != 0);
 }
 
 bool ScriptOperator::IsValid(const std::string& message) {
   if (message.empty()) return false;
-  if (g_operator_text_map.empty()) return false;
-  if ((message == "OP_0") || (message == "OP_1NEGATE")) {
-    return true;
-  } else if (message.length() >= 4) {
-    int num = std::atoi(message.substr(3).c_str());
-    std::string opcode_text = "OP_" + std::to_string(num);
-    if ((message == opcode_text) && (num >= 1) && (num <= 16)) {
-      return true;
-    }
-  }
-  return (g_operator_text_map.find(message) != g_operator_text_map.end());
+  return FindOpcodeName(message.data(), message.size()) != nullptr;
 }
 
 ScriptOperator ScriptOperator::Get(const std::string& message) {
-  std::string search_text = message;
-  if (message == "OP_0") {
-    search_text = "0";
-  } else if (message == "OP_1NEGATE") {
-    search_text = "-1";
-  } else if (message.length() >= 4) {
-    int num = std::atoi(message.substr(3).c_str());
-    std::string num_str = std::to_string(num);
-    std::string opcode_text = "OP_" + num_str;
-    if ((message == opcode_text) && (num >= 1) && (num <= 16)) {
-      search_text = num_str;
-    }
-  }
-  decltype(g_operator_text_map)::const_iterator ite =
-      g_operator_text_map.find(search_text);
-  if (ite == g_operator_text_map.end()) {
+  const OpcodeName* entry = FindOpcodeName(message.data(), message.size());
+  if (entry == nullptr) {
     warn(CFD_LOG_SOURCE, "target op_code not found.");
     throw InvalidScriptException("target op_code not found.");
   }
-  return ite->second;
+  // "OP_0", "OP_1NEGATE" and "OP_1"-"OP_16" are named as the number text.
+  if (entry->is_alias) return ScriptOperator(entry->type);
+  return ScriptOperator(entry->type, entry->name);
 }
 
 bool ScriptOperator::IsOpSuccess(ScriptType op_code, bool is_elements) {
-  if ((op_code == kOpSuccess80) || (op_code == kOpSuccess98) ||
-      ((op_code >= kOpSuccess126) && (op_code <= kOpSuccess129)) ||
-      ((op_code >= kOpSuccess131) && (op_code <= kOpSuccess134)) ||
-      ((op_code >= kOpSuccess137) && (op_code <= kOpSuccess138)) ||
-      ((op_code >= kOpSuccess141) && (op_code <= kOpSuccess142)) ||
-      ((op_code >= kOpSuccess149) && (op_code <= kOpSuccess153)) ||
-      ((op_code >= kOpSuccess187) && (op_code <= kOpSuccess191)) ||
-      (op_code == kOpSuccess195) ||
-      ((op_code >= kOpSuccess229) && (op_code <= kOpSuccess254))) {
-    return true;
-  } else if (!is_elements) {
-    if (((op_code >= kOpSuccess192) && (op_code <= kOpSuccess194)) ||
-        ((op_code >= kOpSuccess196) && (op_code <= kOpSuccess228))) {
-      return true;
-    }
-  }
-  return false;
+  uint32_t value = static_cast<uint32_t>(op_code);
+  if (value >= 256) return false;
+  uint8_t flag = (is_elements) ? kOpcodeFlagSuccessElements
+                               : kOpcodeFlagSuccess;
+  return (kOpcodeTable[value].flags & flag) != 0;
 }
 
 ScriptOperator::ScriptOperator(const ScriptOperator& object)
@@ -593,6 +1275,14 @@ ScriptElement::ScriptElement(const ScriptElement& element)
   // do nothing
 }
 
+ScriptElement::ScriptElement(ScriptElement&& element) noexcept
+    : type_(element.type_),
+      op_code_(element.op_code_),
+      binary_data_(std::move(element.binary_data_)),
+      value_(element.value_) {
+  // do nothing
+}
+
 ScriptElement::ScriptElement(const ScriptType& type)
     : type_(kElementOpCode), op_code_(type), binary_data_(), value_(0) {
   if ((type == kOp1Negate) || ((type >= kOp_1) && (type <= kOp_16))) {
@@ -639,18 +1329,7 @@ ScriptElement::ScriptElement(int64_t value)
       op_code += static_cast<int32_t>(value) - 1;
     }
 
-    ScriptType key = static_cast<ScriptType>(op_code);
-    bool is_find = false;
-    if (!g_operator_map.empty()) {
-      decltype(g_operator_map)::const_iterator ite = g_operator_map.find(key);
-      if (ite != g_operator_map.end()) {
-        op_code_ = ite->second;
-        is_find = true;
-      }
-    }
-    if (!is_find) {
-      op_code_ = ScriptOperator(key);
-    }
+    op_code_ = ScriptOperator(static_cast<ScriptType>(op_code));
     if (op_code_.GetDataType() != kOpInvalidOpCode) {
       type_ = kElementOpCode;
     }
@@ -680,6 +1359,16 @@ ScriptElement& ScriptElement::operator=(const ScriptElement& element) {
   return *this;
 }
 
+ScriptElement& ScriptElement::operator=(ScriptElement&& element) noexcept {
+  if (this != &element) {
+    type_ = element.type_;
+    op_code_ = element.op_code_;
+    binary_data_ = std::move(element.binary_data_);
+    value_ = element.value_;
+  }
+  return *this;
+}
+
 ScriptElementType ScriptElement::GetType() const { return type_; }
 
 const ScriptOperator& ScriptElement::GetOpCode() const { return op_code_; }
@@ -829,111 +1518,144 @@ const ByteData ScriptHash::GetData() const { return script_hash_; }
 // -----------------------------------------------------------------------------
 const Script Script::Empty;  ///< empty script
 
-Script::Script() : script_data_(), script_stack_() {
+/**
+ * @brief Check the push operations of the script data.
+ * @details Checks the same size conditions as the stack decoding,
+ *     without building the script elements.
+ * @param[in] bytedata            script byte data.
+ * @param[in] ignore_size_check   ignore script size check.
+ * @throw InvalidScriptException  incorrect script data.
+ */
+static void CheckScriptData(const ByteData& bytedata, bool ignore_size_check) {
+  ByteSpan buffer(bytedata);
+  uint64_t offset = 0;
+  while (offset < buffer.size()) {
+    uint8_t view_data = buffer[offset];
+    uint64_t push_size = 0;
+    if ((view_data == kOp_0) || (view_data > kOpPushData4)) {
+      ++offset;
+      continue;
+    } else if (view_data < kOpPushData1) {
+      push_size = view_data;
+      ++offset;
+    } else if (view_data == kOpPushData1) {
+      ++offset;
+      if ((offset + 1) >= buffer.size()) {
+        warn(CFD_LOG_SOURCE, "OP_PUSHDATA1 is incorrect size.");
+        throw InvalidScriptException("OP_PUSHDATA1 is incorrect size.");
+      }
+      push_size = buffer[offset];
+      ++offset;
+    } else if (view_data == kOpPushData2) {
+      ++offset;
+      if ((offset + sizeof(uint16_t)) >= buffer.size()) {
+        warn(CFD_LOG_SOURCE, "OP_PUSHDATA2 is incorrect size.");
+        throw InvalidScriptException("OP_PUSHDATA2 is incorrect size.");
+      }
+      push_size = buffer[offset] | (buffer[offset + 1] << 8);
+      offset += sizeof(uint16_t);
+    } else {
+      ++offset;
+      if ((offset + sizeof(uint32_t)) >= buffer.size()) {
+        warn(CFD_LOG_SOURCE, "OP_PUSHDATA4 is incorrect size.");
+        throw InvalidScriptException("OP_PUSHDATA4 is incorrect size.");
+      }
+      uint32_t uint_value = 0;
+      // process under LittleEndian
+      memcpy(&uint_value, buffer.data() + offset, sizeof(uint_value));
+      push_size = uint_value;
+      offset += sizeof(uint_value);
+    }
+
+    if ((offset + push_size) > buffer.size()) {
+      if (!ignore_size_check) {
+        warn(CFD_LOG_SOURCE, "buffer is incorrect size.");
+        throw InvalidScriptException("buffer is incorrect size.");
+      }
+      // (push past end) If script is coinbase scriptsig, length is low.
+      push_size = buffer.size() - offset;
+    }
+    offset += push_size;
+  }
+}
+
+Script::Script()
+    : script_data_(), script_stack_(), ignore_size_check_(false) {
   // do nothing
 }
 
-Script::Script(const std::string& hex) : script_data_(), script_stack_() {
-  std::vector<uint8_t> buffer = StringUtil::StringToByte(hex);
-  ByteData data = ByteData(buffer);
-  SetStackData(data);
-  script_data_ = data;
+Script::Script(const std::string& hex)
+    : script_data_(StringUtil::StringToByte(hex)),
+      script_stack_(),
+      ignore_size_check_(false) {
+  CheckScriptData(script_data_, ignore_size_check_);
 }
 
 Script::Script(const ByteData& bytedata)
-    : script_data_(bytedata), script_stack_() {
-  SetStackData(bytedata);
+    : script_data_(bytedata), script_stack_(), ignore_size_check_(false) {
+  CheckScriptData(script_data_, ignore_size_check_);
 }
 
 Script::Script(const ByteData& bytedata, bool ignore_size_check)
-    : script_data_(bytedata), script_stack_() {
-  SetStackData(bytedata, ignore_size_check);
+    : script_data_(bytedata),
+      script_stack_(),
+      ignore_size_check_(ignore_size_check) {
+  CheckScriptData(script_data_, ignore_size_check_);
 }
 
-Script::Script(const Script& object) {
-  script_data_ = object.script_data_;
-  script_stack_ = object.script_stack_;
+Script::Script(const Script& object)
+    : script_data_(object.script_data_),
+      script_stack_(std::atomic_load(&object.script_stack_)),
+      ignore_size_check_(object.ignore_size_check_) {
+  // do nothing
+}
+
+Script::Script(Script&& object) noexcept
+    : script_data_(std::move(object.script_data_)),
+      script_stack_(std::move(object.script_stack_)),
+      ignore_size_check_(object.ignore_size_check_) {
+  // do nothing
 }
 
 Script& Script::operator=(const Script& object) & {
   if (this != &object) {
     script_data_ = object.script_data_;
-    script_stack_ = object.script_stack_;
+    script_stack_ = std::atomic_load(&object.script_stack_);
+    ignore_size_check_ = object.ignore_size_check_;
   }
   return *this;
 }
 
-/// a map to search ScriptType using script stack count.
-static const std::set<ScriptType> kUseScriptNum1{
-    kOpCheckSequenceVerify,
-    kOpCheckLockTimeVerify,
-    kOp1Add,
-    kOp1Sub,
-    kOpNegate,
-    kOpAbs,
-    kOpNot,
-    kOp0NotEqual,
-    kOpPick,
-    kOpRoll,
-#ifndef CFD_DISABLE_ELEMENTS
-    kOpSha256Initialize,
-    kOpInspectInputOutPint,
-    kOpInspectInputAsset,
-    kOpInspectInputValue,
-    kOpInspectInputScriptPubkey,
-    kOpInspectInputSequence,
-    kOpInspectInputIssuance,
-    kOpInspectOutputAsset,
-    kOpInspectOutputValue,
-    kOpInspectOutputNonce,
-    kOpInspectOutputScriptPubkey,
-    kOpNeg64,
-    kOpScriptNumToLE64,
-    kOpLE64ToScriptNum,
-    kOpLE32ToLE64,
-#endif  // CFD_DISABLE_ELEMENTS
-};
-/// a map to search ScriptType using script stack count.
-static const std::set<ScriptType> kUseScriptNum2{
-    kOpAdd,
-    kOpSub,
-    kOpGreaterThan,
-    kOpBoolOr,
-    kOpNumEqual,
-    kOpNumEqualVerify,
-    kOpNumNotEqual,
-    kOpLessThan,
-    kOpBoolAnd,
-    kOpLessThanOrEqual,
-    kOpMin,
-    kOpMax,
-    kOpGreaterThanOrEqual,
-#ifndef CFD_DISABLE_ELEMENTS
-    kOpSha256Update,
-    kOpSha256Finalize,
-    kOpAdd64,
-    kOpSub64,
-    kOpMul64,
-    kOpDiv64,
-    kOpLessThan64,
-    kOpLessThanOrEqual64,
-    kOpGreaterThan64,
-    kOpGreaterThanOrEqual64,
-#endif  // CFD_DISABLE_ELEMENTS
-};
-/// a map to search ScriptType using script stack count.
-static const std::set<ScriptType> kUseScriptNum3{
-    kOpWithIn,
-    kOpCheckSigAdd,
-#ifndef CFD_DISABLE_ELEMENTS
-    kOpDeterministricRandom,
-    kOpCheckSigFromStack,
-    kOpCheckSigFromStackVerify,
-#endif  // CFD_DISABLE_ELEMENTS
-};
+Script& Script::operator=(Script&& object) & noexcept {
+  if (this != &object) {
+    script_data_ = std::move(object.script_data_);
+    script_stack_ = std::move(object.script_stack_);
+    ignore_size_check_ = object.ignore_size_check_;
+  }
+  return *this;
+}
 
-void Script::SetStackData(const ByteData& bytedata, bool ignore_size_check) {
-  std::vector<uint8_t> buffer = bytedata.GetBytes();
+const std::vector<ScriptElement>& Script::GetStackData() const {
+  std::shared_ptr<const std::vector<ScriptElement>> stack =
+      std::atomic_load(&script_stack_);
+  if (!stack) {
+    std::shared_ptr<const std::vector<ScriptElement>> decoded =
+        std::make_shared<const std::vector<ScriptElement>>(
+            DecodeStackData(script_data_, ignore_size_check_));
+    // If another reader has already set it, use that one.
+    if (std::atomic_compare_exchange_strong(
+            &script_stack_, &stack, decoded)) {
+      stack = decoded;
+    }
+  }
+  // script_stack_ holds the reference until the next non-const operation.
+  return *stack;
+}
+
+std::vector<ScriptElement> Script::DecodeStackData(
+    const ByteData& bytedata, bool ignore_size_check) {
+  ByteSpan buffer(bytedata);
+  std::vector<ScriptElement> script_stack;
 
   // create stack
   bool is_collect_buffer = false;
@@ -947,7 +1669,7 @@ void Script::SetStackData(const ByteData& bytedata, bool ignore_size_check) {
       // @formatter:off
       ScriptElement script_element = ScriptElement(ScriptOperator::OP_0);
       // @formatter:on
-      script_stack_.push_back(script_element);
+      script_stack.push_back(script_element);
 
     } else if (view_data < kOpPushData1) {
       collect_buffer_size = view_data;
@@ -972,7 +1694,7 @@ void Script::SetStackData(const ByteData& bytedata, bool ignore_size_check) {
         throw InvalidScriptException("OP_PUSHDATA2 is incorrect size.");
       }
       // process under LittleEndian
-      memcpy(&ushort_value, &buffer[offset], sizeof(ushort_value));
+      memcpy(&ushort_value, buffer.data() + offset, sizeof(ushort_value));
       collect_buffer_size = ushort_value;
       offset += sizeof(ushort_value);
       is_collect_buffer = true;
@@ -985,7 +1707,7 @@ void Script::SetStackData(const ByteData& bytedata, bool ignore_size_check) {
         throw InvalidScriptException("OP_PUSHDATA4 is incorrect size.");
       }
       // process under LittleEndian
-      memcpy(&uint_value, &buffer[offset], sizeof(uint_value));
+      memcpy(&uint_value, buffer.data() + offset, sizeof(uint_value));
       collect_buffer_size = uint_value;
       offset += sizeof(uint_value);
       is_collect_buffer = true;
@@ -997,51 +1719,48 @@ void Script::SetStackData(const ByteData& bytedata, bool ignore_size_check) {
 
       // Setting for ScriptOperator
       ScriptType type = (ScriptType)view_data;
-      if (!g_operator_map.empty()) {
-        decltype(g_operator_map)::const_iterator ite =
-            g_operator_map.find(type);
-        if (ite != g_operator_map.end()) {
-          ScriptElement script_element = ScriptElement(ite->second);
-          script_stack_.push_back(script_element);
-
-          // Since bytedata is stored as numerica type, after decoding bytedata
-          // Re-convert to numeric type based on the contents of OP_CODE.
-          /// Since OP_CHECKMULTISIG and OP_CHECKMULTISIGVERIFY are
-          // in the range of OP_1-OP_16, they are excluded from
-          // this conversion process.
-          size_t convert_count = 0;
-          if (kUseScriptNum1.count(type) > 0) {
-            if (script_stack_.size() > 1) {
-              convert_count = 1;
-            }
-          } else if (kUseScriptNum2.count(type) > 0) {
-            if (script_stack_.size() > 2) {
-              convert_count = 2;
-            }
-          } else if (kUseScriptNum3.count(type) > 0) {
-            if (script_stack_.size() > 3) {
-              convert_count = 3;
-            }
+      const OpcodeInfo& opcode_info = kOpcodeTable[view_data];
+      if (opcode_info.name != nullptr) {
+        ScriptElement script_element = ScriptElement(ScriptOperator(type));
+        script_stack.push_back(script_element);
+
+        // Since bytedata is stored as numerica type, after decoding bytedata
+        // Re-convert to numeric type based on the contents of OP_CODE.
+        /// Since OP_CHECKMULTISIG and OP_CHECKMULTISIGVERIFY are
+        // in the range of OP_1-OP_16, they are excluded from
+        // this conversion process.
+        size_t convert_count = 0;
+        if ((opcode_info.flags & kOpcodeFlagScriptNum1) != 0) {
+          if (script_stack.size() > 1) {
+            convert_count = 1;
           }
+        } else if ((opcode_info.flags & kOpcodeFlagScriptNum2) != 0) {
+          if (script_stack.size() > 2) {
+            convert_count = 2;
+          }
+        } else if ((opcode_info.flags & kOpcodeFlagScriptNum3) != 0) {
+          if (script_stack.size() > 3) {
+            convert_count = 3;
+          }
+        }
 
-          static constexpr uint32_t kMaxArray = 5;
-          if ((convert_count != 0) && (convert_count <= kMaxArray)) {
-            int64_t values[kMaxArray];
-            memset(values, 0, sizeof(values));
-            size_t stack_offset = script_stack_.size();
-            stack_offset -= convert_count + 1;
-            uint32_t check_count = 0;
-            for (uint32_t index = 0; index < convert_count; ++index) {
-              if (script_stack_[stack_offset + index].ConvertBinaryToNumber(
-                      &values[index])) {
-                ++check_count;
-              }
+        static constexpr uint32_t kMaxArray = 5;
+        if ((convert_count != 0) && (convert_count <= kMaxArray)) {
+          int64_t values[kMaxArray];
+          memset(values, 0, sizeof(values));
+          size_t stack_offset = script_stack.size();
+          stack_offset -= convert_count + 1;
+          uint32_t check_count = 0;
+          for (uint32_t index = 0; index < convert_count; ++index) {
+            if (script_stack[stack_offset + index].ConvertBinaryToNumber(
+                    &values[index])) {
+              ++check_count;
             }
-            if (check_count == convert_count) {
-              ScriptElement* pointer = script_stack_.data();
-              for (uint32_t index = 0; index < convert_count; ++index) {
-                pointer[stack_offset + index] = ScriptElement(values[index]);
-              }
+          }
+          if (check_count == convert_count) {
+            ScriptElement* pointer = script_stack.data();
+            for (uint32_t index = 0; index < convert_count; ++index) {
+              pointer[stack_offset + index] = ScriptElement(values[index]);
             }
           }
         }
@@ -1069,18 +1788,18 @@ void Script::SetStackData(const ByteData& bytedata, bool ignore_size_check) {
           buffer.begin() + offset,
           buffer.begin() + offset + tmp_collect_buffer_size);
 
-      if (top_collect_buffer.size() > script_stack_.size()) {
+      if (top_collect_buffer.size() > script_stack.size()) {
         // for coinbase script check
-        top_collect_buffer[script_stack_.size()] = ByteData(collect_buffer);
+        top_collect_buffer[script_stack.size()] = ByteData(collect_buffer);
       }
       if (tmp_collect_buffer_size <= kMaxScriptNumSize) {
         ScriptElement script_element =
             ScriptElement(ConvertToNumber(collect_buffer), true);
-        script_stack_.push_back(script_element);
+        script_stack.push_back(script_element);
       } else {
         ByteData byte_array = ByteData(collect_buffer);
         ScriptElement script_element = ScriptElement(byte_array);
-        script_stack_.push_back(script_element);
+        script_stack.push_back(script_element);
       }
       offset += tmp_collect_buffer_size;
       is_collect_buffer = false;
@@ -1093,9 +1812,10 @@ void Script::SetStackData(const ByteData& bytedata, bool ignore_size_check) {
     warn(CFD_LOG_SOURCE, "incorrect script data.");
     throw InvalidScriptException("incorrect script data.");
   }
+  return script_stack;
 }
 
-int64_t Script::ConvertToNumber(const std::vector<uint8_t> bytes) {
+int64_t Script::ConvertToNumber(const std::vector<uint8_t>& bytes) {
   if (bytes.empty()) {
     return 0;
   }
@@ -1125,23 +1845,24 @@ const ByteData Script::GetData() const { return script_data_; }
 
 const std::string Script::GetHex() const { return script_data_.GetHex(); }
 
-bool Script::IsEmpty() const { return script_data_.GetBytes().empty(); }
+bool Script::IsEmpty() const { return script_data_.IsEmpty(); }
 
 bool Script::Equals(const Script& object) const {
   return script_data_.Equals(object.script_data_);
 }
 
 std::vector<ScriptElement> Script::GetElementList() const {
-  return script_stack_;
+  return GetStackData();
 }
 
 std::string Script::ToString() const {
-  if (script_stack_.empty()) {
+  const std::vector<ScriptElement>& script_stack = GetStackData();
+  if (script_stack.empty()) {
     return "";
   }
 
   std::vector<std::string> str_list;
-  for (const ScriptElement& element : script_stack_) {
+  for (const ScriptElement& element : script_stack) {
     str_list.push_back(element.ToString());
   }
 
@@ -1156,8 +1877,9 @@ std::string Script::ToString() const {
 }
 
 bool Script::IsPushOnly() const {
+  const std::vector<ScriptElement>& script_stack = GetStackData();
   bool is_push_only = true;
-  for (const ScriptElement& element : script_stack_) {
+  for (const ScriptElement& element : script_stack) {
     if (element.IsOpCode()) {
       if (!element.GetOpCode().IsPushOperator()) {
         is_push_only = false;
@@ -1168,77 +1890,33 @@ bool Script::IsPushOnly() const {
   return is_push_only;
 }
 
-bool Script::IsP2pkScript() const {
-  return (
-      script_stack_.size() == 2 && script_stack_[0].IsBinary() &&
-      Pubkey::IsValid(script_stack_[0].GetBinaryData()) &&
-      script_stack_[1].GetOpCode() == ScriptOperator::OP_CHECKSIG);
-}
+bool Script::IsP2pkScript() const { return Classify() == kP2pkScript; }
 
-bool Script::IsP2pkhScript() const {
-  return (
-      script_data_.GetDataSize() == kScriptHashP2pkhLength &&
-      script_stack_.size() == 5 &&
-      script_stack_[0].GetOpCode() == ScriptOperator::OP_DUP &&
-      script_stack_[1].GetOpCode() == ScriptOperator::OP_HASH160 &&
-      script_stack_[2].IsBinary() &&
-      script_stack_[3].GetOpCode() == ScriptOperator::OP_EQUALVERIFY &&
-      script_stack_[4].GetOpCode() == ScriptOperator::OP_CHECKSIG);
-}
+bool Script::IsP2pkhScript() const { return Classify() == kP2pkhScript; }
 
-bool Script::IsP2shScript() const {
-  return (
-      script_data_.GetDataSize() == kScriptHashP2shLength &&
-      script_stack_.size() == 3 &&
-      script_stack_[0].GetOpCode() == ScriptOperator::OP_HASH160 &&
-      script_stack_[1].IsBinary() &&
-      script_stack_[2].GetOpCode() == ScriptOperator::OP_EQUAL);
-}
+bool Script::IsP2shScript() const { return Classify() == kP2shScript; }
 
 bool Script::IsMultisigScript() const {
-  if (script_stack_.size() < 4 || !script_stack_[0].IsNumber() ||
-      !script_stack_[(script_stack_.size() - 2)].IsNumber() ||
-      script_stack_[(script_stack_.size() - 1)].GetOpCode() !=
-          ScriptOperator::OP_CHECKMULTISIG) {
-    return false;
-  }
-  int64_t req_num = script_stack_[0].GetNumber();
-  int64_t num = script_stack_[(script_stack_.size() - 2)].GetNumber();
-  if (req_num <= 16 && !script_stack_[0].IsOpCode()) {
-    return false;
-  }
-  if (num <= 16 && !script_stack_[(script_stack_.size() - 2)].IsOpCode()) {
-    return false;
-  }
-
-  if (req_num > num || req_num == 0 ||
-      num != static_cast<int64_t>(script_stack_.size() - 3)) {
-    return false;
-  }
-
-  for (size_t i = 1; i < (script_stack_.size() - 2); ++i) {
-    if (!script_stack_[i].IsBinary() ||
-        !Pubkey::IsValid(script_stack_[i].GetBinaryData())) {
-      return false;
-    }
-  }
-  return true;
+  return Classify() == kMultisigScript;
 }
 
 bool Script::IsWitnessProgram() const {
   if ((script_data_.GetDataSize() < kMinWitnessProgramLength) ||
-      (kMaxWitnessProgramLength < script_data_.GetDataSize()) ||
-      (script_stack_.size() != 2) || (!script_stack_[0].IsOpCode()) ||
-      (!script_stack_[1].IsBinary())) {
+      (kMaxWitnessProgramLength < script_data_.GetDataSize())) {
+    return false;
+  }
+  const std::vector<ScriptElement>& script_stack = GetStackData();
+  if ((script_stack.size() != 2) || (!script_stack[0].IsOpCode()) ||
+      (!script_stack[1].IsBinary())) {
     return false;
   }
-  auto op_code = script_stack_[0].GetOpCode().GetDataType();
+  auto op_code = script_stack[0].GetOpCode().GetDataType();
   if ((op_code != ScriptType::kOp_0) &&
       ((op_code < ScriptType::kOp_1) || (op_code > ScriptType::kOp_16))) {
     return false;
   }
 
-  auto hash_size = script_stack_[1].GetBinaryData().GetDataSize();
+  auto hash_size = script_stack[1].GetBinaryData().GetDataSize();
   if (op_code == ScriptType::kOp_0) {
     if ((hash_size != 0x14) && (hash_size != 0x20)) return false;
   } else if (op_code == ScriptType::kOp_1) {
@@ -1249,7 +1927,8 @@ bool Script::IsWitnessProgram() const {
 
 WitnessVersion Script::GetWitnessVersion() const {
   if (IsWitnessProgram()) {
-    auto val = script_stack_[0].GetOpCode().GetDataType();
+    const std::vector<ScriptElement>& script_stack = GetStackData();
+    auto val = script_stack[0].GetOpCode().GetDataType();
     if (kOp_0 == val) {
       return WitnessVersion::kVersion0;
     } else if ((kOp_1 <= val) && (val <= kOp_16)) {
@@ -1261,59 +1940,342 @@ WitnessVersion Script::GetWitnessVersion() const {
   return WitnessVersion::kVersionNone;
 }
 
-bool Script::IsP2wpkhScript() const {
-  return (
-      script_data_.GetDataSize() == kScriptHashP2wpkhLength &&
-      script_stack_.size() == 2 &&
-      script_stack_[0].GetOpCode() == ScriptOperator::OP_0 &&
-      script_stack_[1].IsBinary() &&
-      script_stack_[1].GetBinaryData().GetDataSize() == kByteData160Length);
-}
+bool Script::IsP2wpkhScript() const { return Classify() == kP2wpkhScript; }
 
-bool Script::IsP2wshScript() const {
-  return (
-      script_data_.GetDataSize() == kScriptHashP2wshLength &&
-      script_stack_.size() == 2 &&
-      script_stack_[0].GetOpCode() == ScriptOperator::OP_0 &&
-      script_stack_[1].IsBinary() &&
-      script_stack_[1].GetBinaryData().GetDataSize() == kByteData256Length);
+bool Script::IsP2wshScript() const { return Classify() == kP2wshScript; }
+
+bool Script::IsTaprootScript() const { return Classify() == kTaprootScript; }
+
+/**
+ * @brief Read the push data on the script.
+ * @param[in] script      script data.
+ * @param[in,out] offset  read offset.
+ * @param[out] data       push data.
+ * @retval true   push operation.
+ * @retval false  other operation, or incorrect size.
+ */
+static bool ReadScriptPushData(
+    const ByteSpan& script, size_t* offset, ByteSpan* data) {
+  size_t index = *offset;
+  uint8_t op_code = script[index++];
+  if (op_code > kOpPushData4) return false;
+
+  size_t push_size = op_code;
+  size_t header_size = 0;
+  if (op_code == kOpPushData1) {
+    header_size = 1;
+  } else if (op_code == kOpPushData2) {
+    header_size = 2;
+  } else if (op_code == kOpPushData4) {
+    header_size = 4;
+  }
+  if (header_size != 0) {
+    if ((script.size() - index) < header_size) return false;
+    push_size = 0;
+    for (size_t count = header_size; count > 0; --count) {
+      push_size = (push_size << 8) | script[index + count - 1];
+    }
+    index += header_size;
+  }
+  if ((script.size() - index) < push_size) return false;
+  *data = script.SubSpan(index, push_size);
+  *offset = index + push_size;
+  return true;
 }
 
-bool Script::IsTaprootScript() const {
-  return (
-      script_data_.GetDataSize() == kScriptHashTaprootLength &&
-      script_stack_.size() == 2 &&
-      script_stack_[0].GetOpCode() == ScriptOperator::OP_1 &&
-      script_stack_[1].IsBinary() &&
-      script_stack_[1].GetBinaryData().GetDataSize() == kByteData256Length);
+/**
+ * @brief Check if the data is the pubkey format.
+ * @param[in] data    data
+ * @param[in] size    data size
+ * @retval true   pubkey format
+ * @retval false  other
+ */
+static bool IsPubkeyData(const uint8_t* data, size_t size) {
+  if (size == Pubkey::kCompressedPubkeySize) {
+    return (data[0] == 0x02) || (data[0] == 0x03);
+  } else if (size == Pubkey::kPubkeySize) {
+    return (data[0] == 0x04) || (data[0] == 0x06) || (data[0] == 0x07);
+  }
+  return false;
 }
 
-bool Script::IsPegoutScript() const {
-  if ((script_data_.GetDataSize() < 2) ||
-      (script_stack_[0].GetOpCode() != ScriptOperator::OP_RETURN)) {
+/**
+ * @brief Check if the data is the witness program format.
+ * @param[in] data    script data
+ * @param[in] size    script size
+ * @retval true   witness program
+ * @retval false  other
+ */
+static bool IsWitnessProgramData(const uint8_t* data, size_t size) {
+  if ((size < kMinWitnessProgramLength) || (size > kMaxWitnessProgramLength)) {
     return false;
   }
-
-  if (!script_stack_[1].IsBinary() ||
-      script_stack_[1].GetBinaryData().GetDataSize() != kByteData256Length) {
+  if ((data[0] != kOp_0) && ((data[0] < kOp_1) || (data[0] > kOp_16))) {
     return false;
   }
+  return static_cast<size_t>(data[1]) + 2 == size;
+}
 
-  for (size_t i = 2; i < script_stack_.size(); ++i) {
-    if (!script_stack_[i].IsBinary()) {
+/**
+ * @brief Check if the script is push operator only.
+ * @param[in] script    script data
+ * @param[in] offset    start offset
+ * @retval true   push operator only
+ * @retval false  contain other operator, or incorrect size.
+ */
+static bool IsPushOnlyData(const ByteSpan& script, size_t offset) {
+  ByteSpan data;
+  while (offset < script.size()) {
+    uint8_t op_code = script[offset];
+    if (op_code > kOp_16) {
+      return false;
+    } else if (op_code > kOpPushData4) {
+      ++offset;  // OP_1NEGATE, OP_RESERVED, OP_1 - OP_16
+    } else if (!ReadScriptPushData(script, &offset, &data)) {
       return false;
     }
   }
+  return true;
+}
 
+/**
+ * @brief Read the multisig key count on the script.
+ * @param[in] script      script data.
+ * @param[in,out] offset  read offset.
+ * @param[out] number     key count.
+ * @retval true   OP_1 - OP_16, or minimal push of 17 or more.
+ * @retval false  other
+ */
+static bool ReadMultisigNumber(
+    const ByteSpan& script, size_t* offset, uint32_t* number) {
+  size_t index = *offset;
+  if (index >= script.size()) return false;
+  uint8_t op_code = script[index];
+  if ((op_code >= kOp_1) && (op_code <= kOp_16)) {
+    *number = op_code - kOp_1 + 1;
+    *offset = index + 1;
+    return true;
+  }
+  if ((op_code == 1) && ((index + 1) < script.size()) &&
+      (script[index + 1] > 16) &&
+      (script[index + 1] <= Script::kMaxMultisigPubkeyNum)) {
+    *number = script[index + 1];
+    *offset = index + 2;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Check if the script is multisig format.
+ * @param[in] script        script data.
+ * @param[out] key_offset   offset of the first pubkey push.
+ * @param[out] key_size     byte size of the pubkey pushes.
+ * @retval true   multisig
+ * @retval false  other
+ */
+static bool IsMultisigData(
+    const ByteSpan& script, size_t* key_offset, size_t* key_size) {
+  size_t offset = 0;
+  uint32_t require_num = 0;
+  uint32_t key_num = 0;
+  uint32_t key_count = 0;
+  if (!ReadMultisigNumber(script, &offset, &require_num)) return false;
+
+  size_t start_offset = offset;
+  while (offset < script.size()) {
+    size_t push_size = script[offset];
+    if (((push_size != Pubkey::kCompressedPubkeySize) &&
+         (push_size != Pubkey::kPubkeySize)) ||
+        ((script.size() - offset - 1) < push_size) ||
+        !IsPubkeyData(script.data() + offset + 1, push_size)) {
+      break;
+    }
+    offset += push_size + 1;
+    ++key_count;
+  }
+  size_t end_offset = offset;
+  if (!ReadMultisigNumber(script, &offset, &key_num)) return false;
+  if (((offset + 1) != script.size()) || (require_num > key_num) ||
+      (key_num != key_count)) {
+    return false;
+  }
+  *key_offset = start_offset;
+  *key_size = end_offset - start_offset;
   return true;
 }
 
+bool Script::IsPegoutScript() const {
+  ByteSpan script(script_data_);
+  if ((script.size() < 2) || (script[0] != kOpReturn)) return false;
+
+  // genesis block hash, and binary data (not script number) only.
+  size_t offset = 1;
+  ByteSpan data;
+  if (!ReadScriptPushData(script, &offset, &data) ||
+      (data.size() != kByteData256Length)) {
+    return false;
+  }
+  while (offset < script.size()) {
+    if (!ReadScriptPushData(script, &offset, &data) ||
+        (data.size() <= kMaxScriptNumSize)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+StandardScriptType Script::Classify(ByteSpan* payload) const {
+  return Classify(ByteSpan(script_data_), payload);
+}
+
+StandardScriptType Script::Classify(
+    const ByteSpan& script, ByteSpan* payload) {
+  StandardScriptType type = kNonStandardScript;
+  ByteSpan data = script;
+  const size_t size = script.size();
+  const uint8_t* bytes = script.data();
+
+  if ((size == kScriptHashP2pkhLength) && (bytes[0] == kOpDup) &&
+      (bytes[1] == kOpHash160) && (bytes[2] == kByteData160Length) &&
+      (bytes[23] == kOpEqualVerify) && (bytes[24] == kOpCheckSig)) {
+    type = kP2pkhScript;
+    data = script.SubSpan(3, kByteData160Length);
+  } else if (
+      (size == kScriptHashP2shLength) && (bytes[0] == kOpHash160) &&
+      (bytes[1] == kByteData160Length) && (bytes[22] == kOpEqual)) {
+    type = kP2shScript;
+    data = script.SubSpan(2, kByteData160Length);
+  } else if (IsWitnessProgramData(bytes, size)) {
+    size_t program_size = size - 2;
+    if (bytes[0] == kOp_0) {
+      if (program_size == kByteData160Length) {
+        type = kP2wpkhScript;
+      } else if (program_size == kByteData256Length) {
+        type = kP2wshScript;
+      }
+    } else if ((bytes[0] == kOp_1) && (program_size == kByteData256Length)) {
+      type = kTaprootScript;
+    } else {
+      type = kWitnessUnknownScript;
+    }
+    if (type != kNonStandardScript) data = script.SubSpan(2, program_size);
+  } else if (
+      (size > 2) && (bytes[0] == (size - 2)) &&
+      (bytes[size - 1] == kOpCheckSig) && IsPubkeyData(bytes + 1, size - 2)) {
+    type = kP2pkScript;
+    data = script.SubSpan(1, size - 2);
+  } else if ((size != 0) && (bytes[0] == kOpReturn)) {
+    if (IsPushOnlyData(script, 1)) {
+      type = kNullDataScript;
+      data = script.SubSpan(1, size - 1);
+    }
+  } else if ((size != 0) && (bytes[size - 1] == kOpCheckMultiSig)) {
+    size_t key_offset = 0;
+    size_t key_size = 0;
+    if (IsMultisigData(script, &key_offset, &key_size)) {
+      type = kMultisigScript;
+      data = script.SubSpan(key_offset, key_size);
+    }
+  }
+
+  if (payload != nullptr) *payload = data;
+  return type;
+}
+
+// -----------------------------------------------------------------------------
+// ScriptPool
+// -----------------------------------------------------------------------------
+ScriptPool::ScriptPool(size_t max_size)
+    : max_size_(max_size),
+      intern_count_(0),
+      hit_count_(0),
+      byte_size_(0),
+      scripts_() {
+  // do nothing
+}
+
+Script ScriptPool::Intern(const ByteSpan& script_data) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++intern_count_;
+    auto ite = scripts_.find(script_data);
+    if (ite != scripts_.end()) {
+      ++hit_count_;
+      return ite->second;
+    }
+  }
+
+  // Create outside the lock. The buffer is shared even if it is small.
+  Script script(
+      ByteData::CreateSharedData(script_data.data(), script_data.size()));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if ((max_size_ != 0) && (scripts_.size() >= max_size_)) return script;
+  auto result = scripts_.emplace(ByteSpan(script.script_data_), script);
+  if (result.second) {
+    byte_size_ += script_data.size();
+  } else {
+    // another thread has already added it.
+    ++hit_count_;
+  }
+  return result.first->second;
+}
+
+Script ScriptPool::Intern(const Script& script) {
+  return Intern(ByteSpan(script.script_data_));
+}
+
+size_t ScriptPool::GetSize() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return scripts_.size();
+}
+
+uint64_t ScriptPool::GetInternCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return intern_count_;
+}
+
+uint64_t ScriptPool::GetHitCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hit_count_;
+}
+
+uint64_t ScriptPool::GetByteSize() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return byte_size_;
+}
+
+void ScriptPool::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  scripts_.clear();
+  byte_size_ = 0;
+}
+
+size_t ScriptPool::ScriptDataHash::operator()(const ByteSpan& bytes) const {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t index = 0; index < bytes.size(); ++index) {
+    hash ^= bytes[index];
+    hash *= 1099511628211ULL;
+  }
+  return static_cast<size_t>(hash);
+}
+
+bool ScriptPool::ScriptDataEqual::operator()(
+    const ByteSpan& lhs, const ByteSpan& rhs) const {
+  if (lhs.size() != rhs.size()) return false;
+  return (lhs.size() == 0) || (memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+}
+
 // -----------------------------------------------------------------------------
 // ScriptBuilder
 // -----------------------------------------------------------------------------
 ScriptBuilder& ScriptBuilder::AppendString(const std::string& message) {
-  if (ScriptOperator::IsValid(message)) {
-    return AppendOperator(ScriptOperator::Get(message));
+  const OpcodeName* entry = nullptr;
+  if (!message.empty()) entry = FindOpcodeName(message.data(), message.size());
+  if (entry != nullptr) {
+    return AppendOperator(entry->type);
   } else if ((message.length() > 2) && (message.substr(0, 2) == "0x")) {
     // to hex
     return AppendData(ByteData(message.substr(2)));
@@ -1330,6 +2292,31 @@ ScriptBuilder& ScriptBuilder::AppendString(const std::string& message) {
   }
 }
 
+ScriptBuilder& ScriptBuilder::AppendAsm(const std::string& asm_string) {
+  const char* text = asm_string.c_str();
+  size_t size = asm_string.size();
+  size_t offset = 0;
+  while (offset < size) {
+    if (isspace(static_cast<unsigned char>(text[offset])) != 0) {
+      ++offset;
+      continue;
+    }
+    size_t start = offset;
+    while ((offset < size) &&
+           (isspace(static_cast<unsigned char>(text[offset])) == 0)) {
+      ++offset;
+    }
+    // op_code is appended without a temporary string.
+    const OpcodeName* entry = FindOpcodeName(text + start, offset - start);
+    if (entry != nullptr) {
+      script_byte_array_.push_back(static_cast<uint8_t>(entry->type));
+    } else {
+      AppendString(asm_string.substr(start, offset - start));
+    }
+  }
+  return *this;
+}
+
 ScriptBuilder& ScriptBuilder::AppendOperator(ScriptType type) {
   script_byte_array_.push_back(type);
   return *this;
@@ -0,0 +1,2752 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_script_interpreter.cpp
+ *
+ * @brief Script interpreter implementation.
+ */
+#include "cfdcore/cfdcore_script_interpreter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_logger.h"
+#include "cfdcore/cfdcore_schnorrsig.h"
+#include "cfdcore_manager.h"      // NOLINT
+#include "cfdcore_thread_util.h"  // NOLINT
+#include "secp256k1.h"            // NOLINT
+#include "wally_core.h"           // NOLINT
+
+namespace cfd {
+namespace core {
+
+using logger::warn;
+
+// -----------------------------------------------------------------------------
+// File constants
+// -----------------------------------------------------------------------------
+//! stack element
+using StackData = std::vector<uint8_t>;
+//! max script element size
+constexpr size_t kMaxScriptElementSize = 520;
+//! max non-push operations per script
+constexpr int kMaxOpsPerScript = 201;
+//! max pubkeys per multisig
+constexpr int kMaxPubkeysPerMultisig = 20;
+//! max script size
+constexpr size_t kMaxScriptSize = 10000;
+//! max stack size (stack + altstack)
+constexpr size_t kMaxStackSize = 1000;
+//! locktime threshold (block height or unix time)
+constexpr int64_t kLocktimeThreshold = 500000000;
+//! sequence: final
+constexpr uint32_t kSequenceFinal = 0xffffffff;
+//! sequence: relative locktime disable flag
+constexpr uint32_t kSequenceLockTimeDisableFlag = (1U << 31);
+//! sequence: relative locktime type flag
+constexpr uint32_t kSequenceLockTimeTypeFlag = (1U << 22);
+//! sequence: relative locktime mask
+constexpr uint32_t kSequenceLockTimeMask = 0x0000ffff;
+//! witness v0 script hash size
+constexpr size_t kWitnessV0ScriptHashSize = 32;
+//! witness v0 key hash size
+constexpr size_t kWitnessV0KeyHashSize = 20;
+//! witness v1 taproot size
+constexpr size_t kWitnessV1TaprootSize = 32;
+//! annex tag
+constexpr uint8_t kAnnexTag = 0x50;
+//! taproot leaf version mask
+constexpr uint8_t kTaprootLeafMask = 0xfe;
+//! tapscript leaf version
+constexpr uint8_t kTaprootLeafTapscript = 0xc0;
+//! taproot control block base size
+constexpr size_t kTaprootControlBaseSize = 33;
+//! taproot control block node size
+constexpr size_t kTaprootControlNodeSize = 32;
+//! taproot control block max size
+constexpr size_t kTaprootControlMaxSize =
+    kTaprootControlBaseSize + kTaprootControlNodeSize * 128;
+//! validation weight per passed signature
+constexpr int64_t kValidationWeightPerSigopPassed = 50;
+//! validation weight offset
+constexpr int64_t kValidationWeightOffset = 50;
+//! default script number size
+constexpr size_t kDefaultScriptNumberSize = 4;
+//! locktime script number size
+constexpr size_t kLockTimeScriptNumberSize = 5;
+
+// -----------------------------------------------------------------------------
+// File functions
+// -----------------------------------------------------------------------------
+/**
+ * @brief set the error.
+ * @param[out] error    error
+ * @param[in] value     error value
+ * @return false
+ */
+static bool SetError(ScriptError* error, ScriptError value) {
+  if (error != nullptr) *error = value;
+  return false;
+}
+
+/**
+ * @brief set the success.
+ * @param[out] error    error
+ * @return true
+ */
+static bool SetSuccess(ScriptError* error) {
+  if (error != nullptr) *error = kScriptErrOk;
+  return true;
+}
+
+/**
+ * @brief Read the script operation.
+ * @details Same as the bitcoin core, the position is moved even if the
+ *     push data is broken.
+ * @param[in,out] position    read position
+ * @param[in] end             end of script
+ * @param[out] opcode         opcode
+ * @param[out] push_data      push data (nullable)
+ * @retval true   success
+ * @retval false  broken operation
+ */
+static bool GetScriptOp(
+    const uint8_t** position, const uint8_t* end, uint8_t* opcode,
+    StackData* push_data) {
+  const uint8_t* pc = *position;
+  *opcode = kOpInvalidOpCode;
+  if (push_data != nullptr) push_data->clear();
+  if (pc >= end) return false;
+
+  uint8_t op = *pc++;
+  if (op <= kOpPushData4) {
+    size_t size = 0;
+    if (op < kOpPushData1) {
+      size = op;
+    } else if (op == kOpPushData1) {
+      if (end - pc < 1) {
+        *position = pc;
+        return false;
+      }
+      size = *pc++;
+    } else if (op == kOpPushData2) {
+      if (end - pc < 2) {
+        *position = pc;
+        return false;
+      }
+      size = static_cast<size_t>(pc[0]) | (static_cast<size_t>(pc[1]) << 8);
+      pc += 2;
+    } else {
+      if (end - pc < 4) {
+        *position = pc;
+        return false;
+      }
+      size = static_cast<size_t>(pc[0]) | (static_cast<size_t>(pc[1]) << 8) |
+             (static_cast<size_t>(pc[2]) << 16) |
+             (static_cast<size_t>(pc[3]) << 24);
+      pc += 4;
+    }
+    if (static_cast<size_t>(end - pc) < size) {
+      *position = pc;
+      return false;
+    }
+    if (push_data != nullptr) push_data->assign(pc, pc + size);
+    pc += size;
+  }
+  *position = pc;
+  *opcode = op;
+  return true;
+}
+
+/**
+ * @brief Check if the script is push only.
+ * @param[in] script    script
+ * @retval true   push only
+ * @retval false  other
+ */
+static bool IsPushOnly(const StackData& script) {
+  const uint8_t* pc = script.data();
+  const uint8_t* end = pc + script.size();
+  uint8_t opcode = 0;
+  while (pc < end) {
+    if (!GetScriptOp(&pc, end, &opcode, nullptr)) return false;
+    if (opcode > kOp_16) return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Check if the script is P2SH.
+ * @param[in] script    script
+ * @retval true   P2SH
+ * @retval false  other
+ */
+static bool IsPayToScriptHash(const StackData& script) {
+  return (script.size() == 23) && (script[0] == kOpHash160) &&
+         (script[1] == 0x14) && (script[22] == kOpEqual);
+}
+
+/**
+ * @brief Check if the script is witness program.
+ * @param[in] script    script
+ * @param[out] version  witness version
+ * @param[out] program  witness program
+ * @retval true   witness program
+ * @retval false  other
+ */
+static bool IsWitnessProgram(
+    const StackData& script, int* version, StackData* program) {
+  if ((script.size() < 4) || (script.size() > 42)) return false;
+  if ((script[0] != kOp_0) && ((script[0] < kOp_1) || (script[0] > kOp_16))) {
+    return false;
+  }
+  if (static_cast<size_t>(script[1]) + 2 != script.size()) return false;
+  *version = (script[0] == kOp_0) ? 0 : (script[0] - (kOp_1 - 1));
+  program->assign(script.begin() + 2, script.end());
+  return true;
+}
+
+/**
+ * @brief Get the serialized push operation.
+ * @param[in] data    push data
+ * @return push operation
+ */
+static StackData GetPushOperation(const StackData& data) {
+  StackData result;
+  size_t size = data.size();
+  result.reserve(size + 5);
+  if (size < kOpPushData1) {
+    result.push_back(static_cast<uint8_t>(size));
+  } else if (size <= 0xff) {
+    result.push_back(kOpPushData1);
+    result.push_back(static_cast<uint8_t>(size));
+  } else if (size <= 0xffff) {
+    result.push_back(kOpPushData2);
+    result.push_back(static_cast<uint8_t>(size & 0xff));
+    result.push_back(static_cast<uint8_t>((size >> 8) & 0xff));
+  } else {
+    result.push_back(kOpPushData4);
+    for (size_t index = 0; index < 4; ++index) {
+      result.push_back(static_cast<uint8_t>((size >> (index * 8)) & 0xff));
+    }
+  }
+  result.insert(result.end(), data.begin(), data.end());
+  return result;
+}
+
+/**
+ * @brief Remove all matched operations from the script.
+ * @param[in,out] script    script
+ * @param[in] target        target operation
+ * @return removed count
+ */
+static int FindAndDelete(StackData* script, const StackData& target) {
+  int found = 0;
+  if (target.empty()) return found;
+
+  StackData result;
+  const uint8_t* begin = script->data();
+  const uint8_t* end = begin + script->size();
+  const uint8_t* pc = begin;
+  const uint8_t* pc2 = begin;
+  uint8_t opcode = 0;
+  do {
+    result.insert(result.end(), pc2, pc);
+    while ((static_cast<size_t>(end - pc) >= target.size()) &&
+           std::equal(target.begin(), target.end(), pc)) {
+      pc += target.size();
+      ++found;
+    }
+    pc2 = pc;
+  } while (GetScriptOp(&pc, end, &opcode, nullptr));
+
+  if (found > 0) {
+    result.insert(result.end(), pc2, end);
+    script->swap(result);
+  }
+  return found;
+}
+
+/**
+ * @brief Check if the push operation is minimal.
+ * @param[in] data      push data
+ * @param[in] opcode    opcode
+ * @retval true   minimal
+ * @retval false  other
+ */
+static bool CheckMinimalPush(const StackData& data, uint8_t opcode) {
+  if (data.empty()) {
+    return opcode == kOp_0;
+  } else if ((data.size() == 1) && (data[0] >= 1) && (data[0] <= 16)) {
+    return false;
+  } else if ((data.size() == 1) && (data[0] == 0x81)) {
+    return false;
+  } else if (data.size() < kOpPushData1) {
+    return opcode == data.size();
+  } else if (data.size() <= 0xff) {
+    return opcode == kOpPushData1;
+  } else if (data.size() <= 0xffff) {
+    return opcode == kOpPushData2;
+  }
+  return true;
+}
+
+/**
+ * @brief Convert the stack data to bool.
+ * @param[in] data    stack data
+ * @return bool value
+ */
+static bool CastToBool(const StackData& data) {
+  for (size_t index = 0; index < data.size(); ++index) {
+    if (data[index] != 0) {
+      // negative zero is false
+      if ((index == data.size() - 1) && (data[index] == 0x80)) return false;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Decode the script number.
+ * @param[in] data              stack data
+ * @param[in] require_minimal   require minimal encoding
+ * @param[in] max_size          max byte size
+ * @param[out] value            number
+ * @retval true   success
+ * @retval false  overflow or not minimal
+ */
+static bool DecodeScriptNumber(
+    const StackData& data, bool require_minimal, size_t max_size,
+    int64_t* value) {
+  if (data.size() > max_size) return false;
+  if (require_minimal && (!data.empty())) {
+    // The most significant byte must not be only the sign bit,
+    // except when the next byte uses the sign bit.
+    if ((data.back() & 0x7f) == 0) {
+      if ((data.size() <= 1) || ((data[data.size() - 2] & 0x80) == 0)) {
+        return false;
+      }
+    }
+  }
+  if (data.empty()) {
+    *value = 0;
+    return true;
+  }
+  int64_t result = 0;
+  for (size_t index = 0; index < data.size(); ++index) {
+    result |= static_cast<int64_t>(data[index]) << (8 * index);
+  }
+  if (data.back() & 0x80) {
+    int64_t sign_bit = static_cast<int64_t>(0x80) << (8 * (data.size() - 1));
+    *value = -(result & ~sign_bit);
+  } else {
+    *value = result;
+  }
+  return true;
+}
+
+/**
+ * @brief Encode the script number.
+ * @param[in] value   number
+ * @return stack data
+ */
+static StackData EncodeScriptNumber(int64_t value) {
+  StackData result;
+  if (value == 0) return result;
+
+  bool is_negative = value < 0;
+  uint64_t abs_value = (is_negative) ? ~static_cast<uint64_t>(value) + 1
+                                     : static_cast<uint64_t>(value);
+  while (abs_value != 0) {
+    result.push_back(static_cast<uint8_t>(abs_value & 0xff));
+    abs_value >>= 8;
+  }
+  if (result.back() & 0x80) {
+    result.push_back(is_negative ? 0x80 : 0);
+  } else if (is_negative) {
+    result.back() |= 0x80;
+  }
+  return result;
+}
+
+/**
+ * @brief Convert the script number to int. (clamp)
+ * @param[in] value   number
+ * @return int value
+ */
+static int ScriptNumberToInt(int64_t value) {
+  if (value > std::numeric_limits<int>::max()) {
+    return std::numeric_limits<int>::max();
+  } else if (value < std::numeric_limits<int>::min()) {
+    return std::numeric_limits<int>::min();
+  }
+  return static_cast<int>(value);
+}
+
+/**
+ * @brief Rotate left.
+ * @param[in] value   value
+ * @param[in] count   shift count
+ * @return rotated value
+ */
+static inline uint32_t RotateLeft(uint32_t value, int count) {
+  return (value << count) | (value >> (32 - count));
+}
+
+/**
+ * @brief Calculate the SHA-1 hash. (OP_SHA1 only)
+ * @param[in] data    data
+ * @return hash
+ */
+static StackData Sha1(const StackData& data) {
+  uint32_t state[5] = {
+      0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+  StackData message(data);
+  uint64_t bit_size = static_cast<uint64_t>(data.size()) * 8;
+  message.push_back(0x80);
+  while ((message.size() % 64) != 56) message.push_back(0);
+  for (int index = 7; index >= 0; --index) {
+    message.push_back(static_cast<uint8_t>(bit_size >> (index * 8)));
+  }
+
+  uint32_t words[80];
+  for (size_t offset = 0; offset < message.size(); offset += 64) {
+    for (size_t index = 0; index < 16; ++index) {
+      const uint8_t* ptr = &message[offset + index * 4];
+      words[index] = (static_cast<uint32_t>(ptr[0]) << 24) |
+                     (static_cast<uint32_t>(ptr[1]) << 16) |
+                     (static_cast<uint32_t>(ptr[2]) << 8) |
+                     static_cast<uint32_t>(ptr[3]);
+    }
+    for (size_t index = 16; index < 80; ++index) {
+      words[index] = RotateLeft(
+          words[index - 3] ^ words[index - 8] ^ words[index - 14] ^
+              words[index - 16],
+          1);
+    }
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    for (size_t index = 0; index < 80; ++index) {
+      uint32_t f;
+      uint32_t k;
+      if (index < 20) {
+        f = (b & c) | (~b & d);
+        k = 0x5a827999;
+      } else if (index < 40) {
+        f = b ^ c ^ d;
+        k = 0x6ed9eba1;
+      } else if (index < 60) {
+        f = (b & c) | (b & d) | (c & d);
+        k = 0x8f1bbcdc;
+      } else {
+        f = b ^ c ^ d;
+        k = 0xca62c1d6;
+      }
+      uint32_t temp = RotateLeft(a, 5) + f + e + k + words[index];
+      e = d;
+      d = c;
+      c = RotateLeft(b, 30);
+      b = a;
+      a = temp;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+  }
+
+  StackData result(20);
+  for (size_t index = 0; index < 5; ++index) {
+    result[index * 4] = static_cast<uint8_t>(state[index] >> 24);
+    result[index * 4 + 1] = static_cast<uint8_t>(state[index] >> 16);
+    result[index * 4 + 2] = static_cast<uint8_t>(state[index] >> 8);
+    result[index * 4 + 3] = static_cast<uint8_t>(state[index]);
+  }
+  return result;
+}
+
+/**
+ * @brief Check if the pubkey size matches the header. (CPubKey::IsValid)
+ * @param[in] pubkey    pubkey
+ * @retval true   valid
+ * @retval false  invalid
+ */
+static bool IsValidPubkeySize(const StackData& pubkey) {
+  if (pubkey.empty()) return false;
+  uint8_t header = pubkey[0];
+  if ((header == 2) || (header == 3)) return pubkey.size() == 33;
+  if ((header == 4) || (header == 6) || (header == 7)) {
+    return pubkey.size() == 65;
+  }
+  return false;
+}
+
+/**
+ * @brief Check if the pubkey is compressed or uncompressed.
+ * @param[in] pubkey    pubkey
+ * @retval true   valid
+ * @retval false  invalid
+ */
+static bool IsCompressedOrUncompressedPubkey(const StackData& pubkey) {
+  if (pubkey.size() < 33) return false;
+  if (pubkey[0] == 0x04) return pubkey.size() == 65;
+  if ((pubkey[0] == 0x02) || (pubkey[0] == 0x03)) return pubkey.size() == 33;
+  return false;
+}
+
+/**
+ * @brief Check if the pubkey is compressed.
+ * @param[in] pubkey    pubkey
+ * @retval true   compressed
+ * @retval false  other
+ */
+static bool IsCompressedPubkey(const StackData& pubkey) {
+  return (pubkey.size() == 33) && ((pubkey[0] == 0x02) || (pubkey[0] == 0x03));
+}
+
+/**
+ * @brief Check the strict DER encoding. (BIP66)
+ * @param[in] sig   signature (DER + sighash type)
+ * @retval true   valid
+ * @retval false  invalid
+ */
+static bool IsValidSignatureEncoding(const StackData& sig) {
+  // Format: 0x30 [total-length] 0x02 [R-length] [R] 0x02 [S-length] [S]
+  // [sighash]
+  if (sig.size() < 9) return false;
+  if (sig.size() > 73) return false;
+  if (sig[0] != 0x30) return false;
+  if (sig[1] != sig.size() - 3) return false;
+  size_t len_r = sig[3];
+  if (5 + len_r >= sig.size()) return false;
+  size_t len_s = sig[5 + len_r];
+  if ((len_r + len_s + 7) != sig.size()) return false;
+
+  if (sig[2] != 0x02) return false;
+  if (len_r == 0) return false;
+  if (sig[4] & 0x80) return false;
+  if ((len_r > 1) && (sig[4] == 0x00) && (!(sig[5] & 0x80))) return false;
+
+  if (sig[len_r + 4] != 0x02) return false;
+  if (len_s == 0) return false;
+  if (sig[len_r + 6] & 0x80) return false;
+  if ((len_s > 1) && (sig[len_r + 6] == 0x00) && (!(sig[len_r + 7] & 0x80))) {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Parse the DER signature with the lax rule.
+ * @details Port of ecdsa_signature_parse_der_lax on the bitcoin core.
+ *     The overflowed value is parsed as the zero signature.
+ * @param[in] input       DER signature (without sighash type)
+ * @param[in] input_size  DER signature size
+ * @param[out] signature  signature
+ * @retval true   success
+ * @retval false  invalid format
+ */
+static bool ParseDerSignatureLax(
+    const uint8_t* input, size_t input_size,
+    secp256k1_ecdsa_signature* signature) {
+  const secp256k1_context* context = GetSecp256k1Context();
+  size_t pos = 0;
+  uint8_t compact[64];
+  memset(compact, 0, sizeof(compact));
+  secp256k1_ecdsa_signature_parse_compact(context, signature, compact);
+
+  // Sequence tag byte
+  if ((pos == input_size) || (input[pos] != 0x30)) return false;
+  ++pos;
+  // Sequence length bytes
+  if (pos == input_size) return false;
+  size_t lenbyte = input[pos++];
+  if (lenbyte & 0x80) {
+    lenbyte -= 0x80;
+    if (lenbyte > input_size - pos) return false;
+    pos += lenbyte;
+  }
+
+  size_t positions[2] = {0, 0};
+  size_t lengths[2] = {0, 0};
+  for (size_t index = 0; index < 2; ++index) {
+    // Integer tag byte
+    if ((pos == input_size) || (input[pos] != 0x02)) return false;
+    ++pos;
+    // Integer length
+    if (pos == input_size) return false;
+    lenbyte = input[pos++];
+    size_t length = 0;
+    if (lenbyte & 0x80) {
+      lenbyte -= 0x80;
+      if (lenbyte > input_size - pos) return false;
+      while ((lenbyte > 0) && (input[pos] == 0)) {
+        ++pos;
+        --lenbyte;
+      }
+      if (lenbyte >= 4) return false;
+      while (lenbyte > 0) {
+        length = (length << 8) + input[pos];
+        ++pos;
+        --lenbyte;
+      }
+    } else {
+      length = lenbyte;
+    }
+    if (length > input_size - pos) return false;
+    positions[index] = pos;
+    lengths[index] = length;
+    pos += length;
+  }
+
+  bool is_overflow = false;
+  for (size_t index = 0; index < 2; ++index) {
+    // Ignore leading zeroes
+    while ((lengths[index] > 0) && (input[positions[index]] == 0)) {
+      --lengths[index];
+      ++positions[index];
+    }
+    if (lengths[index] > 32) {
+      is_overflow = true;
+    } else if (lengths[index] > 0) {
+      memcpy(
+          compact + (index * 32) + 32 - lengths[index],
+          input + positions[index], lengths[index]);
+    }
+  }
+  if (!is_overflow) {
+    is_overflow =
+        !secp256k1_ecdsa_signature_parse_compact(context, signature, compact);
+  }
+  if (is_overflow) {
+    memset(compact, 0, sizeof(compact));
+    secp256k1_ecdsa_signature_parse_compact(context, signature, compact);
+  }
+  return true;
+}
+
+/**
+ * @brief Check if the DER signature has the low S value.
+ * @param[in] sig   signature (DER + sighash type)
+ * @retval true   low S
+ * @retval false  high S or invalid
+ */
+static bool IsLowDerSignature(const StackData& sig) {
+  secp256k1_ecdsa_signature signature;
+  if (!ParseDerSignatureLax(sig.data(), sig.size() - 1, &signature)) {
+    return false;
+  }
+  return !secp256k1_ecdsa_signature_normalize(
+      GetSecp256k1Context(), nullptr, &signature);
+}
+
+/**
+ * @brief Check the signature encoding.
+ * @param[in] sig     signature (DER + sighash type)
+ * @param[in] flags   verify flags
+ * @param[out] error  error
+ * @retval true   valid
+ * @retval false  invalid
+ */
+static bool CheckSignatureEncoding(
+    const StackData& sig, uint32_t flags, ScriptError* error) {
+  // Empty signature. Not strictly DER encoded, but allowed to provide a
+  // compact way to provide an invalid signature for use with CHECK(MULTI)SIG
+  if (sig.empty()) return true;
+  if ((flags & (kScriptVerifyDerSig | kScriptVerifyLowS |
+                kScriptVerifyStrictEnc)) &&
+      (!IsValidSignatureEncoding(sig))) {
+    return SetError(error, kScriptErrSigDer);
+  }
+  if ((flags & kScriptVerifyLowS) && (!IsLowDerSignature(sig))) {
+    return SetError(error, kScriptErrSigHighS);
+  }
+  if (flags & kScriptVerifyStrictEnc) {
+    uint8_t hash_type = sig.back() & ~(0x80);
+    if ((hash_type < kSigHashAll) || (hash_type > kSigHashSingle)) {
+      return SetError(error, kScriptErrSigHashType);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Check the pubkey encoding.
+ * @param[in] pubkey    pubkey
+ * @param[in] flags     verify flags
+ * @param[in] version   signature version
+ * @param[out] error    error
+ * @retval true   valid
+ * @retval false  invalid
+ */
+static bool CheckPubkeyEncoding(
+    const StackData& pubkey, uint32_t flags, SigVersion version,
+    ScriptError* error) {
+  if ((flags & kScriptVerifyStrictEnc) &&
+      (!IsCompressedOrUncompressedPubkey(pubkey))) {
+    return SetError(error, kScriptErrPubkeyType);
+  }
+  // Only compressed keys are accepted in segwit
+  if ((flags & kScriptVerifyWitnessPubkeyType) &&
+      (version == kSigVersionWitnessV0) && (!IsCompressedPubkey(pubkey))) {
+    return SetError(error, kScriptErrWitnessPubkeyType);
+  }
+  return true;
+}
+
+/**
+ * @brief Verify the ECDSA signature.
+ * @param[in] der         DER signature
+ * @param[in] der_size    DER signature size
+ * @param[in] pubkey      pubkey
+ * @param[in] sighash     signature hash
+ * @retval true   valid
+ * @retval false  invalid
+ */
+static bool VerifyEcdsaSignature(
+    const uint8_t* der, size_t der_size, const StackData& pubkey,
+    const ByteData256& sighash) {
+  const secp256k1_context* context = GetSecp256k1Context();
+  secp256k1_pubkey pubkey_obj;
+  if (!secp256k1_ec_pubkey_parse(
+          context, &pubkey_obj, pubkey.data(), pubkey.size())) {
+    return false;
+  }
+  secp256k1_ecdsa_signature signature;
+  if (!ParseDerSignatureLax(der, der_size, &signature)) return false;
+  // libsecp256k1 only accepts the low S value.
+  secp256k1_ecdsa_signature_normalize(context, &signature, &signature);
+  const std::vector<uint8_t>& hash = sighash.GetBytes();
+  return secp256k1_ecdsa_verify(
+             context, &signature, hash.data(), &pubkey_obj) == 1;
+}
+
+/**
+ * @brief Calculate the witness stack serialize size.
+ * @param[in] stack   witness stack
+ * @return serialize size
+ */
+static int64_t GetWitnessSerializeSize(const std::vector<StackData>& stack) {
+  Serializer builder;
+  builder.AddVariableInt(stack.size());
+  int64_t size = builder.GetWriteSize();
+  for (const auto& item : stack) {
+    Serializer item_size;
+    item_size.AddVariableInt(item.size());
+    size += item_size.GetWriteSize() + static_cast<int64_t>(item.size());
+  }
+  return size;
+}
+
+/**
+ * @brief Calculate the tapleaf hash.
+ * @param[in] leaf_version  leaf version
+ * @param[in] script        script
+ * @return tapleaf hash
+ */
+static ByteData256 ComputeTapleafHash(
+    uint8_t leaf_version, const StackData& script) {
+  Serializer builder = Serializer::CreateTaggedSha256Sink("TapLeaf");
+  builder.AddDirectByte(leaf_version);
+  builder.AddVariableBuffer(
+      script.data(), static_cast<uint32_t>(script.size()));
+  return builder.OutputSha256();
+}
+
+/**
+ * @brief Verify the taproot commitment.
+ * @param[in] control         control block
+ * @param[in] program         witness program
+ * @param[in] tapleaf_hash    tapleaf hash
+ * @retval true   valid
+ * @retval false  invalid
+ */
+static bool VerifyTaprootCommitment(
+    const StackData& control, const StackData& program,
+    const ByteData256& tapleaf_hash) {
+  const size_t path_length =
+      (control.size() - kTaprootControlBaseSize) / kTaprootControlNodeSize;
+  std::vector<uint8_t> node_hash = tapleaf_hash.GetBytes();
+  for (size_t index = 0; index < path_length; ++index) {
+    const uint8_t* node = control.data() + kTaprootControlBaseSize +
+                          (kTaprootControlNodeSize * index);
+    Serializer builder = Serializer::CreateTaggedSha256Sink("TapBranch");
+    if (std::lexicographical_compare(
+            node_hash.begin(), node_hash.end(), node,
+            node + kTaprootControlNodeSize)) {
+      builder.AddDirectBytes(node_hash.data(), kTaprootControlNodeSize);
+      builder.AddDirectBytes(node, kTaprootControlNodeSize);
+    } else {
+      builder.AddDirectBytes(node, kTaprootControlNodeSize);
+      builder.AddDirectBytes(node_hash.data(), kTaprootControlNodeSize);
+    }
+    node_hash = builder.OutputSha256().GetBytes();
+  }
+
+  try {
+    Serializer tweak_builder = Serializer::CreateTaggedSha256Sink("TapTweak");
+    tweak_builder.AddDirectBytes(control.data() + 1, kByteData256Length);
+    tweak_builder.AddDirectBytes(node_hash.data(), kByteData256Length);
+    SchnorrPubkey internal_pubkey(
+        ByteData(control.data() + 1, kByteData256Length));
+    SchnorrPubkey output_pubkey{ByteData(program)};
+    return output_pubkey.IsTweaked(
+        internal_pubkey, tweak_builder.OutputSha256(), (control[0] & 1) != 0);
+  } catch (const CfdException&) {
+    return false;
+  }
+}
+
+/**
+ * @brief Check the ECDSA signature. (CHECKSIG before tapscript)
+ * @param[in] sig               signature
+ * @param[in] pubkey            pubkey
+ * @param[in] code_begin        begin of script code
+ * @param[in] code_end          end of script code
+ * @param[in] flags             verify flags
+ * @param[in] checker           signature checker
+ * @param[in] version           signature version
+ * @param[out] error            error
+ * @param[out] is_success       signature check result
+ * @retval true   continue
+ * @retval false  script error
+ */
+static bool EvalChecksigPreTapscript(
+    const StackData& sig, const StackData& pubkey, const uint8_t* code_begin,
+    const uint8_t* code_end, uint32_t flags, const SignatureChecker& checker,
+    SigVersion version, ScriptError* error, bool* is_success) {
+  // Subset of script starting at the most recent codeseparator
+  StackData script_code(code_begin, code_end);
+  // Drop the signature in pre-segwit scripts but not segwit scripts
+  if (version == kSigVersionBase) {
+    int found = FindAndDelete(&script_code, GetPushOperation(sig));
+    if ((found > 0) && (flags & kScriptVerifyConstScriptCode)) {
+      return SetError(error, kScriptErrSigFindAndDelete);
+    }
+  }
+  if ((!CheckSignatureEncoding(sig, flags, error)) ||
+      (!CheckPubkeyEncoding(pubkey, flags, version, error))) {
+    return false;
+  }
+  *is_success = checker.CheckEcdsaSignature(sig, pubkey, script_code, version);
+  if ((!*is_success) && (flags & kScriptVerifyNullFail) && (!sig.empty())) {
+    return SetError(error, kScriptErrSigNullFail);
+  }
+  return true;
+}
+
+/**
+ * @brief Check the schnorr signature. (CHECKSIG on tapscript)
+ * @param[in] sig               signature
+ * @param[in] pubkey            pubkey
+ * @param[in,out] exec_data     execution data
+ * @param[in] flags             verify flags
+ * @param[in] checker           signature checker
+ * @param[in] version           signature version
+ * @param[out] error            error
+ * @param[out] is_success       signature check result
+ * @retval true   continue
+ * @retval false  script error
+ */
+static bool EvalChecksigTapscript(
+    const StackData& sig, const StackData& pubkey,
+    ScriptExecutionData* exec_data, uint32_t flags,
+    const SignatureChecker& checker, SigVersion version, ScriptError* error,
+    bool* is_success) {
+  *is_success = !sig.empty();
+  if (*is_success) {
+    // Implement the sigops/witnesssize ratio test.
+    exec_data->validation_weight_left -= kValidationWeightPerSigopPassed;
+    if (exec_data->validation_weight_left < 0) {
+      return SetError(error, kScriptErrTapscriptValidationWeight);
+    }
+  }
+  if (pubkey.empty()) {
+    return SetError(error, kScriptErrPubkeyType);
+  } else if (pubkey.size() == SchnorrPubkey::kSchnorrPubkeySize) {
+    if ((*is_success) && (!checker.CheckSchnorrSignature(
+                             sig, pubkey, version, *exec_data, error))) {
+      return false;
+    }
+  } else if (flags & kScriptVerifyDiscourageUpgradablePubkeyType) {
+    return SetError(error, kScriptErrDiscourageUpgradablePubkeyType);
+  }
+  return true;
+}
+
+/**
+ * @brief Execute the script.
+ * @param[in,out] stack         script stack
+ * @param[in] script            script
+ * @param[in] flags             verify flags
+ * @param[in] checker           signature checker
+ * @param[in] version           signature version
+ * @param[in,out] exec_data     execution data
+ * @param[out] error            error
+ * @retval true   success
+ * @retval false  failed
+ */
+static bool EvalScriptInternal(
+    std::vector<StackData>* stack, const StackData& script, uint32_t flags,
+    const SignatureChecker& checker, SigVersion version,
+    ScriptExecutionData* exec_data, ScriptError* error) {
+  static const StackData kFalseData;
+  static const StackData kTrueData(1, 1);
+
+  std::vector<StackData>& st = *stack;
+  const uint8_t* pc = script.data();
+  const uint8_t* pend = pc + script.size();
+  const uint8_t* code_begin = pc;
+  uint8_t opcode = 0;
+  StackData push_value;
+  std::vector<bool> exec_stack;
+  size_t false_count = 0;
+  std::vector<StackData> altstack;
+  SetError(error, kScriptErrUnknown);
+  if ((version != kSigVersionTapscript) && (script.size() > kMaxScriptSize)) {
+    return SetError(error, kScriptErrScriptSize);
+  }
+  int op_count = 0;
+  bool require_minimal = (flags & kScriptVerifyMinimalData) != 0;
+  uint32_t opcode_pos = 0;
+  exec_data->tap_script.code_separator_position = 0xffffffff;
+
+  auto top = [&st](int index) -> StackData& {
+    return st[st.size() + index];
+  };
+  auto pop = [&st]() { st.pop_back(); };
+
+  for (; pc < pend; ++opcode_pos) {
+    bool is_exec = (false_count == 0);
+
+    // Read instruction
+    if (!GetScriptOp(&pc, pend, &opcode, &push_value)) {
+      return SetError(error, kScriptErrBadOpcode);
+    }
+    if (push_value.size() > kMaxScriptElementSize) {
+      return SetError(error, kScriptErrPushSize);
+    }
+    if (version != kSigVersionTapscript) {
+      // Note how OP_RESERVED does not count towards the opcode limit.
+      if ((opcode > kOp_16) && (++op_count > kMaxOpsPerScript)) {
+        return SetError(error, kScriptErrOpCount);
+      }
+    }
+    switch (opcode) {
+      case kOpCat:
+      case kOpSubstr:
+      case kOpLeft:
+      case kOpRight:
+      case kOpInvert:
+      case kOpAnd:
+      case kOpOr:
+      case kOpXor:
+      case kOp2Mul:
+      case kOp2Div:
+      case kOpMul:
+      case kOpDiv:
+      case kOpMod:
+      case kOpLShift:
+      case kOpRShift:
+        // Disabled opcodes (CVE-2010-5137).
+        return SetError(error, kScriptErrDisabledOpcode);
+      default:
+        break;
+    }
+    // With SCRIPT_VERIFY_CONST_SCRIPTCODE, OP_CODESEPARATOR in non-segwit
+    // script is rejected even in an unexecuted branch
+    if ((opcode == kOpCodeSeparator) && (version == kSigVersionBase) &&
+        (flags & kScriptVerifyConstScriptCode)) {
+      return SetError(error, kScriptErrOpCodeSeparator);
+    }
+
+    if (is_exec && (opcode <= kOpPushData4)) {
+      if (require_minimal && (!CheckMinimalPush(push_value, opcode))) {
+        return SetError(error, kScriptErrMinimalData);
+      }
+      st.push_back(push_value);
+    } else if (is_exec || ((kOpIf <= opcode) && (opcode <= kOpEndIf))) {
+      switch (opcode) {
+        // Push value
+        case kOp1Negate:
+        case kOp_1:
+        case kOp_2:
+        case kOp_3:
+        case kOp_4:
+        case kOp_5:
+        case kOp_6:
+        case kOp_7:
+        case kOp_8:
+        case kOp_9:
+        case kOp_10:
+        case kOp_11:
+        case kOp_12:
+        case kOp_13:
+        case kOp_14:
+        case kOp_15:
+        case kOp_16: {
+          // ( -- value)
+          int64_t value = static_cast<int>(opcode) - (kOp_1 - 1);
+          st.push_back(EncodeScriptNumber(value));
+          break;
+        }
+
+        // Control
+        case kOpNop:
+          break;
+
+        case kOpCheckLockTimeVerify: {
+          if (!(flags & kScriptVerifyCheckLockTimeVerify)) {
+            // not enabled; treat as a NOP2
+            break;
+          }
+          if (st.size() < 1) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          // Note that elsewhere numeric opcodes are limited to operands in
+          // the range -2**31+1 to 2**31-1, however it is legal for opcodes to
+          // produce results exceeding that range.
+          int64_t lock_time = 0;
+          if (!DecodeScriptNumber(
+                  top(-1), require_minimal, kLockTimeScriptNumberSize,
+                  &lock_time)) {
+            return SetError(error, kScriptErrUnknown);
+          }
+          if (lock_time < 0) {
+            return SetError(error, kScriptErrNegativeLocktime);
+          }
+          if (!checker.CheckLockTime(lock_time)) {
+            return SetError(error, kScriptErrUnsatisfiedLocktime);
+          }
+          break;
+        }
+
+        case kOpCheckSequenceVerify: {
+          if (!(flags & kScriptVerifyCheckSequenceVerify)) {
+            // not enabled; treat as a NOP3
+            break;
+          }
+          if (st.size() < 1) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          int64_t sequence = 0;
+          if (!DecodeScriptNumber(
+                  top(-1), require_minimal, kLockTimeScriptNumberSize,
+                  &sequence)) {
+            return SetError(error, kScriptErrUnknown);
+          }
+          if (sequence < 0) {
+            return SetError(error, kScriptErrNegativeLocktime);
+          }
+          // To provide for future soft-fork extensibility, if the operand
+          // has the disabled lock-time flag set, CHECKSEQUENCEVERIFY
+          // behaves as a NOP.
+          if ((sequence & kSequenceLockTimeDisableFlag) != 0) break;
+          if (!checker.CheckSequence(sequence)) {
+            return SetError(error, kScriptErrUnsatisfiedLocktime);
+          }
+          break;
+        }
+
+        case kOpNop1:
+        case kOpNop4:
+        case kOpNop5:
+        case kOpNop6:
+        case kOpNop7:
+        case kOpNop8:
+        case kOpNop9:
+        case kOpNop10:
+          if (flags & kScriptVerifyDiscourageUpgradableNops) {
+            return SetError(error, kScriptErrDiscourageUpgradableNops);
+          }
+          break;
+
+        case kOpIf:
+        case kOpNotIf: {
+          // <expression> if [statements] [else [statements]] endif
+          bool value = false;
+          if (is_exec) {
+            if (st.size() < 1) {
+              return SetError(error, kScriptErrUnbalancedConditional);
+            }
+            const StackData& data = top(-1);
+            // Tapscript requires minimal IF/NOTIF inputs as a consensus
+            // rule.
+            if (version == kSigVersionTapscript) {
+              // The input argument to the OP_IF and OP_NOTIF opcodes must
+              // be either exactly 0 (the empty vector) or exactly 1 (the
+              // one-byte vector with value 1).
+              if ((data.size() > 1) ||
+                  ((data.size() == 1) && (data[0] != 1))) {
+                return SetError(error, kScriptErrTapscriptMinimalIf);
+              }
+            }
+            // Under witness v0 rules it is only a policy rule, enabled
+            // through SCRIPT_VERIFY_MINIMALIF.
+            if ((version == kSigVersionWitnessV0) &&
+                (flags & kScriptVerifyMinimalIf)) {
+              if ((data.size() > 1) ||
+                  ((data.size() == 1) && (data[0] != 1))) {
+                return SetError(error, kScriptErrMinimalIf);
+              }
+            }
+            value = CastToBool(data);
+            if (opcode == kOpNotIf) value = !value;
+            pop();
+          }
+          exec_stack.push_back(value);
+          if (!value) ++false_count;
+          break;
+        }
+
+        case kOpElse: {
+          if (exec_stack.empty()) {
+            return SetError(error, kScriptErrUnbalancedConditional);
+          }
+          if (exec_stack.back()) {
+            ++false_count;
+          } else {
+            --false_count;
+          }
+          exec_stack.back() = !exec_stack.back();
+          break;
+        }
+
+        case kOpEndIf: {
+          if (exec_stack.empty()) {
+            return SetError(error, kScriptErrUnbalancedConditional);
+          }
+          if (!exec_stack.back()) --false_count;
+          exec_stack.pop_back();
+          break;
+        }
+
+        case kOpVerify: {
+          // (true -- ) or
+          // (false -- false) and return
+          if (st.size() < 1) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          if (!CastToBool(top(-1))) {
+            return SetError(error, kScriptErrVerify);
+          }
+          pop();
+          break;
+        }
+
+        case kOpReturn:
+          return SetError(error, kScriptErrOpReturn);
+
+        // Stack ops
+        case kOpToAltStack: {
+          if (st.size() < 1) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          altstack.push_back(top(-1));
+          pop();
+          break;
+        }
+
+        case kOpFromAltStack: {
+          if (altstack.size() < 1) {
+            return SetError(error, kScriptErrInvalidAltstackOperation);
+          }
+          st.push_back(altstack.back());
+          altstack.pop_back();
+          break;
+        }
+
+        case kOp2Drop: {
+          // (x1 x2 -- )
+          if (st.size() < 2) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          pop();
+          pop();
+          break;
+        }
+
+        case kOp2Dup: {
+          // (x1 x2 -- x1 x2 x1 x2)
+          if (st.size() < 2) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          StackData data1 = top(-2);
+          StackData data2 = top(-1);
+          st.push_back(data1);
+          st.push_back(data2);
+          break;
+        }
+
+        case kOp3Dup: {
+          // (x1 x2 x3 -- x1 x2 x3 x1 x2 x3)
+          if (st.size() < 3) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          StackData data1 = top(-3);
+          StackData data2 = top(-2);
+          StackData data3 = top(-1);
+          st.push_back(data1);
+          st.push_back(data2);
+          st.push_back(data3);
+          break;
+        }
+
+        case kOp2Over: {
+          // (x1 x2 x3 x4 -- x1 x2 x3 x4 x1 x2)
+          if (st.size() < 4) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          StackData data1 = top(-4);
+          StackData data2 = top(-3);
+          st.push_back(data1);
+          st.push_back(data2);
+          break;
+        }
+
+        case kOp2Rot: {
+          // (x1 x2 x3 x4 x5 x6 -- x3 x4 x5 x6 x1 x2)
+          if (st.size() < 6) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          StackData data1 = top(-6);
+          StackData data2 = top(-5);
+          st.erase(st.end() - 6, st.end() - 4);
+          st.push_back(data1);
+          st.push_back(data2);
+          break;
+        }
+
+        case kOp2Swap: {
+          // (x1 x2 x3 x4 -- x3 x4 x1 x2)
+          if (st.size() < 4) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          std::swap(top(-4), top(-2));
+          std::swap(top(-3), top(-1));
+          break;
+        }
+
+        case kOpIfDup: {
+          // (x - 0 | x x)
+          if (st.size() < 1) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          StackData data = top(-1);
+          if (CastToBool(data)) st.push_back(data);
+          break;
+        }
+
+        case kOpDepth: {
+          // -- stacksize
+          st.push_back(EncodeScriptNumber(static_cast<int64_t>(st.size())));
+          break;
+        }
+
+        case kOpDrop: {
+          // (x -- )
+          if (st.size() < 1) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          pop();
+          break;
+        }
+
+        case kOpDup: {
+          // (x -- x x)
+          if (st.size() < 1) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          StackData data = top(-1);
+          st.push_back(data);
+          break;
+        }
+
+        case kOpNip: {
+          // (x1 x2 -- x2)
+          if (st.size() < 2) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          st.erase(st.end() - 2);
+          break;
+        }
+
+        case kOpOver: {
+          // (x1 x2 -- x1 x2 x1)
+          if (st.size() < 2) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          StackData data = top(-2);
+          st.push_back(data);
+          break;
+        }
+
+        case kOpPick:
+        case kOpRoll: {
+          // (xn ... x2 x1 x0 n - xn ... x2 x1 x0 xn)
+          // (xn ... x2 x1 x0 n - ... x2 x1 x0 xn)
+          if (st.size() < 2) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          int64_t number = 0;
+          if (!DecodeScriptNumber(
+                  top(-1), require_minimal, kDefaultScriptNumberSize,
+                  &number)) {
+            return SetError(error, kScriptErrUnknown);
+          }
+          int count = ScriptNumberToInt(number);
+          pop();
+          if ((count < 0) || (count >= static_cast<int>(st.size()))) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          StackData data = top(-count - 1);
+          if (opcode == kOpRoll) st.erase(st.end() - count - 1);
+          st.push_back(data);
+          break;
+        }
+
+        case kOpRot: {
+          // (x1 x2 x3 -- x2 x3 x1)
+          //  x2 x1 x3  after first swap
+          //  x2 x3 x1  after second swap
+          if (st.size() < 3) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          std::swap(top(-3), top(-2));
+          std::swap(top(-2), top(-1));
+          break;
+        }
+
+        case kOpSwap: {
+          // (x1 x2 -- x2 x1)
+          if (st.size() < 2) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          std::swap(top(-2), top(-1));
+          break;
+        }
+
+        case kOpTuck: {
+          // (x1 x2 -- x2 x1 x2)
+          if (st.size() < 2) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          StackData data = top(-1);
+          st.insert(st.end() - 2, data);
+          break;
+        }
+
+        case kOpSize: {
+          // (in -- in size)
+          if (st.size() < 1) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          st.push_back(
+              EncodeScriptNumber(static_cast<int64_t>(top(-1).size())));
+          break;
+        }
+
+        // Bitwise logic
+        case kOpEqual:
+        case kOpEqualVerify: {
+          // (x1 x2 - bool)
+          if (st.size() < 2) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          bool is_equal = (top(-2) == top(-1));
+          pop();
+          pop();
+          st.push_back(is_equal ? kTrueData : kFalseData);
+          if (opcode == kOpEqualVerify) {
+            if (!is_equal) return SetError(error, kScriptErrEqualVerify);
+            pop();
+          }
+          break;
+        }
+
+        // Numeric
+        case kOp1Add:
+        case kOp1Sub:
+        case kOpNegate:
+        case kOpAbs:
+        case kOpNot:
+        case kOp0NotEqual: {
+          // (in -- out)
+          if (st.size() < 1) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          int64_t number = 0;
+          if (!DecodeScriptNumber(
+                  top(-1), require_minimal, kDefaultScriptNumberSize,
+                  &number)) {
+            return SetError(error, kScriptErrUnknown);
+          }
+          switch (opcode) {
+            case kOp1Add:
+              number += 1;
+              break;
+            case kOp1Sub:
+              number -= 1;
+              break;
+            case kOpNegate:
+              number = -number;
+              break;
+            case kOpAbs:
+              if (number < 0) number = -number;
+              break;
+            case kOpNot:
+              number = (number == 0) ? 1 : 0;
+              break;
+            case kOp0NotEqual:
+              number = (number != 0) ? 1 : 0;
+              break;
+            default:
+              break;
+          }
+          pop();
+          st.push_back(EncodeScriptNumber(number));
+          break;
+        }
+
+        case kOpAdd:
+        case kOpSub:
+        case kOpBoolAnd:
+        case kOpBoolOr:
+        case kOpNumEqual:
+        case kOpNumEqualVerify:
+        case kOpNumNotEqual:
+        case kOpLessThan:
+        case kOpGreaterThan:
+        case kOpLessThanOrEqual:
+        case kOpGreaterThanOrEqual:
+        case kOpMin:
+        case kOpMax: {
+          // (x1 x2 -- out)
+          if (st.size() < 2) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          int64_t number1 = 0;
+          int64_t number2 = 0;
+          if ((!DecodeScriptNumber(
+                  top(-2), require_minimal, kDefaultScriptNumberSize,
+                  &number1)) ||
+              (!DecodeScriptNumber(
+                  top(-1), require_minimal, kDefaultScriptNumberSize,
+                  &number2))) {
+            return SetError(error, kScriptErrUnknown);
+          }
+          int64_t number = 0;
+          switch (opcode) {
+            case kOpAdd:
+              number = number1 + number2;
+              break;
+            case kOpSub:
+              number = number1 - number2;
+              break;
+            case kOpBoolAnd:
+              number = ((number1 != 0) && (number2 != 0)) ? 1 : 0;
+              break;
+            case kOpBoolOr:
+              number = ((number1 != 0) || (number2 != 0)) ? 1 : 0;
+              break;
+            case kOpNumEqual:
+            case kOpNumEqualVerify:
+              number = (number1 == number2) ? 1 : 0;
+              break;
+            case kOpNumNotEqual:
+              number = (number1 != number2) ? 1 : 0;
+              break;
+            case kOpLessThan:
+              number = (number1 < number2) ? 1 : 0;
+              break;
+            case kOpGreaterThan:
+              number = (number1 > number2) ? 1 : 0;
+              break;
+            case kOpLessThanOrEqual:
+              number = (number1 <= number2) ? 1 : 0;
+              break;
+            case kOpGreaterThanOrEqual:
+              number = (number1 >= number2) ? 1 : 0;
+              break;
+            case kOpMin:
+              number = (number1 < number2) ? number1 : number2;
+              break;
+            case kOpMax:
+              number = (number1 > number2) ? number1 : number2;
+              break;
+            default:
+              break;
+          }
+          pop();
+          pop();
+          st.push_back(EncodeScriptNumber(number));
+
+          if (opcode == kOpNumEqualVerify) {
+            if (!CastToBool(top(-1))) {
+              return SetError(error, kScriptErrNumEqualVerify);
+            }
+            pop();
+          }
+          break;
+        }
+
+        case kOpWithIn: {
+          // (x min max -- out)
+          if (st.size() < 3) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          int64_t number1 = 0;
+          int64_t number2 = 0;
+          int64_t number3 = 0;
+          if ((!DecodeScriptNumber(
+                  top(-3), require_minimal, kDefaultScriptNumberSize,
+                  &number1)) ||
+              (!DecodeScriptNumber(
+                  top(-2), require_minimal, kDefaultScriptNumberSize,
+                  &number2)) ||
+              (!DecodeScriptNumber(
+                  top(-1), require_minimal, kDefaultScriptNumberSize,
+                  &number3))) {
+            return SetError(error, kScriptErrUnknown);
+          }
+          bool value = (number2 <= number1) && (number1 < number3);
+          pop();
+          pop();
+          pop();
+          st.push_back(value ? kTrueData : kFalseData);
+          break;
+        }
+
+        // Crypto
+        case kOpRipemd:
+        case kOpSha1:
+        case kOpSha256:
+        case kOpHash160:
+        case kOpHash256: {
+          // (in -- hash)
+          if (st.size() < 1) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          const StackData& data = top(-1);
+          StackData hash;
+          if (opcode == kOpRipemd) {
+            hash = HashUtil::Ripemd160(data).GetBytes();
+          } else if (opcode == kOpSha1) {
+            hash = Sha1(data);
+          } else if (opcode == kOpSha256) {
+            hash = HashUtil::Sha256(data).GetBytes();
+          } else if (opcode == kOpHash160) {
+            hash = HashUtil::Hash160(data).GetBytes();
+          } else {
+            hash = HashUtil::Sha256D(data).GetBytes();
+          }
+          pop();
+          st.push_back(hash);
+          break;
+        }
+
+        case kOpCodeSeparator: {
+          // If SCRIPT_VERIFY_CONST_SCRIPTCODE flag is set, use of
+          // OP_CODESEPARATOR is rejected in pre-segwit script, even in an
+          // unexecuted branch (this is checked above the opcode case
+          // statement).
+
+          // Hash starts after the code separator
+          code_begin = pc;
+          exec_data->tap_script.code_separator_position = opcode_pos;
+          break;
+        }
+
+        case kOpCheckSig:
+        case kOpCheckSigVerify: {
+          // (sig pubkey -- bool)
+          if (st.size() < 2) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          const StackData& sig = top(-2);
+          const StackData& pubkey = top(-1);
+          bool is_success = true;
+          bool is_continue = false;
+          if (version == kSigVersionTapscript) {
+            is_continue = EvalChecksigTapscript(
+                sig, pubkey, exec_data, flags, checker, version, error,
+                &is_success);
+          } else {
+            is_continue = EvalChecksigPreTapscript(
+                sig, pubkey, code_begin, pend, flags, checker, version, error,
+                &is_success);
+          }
+          if (!is_continue) return false;
+          pop();
+          pop();
+          st.push_back(is_success ? kTrueData : kFalseData);
+          if (opcode == kOpCheckSigVerify) {
+            if (!is_success) return SetError(error, kScriptErrCheckSigVerify);
+            pop();
+          }
+          break;
+        }
+
+        case kOpCheckSigAdd: {
+          // OP_CHECKSIGADD is only available in Tapscript
+          if (version != kSigVersionTapscript) {
+            return SetError(error, kScriptErrBadOpcode);
+          }
+          // (sig num pubkey -- num)
+          if (st.size() < 3) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          int64_t number = 0;
+          if (!DecodeScriptNumber(
+                  top(-2), require_minimal, kDefaultScriptNumberSize,
+                  &number)) {
+            return SetError(error, kScriptErrUnknown);
+          }
+          bool is_success = true;
+          if (!EvalChecksigTapscript(
+                  top(-3), top(-1), exec_data, flags, checker, version, error,
+                  &is_success)) {
+            return false;
+          }
+          pop();
+          pop();
+          pop();
+          st.push_back(EncodeScriptNumber(number + (is_success ? 1 : 0)));
+          break;
+        }
+
+        case kOpCheckMultiSig:
+        case kOpCheckMultiSigVerify: {
+          if (version == kSigVersionTapscript) {
+            return SetError(error, kScriptErrTapscriptCheckMultisig);
+          }
+          // ([sig ...] num_of_signatures [pubkey ...] num_of_pubkeys -- bool)
+          int index = 1;
+          if (static_cast<int>(st.size()) < index) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          int64_t number = 0;
+          if (!DecodeScriptNumber(
+                  top(-index), require_minimal, kDefaultScriptNumberSize,
+                  &number)) {
+            return SetError(error, kScriptErrUnknown);
+          }
+          int key_count = ScriptNumberToInt(number);
+          if ((key_count < 0) || (key_count > kMaxPubkeysPerMultisig)) {
+            return SetError(error, kScriptErrPubkeyCount);
+          }
+          op_count += key_count;
+          if (op_count > kMaxOpsPerScript) {
+            return SetError(error, kScriptErrOpCount);
+          }
+          int key_index = ++index;
+          // key_index2 is the position of last non-signature item in the
+          // stack. Top stack item = 1.
+          // With SCRIPT_VERIFY_NULLFAIL, this is used for cleanup if
+          // operation fails.
+          int key_index2 = key_count + 2;
+          index += key_count;
+          if (static_cast<int>(st.size()) < index) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          if (!DecodeScriptNumber(
+                  top(-index), require_minimal, kDefaultScriptNumberSize,
+                  &number)) {
+            return SetError(error, kScriptErrUnknown);
+          }
+          int sig_count = ScriptNumberToInt(number);
+          if ((sig_count < 0) || (sig_count > key_count)) {
+            return SetError(error, kScriptErrSigCount);
+          }
+          int sig_index = ++index;
+          index += sig_count;
+          if (static_cast<int>(st.size()) < index) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+
+          // Subset of script starting at the most recent codeseparator
+          StackData script_code(code_begin, pend);
+
+          // Drop the signature in pre-segwit scripts but not segwit scripts
+          for (int k = 0; k < sig_count; ++k) {
+            if (version == kSigVersionBase) {
+              int found = FindAndDelete(
+                  &script_code, GetPushOperation(top(-sig_index - k)));
+              if ((found > 0) && (flags & kScriptVerifyConstScriptCode)) {
+                return SetError(error, kScriptErrSigFindAndDelete);
+              }
+            }
+          }
+
+          bool is_success = true;
+          while (is_success && (sig_count > 0)) {
+            const StackData& sig = top(-sig_index);
+            const StackData& pubkey = top(-key_index);
+            // Note how this makes the exact order of pubkey/signature
+            // evaluation distinguishable by CHECKMULTISIG NOT if the
+            // STRICTENC flag is set.
+            if ((!CheckSignatureEncoding(sig, flags, error)) ||
+                (!CheckPubkeyEncoding(pubkey, flags, version, error))) {
+              return false;
+            }
+            // Check signature
+            if (checker.CheckEcdsaSignature(
+                    sig, pubkey, script_code, version)) {
+              ++sig_index;
+              --sig_count;
+            }
+            ++key_index;
+            --key_count;
+            // If there are more signatures left than keys left, then too
+            // many signatures have failed. Exit early, without checking any
+            // further signatures.
+            if (sig_count > key_count) is_success = false;
+          }
+
+          // Clean up stack of actual arguments
+          while (index-- > 1) {
+            // If the operation failed, we require that all signatures must
+            // be empty vector
+            if ((!is_success) && (flags & kScriptVerifyNullFail) &&
+                (key_index2 == 0) && (!top(-1).empty())) {
+              return SetError(error, kScriptErrSigNullFail);
+            }
+            if (key_index2 > 0) --key_index2;
+            pop();
+          }
+
+          // A bug causes CHECKMULTISIG to consume one extra argument whose
+          // contents were not checked in any way.
+          //
+          // Unfortunately this is a potential source of mutability, so
+          // optionally verify it is exactly equal to zero prior to removing
+          // it from the stack.
+          if (st.size() < 1) {
+            return SetError(error, kScriptErrInvalidStackOperation);
+          }
+          if ((flags & kScriptVerifyNullDummy) && (!top(-1).empty())) {
+            return SetError(error, kScriptErrSigNullDummy);
+          }
+          pop();
+
+          st.push_back(is_success ? kTrueData : kFalseData);
+          if (opcode == kOpCheckMultiSigVerify) {
+            if (!is_success) {
+              return SetError(error, kScriptErrCheckMultisigVerify);
+            }
+            pop();
+          }
+          break;
+        }
+
+        default:
+          return SetError(error, kScriptErrBadOpcode);
+      }
+    }
+
+    // Size limits
+    if ((st.size() + altstack.size()) > kMaxStackSize) {
+      return SetError(error, kScriptErrStackSize);
+    }
+  }
+
+  if (!exec_stack.empty()) {
+    return SetError(error, kScriptErrUnbalancedConditional);
+  }
+  return SetSuccess(error);
+}
+
+/**
+ * @brief Execute the witness script.
+ * @param[in] stack_data        witness stack (without script)
+ * @param[in] script            witness script
+ * @param[in] flags             verify flags
+ * @param[in] version           signature version
+ * @param[in] checker           signature checker
+ * @param[in,out] exec_data     execution data
+ * @param[out] error            error
+ * @retval true   success
+ * @retval false  failed
+ */
+static bool ExecuteWitnessScript(
+    const std::vector<StackData>& stack_data, const StackData& script,
+    uint32_t flags, SigVersion version, const SignatureChecker& checker,
+    ScriptExecutionData* exec_data, ScriptError* error) {
+  std::vector<StackData> stack(stack_data);
+
+  if (version == kSigVersionTapscript) {
+    // OP_SUCCESSx processing overrides everything, including stack element
+    // size limits
+    const uint8_t* pc = script.data();
+    const uint8_t* end = pc + script.size();
+    uint8_t opcode = 0;
+    while (pc < end) {
+      if (!GetScriptOp(&pc, end, &opcode, nullptr)) {
+        // Note how this condition would not be reached if an unknown
+        // OP_SUCCESSx was found
+        return SetError(error, kScriptErrBadOpcode);
+      }
+      // New opcodes will be listed here. May use a different sigversion to
+      // modify existing opcodes.
+      if (ScriptOperator::IsOpSuccess(static_cast<ScriptType>(opcode))) {
+        if (flags & kScriptVerifyDiscourageOpSuccess) {
+          return SetError(error, kScriptErrDiscourageOpSuccess);
+        }
+        return SetSuccess(error);
+      }
+    }
+
+    // Tapscript enforces initial stack size limits (altstack is empty here)
+    if (stack.size() > kMaxStackSize) {
+      return SetError(error, kScriptErrStackSize);
+    }
+  }
+
+  // Disallow stack item size > MAX_SCRIPT_ELEMENT_SIZE in witness stack
+  for (const auto& item : stack) {
+    if (item.size() > kMaxScriptElementSize) {
+      return SetError(error, kScriptErrPushSize);
+    }
+  }
+
+  // Run the script interpreter.
+  if (!EvalScriptInternal(
+          &stack, script, flags, checker, version, exec_data, error)) {
+    return false;
+  }
+
+  // Scripts inside witness implicitly require cleanstack behaviour
+  if (stack.size() != 1) return SetError(error, kScriptErrCleanStack);
+  if (!CastToBool(stack.back())) return SetError(error, kScriptErrEvalFalse);
+  return true;
+}
+
+/**
+ * @brief Verify the witness program.
+ * @param[in] witness     witness stack
+ * @param[in] version     witness version
+ * @param[in] program     witness program
+ * @param[in] flags       verify flags
+ * @param[in] checker     signature checker
+ * @param[out] error      error
+ * @param[in] is_p2sh     P2SH-wrapped
+ * @retval true   valid
+ * @retval false  invalid
+ */
+static bool VerifyWitnessProgram(
+    const std::vector<StackData>& witness, int version,
+    const StackData& program, uint32_t flags, const SignatureChecker& checker,
+    ScriptError* error, bool is_p2sh) {
+  std::vector<StackData> stack(witness);
+  ScriptExecutionData exec_data;
+
+  if (version == 0) {
+    if (program.size() == kWitnessV0ScriptHashSize) {
+      // BIP141 P2WSH: 32-byte witness v0 program (which encodes
+      // SHA256(script))
+      if (stack.empty()) {
+        return SetError(error, kScriptErrWitnessProgramWitnessEmpty);
+      }
+      StackData script = stack.back();
+      stack.pop_back();
+      if (HashUtil::Sha256(script).GetBytes() != program) {
+        return SetError(error, kScriptErrWitnessProgramMismatch);
+      }
+      return ExecuteWitnessScript(
+          stack, script, flags, kSigVersionWitnessV0, checker, &exec_data,
+          error);
+    } else if (program.size() == kWitnessV0KeyHashSize) {
+      // BIP141 P2WPKH: 20-byte witness v0 program (which encodes
+      // Hash160(pubkey))
+      if (stack.size() != 2) {
+        return SetError(error, kScriptErrWitnessProgramMismatch);
+      }
+      StackData script = {kOpDup, kOpHash160, 0x14};
+      script.insert(script.end(), program.begin(), program.end());
+      script.push_back(kOpEqualVerify);
+      script.push_back(kOpCheckSig);
+      return ExecuteWitnessScript(
+          stack, script, flags, kSigVersionWitnessV0, checker, &exec_data,
+          error);
+    }
+    return SetError(error, kScriptErrWitnessProgramWrongLength);
+  } else if (
+      (version == 1) && (program.size() == kWitnessV1TaprootSize) &&
+      (!is_p2sh)) {
+    // BIP341 Taproot: 32-byte non-P2SH witness v1 program (which encodes a
+    // P2C-tweaked pubkey)
+    if (!(flags & kScriptVerifyTaproot)) return SetSuccess(error);
+    if (stack.empty()) {
+      return SetError(error, kScriptErrWitnessProgramWitnessEmpty);
+    }
+    if ((stack.size() >= 2) && (!stack.back().empty()) &&
+        (stack.back()[0] == kAnnexTag)) {
+      // Drop annex (this is non-standard; see IsWitnessStandard)
+      exec_data.annex = ByteData(stack.back());
+      exec_data.has_annex = true;
+      stack.pop_back();
+    }
+    if (stack.size() == 1) {
+      // Key path spending (stack size is 1 after removing optional annex)
+      if (!checker.CheckSchnorrSignature(
+              stack.front(), program, kSigVersionTaproot, exec_data, error)) {
+        return false;
+      }
+      return SetSuccess(error);
+    }
+
+    // Script path spending (stack size is >1 after removing optional annex)
+    StackData control = stack.back();
+    stack.pop_back();
+    StackData script = stack.back();
+    stack.pop_back();
+    if ((control.size() < kTaprootControlBaseSize) ||
+        (control.size() > kTaprootControlMaxSize) ||
+        (((control.size() - kTaprootControlBaseSize) %
+          kTaprootControlNodeSize) != 0)) {
+      return SetError(error, kScriptErrTaprootWrongControlSize);
+    }
+    uint8_t leaf_version = control[0] & kTaprootLeafMask;
+    exec_data.tap_script.tap_leaf_hash =
+        ComputeTapleafHash(leaf_version, script);
+    if (!VerifyTaprootCommitment(
+            control, program, exec_data.tap_script.tap_leaf_hash)) {
+      return SetError(error, kScriptErrWitnessProgramMismatch);
+    }
+    if (leaf_version == kTaprootLeafTapscript) {
+      // Tapscript (leaf version 0xc0)
+      exec_data.validation_weight_left =
+          GetWitnessSerializeSize(witness) + kValidationWeightOffset;
+      return ExecuteWitnessScript(
+          stack, script, flags, kSigVersionTapscript, checker, &exec_data,
+          error);
+    }
+    if (flags & kScriptVerifyDiscourageUpgradableTaprootVersion) {
+      return SetError(error, kScriptErrDiscourageUpgradableTaprootVersion);
+    }
+    return SetSuccess(error);
+  }
+
+  if (flags & kScriptVerifyDiscourageUpgradableWitnessProgram) {
+    return SetError(error, kScriptErrDiscourageUpgradableWitnessProgram);
+  }
+  // Other version/size/p2sh combinations return true for future softfork
+  // compatibility
+  return true;
+}
+
+/**
+ * @brief Verify the unlocking script, witness and locking script.
+ * @param[in] unlocking_script  unlocking script
+ * @param[in] locking_script    locking script
+ * @param[in] witness           witness stack
+ * @param[in] flags             verify flags
+ * @param[in] checker           signature checker
+ * @param[out] error            error
+ * @retval true   valid
+ * @retval false  invalid
+ */
+static bool VerifyScriptInternal(
+    const StackData& unlocking_script, const StackData& locking_script,
+    const std::vector<StackData>& witness, uint32_t flags,
+    const SignatureChecker& checker, ScriptError* error) {
+  bool has_witness = false;
+  SetError(error, kScriptErrUnknown);
+
+  if ((flags & kScriptVerifySigPushOnly) && (!IsPushOnly(unlocking_script))) {
+    return SetError(error, kScriptErrSigPushOnly);
+  }
+
+  // scriptSig and scriptPubKey must be evaluated sequentially on the same
+  // stack rather than being simply concatenated (see CVE-2010-5141)
+  std::vector<StackData> stack;
+  std::vector<StackData> stack_copy;
+  ScriptExecutionData exec_data;
+  if (!EvalScriptInternal(
+          &stack, unlocking_script, flags, checker, kSigVersionBase,
+          &exec_data, error)) {
+    return false;
+  }
+  if (flags & kScriptVerifyP2sh) stack_copy = stack;
+  if (!EvalScriptInternal(
+          &stack, locking_script, flags, checker, kSigVersionBase, &exec_data,
+          error)) {
+    return false;
+  }
+  if (stack.empty()) return SetError(error, kScriptErrEvalFalse);
+  if (!CastToBool(stack.back())) return SetError(error, kScriptErrEvalFalse);
+
+  // Bare witness programs
+  int witness_version = 0;
+  StackData witness_program;
+  if (flags & kScriptVerifyWitness) {
+    if (IsWitnessProgram(locking_script, &witness_version, &witness_program)) {
+      has_witness = true;
+      if (!unlocking_script.empty()) {
+        // The scriptSig must be _exactly_ CScript(), otherwise we
+        // reintroduce malleability.
+        return SetError(error, kScriptErrWitnessMalleated);
+      }
+      if (!VerifyWitnessProgram(
+              witness, witness_version, witness_program, flags, checker,
+              error, false)) {
+        return false;
+      }
+      // Bypass the cleanstack check at the end. The actual stack is
+      // obviously not clean for witness programs.
+      stack.resize(1);
+    }
+  }
+
+  // Additional validation for spend-to-script-hash transactions:
+  if ((flags & kScriptVerifyP2sh) && IsPayToScriptHash(locking_script)) {
+    // scriptSig must be literals-only or validation fails
+    if (!IsPushOnly(unlocking_script)) {
+      return SetError(error, kScriptErrSigPushOnly);
+    }
+
+    // Restore stack.
+    stack.swap(stack_copy);
+
+    // stack cannot be empty here, because if it was the
+    // P2SH  HASH <> EQUAL  scriptPubKey would be evaluated with
+    // an empty stack and the EvalScript above would return false.
+    StackData redeem_script = stack.back();
+    stack.pop_back();
+
+    if (!EvalScriptInternal(
+            &stack, redeem_script, flags, checker, kSigVersionBase,
+            &exec_data, error)) {
+      return false;
+    }
+    if (stack.empty()) return SetError(error, kScriptErrEvalFalse);
+    if (!CastToBool(stack.back())) return SetError(error, kScriptErrEvalFalse);
+
+    // P2SH witness program
+    if ((flags & kScriptVerifyWitness) &&
+        IsWitnessProgram(redeem_script, &witness_version, &witness_program)) {
+      has_witness = true;
+      if (unlocking_script != GetPushOperation(redeem_script)) {
+        // The scriptSig must be _exactly_ a single push of the
+        // redeemScript. Otherwise we introduce malleability.
+        return SetError(error, kScriptErrWitnessMalleatedP2sh);
+      }
+      if (!VerifyWitnessProgram(
+              witness, witness_version, witness_program, flags, checker,
+              error, true)) {
+        return false;
+      }
+      // Bypass the cleanstack check at the end. The actual stack is
+      // obviously not clean for witness programs.
+      stack.resize(1);
+    }
+  }
+
+  // The CLEANSTACK check is only performed after potential P2SH evaluation,
+  // as the non-P2SH evaluation of a P2SH script will obviously not result in
+  // a clean stack (the P2SH inputs remain). The same holds for witness
+  // evaluation.
+  if ((flags & kScriptVerifyCleanStack) && (stack.size() != 1)) {
+    return SetError(error, kScriptErrCleanStack);
+  }
+
+  if ((flags & kScriptVerifyWitness) && (!has_witness) &&
+      (!witness.empty())) {
+    return SetError(error, kScriptErrWitnessUnexpected);
+  }
+  return SetSuccess(error);
+}
+
+/**
+ * @brief Check the verify flags.
+ * @param[in] flags   verify flags
+ */
+static void CheckVerifyFlags(uint32_t flags) {
+  // Disallow CLEANSTACK without P2SH, as otherwise a switch
+  // CLEANSTACK->P2SH+CLEANSTACK would be possible, which is not a softfork
+  // (and P2SH should be one).
+  if ((flags & kScriptVerifyCleanStack) &&
+      ((!(flags & kScriptVerifyP2sh)) || (!(flags & kScriptVerifyWitness)))) {
+    warn(CFD_LOG_SOURCE, "CLEANSTACK flag requires P2SH and WITNESS.");
+    throw CfdException(
+        kCfdIllegalArgumentError,
+        "Invalid verify flags. CLEANSTACK requires P2SH and WITNESS.");
+  }
+  // We can't check for correct unexpected witness data if P2SH was off, so
+  // require that WITNESS implies P2SH.
+  if ((flags & kScriptVerifyWitness) && (!(flags & kScriptVerifyP2sh))) {
+    warn(CFD_LOG_SOURCE, "WITNESS flag requires P2SH.");
+    throw CfdException(
+        kCfdIllegalArgumentError,
+        "Invalid verify flags. WITNESS requires P2SH.");
+  }
+}
+
+/**
+ * @brief Convert the witness stack.
+ * @param[in] witness   witness
+ * @return witness stack
+ */
+static std::vector<StackData> ConvertWitnessStack(
+    const ScriptWitness& witness) {
+  std::vector<StackData> result;
+  const std::vector<ByteData> witness_stack = witness.GetWitness();
+  result.reserve(witness_stack.size());
+  for (const auto& item : witness_stack) {
+    result.push_back(item.GetBytes());
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+// SigHashContext
+// -----------------------------------------------------------------------------
+SigHashContext::SigHashContext(
+    const Transaction& transaction, const std::vector<TxOut>& utxo_list)
+    : version_(transaction.GetVersion()),
+      lock_time_(transaction.GetLockTime()),
+      txin_list_(transaction.GetTxInList()),
+      txout_list_(transaction.GetTxOutList()),
+      utxo_list_(utxo_list) {
+  if ((!utxo_list_.empty()) && (utxo_list_.size() != txin_list_.size())) {
+    warn(
+        CFD_LOG_SOURCE, "unmatch utxo count. txin[{}] utxo[{}]",
+        txin_list_.size(), utxo_list_.size());
+    throw CfdException(kCfdIllegalArgumentError, "unmatch utxo list count.");
+  }
+
+  Serializer prevouts = Serializer::CreateSha256Sink();
+  Serializer sequences = Serializer::CreateSha256Sink();
+  Serializer outputs = Serializer::CreateSha256Sink();
+  for (const auto& txin : txin_list_) {
+    prevouts.AddDirectBytes(txin.GetTxid().GetData());
+    prevouts.AddDirectNumber(txin.GetVout());
+    sequences.AddDirectNumber(txin.GetSequence());
+  }
+  for (const auto& txout : txout_list_) {
+    outputs.AddDirectNumber(txout.GetValue().GetSatoshiValue());
+    outputs.AddVariableBuffer(txout.GetLockingScript().GetData());
+  }
+  prevouts_hash_ = prevouts.OutputSha256();
+  sequences_hash_ = sequences.OutputSha256();
+  outputs_hash_ = outputs.OutputSha256();
+  prevouts_hash256_ = HashUtil::Sha256(prevouts_hash_);
+  sequences_hash256_ = HashUtil::Sha256(sequences_hash_);
+  outputs_hash256_ = HashUtil::Sha256(outputs_hash_);
+
+  if (HasUtxo()) {
+    Serializer amounts = Serializer::CreateSha256Sink();
+    Serializer scripts = Serializer::CreateSha256Sink();
+    for (const auto& utxo : utxo_list_) {
+      amounts.AddDirectNumber(utxo.GetValue().GetSatoshiValue());
+      scripts.AddVariableBuffer(utxo.GetLockingScript().GetData());
+    }
+    amounts_hash_ = amounts.OutputSha256();
+    scripts_hash_ = scripts.OutputSha256();
+  }
+}
+
+uint32_t SigHashContext::GetTxInCount() const {
+  return static_cast<uint32_t>(txin_list_.size());
+}
+
+const TxInReference& SigHashContext::GetTxIn(uint32_t txin_index) const {
+  CheckTxInIndex(txin_index);
+  return txin_list_[txin_index];
+}
+
+bool SigHashContext::HasUtxo() const {
+  return (!txin_list_.empty()) && (!utxo_list_.empty());
+}
+
+const TxOut& SigHashContext::GetUtxo(uint32_t txin_index) const {
+  CheckTxInIndex(txin_index);
+  if (!HasUtxo()) {
+    warn(CFD_LOG_SOURCE, "utxo list is empty.");
+    throw CfdException(kCfdIllegalStateError, "utxo list is empty.");
+  }
+  return utxo_list_[txin_index];
+}
+
+int32_t SigHashContext::GetVersion() const { return version_; }
+
+uint32_t SigHashContext::GetLockTime() const { return lock_time_; }
+
+ByteData256 SigHashContext::GetSignatureHash(
+    uint32_t txin_index, const ByteData& script_code,
+    const SigHashType& sighash_type, const Amount& value,
+    WitnessVersion version) const {
+  CheckTxInIndex(txin_index);
+  if (version >= WitnessVersion::kVersion1) {
+    warn(CFD_LOG_SOURCE, "unsupport witness version on ECDSA.");
+    throw CfdException(
+        kCfdIllegalArgumentError, "unsupport witness version on ECDSA.");
+  }
+  uint32_t hash_type = sighash_type.GetSigHashFlag();
+  uint32_t base_type = hash_type & 0x1f;
+  bool is_anyone_can_pay = (hash_type & 0x80) != 0;
+  bool is_single = (base_type == kSigHashSingle);
+  bool is_none = (base_type == kSigHashNone);
+  const TxInReference& txin = txin_list_[txin_index];
+
+  if (version == WitnessVersion::kVersion0) {
+    // BIP143
+    ByteData256 outputs_hash;
+    if ((!is_single) && (!is_none)) {
+      outputs_hash = outputs_hash256_;
+    } else if (is_single && (txin_index < txout_list_.size())) {
+      Serializer output = Serializer::CreateSha256Sink();
+      const TxOutReference& txout = txout_list_[txin_index];
+      output.AddDirectNumber(txout.GetValue().GetSatoshiValue());
+      output.AddVariableBuffer(txout.GetLockingScript().GetData());
+      outputs_hash = output.OutputSha256d();
+    }
+    Serializer builder = Serializer::CreateSha256Sink();
+    builder.AddDirectNumber(static_cast<uint32_t>(version_));
+    builder.AddDirectBytes(
+        (!is_anyone_can_pay) ? prevouts_hash256_ : ByteData256());
+    builder.AddDirectBytes(
+        ((!is_anyone_can_pay) && (!is_single) && (!is_none))
+            ? sequences_hash256_
+            : ByteData256());
+    builder.AddDirectBytes(txin.GetTxid().GetData());
+    builder.AddDirectNumber(txin.GetVout());
+    builder.AddVariableBuffer(script_code);
+    builder.AddDirectNumber(value.GetSatoshiValue());
+    builder.AddDirectNumber(txin.GetSequence());
+    builder.AddDirectBytes(outputs_hash);
+    builder.AddDirectNumber(lock_time_);
+    builder.AddDirectNumber(hash_type);
+    return builder.OutputSha256d();
+  }
+
+  // legacy
+  if (is_single && (txin_index >= txout_list_.size())) {
+    // SIGHASH_SINGLE bug: the hash is one.
+    std::vector<uint8_t> one(kByteData256Length);
+    one[0] = 1;
+    return ByteData256(one);
+  }
+
+  Serializer builder = Serializer::CreateSha256Sink();
+  builder.AddDirectNumber(static_cast<uint32_t>(version_));
+  uint32_t input_count =
+      (is_anyone_can_pay) ? 1 : static_cast<uint32_t>(txin_list_.size());
+  builder.AddVariableInt(input_count);
+  for (uint32_t index = 0; index < input_count; ++index) {
+    uint32_t input_index = (is_anyone_can_pay) ? txin_index : index;
+    const TxInReference& input = txin_list_[input_index];
+    builder.AddDirectBytes(input.GetTxid().GetData());
+    builder.AddDirectNumber(input.GetVout());
+    if (input_index != txin_index) {
+      builder.AddVariableInt(0);
+    } else {
+      // Serialize the script code without OP_CODESEPARATOR.
+      const std::vector<uint8_t>& code = script_code.GetBytes();
+      const uint8_t* begin = code.data();
+      const uint8_t* end = begin + code.size();
+      const uint8_t* pc = begin;
+      uint8_t opcode = 0;
+      uint32_t separator_count = 0;
+      while (GetScriptOp(&pc, end, &opcode, nullptr)) {
+        if (opcode == kOpCodeSeparator) ++separator_count;
+      }
+      builder.AddVariableInt(code.size() - separator_count);
+      pc = begin;
+      while (GetScriptOp(&pc, end, &opcode, nullptr)) {
+        if (opcode == kOpCodeSeparator) {
+          builder.AddDirectBytes(
+              begin, static_cast<uint32_t>(pc - begin - 1));
+          begin = pc;
+        }
+      }
+      if (begin != end) {
+        builder.AddDirectBytes(begin, static_cast<uint32_t>(pc - begin));
+      }
+    }
+    if ((input_index != txin_index) && (is_single || is_none)) {
+      builder.AddDirectNumber(static_cast<uint32_t>(0));
+    } else {
+      builder.AddDirectNumber(input.GetSequence());
+    }
+  }
+
+  uint32_t output_count = static_cast<uint32_t>(txout_list_.size());
+  if (is_none) {
+    output_count = 0;
+  } else if (is_single) {
+    output_count = txin_index + 1;
+  }
+  builder.AddVariableInt(output_count);
+  for (uint32_t index = 0; index < output_count; ++index) {
+    if (is_single && (index != txin_index)) {
+      builder.AddDirectNumber(static_cast<int64_t>(-1));
+      builder.AddVariableInt(0);
+    } else {
+      const TxOutReference& txout = txout_list_[index];
+      builder.AddDirectNumber(txout.GetValue().GetSatoshiValue());
+      builder.AddVariableBuffer(txout.GetLockingScript().GetData());
+    }
+  }
+  builder.AddDirectNumber(lock_time_);
+  builder.AddDirectNumber(hash_type);
+  return builder.OutputSha256d();
+}
+
+ByteData256 SigHashContext::GetSchnorrSignatureHash(
+    uint32_t txin_index, const SigHashType& sighash_type,
+    const TapScriptData* script_data, const ByteData& annex) const {
+  CheckTxInIndex(txin_index);
+  if (!HasUtxo()) {
+    warn(CFD_LOG_SOURCE, "utxo list is empty.");
+    throw CfdException(kCfdIllegalArgumentError, "not enough utxo list.");
+  }
+  uint8_t hash_type = static_cast<uint8_t>(sighash_type.GetSigHashFlag());
+  if (!((hash_type <= 0x03) || ((hash_type >= 0x81) && (hash_type <= 0x83)))) {
+    warn(CFD_LOG_SOURCE, "Invalid sighash type on segwit v1.");
+    throw CfdException(
+        kCfdIllegalArgumentError, "Invalid sighash type on segwit v1.");
+  }
+  // Default (no sighash byte) is equivalent to SIGHASH_ALL
+  uint8_t output_type = (hash_type == 0) ? kSigHashAll : (hash_type & 0x03);
+  bool is_anyone_can_pay = (hash_type & 0x80) != 0;
+  if ((output_type == kSigHashSingle) && (txin_index >= txout_list_.size())) {
+    warn(CFD_LOG_SOURCE, "SIGHASH_SINGLE output is not found.");
+    throw CfdException(kCfdOutOfRangeError, "vout out_of_range error.");
+  }
+  bool has_tap_script =
+      (script_data != nullptr) && (!script_data->tap_leaf_hash.IsEmpty());
+
+  Serializer builder = Serializer::CreateTaggedSha256Sink("TapSighash");
+  builder.AddDirectByte(0);  // EPOCH
+  builder.AddDirectByte(hash_type);
+  builder.AddDirectNumber(static_cast<uint32_t>(version_));
+  builder.AddDirectNumber(lock_time_);
+  if (!is_anyone_can_pay) {
+    builder.AddDirectBytes(prevouts_hash_);
+    builder.AddDirectBytes(amounts_hash_);
+    builder.AddDirectBytes(scripts_hash_);
+    builder.AddDirectBytes(sequences_hash_);
+  }
+  if (output_type == kSigHashAll) builder.AddDirectBytes(outputs_hash_);
+
+  uint8_t spend_type =
+      ((has_tap_script ? 1 : 0) << 1) + (annex.IsEmpty() ? 0 : 1);
+  builder.AddDirectByte(spend_type);
+  if (is_anyone_can_pay) {
+    const TxInReference& txin = txin_list_[txin_index];
+    const TxOut& utxo = utxo_list_[txin_index];
+    builder.AddDirectBytes(txin.GetTxid().GetData());
+    builder.AddDirectNumber(txin.GetVout());
+    builder.AddDirectNumber(utxo.GetValue().GetSatoshiValue());
+    builder.AddVariableBuffer(utxo.GetLockingScript().GetData());
+    builder.AddDirectNumber(txin.GetSequence());
+  } else {
+    builder.AddDirectNumber(txin_index);
+  }
+  if (!annex.IsEmpty()) {
+    Serializer annex_builder = Serializer::CreateSha256Sink();
+    annex_builder.AddVariableBuffer(annex);
+    builder.AddDirectBytes(annex_builder.OutputSha256());
+  }
+  if (output_type == kSigHashSingle) {
+    const TxOutReference& txout = txout_list_[txin_index];
+    Serializer output = Serializer::CreateSha256Sink();
+    output.AddDirectNumber(txout.GetValue().GetSatoshiValue());
+    output.AddVariableBuffer(txout.GetLockingScript().GetData());
+    builder.AddDirectBytes(output.OutputSha256());
+  }
+  if (has_tap_script) {
+    builder.AddDirectBytes(script_data->tap_leaf_hash);
+    builder.AddDirectByte(0);  // key_version
+    builder.AddDirectNumber(script_data->code_separator_position);
+  }
+  return builder.OutputSha256();
+}
+
+void SigHashContext::CheckTxInIndex(uint32_t txin_index) const {
+  if (txin_list_.size() <= txin_index) {
+    warn(CFD_LOG_SOURCE, "vin[{}] out_of_range.", txin_index);
+    throw CfdException(kCfdOutOfRangeError, "vin out_of_range error.");
+  }
+}
+
+// -----------------------------------------------------------------------------
+// SignatureChecker
+// -----------------------------------------------------------------------------
+bool SignatureChecker::CheckEcdsaSignature(
+    const std::vector<uint8_t>&, const std::vector<uint8_t>&,
+    const std::vector<uint8_t>&, SigVersion) const {
+  return false;
+}
+
+bool SignatureChecker::CheckSchnorrSignature(
+    const std::vector<uint8_t>&, const std::vector<uint8_t>&, SigVersion,
+    const ScriptExecutionData&, ScriptError*) const {
+  return false;
+}
+
+bool SignatureChecker::CheckLockTime(int64_t) const { return false; }
+
+bool SignatureChecker::CheckSequence(int64_t) const { return false; }
+
+// -----------------------------------------------------------------------------
+// TransactionSignatureChecker
+// -----------------------------------------------------------------------------
+TransactionSignatureChecker::TransactionSignatureChecker(
+    const SigHashContext* context, uint32_t txin_index)
+    : context_(context), txin_index_(txin_index) {
+  if (context_ == nullptr) {
+    warn(CFD_LOG_SOURCE, "context is null.");
+    throw CfdException(kCfdIllegalArgumentError, "context is null.");
+  }
+  context_->GetTxIn(txin_index_);  // check index
+}
+
+bool TransactionSignatureChecker::CheckEcdsaSignature(
+    const std::vector<uint8_t>& signature, const std::vector<uint8_t>& pubkey,
+    const std::vector<uint8_t>& script_code, SigVersion version) const {
+  if (!IsValidPubkeySize(pubkey)) return false;
+  // Hash type is one byte tacked on to the end of the signature
+  if (signature.empty()) return false;
+  uint8_t hash_type = signature.back();
+  // Witness sighashes need the amount.
+  if ((version == kSigVersionWitnessV0) && (!context_->HasUtxo())) {
+    return false;
+  }
+
+  ByteData256 sighash;
+  try {
+    Amount value;
+    WitnessVersion witness_version = WitnessVersion::kVersionNone;
+    if (version == kSigVersionWitnessV0) {
+      value = context_->GetUtxo(txin_index_).GetValue();
+      witness_version = WitnessVersion::kVersion0;
+    }
+    sighash = context_->GetSignatureHash(
+        txin_index_, ByteData(script_code), SigHashType::Create(hash_type),
+        value, witness_version);
+  } catch (const CfdException&) {
+    return false;
+  }
+  return VerifyEcdsaSignature(
+      signature.data(), signature.size() - 1, pubkey, sighash);
+}
+
+bool TransactionSignatureChecker::CheckSchnorrSignature(
+    const std::vector<uint8_t>& signature, const std::vector<uint8_t>& pubkey,
+    SigVersion version, const ScriptExecutionData& exec_data,
+    ScriptError* error) const {
+  // Note that in Tapscript evaluation, empty signatures are treated specially
+  // (invalid signature that does not abort script execution). In other
+  // contexts, they are invalid like every other signature with size
+  // different from 64 or 65.
+  if ((signature.size() != SchnorrSignature::kSchnorrSignatureSize) &&
+      (signature.size() != SchnorrSignature::kSchnorrSignatureSize + 1)) {
+    return SetError(error, kScriptErrSchnorrSigSize);
+  }
+  uint8_t hash_type = 0;
+  if (signature.size() == SchnorrSignature::kSchnorrSignatureSize + 1) {
+    hash_type = signature.back();
+    if (hash_type == 0) return SetError(error, kScriptErrSchnorrSigHashType);
+  }
+
+  ByteData256 sighash;
+  try {
+    const TapScriptData* script_data = nullptr;
+    if (version == kSigVersionTapscript) script_data = &exec_data.tap_script;
+    sighash = context_->GetSchnorrSignatureHash(
+        txin_index_, SigHashType::Create(hash_type), script_data,
+        (exec_data.has_annex) ? exec_data.annex : ByteData());
+  } catch (const CfdException&) {
+    return SetError(error, kScriptErrSchnorrSigHashType);
+  }
+
+  try {
+    SchnorrPubkey schnorr_pubkey{ByteData(pubkey)};
+    SchnorrSignature schnorr_signature(ByteData(
+        signature.data(),
+        static_cast<uint32_t>(SchnorrSignature::kSchnorrSignatureSize)));
+    if (schnorr_pubkey.Verify(schnorr_signature, sighash)) return true;
+  } catch (const CfdException&) {
+    // invalid pubkey
+  }
+  return SetError(error, kScriptErrSchnorrSig);
+}
+
+bool TransactionSignatureChecker::CheckLockTime(int64_t lock_time) const {
+  // There are two kinds of nLockTime: lock-by-blockheight and
+  // lock-by-blocktime, distinguished by whether nLockTime <
+  // LOCKTIME_THRESHOLD.
+  //
+  // We want to compare apples to apples, so fail the script unless the type
+  // of nLockTime being tested is the same as the nLockTime in the
+  // transaction.
+  int64_t tx_lock_time = context_->GetLockTime();
+  if (!(((tx_lock_time < kLocktimeThreshold) &&
+         (lock_time < kLocktimeThreshold)) ||
+        ((tx_lock_time >= kLocktimeThreshold) &&
+         (lock_time >= kLocktimeThreshold)))) {
+    return false;
+  }
+  // Now that we know we're comparing apples-to-apples, the comparison is a
+  // simple numeric one.
+  if (lock_time > tx_lock_time) return false;
+  // Finally the nLockTime feature can be disabled in IsFinalTx() and thus
+  // CHECKLOCKTIMEVERIFY bypassed if every txin has been finalized by
+  // setting nSequence to maxint.
+  if (context_->GetTxIn(txin_index_).GetSequence() == kSequenceFinal) {
+    return false;
+  }
+  return true;
+}
+
+bool TransactionSignatureChecker::CheckSequence(int64_t sequence) const {
+  // Relative lock times are supported by comparing the passed in operand to
+  // the sequence number of the input.
+  const int64_t tx_sequence = context_->GetTxIn(txin_index_).GetSequence();
+
+  // Fail if the transaction's version number is not set high enough to
+  // trigger BIP 68 rules.
+  if (static_cast<uint32_t>(context_->GetVersion()) < 2) return false;
+
+  // Sequence numbers with their most significant bit set are not consensus
+  // constrained. Testing that the transaction's sequence number do not have
+  // this bit set prevents using this property to get around a
+  // CHECKSEQUENCEVERIFY check.
+  if (tx_sequence & kSequenceLockTimeDisableFlag) return false;
+
+  // Mask off any bits that do not have consensus-enforced meaning before
+  // doing the integer comparisons
+  const int64_t lock_time_mask =
+      kSequenceLockTimeTypeFlag | kSequenceLockTimeMask;
+  const int64_t tx_sequence_masked = tx_sequence & lock_time_mask;
+  const int64_t sequence_masked = sequence & lock_time_mask;
+
+  // There are two kinds of nSequence: lock-by-blockheight and
+  // lock-by-blocktime, distinguished by whether sequence_masked <
+  // SEQUENCE_LOCKTIME_TYPE_FLAG.
+  if (!(((tx_sequence_masked < kSequenceLockTimeTypeFlag) &&
+         (sequence_masked < kSequenceLockTimeTypeFlag)) ||
+        ((tx_sequence_masked >= kSequenceLockTimeTypeFlag) &&
+         (sequence_masked >= kSequenceLockTimeTypeFlag)))) {
+    return false;
+  }
+  // Now that we know we're comparing apples-to-apples, the comparison is a
+  // simple numeric one.
+  if (sequence_masked > tx_sequence_masked) return false;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// ScriptInterpreter
+// -----------------------------------------------------------------------------
+bool ScriptInterpreter::EvalScript(
+    std::vector<ByteData>* stack, const Script& script, uint32_t flags,
+    const SignatureChecker& checker, SigVersion version, ScriptError* error) {
+  if (stack == nullptr) {
+    warn(CFD_LOG_SOURCE, "stack is null.");
+    throw CfdException(kCfdIllegalArgumentError, "stack is null.");
+  }
+  if ((version != kSigVersionBase) && (version != kSigVersionWitnessV0)) {
+    warn(CFD_LOG_SOURCE, "unsupported signature version. [{}]", version);
+    throw CfdException(
+        kCfdIllegalArgumentError, "unsupported signature version.");
+  }
+  std::vector<StackData> stack_data;
+  stack_data.reserve(stack->size());
+  for (const auto& item : *stack) stack_data.push_back(item.GetBytes());
+
+  ScriptExecutionData exec_data;
+  ScriptError result = kScriptErrUnknown;
+  bool is_success = EvalScriptInternal(
+      &stack_data, script.GetData().GetBytes(), flags, checker, version,
+      &exec_data, &result);
+  if (error != nullptr) *error = result;
+
+  stack->clear();
+  stack->reserve(stack_data.size());
+  for (const auto& item : stack_data) stack->emplace_back(item);
+  return is_success;
+}
+
+bool ScriptInterpreter::VerifyScript(
+    const Script& unlocking_script, const Script& locking_script,
+    const ScriptWitness& witness, uint32_t flags,
+    const SignatureChecker& checker, ScriptError* error) {
+  CheckVerifyFlags(flags);
+  return VerifyScriptInternal(
+      unlocking_script.GetData().GetBytes(),
+      locking_script.GetData().GetBytes(), ConvertWitnessStack(witness),
+      flags, checker, error);
+}
+
+bool ScriptInterpreter::VerifyInput(
+    const SigHashContext& context, uint32_t txin_index, uint32_t flags,
+    ScriptError* error) {
+  CheckVerifyFlags(flags);
+  const TxInReference& txin = context.GetTxIn(txin_index);
+  const TxOut& utxo = context.GetUtxo(txin_index);
+  TransactionSignatureChecker checker(&context, txin_index);
+  return VerifyScriptInternal(
+      txin.GetUnlockingScript().GetData().GetBytes(),
+      utxo.GetLockingScript().GetData().GetBytes(),
+      ConvertWitnessStack(txin.GetScriptWitness()), flags, checker, error);
+}
+
+bool ScriptInterpreter::VerifyTransaction(
+    const Transaction& transaction, const std::vector<TxOut>& utxo_list,
+    uint32_t flags, std::vector<ScriptError>* error_list,
+    uint32_t thread_count) {
+  CheckVerifyFlags(flags);
+  uint32_t txin_count = transaction.GetTxInCount();
+  if (utxo_list.size() != txin_count) {
+    warn(
+        CFD_LOG_SOURCE, "unmatch utxo count. txin[{}] utxo[{}]", txin_count,
+        utxo_list.size());
+    throw CfdException(kCfdIllegalArgumentError, "unmatch utxo list count.");
+  }
+
+  const SigHashContext context(transaction, utxo_list);
+  std::vector<ScriptError> errors(txin_count, kScriptErrUnknown);
+  // Each input is independent, so the inputs are split to the workers.
+  ParallelFor(
+      txin_count, thread_count, 1, [&](size_t begin, size_t end) {
+        for (size_t index = begin; index < end; ++index) {
+          VerifyInput(
+              context, static_cast<uint32_t>(index), flags, &errors[index]);
+        }
+      });
+
+  bool is_valid = true;
+  for (const auto& error : errors) {
+    if (error != kScriptErrOk) is_valid = false;
+  }
+  if (error_list != nullptr) *error_list = errors;
+  return is_valid;
+}
+
+std::string ScriptInterpreter::GetErrorString(ScriptError error) {
+  switch (error) {
+    case kScriptErrOk:
+      return "No error";
+    case kScriptErrEvalFalse:
+      return "Script evaluated without error but finished with a false/empty "
+             "top stack element";
+    case kScriptErrVerify:
+      return "Script failed an OP_VERIFY operation";
+    case kScriptErrEqualVerify:
+      return "Script failed an OP_EQUALVERIFY operation";
+    case kScriptErrCheckMultisigVerify:
+      return "Script failed an OP_CHECKMULTISIGVERIFY operation";
+    case kScriptErrCheckSigVerify:
+      return "Script failed an OP_CHECKSIGVERIFY operation";
+    case kScriptErrNumEqualVerify:
+      return "Script failed an OP_NUMEQUALVERIFY operation";
+    case kScriptErrScriptSize:
+      return "Script is too big";
+    case kScriptErrPushSize:
+      return "Push value size limit exceeded";
+    case kScriptErrOpCount:
+      return "Operation limit exceeded";
+    case kScriptErrStackSize:
+      return "Stack size limit exceeded";
+    case kScriptErrSigCount:
+      return "Signature count negative or greater than pubkey count";
+    case kScriptErrPubkeyCount:
+      return "Pubkey count negative or limit exceeded";
+    case kScriptErrBadOpcode:
+      return "Opcode missing or not understood";
+    case kScriptErrDisabledOpcode:
+      return "Attempted to use a disabled opcode";
+    case kScriptErrInvalidStackOperation:
+      return "Operation not valid with the current stack size";
+    case kScriptErrInvalidAltstackOperation:
+      return "Operation not valid with the current altstack size";
+    case kScriptErrOpReturn:
+      return "OP_RETURN was encountered";
+    case kScriptErrUnbalancedConditional:
+      return "Invalid OP_IF construction";
+    case kScriptErrNegativeLocktime:
+      return "Negative locktime";
+    case kScriptErrUnsatisfiedLocktime:
+      return "Locktime requirement not satisfied";
+    case kScriptErrSigHashType:
+      return "Signature hash type missing or not understood";
+    case kScriptErrSigDer:
+      return "Non-canonical DER signature";
+    case kScriptErrMinimalData:
+      return "Data push larger than necessary";
+    case kScriptErrSigPushOnly:
+      return "Only push operators allowed in signatures";
+    case kScriptErrSigHighS:
+      return "Non-canonical signature: S value is unnecessarily high";
+    case kScriptErrSigNullDummy:
+      return "Dummy CHECKMULTISIG argument must be zero";
+    case kScriptErrMinimalIf:
+      return "OP_IF/NOTIF argument must be minimal";
+    case kScriptErrSigNullFail:
+      return "Signature must be zero for failed CHECK(MULTI)SIG operation";
+    case kScriptErrDiscourageUpgradableNops:
+      return "NOPx reserved for soft-fork upgrades";
+    case kScriptErrDiscourageUpgradableWitnessProgram:
+      return "Witness version reserved for soft-fork upgrades";
+    case kScriptErrDiscourageUpgradableTaprootVersion:
+      return "Taproot version reserved for soft-fork upgrades";
+    case kScriptErrDiscourageOpSuccess:
+      return "OP_SUCCESSx reserved for soft-fork upgrades";
+    case kScriptErrDiscourageUpgradablePubkeyType:
+      return "Public key version reserved for soft-fork upgrades";
+    case kScriptErrPubkeyType:
+      return "Public key is neither compressed or uncompressed";
+    case kScriptErrCleanStack:
+      return "Stack size must be exactly one after execution";
+    case kScriptErrWitnessProgramWrongLength:
+      return "Witness program has incorrect length";
+    case kScriptErrWitnessProgramWitnessEmpty:
+      return "Witness program was passed an empty witness";
+    case kScriptErrWitnessProgramMismatch:
+      return "Witness program hash mismatch";
+    case kScriptErrWitnessMalleated:
+      return "Witness requires empty scriptSig";
+    case kScriptErrWitnessMalleatedP2sh:
+      return "Witness requires only-redeemscript scriptSig";
+    case kScriptErrWitnessUnexpected:
+      return "Witness provided for non-witness script";
+    case kScriptErrWitnessPubkeyType:
+      return "Using non-compressed keys in segwit";
+    case kScriptErrSchnorrSigSize:
+      return "Invalid Schnorr signature size";
+    case kScriptErrSchnorrSigHashType:
+      return "Invalid Schnorr signature hash type";
+    case kScriptErrSchnorrSig:
+      return "Invalid Schnorr signature";
+    case kScriptErrTaprootWrongControlSize:
+      return "Invalid Taproot control block size";
+    case kScriptErrTapscriptValidationWeight:
+      return "Too much signature validation relative to witness weight";
+    case kScriptErrTapscriptCheckMultisig:
+      return "OP_CHECKMULTISIG(VERIFY) is not available in tapscript";
+    case kScriptErrTapscriptMinimalIf:
+      return "OP_IF/NOTIF argument must be minimal in tapscript";
+    case kScriptErrOpCodeSeparator:
+      return "Using OP_CODESEPARATOR in non-witness script";
+    case kScriptErrSigFindAndDelete:
+      return "Signature is found in scriptCode";
+    case kScriptErrUnknown:
+    default:
+      break;
+  }
+  return "unknown error";
+}
+
+}  // namespace core
+}  // namespace cfd
@@ -7,16 +7,24 @@
 
 #include "cfdcore_secp256k1.h"  // NOLINT
 
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>  // NOLINT
 #include <vector>
 
 #include "cfdcore/cfdcore_exception.h"
 #include "cfdcore/cfdcore_logger.h"
+#include "cfdcore/cfdcore_util.h"
+#include "cfdcore_random.h"             // NOLINT
 #include "secp256k1.h"                  // NOLINT
 #include "secp256k1_generator.h"        // NOLINT
+#include "secp256k1_preallocated.h"     // NOLINT
 #include "secp256k1_rangeproof.h"       // NOLINT
 #include "secp256k1_schnorrsig.h"       // NOLINT
 #include "secp256k1_surjectionproof.h"  // NOLINT
 #include "secp256k1_whitelist.h"        // NOLINT
+#include "wally_core.h"                 // NOLINT
 
 namespace cfd {
 namespace core {
@@ -32,10 +40,28 @@ static constexpr uint8_t kCompressedPubkeyByteSize =
     33;  //!< ByteSize of compressed pubkey
 static constexpr uint8_t kFullPubkeyByteSize =
     65;  //!< ByteSize of full pubkey
+//! ByteSize of compact ecdsa signature
+static constexpr uint8_t kCompactSignatureByteSize = 64;
+//! ByteSize of context randomize seed
+static constexpr uint8_t kRandomizeSeedByteSize = 32;
 //! Maximum of surjectionproof input
 static constexpr uint32_t kSurjectionproofMaxInputs =
     SECP256K1_SURJECTIONPROOF_MAX_N_INPUTS;
 
+/**
+ * @brief Get the secp256k1 context.
+ * @param[in] context   context pointer
+ * @return secp256k1 context
+ */
+static secp256k1_context* GetSecp256k1Context(void* context) {
+  if (context == NULL) {
+    warn(CFD_LOG_SOURCE, "Secp256k1 context is NULL.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Secp256k1 context is NULL.");
+  }
+  return static_cast<secp256k1_context*>(context);
+}
+
 //////////////////////////////////
 /// Secp256k1
 //////////////////////////////////
@@ -153,6 +179,146 @@ ByteData Secp256k1::CompressPubkeySecp256k1Ec(
   return ByteData(byte_data);
 }
 
+bool Secp256k1::ParsePubkeySecp256k1Ec(
+    const ByteData& pubkey, uint8_t* point) {
+  secp256k1_context* context = GetSecp256k1Context(secp256k1_context_);
+  const std::vector<uint8_t>& pubkey_data = pubkey.GetBytes();
+  secp256k1_pubkey pubkey_secp;
+  if ((pubkey_data.empty()) ||
+      (secp256k1_ec_pubkey_parse(
+           context, &pubkey_secp, pubkey_data.data(), pubkey_data.size()) !=
+       1)) {
+    return false;
+  }
+  memcpy(point, pubkey_secp.data, sizeof(pubkey_secp.data));
+  return true;
+}
+
+ByteData Secp256k1::SerializePubkeySecp256k1Ec(
+    const uint8_t* point, bool is_compressed) {
+  secp256k1_context* context = GetSecp256k1Context(secp256k1_context_);
+  secp256k1_pubkey pubkey_secp;
+  memcpy(pubkey_secp.data, point, sizeof(pubkey_secp.data));
+
+  std::vector<uint8_t> byte_data(kFullPubkeyByteSize);
+  size_t byte_size = byte_data.size();
+  int ret = secp256k1_ec_pubkey_serialize(
+      context, byte_data.data(), &byte_size, &pubkey_secp,
+      (is_compressed) ? SECP256K1_EC_COMPRESSED : SECP256K1_EC_UNCOMPRESSED);
+  if (ret != 1) {
+    warn(CFD_LOG_SOURCE, "secp256k1_ec_pubkey_serialize Error.({})", ret);
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError,
+        "Secp256k1 pubkey serialize Error.");
+  }
+  byte_data.resize(byte_size);
+  return ByteData(byte_data);
+}
+
+void Secp256k1::CombinePubkeyPointSecp256k1Ec(
+    const std::vector<const uint8_t*>& point_list, uint8_t* combined) {
+  secp256k1_context* context = GetSecp256k1Context(secp256k1_context_);
+  if (point_list.size() < 2) {
+    warn(CFD_LOG_SOURCE, "Invalid Argument pubkey list.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid Pubkey List data.");
+  }
+
+  std::vector<secp256k1_pubkey> key_array(point_list.size());
+  std::vector<const secp256k1_pubkey*> ptr_array(point_list.size());
+  for (size_t i = 0; i < point_list.size(); ++i) {
+    memcpy(key_array[i].data, point_list[i], sizeof(key_array[i].data));
+    ptr_array[i] = &key_array[i];
+  }
+
+  secp256k1_pubkey combine_key;
+  int ret = secp256k1_ec_pubkey_combine(
+      context, &combine_key, ptr_array.data(), ptr_array.size());
+  if (ret != 1) {
+    warn(CFD_LOG_SOURCE, "Secp256k1 pubkey combine Error.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Secp256k1 pubkey combine Error.");
+  }
+  memcpy(combined, combine_key.data, sizeof(combine_key.data));
+}
+
+void Secp256k1::AddTweakPubkeyPointSecp256k1Ec(
+    const uint8_t* point, const ByteData& tweak, uint8_t* tweaked) {
+  secp256k1_context* context = GetSecp256k1Context(secp256k1_context_);
+  if (tweak.GetDataSize() != kTweakByteSize) {
+    warn(CFD_LOG_SOURCE, "Invalid Argument tweak size.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid tweak size.");
+  }
+
+  secp256k1_pubkey pubkey_secp;
+  memcpy(pubkey_secp.data, point, sizeof(pubkey_secp.data));
+  int ret = secp256k1_ec_pubkey_tweak_add(
+      context, &pubkey_secp, tweak.GetBytes().data());
+  if (ret != 1) {
+    warn(CFD_LOG_SOURCE, "secp256k1_ec_pubkey_tweak_add Error.({})", ret);
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Secp256k1 pubkey tweak Error.");
+  }
+  memcpy(tweaked, pubkey_secp.data, sizeof(pubkey_secp.data));
+}
+
+void Secp256k1::MulTweakPubkeyPointSecp256k1Ec(
+    const uint8_t* point, const ByteData& tweak, uint8_t* tweaked) {
+  secp256k1_context* context = GetSecp256k1Context(secp256k1_context_);
+  if (tweak.GetDataSize() != kTweakByteSize) {
+    warn(CFD_LOG_SOURCE, "Invalid Argument tweak size.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Invalid tweak size.");
+  }
+
+  secp256k1_pubkey pubkey_secp;
+  memcpy(pubkey_secp.data, point, sizeof(pubkey_secp.data));
+  int ret = secp256k1_ec_pubkey_tweak_mul(
+      context, &pubkey_secp, tweak.GetBytes().data());
+  if (ret != 1) {
+    warn(CFD_LOG_SOURCE, "secp256k1_ec_pubkey_tweak_mul Error.({})", ret);
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Secp256k1 pubkey tweak Error.");
+  }
+  memcpy(tweaked, pubkey_secp.data, sizeof(pubkey_secp.data));
+}
+
+void Secp256k1::NegatePubkeyPointSecp256k1Ec(
+    const uint8_t* point, uint8_t* negated) {
+  secp256k1_context* context = GetSecp256k1Context(secp256k1_context_);
+  secp256k1_pubkey pubkey_secp;
+  memcpy(pubkey_secp.data, point, sizeof(pubkey_secp.data));
+  int ret = secp256k1_ec_pubkey_negate(context, &pubkey_secp);
+  if (ret != 1) {
+    warn(CFD_LOG_SOURCE, "secp256k1_ec_pubkey_negate Error.({})", ret);
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Secp256k1 pubkey negate Error.");
+  }
+  memcpy(negated, pubkey_secp.data, sizeof(pubkey_secp.data));
+}
+
+bool Secp256k1::VerifyEcdsaSecp256k1Ec(
+    const uint8_t* point, const ByteData& signature_hash,
+    const ByteData& signature) {
+  secp256k1_context* context = GetSecp256k1Context(secp256k1_context_);
+  if ((signature_hash.GetDataSize() != kTweakByteSize) ||
+      (signature.GetDataSize() != kCompactSignatureByteSize)) {
+    return false;
+  }
+
+  secp256k1_pubkey pubkey_secp;
+  secp256k1_ecdsa_signature signature_secp;
+  memcpy(pubkey_secp.data, point, sizeof(pubkey_secp.data));
+  if (secp256k1_ecdsa_signature_parse_compact(
+          context, &signature_secp, signature.GetBytes().data()) != 1) {
+    return false;
+  }
+  return secp256k1_ecdsa_verify(
+             context, &signature_secp, signature_hash.GetBytes().data(),
+             &pubkey_secp) == 1;
+}
+
 ByteData Secp256k1::AddTweakPrivkeySecp256k1Ec(
     const ByteData& privkey, const ByteData& tweak) {
   if (secp256k1_context_ == NULL) {
@@ -619,5 +785,235 @@ ByteData Secp256k1::SignWhitelistSecp256k1Ec(
   output.resize(output_size);
   return ByteData(output);
 }
+//////////////////////////////////
+/// Secp256k1ContextPool
+//////////////////////////////////
+/**
+ * @brief context entry of the pool.
+ */
+struct Secp256k1ContextEntry {
+  std::unique_ptr<uint8_t[]> memory;  //!< preallocated context memory
+  secp256k1_context* context;         //!< cloned context
+  uint32_t use_count;                 //!< count of uses after randomize
+};
+
+/**
+ * @brief pool state.
+ */
+struct Secp256k1ContextPool::PoolState {
+  std::mutex mutex;                   //!< exclusive control object
+  std::atomic<bool> is_initialized;   //!< initialized flag
+  std::atomic<uint64_t> generation;   //!< initialize generation
+  secp256k1_context* base_context;    //!< source context of clone
+  size_t context_size;                //!< preallocated context size
+  uint32_t randomize_interval;        //!< count of uses between randomize
+  //! all context entries
+  std::vector<std::unique_ptr<Secp256k1ContextEntry>> entry_list;
+  std::vector<Secp256k1ContextEntry*> free_list;  //!< unused entries
+};
+
+/**
+ * @brief context slot of the thread.
+ */
+struct Secp256k1ContextSlot {
+  std::shared_ptr<Secp256k1ContextPool::PoolState> state;  //!< pool state
+  uint64_t generation;            //!< generation of the entry
+  Secp256k1ContextEntry* entry;   //!< context entry
+};
+
+/**
+ * @brief Randomize the context of the entry.
+ * @param[in,out] entry   context entry
+ */
+static void RandomizeContextEntry(Secp256k1ContextEntry* entry) {
+  // The seed is read from the OS directly, since the random generator of
+  // RandomNumberUtil can be set to the deterministic mode for testing.
+  uint8_t seed[kRandomizeSeedByteSize];
+  GetSystemRandomBytes(seed, sizeof(seed));
+  int ret = secp256k1_context_randomize(entry->context, seed);
+  wally_bzero(seed, sizeof(seed));
+  if (ret != 1) {
+    warn(CFD_LOG_SOURCE, "secp256k1_context_randomize Error.({})", ret);
+    throw CfdException(
+        CfdError::kCfdIllegalStateError, "Secp256k1 context randomize Error.");
+  }
+  entry->use_count = 0;
+}
+
+/**
+ * @brief context slot list of the thread.
+ * @details The entries are returned to the pool on the thread exit.
+ */
+class Secp256k1ContextSlotList {
+ public:
+  /**
+   * @brief destructor.
+   */
+  ~Secp256k1ContextSlotList() {
+    for (const auto& slot : slot_list) {
+      if (slot.entry == nullptr) continue;
+      std::lock_guard<std::mutex> lock(slot.state->mutex);
+      if (slot.state->is_initialized &&
+          (slot.state->generation == slot.generation)) {
+        // re-randomize here, so the next thread takes it without the cost.
+        try {
+          RandomizeContextEntry(slot.entry);
+        } catch (const CfdException&) {
+          // the context is still usable with the old blinding.
+        }
+        slot.state->free_list.push_back(slot.entry);
+      }
+    }
+  }
+
+  std::vector<Secp256k1ContextSlot> slot_list;  //!< slot list
+};
+
+//! context slots of the current thread
+static thread_local Secp256k1ContextSlotList g_secp256k1_context_slots;
+
+/**
+ * @brief Create the context entry. (need the lock of the state)
+ * @param[in,out] state   pool state
+ * @return context entry
+ */
+static Secp256k1ContextEntry* CreateContextEntry(
+    Secp256k1ContextPool::PoolState* state) {
+  std::unique_ptr<Secp256k1ContextEntry> entry(new Secp256k1ContextEntry());
+  entry->memory.reset(new uint8_t[state->context_size]);
+  entry->context = secp256k1_context_preallocated_clone(
+      state->base_context, entry->memory.get());
+  entry->use_count = 0;
+  if (entry->context == nullptr) {
+    warn(CFD_LOG_SOURCE, "secp256k1_context_preallocated_clone Error.");
+    throw CfdException(
+        CfdError::kCfdIllegalStateError, "Secp256k1 context clone Error.");
+  }
+  try {
+    RandomizeContextEntry(entry.get());
+  } catch (const CfdException&) {
+    secp256k1_context_preallocated_destroy(entry->context);
+    throw;
+  }
+  Secp256k1ContextEntry* result = entry.get();
+  state->entry_list.push_back(std::move(entry));
+  return result;
+}
+
+/**
+ * @brief Destroy all context entries. (need the lock of the state)
+ * @param[in,out] state   pool state
+ */
+static void DestroyContextEntries(Secp256k1ContextPool::PoolState* state) {
+  for (const auto& entry : state->entry_list) {
+    secp256k1_context_preallocated_destroy(entry->context);
+  }
+  state->entry_list.clear();
+  state->free_list.clear();
+}
+
+Secp256k1ContextPool::Secp256k1ContextPool() : state_(new PoolState()) {
+  state_->is_initialized = false;
+  state_->generation = 0;
+  state_->base_context = nullptr;
+  state_->context_size = 0;
+  state_->randomize_interval = kDefaultRandomizeInterval;
+}
+
+Secp256k1ContextPool::~Secp256k1ContextPool() { Finalize(); }
+
+void Secp256k1ContextPool::Initialize(
+    void* base_context, uint32_t preallocate_count,
+    uint32_t randomize_interval) {
+  if (base_context == nullptr) {
+    warn(CFD_LOG_SOURCE, "Secp256k1 context is NULL.");
+    throw CfdException(
+        CfdError::kCfdIllegalArgumentError, "Secp256k1 context is NULL.");
+  }
+
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  if (state_->is_initialized) {
+    warn(CFD_LOG_SOURCE, "Secp256k1 context pool is already initialized.");
+    throw CfdException(
+        CfdError::kCfdIllegalStateError,
+        "Secp256k1 context pool is already initialized.");
+  }
+  state_->base_context = static_cast<secp256k1_context*>(base_context);
+  state_->context_size =
+      secp256k1_context_preallocated_clone_size(state_->base_context);
+  state_->randomize_interval = (randomize_interval == 0)
+                                   ? kDefaultRandomizeInterval
+                                   : randomize_interval;
+  try {
+    for (uint32_t index = 0; index < preallocate_count; ++index) {
+      state_->free_list.push_back(CreateContextEntry(state_.get()));
+    }
+  } catch (const CfdException&) {
+    DestroyContextEntries(state_.get());
+    throw;
+  }
+  ++state_->generation;
+  state_->is_initialized = true;
+}
+
+void Secp256k1ContextPool::Finalize() {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  if (!state_->is_initialized) return;
+  state_->is_initialized = false;
+  ++state_->generation;
+  DestroyContextEntries(state_.get());
+  state_->base_context = nullptr;
+}
+
+bool Secp256k1ContextPool::IsInitialized() const {
+  return (state_) ? state_->is_initialized.load() : false;
+}
+
+void* Secp256k1ContextPool::GetContext() {
+  PoolState* state = state_.get();
+  if ((state == nullptr) || (!state->is_initialized)) return nullptr;
+  uint64_t generation = state->generation;
+
+  Secp256k1ContextSlot* slot = nullptr;
+  for (auto& item : g_secp256k1_context_slots.slot_list) {
+    if (item.state.get() == state) {
+      slot = &item;
+      break;
+    }
+  }
+  if (slot == nullptr) {
+    g_secp256k1_context_slots.slot_list.push_back({state_, 0, nullptr});
+    slot = &g_secp256k1_context_slots.slot_list.back();
+  }
+
+  if ((slot->entry != nullptr) && (slot->generation == generation)) {
+    // A thread keeps its context until the thread exits, so there is no
+    // return point for the periodic re-randomization of a long-lived
+    // thread. It is done here once in randomize_interval calls; the cost
+    // (about one scalar multiplication) is small against the interval.
+    if (++slot->entry->use_count >= state->randomize_interval) {
+      RandomizeContextEntry(slot->entry);
+    }
+    return slot->entry->context;
+  }
+
+  // take a context of the pool for this thread.
+  // (The pooled contexts are randomized on the creation and the return.)
+  Secp256k1ContextEntry* entry = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (!state->is_initialized) return nullptr;
+    if (state->free_list.empty()) {
+      entry = CreateContextEntry(state);
+    } else {
+      entry = state->free_list.back();
+      state->free_list.pop_back();
+    }
+    slot->generation = state->generation;
+    slot->entry = entry;
+  }
+  return entry->context;
+}
+
 }  // namespace core
 }  // namespace cfd
@@ -7,7 +7,9 @@
 #ifndef CFD_CORE_SRC_CFDCORE_SECP256K1_H_
 #define CFD_CORE_SRC_CFDCORE_SECP256K1_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "cfdcore/cfdcore_bytedata.h"
@@ -15,6 +17,9 @@
 namespace cfd {
 namespace core {
 
+//! Size of the parsed secp256k1 pubkey (secp256k1_pubkey)
+constexpr size_t kSecp256k1PubkeyPointSize = 64;
+
 /**
  * @brief secp256k1 class
  */
@@ -46,6 +51,68 @@ class Secp256k1 {
    */
   ByteData CompressPubkeySecp256k1Ec(const ByteData& uncompressed_pubkey);
 
+  /**
+   * @brief parse pubkey to the secp256k1 point.
+   * @param[in] pubkey  pubkey (compressed, uncompressed or hybrid)
+   * @param[out] point  parsed point (kSecp256k1PubkeyPointSize)
+   * @retval true   parse success
+   * @retval false  invalid pubkey
+   */
+  bool ParsePubkeySecp256k1Ec(const ByteData& pubkey, uint8_t* point);
+
+  /**
+   * @brief serialize the secp256k1 point to pubkey.
+   * @param[in] point           parsed point
+   * @param[in] is_compressed   compressed format flag
+   * @return data of Pubkey
+   */
+  ByteData SerializePubkeySecp256k1Ec(const uint8_t* point, bool is_compressed);
+
+  /**
+   * @brief combine the secp256k1 points.
+   * @param[in] point_list    parsed point list (2 or more)
+   * @param[out] combined     combined point
+   */
+  void CombinePubkeyPointSecp256k1Ec(
+      const std::vector<const uint8_t*>& point_list, uint8_t* combined);
+
+  /**
+   * @brief add the tweak to the secp256k1 point.
+   * @param[in] point       parsed point
+   * @param[in] tweak       tweak value to be added.(32-byte)
+   * @param[out] tweaked    tweaked point (can be the same as point)
+   */
+  void AddTweakPubkeyPointSecp256k1Ec(
+      const uint8_t* point, const ByteData& tweak, uint8_t* tweaked);
+
+  /**
+   * @brief multiply the secp256k1 point by the tweak.
+   * @param[in] point       parsed point
+   * @param[in] tweak       tweak value to be multiplied.(32-byte)
+   * @param[out] tweaked    tweaked point (can be the same as point)
+   */
+  void MulTweakPubkeyPointSecp256k1Ec(
+      const uint8_t* point, const ByteData& tweak, uint8_t* tweaked);
+
+  /**
+   * @brief negate the secp256k1 point.
+   * @param[in] point       parsed point
+   * @param[out] negated    negated point (can be the same as point)
+   */
+  void NegatePubkeyPointSecp256k1Ec(const uint8_t* point, uint8_t* negated);
+
+  /**
+   * @brief verify the ecdsa signature with the secp256k1 point.
+   * @param[in] point           parsed point
+   * @param[in] signature_hash  signature hash (32-byte)
+   * @param[in] signature       compact signature (64-byte)
+   * @retval true   valid signature
+   * @retval false  invalid signature
+   */
+  bool VerifyEcdsaSecp256k1Ec(
+      const uint8_t* point, const ByteData& signature_hash,
+      const ByteData& signature);
+
   /**
    * @brief Tweak a private key by adding tweak.
    * @param[in] privkey     private key.(must 32-byte)
@@ -133,6 +200,64 @@ class Secp256k1 {
   void* secp256k1_context_;
 };
 
+/**
+ * @brief per-thread secp256k1 context pool.
+ * @details Each thread takes its own context cloned from the base context
+ *     into memory owned by the pool, so signing and verification on
+ *     different threads do not share one context. A context is
+ *     randomized with the OS random source when it is created and when it
+ *     is returned to the pool on the thread exit, so taking a context does
+ *     not randomize it. A context held by a thread is re-randomized in
+ *     GetContext after every randomize interval of its uses.
+ */
+class Secp256k1ContextPool {
+ public:
+  //! default count of uses between re-randomization
+  static constexpr uint32_t kDefaultRandomizeInterval = 1024;
+
+  /**
+   * @brief constructor.
+   */
+  Secp256k1ContextPool();
+  /**
+   * @brief destructor.
+   */
+  virtual ~Secp256k1ContextPool();
+
+  /**
+   * @brief initialize the pool.
+   * @param[in] base_context        source context of clone (sign & verify)
+   * @param[in] preallocate_count   count of contexts cloned in advance
+   * @param[in] randomize_interval  count of uses between re-randomization
+   */
+  void Initialize(
+      void* base_context, uint32_t preallocate_count = 0,
+      uint32_t randomize_interval = kDefaultRandomizeInterval);
+  /**
+   * @brief finalize the pool. All contexts are destroyed.
+   */
+  void Finalize();
+  /**
+   * @brief check the initialized state.
+   * @retval true   initialized
+   * @retval false  not initialized
+   */
+  bool IsInitialized() const;
+  /**
+   * @brief get the context for the current thread.
+   * @return context. (nullptr if not initialized)
+   */
+  void* GetContext();
+
+  /**
+   * @brief pool state (shared with the thread-local slots).
+   */
+  struct PoolState;
+
+ private:
+  std::shared_ptr<PoolState> state_;  //!< pool state
+};
+
 }  // namespace core
 }  // namespace cfd
 #endif  // CFD_CORE_SRC_CFDCORE_SECP256K1_H_
@@ -0,0 +1,661 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_sha2.cpp
+ *
+ * @brief SHA-2 compression functions for keyed hash contexts.
+ */
+#include "cfdcore_sha2.h"  // NOLINT
+
+#include <cstring>
+
+#include "cfdcore_cpu.h"  // NOLINT
+
+namespace cfd {
+namespace core {
+
+/// SHA-256 round constants
+static constexpr uint32_t kSha256RoundTable[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+/// SHA-512 round constants
+static constexpr uint64_t kSha512RoundTable[80] = {
+    0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f,
+    0xe9b5dba58189dbbc, 0x3956c25bf348b538, 0x59f111f1b605d019,
+    0x923f82a4af194f9b, 0xab1c5ed5da6d8118, 0xd807aa98a3030242,
+    0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+    0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235,
+    0xc19bf174cf692694, 0xe49b69c19ef14ad2, 0xefbe4786384f25e3,
+    0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65, 0x2de92c6f592b0275,
+    0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+    0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f,
+    0xbf597fc7beef0ee4, 0xc6e00bf33da88fc2, 0xd5a79147930aa725,
+    0x06ca6351e003826f, 0x142929670a0e6e70, 0x27b70a8546d22ffc,
+    0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+    0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6,
+    0x92722c851482353b, 0xa2bfe8a14cf10364, 0xa81a664bbc423001,
+    0xc24b8b70d0f89791, 0xc76c51a30654be30, 0xd192e819d6ef5218,
+    0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
+    0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99,
+    0x34b0bcb5e19b48a8, 0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb,
+    0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3, 0x748f82ee5defb2fc,
+    0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+    0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915,
+    0xc67178f2e372532b, 0xca273eceea26619c, 0xd186b8c721c0c207,
+    0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178, 0x06f067aa72176fba,
+    0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
+    0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
+    0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a,
+    0x5fcb6fab3ad6faec, 0x6c44198c4a475817,
+};
+
+/**
+ * @brief Read a big endian 32bit value.
+ * @param[in] data  data
+ * @return value
+ */
+static inline uint32_t ReadBigEndian32(const uint8_t *data) {
+  return (static_cast<uint32_t>(data[0]) << 24) |
+         (static_cast<uint32_t>(data[1]) << 16) |
+         (static_cast<uint32_t>(data[2]) << 8) | data[3];
+}
+
+/**
+ * @brief Read a big endian 64bit value.
+ * @param[in] data  data
+ * @return value
+ */
+static inline uint64_t ReadBigEndian64(const uint8_t *data) {
+  return (static_cast<uint64_t>(ReadBigEndian32(data)) << 32) |
+         ReadBigEndian32(data + 4);
+}
+
+/**
+ * @brief Write a big endian value.
+ * @param[in] value   value
+ * @param[in] size    byte size
+ * @param[out] data   output data
+ */
+static inline void WriteBigEndian(uint64_t value, size_t size, uint8_t *data) {
+  for (size_t index = 0; index < size; ++index) {
+    data[index] = static_cast<uint8_t>(value >> (8 * (size - 1 - index)));
+  }
+}
+
+/**
+ * @brief Rotate right. (32bit)
+ * @param[in] value   value
+ * @param[in] count   rotate count
+ * @return value
+ */
+static inline uint32_t RotateRight32(uint32_t value, int count) {
+  return (value >> count) | (value << (32 - count));
+}
+
+/**
+ * @brief Rotate right. (64bit)
+ * @param[in] value   value
+ * @param[in] count   rotate count
+ * @return value
+ */
+static inline uint64_t RotateRight64(uint64_t value, int count) {
+  return (value >> count) | (value << (64 - count));
+}
+
+void Sha256Initialize(uint32_t *state) {
+  static constexpr uint32_t kInitialState[kSha256StateSize] = {
+      0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+      0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+  };
+  memcpy(state, kInitialState, sizeof(kInitialState));
+}
+
+void Sha256Transform(uint32_t *state, const uint8_t *blocks, size_t count) {
+  uint32_t words[64];
+  for (size_t block = 0; block < count; ++block) {
+    const uint8_t *data = blocks + block * kSha256BlockSize;
+    for (int index = 0; index < 16; ++index) {
+      words[index] = ReadBigEndian32(data + index * 4);
+    }
+    for (int index = 16; index < 64; ++index) {
+      uint32_t w15 = words[index - 15];
+      uint32_t w2 = words[index - 2];
+      uint32_t s0 = RotateRight32(w15, 7) ^ RotateRight32(w15, 18) ^ (w15 >> 3);
+      uint32_t s1 = RotateRight32(w2, 17) ^ RotateRight32(w2, 19) ^ (w2 >> 10);
+      words[index] = words[index - 16] + s0 + words[index - 7] + s1;
+    }
+
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+    uint32_t f = state[5];
+    uint32_t g = state[6];
+    uint32_t h = state[7];
+    for (int index = 0; index < 64; ++index) {
+      uint32_t s1 =
+          RotateRight32(e, 6) ^ RotateRight32(e, 11) ^ RotateRight32(e, 25);
+      uint32_t choose = (e & f) ^ (~e & g);
+      uint32_t temp1 =
+          h + s1 + choose + kSha256RoundTable[index] + words[index];
+      uint32_t s0 =
+          RotateRight32(a, 2) ^ RotateRight32(a, 13) ^ RotateRight32(a, 22);
+      uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+      h = g;
+      g = f;
+      f = e;
+      e = d + temp1;
+      d = c;
+      c = b;
+      b = a;
+      a = temp1 + s0 + majority;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+void Sha256Finalize(
+    const uint32_t *state, const uint8_t *data, size_t size,
+    uint64_t total_size, uint8_t *hash) {
+  uint32_t work[kSha256StateSize];
+  memcpy(work, state, sizeof(work));
+  size_t block_count = size / kSha256BlockSize;
+  Sha256Transform(work, data, block_count);
+  data += block_count * kSha256BlockSize;
+  size -= block_count * kSha256BlockSize;
+
+  // padding: 0x80, zero, 64bit bit-length
+  uint8_t last[kSha256BlockSize * 2];
+  memset(last, 0, sizeof(last));
+  if (size != 0) memcpy(last, data, size);
+  last[size] = 0x80;
+  size_t last_size = (size + 1 + 8 <= kSha256BlockSize) ? kSha256BlockSize
+                                                         : sizeof(last);
+  WriteBigEndian(total_size * 8, 8, last + last_size - 8);
+  Sha256Transform(work, last, last_size / kSha256BlockSize);
+  for (size_t index = 0; index < kSha256StateSize; ++index) {
+    WriteBigEndian(work[index], 4, hash + index * 4);
+  }
+}
+
+void Sha512Initialize(uint64_t *state) {
+  static constexpr uint64_t kInitialState[kSha512StateSize] = {
+      0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b,
+      0xa54ff53a5f1d36f1, 0x510e527fade682d1, 0x9b05688c2b3e6c1f,
+      0x1f83d9abfb41bd6b, 0x5be0cd19137e2179,
+  };
+  memcpy(state, kInitialState, sizeof(kInitialState));
+}
+
+/**
+ * @brief Process a SHA-512 block.
+ * @param[in,out] state   hash state
+ * @param[in,out] words   message schedule (16 words in, 80 words used)
+ */
+static void Sha512Compress(uint64_t *state, uint64_t *words) {
+  for (int index = 16; index < 80; ++index) {
+    uint64_t w15 = words[index - 15];
+    uint64_t w2 = words[index - 2];
+    uint64_t s0 = RotateRight64(w15, 1) ^ RotateRight64(w15, 8) ^ (w15 >> 7);
+    uint64_t s1 = RotateRight64(w2, 19) ^ RotateRight64(w2, 61) ^ (w2 >> 6);
+    words[index] = words[index - 16] + s0 + words[index - 7] + s1;
+  }
+
+  uint64_t a = state[0];
+  uint64_t b = state[1];
+  uint64_t c = state[2];
+  uint64_t d = state[3];
+  uint64_t e = state[4];
+  uint64_t f = state[5];
+  uint64_t g = state[6];
+  uint64_t h = state[7];
+  for (int index = 0; index < 80; ++index) {
+    uint64_t s1 =
+        RotateRight64(e, 14) ^ RotateRight64(e, 18) ^ RotateRight64(e, 41);
+    uint64_t choose = (e & f) ^ (~e & g);
+    uint64_t temp1 = h + s1 + choose + kSha512RoundTable[index] + words[index];
+    uint64_t s0 =
+        RotateRight64(a, 28) ^ RotateRight64(a, 34) ^ RotateRight64(a, 39);
+    uint64_t majority = (a & b) ^ (a & c) ^ (b & c);
+    h = g;
+    g = f;
+    f = e;
+    e = d + temp1;
+    d = c;
+    c = b;
+    b = a;
+    a = temp1 + s0 + majority;
+  }
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+void Sha512Transform(uint64_t *state, const uint8_t *blocks, size_t count) {
+  uint64_t words[80];
+  for (size_t block = 0; block < count; ++block) {
+    const uint8_t *data = blocks + block * kSha512BlockSize;
+    for (int index = 0; index < 16; ++index) {
+      words[index] = ReadBigEndian64(data + index * 8);
+    }
+    Sha512Compress(state, words);
+  }
+}
+
+void Sha512Finalize(
+    const uint64_t *state, const uint8_t *data, size_t size,
+    uint64_t total_size, uint8_t *hash) {
+  uint64_t work[kSha512StateSize];
+  memcpy(work, state, sizeof(work));
+  size_t block_count = size / kSha512BlockSize;
+  Sha512Transform(work, data, block_count);
+  data += block_count * kSha512BlockSize;
+  size -= block_count * kSha512BlockSize;
+
+  // padding: 0x80, zero, 128bit bit-length (upper 64bit is zero)
+  uint8_t last[kSha512BlockSize * 2];
+  memset(last, 0, sizeof(last));
+  memcpy(last, data, size);
+  last[size] = 0x80;
+  size_t last_size = (size + 1 + 16 <= kSha512BlockSize) ? kSha512BlockSize
+                                                          : sizeof(last);
+  WriteBigEndian(total_size * 8, 8, last + last_size - 8);
+  Sha512Transform(work, last, last_size / kSha512BlockSize);
+  for (size_t index = 0; index < kSha512StateSize; ++index) {
+    WriteBigEndian(work[index], 8, hash + index * 8);
+  }
+}
+
+/// message length of a PBKDF2 iteration block in bits. (pad + hash)
+static constexpr uint64_t kPbkdf2Sha512BitLength =
+    (kSha512BlockSize + kSha512StateSize * 8) * 8;
+
+/**
+ * @brief Run PBKDF2-HMAC-SHA512 iterations on a lane.
+ * @param[in] inner_state   inner pad state
+ * @param[in] outer_state   outer pad state
+ * @param[in,out] block     in: U1, out: T
+ * @param[in] iterations    iteration count
+ */
+static void Pbkdf2Sha512IterateScalar(
+    const uint64_t *inner_state, const uint64_t *outer_state, uint8_t *block,
+    uint32_t iterations) {
+  uint64_t value[kSha512StateSize];
+  uint64_t result[kSha512StateSize];
+  uint64_t words[80];
+  for (size_t index = 0; index < kSha512StateSize; ++index) {
+    value[index] = ReadBigEndian64(block + index * 8);
+    result[index] = value[index];
+  }
+  for (uint32_t count = 1; count < iterations; ++count) {
+    uint64_t state[kSha512StateSize];
+    for (int step = 0; step < 2; ++step) {
+      // U is a single padded block after the key pad.
+      memcpy(words, value, sizeof(value));
+      words[8] = 0x8000000000000000ULL;
+      memset(&words[9], 0, sizeof(uint64_t) * 6);
+      words[15] = kPbkdf2Sha512BitLength;
+      memcpy(
+          state, (step == 0) ? inner_state : outer_state, sizeof(state));
+      Sha512Compress(state, words);
+      memcpy(value, state, sizeof(value));
+    }
+    for (size_t index = 0; index < kSha512StateSize; ++index) {
+      result[index] ^= value[index];
+    }
+  }
+  for (size_t index = 0; index < kSha512StateSize; ++index) {
+    WriteBigEndian(result[index], 8, block + index * 8);
+  }
+}
+
+#ifdef CFD_CORE_USE_X86_SIMD
+/// AVX2 lane count (4 x 64bit)
+static constexpr size_t kSha512Avx2LaneCount = 4;
+
+/**
+ * @brief Rotate right on each 64bit lane. (AVX2)
+ * @param[in] value   value
+ * @param[in] count   rotate count
+ * @return value
+ */
+__attribute__((target("avx2"))) static inline __m256i RotateRight64Avx2(
+    __m256i value, int count) {
+  return _mm256_or_si256(
+      _mm256_srli_epi64(value, count), _mm256_slli_epi64(value, 64 - count));
+}
+
+/**
+ * @brief Process a SHA-512 block on 4 lanes. (AVX2)
+ * @param[in,out] state   hash state
+ * @param[in,out] words   message schedule (16 words in, 80 words used)
+ */
+__attribute__((target("avx2"))) static void Sha512CompressAvx2(
+    __m256i *state, __m256i *words) {
+  for (int index = 16; index < 80; ++index) {
+    __m256i w15 = words[index - 15];
+    __m256i w2 = words[index - 2];
+    __m256i s0 = _mm256_xor_si256(
+        _mm256_xor_si256(RotateRight64Avx2(w15, 1), RotateRight64Avx2(w15, 8)),
+        _mm256_srli_epi64(w15, 7));
+    __m256i s1 = _mm256_xor_si256(
+        _mm256_xor_si256(RotateRight64Avx2(w2, 19), RotateRight64Avx2(w2, 61)),
+        _mm256_srli_epi64(w2, 6));
+    words[index] = _mm256_add_epi64(
+        _mm256_add_epi64(words[index - 16], s0),
+        _mm256_add_epi64(words[index - 7], s1));
+  }
+
+  __m256i a = state[0];
+  __m256i b = state[1];
+  __m256i c = state[2];
+  __m256i d = state[3];
+  __m256i e = state[4];
+  __m256i f = state[5];
+  __m256i g = state[6];
+  __m256i h = state[7];
+  for (int index = 0; index < 80; ++index) {
+    __m256i s1 = _mm256_xor_si256(
+        _mm256_xor_si256(RotateRight64Avx2(e, 14), RotateRight64Avx2(e, 18)),
+        RotateRight64Avx2(e, 41));
+    __m256i choose =
+        _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    __m256i temp1 = _mm256_add_epi64(
+        _mm256_add_epi64(h, s1),
+        _mm256_add_epi64(
+            _mm256_add_epi64(choose, words[index]),
+            _mm256_set1_epi64x(
+                static_cast<int64_t>(kSha512RoundTable[index]))));
+    __m256i s0 = _mm256_xor_si256(
+        _mm256_xor_si256(RotateRight64Avx2(a, 28), RotateRight64Avx2(a, 34)),
+        RotateRight64Avx2(a, 39));
+    __m256i majority = _mm256_or_si256(
+        _mm256_and_si256(a, _mm256_or_si256(b, c)), _mm256_and_si256(b, c));
+    h = g;
+    g = f;
+    f = e;
+    e = _mm256_add_epi64(d, temp1);
+    d = c;
+    c = b;
+    b = a;
+    a = _mm256_add_epi64(temp1, _mm256_add_epi64(s0, majority));
+  }
+  state[0] = _mm256_add_epi64(state[0], a);
+  state[1] = _mm256_add_epi64(state[1], b);
+  state[2] = _mm256_add_epi64(state[2], c);
+  state[3] = _mm256_add_epi64(state[3], d);
+  state[4] = _mm256_add_epi64(state[4], e);
+  state[5] = _mm256_add_epi64(state[5], f);
+  state[6] = _mm256_add_epi64(state[6], g);
+  state[7] = _mm256_add_epi64(state[7], h);
+}
+
+/**
+ * @brief Load a state word of 4 lanes. (AVX2)
+ * @param[in] states  states (lane * 8 words)
+ * @param[in] index   word index
+ * @return lane vector
+ */
+__attribute__((target("avx2"))) static inline __m256i LoadLaneWordAvx2(
+    const uint64_t *states, size_t index) {
+  return _mm256_set_epi64x(
+      static_cast<int64_t>(states[kSha512StateSize * 3 + index]),
+      static_cast<int64_t>(states[kSha512StateSize * 2 + index]),
+      static_cast<int64_t>(states[kSha512StateSize + index]),
+      static_cast<int64_t>(states[index]));
+}
+
+/**
+ * @brief Run PBKDF2-HMAC-SHA512 iterations on 4 lanes. (AVX2)
+ * @param[in] inner_states  inner pad states (4 * 8 words)
+ * @param[in] outer_states  outer pad states (4 * 8 words)
+ * @param[in,out] blocks    in: U1, out: T (4 * 64 bytes)
+ * @param[in] iterations    iteration count
+ */
+__attribute__((target("avx2"))) static void Pbkdf2Sha512IterateAvx2(
+    const uint64_t *inner_states, const uint64_t *outer_states,
+    uint8_t *blocks, uint32_t iterations) {
+  __m256i inner[kSha512StateSize];
+  __m256i outer[kSha512StateSize];
+  __m256i value[kSha512StateSize];
+  __m256i result[kSha512StateSize];
+  __m256i words[80];
+  uint64_t first[kSha512Avx2LaneCount * kSha512StateSize];
+  for (size_t lane = 0; lane < kSha512Avx2LaneCount; ++lane) {
+    for (size_t index = 0; index < kSha512StateSize; ++index) {
+      first[lane * kSha512StateSize + index] =
+          ReadBigEndian64(blocks + lane * kSha512StateSize * 8 + index * 8);
+    }
+  }
+  for (size_t index = 0; index < kSha512StateSize; ++index) {
+    inner[index] = LoadLaneWordAvx2(inner_states, index);
+    outer[index] = LoadLaneWordAvx2(outer_states, index);
+    value[index] = LoadLaneWordAvx2(first, index);
+    result[index] = value[index];
+  }
+
+  const __m256i padding = _mm256_set1_epi64x(
+      static_cast<int64_t>(0x8000000000000000ULL));
+  const __m256i bit_length =
+      _mm256_set1_epi64x(static_cast<int64_t>(kPbkdf2Sha512BitLength));
+  for (uint32_t count = 1; count < iterations; ++count) {
+    __m256i state[kSha512StateSize];
+    for (int step = 0; step < 2; ++step) {
+      for (size_t index = 0; index < kSha512StateSize; ++index) {
+        words[index] = value[index];
+        state[index] = (step == 0) ? inner[index] : outer[index];
+      }
+      words[8] = padding;
+      for (size_t index = 9; index < 15; ++index) {
+        words[index] = _mm256_setzero_si256();
+      }
+      words[15] = bit_length;
+      Sha512CompressAvx2(state, words);
+      for (size_t index = 0; index < kSha512StateSize; ++index) {
+        value[index] = state[index];
+      }
+    }
+    for (size_t index = 0; index < kSha512StateSize; ++index) {
+      result[index] = _mm256_xor_si256(result[index], value[index]);
+    }
+  }
+
+  uint64_t lanes[kSha512Avx2LaneCount];
+  for (size_t index = 0; index < kSha512StateSize; ++index) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), result[index]);
+    for (size_t lane = 0; lane < kSha512Avx2LaneCount; ++lane) {
+      WriteBigEndian(
+          lanes[lane], 8, blocks + lane * kSha512StateSize * 8 + index * 8);
+    }
+  }
+}
+
+/// AVX2 lane count (8 x 32bit)
+static constexpr size_t kSha256Avx2LaneCount = 8;
+
+/**
+ * @brief Rotate right on each 32bit lane. (AVX2)
+ * @param[in] value   value
+ * @param[in] count   rotate count
+ * @return value
+ */
+__attribute__((target("avx2"))) static inline __m256i RotateRight32Avx2(
+    __m256i value, int count) {
+  return _mm256_or_si256(
+      _mm256_srli_epi32(value, count), _mm256_slli_epi32(value, 32 - count));
+}
+
+/**
+ * @brief Calculate SHA-256 of 8 padded single blocks. (AVX2)
+ * @param[in] blocks    padded blocks (8 * 64 bytes)
+ * @param[out] hashes   hashes (8 * 32 bytes)
+ */
+__attribute__((target("avx2"))) static void Sha256SingleBlockAvx2(
+    const uint8_t *blocks, uint8_t *hashes) {
+  static constexpr uint32_t kInitialState[kSha256StateSize] = {
+      0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+      0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+  };
+  __m256i words[64];
+  for (int index = 0; index < 16; ++index) {
+    uint32_t lanes[kSha256Avx2LaneCount];
+    for (size_t lane = 0; lane < kSha256Avx2LaneCount; ++lane) {
+      lanes[lane] =
+          ReadBigEndian32(blocks + lane * kSha256BlockSize + index * 4);
+    }
+    words[index] =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes));
+  }
+  for (int index = 16; index < 64; ++index) {
+    __m256i w15 = words[index - 15];
+    __m256i w2 = words[index - 2];
+    __m256i s0 = _mm256_xor_si256(
+        _mm256_xor_si256(RotateRight32Avx2(w15, 7), RotateRight32Avx2(w15, 18)),
+        _mm256_srli_epi32(w15, 3));
+    __m256i s1 = _mm256_xor_si256(
+        _mm256_xor_si256(RotateRight32Avx2(w2, 17), RotateRight32Avx2(w2, 19)),
+        _mm256_srli_epi32(w2, 10));
+    words[index] = _mm256_add_epi32(
+        _mm256_add_epi32(words[index - 16], s0),
+        _mm256_add_epi32(words[index - 7], s1));
+  }
+
+  __m256i state[kSha256StateSize];
+  for (size_t index = 0; index < kSha256StateSize; ++index) {
+    state[index] =
+        _mm256_set1_epi32(static_cast<int32_t>(kInitialState[index]));
+  }
+  __m256i a = state[0];
+  __m256i b = state[1];
+  __m256i c = state[2];
+  __m256i d = state[3];
+  __m256i e = state[4];
+  __m256i f = state[5];
+  __m256i g = state[6];
+  __m256i h = state[7];
+  for (int index = 0; index < 64; ++index) {
+    __m256i s1 = _mm256_xor_si256(
+        _mm256_xor_si256(RotateRight32Avx2(e, 6), RotateRight32Avx2(e, 11)),
+        RotateRight32Avx2(e, 25));
+    __m256i choose =
+        _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    __m256i temp1 = _mm256_add_epi32(
+        _mm256_add_epi32(h, s1),
+        _mm256_add_epi32(
+            _mm256_add_epi32(choose, words[index]),
+            _mm256_set1_epi32(
+                static_cast<int32_t>(kSha256RoundTable[index]))));
+    __m256i s0 = _mm256_xor_si256(
+        _mm256_xor_si256(RotateRight32Avx2(a, 2), RotateRight32Avx2(a, 13)),
+        RotateRight32Avx2(a, 22));
+    __m256i majority = _mm256_or_si256(
+        _mm256_and_si256(a, _mm256_or_si256(b, c)), _mm256_and_si256(b, c));
+    h = g;
+    g = f;
+    f = e;
+    e = _mm256_add_epi32(d, temp1);
+    d = c;
+    c = b;
+    b = a;
+    a = _mm256_add_epi32(temp1, _mm256_add_epi32(s0, majority));
+  }
+  state[0] = _mm256_add_epi32(state[0], a);
+  state[1] = _mm256_add_epi32(state[1], b);
+  state[2] = _mm256_add_epi32(state[2], c);
+  state[3] = _mm256_add_epi32(state[3], d);
+  state[4] = _mm256_add_epi32(state[4], e);
+  state[5] = _mm256_add_epi32(state[5], f);
+  state[6] = _mm256_add_epi32(state[6], g);
+  state[7] = _mm256_add_epi32(state[7], h);
+
+  static constexpr size_t kHashSize = kSha256StateSize * 4;
+  uint32_t lanes[kSha256Avx2LaneCount];
+  for (size_t index = 0; index < kSha256StateSize; ++index) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), state[index]);
+    for (size_t lane = 0; lane < kSha256Avx2LaneCount; ++lane) {
+      WriteBigEndian(lanes[lane], 4, hashes + lane * kHashSize + index * 4);
+    }
+  }
+}
+#endif  // CFD_CORE_USE_X86_SIMD
+
+void Pbkdf2Sha512Iterate(
+    const uint64_t *inner_states, const uint64_t *outer_states,
+    uint8_t *blocks, size_t lane_count, uint32_t iterations) {
+  static constexpr size_t kHashSize = kSha512StateSize * 8;
+  size_t lane = 0;
+#ifdef CFD_CORE_USE_X86_SIMD
+  if (IsSupportAvx2()) {
+    for (; lane + kSha512Avx2LaneCount <= lane_count;
+         lane += kSha512Avx2LaneCount) {
+      Pbkdf2Sha512IterateAvx2(
+          inner_states + lane * kSha512StateSize,
+          outer_states + lane * kSha512StateSize, blocks + lane * kHashSize,
+          iterations);
+    }
+  }
+#endif  // CFD_CORE_USE_X86_SIMD
+  for (; lane < lane_count; ++lane) {
+    Pbkdf2Sha512IterateScalar(
+        inner_states + lane * kSha512StateSize,
+        outer_states + lane * kSha512StateSize, blocks + lane * kHashSize,
+        iterations);
+  }
+}
+
+void Sha256SingleBlockBatch(
+    const uint8_t *const *messages, const size_t *sizes, size_t count,
+    uint8_t *hashes) {
+  static constexpr size_t kHashSize = kSha256StateSize * 4;
+  size_t offset = 0;
+#ifdef CFD_CORE_USE_X86_SIMD
+  if (IsSupportAvx2()) {
+    uint8_t blocks[kSha256Avx2LaneCount * kSha256BlockSize];
+    for (; offset + kSha256Avx2LaneCount <= count;
+         offset += kSha256Avx2LaneCount) {
+      memset(blocks, 0, sizeof(blocks));
+      for (size_t lane = 0; lane < kSha256Avx2LaneCount; ++lane) {
+        uint8_t *block = blocks + lane * kSha256BlockSize;
+        size_t size = sizes[offset + lane];
+        if (size != 0) memcpy(block, messages[offset + lane], size);
+        block[size] = 0x80;
+        WriteBigEndian(size * 8, 8, block + kSha256BlockSize - 8);
+      }
+      Sha256SingleBlockAvx2(blocks, hashes + offset * kHashSize);
+    }
+  }
+#endif  // CFD_CORE_USE_X86_SIMD
+  uint32_t state[kSha256StateSize];
+  for (; offset < count; ++offset) {
+    Sha256Initialize(state);
+    Sha256Finalize(
+        state, messages[offset], sizes[offset], sizes[offset],
+        hashes + offset * kHashSize);
+  }
+}
+
+}  // namespace core
+}  // namespace cfd
@@ -0,0 +1,109 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_sha2.h
+ * @brief SHA-2 compression functions for keyed hash contexts.
+ *
+ */
+#ifndef CFD_CORE_SRC_CFDCORE_SHA2_H_
+#define CFD_CORE_SRC_CFDCORE_SHA2_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cfd {
+namespace core {
+
+//! SHA-256 block size
+constexpr size_t kSha256BlockSize = 64;
+//! SHA-256 state count
+constexpr size_t kSha256StateSize = 8;
+//! SHA-256 maximum message size in a single block
+constexpr size_t kSha256SingleBlockMaxSize = kSha256BlockSize - 9;
+//! SHA-512 block size
+constexpr size_t kSha512BlockSize = 128;
+//! SHA-512 state count
+constexpr size_t kSha512StateSize = 8;
+
+/**
+ * @brief Set the SHA-256 initial state.
+ * @param[out] state    hash state
+ */
+void Sha256Initialize(uint32_t *state);
+
+/**
+ * @brief Process SHA-256 blocks.
+ * @param[in,out] state   hash state
+ * @param[in] blocks      block data
+ * @param[in] count       block count
+ */
+void Sha256Transform(uint32_t *state, const uint8_t *blocks, size_t count);
+
+/**
+ * @brief Process the last data and output the SHA-256 hash.
+ * @param[in] state       hash state
+ * @param[in] data        data after the processed blocks
+ * @param[in] size        data size
+ * @param[in] total_size  total byte size (including processed blocks)
+ * @param[out] hash       hash (32 bytes)
+ */
+void Sha256Finalize(
+    const uint32_t *state, const uint8_t *data, size_t size,
+    uint64_t total_size, uint8_t *hash);
+
+/**
+ * @brief Calculate SHA-256 of multiple single block messages.
+ * @details 8 messages are processed at once when AVX2 is available.
+ * @param[in] messages    message list
+ * @param[in] sizes       message size list (kSha256SingleBlockMaxSize or less)
+ * @param[in] count       message count
+ * @param[out] hashes     hash list (count * 32 bytes)
+ */
+void Sha256SingleBlockBatch(
+    const uint8_t *const *messages, const size_t *sizes, size_t count,
+    uint8_t *hashes);
+
+/**
+ * @brief Set the SHA-512 initial state.
+ * @param[out] state    hash state
+ */
+void Sha512Initialize(uint64_t *state);
+
+/**
+ * @brief Process SHA-512 blocks.
+ * @param[in,out] state   hash state
+ * @param[in] blocks      block data
+ * @param[in] count       block count
+ */
+void Sha512Transform(uint64_t *state, const uint8_t *blocks, size_t count);
+
+/**
+ * @brief Process the last data and output the SHA-512 hash.
+ * @param[in] state       hash state
+ * @param[in] data        data after the processed blocks
+ * @param[in] size        data size
+ * @param[in] total_size  total byte size (including processed blocks)
+ * @param[out] hash       hash (64 bytes)
+ */
+void Sha512Finalize(
+    const uint64_t *state, const uint8_t *data, size_t size,
+    uint64_t total_size, uint8_t *hash);
+
+/**
+ * @brief Run PBKDF2-HMAC-SHA512 iterations on multiple lanes.
+ * @details Each lane is an independent output block. U1 is calculated by
+ *     the caller, and U2 or later is calculated from the HMAC pad states.
+ *     4 lanes are processed at once when AVX2 is available.
+ * @param[in] inner_states    inner pad states (lane_count * 8 words)
+ * @param[in] outer_states    outer pad states (lane_count * 8 words)
+ * @param[in,out] blocks      in: U1, out: T (lane_count * 64 bytes)
+ * @param[in] lane_count      lane count
+ * @param[in] iterations      iteration count
+ */
+void Pbkdf2Sha512Iterate(
+    const uint64_t *inner_states, const uint64_t *outer_states,
+    uint8_t *blocks, size_t lane_count, uint32_t iterations);
+
+}  // namespace core
+}  // namespace cfd
+
+#endif  // CFD_CORE_SRC_CFDCORE_SHA2_H_
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_bytedata.h"
@@ -56,6 +57,16 @@ TapBranch::TapBranch(const TapBranch& tap_tree) {
   is_elements_ = tap_tree.is_elements_;
 }
 
+TapBranch::TapBranch(TapBranch&& branch) noexcept
+    : has_leaf_(branch.has_leaf_),
+      leaf_version_(branch.leaf_version_),
+      script_(std::move(branch.script_)),
+      root_commitment_(branch.root_commitment_),
+      branch_list_(std::move(branch.branch_list_)),
+      is_elements_(branch.is_elements_) {
+  // do nothing
+}
+
 void TapBranch::AddBranch(const SchnorrPubkey& pubkey) {
   AddBranch(pubkey.GetByteData256());
 }
@@ -90,6 +101,18 @@ TapBranch& TapBranch::operator=(const TapBranch& object) {
   return *this;
 }
 
+TapBranch& TapBranch::operator=(TapBranch&& object) noexcept {
+  if (this != &object) {
+    has_leaf_ = object.has_leaf_;
+    leaf_version_ = object.leaf_version_;
+    script_ = std::move(object.script_);
+    root_commitment_ = object.root_commitment_;
+    branch_list_ = std::move(object.branch_list_);
+    is_elements_ = object.is_elements_;
+  }
+  return *this;
+}
+
 ByteData256 TapBranch::GetBaseHash() const {
   if (!has_leaf_) return root_commitment_;
 
@@ -596,6 +619,20 @@ TaprootScriptTree& TaprootScriptTree::operator=(
   return *this;
 }
 
+TaprootScriptTree::TaprootScriptTree(TaprootScriptTree&& tap_tree) noexcept
+    : TapBranch(std::move(tap_tree)), nodes_(std::move(tap_tree.nodes_)) {
+  // do nothing
+}
+
+TaprootScriptTree& TaprootScriptTree::operator=(
+    TaprootScriptTree&& object) & noexcept {
+  if (this != &object) {
+    TapBranch::operator=(std::move(object));
+    nodes_ = std::move(object.nodes_);
+  }
+  return *this;
+}
+
 void TaprootScriptTree::AddBranch(const ByteData256& commitment) {
   TapBranch::AddBranch(commitment);
   nodes_.emplace_back(commitment);
@@ -0,0 +1,170 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_thread_util.cpp
+ *
+ * @brief thread internal utility.
+ *
+ */
+#include "cfdcore_thread_util.h"  // NOLINT
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace cfd {
+namespace core {
+
+//! maximum thread count of the worker pool
+static constexpr size_t kMaxWorkerPoolThreadCount = 64;
+
+/**
+ * @brief tasks of a RunOnWorkerPool call.
+ */
+struct WorkerPoolJob {
+  const std::function<void(size_t)>* task;  //!< task function
+  size_t task_count;                        //!< task count
+  std::atomic<size_t> next_index;           //!< next task index
+  std::atomic<size_t> done_count;           //!< finished task count
+  std::mutex mutex;                         //!< mutex of done_cv
+  std::condition_variable done_cv;          //!< notified on completion
+};
+
+/**
+ * @brief Run the unclaimed tasks of the job.
+ * @param[in,out] job   job
+ */
+static void RunWorkerPoolJob(WorkerPoolJob* job) {
+  size_t index;
+  while ((index = job->next_index.fetch_add(1)) < job->task_count) {
+    (*job->task)(index);
+    if ((job->done_count.fetch_add(1) + 1) == job->task_count) {
+      std::lock_guard<std::mutex> lock(job->mutex);
+      job->done_cv.notify_all();
+    }
+  }
+}
+
+/**
+ * @brief worker thread pool.
+ * @details The workers wait for the job queue and run the tasks of the
+ *     front job with the caller thread.
+ */
+class WorkerPool {
+ public:
+  /**
+   * @brief Get the process-wide pool.
+   * @details The pool is not destroyed, since the static destructors can
+   *     not safely join the threads (e.g. on the DLL unload).
+   * @return worker pool
+   */
+  static WorkerPool* GetInstance() {
+    static WorkerPool* pool = new WorkerPool();
+    return pool;
+  }
+
+  /**
+   * @brief Run the tasks.
+   * @param[in] task_count    task count
+   * @param[in] worker_count  maximum thread count including the caller
+   * @param[in] task          task function
+   */
+  void Run(
+      size_t task_count, size_t worker_count,
+      const std::function<void(size_t)>& task) {
+    auto job = std::make_shared<WorkerPoolJob>();
+    job->task = &task;
+    job->task_count = task_count;
+    job->next_index = 0;
+    job->done_count = 0;
+
+    bool is_queued = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      AddThreads(std::min(worker_count - 1, kMaxWorkerPoolThreadCount));
+      if (!threads_.empty()) {
+        job_queue_.push_back(job);
+        is_queued = true;
+      }
+    }
+    if (is_queued) job_cv_.notify_all();
+
+    RunWorkerPoolJob(job.get());
+    {
+      std::unique_lock<std::mutex> lock(job->mutex);
+      job->done_cv.wait(
+          lock, [&job]() { return job->done_count == job->task_count; });
+    }
+    if (is_queued) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto ite = std::find(job_queue_.begin(), job_queue_.end(), job);
+      if (ite != job_queue_.end()) job_queue_.erase(ite);
+    }
+  }
+
+ private:
+  std::mutex mutex_;                 //!< mutex of the queue and threads
+  std::condition_variable job_cv_;   //!< notified on the job queueing
+  std::deque<std::shared_ptr<WorkerPoolJob>> job_queue_;  //!< job queue
+  std::vector<std::thread> threads_;  //!< worker threads
+
+  /**
+   * @brief constructor.
+   */
+  WorkerPool() : mutex_(), job_cv_(), job_queue_(), threads_() {}
+
+  /**
+   * @brief Add the worker threads. (need the lock)
+   * @details If a thread can not be created, the pool keeps the current
+   *     threads. (The caller thread runs the remaining tasks.)
+   * @param[in] thread_count    target thread count
+   */
+  void AddThreads(size_t thread_count) {
+    while (threads_.size() < thread_count) {
+      try {
+        threads_.emplace_back(&WorkerPool::WorkerMain, this);
+      } catch (...) {
+        break;  // thread creation failed. (e.g. std::system_error)
+      }
+    }
+  }
+
+  /**
+   * @brief main function of the worker thread.
+   */
+  void WorkerMain() {
+    while (true) {
+      std::shared_ptr<WorkerPoolJob> job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        job_cv_.wait(lock, [this]() { return !job_queue_.empty(); });
+        job = job_queue_.front();
+        if (job->next_index >= job->task_count) {
+          // all tasks are claimed.
+          job_queue_.pop_front();
+          continue;
+        }
+      }
+      RunWorkerPoolJob(job.get());
+    }
+  }
+};
+
+void RunOnWorkerPool(
+    size_t task_count, size_t worker_count,
+    const std::function<void(size_t)>& task) {
+  if (task_count == 0) return;
+  if ((task_count == 1) || (worker_count <= 1)) {
+    for (size_t index = 0; index < task_count; ++index) task(index);
+    return;
+  }
+  WorkerPool::GetInstance()->Run(task_count, worker_count, task);
+}
+
+}  // namespace core
+}  // namespace cfd
@@ -0,0 +1,102 @@
+// Copyright 2021 CryptoGarage
+/**
+ * @file cfdcore_thread_util.h
+ *
+ * @brief thread internal utility.
+ *
+ */
+#ifndef CFD_CORE_SRC_CFDCORE_THREAD_UTIL_H_
+#define CFD_CORE_SRC_CFDCORE_THREAD_UTIL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace cfd {
+namespace core {
+
+/**
+ * @brief Run the tasks on the worker pool.
+ * @details The worker threads are created on demand and reused by the
+ *     later calls. The caller thread also runs the tasks, so all tasks are
+ *     finished even if no worker thread can be created or all workers are
+ *     busy (e.g. a nested call from a task).
+ * @param[in] task_count    task count
+ * @param[in] worker_count  maximum thread count including the caller
+ * @param[in] task          task function: void(size_t task_index).
+ *     It must not throw.
+ */
+void RunOnWorkerPool(
+    size_t task_count, size_t worker_count,
+    const std::function<void(size_t)>& task);
+
+/**
+ * @brief Split the index range and run the function on worker threads.
+ * @details If the range is small, the function runs on the caller thread.
+ *     The ranges run on the threads of the worker pool and the caller
+ *     thread. The first exception thrown by the function is rethrown after
+ *     all ranges are finished.
+ * @param[in] count         total index count
+ * @param[in] thread_count  worker thread count (0: hardware concurrency)
+ * @param[in] min_unit      minimum index count per thread
+ * @param[in] function      function: void(size_t begin, size_t end)
+ */
+template <class Function>
+void ParallelFor(
+    size_t count, uint32_t thread_count, size_t min_unit,
+    const Function& function) {
+  size_t worker_count =
+      (thread_count != 0) ? thread_count : std::thread::hardware_concurrency();
+  worker_count = std::min(worker_count, count / std::max<size_t>(min_unit, 1));
+  if (worker_count <= 1) {
+    if (count != 0) function(0, count);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(worker_count);
+  size_t unit = (count + worker_count - 1) / worker_count;
+  RunOnWorkerPool(
+      worker_count, worker_count,
+      [&function, &errors, unit, count](size_t worker) {
+        size_t begin = std::min(worker * unit, count);
+        size_t end = std::min(begin + unit, count);
+        try {
+          if (begin < end) function(begin, end);
+        } catch (...) {
+          errors[worker] = std::current_exception();
+        }
+      });
+  for (const auto& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+/**
+ * @brief Collect the result of the batch verification.
+ * @param[in] results           result of each item (1: valid)
+ * @param[out] invalid_indexes  indexes of the invalid items (optional)
+ * @retval true   all items are valid.
+ * @retval false  any item is invalid.
+ */
+inline bool CollectBatchResult(
+    const std::vector<uint8_t>& results,
+    std::vector<uint32_t>* invalid_indexes) {
+  bool is_all_valid = true;
+  if (invalid_indexes != nullptr) invalid_indexes->clear();
+  for (size_t index = 0; index < results.size(); ++index) {
+    if (results[index] == 1) continue;
+    is_all_valid = false;
+    if (invalid_indexes == nullptr) break;
+    invalid_indexes->push_back(static_cast<uint32_t>(index));
+  }
+  return is_all_valid;
+}
+
+}  // namespace core
+}  // namespace cfd
+
+#endif  // CFD_CORE_SRC_CFDCORE_THREAD_UTIL_H_
@@ -8,6 +8,7 @@
 
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "cfdcore/cfdcore_bytedata.h"
@@ -216,80 +217,96 @@ Transaction::Transaction(const std::string &hex_string) : vin_(), vout_() {
 }
 
 Transaction::Transaction(const ByteData &byte_data) : vin_(), vout_() {
-  SetFromHex(byte_data.GetHex());
+  SetFromBytes(ByteSpan(byte_data));
+}
+
+Transaction::Transaction(const ByteData &byte_data, ScriptPool *script_pool)
+    : vin_(), vout_() {
+  SetFromBytes(ByteSpan(byte_data), script_pool);
 }
 
 Transaction::Transaction(const Transaction &transaction)
-    : Transaction(transaction.GetHex()) {
+    : Transaction(transaction.GetData()) {
   // copy constructor
 }
 
-bool Transaction::CheckTxOutBuffer(
-    const uint8_t *buffer, size_t buf_size, uint64_t txout_num,
-    size_t txout_num_size, void *tx_pointer, std::vector<TxOut> *txout_list) {
-  bool is_success = false;
-  if (buf_size > txout_num_size) {
-    size_t data_size = buf_size - txout_num_size;
-    size_t offset = 0;
-    const uint8_t *address_pointer = buffer;
-    address_pointer += txout_num_size;
-    bool is_error = false;
+Transaction::Transaction(Transaction &&transaction) noexcept
+    : vin_(std::move(transaction.vin_)),
+      vout_(std::move(transaction.vout_)) {
+  wally_tx_pointer_ = transaction.wally_tx_pointer_;
+  transaction.wally_tx_pointer_ = NULL;
+}
+
+/**
+ * @brief Parse the transaction that has no txin and one or more txout.
+ * @details libwally can not parse this format. (it is misidentified as
+ *     the witness marker)
+ * @param[in] data          transaction data
+ * @param[in] script_pool   script pool (nullptr is not interned)
+ * @param[out] tx_pointer   wally tx
+ * @param[out] txout_list   TxOut array
+ * @retval true   parse OK
+ * @retval false  invalid format
+ */
+static bool ParseTxOutOnlyTransaction(
+    const ByteSpan &data, ScriptPool *script_pool,
+    struct wally_tx **tx_pointer, std::vector<TxOut> *txout_list) {
+  uint32_t version = 0;
+  uint32_t lock_time = 0;
+  std::vector<uint64_t> amounts;
+  std::vector<ByteSpan> scripts;
+  try {
+    Deserializer parser(data);
+    version = parser.ReadUint32();
+    if (parser.ReadUint8() != 0) {
+      // marker is 1 or txin is greater than 1
+      // Since type can be analyzed with libwally, treated as invalid data.
+      return false;
+    }
+    // txin is 0 (or marker is 0)
+    uint64_t txout_num = parser.ReadVariableInt();
     for (uint64_t index = 0; index < txout_num; ++index) {
-      const uint8_t *work_address = &address_pointer[offset];
-      size_t limit = data_size - offset;
-      size_t total = 0;
-      // check for value
-      if (limit <= sizeof(int64_t)) {
-        is_error = true;
-        break;
-      }
-      uint64_t amount;
-      memcpy(&amount, work_address, sizeof(amount));
-      work_address += sizeof(uint64_t);
-      limit -= sizeof(uint64_t);
-      total += sizeof(uint64_t);
-      // Check locking script
-      uint64_t script_size = 0;
-      size_t vnum_size = 0;
-      if (!GetVariableInt(work_address, limit, &script_size, &vnum_size)) {
-        is_error = true;
-        break;
-      } else if (limit < (vnum_size + script_size)) {
-        is_error = true;
-        break;
-      }
-      work_address += vnum_size;
-      total += vnum_size + script_size;
-      offset += total;
-
-      // Copy of TxOut
-      if (tx_pointer != NULL) {
-        int ret = wally_tx_add_raw_output(
-            static_cast<struct wally_tx *>(tx_pointer), amount, work_address,
-            script_size, 0);
-        if (ret != WALLY_OK) {
-          warn(CFD_LOG_SOURCE, "wally_tx_add_raw_output NG[{}].", ret);
-          throw CfdException(kCfdIllegalStateError, "vout add error.");
-        }
-      }
-      if (txout_list != nullptr) {
-        std::vector<uint8_t> byte_array(script_size);
-        memcpy(byte_array.data(), work_address, byte_array.size());
-        TxOut out(
-            Amount::CreateBySatoshiAmount(amount),
-            Script(ByteData(byte_array)));
-        txout_list->push_back(out);
-      }
+      amounts.push_back(parser.ReadUint64());
+      scripts.push_back(parser.ReadVariableSpan());
     }
+    lock_time = parser.ReadUint32();
+    if (!parser.HasEof()) return false;
+  } catch (const CfdException &) {
+    return false;
+  }
 
-    if ((!is_error) && (data_size == offset)) {
-      is_success = true;
+  int ret = wally_tx_init_alloc(version, lock_time, 0, 0, tx_pointer);
+  if (ret != WALLY_OK) {
+    warn(CFD_LOG_SOURCE, "wally_tx_init_alloc NG[{}] ", ret);
+    throw CfdException(
+        kCfdIllegalArgumentError, "transaction data generate error.");
+  }
+  info(CFD_LOG_SOURCE, "call wally_tx_init_alloc");
+  for (size_t index = 0; index < amounts.size(); ++index) {
+    const ByteSpan &script = scripts[index];
+    ret = wally_tx_add_raw_output(
+        *tx_pointer, amounts[index], script.data(), script.size(), 0);
+    if (ret != WALLY_OK) {
+      wally_tx_free(*tx_pointer);
+      *tx_pointer = NULL;
+      warn(CFD_LOG_SOURCE, "wally_tx_add_raw_output NG[{}].", ret);
+      throw CfdException(kCfdIllegalStateError, "vout add error.");
     }
+    txout_list->push_back(TxOut(
+        Amount::CreateBySatoshiAmount(amounts[index]),
+        (script_pool != nullptr) ? script_pool->Intern(script)
+                                 : Script(script.GetData())));
   }
-  return is_success;
+  return true;
 }
 
 void Transaction::SetFromHex(const std::string &hex_string) {
+  ByteData tx_byte = StringUtil::StringToByte(hex_string);
+  SetFromBytes(ByteSpan(tx_byte));
+}
+
+void Transaction::SetFromBytes(
+    const ByteSpan &data, ScriptPool *script_pool) {
   void *original_address = wally_tx_pointer_;
   bool append_txout = false;
   std::vector<TxIn> vin_work;
@@ -298,10 +315,10 @@ void Transaction::SetFromHex(const std::string &hex_string) {
   // It is assumed that tx information has been created.
   // (If it is not created, it will cause inconsistency)
   struct wally_tx *tx_pointer = NULL;
-  int ret = wally_tx_from_hex(hex_string.c_str(), 0, &tx_pointer);
+  int ret = wally_tx_from_bytes(data.data(), data.size(), 0, &tx_pointer);
   if (ret == WALLY_OK) {
     if ((tx_pointer->num_inputs == 0) && (tx_pointer->num_outputs == 0) &&
-        (hex_string.size() > kTransactionMinimumHexSize)) {
+        (data.size() > kTransactionMinimumSize)) {
       // Judged as an invalid analysis condition when txin is 0 and txout is 1,
       // and enters the exception route
       // (libwally misidentifies as witness tx)
@@ -311,76 +328,17 @@ void Transaction::SetFromHex(const std::string &hex_string) {
     }
   }
 
-  if (ret == WALLY_EINVAL) {
-    ByteData tx_byte = StringUtil::StringToByte(hex_string);
-    const std::vector<uint8_t> &tx_buf = tx_byte.GetBytes();
-    const uint8_t *address_pointer = tx_buf.data();
-
-    // If the minimum size, perform analysis
-    if (hex_string.size() >= kTransactionMinimumHexSize) {
-      uint32_t version = 0;
-      uint32_t lock_time = 0;
-      memcpy(&version, address_pointer, sizeof(version));
-      address_pointer += sizeof(version);
-      if (*address_pointer != 0) {
-        // marker is 1 or txin is greater than 1
-        // Since type can be analyzed with libwally, treated as invalid data.
-      } else {
-        // txin is 0 or marker is 0
-        ++address_pointer;
-        if ((*address_pointer == 0) &&
-            (hex_string.size() == kTransactionMinimumHexSize)) {
-          // txout is 0
-          ++address_pointer;
-          memcpy(&lock_time, address_pointer, sizeof(lock_time));
-          ret = wally_tx_init_alloc(version, lock_time, 0, 0, &tx_pointer);
-          if (ret != WALLY_OK) {
-            warn(CFD_LOG_SOURCE, "wally_tx_init_alloc NG[{}] ", ret);
-            throw CfdException(
-                kCfdIllegalArgumentError, "transaction data generate error.");
-          }
-          info(CFD_LOG_SOURCE, "call wally_tx_init_alloc");
-        } else {
-          // Check remaining size and check if txin is 0 and txout is 1 or more
-          const uint8_t *start_address = tx_buf.data();
-          size_t size = address_pointer - start_address;
-          uint64_t txout_num = 0;
-          size_t num_size = 0;
-          // Subtract the size up to the txout area and the locktime
-          // from the txbuf size.
-          size_t buf_size = tx_buf.size() - size - sizeof(uint32_t);
-          if (!GetVariableInt(
-                  address_pointer, buf_size, &txout_num, &num_size)) {
-            // Invalid
-          } else if (!CheckTxOutBuffer(
-                         address_pointer, buf_size, txout_num, num_size)) {
-            // Invalid
-          } else {
-            // txout OK
-            // locktime copy
-            const uint8_t *work_address = address_pointer + buf_size;
-            memcpy(&lock_time, work_address, sizeof(lock_time));
-            ret = wally_tx_init_alloc(version, lock_time, 0, 0, &tx_pointer);
-            if (ret != WALLY_OK) {
-              warn(CFD_LOG_SOURCE, "wally_tx_init_alloc NG[{}] ", ret);
-              throw CfdException(
-                  kCfdIllegalArgumentError,
-                  "transaction data generate error.");
-            }
-            info(CFD_LOG_SOURCE, "call wally_tx_init_alloc");
-            append_txout = true;
-            // Add data to TxOut again
-            CheckTxOutBuffer(
-                address_pointer, buf_size, txout_num, num_size, tx_pointer,
-                &vout_work);
-          }
-        }
-      }
+  // If the minimum size, perform analysis
+  if ((ret == WALLY_EINVAL) && (data.size() >= kTransactionMinimumSize)) {
+    if (ParseTxOutOnlyTransaction(
+            data, script_pool, &tx_pointer, &vout_work)) {
+      append_txout = true;
+      ret = WALLY_OK;
     }
   }
 
   if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_tx_from_hex NG[{}] ", ret);
+    warn(CFD_LOG_SOURCE, "wally_tx_from_bytes NG[{}] ", ret);
     throw CfdException(kCfdIllegalArgumentError, "transaction data invalid.");
   }
   wally_tx_pointer_ = tx_pointer;
@@ -391,13 +349,12 @@ void Transaction::SetFromHex(const std::string &hex_string) {
       struct wally_tx_input *txin_item = &tx_pointer->inputs[index];
       std::vector<uint8_t> txid_buf(
           txin_item->txhash, txin_item->txhash + sizeof(txin_item->txhash));
-      std::vector<uint8_t> script_buf(
-          txin_item->script, txin_item->script + txin_item->script_len);
       Txid txid = Txid(ByteData256(txid_buf));
       OutPoint out_point(txid, txin_item->index);
       // TODO(k-matsuzawa): ignore size checks for coinbase scripts
-      Script unlocking_script =
-          Script(ByteData(script_buf), out_point.IsCoinBase());
+      Script unlocking_script = Script(
+          ByteSpan(txin_item->script, txin_item->script_len).GetData(),
+          out_point.IsCoinBase());
       /* Temporarily comment out
       if (!unlocking_script.IsPushOnly()) {
         warn(CFD_LOG_SOURCE, "IsPushOnly() false.");
@@ -413,10 +370,9 @@ void Transaction::SetFromHex(const std::string &hex_string) {
              ++w_index) {
           struct wally_tx_witness_item *witness_stack;
           witness_stack = &txin_item->witness->items[w_index];
-          const std::vector<uint8_t> witness_buf(
-              witness_stack->witness,
-              witness_stack->witness + witness_stack->witness_len);
-          txin.AddScriptWitnessStack(ByteData(witness_buf));
+          txin.AddScriptWitnessStack(
+              ByteSpan(witness_stack->witness, witness_stack->witness_len)
+                  .GetData());
         }
       }
       vin_work.push_back(txin);
@@ -426,11 +382,11 @@ void Transaction::SetFromHex(const std::string &hex_string) {
     if (!append_txout) {
       for (size_t index = 0; index < tx_pointer->num_outputs; ++index) {
         struct wally_tx_output *txout_item = &tx_pointer->outputs[index];
-        std::vector<uint8_t> script_buf(
-            txout_item->script, txout_item->script + txout_item->script_len);
+        ByteSpan script(txout_item->script, txout_item->script_len);
         TxOut txout(
             Amount::CreateBySatoshiAmount(txout_item->satoshi),
-            Script(ByteData(script_buf)));
+            (script_pool != nullptr) ? script_pool->Intern(script)
+                                     : Script(script.GetData()));
         vout_work.push_back(txout);
       }
     }
@@ -440,8 +396,8 @@ void Transaction::SetFromHex(const std::string &hex_string) {
       vin_.clear();
       vout_.clear();
     }
-    vin_ = vin_work;
-    vout_ = vout_work;
+    vin_ = std::move(vin_work);
+    vout_ = std::move(vout_work);
   } catch (const CfdException &exception) {
     // free on error
     wally_tx_free(tx_pointer);
@@ -457,7 +413,18 @@ void Transaction::SetFromHex(const std::string &hex_string) {
 
 Transaction &Transaction::operator=(const Transaction &transaction) & {
   if (this != &transaction) {
-    SetFromHex(transaction.GetHex());
+    ByteData tx_data = transaction.GetData();
+    SetFromBytes(ByteSpan(tx_data));
+  }
+  return *this;
+}
+
+Transaction &Transaction::operator=(Transaction &&transaction) & noexcept {
+  if (this != &transaction) {
+    // the old buffer is freed by the moved-from object
+    std::swap(wally_tx_pointer_, transaction.wally_tx_pointer_);
+    vin_.swap(transaction.vin_);
+    vout_.swap(transaction.vout_);
   }
   return *this;
 }
@@ -764,38 +731,20 @@ ByteData256 Transaction::GetSignatureHash(
   }
   std::vector<uint8_t> buffer(SHA256_LEN);
   const std::vector<uint8_t> &bytes = script_data.GetBytes();
-  struct wally_tx *tx_pointer = NULL;
-  int ret = WALLY_OK;
-
-  // It is assumed that tx information has been created.
-  // (If it is not created, it will cause inconsistency)
-  const std::vector<uint8_t> &tx_bytedata =
-      GetByteData(HasWitness()).GetBytes();
-  ret = wally_tx_from_bytes(
-      tx_bytedata.data(), tx_bytedata.size(), 0, &tx_pointer);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_tx_from_bytes NG[{}] ", ret);
-    throw CfdException(kCfdIllegalArgumentError, "transaction data invalid.");
-  }
-
-  ret = WALLY_ENOMEM;
-  if (tx_pointer != NULL) {
-    try {
-      uint32_t tx_flag = 0;
-      if (version != WitnessVersion::kVersionNone) {
-        tx_flag = GetWallyFlag() & WALLY_TX_FLAG_USE_WITNESS;
-      }
-      ret = wally_tx_get_btc_signature_hash(
-          tx_pointer, txin_index, bytes.data(), bytes.size(),
-          value.GetSatoshiValue(), sighash_type.GetSigHashFlag(), tx_flag,
-          buffer.data(), buffer.size());
-      wally_tx_free(tx_pointer);
-    } catch (...) {
-      wally_tx_free(tx_pointer);  // Separately released in case of exception
-                                  // (possibility of exception by warn ())
-      warn(CFD_LOG_SOURCE, "wally_tx_get_btc_signature_hash cause exception.");
-      ret = WALLY_ERROR;
+  const struct wally_tx *tx_pointer =
+      static_cast<const struct wally_tx *>(wally_tx_pointer_);
+  int ret = WALLY_EINVAL;
+  if (tx_pointer != nullptr) {
+    // The wally tx is kept in sync with vin_/vout_, so it is used directly
+    // instead of the serialize and parse round trip.
+    uint32_t tx_flag = 0;
+    if (version != WitnessVersion::kVersionNone) {
+      tx_flag = GetWallyFlag() & WALLY_TX_FLAG_USE_WITNESS;
     }
+    ret = wally_tx_get_btc_signature_hash(
+        tx_pointer, txin_index, bytes.data(), bytes.size(),
+        value.GetSatoshiValue(), sighash_type.GetSigHashFlag(), tx_flag,
+        buffer.data(), buffer.size());
   }
 
   if (ret != WALLY_OK) {
@@ -851,74 +800,80 @@ ByteData256 Transaction::GetSchnorrSignatureHash(
   }
   ext_flag |= has_tap_script;
 
-  Serializer builder;
-  auto top = HashUtil::Sha256("TapSighash");
-  builder.AddDirectBytes(top);
-  builder.AddDirectBytes(top);  // double data
-  builder.AddDirectByte(0);     // EPOCH
+  const struct wally_tx *tx_pointer =
+      static_cast<const struct wally_tx *>(wally_tx_pointer_);
+  Serializer builder = Serializer::CreateTaggedSha256Sink("TapSighash");
+  builder.AddDirectByte(0);  // EPOCH
   builder.AddDirectByte(static_cast<uint8_t>(sighash_type.GetSigHashFlag()));
   builder.AddDirectNumber(static_cast<uint32_t>(GetVersion()));
   builder.AddDirectNumber(GetLockTime());
   if (!is_anyone_can_pay) {
-    Serializer prevouts_buf;
-    Serializer amounts_buf;
-    Serializer scripts_buf;
-    Serializer sequences_buf;
-    for (size_t index = 0; index < vin_.size(); ++index) {
-      prevouts_buf.AddDirectBytes(vin_[index].GetTxid().GetData());
-      prevouts_buf.AddDirectNumber(vin_[index].GetVout());
+    Serializer prevouts_buf = Serializer::CreateSha256Sink();
+    Serializer amounts_buf = Serializer::CreateSha256Sink();
+    Serializer scripts_buf = Serializer::CreateSha256Sink();
+    Serializer sequences_buf = Serializer::CreateSha256Sink();
+    for (size_t index = 0; index < tx_pointer->num_inputs; ++index) {
+      const struct wally_tx_input *input = tx_pointer->inputs + index;
+      prevouts_buf.AddDirectBytes(input->txhash, sizeof(input->txhash));
+      prevouts_buf.AddDirectNumber(input->index);
       amounts_buf.AddDirectNumber(
           utxo_list[index].GetValue().GetSatoshiValue());
       scripts_buf.AddVariableBuffer(
           utxo_list[index].GetLockingScript().GetData());
-      sequences_buf.AddDirectNumber(vin_[index].GetSequence());
+      sequences_buf.AddDirectNumber(input->sequence);
     }
-    builder.AddDirectBytes(HashUtil::Sha256(prevouts_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(amounts_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(scripts_buf.Output()));
-    builder.AddDirectBytes(HashUtil::Sha256(sequences_buf.Output()));
+    builder.AddDirectBytes(prevouts_buf.OutputSha256());
+    builder.AddDirectBytes(amounts_buf.OutputSha256());
+    builder.AddDirectBytes(scripts_buf.OutputSha256());
+    builder.AddDirectBytes(sequences_buf.OutputSha256());
   }
   if (has_sighash_all) {
-    Serializer outputs_buf;
-    for (const auto &txout : vout_) {
-      outputs_buf.AddDirectNumber(txout.GetValue().GetSatoshiValue());
-      outputs_buf.AddVariableBuffer(txout.GetLockingScript().GetData());
+    Serializer outputs_buf = Serializer::CreateSha256Sink();
+    for (size_t index = 0; index < tx_pointer->num_outputs; ++index) {
+      const struct wally_tx_output *output = tx_pointer->outputs + index;
+      outputs_buf.AddDirectNumber(output->satoshi);
+      outputs_buf.AddVariableBuffer(
+          output->script, static_cast<uint32_t>(output->script_len));
     }
-    builder.AddDirectBytes(HashUtil::Sha256(outputs_buf.Output()));
+    builder.AddDirectBytes(outputs_buf.OutputSha256());
   }
 
   uint8_t spend_type = (ext_flag << 1) + (annex.IsEmpty() ? 0 : 1);
   builder.AddDirectByte(spend_type);
   if (is_anyone_can_pay) {
-    builder.AddDirectBytes(vin_[txin_index].GetTxid().GetData());
-    builder.AddDirectNumber(vin_[txin_index].GetVout());
+    const struct wally_tx_input *input = tx_pointer->inputs + txin_index;
+    builder.AddDirectBytes(input->txhash, sizeof(input->txhash));
+    builder.AddDirectNumber(input->index);
     builder.AddDirectNumber(
         utxo_list[txin_index].GetValue().GetSatoshiValue());
     builder.AddVariableBuffer(
         utxo_list[txin_index].GetLockingScript().GetData());
-    builder.AddDirectNumber(vin_[txin_index].GetSequence());
+    builder.AddDirectNumber(input->sequence);
   } else {
     builder.AddDirectNumber(txin_index);
   }
 
-  if (!annex.IsEmpty()) builder.AddDirectBytes(HashUtil::Sha256(annex));
+  if (!annex.IsEmpty()) {
+    // sha_annex: SHA256(compact_size(size of annex) || annex)
+    builder.AddDirectBytes(HashUtil::Sha256(annex.Serialize()));
+  }
 
   if (sighash_type.GetSigHashAlgorithm() == SigHashAlgorithm::kSigHashSingle) {
     CheckTxOutIndex(txin_index, __LINE__, __FUNCTION__);
-    Serializer outputs_buf;
-    outputs_buf.AddDirectNumber(
-        vout_[txin_index].GetValue().GetSatoshiValue());
+    const struct wally_tx_output *output = tx_pointer->outputs + txin_index;
+    Serializer outputs_buf = Serializer::CreateSha256Sink();
+    outputs_buf.AddDirectNumber(output->satoshi);
     outputs_buf.AddVariableBuffer(
-        vout_[txin_index].GetLockingScript().GetData());
-    builder.AddDirectBytes(HashUtil::Sha256(outputs_buf.Output()));
+        output->script, static_cast<uint32_t>(output->script_len));
+    builder.AddDirectBytes(outputs_buf.OutputSha256());
   }
 
   if (has_tap_script == 1) {
-    builder.AddDirectBytes(script_data->tap_leaf_hash.GetData());
+    builder.AddDirectBytes(script_data->tap_leaf_hash);
     builder.AddDirectByte(key_version);
     builder.AddDirectNumber(script_data->code_separator_position);
   }
-  return HashUtil::Sha256(builder.Output());
+  return builder.OutputSha256();
 }
 
 bool Transaction::HasWitness() const {
@@ -936,6 +891,17 @@ ByteData Transaction::GetByteData(bool has_witness) const {
   return ConvertBitcoinTxFromWally(tx_pointer, !has_witness);
 }
 
+void Transaction::WriteByteData(
+    bool has_witness, Serializer *serializer) const {
+  if (serializer == nullptr) {
+    warn(CFD_LOG_SOURCE, "serializer is null.");
+    throw CfdException(kCfdIllegalArgumentError, "serializer is null.");
+  }
+  SerializeBitcoinTxFromWally(
+      static_cast<const struct wally_tx *>(wally_tx_pointer_), !has_witness,
+      serializer);
+}
+
 uint32_t Transaction::GetWallyFlag() const {
   return WALLY_TX_FLAG_USE_WITNESS;
 }
@@ -1030,48 +996,7 @@ ByteData ConvertBitcoinTxFromWally(
         }
 
         Serializer builder(static_cast<uint32_t>(need_size));
-        builder.AddDirectNumber(tx->version);
-        if ((flags != 0) && (tx->num_inputs != 0)) {  // witness
-          builder.AddDirectByte(0);                   // marker is 0
-          builder.AddDirectByte(1);                   // flag is 1(witness)
-        }
-
-        builder.AddVariableInt(tx->num_inputs);
-        for (uint32_t i = 0; i < tx->num_inputs; ++i) {
-          const struct wally_tx_input *input = tx->inputs + i;
-          builder.AddDirectBytes(input->txhash, sizeof(input->txhash));
-          builder.AddDirectNumber(input->index);
-          builder.AddVariableBuffer(
-              input->script, static_cast<uint32_t>(input->script_len));
-          builder.AddDirectNumber(input->sequence);
-        }
-
-        builder.AddVariableInt(tx->num_outputs);
-        for (uint32_t i = 0; i < tx->num_outputs; ++i) {
-          const struct wally_tx_output *output = tx->outputs + i;
-          builder.AddDirectNumber(output->satoshi);
-          builder.AddVariableBuffer(
-              output->script, static_cast<uint32_t>(output->script_len));
-        }
-
-        if (flags != 0) {  // witness
-          for (uint32_t i = 0; i < tx->num_inputs; ++i) {
-            const struct wally_tx_input *input = tx->inputs + i;
-            uint32_t num_items =
-                input->witness
-                    ? static_cast<uint32_t>(input->witness->num_items)
-                    : 0;
-            builder.AddVariableInt(num_items);
-            for (uint32_t j = 0; j < num_items; ++j) {
-              const struct wally_tx_witness_item *stack;
-              stack = input->witness->items + j;
-              builder.AddVariableBuffer(
-                  stack->witness, static_cast<uint32_t>(stack->witness_len));
-            }
-          }
-        }
-
-        builder.AddDirectNumber(tx->locktime);
+        SerializeBitcoinTxFromWally(tx, force_exclude_witness, &builder);
         return builder.Output();
       } else {
         warn(CFD_LOG_SOURCE, "wally_tx_to_bytes NG[{}].", ret);
@@ -1092,5 +1017,62 @@ ByteData ConvertBitcoinTxFromWally(
   }
 }
 
+void SerializeBitcoinTxFromWally(
+    const struct wally_tx *tx, bool force_exclude_witness,
+    Serializer *serializer) {
+  size_t witness_count = 0;
+  if (!force_exclude_witness) {
+    int ret = wally_tx_get_witness_count(tx, &witness_count);
+    if (ret != WALLY_OK) {
+      warn(CFD_LOG_SOURCE, "wally_tx_get_witness_count NG[{}]", ret);
+      throw CfdException(
+          kCfdIllegalStateError, "psbt witness count get error.");
+    }
+  }
+  bool has_witness = (witness_count != 0);
+
+  serializer->AddDirectNumber(tx->version);
+  if (has_witness && (tx->num_inputs != 0)) {
+    serializer->AddDirectByte(0);  // marker is 0
+    serializer->AddDirectByte(1);  // flag is 1(witness)
+  }
+
+  serializer->AddVariableInt(tx->num_inputs);
+  for (uint32_t i = 0; i < tx->num_inputs; ++i) {
+    const struct wally_tx_input *input = tx->inputs + i;
+    serializer->AddDirectBytes(input->txhash, sizeof(input->txhash));
+    serializer->AddDirectNumber(input->index);
+    serializer->AddVariableBuffer(
+        input->script, static_cast<uint32_t>(input->script_len));
+    serializer->AddDirectNumber(input->sequence);
+  }
+
+  serializer->AddVariableInt(tx->num_outputs);
+  for (uint32_t i = 0; i < tx->num_outputs; ++i) {
+    const struct wally_tx_output *output = tx->outputs + i;
+    serializer->AddDirectNumber(output->satoshi);
+    serializer->AddVariableBuffer(
+        output->script, static_cast<uint32_t>(output->script_len));
+  }
+
+  if (has_witness) {
+    for (uint32_t i = 0; i < tx->num_inputs; ++i) {
+      const struct wally_tx_input *input = tx->inputs + i;
+      uint32_t num_items =
+          input->witness ? static_cast<uint32_t>(input->witness->num_items)
+                         : 0;
+      serializer->AddVariableInt(num_items);
+      for (uint32_t j = 0; j < num_items; ++j) {
+        const struct wally_tx_witness_item *stack;
+        stack = input->witness->items + j;
+        serializer->AddVariableBuffer(
+            stack->witness, static_cast<uint32_t>(stack->witness_len));
+      }
+    }
+  }
+
+  serializer->AddDirectNumber(tx->locktime);
+}
+
 }  // namespace core
 }  // namespace cfd
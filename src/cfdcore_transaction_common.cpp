@@ -235,14 +235,7 @@ ByteData SignatureUtil::CalculateEcSignature(
 bool SignatureUtil::VerifyEcSignature(
     const ByteData256 &signature_hash, const Pubkey &pubkey,
     const ByteData &signature) {
-  std::vector<uint8_t> pubkey_data = pubkey.GetData().GetBytes();
-  std::vector<uint8_t> sighash = signature_hash.GetBytes();
-  std::vector<uint8_t> signature_data = signature.GetBytes();
-  int flag = EC_FLAG_ECDSA;
-  int ret = wally_ec_sig_verify(
-      pubkey_data.data(), pubkey_data.size(), sighash.data(), sighash.size(),
-      flag, signature_data.data(), signature_data.size());
-  return ret == WALLY_OK;
+  return pubkey.VerifyEcSignature(signature_hash, signature);
 }
 
 // -----------------------------------------------------------------------------
@@ -637,15 +630,25 @@ ByteData256 AbstractTransaction::GetWitnessHash() const {
 }
 
 ByteData256 AbstractTransaction::GetHash(bool has_witness) const {
-  ByteData buffer = GetByteData(has_witness);
+  Serializer sink = Serializer::CreateSha256Sink();
+  WriteByteData(has_witness, &sink);
   // sha256d hash
-  return HashUtil::Sha256D(buffer.GetBytes());
+  return sink.OutputSha256d();
 }
 
 ByteData AbstractTransaction::GetData() const {
   return GetByteData(HasWitness());
 }
 
+void AbstractTransaction::WriteByteData(
+    bool has_witness, Serializer *serializer) const {
+  if (serializer == nullptr) {
+    warn(CFD_LOG_SOURCE, "serializer is null.");
+    throw CfdException(kCfdIllegalArgumentError, "serializer is null.");
+  }
+  serializer->AddDirectBytes(GetByteData(has_witness));
+}
+
 std::string AbstractTransaction::GetHex() const { return GetData().GetHex(); }
 
 Txid AbstractTransaction::GetTxid() const {
@@ -24,6 +24,16 @@ namespace core {
 extern ByteData ConvertBitcoinTxFromWally(
     const struct wally_tx *tx, bool force_exclude_witness);
 
+/**
+ * @brief serialize bitcoin transaction from wally tx.
+ * @param[in] tx  wally tx
+ * @param[in] force_exclude_witness  exclude witness force flag.
+ * @param[in,out] serializer  serializer
+ */
+extern void SerializeBitcoinTxFromWally(
+    const struct wally_tx *tx, bool force_exclude_witness,
+    Serializer *serializer);
+
 }  // namespace core
 }  // namespace cfd
 
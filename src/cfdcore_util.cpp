@@ -8,8 +8,11 @@
 #include "cfdcore/cfdcore_util.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <ctime>
 #include <iterator>
+#include <limits>
 #include <random>
 #include <set>
 #include <sstream>
@@ -18,7 +21,17 @@
 
 #include "cfdcore/cfdcore_exception.h"
 #include "cfdcore/cfdcore_logger.h"
-#include "cfdcore_wally_util.h"  // NOLINT
+#include "cfdcore_aes.h"          // NOLINT
+#include "cfdcore_chacha20.h"     // NOLINT
+#include "cfdcore_cpu.h"          // NOLINT
+#include "cfdcore_random.h"       // NOLINT
+#include "cfdcore_sha2.h"         // NOLINT
+#include "cfdcore_thread_util.h"  // NOLINT
+#include "cfdcore_wally_util.h"   // NOLINT
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
 
 namespace cfd {
 namespace core {
@@ -46,6 +59,293 @@ static const SupportHashFormat kFormatList[] = {
     {"sha512", HashUtil::kSha512},       {"", 0},
 };
 
+/// hex character table (lower case).
+static constexpr const char kHexCharTable[] = "0123456789abcdef";
+
+/**
+ * @brief Convert a hex character to 4-bit value.
+ * @param[in] hex_char    hex character
+ * @return 4-bit value. (0xff if invalid character)
+ */
+static inline uint8_t ConvertHexCharToValue(char hex_char) {
+  uint8_t digit = static_cast<uint8_t>(hex_char - '0');
+  if (digit < 10) return digit;
+  uint8_t alpha = static_cast<uint8_t>((hex_char | 0x20) - 'a');
+  if (alpha < 6) return static_cast<uint8_t>(alpha + 10);
+  return 0xff;
+}
+
+/**
+ * @brief Encode bytes to hex characters. (scalar)
+ * @param[in] bytes     byte data
+ * @param[in] size      byte data size
+ * @param[out] output   hex characters (size * 2)
+ */
+static void EncodeHexScalar(const uint8_t *bytes, size_t size, char *output) {
+  for (size_t index = 0; index < size; ++index) {
+    output[index * 2] = kHexCharTable[bytes[index] >> 4];
+    output[index * 2 + 1] = kHexCharTable[bytes[index] & 0x0f];
+  }
+}
+
+/**
+ * @brief Decode hex characters to bytes. (scalar)
+ * @param[in] hex       hex characters
+ * @param[in] size      output byte size (hex size / 2)
+ * @param[out] output   byte data (nullptr is validation only)
+ * @retval true   success
+ * @retval false  invalid character
+ */
+static bool DecodeHexScalar(const char *hex, size_t size, uint8_t *output) {
+  uint8_t invalid = 0;
+  for (size_t index = 0; index < size; ++index) {
+    uint8_t high = ConvertHexCharToValue(hex[index * 2]);
+    uint8_t low = ConvertHexCharToValue(hex[index * 2 + 1]);
+    invalid |= (high | low) & 0xf0;
+    if (output != nullptr) {
+      output[index] = static_cast<uint8_t>((high << 4) | (low & 0x0f));
+    }
+  }
+  return invalid == 0;
+}
+
+#ifdef CFD_CORE_USE_X86_SIMD
+/**
+ * @brief Convert 16 hex characters to 4-bit values. (SSSE3)
+ * @param[in] chars     hex characters
+ * @param[out] values   4-bit values
+ * @retval true   success
+ * @retval false  invalid character
+ */
+__attribute__((target("ssse3"))) static inline bool ConvertHexCharsSsse3(
+    __m128i chars, __m128i *values) {
+  const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+  const __m128i alpha = _mm_sub_epi8(
+      _mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  const __m128i is_digit =
+      _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+  const __m128i is_alpha =
+      _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+  if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xffff) {
+    return false;
+  }
+  *values = _mm_or_si128(
+      _mm_and_si128(is_digit, digit),
+      _mm_andnot_si128(is_digit, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+  return true;
+}
+
+/**
+ * @brief Encode bytes to hex characters. (SSSE3)
+ * @param[in] bytes     byte data
+ * @param[in] size      byte data size
+ * @param[out] output   hex characters (size * 2)
+ */
+__attribute__((target("ssse3"))) static void EncodeHexSsse3(
+    const uint8_t *bytes, size_t size, char *output) {
+  const __m128i table =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(kHexCharTable));
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  size_t index = 0;
+  for (; index + 16 <= size; index += 16) {
+    __m128i data =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + index));
+    __m128i high = _mm_shuffle_epi8(
+        table, _mm_and_si128(_mm_srli_epi16(data, 4), mask));
+    __m128i low = _mm_shuffle_epi8(table, _mm_and_si128(data, mask));
+    __m128i *dest = reinterpret_cast<__m128i *>(output + index * 2);
+    _mm_storeu_si128(dest, _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128(dest + 1, _mm_unpackhi_epi8(high, low));
+  }
+  EncodeHexScalar(bytes + index, size - index, output + index * 2);
+}
+
+/**
+ * @brief Decode hex characters to bytes. (SSSE3)
+ * @param[in] hex       hex characters
+ * @param[in] size      output byte size (hex size / 2)
+ * @param[out] output   byte data (nullptr is validation only)
+ * @retval true   success
+ * @retval false  invalid character
+ */
+__attribute__((target("ssse3"))) static bool DecodeHexSsse3(
+    const char *hex, size_t size, uint8_t *output) {
+  const __m128i weight = _mm_set1_epi16(0x0110);
+  size_t index = 0;
+  for (; index + 16 <= size; index += 16) {
+    const __m128i *src = reinterpret_cast<const __m128i *>(hex + index * 2);
+    __m128i value1;
+    __m128i value2;
+    if (!ConvertHexCharsSsse3(_mm_loadu_si128(src), &value1) ||
+        !ConvertHexCharsSsse3(_mm_loadu_si128(src + 1), &value2)) {
+      return false;
+    }
+    if (output != nullptr) {
+      // (high * 16 + low) for each character pair.
+      __m128i result = _mm_packus_epi16(
+          _mm_maddubs_epi16(value1, weight), _mm_maddubs_epi16(value2, weight));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output + index), result);
+    }
+  }
+  return DecodeHexScalar(
+      hex + index * 2, size - index,
+      (output == nullptr) ? nullptr : output + index);
+}
+
+/**
+ * @brief Convert 32 hex characters to 4-bit values. (AVX2)
+ * @param[in] chars     hex characters
+ * @param[out] values   4-bit values
+ * @retval true   success
+ * @retval false  invalid character
+ */
+__attribute__((target("avx2"))) static inline bool ConvertHexCharsAvx2(
+    __m256i chars, __m256i *values) {
+  const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+  const __m256i alpha = _mm256_sub_epi8(
+      _mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+  const __m256i is_digit =
+      _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+  const __m256i is_alpha =
+      _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+  if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha)) != -1) {
+    return false;
+  }
+  *values = _mm256_or_si256(
+      _mm256_and_si256(is_digit, digit),
+      _mm256_andnot_si256(
+          is_digit, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+  return true;
+}
+
+/**
+ * @brief Encode bytes to hex characters. (AVX2)
+ * @param[in] bytes     byte data
+ * @param[in] size      byte data size
+ * @param[out] output   hex characters (size * 2)
+ */
+__attribute__((target("avx2"))) static void EncodeHexAvx2(
+    const uint8_t *bytes, size_t size, char *output) {
+  const __m256i table = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(kHexCharTable)));
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  size_t index = 0;
+  for (; index + 32 <= size; index += 32) {
+    __m256i data =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bytes + index));
+    __m256i high = _mm256_shuffle_epi8(
+        table, _mm256_and_si256(_mm256_srli_epi16(data, 4), mask));
+    __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(data, mask));
+    // unpack works per 128bit lane: [0-7,16-23] and [8-15,24-31]
+    __m256i mixed_low = _mm256_unpacklo_epi8(high, low);
+    __m256i mixed_high = _mm256_unpackhi_epi8(high, low);
+    __m256i *dest = reinterpret_cast<__m256i *>(output + index * 2);
+    _mm256_storeu_si256(
+        dest, _mm256_permute2x128_si256(mixed_low, mixed_high, 0x20));
+    _mm256_storeu_si256(
+        dest + 1, _mm256_permute2x128_si256(mixed_low, mixed_high, 0x31));
+  }
+  EncodeHexSsse3(bytes + index, size - index, output + index * 2);
+}
+
+/**
+ * @brief Decode hex characters to bytes. (AVX2)
+ * @param[in] hex       hex characters
+ * @param[in] size      output byte size (hex size / 2)
+ * @param[out] output   byte data (nullptr is validation only)
+ * @retval true   success
+ * @retval false  invalid character
+ */
+__attribute__((target("avx2"))) static bool DecodeHexAvx2(
+    const char *hex, size_t size, uint8_t *output) {
+  const __m256i weight = _mm256_set1_epi16(0x0110);
+  size_t index = 0;
+  for (; index + 32 <= size; index += 32) {
+    const __m256i *src = reinterpret_cast<const __m256i *>(hex + index * 2);
+    __m256i value1;
+    __m256i value2;
+    if (!ConvertHexCharsAvx2(_mm256_loadu_si256(src), &value1) ||
+        !ConvertHexCharsAvx2(_mm256_loadu_si256(src + 1), &value2)) {
+      return false;
+    }
+    if (output != nullptr) {
+      // packus works per 128bit lane. reorder to [0,2,1,3] qwords.
+      __m256i result = _mm256_packus_epi16(
+          _mm256_maddubs_epi16(value1, weight),
+          _mm256_maddubs_epi16(value2, weight));
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i *>(output + index),
+          _mm256_permute4x64_epi64(result, 0xd8));
+    }
+  }
+  return DecodeHexSsse3(
+      hex + index * 2, size - index,
+      (output == nullptr) ? nullptr : output + index);
+}
+
+/// SIMD kernel level.
+enum SimdKernelLevel {
+  kSimdKernelScalar = 0,  //!< scalar
+  kSimdKernelSsse3,       //!< SSSE3
+  kSimdKernelAvx2,        //!< AVX2
+};
+
+/**
+ * @brief Get the usable SIMD kernel level.
+ * @return SIMD kernel level
+ */
+static SimdKernelLevel GetSimdKernelLevel() {
+  static const SimdKernelLevel kLevel = []() {
+    if (IsSupportAvx2()) return kSimdKernelAvx2;
+    if (IsSupportSsse3()) return kSimdKernelSsse3;
+    return kSimdKernelScalar;
+  }();
+  return kLevel;
+}
+#endif  // CFD_CORE_USE_X86_SIMD
+
+/**
+ * @brief Encode bytes to hex characters.
+ * @param[in] bytes     byte data
+ * @param[in] size      byte data size
+ * @param[out] output   hex characters (size * 2)
+ */
+static void EncodeHex(const uint8_t *bytes, size_t size, char *output) {
+#ifdef CFD_CORE_USE_X86_SIMD
+  switch (GetSimdKernelLevel()) {
+    case kSimdKernelAvx2:
+      return EncodeHexAvx2(bytes, size, output);
+    case kSimdKernelSsse3:
+      return EncodeHexSsse3(bytes, size, output);
+    default:
+      break;
+  }
+#endif  // CFD_CORE_USE_X86_SIMD
+  EncodeHexScalar(bytes, size, output);
+}
+
+/**
+ * @brief Decode hex characters to bytes.
+ * @param[in] hex       hex characters
+ * @param[in] size      output byte size (hex size / 2)
+ * @param[out] output   byte data (nullptr is validation only)
+ * @retval true   success
+ * @retval false  invalid character
+ */
+static bool DecodeHex(const char *hex, size_t size, uint8_t *output) {
+#ifdef CFD_CORE_USE_X86_SIMD
+  switch (GetSimdKernelLevel()) {
+    case kSimdKernelAvx2:
+      return DecodeHexAvx2(hex, size, output);
+    case kSimdKernelSsse3:
+      return DecodeHexSsse3(hex, size, output);
+    default:
+      break;
+  }
+#endif  // CFD_CORE_USE_X86_SIMD
+  return DecodeHexScalar(hex, size, output);
+}
+
 //////////////////////////////////
 /// SigHashType
 //////////////////////////////////
@@ -667,35 +967,29 @@ ByteData CryptoUtil::EncryptAes256Cbc(
 ByteData CryptoUtil::EncryptAes256Cbc(
     const ByteData &key, const ByteData &iv, const ByteData &data) {
   if (key.GetDataSize() != AES_KEY_LEN_256) {
-    warn(CFD_LOG_SOURCE, "wally_aes key size NG.");
+    warn(CFD_LOG_SOURCE, "aes key size NG.");
     throw CfdException(
         kCfdIllegalStateError, "EncryptAes256Cbc key size error.");
   }
 
   if (data.IsEmpty()) {
-    warn(CFD_LOG_SOURCE, "wally_aes data is Empty.");
+    warn(CFD_LOG_SOURCE, "aes data is Empty.");
     throw CfdException(
         kCfdIllegalStateError, "EncryptAes256Cbc data isEmpty.");
   }
 
-  size_t data_size =
-      (((data.GetDataSize() / kAesBlockLength) + 1) * kAesBlockLength);
-  std::vector<uint8_t> output(data_size);
-  std::vector<uint8_t> key_data = key.GetBytes();
-  std::vector<uint8_t> iv_data = iv.GetBytes();
-  size_t written = 0;
-
-  // Encrypt data using AES(CBC mode, PKCS#7 padding).
-  int ret = wally_aes_cbc(
-      key_data.data(), key_data.size(), iv_data.data(), iv_data.size(),
-      data.GetBytes().data(), data.GetDataSize(), AES_FLAG_ENCRYPT,
-      output.data(), output.size(), &written);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_aes_cbc NG[{}].", ret);
+  if (iv.GetDataSize() != kAesBlockLength) {
+    warn(CFD_LOG_SOURCE, "aes iv size NG.");
     throw CfdException(kCfdIllegalStateError, "EncryptAes256Cbc error.");
   }
 
-  output.resize(written);
+  // Encrypt data using AES(CBC mode, PKCS#7 padding).
+  std::vector<uint8_t> output;
+  output.reserve(
+      ((data.GetDataSize() / kAesBlockLength) + 1) * kAesBlockLength);
+  Aes256CbcEncryptor encryptor(key, iv);
+  encryptor.Update(data, &output);
+  encryptor.Final(&output);
   return ByteData(output);
 }
 
@@ -713,30 +1007,42 @@ std::string CryptoUtil::DecryptAes256CbcToString(
 ByteData CryptoUtil::DecryptAes256Cbc(
     const ByteData &key, const ByteData &iv, const ByteData &data) {
   if (key.GetDataSize() != AES_KEY_LEN_256) {
-    warn(CFD_LOG_SOURCE, "wally_aes key size NG.");
+    warn(CFD_LOG_SOURCE, "aes key size NG.");
     throw CfdException(
         kCfdIllegalStateError, "DecryptAes256Cbc key size error.");
   }
 
-  std::vector<uint8_t> output(data.GetDataSize());
-  std::vector<uint8_t> key_data = key.GetBytes();
-  std::vector<uint8_t> iv_data = iv.GetBytes();
-  size_t written = 0;
+  if (iv.GetDataSize() != kAesBlockLength) {
+    warn(CFD_LOG_SOURCE, "aes iv size NG.");
+    throw CfdException(kCfdIllegalStateError, "DecryptAes256Cbc error.");
+  }
 
   // Decrypt data using AES(CBC mode, PKCS#7 padding).
-  int ret = wally_aes_cbc(
-      key_data.data(), key_data.size(), iv_data.data(), iv_data.size(),
-      data.GetBytes().data(), data.GetDataSize(), AES_FLAG_DECRYPT,
-      output.data(), output.size(), &written);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_aes_cbc NG[{}].", ret);
+  std::vector<uint8_t> output;
+  output.reserve(data.GetDataSize());
+  try {
+    Aes256CbcDecryptor decryptor(key, iv);
+    decryptor.Update(data, &output);
+    decryptor.Final(&output);
+  } catch (const CfdException &except) {
+    warn(CFD_LOG_SOURCE, "aes cbc decrypt NG[{}].", except.what());
     throw CfdException(kCfdIllegalStateError, "DecryptAes256Cbc error.");
   }
-
-  output.resize(written);
   return ByteData(output);
 }
 
+ByteData CryptoUtil::EncryptAes256Ctr(
+    const ByteData &key, const ByteData &iv, const ByteData &data) {
+  Aes256CtrCipher cipher(key, iv);
+  return cipher.Update(data);
+}
+
+ByteData CryptoUtil::DecryptAes256Ctr(
+    const ByteData &key, const ByteData &iv, const ByteData &data) {
+  // CTR mode decryption is the same operation as encryption.
+  return EncryptAes256Ctr(key, iv, data);
+}
+
 ByteData256 CryptoUtil::HmacSha256(
     const std::vector<uint8_t> &key, const ByteData &data) {
   std::vector<uint8_t> output(HMAC_SHA256_LEN);
@@ -869,176 +1175,579 @@ ByteData CryptoUtil::ConvertSignatureFromDer(
  * @brief Base64encodeに用いるtable情報
  * @return Base64で利用する文字列
  */
-static const std::string kBase64EncodeTable(
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
-
-std::string CryptoUtil::EncodeBase64(const ByteData &data) {
-  std::vector<uint8_t> src(data.GetBytes());
-  std::string dst;
-  std::string cdst;
-
-  for (std::size_t i = 0; i < src.size(); ++i) {
-    switch (i % 3) {
-      case 0:
-        cdst.push_back(kBase64EncodeTable[(src[i] & 0xFC) >> 2]);
-        if (i + 1 == src.size()) {
-          cdst.push_back(kBase64EncodeTable[(src[i] & 0x03) << 4]);
-          cdst.push_back('=');
-          cdst.push_back('=');
-        }
-
-        break;
-      case 1:
-        cdst.push_back(
-            kBase64EncodeTable
-                [((src[i - 1] & 0x03) << 4) | ((src[i + 0] & 0xF0) >> 4)]);
-        if (i + 1 == src.size()) {
-          cdst.push_back(kBase64EncodeTable[(src[i] & 0x0F) << 2]);
-          cdst.push_back('=');
-        }
+static constexpr const char kBase64EncodeTable[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+/// Base64 value table (0xff is invalid character)
+static constexpr uint8_t kBase64ValueTable[128] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12,
+    0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24,
+    0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30,
+    0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+/// Base64 padding character
+static constexpr char kBase64Padding = '=';
 
-        break;
-      case 2:
-        cdst.push_back(
-            kBase64EncodeTable
-                [((src[i - 1] & 0x0F) << 2) | ((src[i + 0] & 0xC0) >> 6)]);
-        cdst.push_back(kBase64EncodeTable[src[i] & 0x3F]);
+/**
+ * @brief Encode 3-byte groups to Base64 characters.
+ * @param[in] data      byte data
+ * @param[in] size      byte data size (multiple of 3)
+ * @param[out] output   Base64 characters (size / 3 * 4)
+ */
+static void EncodeBase64Scalar(const uint8_t *data, size_t size, char *output) {
+  for (size_t index = 0; index < size; index += 3) {
+    uint32_t value = (static_cast<uint32_t>(data[index]) << 16) |
+                     (static_cast<uint32_t>(data[index + 1]) << 8) |
+                     data[index + 2];
+    *output++ = kBase64EncodeTable[(value >> 18) & 0x3f];
+    *output++ = kBase64EncodeTable[(value >> 12) & 0x3f];
+    *output++ = kBase64EncodeTable[(value >> 6) & 0x3f];
+    *output++ = kBase64EncodeTable[value & 0x3f];
+  }
+}
 
-        break;
+/**
+ * @brief Decode Base64 quads to bytes.
+ * @details Padding is allowed only in the last quad.
+ * @param[in] data        Base64 characters
+ * @param[in] size        Base64 characters size (multiple of 4)
+ * @param[out] output     byte data (size / 4 * 3)
+ * @param[out] written    written byte size
+ * @param[out] is_padded  padding is found
+ * @retval true   success
+ * @retval false  invalid character
+ */
+static bool DecodeBase64Scalar(
+    const char *data, size_t size, uint8_t *output, size_t *written,
+    bool *is_padded) {
+  size_t offset = 0;
+  for (size_t index = 0; index < size; index += 4) {
+    uint32_t value = 0;
+    uint8_t invalid = 0;
+    size_t padding = 0;
+    for (size_t count = 0; count < 4; ++count) {
+      uint8_t character = static_cast<uint8_t>(data[index + count]);
+      uint8_t bits = 0;
+      if (character == kBase64Padding) {
+        ++padding;
+      } else {
+        // character after padding is invalid.
+        if (padding != 0) return false;
+        bits = (character < 128) ? kBase64ValueTable[character] : 0xff;
+        invalid |= bits;
+      }
+      value = (value << 6) | (bits & 0x3f);
+    }
+    if (((invalid & 0xc0) != 0) || (padding > 2) ||
+        ((padding != 0) && (index + 4 != size))) {
+      return false;
     }
+    output[offset++] = static_cast<uint8_t>(value >> 16);
+    if (padding < 2) output[offset++] = static_cast<uint8_t>(value >> 8);
+    if (padding < 1) output[offset++] = static_cast<uint8_t>(value);
+    if (padding != 0) *is_padded = true;
   }
-
-  dst.swap(cdst);
-  return dst;
+  *written = offset;
+  return true;
 }
 
-ByteData CryptoUtil::DecodeBase64(const std::string &str) {
-  std::vector<uint8_t> dst;
-  if (str.size() & 0x00000003) {
-    ByteData byteData(dst);
-    return byteData;
-  }
+#ifdef CFD_CORE_USE_X86_SIMD
+/**
+ * @brief Encode 3-byte groups to Base64 characters. (SSSE3)
+ * @param[in] data      byte data
+ * @param[in] size      byte data size (multiple of 3)
+ * @param[out] output   Base64 characters (size / 3 * 4)
+ */
+__attribute__((target("ssse3"))) static void EncodeBase64Ssse3(
+    const uint8_t *data, size_t size, char *output) {
+  const __m128i shuffle =
+      _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+  const __m128i shift_table = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  size_t index = 0;
+  // 12 bytes are used from each 16 bytes load.
+  for (; index + 16 <= size; index += 12) {
+    __m128i input = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + index)),
+        shuffle);
+    // split to 6-bit values.
+    __m128i high = _mm_mulhi_epu16(
+        _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)),
+        _mm_set1_epi32(0x04000040));
+    __m128i low = _mm_mullo_epi16(
+        _mm_and_si128(input, _mm_set1_epi32(0x003f03f0)),
+        _mm_set1_epi32(0x01000010));
+    __m128i values = _mm_or_si128(high, low);
+    // convert to character.
+    __m128i range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+    __m128i is_upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), values);
+    range = _mm_or_si128(range, _mm_and_si128(is_upper, _mm_set1_epi8(13)));
+    __m128i chars =
+        _mm_add_epi8(_mm_shuffle_epi8(shift_table, range), values);
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(output + index / 3 * 4), chars);
+  }
+  EncodeBase64Scalar(data + index, size - index, output + index / 3 * 4);
+}
 
-  std::vector<uint8_t> cdst;
-  for (std::size_t i = 0; i < str.size(); i += 4) {
-    if (str[i + 0] == '=') {
-      ByteData byteData(dst);
-      return byteData;
+/**
+ * @brief Decode Base64 quads to bytes. (SSSE3)
+ * @param[in] data        Base64 characters
+ * @param[in] size        Base64 characters size (multiple of 4)
+ * @param[out] output     byte data (size / 4 * 3 + 4)
+ * @param[out] written    written byte size
+ * @param[out] is_padded  padding is found
+ * @retval true   success
+ * @retval false  invalid character
+ */
+__attribute__((target("ssse3"))) static bool DecodeBase64Ssse3(
+    const char *data, size_t size, uint8_t *output, size_t *written,
+    bool *is_padded) {
+  const __m128i low_table = _mm_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a,
+      0x1b, 0x1b, 0x1b, 0x1a);
+  const __m128i high_table = _mm_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x10, 0x10);
+  const __m128i roll_table =
+      _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i pack_shuffle =
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  size_t index = 0;
+  size_t offset = 0;
+  // the output is written 16 bytes per 12 bytes.
+  for (; index + 16 <= size; index += 16) {
+    __m128i chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + index));
+    __m128i high_nibble = _mm_and_si128(_mm_srli_epi32(chars, 4), mask);
+    __m128i low_bits = _mm_shuffle_epi8(low_table, _mm_and_si128(chars, mask));
+    __m128i high_bits = _mm_shuffle_epi8(high_table, high_nibble);
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(
+            _mm_and_si128(low_bits, high_bits), _mm_setzero_si128())) != 0) {
+      // invalid character or padding. check on scalar.
+      break;
+    }
+    __m128i is_slash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('/'));
+    __m128i roll =
+        _mm_shuffle_epi8(roll_table, _mm_add_epi8(is_slash, high_nibble));
+    __m128i values = _mm_add_epi8(chars, roll);
+    // pack 6-bit values to 24-bit.
+    __m128i merged =
+        _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i *>(output + offset),
+        _mm_shuffle_epi8(merged, pack_shuffle));
+    offset += 12;
+  }
+  size_t remain = 0;
+  if (!DecodeBase64Scalar(
+          data + index, size - index, output + offset, &remain, is_padded)) {
+    return false;
+  }
+  *written = offset + remain;
+  return true;
+}
+#endif  // CFD_CORE_USE_X86_SIMD
 
-    } else if (str[i + 1] == '=') {
-      ByteData byteData(dst);
-      return byteData;
+/**
+ * @brief Encode 3-byte groups to Base64 characters.
+ * @param[in] data      byte data
+ * @param[in] size      byte data size (multiple of 3)
+ * @param[out] output   Base64 characters (size / 3 * 4)
+ */
+static void EncodeBase64Block(const uint8_t *data, size_t size, char *output) {
+#ifdef CFD_CORE_USE_X86_SIMD
+  if (GetSimdKernelLevel() != kSimdKernelScalar) {
+    return EncodeBase64Ssse3(data, size, output);
+  }
+#endif  // CFD_CORE_USE_X86_SIMD
+  EncodeBase64Scalar(data, size, output);
+}
 
-    } else if (str[i + 2] == '=') {
-      const std::string::size_type s1 = kBase64EncodeTable.find(str[i + 0]);
-      const std::string::size_type s2 = kBase64EncodeTable.find(str[i + 1]);
+/**
+ * @brief Decode Base64 quads to bytes.
+ * @param[in] data        Base64 characters
+ * @param[in] size        Base64 characters size (multiple of 4)
+ * @param[out] output     byte data (size / 4 * 3 + 4)
+ * @param[out] written    written byte size
+ * @param[out] is_padded  padding is found
+ * @retval true   success
+ * @retval false  invalid character
+ */
+static bool DecodeBase64Block(
+    const char *data, size_t size, uint8_t *output, size_t *written,
+    bool *is_padded) {
+#ifdef CFD_CORE_USE_X86_SIMD
+  if (GetSimdKernelLevel() != kSimdKernelScalar) {
+    return DecodeBase64Ssse3(data, size, output, written, is_padded);
+  }
+#endif  // CFD_CORE_USE_X86_SIMD
+  return DecodeBase64Scalar(data, size, output, written, is_padded);
+}
 
-      if (s1 == std::string::npos || s2 == std::string::npos) {
-        ByteData byteData(dst);
-        return byteData;
-      }
+/**
+ * @brief Check the line break character.
+ * @param[in] character   character
+ * @retval true   line break
+ * @retval false  other
+ */
+static inline bool IsBase64LineBreak(char character) {
+  return (character == '\n') || (character == '\r');
+}
 
-      cdst.push_back(
-          static_cast<uint8_t>(((s1 & 0x3F) << 2) | ((s2 & 0x30) >> 4)));
+std::string CryptoUtil::EncodeBase64(const ByteData &data) {
+  std::string result;
+  Base64Encoder encoder;
+  encoder.Update(data, &result);
+  encoder.Final(&result);
+  return result;
+}
 
-      break;
-    } else if (str[i + 3] == '=') {
-      const std::string::size_type s1 = kBase64EncodeTable.find(str[i + 0]);
-      const std::string::size_type s2 = kBase64EncodeTable.find(str[i + 1]);
-      const std::string::size_type s3 = kBase64EncodeTable.find(str[i + 2]);
-
-      if (s1 == std::string::npos || s2 == std::string::npos ||
-          s3 == std::string::npos) {
-        ByteData byteData(dst);
-        return byteData;
-      }
+ByteData CryptoUtil::DecodeBase64(const std::string &str) {
+  std::vector<uint8_t> result;
+  try {
+    Base64Decoder decoder;
+    decoder.Update(str, &result);
+    decoder.Final();
+  } catch (const CfdException &except) {
+    info(CFD_LOG_SOURCE, "DecodeBase64 error. {}", except.what());
+    result.clear();
+  }
+  return ByteData(result);
+}
+
+/// Base58 character table
+static constexpr const char kBase58CharTable[] =
+    "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+/// Base58 value table (0xff is invalid character)
+static constexpr uint8_t kBase58ValueTable[128] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0xff, 0x11, 0x12, 0x13, 0x14, 0x15, 0xff, 0x16, 0x17, 0x18, 0x19,
+    0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b,
+    0xff, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+/// 58^5: Base58 limb base (5 characters per 32bit limb)
+static constexpr uint64_t kBase58LimbBase = 656356768;
+/// power of 58 (index: character count)
+static constexpr uint64_t kBase58PowerTable[] = {
+    1, 58, 3364, 195112, 11316496, 656356768};
+/// limb size on the stack. (enough for extkey, address and WIF)
+static constexpr size_t kBase58StackLimbSize = 32;
+/// Base58 checksum size
+static constexpr size_t kBase58ChecksumSize = 4;
+/// Base58Check decode buffer size of the fixed buffer decoding
+static constexpr size_t kBase58CheckDecodeBufferSize = 128;
 
-      cdst.push_back(
-          static_cast<uint8_t>(((s1 & 0x3F) << 2) | ((s2 & 0x30) >> 4)));
-      cdst.push_back(
-          static_cast<uint8_t>(((s2 & 0x0F) << 4) | ((s3 & 0x3C) >> 2)));
+/**
+ * @brief Encode to Base58 and append to the string.
+ * @details The data is processed in 32bit words, and the number is held
+ *     in limbs of base 58^5.
+ * @param[in] data      byte data
+ * @param[in] size      byte data size
+ * @param[out] output   output string
+ */
+static void EncodeBase58Buffer(
+    const uint8_t *data, size_t size, std::string *output) {
+  size_t zeros = 0;
+  while ((zeros < size) && (data[zeros] == 0)) ++zeros;
+
+  size_t remain = size - zeros;
+  size_t limb_max = ((remain * 138 / 100) / 5) + 2;
+  uint32_t stack_limbs[kBase58StackLimbSize];
+  std::vector<uint32_t> heap_limbs;
+  uint32_t *limbs = stack_limbs;
+  if (limb_max > kBase58StackLimbSize) {
+    heap_limbs.resize(limb_max);
+    limbs = heap_limbs.data();
+  }
+
+  size_t limb_count = 0;
+  size_t index = zeros;
+  while (remain > 0) {
+    size_t chunk = ((remain % 4) == 0) ? 4 : (remain % 4);
+    uint64_t carry = 0;
+    for (size_t offset = 0; offset < chunk; ++offset) {
+      carry = (carry << 8) | data[index + offset];
+    }
+    uint64_t multiplier = static_cast<uint64_t>(1) << (chunk * 8);
+    for (size_t pos = 0; pos < limb_count; ++pos) {
+      uint64_t value = (limbs[pos] * multiplier) + carry;
+      limbs[pos] = static_cast<uint32_t>(value % kBase58LimbBase);
+      carry = value / kBase58LimbBase;
+    }
+    while (carry != 0) {
+      limbs[limb_count++] = static_cast<uint32_t>(carry % kBase58LimbBase);
+      carry /= kBase58LimbBase;
+    }
+    index += chunk;
+    remain -= chunk;
+  }
+
+  output->reserve(output->size() + zeros + (limb_count * 5));
+  output->append(zeros, kBase58CharTable[0]);
+  char digits[5];
+  for (size_t pos = limb_count; pos > 0; --pos) {
+    uint32_t limb = limbs[pos - 1];
+    for (size_t digit = 5; digit > 0; --digit) {
+      digits[digit - 1] = kBase58CharTable[limb % 58];
+      limb /= 58;
+    }
+    size_t start = 0;
+    if (pos == limb_count) {
+      // top limb is not zero.
+      while (digits[start] == kBase58CharTable[0]) ++start;
+    }
+    output->append(digits + start, sizeof(digits) - start);
+  }
+}
 
-      break;
-    } else {
-      const std::string::size_type s1 = kBase64EncodeTable.find(str[i + 0]);
-      const std::string::size_type s2 = kBase64EncodeTable.find(str[i + 1]);
-      const std::string::size_type s3 = kBase64EncodeTable.find(str[i + 2]);
-      const std::string::size_type s4 = kBase64EncodeTable.find(str[i + 3]);
-
-      if (s1 == std::string::npos || s2 == std::string::npos ||
-          s3 == std::string::npos || s4 == std::string::npos) {
-        ByteData byteData(dst);
-        return byteData;
+/**
+ * @brief Decode from Base58.
+ * @details The characters are processed 5 at a time, and the number is
+ *     held in 32bit limbs.
+ * @param[in] str           Base58 string
+ * @param[in] size          Base58 string length
+ * @param[out] output       decoded data buffer
+ * @param[in] output_size   decoded data buffer size
+ * @param[out] written      decoded data size
+ * @retval true   success
+ * @retval false  invalid string or buffer shortage
+ */
+static bool DecodeBase58Buffer(
+    const char *str, size_t size, uint8_t *output, size_t output_size,
+    size_t *written) {
+  if (size == 0) return false;
+  size_t zeros = 0;
+  while ((zeros < size) && (str[zeros] == kBase58CharTable[0])) ++zeros;
+
+  size_t remain = size - zeros;
+  size_t limb_max = ((remain * 733 / 1000) / 4) + 2;
+  uint32_t stack_limbs[kBase58StackLimbSize];
+  std::vector<uint32_t> heap_limbs;
+  uint32_t *limbs = stack_limbs;
+  if (limb_max > kBase58StackLimbSize) {
+    heap_limbs.resize(limb_max);
+    limbs = heap_limbs.data();
+  }
+
+  size_t limb_count = 0;
+  size_t index = zeros;
+  while (remain > 0) {
+    size_t chunk = ((remain % 5) == 0) ? 5 : (remain % 5);
+    uint64_t carry = 0;
+    for (size_t offset = 0; offset < chunk; ++offset) {
+      uint8_t character = static_cast<uint8_t>(str[index + offset]);
+      uint8_t value =
+          (character < 128) ? kBase58ValueTable[character] : 0xff;
+      if (value == 0xff) return false;
+      carry = (carry * 58) + value;
+    }
+    uint64_t multiplier = kBase58PowerTable[chunk];
+    for (size_t pos = 0; pos < limb_count; ++pos) {
+      uint64_t value = (limbs[pos] * multiplier) + carry;
+      limbs[pos] = static_cast<uint32_t>(value);
+      carry = value >> 32;
+    }
+    if (carry != 0) limbs[limb_count++] = static_cast<uint32_t>(carry);
+    index += chunk;
+    remain -= chunk;
+  }
+
+  if (zeros > output_size) return false;
+  memset(output, 0, zeros);
+  size_t output_index = zeros;
+  for (size_t pos = limb_count; pos > 0; --pos) {
+    uint32_t limb = limbs[pos - 1];
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      uint8_t byte_data = static_cast<uint8_t>(limb >> shift);
+      // skip the leading zero of the top limb.
+      if ((pos != limb_count) || (output_index != zeros) ||
+          (byte_data != 0)) {
+        if (output_index >= output_size) return false;
+        output[output_index++] = byte_data;
       }
-
-      cdst.push_back(
-          static_cast<uint8_t>(((s1 & 0x3F) << 2) | ((s2 & 0x30) >> 4)));
-      cdst.push_back(
-          static_cast<uint8_t>(((s2 & 0x0F) << 4) | ((s3 & 0x3C) >> 2)));
-      cdst.push_back(
-          static_cast<uint8_t>(((s3 & 0x03) << 6) | ((s4 & 0x3F) >> 0)));
     }
   }
-  dst.swap(cdst);
-  ByteData byteData(dst);
-  return byteData;
+  *written = output_index;
+  return true;
 }
 
-ByteData CryptoUtil::DecodeBase58(const std::string &str) {
-  std::vector<uint8_t> output(1024);
+/**
+ * @brief Decode from Base58.
+ * @param[in] str       Base58 string
+ * @param[in] size      Base58 string length
+ * @param[out] output   decoded data
+ * @retval true   success
+ * @retval false  invalid string
+ */
+static bool DecodeBase58Buffer(
+    const char *str, size_t size, std::vector<uint8_t> *output) {
+  // 58^n < 256^(n * 0.733)
+  output->resize(size + 1);
   size_t written = 0;
+  if (!DecodeBase58Buffer(
+          str, size, output->data(), output->size(), &written)) {
+    return false;
+  }
+  output->resize(written);
+  return true;
+}
 
-  int ret = wally_base58_to_bytes(
-      str.data(), 0, output.data(), output.size(), &written);
+/**
+ * @brief Append the Base58 checksum.
+ * @param[in,out] data  target data
+ */
+static void AppendBase58Checksum(std::vector<uint8_t> *data) {
+  uint8_t hash[SHA256_LEN];
+  int ret = wally_sha256d(data->data(), data->size(), hash, sizeof(hash));
   if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_base58_to_bytes NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
+    warn(CFD_LOG_SOURCE, "wally_sha256d NG[{}].", ret);
+    throw CfdException(kCfdIllegalStateError, "Encode base58 error.");
   }
+  data->insert(data->end(), hash, hash + kBase58ChecksumSize);
+}
 
-  output.resize(written);
+ByteData CryptoUtil::DecodeBase58(const std::string &str) {
+  std::vector<uint8_t> output;
+  if (!DecodeBase58Buffer(str.data(), str.size(), &output)) {
+    warn(CFD_LOG_SOURCE, "DecodeBase58 NG.");
+    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
+  }
   return ByteData(output);
 }
 
 ByteData CryptoUtil::DecodeBase58Check(const std::string &str) {
-  std::vector<uint8_t> output(1024);
-  size_t written = 0;
+  std::vector<uint8_t> output;
+  if ((!DecodeBase58Buffer(str.data(), str.size(), &output)) ||
+      (output.size() < kBase58ChecksumSize)) {
+    warn(CFD_LOG_SOURCE, "DecodeBase58Check NG.");
+    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
+  }
 
-  int ret = wally_base58_to_bytes(
-      str.data(), BASE58_FLAG_CHECKSUM, output.data(), output.size(),
-      &written);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_base58_to_bytes NG[{}].", ret);
+  size_t size = output.size() - kBase58ChecksumSize;
+  uint8_t hash[SHA256_LEN];
+  int ret = wally_sha256d(output.data(), size, hash, sizeof(hash));
+  if ((ret != WALLY_OK) ||
+      (memcmp(hash, &output[size], kBase58ChecksumSize) != 0)) {
+    warn(CFD_LOG_SOURCE, "DecodeBase58Check checksum unmatch.");
     throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
   }
+  return ByteData(output.data(), static_cast<uint32_t>(size));
+}
 
-  output.resize(written);
-  return ByteData(output);
+bool CryptoUtil::DecodeBase58Check(
+    const std::string &str, uint8_t *output, size_t output_size,
+    size_t *written) {
+  uint8_t buffer[kBase58CheckDecodeBufferSize];
+  size_t size = 0;
+  if ((output == nullptr) || (written == nullptr) ||
+      (!DecodeBase58Buffer(
+          str.data(), str.size(), buffer, sizeof(buffer), &size)) ||
+      (size < kBase58ChecksumSize)) {
+    return false;
+  }
+
+  size -= kBase58ChecksumSize;
+  uint8_t hash[SHA256_LEN];
+  int ret = wally_sha256d(buffer, size, hash, sizeof(hash));
+  if ((ret != WALLY_OK) ||
+      (memcmp(hash, &buffer[size], kBase58ChecksumSize) != 0) ||
+      (size > output_size)) {
+    return false;
+  }
+  memcpy(output, buffer, size);
+  *written = size;
+  return true;
 }
 
 std::string CryptoUtil::EncodeBase58(const ByteData &data) {
   std::vector<uint8_t> byte_array = data.GetBytes();
-  char *output = nullptr;
-
-  int ret = wally_base58_from_bytes(
-      byte_array.data(), byte_array.size(), 0, &output);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_base58_from_bytes NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
-  }
-  return WallyUtil::ConvertStringAndFree(output);
+  std::string output;
+  EncodeBase58Buffer(byte_array.data(), byte_array.size(), &output);
+  return output;
 }
 
 std::string CryptoUtil::EncodeBase58Check(const ByteData &data) {
   std::vector<uint8_t> byte_array = data.GetBytes();
-  char *output = nullptr;
+  byte_array.reserve(byte_array.size() + kBase58ChecksumSize);
+  AppendBase58Checksum(&byte_array);
+  std::string output;
+  EncodeBase58Buffer(byte_array.data(), byte_array.size(), &output);
+  return output;
+}
+
+std::vector<std::string> CryptoUtil::EncodeBase58CheckBatch(
+    const std::vector<ByteData> &data_list) {
+  std::string buffer;
+  std::vector<size_t> offsets;
+  EncodeBase58CheckBatch(data_list, &buffer, &offsets);
+  std::vector<std::string> result;
+  result.reserve(data_list.size());
+  for (size_t index = 0; index < data_list.size(); ++index) {
+    result.emplace_back(
+        buffer, offsets[index], offsets[index + 1] - offsets[index]);
+  }
+  return result;
+}
 
-  int ret = wally_base58_from_bytes(
-      byte_array.data(), byte_array.size(), BASE58_FLAG_CHECKSUM, &output);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "wally_base58_from_bytes NG[{}].", ret);
-    throw CfdException(kCfdIllegalStateError, "Decode base58 error.");
+void CryptoUtil::EncodeBase58CheckBatch(
+    const std::vector<ByteData> &data_list, std::string *output,
+    std::vector<size_t> *offsets) {
+  if ((output == nullptr) || (offsets == nullptr)) {
+    warn(CFD_LOG_SOURCE, "EncodeBase58CheckBatch output is null.");
+    throw CfdException(kCfdIllegalArgumentError, "Encode base58 error.");
+  }
+
+  // 256^n < 58^(n * 1.38), and EncodeBase58Buffer reserves whole limbs.
+  size_t total_size = 0;
+  size_t max_size = 0;
+  for (const auto &data : data_list) {
+    size_t size = data.GetDataSize() + kBase58ChecksumSize;
+    total_size += (size * 138 / 100) + 6;
+    max_size = std::max(max_size, size);
+  }
+  output->clear();
+  output->reserve(total_size);
+  offsets->clear();
+  offsets->reserve(data_list.size() + 1);
+
+  uint8_t stack_work[kBase58CheckDecodeBufferSize];
+  std::vector<uint8_t> heap_work;
+  uint8_t *work = stack_work;
+  if (max_size > sizeof(stack_work)) {
+    heap_work.resize(max_size);
+    work = heap_work.data();
+  }
+  uint8_t hash[SHA256_LEN];
+  for (const auto &data : data_list) {
+    ByteSpan span(data);
+    if (!span.empty()) memcpy(work, span.data(), span.size());
+    int ret = wally_sha256d(work, span.size(), hash, sizeof(hash));
+    if (ret != WALLY_OK) {
+      warn(CFD_LOG_SOURCE, "wally_sha256d NG[{}].", ret);
+      throw CfdException(kCfdIllegalStateError, "Encode base58 error.");
+    }
+    memcpy(work + span.size(), hash, kBase58ChecksumSize);
+    offsets->push_back(output->size());
+    EncodeBase58Buffer(work, span.size() + kBase58ChecksumSize, output);
   }
-  return WallyUtil::ConvertStringAndFree(output);
+  offsets->push_back(output->size());
 }
 
 ByteData256 CryptoUtil::ComputeFastMerkleRoot(
@@ -1118,43 +1827,775 @@ ByteData256 CryptoUtil::MerkleHashSha256Midstate(
   return ByteData256(output);
 }
 
+//////////////////////////////////
+/// HmacSha256Context
+//////////////////////////////////
+/// HMAC inner pad value
+static constexpr uint8_t kHmacInnerPad = 0x36;
+/// HMAC outer pad value
+static constexpr uint8_t kHmacOuterPad = 0x5c;
+
+HmacSha256Context::HmacSha256Context(const std::vector<uint8_t> &key)
+    : inner_state_(), outer_state_() {
+  uint8_t block[kSha256BlockSize];
+  memset(block, 0, sizeof(block));
+  if (key.size() > kSha256BlockSize) {
+    uint32_t state[kSha256StateSize];
+    Sha256Initialize(state);
+    Sha256Finalize(state, key.data(), key.size(), key.size(), block);
+  } else if (!key.empty()) {
+    memcpy(block, key.data(), key.size());
+  }
+
+  for (auto &value : block) value ^= kHmacInnerPad;
+  Sha256Initialize(inner_state_);
+  Sha256Transform(inner_state_, block, 1);
+  for (auto &value : block) value ^= kHmacInnerPad ^ kHmacOuterPad;
+  Sha256Initialize(outer_state_);
+  Sha256Transform(outer_state_, block, 1);
+  wally_bzero(block, sizeof(block));
+}
+
+HmacSha256Context::HmacSha256Context(const ByteData &key)
+    : HmacSha256Context(key.GetBytes()) {
+  // do nothing
+}
+
+HmacSha256Context::~HmacSha256Context() {
+  wally_bzero(inner_state_, sizeof(inner_state_));
+  wally_bzero(outer_state_, sizeof(outer_state_));
+}
+
+ByteData256 HmacSha256Context::Calculate(const ByteData &data) const {
+  std::vector<uint8_t> bytes = data.GetBytes();
+  std::vector<uint8_t> output(HMAC_SHA256_LEN);
+  Calculate(bytes.data(), bytes.size(), output.data());
+  return ByteData256(output);
+}
+
+void HmacSha256Context::Calculate(
+    const uint8_t *data, size_t size, uint8_t *output) const {
+  uint8_t inner_hash[HMAC_SHA256_LEN];
+  Sha256Finalize(
+      inner_state_, data, size, kSha256BlockSize + size, inner_hash);
+  Sha256Finalize(
+      outer_state_, inner_hash, sizeof(inner_hash),
+      kSha256BlockSize + sizeof(inner_hash), output);
+}
+
+//////////////////////////////////
+/// HmacSha512Context
+//////////////////////////////////
+/**
+ * @brief Calculate the HMAC-SHA512 pad states.
+ * @param[in] key           key
+ * @param[in] key_size      key size
+ * @param[out] inner_state  inner pad state
+ * @param[out] outer_state  outer pad state
+ */
+static void CalculateHmacSha512PadState(
+    const uint8_t *key, size_t key_size, uint64_t *inner_state,
+    uint64_t *outer_state) {
+  uint8_t block[kSha512BlockSize];
+  memset(block, 0, sizeof(block));
+  if (key_size > kSha512BlockSize) {
+    uint64_t state[kSha512StateSize];
+    Sha512Initialize(state);
+    Sha512Finalize(state, key, key_size, key_size, block);
+  } else if (key_size != 0) {
+    memcpy(block, key, key_size);
+  }
+
+  for (auto &value : block) value ^= kHmacInnerPad;
+  Sha512Initialize(inner_state);
+  Sha512Transform(inner_state, block, 1);
+  for (auto &value : block) value ^= kHmacInnerPad ^ kHmacOuterPad;
+  Sha512Initialize(outer_state);
+  Sha512Transform(outer_state, block, 1);
+  wally_bzero(block, sizeof(block));
+}
+
+HmacSha512Context::HmacSha512Context(const std::vector<uint8_t> &key)
+    : inner_state_(), outer_state_() {
+  CalculateHmacSha512PadState(
+      key.data(), key.size(), inner_state_, outer_state_);
+}
+
+HmacSha512Context::HmacSha512Context(const ByteData &key)
+    : HmacSha512Context(key.GetBytes()) {
+  // do nothing
+}
+
+HmacSha512Context::~HmacSha512Context() {
+  wally_bzero(inner_state_, sizeof(inner_state_));
+  wally_bzero(outer_state_, sizeof(outer_state_));
+}
+
+ByteData HmacSha512Context::Calculate(const ByteData &data) const {
+  std::vector<uint8_t> bytes = data.GetBytes();
+  std::vector<uint8_t> output(HMAC_SHA512_LEN);
+  Calculate(bytes.data(), bytes.size(), output.data());
+  return ByteData(output);
+}
+
+void HmacSha512Context::Calculate(
+    const uint8_t *data, size_t size, uint8_t *output) const {
+  uint8_t inner_hash[HMAC_SHA512_LEN];
+  Sha512Finalize(
+      inner_state_, data, size, kSha512BlockSize + size, inner_hash);
+  Sha512Finalize(
+      outer_state_, inner_hash, sizeof(inner_hash),
+      kSha512BlockSize + sizeof(inner_hash), output);
+}
+
+//////////////////////////////////
+/// PBKDF2-HMAC-SHA512
+//////////////////////////////////
+/// PBKDF2 lane count per kernel call
+static constexpr size_t kPbkdf2LaneUnit = 4;
+/// minimum lane unit count per thread
+static constexpr size_t kPbkdf2LaneUnitPerThread = 2;
+
+ByteData CryptoUtil::Pbkdf2HmacSha512(
+    const ByteData &password, const ByteData &salt, uint32_t iterations,
+    size_t key_size) {
+  std::vector<ByteData> result = Pbkdf2HmacSha512Batch(
+      std::vector<ByteData>{password}, std::vector<ByteData>{salt}, iterations,
+      key_size, 1);
+  return result[0];
+}
+
+std::vector<ByteData> CryptoUtil::Pbkdf2HmacSha512Batch(
+    const std::vector<ByteData> &passwords, const std::vector<ByteData> &salts,
+    uint32_t iterations, size_t key_size, uint32_t thread_count) {
+  if (passwords.size() != salts.size()) {
+    warn(
+        CFD_LOG_SOURCE, "Unmatch pbkdf2 list size. password={}, salt={}",
+        passwords.size(), salts.size());
+    throw CfdException(
+        kCfdIllegalArgumentError, "Unmatch password and salt count.");
+  }
+  if ((iterations == 0) || (key_size == 0)) {
+    warn(
+        CFD_LOG_SOURCE, "Invalid pbkdf2 parameter. iterations={}, size={}",
+        iterations, key_size);
+    throw CfdException(kCfdIllegalArgumentError, "Invalid pbkdf2 parameter.");
+  }
+
+  // one lane is one output block (T_i) of a password.
+  const size_t block_count =
+      (key_size + HMAC_SHA512_LEN - 1) / HMAC_SHA512_LEN;
+  const size_t lane_count = passwords.size() * block_count;
+  std::vector<uint64_t> inner_states(lane_count * kSha512StateSize);
+  std::vector<uint64_t> outer_states(lane_count * kSha512StateSize);
+  std::vector<uint8_t> blocks(lane_count * HMAC_SHA512_LEN);
+  for (size_t index = 0; index < passwords.size(); ++index) {
+    const std::vector<uint8_t> password = passwords[index].GetBytes();
+    std::vector<uint8_t> salt = salts[index].GetBytes();
+    const size_t salt_size = salt.size();
+    salt.resize(salt_size + 4);
+    for (size_t block = 0; block < block_count; ++block) {
+      const size_t lane = index * block_count + block;
+      uint64_t *inner_state = &inner_states[lane * kSha512StateSize];
+      uint64_t *outer_state = &outer_states[lane * kSha512StateSize];
+      uint8_t *output = &blocks[lane * HMAC_SHA512_LEN];
+      if (block == 0) {
+        CalculateHmacSha512PadState(
+            password.data(), password.size(), inner_state, outer_state);
+      } else {
+        memcpy(
+            inner_state, inner_state - kSha512StateSize,
+            sizeof(uint64_t) * kSha512StateSize);
+        memcpy(
+            outer_state, outer_state - kSha512StateSize,
+            sizeof(uint64_t) * kSha512StateSize);
+      }
+
+      // U1 = HMAC(P, S || INT(i))
+      const uint32_t block_index = static_cast<uint32_t>(block + 1);
+      salt[salt_size] = static_cast<uint8_t>(block_index >> 24);
+      salt[salt_size + 1] = static_cast<uint8_t>(block_index >> 16);
+      salt[salt_size + 2] = static_cast<uint8_t>(block_index >> 8);
+      salt[salt_size + 3] = static_cast<uint8_t>(block_index);
+      uint8_t inner_hash[HMAC_SHA512_LEN];
+      Sha512Finalize(
+          inner_state, salt.data(), salt.size(),
+          kSha512BlockSize + salt.size(), inner_hash);
+      Sha512Finalize(
+          outer_state, inner_hash, sizeof(inner_hash),
+          kSha512BlockSize + sizeof(inner_hash), output);
+    }
+  }
+
+  const size_t unit_count = (lane_count + kPbkdf2LaneUnit - 1) / kPbkdf2LaneUnit;
+  ParallelFor(
+      unit_count, thread_count, kPbkdf2LaneUnitPerThread,
+      [&](size_t begin, size_t end) {
+        const size_t lane = begin * kPbkdf2LaneUnit;
+        const size_t count = std::min(end * kPbkdf2LaneUnit, lane_count) - lane;
+        Pbkdf2Sha512Iterate(
+            &inner_states[lane * kSha512StateSize],
+            &outer_states[lane * kSha512StateSize],
+            &blocks[lane * HMAC_SHA512_LEN], count, iterations);
+      });
+
+  std::vector<ByteData> result;
+  result.reserve(passwords.size());
+  for (size_t index = 0; index < passwords.size(); ++index) {
+    const uint8_t *top = &blocks[index * block_count * HMAC_SHA512_LEN];
+    result.emplace_back(top, static_cast<uint32_t>(key_size));
+  }
+  wally_bzero(inner_states.data(), inner_states.size() * sizeof(uint64_t));
+  wally_bzero(outer_states.data(), outer_states.size() * sizeof(uint64_t));
+  wally_bzero(blocks.data(), blocks.size());
+  return result;
+}
+
+//////////////////////////////////
+/// Base64Encoder
+//////////////////////////////////
+Base64Encoder::Base64Encoder() : pending_(), pending_size_(0) {
+  // do nothing
+}
+
+void Base64Encoder::Update(
+    const uint8_t *data, size_t size, std::string *output) {
+  if ((output == nullptr) || ((data == nullptr) && (size != 0))) {
+    warn(CFD_LOG_SOURCE, "Base64Encoder output is null.");
+    throw CfdException(kCfdIllegalArgumentError, "Invalid base64 argument.");
+  }
+  if (size == 0) return;
+  size_t total = pending_size_ + size;
+  if (total < 3) {
+    memcpy(pending_ + pending_size_, data, size);
+    pending_size_ = total;
+    return;
+  }
+  size_t offset = output->size();
+  output->resize(offset + total / 3 * 4);
+  char *dest = &(*output)[offset];
+  if (pending_size_ != 0) {
+    size_t fill = 3 - pending_size_;
+    memcpy(pending_ + pending_size_, data, fill);
+    EncodeBase64Scalar(pending_, 3, dest);
+    dest += 4;
+    data += fill;
+    size -= fill;
+    pending_size_ = 0;
+  }
+  size_t block_size = size / 3 * 3;
+  EncodeBase64Block(data, block_size, dest);
+  pending_size_ = size - block_size;
+  memcpy(pending_, data + block_size, pending_size_);
+}
+
+void Base64Encoder::Update(const ByteData &data, std::string *output) {
+  std::vector<uint8_t> bytes = data.GetBytes();
+  if (output != nullptr) {
+    output->reserve(output->size() + (pending_size_ + bytes.size() + 2) / 3 * 4);
+  }
+  Update(bytes.data(), bytes.size(), output);
+}
+
+void Base64Encoder::Final(std::string *output) {
+  if (output == nullptr) {
+    warn(CFD_LOG_SOURCE, "Base64Encoder output is null.");
+    throw CfdException(kCfdIllegalArgumentError, "Invalid base64 argument.");
+  }
+  if (pending_size_ != 0) {
+    uint8_t block[3] = {pending_[0], 0, 0};
+    if (pending_size_ == 2) block[1] = pending_[1];
+    char chars[4];
+    EncodeBase64Scalar(block, sizeof(block), chars);
+    output->append(chars, pending_size_ + 1);
+    output->append(3 - pending_size_, kBase64Padding);
+  }
+  pending_size_ = 0;
+}
+
+//////////////////////////////////
+/// Base64Decoder
+//////////////////////////////////
+Base64Decoder::Base64Decoder()
+    : pending_(), pending_size_(0), is_padded_(false) {
+  // do nothing
+}
+
+void Base64Decoder::Update(
+    const char *data, size_t size, std::vector<uint8_t> *output) {
+  if ((output == nullptr) || ((data == nullptr) && (size != 0))) {
+    warn(CFD_LOG_SOURCE, "Base64Decoder output is null.");
+    throw CfdException(kCfdIllegalArgumentError, "Invalid base64 argument.");
+  }
+  size_t index = 0;
+  while (index < size) {
+    if (IsBase64LineBreak(data[index])) {
+      ++index;
+      continue;
+    }
+    if (is_padded_) {
+      warn(CFD_LOG_SOURCE, "Base64 data exists after padding.");
+      throw CfdException(kCfdIllegalArgumentError, "Invalid base64 string.");
+    }
+
+    const char *block = data + index;
+    size_t block_size = 0;
+    if (pending_size_ != 0) {
+      pending_[pending_size_++] = data[index++];
+      if (pending_size_ != sizeof(pending_)) continue;
+      block = pending_;
+      block_size = sizeof(pending_);
+      pending_size_ = 0;
+    } else {
+      size_t end = index;
+      while ((end < size) && !IsBase64LineBreak(data[end])) ++end;
+      block_size = (end - index) & ~static_cast<size_t>(3);
+      if (block_size == 0) {
+        pending_[pending_size_++] = data[index++];
+        continue;
+      }
+      index += block_size;
+    }
+
+    size_t offset = output->size();
+    size_t written = 0;
+    output->resize(offset + block_size / 4 * 3 + 4);
+    if (!DecodeBase64Block(
+            block, block_size, output->data() + offset, &written,
+            &is_padded_)) {
+      output->resize(offset);
+      warn(CFD_LOG_SOURCE, "Base64 data has invalid character.");
+      throw CfdException(kCfdIllegalArgumentError, "Invalid base64 string.");
+    }
+    output->resize(offset + written);
+  }
+}
+
+void Base64Decoder::Update(
+    const std::string &data, std::vector<uint8_t> *output) {
+  if (output != nullptr) {
+    output->reserve(output->size() + data.size() / 4 * 3 + 4);
+  }
+  Update(data.data(), data.size(), output);
+}
+
+void Base64Decoder::Final() {
+  bool is_terminated = (pending_size_ == 0);
+  pending_size_ = 0;
+  is_padded_ = false;
+  if (!is_terminated) {
+    warn(CFD_LOG_SOURCE, "Base64 data is not terminated.");
+    throw CfdException(kCfdIllegalArgumentError, "Invalid base64 string.");
+  }
+}
+
+//////////////////////////////////
+/// Aes256CbcEncryptor
+//////////////////////////////////
+/**
+ * @brief Check the key and iv, and set the key schedule.
+ * @param[in] key             key
+ * @param[in] iv              initial vector
+ * @param[out] key_schedule   key schedule
+ * @param[out] iv_output      initial vector
+ */
+static void InitializeAes256(
+    const ByteData &key, const ByteData &iv, uint8_t *key_schedule,
+    uint8_t *iv_output) {
+  if (key.GetDataSize() != kAes256KeySize) {
+    warn(CFD_LOG_SOURCE, "aes key size NG. size={}", key.GetDataSize());
+    throw CfdException(kCfdIllegalStateError, "Invalid aes key size.");
+  }
+  if (iv.GetDataSize() != kAesBlockSize) {
+    warn(CFD_LOG_SOURCE, "aes iv size NG. size={}", iv.GetDataSize());
+    throw CfdException(kCfdIllegalStateError, "Invalid aes iv size.");
+  }
+  std::vector<uint8_t> key_bytes = key.GetBytes();
+  Aes256ExpandKey(key_bytes.data(), key_schedule);
+  wally_bzero(key_bytes.data(), key_bytes.size());
+  std::vector<uint8_t> iv_bytes = iv.GetBytes();
+  memcpy(iv_output, iv_bytes.data(), kAesBlockSize);
+}
+
+/**
+ * @brief Check the stream arguments.
+ * @param[in] data      data
+ * @param[in] size      data size
+ * @param[in] output    output
+ */
+static void CheckAesStreamArgument(
+    const void *data, size_t size, const void *output) {
+  if ((output == nullptr) || ((data == nullptr) && (size != 0))) {
+    warn(CFD_LOG_SOURCE, "aes stream output is null.");
+    throw CfdException(kCfdIllegalArgumentError, "Invalid aes argument.");
+  }
+}
+
+Aes256CbcEncryptor::Aes256CbcEncryptor(const ByteData &key, const ByteData &iv)
+    : key_schedule_(), iv_(), pending_(), pending_size_(0) {
+  static_assert(
+      sizeof(key_schedule_) == kAes256KeyScheduleSize,
+      "key schedule size unmatch.");
+  InitializeAes256(key, iv, key_schedule_, iv_);
+}
+
+Aes256CbcEncryptor::~Aes256CbcEncryptor() {
+  wally_bzero(key_schedule_, sizeof(key_schedule_));
+  wally_bzero(iv_, sizeof(iv_));
+  wally_bzero(pending_, sizeof(pending_));
+}
+
+void Aes256CbcEncryptor::Update(
+    const uint8_t *data, size_t size, std::vector<uint8_t> *output) {
+  CheckAesStreamArgument(data, size, output);
+  if (size == 0) return;
+  size_t offset = std::min(kAesBlockSize - pending_size_, size);
+  memcpy(pending_ + pending_size_, data, offset);
+  pending_size_ += offset;
+  if (pending_size_ < kAesBlockSize) return;
+
+  const size_t block_count = (size - offset) / kAesBlockSize;
+  size_t position = output->size();
+  output->resize(position + (block_count + 1) * kAesBlockSize);
+  Aes256CbcEncrypt(key_schedule_, iv_, pending_, &(*output)[position], 1);
+  position += kAesBlockSize;
+  if (block_count != 0) {
+    Aes256CbcEncrypt(
+        key_schedule_, iv_, data + offset, &(*output)[position], block_count);
+    offset += block_count * kAesBlockSize;
+  }
+  pending_size_ = size - offset;
+  if (pending_size_ != 0) memcpy(pending_, data + offset, pending_size_);
+}
+
+void Aes256CbcEncryptor::Update(
+    const ByteData &data, std::vector<uint8_t> *output) {
+  const std::vector<uint8_t> bytes = data.GetBytes();
+  Update(bytes.data(), bytes.size(), output);
+}
+
+void Aes256CbcEncryptor::Final(std::vector<uint8_t> *output) {
+  CheckAesStreamArgument(nullptr, 0, output);
+  // PKCS#7 padding
+  const uint8_t padding = static_cast<uint8_t>(kAesBlockSize - pending_size_);
+  memset(pending_ + pending_size_, padding, padding);
+  const size_t position = output->size();
+  output->resize(position + kAesBlockSize);
+  Aes256CbcEncrypt(key_schedule_, iv_, pending_, &(*output)[position], 1);
+  pending_size_ = 0;
+}
+
+//////////////////////////////////
+/// Aes256CbcDecryptor
+//////////////////////////////////
+Aes256CbcDecryptor::Aes256CbcDecryptor(const ByteData &key, const ByteData &iv)
+    : key_schedule_(), iv_(), pending_(), pending_size_(0) {
+  InitializeAes256(key, iv, key_schedule_, iv_);
+}
+
+Aes256CbcDecryptor::~Aes256CbcDecryptor() {
+  wally_bzero(key_schedule_, sizeof(key_schedule_));
+  wally_bzero(iv_, sizeof(iv_));
+  wally_bzero(pending_, sizeof(pending_));
+}
+
+void Aes256CbcDecryptor::Update(
+    const uint8_t *data, size_t size, std::vector<uint8_t> *output) {
+  CheckAesStreamArgument(data, size, output);
+  if (size == 0) return;
+  size_t offset = std::min(kAesBlockSize - pending_size_, size);
+  memcpy(pending_ + pending_size_, data, offset);
+  pending_size_ += offset;
+  // keep the last block for the padding.
+  if (offset == size) return;
+
+  const size_t block_count = (size - offset - 1) / kAesBlockSize;
+  size_t position = output->size();
+  output->resize(position + (block_count + 1) * kAesBlockSize);
+  Aes256CbcDecrypt(key_schedule_, iv_, pending_, &(*output)[position], 1);
+  position += kAesBlockSize;
+  if (block_count != 0) {
+    Aes256CbcDecrypt(
+        key_schedule_, iv_, data + offset, &(*output)[position], block_count);
+    offset += block_count * kAesBlockSize;
+  }
+  pending_size_ = size - offset;
+  memcpy(pending_, data + offset, pending_size_);
+}
+
+void Aes256CbcDecryptor::Update(
+    const ByteData &data, std::vector<uint8_t> *output) {
+  const std::vector<uint8_t> bytes = data.GetBytes();
+  Update(bytes.data(), bytes.size(), output);
+}
+
+void Aes256CbcDecryptor::Final(std::vector<uint8_t> *output) {
+  CheckAesStreamArgument(nullptr, 0, output);
+  if (pending_size_ != kAesBlockSize) {
+    warn(CFD_LOG_SOURCE, "aes data size NG. remain={}", pending_size_);
+    throw CfdException(kCfdIllegalStateError, "Invalid aes data size.");
+  }
+  uint8_t block[kAesBlockSize];
+  Aes256CbcDecrypt(key_schedule_, iv_, pending_, block, 1);
+  pending_size_ = 0;
+
+  // check PKCS#7 padding without the data-dependent branch.
+  const uint8_t padding = block[kAesBlockSize - 1];
+  uint32_t invalid = static_cast<uint32_t>(padding == 0) |
+                     static_cast<uint32_t>(padding > kAesBlockSize);
+  for (size_t index = 0; index < kAesBlockSize; ++index) {
+    const uint32_t is_padding = static_cast<uint32_t>(
+        index >= (kAesBlockSize - (padding & 0x1f)));
+    invalid |= is_padding & static_cast<uint32_t>(block[index] != padding);
+  }
+  if (invalid != 0) {
+    wally_bzero(block, sizeof(block));
+    warn(CFD_LOG_SOURCE, "aes padding NG.");
+    throw CfdException(kCfdIllegalStateError, "Invalid aes padding.");
+  }
+  output->insert(output->end(), block, block + (kAesBlockSize - padding));
+  wally_bzero(block, sizeof(block));
+}
+
+//////////////////////////////////
+/// Aes256CtrCipher
+//////////////////////////////////
+/// minimum CTR block count per thread (256KiB)
+static constexpr size_t kAesCtrBlockCountPerThread = 16384;
+
+Aes256CtrCipher::Aes256CtrCipher(
+    const ByteData &key, const ByteData &iv, uint32_t thread_count)
+    : key_schedule_(),
+      counter_(),
+      keystream_(),
+      keystream_offset_(kAesBlockSize),
+      thread_count_(thread_count) {
+  InitializeAes256(key, iv, key_schedule_, counter_);
+}
+
+Aes256CtrCipher::~Aes256CtrCipher() {
+  wally_bzero(key_schedule_, sizeof(key_schedule_));
+  wally_bzero(keystream_, sizeof(keystream_));
+  wally_bzero(counter_, sizeof(counter_));
+}
+
+void Aes256CtrCipher::Update(const uint8_t *data, size_t size, uint8_t *output) {
+  CheckAesStreamArgument(data, size, output);
+  size_t offset = 0;
+  while ((keystream_offset_ < kAesBlockSize) && (offset < size)) {
+    output[offset] = data[offset] ^ keystream_[keystream_offset_];
+    ++keystream_offset_;
+    ++offset;
+  }
+
+  const size_t block_count = (size - offset) / kAesBlockSize;
+  if (block_count != 0) {
+    const uint8_t *source = data + offset;
+    uint8_t *target = output + offset;
+    ParallelFor(
+        block_count, thread_count_, kAesCtrBlockCountPerThread,
+        [this, source, target](size_t begin, size_t end) {
+          uint8_t counter[kAesBlockSize];
+          memcpy(counter, counter_, sizeof(counter));
+          AddAesCounter(counter, begin);
+          Aes256CtrTransform(
+              key_schedule_, counter, source + begin * kAesBlockSize,
+              target + begin * kAesBlockSize, end - begin);
+        });
+    AddAesCounter(counter_, block_count);
+    offset += block_count * kAesBlockSize;
+  }
+
+  if (offset < size) {
+    memset(keystream_, 0, sizeof(keystream_));
+    Aes256CtrTransform(key_schedule_, counter_, keystream_, keystream_, 1);
+    AddAesCounter(counter_, 1);
+    keystream_offset_ = 0;
+    while (offset < size) {
+      output[offset] = data[offset] ^ keystream_[keystream_offset_];
+      ++keystream_offset_;
+      ++offset;
+    }
+  }
+}
+
+ByteData Aes256CtrCipher::Update(const ByteData &data) {
+  std::vector<uint8_t> bytes = data.GetBytes();
+  Update(bytes.data(), bytes.size(), bytes.data());
+  return ByteData(bytes);
+}
+
 //////////////////////////////////
 /// RandomNumberUtil
 //////////////////////////////////
-std::vector<uint8_t> RandomNumberUtil::GetRandomBytes(int len) {
-#if defined(_WIN32) && defined(__GNUC__) && (__GNUC__ < 9)
-  // for mingw gcc lower 9
-  static std::mt19937 engine(static_cast<unsigned int>(time(nullptr)));
-#else
-  static std::random_device rd;
-  static std::mt19937 engine(rd());
+/// keystream buffer size of the random generator
+static constexpr size_t kRandomBufferSize = 4096;
+/// fork count of the process (updated in the child process)
+static std::atomic<uint32_t> g_random_fork_count(0);
+
+#if !defined(_WIN32)
+/**
+ * @brief Fork handler of the child process.
+ */
+static void OnRandomGeneratorFork() { g_random_fork_count.fetch_add(1); }
 #endif
-  std::vector<uint8_t> result(len);
 
-  int index = 0;
-  for (int i = 0; i < len / 4; i++) {
-    uint32_t random = engine();
-    memcpy(&result[index], reinterpret_cast<uint8_t *>(&random), 4);
-    index += 4;
+/**
+ * @brief ChaCha20 random generator of a thread.
+ * @details The keystream is buffered by kRandomBufferSize bytes. The first
+ *     key size bytes of each refill become the next key, and the used bytes
+ *     are cleared from the buffer, so the past output can not be recovered
+ *     from the state. It is reseeded from the system after a fork.
+ */
+class RandomGenerator {
+ public:
+  /**
+   * @brief constructor.
+   */
+  RandomGenerator()
+      : offset_(kRandomBufferSize),
+        fork_count_(0),
+        is_seeded_(false),
+        is_deterministic_(false) {}
+  /**
+   * @brief destructor.
+   */
+  ~RandomGenerator() {
+    wally_bzero(key_, sizeof(key_));
+    wally_bzero(buffer_, sizeof(buffer_));
+  }
+
+  /**
+   * @brief Set the seed.
+   * @param[in] seed              seed (kChaCha20KeySize)
+   * @param[in] is_deterministic  keep the seed after a fork
+   */
+  void Seed(const uint8_t *seed, bool is_deterministic) {
+    memcpy(key_, seed, sizeof(key_));
+    wally_bzero(buffer_, sizeof(buffer_));
+    offset_ = kRandomBufferSize;
+    fork_count_ = g_random_fork_count.load();
+    is_seeded_ = true;
+    is_deterministic_ = is_deterministic;
+  }
+
+  /**
+   * @brief Reseed from the system at the next generation.
+   */
+  void Reset() {
+    is_seeded_ = false;
+    is_deterministic_ = false;
+  }
+
+  /**
+   * @brief Generate random bytes.
+   * @param[out] output   output buffer
+   * @param[in] size      output size
+   */
+  void Generate(uint8_t *output, size_t size) {
+    if ((!is_seeded_) ||
+        ((!is_deterministic_) &&
+         (fork_count_ != g_random_fork_count.load()))) {
+      uint8_t seed[kChaCha20KeySize];
+      GetSystemRandomBytes(seed, sizeof(seed));
+      Seed(seed, false);
+      wally_bzero(seed, sizeof(seed));
+    }
+
+    size_t offset = 0;
+    while (offset < size) {
+      if (offset_ == kRandomBufferSize) Refill();
+      size_t copy_size = std::min(size - offset, kRandomBufferSize - offset_);
+      memcpy(output + offset, buffer_ + offset_, copy_size);
+      memset(buffer_ + offset_, 0, copy_size);
+      offset_ += copy_size;
+      offset += copy_size;
+    }
   }
 
-  int remainder = len % 4;
-  if (remainder != 0) {
-    uint32_t random = engine();
-    memcpy(&result[index], reinterpret_cast<uint8_t *>(&random), remainder);
+ private:
+  uint8_t key_[kChaCha20KeySize];     //!< current key
+  uint8_t buffer_[kRandomBufferSize];  //!< keystream buffer
+  size_t offset_;                      //!< used byte size of the buffer
+  uint32_t fork_count_;                //!< fork count at the seeding
+  bool is_seeded_;                     //!< seeded flag
+  bool is_deterministic_;              //!< deterministic seed flag
+
+  /**
+   * @brief Refill the keystream buffer and update the key.
+   */
+  void Refill() {
+    static const uint8_t kNonce[kChaCha20NonceSize] = {0};
+    ChaCha20Keystream(
+        key_, kNonce, 0, buffer_, kRandomBufferSize / kChaCha20BlockSize);
+    memcpy(key_, buffer_, sizeof(key_));
+    memset(buffer_, 0, sizeof(key_));
+    offset_ = sizeof(key_);
+  }
+};
+
+/**
+ * @brief Get the random generator of this thread.
+ * @return random generator
+ */
+static RandomGenerator &GetRandomGenerator() {
+#if !defined(_WIN32)
+  static const int kForkHandlerResult =
+      pthread_atfork(nullptr, nullptr, OnRandomGeneratorFork);
+  static_cast<void>(kForkHandlerResult);
+#endif
+  static thread_local RandomGenerator generator;
+  return generator;
+}
+
+void SetRandomDeterministicSeed(const uint8_t *seed) {
+  GetRandomGenerator().Seed(seed, true);
+}
+
+void ResetRandomSeed() { GetRandomGenerator().Reset(); }
+
+/**
+ * @brief Uniform random bit generator on the random generator of this thread.
+ */
+struct RandomEngine {
+  using result_type = uint32_t;  //!< result type
+  /**
+   * @brief Get the minimum value.
+   * @return minimum value
+   */
+  static constexpr result_type min() {
+    return std::numeric_limits<result_type>::min();
+  }
+  /**
+   * @brief Get the maximum value.
+   * @return maximum value
+   */
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+  /**
+   * @brief Generate a random value.
+   * @return random value
+   */
+  result_type operator()() {
+    uint8_t random[sizeof(result_type)];
+    GetRandomGenerator().Generate(random, sizeof(random));
+    result_type value;
+    memcpy(&value, random, sizeof(value));
+    return value;
   }
+};
 
+std::vector<uint8_t> RandomNumberUtil::GetRandomBytes(int len) {
+  std::vector<uint8_t> result(len);
+  if (!result.empty()) {
+    GetRandomGenerator().Generate(result.data(), result.size());
+  }
   return result;
 }
 
 std::vector<uint32_t> RandomNumberUtil::GetRandomIndexes(uint32_t length) {
-#if defined(_WIN32) && defined(__GNUC__) && (__GNUC__ < 9)
-  // for mingw gcc lower 9
-  static std::mt19937 engine(static_cast<unsigned int>(time(nullptr)));
-#else
-  static std::random_device rd;
-  static std::mt19937 engine(rd());
-#endif
+  RandomEngine engine;
   std::uniform_int_distribution<> dist(0, length);
   std::vector<uint32_t> result(length);
   std::set<uint32_t> exist_value;
@@ -1189,13 +2630,7 @@ std::vector<uint32_t> RandomNumberUtil::GetRandomIndexes(uint32_t length) {
 }
 
 bool RandomNumberUtil::GetRandomBool(std::vector<bool> *random_cache) {
-#if defined(_WIN32) && defined(__GNUC__) && (__GNUC__ < 9)
-  // for mingw gcc lower 9
-  static std::mt19937 engine(static_cast<unsigned int>(time(nullptr)));
-#else
-  static std::random_device rd;
-  static std::mt19937 engine(rd());
-#endif
+  RandomEngine engine;
   if (random_cache == nullptr) {
     throw CfdException(kCfdIllegalArgumentError, "GetRandomBool error.");
   }
@@ -1212,17 +2647,14 @@ bool RandomNumberUtil::GetRandomBool(std::vector<bool> *random_cache) {
   return ret;
 }
 
+
 //////////////////////////////////
 /// StringUtil
 //////////////////////////////////
 bool StringUtil::IsValidHexString(const std::string &hex_str) {
   if (hex_str.empty()) return true;
-
-  std::vector<uint8_t> buffer(hex_str.size() + 1);
-  size_t buf_size = 0;
-  int ret = wally_hex_to_bytes(
-      hex_str.data(), buffer.data(), buffer.size(), &buf_size);
-  return (ret == WALLY_OK);
+  if ((hex_str.size() % 2) != 0) return false;
+  return DecodeHex(hex_str.data(), hex_str.size() / 2, nullptr);
 }
 
 std::vector<uint8_t> StringUtil::StringToByte(const std::string &hex_str) {
@@ -1230,38 +2662,60 @@ std::vector<uint8_t> StringUtil::StringToByte(const std::string &hex_str) {
     info(CFD_LOG_SOURCE, "hex_str empty. return empty buffer.");
     return std::vector<uint8_t>();
   }
-  std::vector<uint8_t> buffer(hex_str.size() + 1);
-  size_t buf_size = 0;
-  int ret = wally_hex_to_bytes(
-      hex_str.data(), buffer.data(), buffer.size(), &buf_size);
-  if (ret == WALLY_OK) {
-    buffer.resize(buf_size);
-  } else {
-    warn(CFD_LOG_SOURCE, "wally_hex_to_bytes NG[{}].", ret);
+  std::vector<uint8_t> buffer(hex_str.size() / 2);
+  StringToByte(hex_str.data(), hex_str.size(), buffer.data(), buffer.size());
+  return buffer;
+}
+
+size_t StringUtil::StringToByte(
+    const char *hex_str, size_t hex_size, uint8_t *output,
+    size_t output_size) {
+  if (hex_size == 0) return 0;
+  if ((hex_str == nullptr) || (output == nullptr)) {
+    warn(CFD_LOG_SOURCE, "hex_str or output is null.");
     throw CfdException(kCfdIllegalArgumentError, "hex to byte convert error.");
   }
-
-  return buffer;
+  if ((hex_size % 2) != 0) {
+    warn(CFD_LOG_SOURCE, "hex string length is odd. size={}", hex_size);
+    throw CfdException(kCfdIllegalArgumentError, "hex to byte convert error.");
+  }
+  size_t size = hex_size / 2;
+  if (output_size < size) {
+    warn(CFD_LOG_SOURCE, "output buffer is too small. size={}", output_size);
+    throw CfdException(kCfdIllegalArgumentError, "hex to byte convert error.");
+  }
+  if (!DecodeHex(hex_str, size, output)) {
+    warn(CFD_LOG_SOURCE, "hex string contains invalid character.");
+    throw CfdException(kCfdIllegalArgumentError, "hex to byte convert error.");
+  }
+  return size;
 }
 
 std::string StringUtil::ByteToString(const std::vector<uint8_t> &bytes) {
-  std::string byte_str;
   if (bytes.empty()) {
     info(CFD_LOG_SOURCE, "bytes empty. return empty string.");
-  } else {
-    char *buffer = NULL;
-    int ret = wally_hex_from_bytes(bytes.data(), bytes.size(), &buffer);
-    if (ret == WALLY_OK) {
-      byte_str = WallyUtil::ConvertStringAndFree(buffer);
-    } else {
-      warn(CFD_LOG_SOURCE, "wally_hex_from_bytes NG[{}].", ret);
-      throw CfdException(
-          kCfdIllegalArgumentError, "byte to hex convert error.");
-    }
+    return std::string();
   }
+  std::string byte_str(bytes.size() * 2, '\0');
+  ByteToString(bytes.data(), bytes.size(), &byte_str[0], byte_str.size());
   return byte_str;
 }
 
+size_t StringUtil::ByteToString(
+    const uint8_t *bytes, size_t size, char *output, size_t output_size) {
+  if (size == 0) return 0;
+  if ((bytes == nullptr) || (output == nullptr)) {
+    warn(CFD_LOG_SOURCE, "bytes or output is null.");
+    throw CfdException(kCfdIllegalArgumentError, "byte to hex convert error.");
+  }
+  if ((output_size / 2) < size) {
+    warn(CFD_LOG_SOURCE, "output buffer is too small. size={}", output_size);
+    throw CfdException(kCfdIllegalArgumentError, "byte to hex convert error.");
+  }
+  EncodeHex(bytes, size, output);
+  return size * 2;
+}
+
 std::string StringUtil::ToLower(const std::string &str) {
   static auto tolower_func = [](const char &c_value) -> char {
     return static_cast<char>(std::tolower(static_cast<char>(c_value)));
@@ -16,6 +16,7 @@
 #include "cfdcore/cfdcore_exception.h"
 #include "cfdcore/cfdcore_logger.h"
 #include "cfdcore/cfdcore_util.h"
+#include "cfdcore_manager.h"    // NOLINT
 #include "cfdcore_secp256k1.h"  // NOLINT
 #include "wally_address.h"      // NOLINT
 #include "wally_bip32.h"        // NOLINT
@@ -37,8 +38,6 @@ using logger::warn;
 
 /// length of bip39 wordlist array
 static constexpr size_t kWordlistLength = BIP39_WORDLIST_LEN;
-/// length of bytes for bip39 seed binary
-static constexpr size_t kSeedBytesLen = BIP39_SEED_LEN_512;
 /// delimiter for libwally mnemonic_sentence
 static const char kMnemonicDelimiter[] = {0x20, 0};  // u8"\u0020";
 /// delimiter for libwally mnemonic_sentence (jp language specific)
@@ -83,14 +82,14 @@ std::string WallyUtil::ConvertStringAndFree(char* wally_string) {
 
 ByteData WallyUtil::CombinePubkeySecp256k1Ec(
     const std::vector<ByteData>& pubkey_list) {
-  struct secp256k1_context_struct* context = wally_get_secp_context();
+  struct secp256k1_context_struct* context = GetSecp256k1Context();
 
   Secp256k1 secp256k1(context);
   return secp256k1.CombinePubkeySecp256k1Ec(pubkey_list);
 }
 
 ByteData WallyUtil::CompressPubkey(const ByteData& uncompressed_pubkey) {
-  struct secp256k1_context_struct* context = wally_get_secp_context();
+  struct secp256k1_context_struct* context = GetSecp256k1Context();
 
   Secp256k1 secp256k1(context);
   return secp256k1.CompressPubkeySecp256k1Ec(uncompressed_pubkey);
@@ -98,7 +97,7 @@ ByteData WallyUtil::CompressPubkey(const ByteData& uncompressed_pubkey) {
 
 ByteData WallyUtil::AddTweakPrivkey(
     const ByteData& privkey, const ByteData256& tweak) {
-  struct secp256k1_context_struct* context = wally_get_secp_context();
+  struct secp256k1_context_struct* context = GetSecp256k1Context();
   Secp256k1 secp256k1(context);
   return secp256k1.AddTweakPrivkeySecp256k1Ec(
       privkey, ByteData(tweak.GetBytes()));
@@ -106,7 +105,7 @@ ByteData WallyUtil::AddTweakPrivkey(
 
 ByteData WallyUtil::MulTweakPrivkey(
     const ByteData& privkey, const ByteData256& tweak) {
-  struct secp256k1_context_struct* context = wally_get_secp_context();
+  struct secp256k1_context_struct* context = GetSecp256k1Context();
   Secp256k1 secp256k1(context);
   return secp256k1.MulTweakPrivkeySecp256k1Ec(
       privkey, ByteData(tweak.GetBytes()));
@@ -114,7 +113,7 @@ ByteData WallyUtil::MulTweakPrivkey(
 
 ByteData WallyUtil::AddTweakPubkey(
     const ByteData& pubkey, const ByteData256& tweak, bool is_tweak_check) {
-  struct secp256k1_context_struct* context = wally_get_secp_context();
+  struct secp256k1_context_struct* context = GetSecp256k1Context();
   Secp256k1 secp256k1(context);
   return secp256k1.AddTweakPubkeySecp256k1Ec(
       pubkey, ByteData(tweak.GetBytes()), is_tweak_check);
@@ -122,7 +121,7 @@ ByteData WallyUtil::AddTweakPubkey(
 
 ByteData WallyUtil::MulTweakPubkey(
     const ByteData& pubkey, const ByteData256& tweak) {
-  struct secp256k1_context_struct* context = wally_get_secp_context();
+  struct secp256k1_context_struct* context = GetSecp256k1Context();
   Secp256k1 secp256k1(context);
   return secp256k1.MulTweakPubkeySecp256k1Ec(
       pubkey, ByteData(tweak.GetBytes()));
@@ -155,13 +154,13 @@ std::vector<uint8_t> WallyUtil::CreateScriptDataFromBytes(
 }
 
 ByteData WallyUtil::NegatePrivkey(const ByteData& privkey) {
-  struct secp256k1_context_struct* context = wally_get_secp_context();
+  struct secp256k1_context_struct* context = GetSecp256k1Context();
   Secp256k1 secp256k1(context);
   return secp256k1.NegatePrivkeySecp256k1Ec(privkey);
 }
 
 ByteData WallyUtil::NegatePubkey(const ByteData& pubkey) {
-  struct secp256k1_context_struct* context = wally_get_secp_context();
+  struct secp256k1_context_struct* context = GetSecp256k1Context();
   Secp256k1 secp256k1(context);
   return secp256k1.NegatePubkeySecp256k1Ec(pubkey);
 }
@@ -169,7 +168,7 @@ ByteData WallyUtil::NegatePubkey(const ByteData& pubkey) {
 void WallyUtil::RangeProofInfo(
     const ByteData& bytes, int* exponent, int* mantissa, uint64_t* min_value,
     uint64_t* max_value) {
-  struct secp256k1_context_struct* context = wally_get_secp_context();
+  struct secp256k1_context_struct* context = GetSecp256k1Context();
 
   Secp256k1 secp256k1(context);
   secp256k1.RangeProofInfoSecp256k1(
@@ -180,7 +179,7 @@ ByteData WallyUtil::SignWhitelist(
     const ByteData& offline_pubkey, const ByteData256& online_privkey,
     const ByteData256& tweak_sum, const std::vector<ByteData>& online_keys,
     const std::vector<ByteData>& offline_keys, uint32_t whitelist_index) {
-  struct secp256k1_context_struct* context = wally_get_secp_context();
+  struct secp256k1_context_struct* context = GetSecp256k1Context();
   Secp256k1 secp256k1(context);
   return secp256k1.SignWhitelistSecp256k1Ec(
       offline_pubkey, online_privkey, tweak_sum, online_keys, offline_keys,
@@ -201,29 +200,13 @@ std::vector<std::string> WallyUtil::GetMnemonicWordlist(
   return wordlist;
 }
 
-ByteData WallyUtil::ConvertMnemonicToSeed(
-    const std::vector<std::string>& mnemonic, const std::string& passphrase,
-    bool use_ideographic_space) {
+std::string WallyUtil::JoinMnemonic(
+    const std::vector<std::string>& mnemonic, bool use_ideographic_space) {
   std::string delimitor = kMnemonicDelimiter;
   if (use_ideographic_space) {
     delimitor = kMnemonicIdeographicDelimiter;
   }
-  std::string mnemonic_sentence = StringUtil::Join(mnemonic, delimitor);
-  std::vector<uint8_t> seed_bytes(kByteData512Length);
-  size_t out_size = 0;
-  int ret = bip39_mnemonic_to_seed(
-      mnemonic_sentence.c_str(), passphrase.c_str(), seed_bytes.data(),
-      kSeedBytesLen, &out_size);
-  if (ret != WALLY_OK) {
-    warn(CFD_LOG_SOURCE, "Convert mnemonic to seed error. ret=[{}]", ret);
-    throw CfdException(
-        CfdError::kCfdIllegalArgumentError, "Convert mnemonic to seed error.");
-  }
-
-  seed_bytes.resize(out_size);
-  ByteData seed(seed_bytes);
-
-  return seed;
+  return StringUtil::Join(mnemonic, delimitor);
 }
 
 std::vector<std::string> WallyUtil::ConvertEntropyToMnemonic(
@@ -255,11 +238,8 @@ ByteData WallyUtil::ConvertMnemonicToEntropy(
     bool use_ideographic_space) {
   words* wally_wordlist = Bip39GetWordlist(language);
 
-  std::string delimitor = kMnemonicDelimiter;
-  if (use_ideographic_space) {
-    delimitor = kMnemonicIdeographicDelimiter;
-  }
-  std::string mnemonic_sentence = StringUtil::Join(mnemonic, delimitor);
+  std::string mnemonic_sentence =
+      JoinMnemonic(mnemonic, use_ideographic_space);
 
   std::vector<uint8_t> entropy_bytes(kByteData512Length);
   size_t out_size = 0;
@@ -158,19 +158,14 @@ class WallyUtil {
       const std::string& language);
 
   /**
-   * @brief mnemonic と passphrase から seed を生成する.
-   * @details This function doesn't check mnemonic words strictly.
-   *     If you need to check mnemonic is valid, may use CheckValidMnemonic.
+   * @brief Join the mnemonic words to a sentence.
    * @param[in] mnemonic    mnemonic words list.
-   * @param[in] passphrase  passphrase used as a solt.
    * @param[in] use_ideographic_space   flag of using ideographic space
    *     for mnemonic separator
-   * @return binary seed to use hdwallet.
-   * @throws CfdException   If invalid argument passed.
+   * @return mnemonic sentence.
    */
-  static ByteData ConvertMnemonicToSeed(
-      const std::vector<std::string>& mnemonic, const std::string& passphrase,
-      bool use_ideographic_space = false);
+  static std::string JoinMnemonic(
+      const std::vector<std::string>& mnemonic, bool use_ideographic_space);
 
   /**
    * @brief Entropy から Mnemonic を生成する.
@@ -9,6 +9,7 @@
 #include "cfdcore/cfdcore_exception.h"
 #include "cfdcore/cfdcore_key.h"
 #include "cfdcore/cfdcore_schnorrsig.h"
+#include "cfdcore_manager.h"      // NOLINT
 #include "secp256k1.h"            // NOLINT
 #include "secp256k1_extrakeys.h"  // NOLINT
 #include "wally_core.h"           // NOLINT
@@ -25,7 +26,7 @@ using cfd::core::SchnorrPubkey;
 
 secp256k1_pubkey ParsePubkey(const Pubkey& pubkey) {
   auto pubkey_bytes = pubkey.GetData().GetBytes();
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   secp256k1_pubkey result;
   int ret = secp256k1_ec_pubkey_parse(
       ctx, &result, pubkey_bytes.data(), pubkey_bytes.size());
@@ -38,7 +39,7 @@ secp256k1_pubkey ParsePubkey(const Pubkey& pubkey) {
 }
 
 secp256k1_xonly_pubkey ParseXOnlyPubkey(const SchnorrPubkey& pubkey) {
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   secp256k1_xonly_pubkey xonly_pubkey;
 
   auto ret = secp256k1_xonly_pubkey_parse(
@@ -53,7 +54,7 @@ secp256k1_xonly_pubkey ParseXOnlyPubkey(const SchnorrPubkey& pubkey) {
 }
 
 secp256k1_ecdsa_signature ParseSignature(const ByteData& signature) {
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   secp256k1_ecdsa_signature result;
   auto ret = secp256k1_ecdsa_signature_parse_compact(
       ctx, &result, signature.GetBytes().data());
@@ -69,7 +70,7 @@ secp256k1_ecdsa_signature ParseSignature(const ByteData& signature) {
 
 secp256k1_xonly_pubkey GetXOnlyPubkeyFromPubkey(
     const secp256k1_pubkey& pubkey, bool* parity) {
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   secp256k1_xonly_pubkey xonly_pubkey;
   int pk_parity = 0;
 
@@ -86,7 +87,7 @@ secp256k1_xonly_pubkey GetXOnlyPubkeyFromPubkey(
 
 ByteData256 TweakAddXonlyPubkey(
     const SchnorrPubkey& pubkey, const ByteData256& tweak, bool* parity) {
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   auto base_xonly_key = ParseXOnlyPubkey(pubkey);
   std::vector<uint8_t> tweak_bytes = tweak.GetBytes();
   secp256k1_pubkey tweak_pubkey;
@@ -106,7 +107,7 @@ ByteData256 TweakAddXonlyPubkey(
 bool CheckTweakAddXonlyPubkey(
     const SchnorrPubkey& tweaked_pubkey, const SchnorrPubkey& base_pubkey,
     const ByteData256& tweak, bool parity) {
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   std::vector<uint8_t> tweak_xonly_key = tweaked_pubkey.GetData().GetBytes();
   auto base_xonly_key = ParseXOnlyPubkey(base_pubkey);
   std::vector<uint8_t> tweak_bytes = tweak.GetBytes();
@@ -120,7 +121,7 @@ bool CheckTweakAddXonlyPubkey(
 }
 
 Pubkey ConvertSecpPubkey(const secp256k1_pubkey& pubkey) {
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   std::vector<uint8_t> result_bytes(Pubkey::kCompressedPubkeySize);
   size_t result_bytes_size = result_bytes.size();
   int ret = secp256k1_ec_pubkey_serialize(
@@ -135,7 +136,7 @@ Pubkey ConvertSecpPubkey(const secp256k1_pubkey& pubkey) {
 }
 
 ByteData256 ConvertSchnorrPubkey(const secp256k1_xonly_pubkey& pubkey) {
-  auto ctx = wally_get_secp_context();
+  auto ctx = GetSecp256k1Context();
   std::vector<uint8_t> result_bytes(SchnorrPubkey::kSchnorrPubkeySize);
   int ret =
       secp256k1_xonly_pubkey_serialize(ctx, result_bytes.data(), &pubkey);
@@ -1,4 +1,9 @@
 #include "gtest/gtest.h"
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -11,6 +16,8 @@
 #include "cfdcore/cfdcore_taproot.h"
 
 using cfd::core::Address;
+using cfd::core::AddressFactory;
+using cfd::core::Bech32Util;
 using cfd::core::NetType;
 using cfd::core::WitnessVersion;
 using cfd::core::AddressType;
@@ -255,6 +262,50 @@ TEST(Address, TaprootScriptAddressTest) {
   }
 }
 
+TEST(Address, MoveTest) {
+  static_assert(std::is_nothrow_move_constructible<Address>::value,
+      "Address move constructor must be noexcept.");
+  static_assert(std::is_nothrow_move_assignable<Address>::value,
+      "Address move assignment must be noexcept.");
+  static_assert(
+      std::is_nothrow_move_constructible<TaprootScriptTree>::value,
+      "TaprootScriptTree move constructor must be noexcept.");
+#ifndef CFD_DISABLE_ELEMENTS
+  static_assert(
+      std::is_nothrow_move_constructible<ElementsConfidentialAddress>::value,
+      "ElementsConfidentialAddress move constructor must be noexcept.");
+#endif  // CFD_DISABLE_ELEMENTS
+  const std::string exp_address =
+      "bc1p3r0p5kdn3yultra5lrzlls74vwgdg057j8rmr4nlj8s8pucss7vsftyvah";
+  const SchnorrPubkey pubkey(
+      "1777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb");
+  ScriptBuilder build;
+  build.AppendOperator(ScriptOperator::OP_TRUE);
+  TaprootScriptTree tree(build.Build());
+  Address base_address(
+      NetType::kMainnet, WitnessVersion::kVersion1, tree, pubkey);
+
+  Address moved_address(std::move(base_address));
+  EXPECT_EQ(exp_address, moved_address.GetAddress());
+  EXPECT_EQ("tl(51)", moved_address.GetScriptTree().ToString());
+
+  Address assigned_address;
+  assigned_address = std::move(moved_address);
+  EXPECT_EQ(exp_address, assigned_address.GetAddress());
+  EXPECT_EQ(AddressType::kTaprootAddress,
+      assigned_address.GetAddressType());
+  EXPECT_EQ("tl(51)", assigned_address.GetScriptTree().ToString());
+  EXPECT_EQ(
+      "512088de1a59b38939f58fb4f8c5ffc3d56390d43e9e91c7b1d67f91e070f3108799",
+      assigned_address.GetLockingScript().GetHex());
+
+  std::vector<Address> addresses(4, assigned_address);
+  addresses.reserve(32);
+  for (const auto& item : addresses) {
+    EXPECT_EQ(exp_address, item.GetAddress());
+  }
+}
+
 TEST(Address, NoSegwitAddressFromHashTest) {
   const Pubkey pubkey = Pubkey(
       "027592aab5d43618dda13fba71e3993cd7517a712d3da49664c06ee1bd3d1f70af");
@@ -1036,6 +1087,214 @@ TEST(Address, PegoutAddressTest) {
 
 #endif  // CFD_DISABLE_ELEMENTS
 
+TEST(Address, ParseTest) {
+  std::vector<std::string> address_list = {
+      "1ELuNB5fLNUcrLzb93oJDPmjxjnsVwhNHn",
+      "mtrrfEAe9PusdTUCrcmg3Jz4pjPaSnTiCc",
+      "3K4cCA6U45jhvBcgc8qEdjHGDGyUMuVRpG",
+      "2NAcpFu2VfYF47yFEHGT7FgGXRdBeBHNfHU",
+      "bc1qjfw5q2ygp0gvn450h3lu0hlwjanfsc5uax7v9q",
+      "tb1qcc5c9wnzly8zj2dcsvxv83kupsu0uamx69u0y9lsmw7shuns2gqs44ltpt",
+      "bc1pzamhq9jglfxaj0r5ahvatr8uc77u973s5tm04yytdltsey5r8naspp3kr4",
+      "bcrt1p3r0p5kdn3yultra5lrzlls74vwgdg057j8rmr4nlj8s8pucss7vsn6c9jz",
+  };
+  for (const auto& address_str : address_list) {
+    Address address(address_str);
+    auto result = Address::Parse(address_str);
+    EXPECT_EQ(cfd::core::kCfdSuccess, result.error) << address_str;
+    EXPECT_EQ(address.GetNetType(), result.net_type) << address_str;
+    EXPECT_EQ(address.GetAddressType(), result.address_type) << address_str;
+    EXPECT_EQ(address.GetWitnessVersion(), result.witness_version)
+        << address_str;
+    EXPECT_EQ(address.GetLockingScript().GetHex(),
+        ByteData(result.locking_script, result.locking_script_size).GetHex())
+        << address_str;
+  }
+
+  auto upper = Address::Parse("BC1QW508D6QEJXTDG4Y5R3ZARVARY0C5XW7KV8F3T4");
+  EXPECT_EQ(cfd::core::kCfdSuccess, upper.error);
+  EXPECT_EQ(NetType::kMainnet, upper.net_type);
+  EXPECT_EQ(AddressType::kP2wpkhAddress, upper.address_type);
+  EXPECT_EQ("0014751e76e8199196d454941c45d1b3a323f1433bd6",
+      ByteData(upper.locking_script, upper.locking_script_size).GetHex());
+
+  auto unknown = Address::Parse("bc1zw508d6qejxtdg4y5r3zarvaryvaxxpcs");
+  EXPECT_EQ(cfd::core::kCfdSuccess, unknown.error);
+  EXPECT_EQ(AddressType::kWitnessUnknown, unknown.address_type);
+  EXPECT_EQ(WitnessVersion::kVersion2, unknown.witness_version);
+
+  std::vector<std::string> invalid_list = {
+      "",
+      "1",
+      "1ELuNB5fLNUcrLzb93oJDPmjxjnsVwhNHm",
+      "2NAcpFu2VfYF47yFEHGT7FgGXRdBeBHXfHU",
+      "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kemeawh",
+      "bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vq5zuyut",
+      "ex1qjfw5q2ygp0gvn450h3lu0hlwjanfsc5uax7v9q",
+      "5HueCGU8rMjxEXxiPuD5BDku4MkFqeZyd4dZ1jvhTVqvbTLvyTJ",
+  };
+  for (const auto& address_str : invalid_list) {
+    auto result = Address::Parse(address_str);
+    EXPECT_EQ(cfd::core::kCfdIllegalArgumentError, result.error)
+        << address_str;
+  }
+
+  std::string custom_json = "[{"
+      "\"nettype\":\"regtest\",\"p2pkh\":\"95\","
+      "\"p2sh\":\"a2\",\"bech32\":\"brt\""
+    "}]";
+  auto format_list = AddressFormatData::ConvertListFromJson(custom_json);
+  auto custom = Address::Parse(
+      "23CLVd4USvrBN6atcvbATtsnFi1jFJzBMWG", format_list);
+  EXPECT_EQ(cfd::core::kCfdSuccess, custom.error);
+  EXPECT_EQ(NetType::kRegtest, custom.net_type);
+  EXPECT_EQ(AddressType::kP2pkhAddress, custom.address_type);
+  custom = Address::Parse(
+      "brt1qn98wsxje7xk68axrn979fuzqrd04880s345gz2", format_list);
+  EXPECT_EQ(cfd::core::kCfdSuccess, custom.error);
+  EXPECT_EQ(NetType::kRegtest, custom.net_type);
+  EXPECT_EQ("0014994ee81a59f1ada3f4c3997c54f0401b5f539df0",
+      ByteData(custom.locking_script, custom.locking_script_size).GetHex());
+  EXPECT_EQ(cfd::core::kCfdIllegalArgumentError, Address::Parse(
+      "1ELuNB5fLNUcrLzb93oJDPmjxjnsVwhNHn", format_list).error);
+}
+
+TEST(AddressFactory, CreateBatchFromPubkey) {
+  const std::vector<Pubkey> pubkey_list = {
+      Pubkey(
+          "02d21c625759280111907a06df050cccbc875b11a50bdafa71dae5d1e8695ba82e"),
+      Pubkey(
+          "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"),
+      Pubkey(
+          "0479be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+          "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8"),
+  };
+  std::vector<Pubkey> pubkeys;
+  for (size_t index = 0; index < 301; ++index) {
+    pubkeys.push_back(pubkey_list[index % pubkey_list.size()]);
+  }
+
+  for (uint32_t thread_count : {1, 4, 0}) {
+    std::vector<Address> p2pkh_list = AddressFactory::CreateBatch(
+        NetType::kMainnet, AddressType::kP2pkhAddress, pubkeys, thread_count);
+    std::vector<Address> p2wpkh_list = AddressFactory::CreateBatch(
+        NetType::kTestnet, AddressType::kP2wpkhAddress, pubkeys,
+        thread_count);
+    std::vector<Address> p2sh_p2wpkh_list = AddressFactory::CreateBatch(
+        NetType::kMainnet, AddressType::kP2shP2wpkhAddress, pubkeys,
+        thread_count);
+    ASSERT_EQ(pubkeys.size(), p2pkh_list.size());
+    ASSERT_EQ(pubkeys.size(), p2wpkh_list.size());
+    ASSERT_EQ(pubkeys.size(), p2sh_p2wpkh_list.size());
+    EXPECT_EQ("1Eycut4X8y8pF17iH5XyeCE2vrLhP4Q3y2",
+        p2pkh_list[0].GetAddress());
+    EXPECT_EQ("tb1qn98wsxje7xk68axrn979fuzqrd04880s7ltgxt",
+        p2wpkh_list[0].GetAddress());
+
+    for (size_t index = 0; index < pubkeys.size(); index += 5) {
+      Address p2pkh(NetType::kMainnet, pubkeys[index]);
+      EXPECT_EQ(p2pkh.GetAddress(), p2pkh_list[index].GetAddress());
+      EXPECT_EQ(p2pkh.GetHash().GetHex(),
+          p2pkh_list[index].GetHash().GetHex());
+      EXPECT_EQ(AddressType::kP2pkhAddress,
+          p2pkh_list[index].GetAddressType());
+      EXPECT_EQ(NetType::kMainnet, p2pkh_list[index].GetNetType());
+      EXPECT_EQ(pubkeys[index].GetHex(),
+          p2pkh_list[index].GetPubkey().GetHex());
+
+      Address p2wpkh(
+          NetType::kTestnet, WitnessVersion::kVersion0, pubkeys[index]);
+      EXPECT_EQ(p2wpkh.GetAddress(), p2wpkh_list[index].GetAddress());
+      EXPECT_EQ(p2wpkh.GetLockingScript().GetHex(),
+          p2wpkh_list[index].GetLockingScript().GetHex());
+      EXPECT_EQ(WitnessVersion::kVersion0,
+          p2wpkh_list[index].GetWitnessVersion());
+
+      Script wpkh_script = ScriptUtil::CreateP2wpkhLockingScript(
+          pubkeys[index]);
+      Address p2sh_p2wpkh(NetType::kMainnet, wpkh_script);
+      EXPECT_EQ(p2sh_p2wpkh.GetAddress(),
+          p2sh_p2wpkh_list[index].GetAddress());
+      EXPECT_EQ(p2sh_p2wpkh.GetLockingScript().GetHex(),
+          p2sh_p2wpkh_list[index].GetLockingScript().GetHex());
+      EXPECT_EQ(wpkh_script.GetHex(),
+          p2sh_p2wpkh_list[index].GetScript().GetHex());
+      EXPECT_EQ(AddressType::kP2shP2wpkhAddress,
+          p2sh_p2wpkh_list[index].GetAddressType());
+    }
+  }
+
+  EXPECT_THROW(AddressFactory::CreateBatch(
+      NetType::kMainnet, AddressType::kP2shAddress, pubkeys), CfdException);
+  EXPECT_THROW(AddressFactory::CreateBatch(
+      NetType::kLiquidV1, AddressType::kP2pkhAddress, pubkeys), CfdException);
+  EXPECT_TRUE(AddressFactory::CreateBatch(
+      NetType::kMainnet, AddressType::kP2pkhAddress,
+      std::vector<Pubkey>()).empty());
+}
+
+TEST(AddressFactory, CreateBatchFromScript) {
+  Pubkey pubkey(
+      "02d21c625759280111907a06df050cccbc875b11a50bdafa71dae5d1e8695ba82e");
+  std::vector<Script> scripts;
+  for (int64_t index = 0; index < 150; ++index) {
+    ScriptBuilder builder;
+    builder.AppendData(index);
+    builder.AppendOperator(ScriptOperator::OP_DROP);
+    if ((index % 3) == 0) {
+      // longer than a sha256 block.
+      builder.AppendData(pubkey);
+      builder.AppendOperator(ScriptOperator::OP_DROP);
+    }
+    builder.AppendData(pubkey);
+    builder.AppendOperator(ScriptOperator::OP_CHECKSIG);
+    scripts.push_back(builder.Build());
+  }
+
+  for (uint32_t thread_count : {1, 4, 0}) {
+    std::vector<Address> p2sh_list = AddressFactory::CreateBatch(
+        NetType::kRegtest, AddressType::kP2shAddress, scripts, thread_count);
+    std::vector<Address> p2wsh_list = AddressFactory::CreateBatch(
+        NetType::kMainnet, AddressType::kP2wshAddress, scripts,
+        GetBitcoinAddressFormatList(), thread_count);
+    std::vector<Address> p2sh_p2wsh_list = AddressFactory::CreateBatch(
+        NetType::kTestnet, AddressType::kP2shP2wshAddress, scripts,
+        thread_count);
+    ASSERT_EQ(scripts.size(), p2sh_list.size());
+    ASSERT_EQ(scripts.size(), p2wsh_list.size());
+    ASSERT_EQ(scripts.size(), p2sh_p2wsh_list.size());
+
+    for (size_t index = 0; index < scripts.size(); index += 4) {
+      Address p2sh(NetType::kRegtest, scripts[index]);
+      EXPECT_EQ(p2sh.GetAddress(), p2sh_list[index].GetAddress());
+      EXPECT_EQ(p2sh.GetHash().GetHex(),
+          p2sh_list[index].GetHash().GetHex());
+      EXPECT_EQ(scripts[index].GetHex(),
+          p2sh_list[index].GetScript().GetHex());
+
+      Address p2wsh(
+          NetType::kMainnet, WitnessVersion::kVersion0, scripts[index]);
+      EXPECT_EQ(p2wsh.GetAddress(), p2wsh_list[index].GetAddress());
+      EXPECT_EQ(p2wsh.GetHash().GetHex(), p2wsh_list[index].GetHash().GetHex());
+      EXPECT_EQ(p2wsh.GetLockingScript().GetHex(),
+          p2wsh_list[index].GetLockingScript().GetHex());
+
+      Script wsh_script = ScriptUtil::CreateP2wshLockingScript(
+          scripts[index]);
+      Address p2sh_p2wsh(NetType::kTestnet, wsh_script);
+      EXPECT_EQ(p2sh_p2wsh.GetAddress(),
+          p2sh_p2wsh_list[index].GetAddress());
+      EXPECT_EQ(wsh_script.GetHex(),
+          p2sh_p2wsh_list[index].GetScript().GetHex());
+      EXPECT_EQ(AddressType::kP2shP2wshAddress,
+          p2sh_p2wsh_list[index].GetAddressType());
+    }
+  }
+
+  EXPECT_THROW(AddressFactory::CreateBatch(
+      NetType::kMainnet, AddressType::kP2pkhAddress, scripts), CfdException);
+}
+
 TEST(AddressFormatData, CustomBitcoinAddressFormatList) {
   std::string custom_json = "[{"
       "\"nettype\":\"testnet\",\"p2pkh\":\"71\","
@@ -1108,6 +1367,81 @@ TEST(AddressFormatData, CustomBitcoinAddressFormatList) {
   cfd::core::ClearCustomAddressFormatList();
 }
 
+TEST(AddressFormatData, GetNetworkParams) {
+  std::map<std::string, std::string> map = {
+      {cfd::core::kNettype, "regtest"},
+      {cfd::core::kPrefixP2pkh, "6f"},
+      {cfd::core::kPrefixP2sh, "c4"},
+      {cfd::core::kPrefixBech32Hrp, "bcrt"},
+  };
+  AddressFormatData data(map);
+  AddressFormatData copy_data = data;
+  const auto& params = copy_data.GetNetworkParams();
+  EXPECT_TRUE(params.has_net_type);
+  EXPECT_EQ(NetType::kRegtest, params.net_type);
+  EXPECT_TRUE(params.has_p2pkh_prefix);
+  EXPECT_EQ(0x6f, params.p2pkh_prefix);
+  EXPECT_TRUE(params.has_p2sh_prefix);
+  EXPECT_EQ(0xc4, params.p2sh_prefix);
+  EXPECT_EQ("bcrt", params.bech32_hrp);
+  EXPECT_FALSE(params.has_blinded_p2pkh_prefix);
+  EXPECT_FALSE(params.has_blinded_p2sh_prefix);
+  EXPECT_EQ("", params.blech32_hrp);
+  EXPECT_EQ(0x6f, data.GetP2pkhPrefix());
+  EXPECT_EQ(0xc4, data.GetP2shPrefix());
+  EXPECT_EQ("bcrt", data.GetBech32Hrp());
+
+  AddressFormatData empty_data;
+  EXPECT_FALSE(empty_data.GetNetworkParams().has_net_type);
+  EXPECT_FALSE(empty_data.GetNetworkParams().has_p2pkh_prefix);
+  EXPECT_THROW(empty_data.GetP2pkhPrefix(), CfdException);
+}
+
+TEST(AddressFormatData, CustomAddressFormatListMultiThread) {
+  std::string custom_json = "[{"
+      "\"nettype\":\"regtest\",\"p2pkh\":\"95\","
+      "\"p2sh\":\"a2\",\"bech32\":\"brt\""
+    "}]";
+  auto list = AddressFormatData::ConvertListFromJson(custom_json);
+  const Pubkey pk(
+      "02d21c625759280111907a06df050cccbc875b11a50bdafa71dae5d1e8695ba82e");
+  const std::string default_address =
+      "bcrt1qn98wsxje7xk68axrn979fuzqrd04880sukj93z";
+  const std::string custom_address =
+      "brt1qn98wsxje7xk68axrn979fuzqrd04880s345gz2";
+
+  std::atomic<bool> is_stop(false);
+  std::atomic<int> error_count(0);
+  std::vector<std::thread> threads;
+  for (int index = 0; index < 4; ++index) {
+    threads.emplace_back([&]() {
+      while (!is_stop.load()) {
+        Address address(NetType::kRegtest, WitnessVersion::kVersion0, pk);
+        std::string addr = address.GetAddress();
+        if ((addr != default_address) && (addr != custom_address)) {
+          ++error_count;
+        }
+        Address decoded(addr);
+        if (decoded.GetNetType() != NetType::kRegtest) ++error_count;
+      }
+    });
+  }
+  for (int count = 0; count < 200; ++count) {
+    cfd::core::SetCustomAddressFormatList(list);
+    cfd::core::ClearCustomAddressFormatList();
+  }
+  is_stop = true;
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(0, error_count.load());
+
+  cfd::core::SetCustomAddressFormatList(list);
+  EXPECT_EQ(custom_address, Address(
+      NetType::kRegtest, WitnessVersion::kVersion0, pk).GetAddress());
+  cfd::core::ClearCustomAddressFormatList();
+  EXPECT_EQ(default_address, Address(
+      NetType::kRegtest, WitnessVersion::kVersion0, pk).GetAddress());
+}
+
 #ifndef CFD_DISABLE_ELEMENTS
 
 TEST(AddressFormatData, CustomElementsAddressFormatList) {
@@ -1209,3 +1543,99 @@ TEST(AddressFormatData, CustomElementsAddressFormatList) {
 }
 
 #endif  // CFD_DISABLE_ELEMENTS
+
+TEST(Bech32Util, EncodeSegwitAddress) {
+  // BIP173 / BIP350 test vectors
+  EXPECT_EQ("bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4",
+      Bech32Util::EncodeSegwitAddress("bc",
+          ByteData("0014751e76e8199196d454941c45d1b3a323f1433bd6")));
+  EXPECT_EQ("tb1qrp33g0q5c5txsp9arysrx4k6zdkfs4nce4xj0gdcccefvpysxf3q0sl5k7",
+      Bech32Util::EncodeSegwitAddress("tb", ByteData(
+          "0020"
+          "1863143c14c5166804bd19203356da136c985678cd4d27a1b8c6329604903262")));
+  EXPECT_EQ(
+      "bc1pw508d6qejxtdg4y5r3zarvary0c5xw7kw508d6qejxtdg4y5r3zarvary0c5xw7k"
+      "t5nd6y",
+      Bech32Util::EncodeSegwitAddress("BC", ByteData(
+          "5128751e76e8199196d454941c45d1b3a323f1433bd6"
+          "751e76e8199196d454941c45d1b3a323f1433bd6")));
+  EXPECT_EQ("bc1sw50qgdz25j",
+      Bech32Util::EncodeSegwitAddress("bc", ByteData("6002751e")));
+
+  EXPECT_THROW(Bech32Util::EncodeSegwitAddress("bc",
+      ByteData("0013751e76e8199196d454941c45d1b3a323f1433b")), CfdException);
+  EXPECT_THROW(Bech32Util::EncodeSegwitAddress("bc",
+      ByteData("6101751e")), CfdException);
+  EXPECT_THROW(Bech32Util::EncodeSegwitAddress("",
+      ByteData("6002751e")), CfdException);
+}
+
+TEST(Bech32Util, DecodeSegwitAddress) {
+  uint8_t buffer[Bech32Util::kMaxWitnessScriptSize];
+  size_t written = 0;
+  EXPECT_TRUE(Bech32Util::DecodeSegwitAddress("bc",
+      "BC1QW508D6QEJXTDG4Y5R3ZARVARY0C5XW7KV8F3T4", buffer, sizeof(buffer),
+      &written));
+  EXPECT_EQ("0014751e76e8199196d454941c45d1b3a323f1433bd6",
+      ByteData(buffer, static_cast<uint32_t>(written)).GetHex());
+  EXPECT_TRUE(Bech32Util::DecodeSegwitAddress("tb",
+      "tb1pqqqqp399et2xygdj5xreqhjjvcmzhxw4aywxecjdzew6hylgvsesf3hn0c",
+      buffer, sizeof(buffer), &written));
+  EXPECT_EQ(
+      "5120000000c4a5cad46221b2a187905e5266362b99d5e91c6ce24d165dab93e86433",
+      ByteData(buffer, static_cast<uint32_t>(written)).GetHex());
+  EXPECT_TRUE(Bech32Util::DecodeSegwitAddress("bc",
+      "bc1zw508d6qejxtdg4y5r3zarvaryvaxxpcs", buffer, sizeof(buffer),
+      &written));
+  EXPECT_EQ("5210751e76e8199196d454941c45d1b3a323",
+      ByteData(buffer, static_cast<uint32_t>(written)).GetHex());
+
+  std::vector<std::string> invalid_list = {
+    // bech32m checksum for witness v0
+    "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kemeawh",
+    // bech32 checksum for witness v1
+    "bc1p0xlxvlhemja6c4dqv22uapctqupfhlxm9h8z3k2e72q4k9hcz7vq5zuyut",
+    // invalid program length
+    "bc1gmk9yu",
+    // mixed case
+    "tb1qrp33g0q5c5txsp9arysrx4k6zdkfs4nce4xj0gdcccefvpysxf3q0sL5k7",
+    // non-zero padding
+    "tb1qrp33g0q5c5txsp9arysrx4k6zdkfs4nce4xj0gdcccefvpysxf3pjxtptv",
+    // different hrp
+    "tb1qw508d6qejxtdg4y5r3zarvary0c5xw7kxpjzsx",
+  };
+  for (const auto& address : invalid_list) {
+    EXPECT_FALSE(Bech32Util::DecodeSegwitAddress("bc", address, buffer,
+        sizeof(buffer), &written)) << address;
+  }
+  // short buffer
+  EXPECT_FALSE(Bech32Util::DecodeSegwitAddress("bc",
+      "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4", buffer, 21, &written));
+
+  // hrp buffer (not null-terminated)
+  const char hrp_buffer[] = {'t', 'b', '1'};
+  EXPECT_TRUE(Bech32Util::DecodeSegwitAddress(hrp_buffer, 2,
+      "tb1pqqqqp399et2xygdj5xreqhjjvcmzhxw4aywxecjdzew6hylgvsesf3hn0c",
+      buffer, sizeof(buffer), &written));
+  EXPECT_EQ(size_t{34}, written);
+  EXPECT_FALSE(Bech32Util::DecodeSegwitAddress(hrp_buffer, 1,
+      "tb1pqqqqp399et2xygdj5xreqhjjvcmzhxw4aywxecjdzew6hylgvsesf3hn0c",
+      buffer, sizeof(buffer), &written));
+}
+
+TEST(Bech32Util, EncodeSegwitAddresses) {
+  std::vector<ByteData> script_list = {
+    ByteData("0014751e76e8199196d454941c45d1b3a323f1433bd6"),
+    ByteData("6002751e"),
+    ByteData("5210751e76e8199196d454941c45d1b3a323"),
+  };
+  std::vector<std::string> address_list =
+      Bech32Util::EncodeSegwitAddresses("bc", script_list);
+  ASSERT_EQ(script_list.size(), address_list.size());
+  for (size_t index = 0; index < script_list.size(); ++index) {
+    EXPECT_EQ(Bech32Util::EncodeSegwitAddress("bc", script_list[index]),
+        address_list[index]);
+  }
+  EXPECT_EQ("bc1zw508d6qejxtdg4y5r3zarvaryvaxxpcs", address_list[2]);
+  EXPECT_TRUE(Bech32Util::EncodeSegwitAddresses("bc", {}).empty());
+}
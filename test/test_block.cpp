@@ -138,3 +138,14 @@ TEST(Block, GetTransaction) {
   EXPECT_EQ(block.GetBlockHeader().prev_block_hash.GetHex(),
       block3.GetBlockHeader().prev_block_hash.GetHex());
 }
+
+TEST(Block, EmptyTransactionTxid) {
+  // 0-in/0-out transaction: version, 00 (txin count), 00 (txout count),
+  // locktime. The txid covers both count bytes.
+  std::string header_hex = "00000030957958949bad814d1666ed0d4a005c8aed6b7fd56df5d12c81d584c71e5fae2dfe391f9150dcfb06d54d4eb6621672590bf46bed6893da825c076b841794cec5414e2660ffff7f2000000000";
+  Block block(header_hex + "01" + "01000000000000000000");
+  EXPECT_EQ(1, block.GetTransactionCount());
+  EXPECT_EQ(
+      "d21633ba23f70118185227be58a63527675641ad37967e2aa461559f577aec43",
+      block.GetTxid(0).GetHex());
+}
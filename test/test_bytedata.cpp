@@ -1,10 +1,14 @@
 #include "gtest/gtest.h"
 #include <vector>
 #include <limits>
+#include <type_traits>
 
 #include "cfdcore/cfdcore_common.h"
+#include "cfdcore/cfdcore_block.h"
 #include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_coin.h"
 #include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_script.h"
 
 // https://qiita.com/yohm/items/477bac065f4b772127c7
 
@@ -15,6 +19,11 @@
 using cfd::core::ByteData;
 using cfd::core::ByteData160;
 using cfd::core::ByteData256;
+using cfd::core::Block;
+using cfd::core::BlockHash;
+using cfd::core::Script;
+using cfd::core::ScriptElement;
+using cfd::core::Txid;
 
 TEST(ByteData, DefaultConstructor) {
   ByteData byte_data;
@@ -251,3 +260,65 @@ TEST(ByteData, SplitData) {
     EXPECT_FALSE(sub_data == list[1]);
   }
 }
+
+TEST(ByteData, CopyOnWrite) {
+  std::vector<uint8_t> large_bytes(ByteData::kInlineCapacity + 1, 0x11);
+  ByteData small_data(std::vector<uint8_t>(ByteData::kInlineCapacity, 0x22));
+  ByteData large_data(large_bytes);
+  ByteData small_copy = small_data;
+  ByteData large_copy = large_data;
+
+  EXPECT_TRUE(small_copy == small_data);
+  EXPECT_TRUE(large_copy == large_data);
+
+  // small -> large
+  small_copy.Push(ByteData("33"));
+  EXPECT_EQ(ByteData::kInlineCapacity + 1, small_copy.GetDataSize());
+  EXPECT_EQ(ByteData::kInlineCapacity, small_data.GetDataSize());
+  EXPECT_EQ(0x33, small_copy.GetBytes().back());
+
+  // shared buffer is not changed.
+  large_copy.Push(ByteData("44"));
+  EXPECT_EQ(large_bytes.size() + 1, large_copy.GetDataSize());
+  EXPECT_EQ(large_bytes, large_data.GetBytes());
+  EXPECT_FALSE(large_copy == large_data);
+
+  ByteData self_data("0011");
+  self_data.Push(self_data);
+  EXPECT_EQ("00110011", self_data.GetHex());
+}
+
+TEST(ByteData, MoveConstructor) {
+  std::vector<uint8_t> large_bytes(100, 0x55);
+  ByteData large_data(large_bytes);
+  ByteData moved_data(std::move(large_data));
+  EXPECT_EQ(large_bytes, moved_data.GetBytes());
+
+  ByteData small_data("0011");
+  ByteData assign_data;
+  assign_data = std::move(small_data);
+  EXPECT_EQ("0011", assign_data.GetHex());
+
+  std::vector<ByteData> list;
+  for (uint8_t index = 0; index < 20; ++index) {
+    list.emplace_back(std::vector<uint8_t>(index * 5, index));
+  }
+  for (uint8_t index = 0; index < 20; ++index) {
+    EXPECT_EQ(static_cast<size_t>(index * 5), list[index].GetDataSize());
+  }
+}
+
+TEST(ByteData, NothrowMove) {
+  // std::vector moves the elements on reallocation only if noexcept.
+  EXPECT_TRUE(std::is_nothrow_move_constructible<ByteData>::value);
+  EXPECT_TRUE(std::is_nothrow_move_assignable<ByteData>::value);
+  EXPECT_TRUE(std::is_nothrow_move_constructible<Txid>::value);
+  EXPECT_TRUE(std::is_nothrow_move_assignable<Txid>::value);
+  EXPECT_TRUE(std::is_nothrow_move_constructible<BlockHash>::value);
+  EXPECT_TRUE(std::is_nothrow_move_assignable<BlockHash>::value);
+  EXPECT_TRUE(std::is_nothrow_move_constructible<Block>::value);
+  EXPECT_TRUE(std::is_nothrow_move_assignable<Block>::value);
+  EXPECT_TRUE(std::is_nothrow_move_constructible<ScriptElement>::value);
+  EXPECT_TRUE(std::is_nothrow_move_assignable<ScriptElement>::value);
+  EXPECT_TRUE(std::is_nothrow_move_constructible<Script>::value);
+}
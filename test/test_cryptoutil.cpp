@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -7,11 +8,18 @@
 #include "cfdcore/cfdcore_script.h"
 #include "cfdcore/cfdcore_exception.h"
 
+using cfd::core::Aes256CbcDecryptor;
+using cfd::core::Aes256CbcEncryptor;
+using cfd::core::Aes256CtrCipher;
+using cfd::core::Base64Decoder;
+using cfd::core::Base64Encoder;
 using cfd::core::ByteData;
 using cfd::core::ByteData160;
 using cfd::core::ByteData256;
 using cfd::core::CfdException;
 using cfd::core::CryptoUtil;
+using cfd::core::HmacSha256Context;
+using cfd::core::HmacSha512Context;
 using cfd::core::SigHashType;
 using cfd::core::SigHashAlgorithm;
 
@@ -365,6 +373,118 @@ TEST(CryptoUtil, DecryptAes256CbcToStringDataSizeError) {
   ASSERT_TRUE(false);
 }
 
+TEST(Aes256CbcEncryptor, Update) {
+  ByteData key(
+      "3334353637383930313233343536373833343536373839303132333435363738");
+  ByteData iv("33343536373839303132333435363738");
+  std::string text = "aiueoaiueoaiueoaiueoaiueoaiueoai";
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(text.data());
+  for (size_t split = 0; split <= text.size(); ++split) {
+    Aes256CbcEncryptor encryptor(key, iv);
+    std::vector<uint8_t> output;
+    encryptor.Update(data, split, &output);
+    encryptor.Update(data + split, text.size() - split, &output);
+    encryptor.Final(&output);
+    EXPECT_EQ(
+        "aaf07c2bce50048b41e931898ad647a38d91324abd47121aa4d625fbc2aeb3a8"
+        "d57df4f18f25599a4c40a9a7c547479c", ByteData(output).GetHex()) << split;
+  }
+
+  EXPECT_THROW(Aes256CbcEncryptor(ByteData("0102"), iv), CfdException);
+  EXPECT_THROW(Aes256CbcEncryptor(key, ByteData("0102")), CfdException);
+  try {
+    Aes256CbcEncryptor encryptor(ByteData("0102"), iv);
+    ASSERT_TRUE(false);
+  } catch (const CfdException &except) {
+    // same as CryptoUtil::EncryptAes256Cbc
+    EXPECT_EQ(cfd::core::kCfdIllegalStateError, except.GetErrorCode());
+  }
+}
+
+TEST(Aes256CbcDecryptor, Update) {
+  ByteData key(
+      "3334353637383930313233343536373833343536373839303132333435363738");
+  ByteData iv("33343536373839303132333435363738");
+  std::vector<uint8_t> data = ByteData(
+      "aaf07c2bce50048b41e931898ad647a38d91324abd47121aa4d625fbc2aeb3a8"
+      "d57df4f18f25599a4c40a9a7c547479c").GetBytes();
+  for (size_t split = 0; split <= data.size(); ++split) {
+    Aes256CbcDecryptor decryptor(key, iv);
+    std::vector<uint8_t> output;
+    decryptor.Update(data.data(), split, &output);
+    decryptor.Update(data.data() + split, data.size() - split, &output);
+    decryptor.Final(&output);
+    EXPECT_EQ("aiueoaiueoaiueoaiueoaiueoaiueoai",
+        std::string(output.begin(), output.end())) << split;
+  }
+
+  // round trip of the multi-block data
+  std::vector<uint8_t> plain(1000);
+  for (size_t index = 0; index < plain.size(); ++index) {
+    plain[index] = static_cast<uint8_t>(index * 7);
+  }
+  ByteData encrypted = CryptoUtil::EncryptAes256Cbc(key, iv, ByteData(plain));
+  EXPECT_EQ(ByteData(plain).GetHex(),
+      CryptoUtil::DecryptAes256Cbc(key, iv, encrypted).GetHex());
+
+  std::vector<uint8_t> output;
+  Aes256CbcDecryptor size_error(key, iv);
+  size_error.Update(data.data(), data.size() - 1, &output);
+  EXPECT_THROW(size_error.Final(&output), CfdException);
+  Aes256CbcDecryptor padding_error(ByteData256().GetData(), iv);
+  padding_error.Update(data.data(), data.size(), &output);
+  EXPECT_THROW(padding_error.Final(&output), CfdException);
+}
+
+TEST(Aes256CtrCipher, Update) {
+  // NIST SP 800-38A F.5.5 CTR-AES256.Encrypt
+  ByteData key(
+      "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4");
+  ByteData iv("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff");
+  ByteData plain(
+      "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+      "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+  const std::string cipher_hex =
+      "601ec313775789a5b7a7f504bbf3d228f443e3ca4d62b59aca84e990cacaf5c5"
+      "2b0930daa23de94ce87017ba2d84988ddfc9c58db67aada613c2dd08457941a6";
+  EXPECT_EQ(cipher_hex, CryptoUtil::EncryptAes256Ctr(key, iv, plain).GetHex());
+  EXPECT_EQ(plain.GetHex(),
+      CryptoUtil::DecryptAes256Ctr(key, iv, ByteData(cipher_hex)).GetHex());
+
+  std::vector<uint8_t> data = plain.GetBytes();
+  for (size_t split = 0; split <= data.size(); ++split) {
+    Aes256CtrCipher cipher(key, iv);
+    std::vector<uint8_t> output(data.size());
+    cipher.Update(data.data(), split, output.data());
+    cipher.Update(data.data() + split, data.size() - split,
+        output.data() + split);
+    EXPECT_EQ(cipher_hex, ByteData(output).GetHex()) << split;
+  }
+}
+
+TEST(Aes256CtrCipher, UpdateMultiThread) {
+  ByteData key(
+      "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4");
+  ByteData iv("00000000000000ffffffffffffffff00");  // carry over 64bit
+  std::vector<uint8_t> data(1024 * 1024 + 21);
+  for (size_t index = 0; index < data.size(); ++index) {
+    data[index] = static_cast<uint8_t>(index);
+  }
+  std::vector<uint8_t> expect(data.size());
+  Aes256CtrCipher single(key, iv, 1);
+  single.Update(data.data(), data.size(), expect.data());
+
+  Aes256CtrCipher multi(key, iv, 4);
+  std::vector<uint8_t> output = data;
+  multi.Update(output.data(), 5, output.data());
+  multi.Update(output.data() + 5, output.size() - 5, output.data() + 5);
+  EXPECT_TRUE(expect == output);
+
+  Aes256CtrCipher decrypt(key, iv, 4);
+  decrypt.Update(output.data(), output.size(), output.data());
+  EXPECT_TRUE(data == output);
+}
+
 // HmacSha256 tool
 // https://cryptii.com/pipes/hmac
 // HmacSha256------------------------------------------------------------------
@@ -421,6 +541,111 @@ TEST(CryptoUtil, HmacSha256DataEmpty) {
   ASSERT_TRUE(false);
 }
 
+TEST(HmacSha256Context, Calculate) {
+  // RFC 4231 test case 2, 6
+  HmacSha256Context context(ByteData("4a656665"));
+  EXPECT_EQ("5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843",
+      context.Calculate(ByteData(
+          "7768617420646f2079612077616e7420666f72206e6f7468696e673f"))
+          .GetHex());
+  HmacSha256Context long_key_context(std::vector<uint8_t>(131, 0xaa));
+  EXPECT_EQ("60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54",
+      long_key_context.Calculate(ByteData(
+          "54657374205573696e67204c6172676572205468616e20426c6f636b2d53697a"
+          "65204b6579202d2048617368204b6579204669727374")).GetHex());
+
+  // same result as CryptoUtil
+  ByteData key(
+      "616975656F616975656F616975656F616975656F616975656F616975656F6169");
+  HmacSha256Context key_context(key);
+  std::vector<uint8_t> data;
+  for (size_t size = 1; size < 150; ++size) {
+    data.push_back(static_cast<uint8_t>(size));
+    EXPECT_EQ(CryptoUtil::HmacSha256(key, ByteData(data)).GetHex(),
+        key_context.Calculate(ByteData(data)).GetHex()) << size;
+  }
+}
+
+TEST(HmacSha512Context, Calculate) {
+  // RFC 4231 test case 2, 6
+  HmacSha512Context context(ByteData("4a656665"));
+  EXPECT_EQ("164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+      "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737",
+      context.Calculate(ByteData(
+          "7768617420646f2079612077616e7420666f72206e6f7468696e673f"))
+          .GetHex());
+  HmacSha512Context long_key_context(std::vector<uint8_t>(131, 0xaa));
+  EXPECT_EQ("80b24263c7c1a3ebb71493c1dd7be8b49b46d1f41b4aeec1121b013783f8f352"
+      "6b56d037e05f2598bd0fd2215d6a1e5295e64f73f63f0aec8b915a985d786598",
+      long_key_context.Calculate(ByteData(
+          "54657374205573696e67204c6172676572205468616e20426c6f636b2d53697a"
+          "65204b6579202d2048617368204b6579204669727374")).GetHex());
+
+  // same result as CryptoUtil
+  std::vector<uint8_t> key = ByteData(
+      "616975656F616975656F616975656F616975656F616975656F616975656F6169")
+      .GetBytes();
+  HmacSha512Context key_context(key);
+  std::vector<uint8_t> data;
+  for (size_t size = 1; size < 300; ++size) {
+    data.push_back(static_cast<uint8_t>(size));
+    EXPECT_EQ(CryptoUtil::HmacSha512(key, ByteData(data)).GetHex(),
+        key_context.Calculate(ByteData(data)).GetHex()) << size;
+  }
+}
+
+TEST(CryptoUtil, Pbkdf2HmacSha512) {
+  ByteData password("70617373776f7264");  // password
+  ByteData salt("73616c74");  // salt
+  EXPECT_EQ("867f70cf1ade02cff3752599a3a53dc4af34c7a669815ae5d513554e1c8cf252"
+      "c02d470a285a0501bad999bfe943c08f050235d7d68b1da55e63f73b60a57fce",
+      CryptoUtil::Pbkdf2HmacSha512(password, salt, 1, 64).GetHex());
+  EXPECT_EQ("e1d9c16aa681708a45f5c7c4e215ceb66e011a2e9f0040713f18aefdb866d53c"
+      "f76cab2868a39b9f7840edce4fef5a82be67335c77a6068e04112754f27ccf4e",
+      CryptoUtil::Pbkdf2HmacSha512(password, salt, 2, 64).GetHex());
+  EXPECT_EQ("d197b1b33db0143e018b12f3d1d1479e6cdebdcc97c5c0f87f6902e072f457b5"
+      "143f30602641b3d55cd335988cb36b84376060ecd532e039b742a239434af2d5",
+      CryptoUtil::Pbkdf2HmacSha512(password, salt, 4096, 64).GetHex());
+  // multiple output blocks
+  EXPECT_EQ("8c0511f4c6e597c6ac6315d8f0362e225f3c501495ba23b868c005174dc4ee71"
+      "115b59f9e60cd9532fa33e0f75aefe30225c583a186cd82bd4daea9724a3d3b8"
+      "04f75bdd41494fa324cab24bcc680fb3b96a30cf5d21fac3c2875913919f3399"
+      "b1d9ce7e",
+      CryptoUtil::Pbkdf2HmacSha512(
+          ByteData("70617373776f726450415353574f524470617373776f7264"),
+          ByteData("73616c7453414c5473616c7453414c5473616c7453414c5473616c74"
+              "53414c5473616c74"), 4096, 100).GetHex());
+
+  EXPECT_THROW(CryptoUtil::Pbkdf2HmacSha512(password, salt, 0, 64),
+      CfdException);
+  EXPECT_THROW(CryptoUtil::Pbkdf2HmacSha512(password, salt, 1, 0),
+      CfdException);
+}
+
+TEST(CryptoUtil, Pbkdf2HmacSha512Batch) {
+  std::vector<ByteData> passwords;
+  std::vector<ByteData> salts;
+  for (uint8_t index = 0; index < 5; ++index) {
+    passwords.push_back(ByteData(std::vector<uint8_t>(index * 40, index)));
+    salts.push_back(ByteData(std::vector<uint8_t>(index + 8, 0x5a)));
+  }
+  for (uint32_t thread_count : {1, 2, 4}) {
+    std::vector<ByteData> result = CryptoUtil::Pbkdf2HmacSha512Batch(
+        passwords, salts, 100, 80, thread_count);
+    ASSERT_EQ(passwords.size(), result.size());
+    for (size_t index = 0; index < passwords.size(); ++index) {
+      EXPECT_EQ(
+          CryptoUtil::Pbkdf2HmacSha512(
+              passwords[index], salts[index], 100, 80).GetHex(),
+          result[index].GetHex()) << thread_count << "," << index;
+    }
+  }
+
+  salts.pop_back();
+  EXPECT_THROW(CryptoUtil::Pbkdf2HmacSha512Batch(passwords, salts, 1, 64),
+      CfdException);
+}
+
 // HmacSha512 tool
 // https://cryptii.com/pipes/hmac
 // HmacSha512------------------------------------------------------------------
@@ -590,6 +815,77 @@ TEST(CryptoUtil, DecodeBase64DataEmpty) {
   EXPECT_STREQ(byte_data.GetHex().c_str(), "");
 }
 
+TEST(CryptoUtil, DecodeBase64Error) {
+  EXPECT_EQ("", CryptoUtil::DecodeBase64("VGhlIHF1aWNr=").GetHex());
+  EXPECT_EQ("", CryptoUtil::DecodeBase64("VGhl*HF1aWNr").GetHex());
+  EXPECT_EQ("", CryptoUtil::DecodeBase64("VG==aWNr").GetHex());
+  EXPECT_EQ("", CryptoUtil::DecodeBase64("V===").GetHex());
+  EXPECT_EQ("54", CryptoUtil::DecodeBase64("VA==").GetHex());
+}
+
+TEST(Base64Encoder, Update) {
+  std::vector<uint8_t> data(1000);
+  for (size_t index = 0; index < data.size(); ++index) {
+    data[index] = static_cast<uint8_t>(index * 7 + 3);
+  }
+  for (size_t size : {0, 1, 2, 3, 15, 16, 17, 47, 48, 1000}) {
+    std::vector<uint8_t> target(data.begin(), data.begin() + size);
+    std::string expect = CryptoUtil::EncodeBase64(ByteData(target));
+    EXPECT_EQ(target, CryptoUtil::DecodeBase64(expect).GetBytes());
+    // split into small chunks
+    for (size_t chunk : {1, 2, 5, 13, 64}) {
+      Base64Encoder encoder;
+      std::string result;
+      for (size_t index = 0; index < size; index += chunk) {
+        encoder.Update(
+            target.data() + index, std::min(chunk, size - index), &result);
+      }
+      encoder.Final(&result);
+      EXPECT_EQ(expect, result) << size << "," << chunk;
+    }
+  }
+  Base64Encoder encoder;
+  std::string result;
+  encoder.Update(ByteData("5468"), &result);
+  encoder.Final(&result);
+  EXPECT_EQ("VGg=", result);
+}
+
+TEST(Base64Decoder, Update) {
+  std::string base64 =
+      "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIDEzIGxhenkgZG9ncy4=";
+  std::string expect =
+      "54686520717569636b2062726f776e20666f78206a756d7073206f7665722031"
+      "33206c617a7920646f67732e";
+  for (size_t chunk : {1, 3, 4, 7, 16, 100}) {
+    Base64Decoder decoder;
+    std::vector<uint8_t> result;
+    for (size_t index = 0; index < base64.size(); index += chunk) {
+      decoder.Update(base64.substr(index, chunk), &result);
+    }
+    decoder.Final();
+    EXPECT_EQ(expect, ByteData(result).GetHex()) << chunk;
+  }
+
+  // line break
+  Base64Decoder decoder;
+  std::vector<uint8_t> result;
+  decoder.Update("VGhlIHF1aWNrIGJyb3du\r\nIGZveCBqdW1w", &result);
+  decoder.Update("cyBvdmVyIDEzIGxh\nenkgZG9ncy4=\n", &result);
+  decoder.Final();
+  EXPECT_EQ(expect, ByteData(result).GetHex());
+
+  // error
+  result.clear();
+  EXPECT_THROW(decoder.Update("VGhlIHF1aWNr*GJyb3du", &result), CfdException);
+  Base64Decoder decoder2;
+  decoder2.Update("VGhlIHF", &result);
+  EXPECT_THROW(decoder2.Final(), CfdException);
+  Base64Decoder decoder3;
+  decoder3.Update("VGg=", &result);
+  EXPECT_THROW(decoder3.Update("VGhl", &result), CfdException);
+}
+
 // Base58 decode tool
 // https://bc-2.jp/tools/txeditor2.html
 // EncodeBase58----------------------------------------------------------------
@@ -640,6 +936,76 @@ TEST(CryptoUtil, DecodeBase58CheckDataEmpty) {
   ASSERT_TRUE(false);
 }
 
+TEST(CryptoUtil, Base58LeadingZero) {
+  EXPECT_EQ("1", CryptoUtil::EncodeBase58(ByteData("00")));
+  EXPECT_EQ("1112", CryptoUtil::EncodeBase58(ByteData("00000001")));
+  EXPECT_EQ("5R", CryptoUtil::EncodeBase58(ByteData("0100")));
+  EXPECT_EQ("00000001", CryptoUtil::DecodeBase58("1112").GetHex());
+  EXPECT_EQ("0100", CryptoUtil::DecodeBase58("5R").GetHex());
+  EXPECT_EQ(
+      "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH",
+      CryptoUtil::EncodeBase58Check(
+          ByteData("00751e76e8199196d454941c45d1b3a323f1433bd6")));
+  EXPECT_EQ(
+      "00751e76e8199196d454941c45d1b3a323f1433bd6",
+      CryptoUtil::DecodeBase58Check("1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH")
+          .GetHex());
+}
+
+TEST(CryptoUtil, DecodeBase58Error) {
+  // invalid character: 0, O, I, l
+  EXPECT_THROW(CryptoUtil::DecodeBase58("1BgGZ0"), cfd::core::CfdException);
+  EXPECT_THROW(CryptoUtil::DecodeBase58("1BgGZO"), cfd::core::CfdException);
+  EXPECT_THROW(CryptoUtil::DecodeBase58("1BgGZI"), cfd::core::CfdException);
+  EXPECT_THROW(CryptoUtil::DecodeBase58("1BgGZl"), cfd::core::CfdException);
+  // checksum unmatch
+  EXPECT_THROW(
+      CryptoUtil::DecodeBase58Check("1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMJ"),
+      cfd::core::CfdException);
+  EXPECT_THROW(
+      CryptoUtil::DecodeBase58Check("111"), cfd::core::CfdException);
+}
+
+TEST(CryptoUtil, EncodeBase58CheckBatch) {
+  std::vector<ByteData> data_list = {
+      ByteData("00751e76e8199196d454941c45d1b3a323f1433bd6"),
+      ByteData(
+          "0488b21e051431616f00000000e6ba4088246b104837c62bd01fd8ba1cf2931a"
+          "d1a5376c2360a1f112f2cfc63c02acf89ab4e3daa79bceef2ebecee2af92712e"
+          "6bf5e4b0d10c74bbecc27ac13da8"),
+      ByteData(),
+  };
+  std::vector<std::string> result =
+      CryptoUtil::EncodeBase58CheckBatch(data_list);
+  ASSERT_EQ(data_list.size(), result.size());
+  EXPECT_EQ("1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH", result[0]);
+  EXPECT_EQ(
+      "xpub6FZeZ5vwcYiT6r7ZYKJhyUqBxMBvzSmb6SpPQCsSenGPrVjKk5SGW4JJpc7cK"
+      "ERN8w9KnJZcMgJA4B2cHnpGq5TahYrDvZSBY2EMLKPRMTT",
+      result[1]);
+  EXPECT_EQ(CryptoUtil::EncodeBase58Check(ByteData()), result[2]);
+  for (size_t index = 0; index < data_list.size(); ++index) {
+    EXPECT_EQ(
+        data_list[index].GetHex(),
+        CryptoUtil::DecodeBase58Check(result[index]).GetHex());
+  }
+
+  std::string buffer;
+  std::vector<size_t> offsets;
+  CryptoUtil::EncodeBase58CheckBatch(data_list, &buffer, &offsets);
+  ASSERT_EQ(data_list.size() + 1, offsets.size());
+  EXPECT_EQ(0U, offsets[0]);
+  EXPECT_EQ(buffer.size(), offsets.back());
+  for (size_t index = 0; index < data_list.size(); ++index) {
+    EXPECT_EQ(
+        result[index],
+        buffer.substr(offsets[index], offsets[index + 1] - offsets[index]));
+  }
+  EXPECT_THROW(
+      CryptoUtil::EncodeBase58CheckBatch(data_list, nullptr, &offsets),
+      CfdException);
+}
+
 TEST(CryptoUtil, ComputeFastMerkleRootTest0) {
   // test_vectors from 
   // https://github.com/ElementsProject/elements/blob/66c015529e7846f8491bcafd986326bcafc1bfcb/src/test/merkle_tests.cpp#L256
@@ -8,6 +8,8 @@
 using cfd::core::ByteData;
 using cfd::core::ByteData160;
 using cfd::core::ByteData256;
+using cfd::core::ByteSpan;
+using cfd::core::CfdException;
 using cfd::core::Deserializer;
 
 TEST(Deserializer, Normal) {
@@ -54,3 +56,49 @@ TEST(Deserializer, BigEndian) {
   EXPECT_EQ(16, parser.GetReadSize());
   EXPECT_TRUE(parser.HasEof());
 }
+
+TEST(Deserializer, BorrowedBuffer) {
+  ByteData data("0102030405060708090a0b0c0d0e0f10111213141516");
+  std::vector<uint8_t> bytes = data.GetBytes();
+  Deserializer borrowed(bytes.data(), bytes.size());
+
+  EXPECT_EQ(1, borrowed.ReadUint8());
+  ByteSpan span = borrowed.ReadSpan(2);
+  EXPECT_EQ(bytes.data() + 1, span.data());
+  EXPECT_EQ("0203", span.GetHex());
+  borrowed.Skip(1);
+  uint32_t values[2];
+  borrowed.ReadUint32Array(values, 2);
+  EXPECT_EQ(0x08070605U, values[0]);
+  EXPECT_EQ(0x0c0b0a09U, values[1]);
+  EXPECT_EQ(12, borrowed.GetReadSize());
+  uint64_t value64 = 0;
+  borrowed.ReadUint64Array(&value64, 1);
+  EXPECT_EQ(0x14131211100f0e0dULL, value64);
+  EXPECT_THROW(borrowed.ReadSpan(3), CfdException);
+
+  Deserializer copy_parser(borrowed);
+  EXPECT_EQ(20, copy_parser.GetReadSize());
+  EXPECT_EQ("1516", copy_parser.ReadSpan(2).GetHex());
+  EXPECT_TRUE(copy_parser.HasEof());
+  EXPECT_FALSE(borrowed.HasEof());
+}
+
+TEST(Deserializer, VariableSpan) {
+  ByteData data("03020304000306070801ff");
+  ByteSpan data_span(data);
+  Deserializer parser(data_span);
+  ByteSpan span = parser.ReadVariableSpan();
+  EXPECT_EQ("020304", span.GetHex());
+  EXPECT_TRUE(parser.ReadVariableSpan().empty());
+  parser.SkipVariableBuffer();
+  EXPECT_EQ("ff", parser.ReadVariableSpan().GetHex());
+  EXPECT_TRUE(parser.HasEof());
+  EXPECT_THROW(parser.SkipVariableBuffer(), CfdException);
+
+  ByteSpan sub_span = data_span.SubSpan(1, 3);
+  EXPECT_EQ(ByteData("020304"), sub_span.GetData());
+  EXPECT_EQ(3, sub_span.size());
+  EXPECT_EQ(2, sub_span[0]);
+  EXPECT_THROW(data_span.SubSpan(10, 3), CfdException);
+}
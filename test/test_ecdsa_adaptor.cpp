@@ -1,12 +1,17 @@
+#include <vector>
+
 #include "cfdcore/cfdcore_ecdsa_adaptor.h"
+#include "cfdcore/cfdcore_exception.h"
 #include "cfdcore/cfdcore_key.h"
 #include "cfdcore/cfdcore_util.h"
 #include "gtest/gtest.h"
 
 using cfd::core::ByteData;
 using cfd::core::ByteData256;
+using cfd::core::CfdException;
 using cfd::core::CryptoUtil;
 using cfd::core::Privkey;
+using cfd::core::HashUtil;
 using cfd::core::Pubkey;
 
 using cfd::core::AdaptorSignature;
@@ -56,3 +61,55 @@ TEST(AdaptorSignature, Recover) {
 
   EXPECT_EQ(secret.GetHex(), sec.GetHex());
 }
+
+TEST(AdaptorSignature, EncryptBatchAndVerifyBatch) {
+  std::vector<ByteData256> msgs;
+  std::vector<Pubkey> adaptors;
+  for (uint8_t index = 0; index < 40; ++index) {
+    msgs.push_back(HashUtil::Sha256(ByteData(index)));
+    adaptors.push_back(adaptor.CreateTweakAdd(HashUtil::Sha256(msgs.back())));
+  }
+  // the last item is created with an invalid adaptor.
+  std::vector<Pubkey> encrypt_adaptors = adaptors;
+  encrypt_adaptors.back() = Pubkey();
+
+  std::vector<AdaptorSignature> sigs;
+  EXPECT_NO_THROW(sigs = AdaptorSignature::EncryptBatch(
+      msgs, sk, encrypt_adaptors, 4));
+  ASSERT_EQ(msgs.size(), sigs.size());
+  EXPECT_EQ(adaptor_sig_str, AdaptorSignature::EncryptBatch(
+      {msg}, sk, {adaptor})[0].GetData().GetHex());
+  for (size_t index = 0; index < sigs.size() - 1; ++index) {
+    EXPECT_EQ(
+        AdaptorSignature::Encrypt(msgs[index], sk, adaptors[index]).GetData()
+            .GetHex(),
+        sigs[index].GetData().GetHex());
+  }
+  EXPECT_FALSE(sigs.back().IsValid());
+
+  std::vector<uint32_t> invalid_indexes;
+  sigs.pop_back();
+  msgs.pop_back();
+  adaptors.pop_back();
+  EXPECT_TRUE(AdaptorSignature::VerifyBatch(
+      sigs, msgs, sk.GetPubkey(), adaptors, &invalid_indexes, 4));
+  EXPECT_EQ(0U, invalid_indexes.size());
+
+  std::swap(msgs[3], msgs[4]);
+  adaptors[20] = adaptor;
+  EXPECT_FALSE(AdaptorSignature::VerifyBatch(
+      sigs, msgs, sk.GetPubkey(), adaptors, &invalid_indexes, 4));
+  EXPECT_EQ(std::vector<uint32_t>({3, 4, 20}), invalid_indexes);
+  EXPECT_FALSE(AdaptorSignature::VerifyBatch(
+      sigs, msgs, secret.GetPubkey(), adaptors, &invalid_indexes));
+  EXPECT_EQ(sigs.size(), invalid_indexes.size());
+
+  EXPECT_THROW(AdaptorSignature::EncryptBatch(
+      msgs, Privkey(), adaptors), CfdException);
+
+  msgs.pop_back();
+  EXPECT_THROW(AdaptorSignature::VerifyBatch(
+      sigs, msgs, sk.GetPubkey(), adaptors), CfdException);
+  EXPECT_THROW(AdaptorSignature::EncryptBatch(
+      msgs, sk, adaptors), CfdException);
+}
@@ -11,6 +11,8 @@
 using cfd::core::CfdException;
 using cfd::core::ElementsConfidentialAddress;
 using cfd::core::Address;
+using cfd::core::AddressFactory;
+using cfd::core::Bech32Util;
 using cfd::core::ConfidentialKey;
 using cfd::core::ElementsNetType;
 using cfd::core::ElementsAddressType;
@@ -21,6 +23,7 @@ using cfd::core::ByteData256;
 using cfd::core::ByteData;
 using cfd::core::NetType;
 using cfd::core::Script;
+using cfd::core::ScriptUtil;
 using cfd::core::ScriptOperator;
 using cfd::core::ScriptBuilder;
 using cfd::core::HashUtil;
@@ -537,6 +540,50 @@ TEST(ElementsConfidentialAddress, P2wshAddressToConfidential) {
   EXPECT_EQ(ElementsAddressType::kP2wshAddress, confidential_address.GetAddressType());
 }
 
+TEST(ElementsConfidentialAddress, Blech32RoundTrip) {
+  std::string confidential_address =
+      "el1qqw3e3mk4ng3ks43mh54udznuekaadh9lgwef3mwgzrfzakmdwcvqqve2xzutyaf7vjcap67f28q90uxec2ve95g3rpu5crapcmfr2l9xl5jzazvcpysz";
+  uint8_t witness_script[Bech32Util::kMaxWitnessScriptSize];
+  size_t written = 0;
+  uint8_t confidential_key[Pubkey::kCompressedPubkeySize];
+  EXPECT_TRUE(Bech32Util::DecodeBlindedSegwitAddress("el",
+      confidential_address, witness_script, sizeof(witness_script), &written,
+      confidential_key));
+  ByteData script(witness_script, static_cast<uint32_t>(written));
+  ByteData key(confidential_key, sizeof(confidential_key));
+  EXPECT_EQ("ert1qxv4rpw9jw5lxfvwsa0y4rszh7rvu9xvj6yg3s72vp7sud5340jnquagp6g",
+      Bech32Util::EncodeSegwitAddress("ert", script));
+  EXPECT_EQ(confidential_address,
+      Bech32Util::EncodeBlindedSegwitAddress("el", script, Pubkey(key)));
+
+  // invalid hrp
+  EXPECT_FALSE(Bech32Util::DecodeBlindedSegwitAddress("lq",
+      confidential_address, witness_script, sizeof(witness_script), &written,
+      confidential_key));
+  // invalid checksum
+  confidential_address.back() = 'q';
+  EXPECT_FALSE(Bech32Util::DecodeBlindedSegwitAddress("el",
+      confidential_address, witness_script, sizeof(witness_script), &written,
+      confidential_key));
+
+  // witness v1 with a 40-byte program (130 5bit symbols)
+  ByteData program40(
+      "0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20"
+      "2122232425262728");
+  ByteData script40 = ByteData("5128").Concat(program40);
+  std::string address40 =
+      "el1pqw3e3mk4ng3ks43mh54udznuekaadh9lgwef3mwgzrfzakmdwcvqqqgzqvzq2ps8pqys5zcvp58q7yq3zgf3g9gkzuvpjxsmrsw3u8eqyy3zxfp9ycnjsjmra6t6rxh89";
+  EXPECT_EQ(address40,
+      Bech32Util::EncodeBlindedSegwitAddress("el", script40, Pubkey(key)));
+  EXPECT_TRUE(Bech32Util::DecodeBlindedSegwitAddress("el",
+      address40, witness_script, sizeof(witness_script), &written,
+      confidential_key));
+  EXPECT_EQ(script40.GetHex(),
+      ByteData(witness_script, static_cast<uint32_t>(written)).GetHex());
+  EXPECT_EQ(key.GetHex(),
+      ByteData(confidential_key, sizeof(confidential_key)).GetHex());
+}
+
 TEST(ElementsConfidentialAddress, GetBlindingKey) {
   const Privkey master_blinding_key(
       "881a1ab07e99ab0626b4d93b3dddfd16cbc04342ee71aab4da7093e7b853fd80");
@@ -564,6 +611,89 @@ TEST(ElementsConfidentialAddress, GetBlindingKey) {
       confidential_address.GetAddress().c_str());
 }
 
+TEST(ElementsConfidentialAddress, GetBlindingKeys) {
+  const Privkey master_blinding_key(
+      "881a1ab07e99ab0626b4d93b3dddfd16cbc04342ee71aab4da7093e7b853fd80");
+  std::vector<Script> locking_scripts;
+  for (uint32_t index = 0; index < 600; ++index) {
+    ByteData256 hash = HashUtil::Sha256(ByteData(std::vector<uint8_t>(
+        reinterpret_cast<uint8_t*>(&index),
+        reinterpret_cast<uint8_t*>(&index) + sizeof(index))));
+    locking_scripts.push_back(ScriptUtil::CreateP2wshLockingScript(hash));
+  }
+  locking_scripts.push_back(Address(
+      "ert1q0zln07l8vgm5qf4jhzz00668lfs7xssdlxlysh",
+      GetElementsAddressFormatList()).GetLockingScript());
+
+  for (uint32_t thread_count : {1, 4, 0}) {
+    std::vector<Privkey> keys = ElementsConfidentialAddress::GetBlindingKeys(
+        master_blinding_key, locking_scripts, thread_count);
+    ASSERT_EQ(locking_scripts.size(), keys.size());
+    for (size_t index = 0; index < keys.size(); index += 37) {
+      EXPECT_EQ(ElementsConfidentialAddress::GetBlindingKey(
+          master_blinding_key, locking_scripts[index]).GetHex(),
+          keys[index].GetHex());
+    }
+    EXPECT_EQ(
+        "95af1be4f929e182442c9f3aa55a3cacde69d1182677f3afd618cdfb4a588742",
+        keys.back().GetHex());
+  }
+  EXPECT_TRUE(ElementsConfidentialAddress::GetBlindingKeys(
+      master_blinding_key, {}).empty());
+}
+
+TEST(ElementsConfidentialAddress, CreateBatch) {
+  const std::vector<Pubkey> pubkey_list = {
+      Pubkey(
+          "02bedf98a38247c1718fdff7e07561b4dc15f10323ebb0accab581778e72c2e995"),
+      Pubkey(
+          "02d21c625759280111907a06df050cccbc875b11a50bdafa71dae5d1e8695ba82e"),
+  };
+  const std::vector<ConfidentialKey> key_list = {
+      ConfidentialKey(
+          "02c63c841eae06932626118e77d4002baa14592aeabe5439cbe22e0654319d8e8c"),
+      ConfidentialKey(
+          "02d21c625759280111907a06df050cccbc875b11a50bdafa71dae5d1e8695ba82e"),
+  };
+  std::vector<Pubkey> pubkeys;
+  std::vector<ConfidentialKey> confidential_keys;
+  for (size_t index = 0; index < 301; ++index) {
+    pubkeys.push_back(pubkey_list[index % pubkey_list.size()]);
+    confidential_keys.push_back(key_list[(index / 2) % key_list.size()]);
+  }
+  std::vector<Address> addresses = AddressFactory::CreateBatch(
+      ElementsNetType::kElementsRegtest, ElementsAddressType::kP2wpkhAddress,
+      pubkeys, GetElementsAddressFormatList());
+
+  for (uint32_t thread_count : {1, 4, 0}) {
+    std::vector<ElementsConfidentialAddress> result =
+        ElementsConfidentialAddress::CreateBatch(
+            addresses, confidential_keys, thread_count);
+    ASSERT_EQ(addresses.size(), result.size());
+    EXPECT_EQ(
+        "el1qqtrrepq74crfxf3xzx8804qq9w4pgkf2a2l9gwwtughqv4p3nk8gepg0y9q39q"
+        "hjgmnyfwfz5z5c5ek0llwtc3jfqw5zvqx5q",
+        result[0].GetAddress());
+    for (size_t index = 0; index < result.size(); index += 7) {
+      ElementsConfidentialAddress expect(
+          addresses[index], confidential_keys[index]);
+      EXPECT_EQ(expect.GetAddress(), result[index].GetAddress());
+      EXPECT_EQ(
+          expect.GetUnblindedAddress().GetAddress(),
+          result[index].GetUnblindedAddress().GetAddress());
+      EXPECT_EQ(
+          confidential_keys[index].GetHex(),
+          result[index].GetConfidentialKey().GetHex());
+      EXPECT_EQ(ElementsAddressType::kP2wpkhAddress,
+          result[index].GetAddressType());
+    }
+  }
+
+  EXPECT_THROW(ElementsConfidentialAddress::CreateBatch(
+      addresses, key_list), CfdException);
+  EXPECT_TRUE(ElementsConfidentialAddress::CreateBatch({}, {}).empty());
+}
+
 TEST(ElementsConfidentialAddress, CustomElementsAddressFormatList) {
   std::string custom_json = "[{"
       "\"nettype\":\"elementsregtest\",\"p2pkh\":\"72\","
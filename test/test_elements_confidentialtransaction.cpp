@@ -37,6 +37,7 @@ using cfd::core::ScriptOperator;
 using cfd::core::ScriptBuilder;
 using cfd::core::ScriptUtil;
 using cfd::core::ScriptWitness;
+using cfd::core::Serializer;
 using cfd::core::ConfidentialValue;
 using cfd::core::ConfidentialAssetId;
 using cfd::core::ConfidentialNonce;
@@ -815,6 +816,51 @@ TEST(ConfidentialTransaction, SetTxOutCommitmentTest) {
                range_proof.GetHex().c_str());
 }
 
+TEST(ConfidentialTransaction, WriteByteData) {
+  ConfidentialTransaction tx(exp_tx_hex);
+  std::vector<std::string> tx_list;
+  tx_list.push_back(tx.GetHex());
+  tx.SetIssuance(0, exp_blinding_nonce, exp_asset_entropy,
+      exp_issuance_amount, exp_inflation_keys,
+      exp_issuance_amount_rangeproof, exp_inflation_keys_rangeproof);
+  for (const auto& item : GetExpectWitnessStack().GetWitness()) {
+    tx.AddScriptWitnessStack(0, item);
+  }
+  tx_list.push_back(tx.GetHex());
+  for (const auto& item : GetExpectPeginWitnessStack().GetWitness()) {
+    tx.AddPeginWitnessStack(0, item);
+  }
+  ConfidentialTxOutReference txout = tx.GetTxOut(0);
+  tx.SetTxOutCommitment(0, txout.GetAsset(), txout.GetConfidentialValue(),
+      ConfidentialNonce(
+          "991a4b6bd5571b5f08ab79c314dc6483f9b952af2f5ef206cd6f8e68eb1186f3"),
+      ByteData("1234567890"),
+      ByteData("1234567890123456789012345678901234567890"));
+  tx_list.push_back(tx.GetHex());
+
+  for (const auto& tx_hex : tx_list) {
+    ConfidentialTransaction target(tx_hex);
+    Serializer counter = Serializer::CreateSizeCounter();
+    target.WriteByteData(true, &counter);
+    EXPECT_EQ(target.GetTotalSize(), counter.GetWriteSize());
+
+    std::vector<uint8_t> buffer(counter.GetWriteSize());
+    Serializer builder(buffer.data(), static_cast<uint32_t>(buffer.size()));
+    target.WriteByteData(true, &builder);
+    EXPECT_EQ(tx_hex, ByteData(buffer).GetHex());
+
+    // libwally reads the data without witness back to the same bytes.
+    Serializer base_builder;
+    target.WriteByteData(false, &base_builder);
+    ByteData base_data = base_builder.Output();
+    EXPECT_EQ(base_data.GetHex(), ConfidentialTransaction(base_data).GetHex());
+    EXPECT_EQ(
+        Txid(HashUtil::Sha256D(base_data)).GetHex(),
+        target.GetTxid().GetHex());
+  }
+  EXPECT_THROW(tx.WriteByteData(true, nullptr), CfdException);
+}
+
 TEST(ConfidentialTransaction, BlindTxOutTest) {
   std::string tx_hex = "020000000001e6162f9bbac022e67327e717a3885b316a54e50c34ba266b58f1999854c596810100000000ffffffff030125b251070e29ca19043cf33ccd7324e2ddab03ecc4ae0b5e77c4fc0e5cf6c95a0100000000000138800017a914a3949e9a8b0b813db67c8fc5ad14194a297979cd870125b251070e29ca19043cf33ccd7324e2ddab03ecc4ae0b5e77c4fc0e5cf6c95a0100000000000027100017a9145227b0820cf08f489873888672a5d97face863b2870125b251070e29ca19043cf33ccd7324e2ddab03ecc4ae0b5e77c4fc0e5cf6c95a010000000000002710000000000000";
   ConfidentialTransaction tx(tx_hex);
@@ -207,6 +207,26 @@ TEST(HDWallet, ConvertTest) {
   }
 }
 
+TEST(HDWallet, ConvertMnemonicToSeedsTest) {
+  std::vector<std::vector<std::string>> mnemonics;
+  std::vector<std::string> passphrases;
+  for (const auto& test_vector : bip39_test_vectors) {
+    mnemonics.push_back(test_vector.mnemonic);
+    passphrases.push_back(test_passphrase);
+  }
+  std::vector<ByteData> seeds;
+  EXPECT_NO_THROW(seeds = HDWallet::ConvertMnemonicToSeeds(
+      mnemonics, passphrases, false, 2));
+  ASSERT_EQ(bip39_test_vectors.size(), seeds.size());
+  for (size_t index = 0; index < seeds.size(); ++index) {
+    EXPECT_EQ(bip39_test_vectors[index].seed.GetHex(), seeds[index].GetHex());
+  }
+
+  passphrases.pop_back();
+  EXPECT_THROW(HDWallet::ConvertMnemonicToSeeds(mnemonics, passphrases),
+      CfdException);
+}
+
 const std::vector<std::string> empty_mnemonic = {};
 const std::vector<std::string> invalid_words_mnemonic = {"aa","aa","aa","aa","aa","aa","aa","aa","aa","aa","aa","abort"};
 
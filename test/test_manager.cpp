@@ -10,6 +10,7 @@ using cfd::core::CfdCoreHandle;
 using cfd::core::Initialize;
 using cfd::core::Finalize;
 using cfd::core::GetSupportedFunction;
+using cfd::core::GetSecp256k1Context;
 using cfd::core::CfdCoreManager;
 using cfd::core::LibraryFunction;
 
@@ -49,6 +50,12 @@ TEST(cfdcore_manager, Finalize) {
   EXPECT_NO_THROW((Finalize(handle)));
 }
 
+TEST(cfdcore_manager, GetSecp256k1Context) {
+  auto context = GetSecp256k1Context();
+  EXPECT_NE(nullptr, context);
+  EXPECT_EQ(context, GetSecp256k1Context());
+}
+
 TEST(cfdcore_manager, GetSupportedFunction) {
   EXPECT_EQ(GetSupportedFunction(), GetSupportedFunctionExpect());
 }
@@ -176,6 +176,26 @@ TEST(Privkey, FromWif_wif_error) {
   ASSERT_TRUE(false);
 }
 
+TEST(Privkey, FromWif_compress_unmatch) {
+  // compressed WIF
+  EXPECT_THROW(Privkey::FromWif(
+      "KxqjPLtQqydD8d6eUrpJ7Q1266k8Mw8f5eoyEztY3Kc5z4f2RQTG",
+      NetType::kMainnet, false), CfdException);
+  // uncompressed WIF
+  EXPECT_THROW(Privkey::FromWif(
+      "5JBb5A38fjjeBnngkvRmCsXN6EY4w8jWvckik3hDvYQMcddGY23",
+      NetType::kMainnet, true), CfdException);
+
+  Privkey privkey = Privkey::FromWif(
+      "KxqjPLtQqydD8d6eUrpJ7Q1266k8Mw8f5eoyEztY3Kc5z4f2RQTG",
+      NetType::kCustomChain);
+  EXPECT_EQ("KxqjPLtQqydD8d6eUrpJ7Q1266k8Mw8f5eoyEztY3Kc5z4f2RQTG",
+      privkey.GetWif());
+  EXPECT_EQ(
+      "031777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb",
+      privkey.GetPubkey().GetHex());
+}
+
 TEST(Privkey, GeneratePubkey_compressed) {
   std::string wif = "cQNmd1D8MqzijUuXHb2yS5oRSm2F3TSTTMvcHC3V7CiKxArpg1bg";
   Privkey privkey = Privkey::FromWif(wif, NetType::kRegtest, true);
@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <sstream>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -10,6 +11,7 @@
 #include "cfdcore/cfdcore_address.h"
 #include "cfdcore/cfdcore_transaction.h"
 
+using cfd::core::CfdError;
 using cfd::core::CfdException;
 using cfd::core::Address;
 using cfd::core::Amount;
@@ -400,6 +402,32 @@ static const std::string g_psbt_seed1 = "8bc106907003ea0b55f3ed4ce2fcf9a198d8c43
 static const std::string g_psbt_seed2 = "d3e3539eafb6af1f0ae374ecffd33bed394f5eb2e39f8957be63c258ac32ca97";
 // 44'/0'/0': tprv8fbPrDdF7Cdde4fLncessNymvfuvREAzhoMmfs3XqCuLcNVB9didfgXgb5V1NrxkqF7ZKibuyib4n6bujk1L5NfgVYnZZCwuyDdT21JAquv
 
+TEST(Psbt, Base64Stream) {
+  std::string base64 = "cHNidP8BAFwCAAAAAiZ//Xbq5rbBP/uGzquqJNQkhVICM8LDgF4K12RwlXjAAQAAAAD/////fSVGKkL/LLG6VAHliTJZ2zykvPXParlxXTUWPTHJ7MAAAAAAAP////8AAAAAAAAAAA==";
+  std::istringstream stream(base64 + "\n");
+  Psbt psbt(stream);
+  EXPECT_EQ(2, psbt.GetTxInCount());
+  EXPECT_EQ(base64, psbt.GetBase64());
+
+  // invalid base64 is the same error on both constructors.
+  std::string invalid_base64 = "cHNidP8BAFwCAAAAAiZ//Xbq5rbBP/uGzquq*";
+  std::istringstream invalid_stream(invalid_base64);
+  try {
+    Psbt psbt2(invalid_stream);
+    ADD_FAILURE();
+  } catch (const CfdException &except) {
+    EXPECT_EQ(CfdError::kCfdIllegalArgumentError, except.GetErrorCode());
+    EXPECT_STREQ("psbt base64 decode error.", except.what());
+  }
+  try {
+    Psbt psbt3(invalid_base64);
+    ADD_FAILURE();
+  } catch (const CfdException &except) {
+    EXPECT_EQ(CfdError::kCfdIllegalArgumentError, except.GetErrorCode());
+    EXPECT_STREQ("psbt base64 decode error.", except.what());
+  }
+}
+
 TEST(Psbt, SetTxInOnly) {
   Psbt psbt;
   EXPECT_EQ(0, psbt.GetTxInCount());
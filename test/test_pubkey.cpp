@@ -1,6 +1,10 @@
 #include "gtest/gtest.h"
 #include <iostream>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "cfdcore/cfdcore_key.h"
 #include "cfdcore/cfdcore_exception.h"
@@ -94,6 +98,31 @@ TEST(Pubkey, ConstructorTest) {
   }
 }
 
+TEST(Pubkey, MoveTest) {
+  static_assert(std::is_nothrow_move_constructible<Pubkey>::value,
+      "Pubkey move constructor must be noexcept.");
+  static_assert(std::is_nothrow_move_assignable<Pubkey>::value,
+      "Pubkey move assignment must be noexcept.");
+  const std::string hex =
+      "031777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb";
+  Pubkey pubkey(hex);
+  // fill the point cache
+  EXPECT_TRUE(pubkey.IsParity());
+  Pubkey moved_pubkey(std::move(pubkey));
+  EXPECT_EQ(hex, moved_pubkey.GetHex());
+  EXPECT_TRUE(moved_pubkey.IsValid());
+
+  Pubkey assigned_pubkey;
+  assigned_pubkey = std::move(moved_pubkey);
+  EXPECT_EQ(hex, assigned_pubkey.GetHex());
+  EXPECT_EQ(hex,
+      assigned_pubkey.CreateTweakAdd(ByteData256()).GetHex());
+
+  std::vector<Pubkey> pubkeys(8, assigned_pubkey);
+  pubkeys.reserve(64);
+  for (const auto& item : pubkeys) EXPECT_EQ(hex, item.GetHex());
+}
+
 void pubkeyExceptionTest(std::string hex) {
   Pubkey pubkey;
   EXPECT_THROW((pubkey = Pubkey(hex)), CfdException);
@@ -260,6 +289,60 @@ TEST(Pubkey, TweakTest) {
   EXPECT_EQ(exp_pk_t23, pk_t23.GetHex());
 }
 
+TEST(Pubkey, TweakChainTest) {
+  ByteData256 tweak1("bd7d5d628f259c5f141519a932fb97e57e03852fd6fc5c42f41eee3df2a09e3a");
+  ByteData256 tweak2("dc66de3b954578f60b68ab5d241c98b24c0b91038d1b5b158a63fbafa7cc9073");
+  Pubkey pk_a("034d18084bb47027f47d428b2ed67e1ccace5520fdc36f308e272394e288d53b6d");
+
+  // chained result equals the result re-parsed from the serialized bytes.
+  Pubkey chained = pk_a.CreateTweakAdd(tweak1).Uncompress().Compress()
+      .CreateTweakMul(tweak2).CreateNegate();
+  Pubkey step = Pubkey(pk_a.CreateTweakAdd(tweak1).GetHex());
+  step = Pubkey(step.Uncompress().GetHex());
+  step = Pubkey(step.Compress().GetHex());
+  step = Pubkey(step.CreateTweakMul(tweak2).GetHex());
+  step = Pubkey(step.CreateNegate().GetHex());
+  EXPECT_EQ(step.GetHex(), chained.GetHex());
+
+  Pubkey copied = chained;
+  EXPECT_TRUE(copied.Equals(chained));
+  EXPECT_EQ(chained.CreateTweakAdd(tweak1).GetHex(),
+      copied.CreateTweakAdd(tweak1).GetHex());
+
+  // not on the curve
+  Pubkey invalid(
+      "020000000000000000000000000000000000000000000000000000000000000005");
+  EXPECT_THROW(invalid.CreateTweakAdd(tweak1), CfdException);
+  EXPECT_FALSE(invalid.VerifyEcSignature(tweak1, ByteData(
+      "0e68b55347fe37338beb3c28920267c5915a0c474d1dcafc65b087b9b3819cae6ae5e8fb"
+      "12d669a63127abb4724070f8bd232a9efe3704e6544296a843a64f2c")));
+}
+
+TEST(Pubkey, TweakMultiThreadTest) {
+  ByteData256 tweak("bd7d5d628f259c5f141519a932fb97e57e03852fd6fc5c42f41eee3df2a09e3a");
+  const std::string pubkey_hex =
+      "034d18084bb47027f47d428b2ed67e1ccace5520fdc36f308e272394e288d53b6d";
+  const std::string expect_hex =
+      Pubkey(pubkey_hex).CreateTweakAdd(tweak).GetHex();
+
+  // the first parse is raced by all threads.
+  const Pubkey pubkey(pubkey_hex);
+  std::vector<std::string> results(4);
+  std::vector<std::thread> threads;
+  for (size_t idx = 0; idx < results.size(); ++idx) {
+    threads.emplace_back([&pubkey, &tweak, &results, idx]() {
+      for (int count = 0; count < 100; ++count) {
+        Pubkey copied = pubkey;
+        results[idx] = copied.CreateTweakAdd(tweak).GetHex();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (const auto& result : results) {
+    EXPECT_EQ(expect_hex, result);
+  }
+}
+
 TEST(Pubkey, CombineTest) {
   // https://planethouki.wordpress.com/2018/03/15/pubkey-add-ecdsa/
   Privkey sk_a("1d52f68124c59c3125d5c2e043cabf01cef46fafaf45be3132fc1f52ff0ec434");
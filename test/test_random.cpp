@@ -0,0 +1,52 @@
+#include "gtest/gtest.h"
+#include <vector>
+
+#include "cfdcore/cfdcore_bytedata.h"
+#include "cfdcore/cfdcore_util.h"
+#include "cfdcore_random.h"
+
+using cfd::core::ByteData;
+using cfd::core::GetSystemRandomBytes;
+using cfd::core::RandomNumberUtil;
+using cfd::core::ResetRandomSeed;
+using cfd::core::SetRandomDeterministicSeed;
+
+TEST(Random, GetSystemRandomBytes) {
+  std::vector<uint8_t> random1(32);
+  std::vector<uint8_t> random2(32);
+  GetSystemRandomBytes(random1.data(), random1.size());
+  GetSystemRandomBytes(random2.data(), random2.size());
+  EXPECT_NE(random1, random2);
+  EXPECT_NE(std::vector<uint8_t>(32), random1);
+}
+
+TEST(Random, SetRandomDeterministicSeed) {
+  const uint8_t seed[32] = {};
+  // RFC 8439 A.1 test vector #1 (the first 32 bytes become the next key)
+  SetRandomDeterministicSeed(seed);
+  EXPECT_EQ(
+      "da41597c5157488d7724e03fb8d84a376a43b8f41518a11cc387b669b2ee6586",
+      ByteData(RandomNumberUtil::GetRandomBytes(32)).GetHex());
+
+  // the output does not depend on the request size.
+  std::vector<uint8_t> bytes;
+  for (int size = 1; bytes.size() < 10000; ++size) {
+    auto random = RandomNumberUtil::GetRandomBytes(size);
+    bytes.insert(bytes.end(), random.begin(), random.end());
+  }
+  SetRandomDeterministicSeed(seed);
+  RandomNumberUtil::GetRandomBytes(32);
+  EXPECT_EQ(
+      ByteData(bytes).GetHex(),
+      ByteData(RandomNumberUtil::GetRandomBytes(static_cast<int>(
+          bytes.size()))).GetHex());
+  SetRandomDeterministicSeed(seed);
+  auto indexes = RandomNumberUtil::GetRandomIndexes(10);
+  SetRandomDeterministicSeed(seed);
+  EXPECT_EQ(indexes, RandomNumberUtil::GetRandomIndexes(10));
+
+  ResetRandomSeed();
+  EXPECT_STRNE(
+      "da41597c5157488d7724e03fb8d84a376a43b8f41518a11cc387b669b2ee6586",
+      ByteData(RandomNumberUtil::GetRandomBytes(32)).GetHex().c_str());
+}
@@ -1,4 +1,7 @@
 #include "gtest/gtest.h"
+#include <set>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -88,3 +91,25 @@ TEST(RandomNumberUtil, GetRandomBool) {
   std::vector<bool> cashe;
   EXPECT_NO_THROW(RandomNumberUtil::GetRandomBool(&cashe));
 }
+
+TEST(RandomNumberUtil, GetRandomBytesMultiThread) {
+  constexpr size_t kThreadCount = 4;
+  constexpr size_t kLoopCount = 500;
+  std::vector<std::vector<std::string>> results(kThreadCount);
+  std::vector<std::thread> threads;
+  for (size_t index = 0; index < kThreadCount; ++index) {
+    threads.emplace_back([&results, index]() {
+      for (size_t count = 0; count < kLoopCount; ++count) {
+        results[index].push_back(
+            ByteData(RandomNumberUtil::GetRandomBytes(32)).GetHex());
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  std::set<std::string> values;
+  for (const auto &result : results) {
+    values.insert(result.begin(), result.end());
+  }
+  EXPECT_EQ(kThreadCount * kLoopCount, values.size());
+}
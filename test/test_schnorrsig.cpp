@@ -1,4 +1,6 @@
+#include <type_traits>
 #include <vector>
+#include "cfdcore/cfdcore_exception.h"
 #include "cfdcore/cfdcore_key.h"
 #include "cfdcore/cfdcore_schnorrsig.h"
 #include "cfdcore/cfdcore_util.h"
@@ -7,6 +9,7 @@
 using cfd::core::ByteData;
 using cfd::core::ByteData256;
 using cfd::core::CryptoUtil;
+using cfd::core::HashUtil;
 using cfd::core::Privkey;
 using cfd::core::Pubkey;
 using cfd::core::SchnorrPubkey;
@@ -38,6 +41,21 @@ TEST(SchnorrSig, Sign) {
   EXPECT_EQ(signature.GetData().GetHex(), sig.GetData().GetHex());
 }
 
+TEST(SchnorrSig, MoveTest) {
+  static_assert(std::is_nothrow_move_constructible<SchnorrSignature>::value,
+      "SchnorrSignature move constructor must be noexcept.");
+  static_assert(std::is_nothrow_move_assignable<SchnorrSignature>::value,
+      "SchnorrSignature move assignment must be noexcept.");
+  SchnorrSignature base_sig(signature);
+  SchnorrSignature moved_sig(std::move(base_sig));
+  EXPECT_EQ(signature.GetHex(), moved_sig.GetHex());
+
+  SchnorrSignature assigned_sig;
+  assigned_sig = std::move(moved_sig);
+  EXPECT_EQ(signature.GetHex(), assigned_sig.GetHex());
+  EXPECT_TRUE(SchnorrUtil::Verify(assigned_sig, msg, pubkey));
+}
+
 TEST(SchnorrSig, SignWithNonce) {
   std::string expected_sig =
       "5da618c1936ec728e5ccff29207f1680dcf4146370bdcfab0039951b91e3637a958e91d"
@@ -279,3 +297,103 @@ TEST(SchnorrUtil, ComputeSigPointBatch) {
 
   ASSERT_EQ(expected_sig_point.GetHex(), actual_sig_point.GetHex());
 }
+
+TEST(SchnorrUtil, ComputeSigPointList) {
+  // 3 digits (base 2) of a numeric outcome.
+  std::vector<ByteData256> msgs;
+  std::vector<SchnorrPubkey> nonces = {
+      SchnorrPubkey(
+          "4d18084bb47027f47d428b2ed67e1ccace5520fdc36f308e272394e288d53b6d"),
+      SchnorrPubkey(
+          "f14d7e54ff58c5d019ce9986be4a0e8b7d643bd08ef2cdf1099e1a457865b547"),
+      SchnorrPubkey(
+          "dc82121e4ff8d23745f3859e8939ecb0a38af63e6ddea2fff97a7fd61a1d2d54")};
+  std::vector<SchnorrPubkey> digit_nonces;
+  for (const auto& nonce : nonces) {
+    for (uint8_t value = 0; value < 2; ++value) {
+      msgs.push_back(HashUtil::Sha256(ByteData(value)));
+      digit_nonces.push_back(nonce);
+    }
+  }
+
+  auto sig_points =
+      SchnorrUtil::ComputeSigPointList(msgs, digit_nonces, pubkey, 2);
+  ASSERT_EQ(msgs.size(), sig_points.size());
+  for (size_t i = 0; i < msgs.size(); i++) {
+    EXPECT_EQ(
+        SchnorrUtil::ComputeSigPoint(msgs[i], digit_nonces[i], pubkey).GetHex(),
+        sig_points[i].GetHex());
+  }
+
+  std::vector<std::vector<Pubkey>> table = {
+      {sig_points[0], sig_points[1]},
+      {sig_points[2], sig_points[3]},
+      {sig_points[4], sig_points[5]},
+  };
+  std::vector<std::vector<uint32_t>> outcomes;
+  for (uint32_t value = 0; value < 8; ++value) {
+    outcomes.push_back({(value >> 2) & 1, (value >> 1) & 1, value & 1});
+  }
+  outcomes.push_back({1});
+  outcomes.push_back({0, 1});
+  auto outcome_points = SchnorrUtil::CombineSigPointList(table, outcomes, 2);
+  ASSERT_EQ(outcomes.size(), outcome_points.size());
+  for (size_t index = 0; index < outcomes.size(); ++index) {
+    std::vector<ByteData256> outcome_msgs;
+    std::vector<SchnorrPubkey> outcome_nonces;
+    for (size_t digit = 0; digit < outcomes[index].size(); ++digit) {
+      outcome_msgs.push_back(msgs[digit * 2 + outcomes[index][digit]]);
+      outcome_nonces.push_back(nonces[digit]);
+    }
+    EXPECT_EQ(
+        SchnorrUtil::ComputeSigPointBatch(
+            outcome_msgs, outcome_nonces, pubkey).GetHex(),
+        outcome_points[index].GetHex());
+  }
+
+  EXPECT_THROW(
+      SchnorrUtil::CombineSigPointList(table, {{0, 2}}),
+      cfd::core::CfdException);
+  EXPECT_THROW(
+      SchnorrUtil::CombineSigPointList(table, {{0, 1, 0, 1}}),
+      cfd::core::CfdException);
+  EXPECT_THROW(
+      SchnorrUtil::ComputeSigPointList(msgs, nonces, pubkey),
+      cfd::core::CfdException);
+}
+
+TEST(SchnorrUtil, VerifyBatch) {
+  const SchnorrPubkey other_pubkey(
+      "1e0ba0cd7e2cf8b33bc46d12cdc7e0b1a06ef8b1c7e1ac83b8f6a1a43fd14b1f");
+  std::vector<SchnorrSignature> signatures;
+  std::vector<ByteData256> msgs;
+  std::vector<SchnorrPubkey> pubkeys;
+  for (uint32_t index = 0; index < 40; ++index) {
+    ByteData256 message = HashUtil::Sha256(msg.Concat(ByteData(static_cast<uint8_t>(index))));
+    signatures.push_back(SchnorrUtil::Sign(message, sk, aux_rand));
+    msgs.push_back(message);
+    pubkeys.push_back(pubkey);
+  }
+
+  std::vector<uint32_t> invalid_indexes;
+  EXPECT_TRUE(SchnorrUtil::VerifyBatch(
+      signatures, msgs, pubkeys, &invalid_indexes, 4));
+  EXPECT_TRUE(invalid_indexes.empty());
+  EXPECT_TRUE(SchnorrUtil::VerifyBatch(signatures, msgs, pubkeys));
+
+  // wrong message, wrong pubkey, broken signature
+  msgs[3] = msg;
+  pubkeys[17] = other_pubkey;
+  signatures[39] = SchnorrSignature(signature.GetData());
+  EXPECT_FALSE(SchnorrUtil::VerifyBatch(
+      signatures, msgs, pubkeys, &invalid_indexes, 4));
+  EXPECT_EQ(std::vector<uint32_t>({3, 17, 39}), invalid_indexes);
+  EXPECT_FALSE(SchnorrUtil::VerifyBatch(
+      signatures, msgs, pubkeys, &invalid_indexes, 1));
+  EXPECT_EQ(std::vector<uint32_t>({3, 17, 39}), invalid_indexes);
+
+  EXPECT_TRUE(SchnorrUtil::VerifyBatch({}, {}, {}));
+  EXPECT_THROW(
+      SchnorrUtil::VerifyBatch(signatures, msgs, {pubkey}),
+      cfd::core::CfdException);
+}
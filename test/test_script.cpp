@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <thread>
 #include <vector>
 
 #include "cfdcore/cfdcore_common.h"
@@ -13,6 +14,7 @@
 
 using cfd::core::Script;
 using cfd::core::ScriptBuilder;
+using cfd::core::ScriptPool;
 using cfd::core::ScriptOperator;
 using cfd::core::ScriptHash;
 using cfd::core::ScriptElement;
@@ -21,6 +23,8 @@ using cfd::core::Privkey;
 using cfd::core::Pubkey;
 using cfd::core::NetType;
 using cfd::core::WitnessVersion;
+using cfd::core::ByteSpan;
+using cfd::core::StandardScriptType;
 
 TEST(Script, Script) {
   size_t size = 0;
@@ -309,6 +313,33 @@ TEST(Script, GetElementList) {
   EXPECT_EQ(list.size(), size);
 }
 
+TEST(Script, GetElementListLazy) {
+  const std::string script_hex =
+      "03632b1e045352b260425443506f6f6cfabe6d6d4b081c2a3c7cb234c159b8e198294dfa79c04b54803e0e54c4a37d239445eb42020000007296cd100100000e8338000000000000";
+  Script obj(ByteData(script_hex), true);  // ignore size check
+  // copy before decoding keeps the size check option.
+  Script copy_obj(obj);
+  EXPECT_FALSE(copy_obj.IsEmpty());
+  EXPECT_EQ(script_hex, copy_obj.GetHex());
+
+  std::vector<size_t> sizes(4);
+  std::vector<std::thread> threads;
+  for (size_t index = 0; index < sizes.size(); ++index) {
+    threads.emplace_back([&copy_obj, &sizes, index]() {
+      sizes[index] = copy_obj.GetElementList().size();
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (size_t size : sizes) {
+    EXPECT_EQ(3, size);
+  }
+
+  Script assign_obj;
+  assign_obj = copy_obj;
+  EXPECT_EQ(copy_obj.ToString(), assign_obj.ToString());
+  EXPECT_TRUE(Script(ByteData(script_hex), true).Equals(assign_obj));
+}
+
 TEST(Script, ToString) {
   Script script(
       "002096376230fbeec4d1e703c3a2d1efe975ccf650a40f6ca2ec2d6cce44fc6bb2b3");
@@ -533,6 +564,65 @@ TEST(Script, IsPegoutScriptTest) {
   EXPECT_TRUE(script.IsPegoutScript());
 }
 
+TEST(Script, ClassifyTest) {
+  struct TestVector {
+    std::string script;
+    StandardScriptType type;
+    std::string payload;
+  };
+  std::vector<TestVector> test_vector = {
+    {"0288b03ce954e6eccfd9bdfd8cea71f80957e20d37d020b1b99973ea9f897f2b81",
+        StandardScriptType::kNonStandardScript,
+        "0288b03ce954e6eccfd9bdfd8cea71f80957e20d37d020b1b99973ea9f897f2b81"},
+    {"210288b03ce954e6eccfd9bdfd8cea71f80957e20d37d020b1b99973ea9f897f2b81ac",
+        StandardScriptType::kP2pkScript,
+        "0288b03ce954e6eccfd9bdfd8cea71f80957e20d37d020b1b99973ea9f897f2b81"},
+    {"76a91418763afd24a108d323f53ebcea974e7f7d30950388ac",
+        StandardScriptType::kP2pkhScript,
+        "18763afd24a108d323f53ebcea974e7f7d309503"},
+    {"a91453c252a6a1379642adea35d055329ea04528eab787",
+        StandardScriptType::kP2shScript,
+        "53c252a6a1379642adea35d055329ea04528eab7"},
+    {"0014925d4028880bd0c9d68fbc7fc7dfee976698629c",
+        StandardScriptType::kP2wpkhScript,
+        "925d4028880bd0c9d68fbc7fc7dfee976698629c"},
+    {"002087cb0bc07de5b3befd7565b2c63fb1681bf2a25fc17a4e8d0fcc5e1087bd4f18",
+        StandardScriptType::kP2wshScript,
+        "87cb0bc07de5b3befd7565b2c63fb1681bf2a25fc17a4e8d0fcc5e1087bd4f18"},
+    {"51201777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb",
+        StandardScriptType::kTaprootScript,
+        "1777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb"},
+    {"52021234", StandardScriptType::kWitnessUnknownScript, "1234"},
+    {"0013925d4028880bd0c9d68fbc7fc7dfee9766986298",
+        StandardScriptType::kNonStandardScript,
+        "0013925d4028880bd0c9d68fbc7fc7dfee9766986298"},
+    {"512103b2f41b7a4f3b5e3d42e7a4a9dc3f8b3c6e2fbd8a1c2e75a04a1e2bbc3b27d96a2102f0b3b35fb2c8e9bfe2ec52fc7e41aa16fcb0d7db1a66c2cde1f2a07f1f01c8a852ae",
+        StandardScriptType::kMultisigScript,
+        "2103b2f41b7a4f3b5e3d42e7a4a9dc3f8b3c6e2fbd8a1c2e75a04a1e2bbc3b27d96a2102f0b3b35fb2c8e9bfe2ec52fc7e41aa16fcb0d7db1a66c2cde1f2a07f1f01c8a8"},
+    {"532103b2f41b7a4f3b5e3d42e7a4a9dc3f8b3c6e2fbd8a1c2e75a04a1e2bbc3b27d96a2102f0b3b35fb2c8e9bfe2ec52fc7e41aa16fcb0d7db1a66c2cde1f2a07f1f01c8a852ae",
+        StandardScriptType::kNonStandardScript,
+        "532103b2f41b7a4f3b5e3d42e7a4a9dc3f8b3c6e2fbd8a1c2e75a04a1e2bbc3b27d96a2102f0b3b35fb2c8e9bfe2ec52fc7e41aa16fcb0d7db1a66c2cde1f2a07f1f01c8a852ae"},
+    {"6a0568656c6c6f51", StandardScriptType::kNullDataScript,
+        "0568656c6c6f51"},
+    {"6a0568656c6c6f", StandardScriptType::kNullDataScript,
+        "0568656c6c6f"},
+    {"6a0668656c6c6f", StandardScriptType::kNonStandardScript,
+        "6a0668656c6c6f"},
+    {"6a76", StandardScriptType::kNonStandardScript, "6a76"},
+    {"", StandardScriptType::kNonStandardScript, ""},
+  };
+
+  for (const auto& test_data : test_vector) {
+    ByteData data(test_data.script);
+    ByteSpan payload;
+    EXPECT_EQ(test_data.type, Script::Classify(ByteSpan(data), &payload))
+        << test_data.script;
+    EXPECT_EQ(test_data.payload, payload.GetHex()) << test_data.script;
+    Script script(data, true);  // contains the incorrect push size
+    EXPECT_EQ(test_data.type, script.Classify()) << test_data.script;
+  }
+}
+
 TEST(Script, ParseCoinbaseScriptsigTest) {
   const std::string script = "03632b1e045352b260425443506f6f6cfabe6d6d4b081c2a3c7cb234c159b8e198294dfa79c04b54803e0e54c4a37d239445eb42020000007296cd100100000e8338000000000000";
   Script obj(ByteData(script), true);  // ignore size check
@@ -549,3 +639,88 @@ TEST(Script, ParseCoinbaseScriptsigTest) {
       list[2].GetBinaryData().GetHex());
   }
 }
+
+TEST(ScriptPool, Intern) {
+  const std::string p2pkh = "76a914925d4028880bd0c9d68fbc7fc7dfee976698629c88ac";
+  const std::string p2wpkh = "0014925d4028880bd0c9d68fbc7fc7dfee976698629c";
+  ScriptPool pool;
+  Script script1 = pool.Intern(ByteSpan(ByteData(p2pkh)));
+  Script script2 = pool.Intern(Script(p2pkh));
+  Script script3 = pool.Intern(ByteSpan(ByteData(p2wpkh)));
+  EXPECT_EQ(p2pkh, script1.GetHex());
+  EXPECT_TRUE(script1.Equals(script2));
+  EXPECT_EQ(p2wpkh, script3.GetHex());
+  EXPECT_EQ(5, script2.GetElementList().size());
+  EXPECT_EQ(2, pool.GetSize());
+  EXPECT_EQ(3, pool.GetInternCount());
+  EXPECT_EQ(1, pool.GetHitCount());
+  EXPECT_EQ(47, pool.GetByteSize());
+
+  // the scripts are valid after clear.
+  pool.Clear();
+  EXPECT_EQ(0, pool.GetSize());
+  EXPECT_EQ(0, pool.GetByteSize());
+  EXPECT_EQ(p2pkh, script1.GetHex());
+  EXPECT_EQ("0 925d4028880bd0c9d68fbc7fc7dfee976698629c",
+      script3.ToString());
+
+  EXPECT_THROW(
+      pool.Intern(ByteSpan(ByteData("4c"))), cfd::core::CfdException);
+
+  ScriptPool limited_pool(1);
+  limited_pool.Intern(ByteSpan(ByteData(p2pkh)));
+  Script script4 = limited_pool.Intern(ByteSpan(ByteData(p2wpkh)));
+  EXPECT_EQ(p2wpkh, script4.GetHex());
+  EXPECT_EQ(1, limited_pool.GetSize());
+}
+
+TEST(ScriptPool, Footprint) {
+  // p2wpkh is smaller than the inline capacity of ByteData.
+  const std::string p2wpkh = "0014925d4028880bd0c9d68fbc7fc7dfee976698629c";
+  const ByteData script_data(p2wpkh);
+  ASSERT_GT(ByteData::kInlineCapacity, script_data.GetDataSize());
+  ScriptPool pool;
+  std::vector<Script> scripts;
+  for (int count = 0; count < 1000; ++count) {
+    scripts.push_back(pool.Intern(ByteSpan(script_data)));
+  }
+  EXPECT_EQ(1, pool.GetSize());
+  EXPECT_EQ(999, pool.GetHitCount());
+  EXPECT_EQ(script_data.GetDataSize(), pool.GetByteSize());
+
+  // all scripts refer to the one pooled buffer.
+  const ByteData pooled_data = scripts.front().GetData();
+  const uint8_t* pooled_address = ByteSpan(pooled_data).data();
+  EXPECT_NE(ByteSpan(script_data).data(), pooled_address);
+  for (const auto& script : scripts) {
+    const ByteData data = script.GetData();
+    EXPECT_EQ(pooled_address, ByteSpan(data).data());
+  }
+  const ByteData interned_data = pool.Intern(Script(p2wpkh)).GetData();
+  EXPECT_EQ(pooled_address, ByteSpan(interned_data).data());
+
+  // copy-on-write: the pooled buffer is not changed.
+  ByteData append_data = pooled_data;
+  append_data.Push(ByteData("51"));
+  EXPECT_EQ(p2wpkh + "51", append_data.GetHex());
+  EXPECT_EQ(p2wpkh, scripts.back().GetHex());
+  EXPECT_EQ(p2wpkh, pool.Intern(ByteSpan(script_data)).GetHex());
+}
+
+TEST(ScriptPool, InternMultiThread) {
+  ScriptPool pool;
+  std::vector<std::thread> threads;
+  for (int index = 0; index < 4; ++index) {
+    threads.emplace_back([&pool]() {
+      for (int count = 0; count < 100; ++count) {
+        pool.Intern(ByteSpan(ByteData(
+            "a914" + std::string(39, '1') + std::to_string(count % 10) +
+            "87")));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(10, pool.GetSize());
+  EXPECT_EQ(400, pool.GetInternCount());
+  EXPECT_EQ(390, pool.GetHitCount());
+}
@@ -0,0 +1,1158 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+#include "cfdcore/cfdcore_common.h"
+#include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_key.h"
+#include "cfdcore/cfdcore_schnorrsig.h"
+#include "cfdcore/cfdcore_script_interpreter.h"
+#include "cfdcore/cfdcore_taproot.h"
+#include "cfdcore/cfdcore_transaction.h"
+#include "cfdcore/cfdcore_util.h"
+
+using cfd::core::Amount;
+using cfd::core::ByteData;
+using cfd::core::ByteData256;
+using cfd::core::CfdException;
+using cfd::core::CryptoUtil;
+using cfd::core::HashUtil;
+using cfd::core::Privkey;
+using cfd::core::Pubkey;
+using cfd::core::SchnorrPubkey;
+using cfd::core::SchnorrSignature;
+using cfd::core::SchnorrUtil;
+using cfd::core::Script;
+using cfd::core::ScriptError;
+using cfd::core::ScriptExecutionData;
+using cfd::core::ScriptInterpreter;
+using cfd::core::ScriptUtil;
+using cfd::core::ScriptWitness;
+using cfd::core::SigHashAlgorithm;
+using cfd::core::SigHashContext;
+using cfd::core::SigHashType;
+using cfd::core::SignatureChecker;
+using cfd::core::SigVersion;
+using cfd::core::TapScriptData;
+using cfd::core::TaprootScriptTree;
+using cfd::core::TaprootUtil;
+using cfd::core::Transaction;
+using cfd::core::TransactionSignatureChecker;
+using cfd::core::Txid;
+using cfd::core::TxOut;
+using cfd::core::WitnessVersion;
+
+/**
+ * @brief checker for test. (all ECDSA signatures are valid)
+ */
+class AcceptAllChecker : public SignatureChecker {
+ public:
+  virtual bool CheckEcdsaSignature(
+      const std::vector<uint8_t>& signature, const std::vector<uint8_t>&,
+      const std::vector<uint8_t>&, SigVersion) const {
+    return !signature.empty();
+  }
+};
+
+static std::vector<ByteData> EvalScriptHex(
+    const std::string& hex, uint32_t flags, ScriptError* error) {
+  SignatureChecker checker;
+  std::vector<ByteData> stack;
+  ScriptInterpreter::EvalScript(
+      &stack, Script(ByteData(hex), true), flags, checker,
+      SigVersion::kSigVersionBase, error);
+  return stack;
+}
+
+TEST(ScriptInterpreter, EvalScriptArithmetic) {
+  ScriptError error = ScriptError::kScriptErrUnknown;
+  // OP_2 OP_3 OP_ADD
+  auto stack = EvalScriptHex("525393", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+  ASSERT_EQ(size_t{1}, stack.size());
+  EXPECT_EQ("05", stack[0].GetHex());
+
+  // OP_1NEGATE OP_1NEGATE OP_ADD
+  stack = EvalScriptHex("4f4f93", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+  ASSERT_EQ(size_t{1}, stack.size());
+  EXPECT_EQ("82", stack[0].GetHex());
+
+  // 0x7f OP_1ADD
+  stack = EvalScriptHex("017f8b", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+  ASSERT_EQ(size_t{1}, stack.size());
+  EXPECT_EQ("8000", stack[0].GetHex());
+
+  // OP_3 OP_2 OP_5 OP_WITHIN
+  stack = EvalScriptHex("535255a5", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+  ASSERT_EQ(size_t{1}, stack.size());
+  EXPECT_EQ("01", stack[0].GetHex());
+
+  // 5 bytes number
+  EvalScriptHex("05010203040551", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+  EvalScriptHex("0501020304058b", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrUnknown, error);
+}
+
+TEST(ScriptInterpreter, EvalScriptFlowControl) {
+  ScriptError error = ScriptError::kScriptErrUnknown;
+  // OP_1 OP_IF OP_2 OP_ELSE OP_3 OP_ENDIF
+  auto stack = EvalScriptHex("516352675368", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+  ASSERT_EQ(size_t{1}, stack.size());
+  EXPECT_EQ("02", stack[0].GetHex());
+
+  // OP_0 OP_IF OP_2 OP_ELSE OP_3 OP_ENDIF
+  stack = EvalScriptHex("006352675368", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+  ASSERT_EQ(size_t{1}, stack.size());
+  EXPECT_EQ("03", stack[0].GetHex());
+
+  // OP_0 OP_IF OP_RETURN OP_ENDIF OP_1
+  stack = EvalScriptHex("00636a6851", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+
+  EvalScriptHex("5163", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrUnbalancedConditional, error);
+  EvalScriptHex("68", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrUnbalancedConditional, error);
+  EvalScriptHex("6a", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrOpReturn, error);
+  EvalScriptHex("0069", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrVerify, error);
+  EvalScriptHex("75", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrInvalidStackOperation, error);
+  EvalScriptHex("6c", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrInvalidAltstackOperation, error);
+  // OP_VERIF is invalid even in an unexecuted branch.
+  EvalScriptHex("00636568", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrBadOpcode, error);
+  // disabled opcode in an unexecuted branch
+  EvalScriptHex("00637e68", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrDisabledOpcode, error);
+}
+
+TEST(ScriptInterpreter, EvalScriptHash) {
+  ScriptError error = ScriptError::kScriptErrUnknown;
+  auto stack = EvalScriptHex("00a7", 0, &error);
+  ASSERT_EQ(size_t{1}, stack.size());
+  EXPECT_EQ("da39a3ee5e6b4b0d3255bfef95601890afd80709", stack[0].GetHex());
+  stack = EvalScriptHex("03616263a7", 0, &error);
+  ASSERT_EQ(size_t{1}, stack.size());
+  EXPECT_EQ("a9993e364706816aba3e25717850c26c9cd0d89d", stack[0].GetHex());
+  stack = EvalScriptHex("00a6", 0, &error);
+  ASSERT_EQ(size_t{1}, stack.size());
+  EXPECT_EQ("9c1185a5c5e9fc54612808977ee8f548b2258d31", stack[0].GetHex());
+  stack = EvalScriptHex("00a8", 0, &error);
+  ASSERT_EQ(size_t{1}, stack.size());
+  EXPECT_EQ(
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+      stack[0].GetHex());
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+}
+
+TEST(ScriptInterpreter, EvalScriptFlags) {
+  ScriptError error = ScriptError::kScriptErrUnknown;
+  // non-minimal push
+  EvalScriptHex("0101", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+  EvalScriptHex("0101", cfd::core::kScriptVerifyMinimalData, &error);
+  EXPECT_EQ(ScriptError::kScriptErrMinimalData, error);
+
+  // OP_NOP1
+  EvalScriptHex("b0", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+  EvalScriptHex(
+      "b0", cfd::core::kScriptVerifyDiscourageUpgradableNops, &error);
+  EXPECT_EQ(ScriptError::kScriptErrDiscourageUpgradableNops, error);
+
+  // OP_CHECKLOCKTIMEVERIFY
+  EvalScriptHex("4fb1", 0, &error);
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+  EvalScriptHex("4fb1", cfd::core::kScriptVerifyCheckLockTimeVerify, &error);
+  EXPECT_EQ(ScriptError::kScriptErrNegativeLocktime, error);
+  EvalScriptHex("51b1", cfd::core::kScriptVerifyCheckLockTimeVerify, &error);
+  EXPECT_EQ(ScriptError::kScriptErrUnsatisfiedLocktime, error);
+
+  // OP_CHECKSIG with empty signature
+  std::string checksig_hex =
+      "0021"
+      "031777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb"
+      "ac";
+  auto stack = EvalScriptHex(
+      checksig_hex,
+      cfd::core::kScriptVerifyStrictEnc | cfd::core::kScriptVerifyNullFail,
+      &error);
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+  ASSERT_EQ(size_t{1}, stack.size());
+  EXPECT_EQ("", stack[0].GetHex());
+  // the signature push is found in the script code.
+  EvalScriptHex(
+      checksig_hex, cfd::core::kScriptVerifyConstScriptCode, &error);
+  EXPECT_EQ(ScriptError::kScriptErrSigFindAndDelete, error);
+  // OP_CHECKSIG with invalid signature
+  EvalScriptHex(
+      "01302103"
+      "1777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfbac",
+      cfd::core::kScriptVerifyDerSig, &error);
+  EXPECT_EQ(ScriptError::kScriptErrSigDer, error);
+}
+
+TEST(ScriptInterpreter, VerifyScript) {
+  AcceptAllChecker checker;
+  ScriptError error = ScriptError::kScriptErrUnknown;
+  ScriptWitness empty_witness;
+  uint32_t flags = cfd::core::kScriptVerifyP2sh |
+                   cfd::core::kScriptVerifyWitness |
+                   cfd::core::kScriptVerifyCleanStack;
+
+  // p2pkh
+  ByteData pubkey(
+      "031777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c92833cfb");
+  Script locking_script(
+      "76a914" + HashUtil::Hash160(pubkey).GetHex() + "88ac");
+  Script unlocking_script("0101" + std::string("21") + pubkey.GetHex());
+  EXPECT_TRUE(ScriptInterpreter::VerifyScript(
+      unlocking_script, locking_script, empty_witness, flags, checker,
+      &error));
+  EXPECT_EQ(ScriptError::kScriptErrOk, error);
+  EXPECT_FALSE(ScriptInterpreter::VerifyScript(
+      Script("00" + std::string("21") + pubkey.GetHex()), locking_script,
+      empty_witness, flags, checker, &error));
+  EXPECT_EQ(ScriptError::kScriptErrEvalFalse, error);
+
+  // p2sh
+  Script p2sh_script(
+      "a914" + HashUtil::Hash160(ByteData("51")).GetHex() + "87");
+  EXPECT_TRUE(ScriptInterpreter::VerifyScript(
+      Script("0151"), p2sh_script, empty_witness, flags, checker, &error));
+  EXPECT_FALSE(ScriptInterpreter::VerifyScript(
+      Script("510151"), p2sh_script, empty_witness, flags, checker, &error));
+  EXPECT_EQ(ScriptError::kScriptErrCleanStack, error);
+  EXPECT_FALSE(ScriptInterpreter::VerifyScript(
+      Script("61"), p2sh_script, empty_witness, flags, checker, &error));
+  EXPECT_EQ(ScriptError::kScriptErrInvalidStackOperation, error);
+
+  // p2wsh
+  Script p2wsh_script("0020" + HashUtil::Sha256(ByteData("51")).GetHex());
+  ScriptWitness witness;
+  witness.AddWitnessStack(ByteData("51"));
+  EXPECT_TRUE(ScriptInterpreter::VerifyScript(
+      Script(), p2wsh_script, witness, flags, checker, &error));
+  EXPECT_FALSE(ScriptInterpreter::VerifyScript(
+      Script("51"), p2wsh_script, witness, flags, checker, &error));
+  EXPECT_EQ(ScriptError::kScriptErrWitnessMalleated, error);
+  EXPECT_FALSE(ScriptInterpreter::VerifyScript(
+      Script(), p2wsh_script, empty_witness, flags, checker, &error));
+  EXPECT_EQ(ScriptError::kScriptErrWitnessProgramWitnessEmpty, error);
+  EXPECT_FALSE(ScriptInterpreter::VerifyScript(
+      Script("0151"), p2sh_script, witness, flags, checker, &error));
+  EXPECT_EQ(ScriptError::kScriptErrWitnessUnexpected, error);
+
+  // p2sh-p2wsh
+  Script p2sh_p2wsh_script(
+      "a914" + HashUtil::Hash160(p2wsh_script).GetHex() + "87");
+  EXPECT_TRUE(ScriptInterpreter::VerifyScript(
+      Script("22" + p2wsh_script.GetHex()), p2sh_p2wsh_script, witness, flags,
+      checker, &error));
+
+  // unknown witness version
+  Script unknown_script("5202aabb");
+  EXPECT_TRUE(ScriptInterpreter::VerifyScript(
+      Script(), unknown_script, empty_witness, flags, checker, &error));
+  EXPECT_FALSE(ScriptInterpreter::VerifyScript(
+      Script(), unknown_script, empty_witness,
+      flags | cfd::core::kScriptVerifyDiscourageUpgradableWitnessProgram,
+      checker, &error));
+  EXPECT_EQ(
+      ScriptError::kScriptErrDiscourageUpgradableWitnessProgram, error);
+
+  // invalid flags
+  EXPECT_THROW(
+      ScriptInterpreter::VerifyScript(
+          Script("0151"), p2sh_script, empty_witness,
+          cfd::core::kScriptVerifyWitness, checker, &error),
+      CfdException);
+  EXPECT_THROW(
+      ScriptInterpreter::VerifyScript(
+          Script("0151"), p2sh_script, empty_witness,
+          cfd::core::kScriptVerifyP2sh | cfd::core::kScriptVerifyCleanStack,
+          checker, &error),
+      CfdException);
+}
+
+TEST(ScriptInterpreter, GetErrorString) {
+  EXPECT_EQ(
+      "No error",
+      ScriptInterpreter::GetErrorString(ScriptError::kScriptErrOk));
+  EXPECT_EQ(
+      "Witness program hash mismatch",
+      ScriptInterpreter::GetErrorString(
+          ScriptError::kScriptErrWitnessProgramMismatch));
+  EXPECT_EQ(
+      "unknown error",
+      ScriptInterpreter::GetErrorString(ScriptError::kScriptErrUnknown));
+}
+
+static const Privkey kTestPrivkey1(
+    "305e293b010d29bf3c888b617763a438fee9054c8cab66eb12ad078f819d9f27");
+static const Privkey kTestPrivkey2(
+    "f1a2f2ad0c3ee2dd4d2e2e76d9a5a1b8bd8e07fab2e0f2d3ee7bc14b15a1ac0d");
+static const Privkey kTestPrivkey3(
+    "3b8f5a3b02a1d5d9e4b5a4b9f0b2a4f8c2d8e6b1a9f7c5d3e1b9a7f5c3d1e9b7");
+static const Privkey kTestPrivkey4(
+    "9a0d1b5e8c0b8e4d4c8a2c3e0f7a1b5d6c9e2f4a8b1c3d5e7f9a0b2c4d6e8f01");
+static const Privkey kTestPrivkey5(
+    "6d1e2f3a4b5c6d7e8f9a0b1c2d3e4f5a6b7c8d9e0f1a2b3c4d5e6f7a8b9c0d1e");
+
+static constexpr uint32_t kTestTxInP2pkh = 0;
+static constexpr uint32_t kTestTxInP2shMultisig = 1;
+static constexpr uint32_t kTestTxInP2wpkh = 2;
+static constexpr uint32_t kTestTxInP2wshMultisig = 3;
+static constexpr uint32_t kTestTxInTaprootKeyPath = 4;
+static constexpr uint32_t kTestTxInTaprootScriptPath = 5;
+static constexpr uint32_t kTestTxInCount = 6;
+
+static ByteData SignEcdsa(
+    const ByteData256& sighash, const Privkey& privkey,
+    const SigHashType& sighash_type) {
+  return CryptoUtil::ConvertSignatureToDer(
+      privkey.CalculateEcSignature(sighash), sighash_type);
+}
+
+static ByteData SignSchnorr(
+    const ByteData256& sighash, const Privkey& privkey,
+    const SigHashType& sighash_type) {
+  SchnorrSignature signature = SchnorrUtil::Sign(sighash, privkey);
+  signature.SetSigHashType(sighash_type);
+  return signature.GetData(true);
+}
+
+static Script CreateTestTapScript() {
+  return Script(
+      "20" + SchnorrPubkey::FromPrivkey(kTestPrivkey5).GetHex() + "ac");
+}
+
+static TaprootScriptTree CreateTestTapTree() {
+  TaprootScriptTree tree(CreateTestTapScript());
+  // the other leaf: OP_TRUE
+  tree.AddBranch(TaprootScriptTree(Script("51")).GetTapLeafHash());
+  return tree;
+}
+
+/**
+ * @brief Create the signed transaction for test.
+ * @details txin: p2pkh, p2sh(2-of-3 multisig), p2wpkh,
+ *     p2wsh(1-of-2 multisig), taproot key path, taproot script path.
+ * @param[in] sighash_type  sighash type of all signatures
+ * @param[out] utxo_list    spent outputs
+ * @return signed transaction
+ */
+static Transaction CreateSignedTransaction(
+    const SigHashType& sighash_type, std::vector<TxOut>* utxo_list) {
+  const Pubkey pubkey1 = kTestPrivkey1.GetPubkey();
+  const Pubkey pubkey2 = kTestPrivkey2.GetPubkey();
+  const Pubkey pubkey3 = kTestPrivkey3.GetPubkey();
+  const Script multisig_2of3 = ScriptUtil::CreateMultisigRedeemScript(
+      2, {pubkey1, pubkey2, pubkey3}, false);
+  const Script multisig_1of2 =
+      ScriptUtil::CreateMultisigRedeemScript(1, {pubkey2, pubkey3});
+  const SchnorrPubkey internal_pubkey =
+      SchnorrPubkey::FromPrivkey(kTestPrivkey4);
+  const TaprootScriptTree empty_tree;
+  const TaprootScriptTree tap_tree = CreateTestTapTree();
+  Script taproot_script_path_locking_script;
+  const ByteData control = TaprootUtil::CreateTapScriptControl(
+      internal_pubkey, tap_tree, nullptr, &taproot_script_path_locking_script);
+
+  utxo_list->clear();
+  utxo_list->emplace_back(
+      Amount(int64_t{10000}), ScriptUtil::CreateP2pkhLockingScript(pubkey1));
+  utxo_list->emplace_back(
+      Amount(int64_t{20000}),
+      ScriptUtil::CreateP2shLockingScript(multisig_2of3));
+  utxo_list->emplace_back(
+      Amount(int64_t{30000}), ScriptUtil::CreateP2wpkhLockingScript(pubkey1));
+  utxo_list->emplace_back(
+      Amount(int64_t{40000}),
+      ScriptUtil::CreateP2wshLockingScript(multisig_1of2));
+  utxo_list->emplace_back(
+      Amount(int64_t{50000}),
+      ScriptUtil::CreateTaprootLockingScript(
+          empty_tree.GetTweakedPubkey(internal_pubkey).GetByteData256()));
+  utxo_list->emplace_back(
+      Amount(int64_t{60000}), taproot_script_path_locking_script);
+
+  Transaction tx(2, 0);
+  const Txid txid(
+      "3f7c1a5b8e2d4f6a9c0b1d3e5f7a9b2c4d6e8f0a1b3c5d7e9f2a4b6c8d0e1f30");
+  for (uint32_t index = 0; index < kTestTxInCount; ++index) {
+    tx.AddTxIn(txid, index, 0xfffffffe);
+    tx.AddTxOut(
+        Amount(int64_t{9000}),
+        ScriptUtil::CreateP2wpkhLockingScript(pubkey2));
+  }
+
+  ByteData256 sighash = tx.GetSignatureHash(
+      kTestTxInP2pkh,
+      utxo_list->at(kTestTxInP2pkh).GetLockingScript().GetData(),
+      sighash_type);
+  tx.SetUnlockingScript(
+      kTestTxInP2pkh,
+      {SignEcdsa(sighash, kTestPrivkey1, sighash_type), pubkey1.GetData()});
+
+  sighash = tx.GetSignatureHash(
+      kTestTxInP2shMultisig, multisig_2of3.GetData(), sighash_type);
+  tx.SetUnlockingScript(
+      kTestTxInP2shMultisig,
+      {ByteData(), SignEcdsa(sighash, kTestPrivkey1, sighash_type),
+       SignEcdsa(sighash, kTestPrivkey3, sighash_type),
+       multisig_2of3.GetData()});
+
+  sighash = tx.GetSignatureHash(
+      kTestTxInP2wpkh,
+      ScriptUtil::CreateP2pkhLockingScript(pubkey1).GetData(), sighash_type,
+      utxo_list->at(kTestTxInP2wpkh).GetValue(), WitnessVersion::kVersion0);
+  tx.AddScriptWitnessStack(
+      kTestTxInP2wpkh, SignEcdsa(sighash, kTestPrivkey1, sighash_type));
+  tx.AddScriptWitnessStack(kTestTxInP2wpkh, pubkey1.GetData());
+
+  sighash = tx.GetSignatureHash(
+      kTestTxInP2wshMultisig, multisig_1of2.GetData(), sighash_type,
+      utxo_list->at(kTestTxInP2wshMultisig).GetValue(),
+      WitnessVersion::kVersion0);
+  tx.AddScriptWitnessStack(kTestTxInP2wshMultisig, ByteData());
+  tx.AddScriptWitnessStack(
+      kTestTxInP2wshMultisig, SignEcdsa(sighash, kTestPrivkey3, sighash_type));
+  tx.AddScriptWitnessStack(kTestTxInP2wshMultisig, multisig_1of2.GetData());
+
+  sighash = tx.GetSchnorrSignatureHash(
+      kTestTxInTaprootKeyPath, sighash_type, *utxo_list);
+  tx.AddScriptWitnessStack(
+      kTestTxInTaprootKeyPath,
+      SignSchnorr(
+          sighash, empty_tree.GetTweakedPrivkey(kTestPrivkey4), sighash_type));
+
+  TapScriptData script_data;
+  script_data.tap_leaf_hash = tap_tree.GetTapLeafHash();
+  sighash = tx.GetSchnorrSignatureHash(
+      kTestTxInTaprootScriptPath, sighash_type, *utxo_list, &script_data);
+  tx.AddScriptWitnessStack(
+      kTestTxInTaprootScriptPath,
+      SignSchnorr(sighash, kTestPrivkey5, sighash_type));
+  tx.AddScriptWitnessStack(
+      kTestTxInTaprootScriptPath, CreateTestTapScript().GetData());
+  tx.AddScriptWitnessStack(kTestTxInTaprootScriptPath, control);
+  return tx;
+}
+
+TEST(ScriptInterpreter, SigHashContextSignatureHash) {
+  // 3 txin, 2 txout (SIGHASH_SINGLE for txin[2] has no output)
+  Transaction tx(2, 500000);
+  tx.AddTxIn(
+      Txid("2b7a8c0e9d3f5a1b4c6e8f0a2d4b6c8e0f1a3c5e7b9d1f3a5c7e9b1d3f5a7c9e"),
+      1, 0xfffffffd, Script("0151"));
+  tx.AddTxIn(
+      Txid("5d2c8e1f0a3b7c9d4e6f8a0b2c4d6e8f1a3b5c7d9e0f2a4b6c8d0e1f3a5b7c9d"),
+      0, 0xffffffff);
+  tx.AddTxIn(
+      Txid("9e8d7c6b5a4f3e2d1c0b9a8f7e6d5c4b3a2f1e0d9c8b7a6f5e4d3c2b1a0f9e8d"),
+      7, 0x00000010);
+  tx.AddTxOut(
+      Amount(int64_t{150000}),
+      ScriptUtil::CreateP2wpkhLockingScript(kTestPrivkey1.GetPubkey()));
+  tx.AddTxOut(
+      Amount(int64_t{60000}),
+      ScriptUtil::CreateP2pkhLockingScript(kTestPrivkey2.GetPubkey()));
+  std::vector<TxOut> utxo_list = {
+      TxOut(
+          Amount(int64_t{100000}),
+          ScriptUtil::CreateP2pkhLockingScript(kTestPrivkey1.GetPubkey())),
+      TxOut(
+          Amount(int64_t{70000}),
+          ScriptUtil::CreateTaprootLockingScript(
+              SchnorrPubkey::FromPrivkey(kTestPrivkey4).GetByteData256())),
+      TxOut(
+          Amount(int64_t{45000}),
+          ScriptUtil::CreateTaprootLockingScript(
+              SchnorrPubkey::FromPrivkey(kTestPrivkey5).GetByteData256())),
+  };
+  SigHashContext context(tx, utxo_list);
+  EXPECT_EQ(uint32_t{3}, context.GetTxInCount());
+  EXPECT_TRUE(context.HasUtxo());
+  EXPECT_EQ(int32_t{2}, context.GetVersion());
+  EXPECT_EQ(uint32_t{500000}, context.GetLockTime());
+
+  const ByteData script_code =
+      ScriptUtil::CreateP2pkhLockingScript(kTestPrivkey1.GetPubkey())
+          .GetData();
+  const std::vector<SigHashType> ecdsa_types = {
+      SigHashType(SigHashAlgorithm::kSigHashAll),
+      SigHashType(SigHashAlgorithm::kSigHashNone),
+      SigHashType(SigHashAlgorithm::kSigHashSingle),
+      SigHashType(SigHashAlgorithm::kSigHashAll, true),
+      SigHashType(SigHashAlgorithm::kSigHashNone, true),
+      SigHashType(SigHashAlgorithm::kSigHashSingle, true),
+  };
+  for (const auto& sighash_type : ecdsa_types) {
+    for (uint32_t index = 0; index < tx.GetTxInCount(); ++index) {
+      EXPECT_EQ(
+          tx.GetSignatureHash(index, script_code, sighash_type).GetHex(),
+          context.GetSignatureHash(index, script_code, sighash_type)
+              .GetHex())
+          << "legacy: " << sighash_type.GetSigHashFlag() << ", " << index;
+      Amount amount = utxo_list[index].GetValue();
+      EXPECT_EQ(
+          tx.GetSignatureHash(
+                index, script_code, sighash_type, amount,
+                WitnessVersion::kVersion0)
+              .GetHex(),
+          context
+              .GetSignatureHash(
+                  index, script_code, sighash_type, amount,
+                  WitnessVersion::kVersion0)
+              .GetHex())
+          << "segwit v0: " << sighash_type.GetSigHashFlag() << ", " << index;
+    }
+  }
+  // SIGHASH_SINGLE bug
+  EXPECT_EQ(
+      "0100000000000000000000000000000000000000000000000000000000000000",
+      context
+          .GetSignatureHash(
+              2, script_code, SigHashType(SigHashAlgorithm::kSigHashSingle))
+          .GetHex());
+
+  std::vector<SigHashType> schnorr_types = ecdsa_types;
+  schnorr_types.push_back(SigHashType(SigHashAlgorithm::kSigHashDefault));
+  TapScriptData script_data;
+  script_data.tap_leaf_hash = CreateTestTapTree().GetTapLeafHash();
+  script_data.code_separator_position = 3;
+  const ByteData annex("50aabbccdd");
+  for (const auto& sighash_type : schnorr_types) {
+    // txin[0] is not taproot.
+    for (uint32_t index = 1; index < tx.GetTxInCount(); ++index) {
+      if ((sighash_type.GetSigHashAlgorithm() ==
+           SigHashAlgorithm::kSigHashSingle) &&
+          (index >= tx.GetTxOutCount())) {
+        EXPECT_THROW(
+            context.GetSchnorrSignatureHash(index, sighash_type),
+            CfdException);
+        continue;
+      }
+      EXPECT_EQ(
+          tx.GetSchnorrSignatureHash(index, sighash_type, utxo_list)
+              .GetHex(),
+          context.GetSchnorrSignatureHash(index, sighash_type).GetHex())
+          << "key path: " << sighash_type.GetSigHashFlag() << ", " << index;
+      EXPECT_EQ(
+          tx.GetSchnorrSignatureHash(
+                index, sighash_type, utxo_list, &script_data, annex)
+              .GetHex(),
+          context
+              .GetSchnorrSignatureHash(
+                  index, sighash_type, &script_data, annex)
+              .GetHex())
+          << "script path: " << sighash_type.GetSigHashFlag() << ", "
+          << index;
+    }
+  }
+
+  EXPECT_THROW(
+      context.GetSignatureHash(
+          3, script_code, SigHashType(SigHashAlgorithm::kSigHashAll)),
+      CfdException);
+  EXPECT_THROW(
+      context.GetSignatureHash(
+          0, script_code, SigHashType(SigHashAlgorithm::kSigHashAll),
+          Amount(), WitnessVersion::kVersion1),
+      CfdException);
+  EXPECT_THROW(
+      SigHashContext(tx).GetSchnorrSignatureHash(
+          0, SigHashType(SigHashAlgorithm::kSigHashAll)),
+      CfdException);
+}
+
+TEST(ScriptInterpreter, TransactionSignatureChecker) {
+  std::vector<TxOut> utxo_list;
+  const SigHashType sighash_type(SigHashAlgorithm::kSigHashAll);
+  Transaction tx = CreateSignedTransaction(sighash_type, &utxo_list);
+  SigHashContext context(tx, utxo_list);
+
+  // p2pkh
+  const Pubkey pubkey = kTestPrivkey1.GetPubkey();
+  const ByteData script_code =
+      utxo_list[kTestTxInP2pkh].GetLockingScript().GetData();
+  ByteData256 sighash =
+      context.GetSignatureHash(kTestTxInP2pkh, script_code, sighash_type);
+  ByteData signature = SignEcdsa(sighash, kTestPrivkey1, sighash_type);
+  TransactionSignatureChecker checker(&context, kTestTxInP2pkh);
+  EXPECT_TRUE(checker.CheckEcdsaSignature(
+      signature.GetBytes(), pubkey.GetData().GetBytes(),
+      script_code.GetBytes(), SigVersion::kSigVersionBase));
+  // other pubkey
+  EXPECT_FALSE(checker.CheckEcdsaSignature(
+      signature.GetBytes(), kTestPrivkey2.GetPubkey().GetData().GetBytes(),
+      script_code.GetBytes(), SigVersion::kSigVersionBase));
+  // other sighash type
+  std::vector<uint8_t> other_type_sig = signature.GetBytes();
+  other_type_sig.back() = 0x02;
+  EXPECT_FALSE(checker.CheckEcdsaSignature(
+      other_type_sig, pubkey.GetData().GetBytes(), script_code.GetBytes(),
+      SigVersion::kSigVersionBase));
+  // other txin
+  TransactionSignatureChecker other_checker(&context, kTestTxInP2wpkh);
+  EXPECT_FALSE(other_checker.CheckEcdsaSignature(
+      signature.GetBytes(), pubkey.GetData().GetBytes(),
+      script_code.GetBytes(), SigVersion::kSigVersionBase));
+  // empty signature
+  EXPECT_FALSE(checker.CheckEcdsaSignature(
+      std::vector<uint8_t>(), pubkey.GetData().GetBytes(),
+      script_code.GetBytes(), SigVersion::kSigVersionBase));
+
+  // p2wpkh
+  sighash = context.GetSignatureHash(
+      kTestTxInP2wpkh, script_code, sighash_type,
+      utxo_list[kTestTxInP2wpkh].GetValue(), WitnessVersion::kVersion0);
+  signature = SignEcdsa(sighash, kTestPrivkey1, sighash_type);
+  EXPECT_TRUE(other_checker.CheckEcdsaSignature(
+      signature.GetBytes(), pubkey.GetData().GetBytes(),
+      script_code.GetBytes(), SigVersion::kSigVersionWitnessV0));
+  EXPECT_FALSE(other_checker.CheckEcdsaSignature(
+      signature.GetBytes(), pubkey.GetData().GetBytes(),
+      script_code.GetBytes(), SigVersion::kSigVersionBase));
+
+  // taproot key path
+  const Privkey tweaked_privkey =
+      TaprootScriptTree().GetTweakedPrivkey(kTestPrivkey4);
+  const std::vector<uint8_t> tweaked_pubkey =
+      SchnorrPubkey::FromPrivkey(tweaked_privkey).GetData().GetBytes();
+  const SigHashType default_type(SigHashAlgorithm::kSigHashDefault);
+  sighash = context.GetSchnorrSignatureHash(
+      kTestTxInTaprootKeyPath, default_type);
+  ByteData schnorr_sig = SignSchnorr(sighash, tweaked_privkey, default_type);
+  EXPECT_EQ(size_t{64}, schnorr_sig.GetDataSize());
+  TransactionSignatureChecker taproot_checker(
+      &context, kTestTxInTaprootKeyPath);
+  ScriptExecutionData exec_data;
+  ScriptError error = ScriptError::kScriptErrUnknown;
+  EXPECT_TRUE(taproot_checker.CheckSchnorrSignature(
+      schnorr_sig.GetBytes(), tweaked_pubkey, SigVersion::kSigVersionTaproot,
+      exec_data, &error));
+  sighash = context.GetSchnorrSignatureHash(
+      kTestTxInTaprootKeyPath, sighash_type);
+  schnorr_sig = SignSchnorr(sighash, tweaked_privkey, sighash_type);
+  EXPECT_EQ(size_t{65}, schnorr_sig.GetDataSize());
+  EXPECT_TRUE(taproot_checker.CheckSchnorrSignature(
+      schnorr_sig.GetBytes(), tweaked_pubkey, SigVersion::kSigVersionTaproot,
+      exec_data, &error));
+  // 65 bytes signature with SIGHASH_DEFAULT
+  std::vector<uint8_t> default_type_sig = schnorr_sig.GetBytes();
+  default_type_sig.back() = 0x00;
+  EXPECT_FALSE(taproot_checker.CheckSchnorrSignature(
+      default_type_sig, tweaked_pubkey, SigVersion::kSigVersionTaproot,
+      exec_data, &error));
+  EXPECT_EQ(ScriptError::kScriptErrSchnorrSigHashType, error);
+  // invalid signature
+  std::vector<uint8_t> invalid_sig = schnorr_sig.GetBytes();
+  invalid_sig[10] ^= 0x01;
+  EXPECT_FALSE(taproot_checker.CheckSchnorrSignature(
+      invalid_sig, tweaked_pubkey, SigVersion::kSigVersionTaproot, exec_data,
+      &error));
+  EXPECT_EQ(ScriptError::kScriptErrSchnorrSig, error);
+  invalid_sig.resize(63);
+  EXPECT_FALSE(taproot_checker.CheckSchnorrSignature(
+      invalid_sig, tweaked_pubkey, SigVersion::kSigVersionTaproot, exec_data,
+      &error));
+  EXPECT_EQ(ScriptError::kScriptErrSchnorrSigSize, error);
+
+  // locktime (tx locktime: 0, sequence: 0xfffffffe)
+  EXPECT_TRUE(checker.CheckLockTime(0));
+  EXPECT_FALSE(checker.CheckLockTime(1));
+  // sequence (tx version 2, sequence disable flag is set)
+  EXPECT_FALSE(checker.CheckSequence(0));
+}
+
+TEST(ScriptInterpreter, VerifyInput) {
+  const uint32_t flags = cfd::core::kScriptVerifyStandardFlags;
+  const std::vector<SigHashType> sighash_types = {
+      SigHashType(SigHashAlgorithm::kSigHashAll),
+      SigHashType(SigHashAlgorithm::kSigHashNone, true),
+      SigHashType(SigHashAlgorithm::kSigHashSingle),
+  };
+  for (const auto& sighash_type : sighash_types) {
+    std::vector<TxOut> utxo_list;
+    Transaction tx = CreateSignedTransaction(sighash_type, &utxo_list);
+    SigHashContext context(tx, utxo_list);
+    for (uint32_t index = 0; index < kTestTxInCount; ++index) {
+      ScriptError error = ScriptError::kScriptErrUnknown;
+      EXPECT_TRUE(ScriptInterpreter::VerifyInput(context, index, flags, &error))
+          << sighash_type.GetSigHashFlag() << ", " << index << ": "
+          << ScriptInterpreter::GetErrorString(error);
+      EXPECT_EQ(ScriptError::kScriptErrOk, error);
+    }
+  }
+
+  std::vector<TxOut> utxo_list;
+  const SigHashType sighash_type(SigHashAlgorithm::kSigHashAll);
+  const Transaction base_tx =
+      CreateSignedTransaction(sighash_type, &utxo_list);
+  ScriptError error = ScriptError::kScriptErrUnknown;
+
+  // p2pkh: signature of the other txin
+  Transaction tx = base_tx;
+  ByteData256 sighash = tx.GetSignatureHash(
+      kTestTxInP2shMultisig,
+      utxo_list[kTestTxInP2pkh].GetLockingScript().GetData(), sighash_type);
+  tx.SetUnlockingScript(
+      kTestTxInP2pkh,
+      {SignEcdsa(sighash, kTestPrivkey1, sighash_type),
+       kTestPrivkey1.GetPubkey().GetData()});
+  EXPECT_FALSE(ScriptInterpreter::VerifyInput(
+      SigHashContext(tx, utxo_list), kTestTxInP2pkh,
+      cfd::core::kScriptVerifyConsensusFlags, &error));
+  EXPECT_EQ(ScriptError::kScriptErrEvalFalse, error);
+  EXPECT_FALSE(ScriptInterpreter::VerifyInput(
+      SigHashContext(tx, utxo_list), kTestTxInP2pkh, flags, &error));
+  EXPECT_EQ(ScriptError::kScriptErrSigNullFail, error);
+
+  // p2sh multisig: wrong signature order
+  tx = base_tx;
+  auto unlocking_items =
+      tx.GetTxIn(kTestTxInP2shMultisig).GetUnlockingScript().GetElementList();
+  ASSERT_EQ(size_t{4}, unlocking_items.size());
+  tx.SetUnlockingScript(
+      kTestTxInP2shMultisig,
+      {ByteData(), unlocking_items[2].GetBinaryData(),
+       unlocking_items[1].GetBinaryData(), unlocking_items[3].GetBinaryData()});
+  EXPECT_FALSE(ScriptInterpreter::VerifyInput(
+      SigHashContext(tx, utxo_list), kTestTxInP2shMultisig,
+      cfd::core::kScriptVerifyConsensusFlags, &error));
+  EXPECT_EQ(ScriptError::kScriptErrEvalFalse, error);
+  // p2sh multisig: non-null dummy
+  tx.SetUnlockingScript(
+      kTestTxInP2shMultisig,
+      {ByteData("01"), unlocking_items[1].GetBinaryData(),
+       unlocking_items[2].GetBinaryData(), unlocking_items[3].GetBinaryData()});
+  EXPECT_TRUE(ScriptInterpreter::VerifyInput(
+      SigHashContext(tx, utxo_list), kTestTxInP2shMultisig,
+      cfd::core::kScriptVerifyP2sh, &error));
+  EXPECT_FALSE(ScriptInterpreter::VerifyInput(
+      SigHashContext(tx, utxo_list), kTestTxInP2shMultisig,
+      cfd::core::kScriptVerifyConsensusFlags, &error));
+  EXPECT_EQ(ScriptError::kScriptErrSigNullDummy, error);
+
+  // p2wpkh: amount is changed
+  std::vector<TxOut> other_utxo_list = utxo_list;
+  other_utxo_list[kTestTxInP2wpkh] = TxOut(
+      Amount(int64_t{30001}),
+      utxo_list[kTestTxInP2wpkh].GetLockingScript());
+  EXPECT_TRUE(ScriptInterpreter::VerifyInput(
+      SigHashContext(base_tx, other_utxo_list), kTestTxInP2pkh, flags,
+      &error));
+  EXPECT_FALSE(ScriptInterpreter::VerifyInput(
+      SigHashContext(base_tx, other_utxo_list), kTestTxInP2wpkh,
+      cfd::core::kScriptVerifyConsensusFlags, &error));
+  EXPECT_EQ(ScriptError::kScriptErrEvalFalse, error);
+  // the taproot signature commits to all amounts.
+  EXPECT_FALSE(ScriptInterpreter::VerifyInput(
+      SigHashContext(base_tx, other_utxo_list), kTestTxInTaprootKeyPath,
+      flags, &error));
+  EXPECT_EQ(ScriptError::kScriptErrSchnorrSig, error);
+
+  // p2wsh: witness script mismatch
+  tx = base_tx;
+  tx.SetScriptWitnessStack(
+      kTestTxInP2wshMultisig, 2,
+      ScriptUtil::CreateMultisigRedeemScript(
+          1, {kTestPrivkey3.GetPubkey(), kTestPrivkey2.GetPubkey()})
+          .GetData());
+  EXPECT_FALSE(ScriptInterpreter::VerifyInput(
+      SigHashContext(tx, utxo_list), kTestTxInP2wshMultisig, flags, &error));
+  EXPECT_EQ(ScriptError::kScriptErrWitnessProgramMismatch, error);
+
+  // taproot key path: invalid signature
+  tx = base_tx;
+  std::vector<uint8_t> signature =
+      tx.GetTxIn(kTestTxInTaprootKeyPath).GetScriptWitness().GetWitness()[0]
+          .GetBytes();
+  signature[0] ^= 0x80;
+  tx.SetScriptWitnessStack(kTestTxInTaprootKeyPath, 0, ByteData(signature));
+  EXPECT_FALSE(ScriptInterpreter::VerifyInput(
+      SigHashContext(tx, utxo_list), kTestTxInTaprootKeyPath, flags, &error));
+  EXPECT_EQ(ScriptError::kScriptErrSchnorrSig, error);
+
+  // taproot script path: control block of the other internal key
+  tx = base_tx;
+  tx.SetScriptWitnessStack(
+      kTestTxInTaprootScriptPath, 2,
+      TaprootUtil::CreateTapScriptControl(
+          SchnorrPubkey::FromPrivkey(kTestPrivkey1), CreateTestTapTree()));
+  EXPECT_FALSE(ScriptInterpreter::VerifyInput(
+      SigHashContext(tx, utxo_list), kTestTxInTaprootScriptPath, flags,
+      &error));
+  EXPECT_EQ(ScriptError::kScriptErrWitnessProgramMismatch, error);
+  // taproot script path: signature for the key path
+  tx = base_tx;
+  tx.SetScriptWitnessStack(
+      kTestTxInTaprootScriptPath, 0,
+      SignSchnorr(
+          tx.GetSchnorrSignatureHash(
+              kTestTxInTaprootScriptPath, sighash_type, utxo_list),
+          kTestPrivkey5, sighash_type));
+  EXPECT_FALSE(ScriptInterpreter::VerifyInput(
+      SigHashContext(tx, utxo_list), kTestTxInTaprootScriptPath, flags,
+      &error));
+  EXPECT_EQ(ScriptError::kScriptErrSchnorrSig, error);
+
+  EXPECT_THROW(
+      ScriptInterpreter::VerifyInput(
+          SigHashContext(base_tx, utxo_list), kTestTxInCount, flags, &error),
+      CfdException);
+  EXPECT_THROW(
+      ScriptInterpreter::VerifyInput(
+          SigHashContext(base_tx), kTestTxInP2pkh, flags, &error),
+      CfdException);
+}
+
+TEST(ScriptInterpreter, VerifyTransaction) {
+  const uint32_t flags = cfd::core::kScriptVerifyStandardFlags;
+  std::vector<TxOut> utxo_list;
+  const SigHashType sighash_type(SigHashAlgorithm::kSigHashAll);
+  const Transaction base_tx =
+      CreateSignedTransaction(sighash_type, &utxo_list);
+
+  std::vector<ScriptError> error_list;
+  EXPECT_TRUE(ScriptInterpreter::VerifyTransaction(
+      base_tx, utxo_list, flags, &error_list));
+  EXPECT_EQ(
+      std::vector<ScriptError>(kTestTxInCount, ScriptError::kScriptErrOk),
+      error_list);
+  EXPECT_TRUE(ScriptInterpreter::VerifyTransaction(
+      base_tx, utxo_list, flags, &error_list, 1));
+  // re-parse the serialized transaction
+  EXPECT_TRUE(ScriptInterpreter::VerifyTransaction(
+      Transaction(base_tx.GetHex()), utxo_list, flags, &error_list, 4));
+
+  Transaction tx = base_tx;
+  tx.SetScriptWitnessStack(
+      kTestTxInP2wpkh, 1, kTestPrivkey2.GetPubkey().GetData());
+  tx.RemoveScriptWitnessStackAll(kTestTxInTaprootScriptPath);
+  EXPECT_FALSE(ScriptInterpreter::VerifyTransaction(
+      tx, utxo_list, flags, &error_list, 3));
+  std::vector<ScriptError> expect_error_list(
+      kTestTxInCount, ScriptError::kScriptErrOk);
+  expect_error_list[kTestTxInP2wpkh] = ScriptError::kScriptErrEqualVerify;
+  expect_error_list[kTestTxInTaprootScriptPath] =
+      ScriptError::kScriptErrWitnessProgramWitnessEmpty;
+  EXPECT_EQ(expect_error_list, error_list);
+  // the signatures commit to the witness-free transaction.
+  for (uint32_t index = 0; index < kTestTxInP2wpkh; ++index) {
+    EXPECT_EQ(ScriptError::kScriptErrOk, error_list[index]);
+  }
+
+  // the output is changed after signing.
+  tx = base_tx;
+  tx.SetTxOutValue(0, Amount(int64_t{8999}));
+  EXPECT_FALSE(ScriptInterpreter::VerifyTransaction(
+      tx, utxo_list, cfd::core::kScriptVerifyConsensusFlags, &error_list));
+  for (uint32_t index = 0; index < kTestTxInCount; ++index) {
+    EXPECT_NE(ScriptError::kScriptErrOk, error_list[index]) << index;
+  }
+
+  utxo_list.pop_back();
+  EXPECT_THROW(
+      ScriptInterpreter::VerifyTransaction(base_tx, utxo_list, flags),
+      CfdException);
+}
+
+/**
+ * @brief script test vector.
+ * @details the format of bitcoin core's script_tests.json.
+ *     (scriptSig, scriptPubKey, witness, flags, expected error)
+ */
+struct ScriptTestVector {
+  std::string unlocking_script;       //!< scriptSig (hex)
+  std::string locking_script;         //!< scriptPubKey (hex)
+  std::vector<std::string> witness;   //!< witness stack (hex)
+  uint32_t flags;                     //!< verify flags
+  ScriptError error;                  //!< expected error
+  std::string comment;                //!< comment
+};
+
+/**
+ * @brief Create the spending transaction of bitcoin core's script test.
+ * @details crediting tx: version 1, txin(null outpoint, "0 0"),
+ *     txout(amount, locking script).
+ *     spending tx: version 1, txin(crediting tx:0), txout(amount, empty).
+ * @param[in] locking_script    locking script
+ * @param[in] amount            amount
+ * @return spending transaction
+ */
+static Transaction CreateScriptTestSpendingTx(
+    const Script& locking_script, const Amount& amount) {
+  Transaction crediting_tx(1, 0);
+  crediting_tx.AddTxIn(
+      Txid(ByteData256()), 0xffffffff, 0xffffffff, Script("0000"));
+  crediting_tx.AddTxOut(amount, locking_script);
+  Transaction spending_tx(1, 0);
+  spending_tx.AddTxIn(crediting_tx.GetTxid(), 0, 0xffffffff);
+  spending_tx.AddTxOut(amount, Script());
+  return spending_tx;
+}
+
+static ScriptError VerifyScriptTestVector(
+    const Script& unlocking_script, const Script& locking_script,
+    const ScriptWitness& witness, const Amount& amount, uint32_t flags) {
+  Transaction tx = CreateScriptTestSpendingTx(locking_script, amount);
+  SigHashContext context(tx, {TxOut(amount, locking_script)});
+  TransactionSignatureChecker checker(&context, 0);
+  ScriptError error = ScriptError::kScriptErrUnknown;
+  ScriptInterpreter::VerifyScript(
+      unlocking_script, locking_script, witness, flags, checker, &error);
+  return error;
+}
+
+TEST(ScriptInterpreter, ScriptTestsVectors) {
+  static constexpr uint32_t kP2shStrictEnc =
+      cfd::core::kScriptVerifyP2sh | cfd::core::kScriptVerifyStrictEnc;
+  static constexpr uint32_t kWitnessFlags =
+      cfd::core::kScriptVerifyP2sh | cfd::core::kScriptVerifyWitness;
+  // OP_IF 1 OP_ELSE 0 OP_ENDIF
+  const std::string minimalif_script = "6351670068";
+  const std::string minimalif_p2wsh =
+      "0020" + HashUtil::Sha256(ByteData(minimalif_script)).GetHex();
+  const std::vector<ScriptTestVector> vectors = {
+      {"5152", "52885187", {}, kP2shStrictEnc, ScriptError::kScriptErrOk,
+       "1 2 / 2 EQUALVERIFY 1 EQUAL"},
+      {"010b", "5b87", {}, kP2shStrictEnc, ScriptError::kScriptErrOk,
+       "push 1 byte"},
+      {"", "740087", {}, kP2shStrictEnc, ScriptError::kScriptErrOk,
+       "empty stack after scriptSig evaluation"},
+      {"00", "63506851", {}, kP2shStrictEnc, ScriptError::kScriptErrOk,
+       "0x50 is reserved (ok if not executed)"},
+      {"00", "636a6851", {}, kP2shStrictEnc, ScriptError::kScriptErrOk,
+       "Returning within an if statement should succeed"},
+      {"50", "51", {}, kP2shStrictEnc, ScriptError::kScriptErrBadOpcode,
+       "0x50 is reserved"},
+      {"51", "62", {}, kP2shStrictEnc, ScriptError::kScriptErrBadOpcode,
+       "OP_VER is reserved"},
+      {"51", "6a", {}, kP2shStrictEnc, ScriptError::kScriptErrOpReturn,
+       "OP_RETURN"},
+      {"0105", "7551", {}, cfd::core::kScriptVerifyMinimalData,
+       ScriptError::kScriptErrMinimalData,
+       "direct push of 0x05 equals OP_5"},
+      {"0181", "7551", {}, cfd::core::kScriptVerifyMinimalData,
+       ScriptError::kScriptErrMinimalData,
+       "direct push of 0x81 equals 1NEGATE"},
+      {"0181", "7551", {}, 0, ScriptError::kScriptErrOk,
+       "direct push of 0x81 without MINIMALDATA"},
+      {"5151", "51", {}, kP2shStrictEnc, ScriptError::kScriptErrOk,
+       "extra stack item without CLEANSTACK"},
+      {"5151", "51", {},
+       kP2shStrictEnc | kWitnessFlags | cfd::core::kScriptVerifyCleanStack,
+       ScriptError::kScriptErrCleanStack, "CLEANSTACK"},
+      {"", minimalif_p2wsh, {"02", minimalif_script}, kWitnessFlags,
+       ScriptError::kScriptErrOk, "non-minimal IF without MINIMALIF"},
+      {"", minimalif_p2wsh, {"02", minimalif_script},
+       kWitnessFlags | cfd::core::kScriptVerifyMinimalIf,
+       ScriptError::kScriptErrMinimalIf, "MINIMALIF: 2 is not minimal"},
+      {"", minimalif_p2wsh, {"00", minimalif_script},
+       kWitnessFlags | cfd::core::kScriptVerifyMinimalIf,
+       ScriptError::kScriptErrMinimalIf, "MINIMALIF: 0x00 is not minimal"},
+      {"", minimalif_p2wsh, {"01", minimalif_script},
+       kWitnessFlags | cfd::core::kScriptVerifyMinimalIf,
+       ScriptError::kScriptErrOk, "MINIMALIF: 1 is minimal"},
+      {"", minimalif_p2wsh, {"", minimalif_script},
+       kWitnessFlags | cfd::core::kScriptVerifyMinimalIf,
+       ScriptError::kScriptErrEvalFalse, "MINIMALIF: empty is minimal"},
+  };
+  for (const auto& vector : vectors) {
+    ScriptWitness witness;
+    for (const auto& item : vector.witness) {
+      witness.AddWitnessStack(ByteData(item));
+    }
+    EXPECT_EQ(
+        vector.error,
+        VerifyScriptTestVector(
+            Script(vector.unlocking_script), Script(vector.locking_script),
+            witness, Amount(), vector.flags))
+        << vector.comment;
+  }
+}
+
+/**
+ * @brief Convert to the high S signature.
+ * @param[in] signature   compact signature (low S)
+ * @return compact signature (high S)
+ */
+static ByteData ConvertHighS(const ByteData& signature) {
+  static const std::vector<uint8_t> kOrder = ByteData(
+      "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141")
+                                                 .GetBytes();
+  std::vector<uint8_t> bytes = signature.GetBytes();
+  int borrow = 0;
+  for (int index = 31; index >= 0; --index) {
+    int value = kOrder[index] - bytes[32 + index] - borrow;
+    borrow = (value < 0) ? 1 : 0;
+    bytes[32 + index] = static_cast<uint8_t>(value + (borrow * 256));
+  }
+  return ByteData(bytes);
+}
+
+TEST(ScriptInterpreter, ScriptTestsSignatureVectors) {
+  const SigHashType sighash_type(SigHashAlgorithm::kSigHashAll);
+  const Pubkey pubkey = kTestPrivkey1.GetPubkey();
+  // <pubkey> CHECKSIG
+  const Script p2pk_script = ScriptUtil::CreateP2pkLockingScript(pubkey);
+  // <pubkey> CHECKSIG NOT
+  const Script p2pk_not_script(p2pk_script.GetHex() + "91");
+  const Script multisig_script = ScriptUtil::CreateMultisigRedeemScript(
+      2, {pubkey, kTestPrivkey2.GetPubkey()}, false);
+  const Script multisig_not_script(multisig_script.GetHex() + "91");
+  const ScriptWitness empty_witness;
+  const Amount amount;
+  const uint32_t flags = cfd::core::kScriptVerifyP2sh;
+
+  ByteData256 sighash =
+      SigHashContext(CreateScriptTestSpendingTx(p2pk_script, amount))
+          .GetSignatureHash(0, p2pk_script.GetData(), sighash_type);
+  ByteData compact_sig = kTestPrivkey1.CalculateEcSignature(sighash);
+  ByteData signature =
+      CryptoUtil::ConvertSignatureToDer(compact_sig, sighash_type);
+  ByteData high_s_signature = CryptoUtil::ConvertSignatureToDer(
+      ConvertHighS(compact_sig), sighash_type);
+  EXPECT_EQ(
+      compact_sig.GetHex(),
+      CryptoUtil::NormalizeSignature(ConvertHighS(compact_sig)).GetHex());
+
+  // P2PK
+  Script unlocking_script(
+      ByteData(static_cast<uint8_t>(signature.GetDataSize())).GetHex() +
+      signature.GetHex());
+  EXPECT_EQ(
+      ScriptError::kScriptErrOk,
+      VerifyScriptTestVector(
+          unlocking_script, p2pk_script, empty_witness, amount, flags));
+  // P2PK with undefined sighash type
+  Script undefined_type_script(
+      ByteData(static_cast<uint8_t>(signature.GetDataSize())).GetHex() +
+      signature.GetHex().substr(0, signature.GetHex().size() - 2) + "21");
+  EXPECT_EQ(
+      ScriptError::kScriptErrOk,
+      VerifyScriptTestVector(
+          undefined_type_script, p2pk_not_script, empty_witness, amount,
+          flags));
+  EXPECT_EQ(
+      ScriptError::kScriptErrSigHashType,
+      VerifyScriptTestVector(
+          undefined_type_script, p2pk_script, empty_witness, amount,
+          flags | cfd::core::kScriptVerifyStrictEnc));
+
+  // P2PK with high S
+  Script high_s_script(
+      ByteData(static_cast<uint8_t>(high_s_signature.GetDataSize()))
+          .GetHex() +
+      high_s_signature.GetHex());
+  EXPECT_EQ(
+      ScriptError::kScriptErrOk,
+      VerifyScriptTestVector(
+          high_s_script, p2pk_script, empty_witness, amount, flags));
+  EXPECT_EQ(
+      ScriptError::kScriptErrSigHighS,
+      VerifyScriptTestVector(
+          high_s_script, p2pk_script, empty_witness, amount,
+          flags | cfd::core::kScriptVerifyLowS));
+
+  // P2PK NOT with invalid sig (signature of the other message)
+  ByteData invalid_signature = CryptoUtil::ConvertSignatureToDer(
+      kTestPrivkey1.CalculateEcSignature(HashUtil::Sha256("other")),
+      sighash_type);
+  Script invalid_sig_script(
+      ByteData(static_cast<uint8_t>(invalid_signature.GetDataSize()))
+          .GetHex() +
+      invalid_signature.GetHex());
+  EXPECT_EQ(
+      ScriptError::kScriptErrOk,
+      VerifyScriptTestVector(
+          invalid_sig_script, p2pk_not_script, empty_witness, amount,
+          flags));
+  EXPECT_EQ(
+      ScriptError::kScriptErrSigNullFail,
+      VerifyScriptTestVector(
+          invalid_sig_script, p2pk_not_script, empty_witness, amount,
+          flags | cfd::core::kScriptVerifyNullFail));
+  EXPECT_EQ(
+      ScriptError::kScriptErrEvalFalse,
+      VerifyScriptTestVector(
+          invalid_sig_script, p2pk_script, empty_witness, amount, flags));
+  // P2PK NOT with empty sig and NULLFAIL
+  EXPECT_EQ(
+      ScriptError::kScriptErrOk,
+      VerifyScriptTestVector(
+          Script("00"), p2pk_not_script, empty_witness, amount,
+          flags | cfd::core::kScriptVerifyNullFail));
+
+  // 2-of-2 CHECKMULTISIG NOT with the first sig invalid
+  sighash =
+      SigHashContext(CreateScriptTestSpendingTx(multisig_not_script, amount))
+          .GetSignatureHash(0, multisig_not_script.GetData(), sighash_type);
+  ByteData multisig_sig2 = CryptoUtil::ConvertSignatureToDer(
+      kTestPrivkey2.CalculateEcSignature(sighash), sighash_type);
+  Script multisig_unlocking_script(
+      "00" +
+      ByteData(static_cast<uint8_t>(invalid_signature.GetDataSize()))
+          .GetHex() +
+      invalid_signature.GetHex() +
+      ByteData(static_cast<uint8_t>(multisig_sig2.GetDataSize())).GetHex() +
+      multisig_sig2.GetHex());
+  EXPECT_EQ(
+      ScriptError::kScriptErrOk,
+      VerifyScriptTestVector(
+          multisig_unlocking_script, multisig_not_script, empty_witness,
+          amount, flags));
+  EXPECT_EQ(
+      ScriptError::kScriptErrSigNullFail,
+      VerifyScriptTestVector(
+          multisig_unlocking_script, multisig_not_script, empty_witness,
+          amount, flags | cfd::core::kScriptVerifyNullFail));
+  EXPECT_EQ(
+      ScriptError::kScriptErrOk,
+      VerifyScriptTestVector(
+          Script("000000"), multisig_not_script, empty_witness, amount,
+          flags | cfd::core::kScriptVerifyNullFail));
+
+  // P2SH(P2PK) with extra stack item and CLEANSTACK
+  Script p2sh_script = ScriptUtil::CreateP2shLockingScript(p2pk_script);
+  sighash = SigHashContext(CreateScriptTestSpendingTx(p2sh_script, amount))
+                .GetSignatureHash(0, p2pk_script.GetData(), sighash_type);
+  signature = CryptoUtil::ConvertSignatureToDer(
+      kTestPrivkey1.CalculateEcSignature(sighash), sighash_type);
+  std::string p2sh_unlocking_hex =
+      ByteData(static_cast<uint8_t>(signature.GetDataSize())).GetHex() +
+      signature.GetHex() +
+      ByteData(static_cast<uint8_t>(p2pk_script.GetData().GetDataSize()))
+          .GetHex() +
+      p2pk_script.GetHex();
+  EXPECT_EQ(
+      ScriptError::kScriptErrOk,
+      VerifyScriptTestVector(
+          Script(p2sh_unlocking_hex), p2sh_script, empty_witness, amount,
+          flags | cfd::core::kScriptVerifyWitness |
+              cfd::core::kScriptVerifyCleanStack));
+  EXPECT_EQ(
+      ScriptError::kScriptErrOk,
+      VerifyScriptTestVector(
+          Script("51" + p2sh_unlocking_hex), p2sh_script, empty_witness,
+          amount, flags));
+  EXPECT_EQ(
+      ScriptError::kScriptErrCleanStack,
+      VerifyScriptTestVector(
+          Script("51" + p2sh_unlocking_hex), p2sh_script, empty_witness,
+          amount,
+          flags | cfd::core::kScriptVerifyWitness |
+              cfd::core::kScriptVerifyCleanStack));
+}
@@ -280,6 +280,24 @@ TEST(ScriptBuilder, StringBuildTest) {
     "0 17 8738 3355443");
 }
 
+TEST(ScriptBuilder, AppendAsmTest) {
+  std::string asm_str =
+  "304402203dd0c408e173d6b7252eabc7e3f6a0c632d930a7b343eaf60e7ebee9eb01adcc02204a567cb6a941c88f24f4c4201633468d53810fae9cdb90f35571e6b52bed005e 042322ed12f2779cae32ca89f15d61d10e3bd725d74d45269b05a34abb91b45a2ca19cc8734300deaf74d006871b5cd0730f2384037d16843663a0327fce24aef0 144 OP_CHECKLOCKTIMEVERIFY OP_DROP 1469272661 OP_SHA256 f6116d61351c05df34e116f1cc63fcacbd4f1a3882d2f629e7a0986ac03005c4 OP_EQUALVERIFY OP_CHECKSIG";// NOLINT
+  Script script;
+  EXPECT_NO_THROW(script = ScriptBuilder().AppendAsm(asm_str).Build());
+  EXPECT_STREQ(script.ToString().c_str(), asm_str.c_str());
+  EXPECT_STREQ(Script(script.GetHex()).ToString().c_str(), asm_str.c_str());
+
+  EXPECT_NO_THROW(script = ScriptBuilder()
+      .AppendAsm("  OP_0 OP_1NEGATE\tOP_16 OP_TRUE  ")
+      .AppendAsm("")
+      .AppendAsm("OP_FALSE 0x2222\nOP_CHECKSIG").Build());
+  EXPECT_STREQ(script.GetHex().c_str(), "004f605100022222ac");
+  EXPECT_STREQ(script.ToString().c_str(), "0 -1 16 1 0 8738 OP_CHECKSIG");
+
+  EXPECT_THROW(ScriptBuilder().AppendAsm("OP_DUP OP_xxxx"), CfdException);
+}
+
 TEST(ScriptBuilder, StringBuildByOperator) {
   Script script = (ScriptBuilder() << "5" << "2" << "OP_ADD" << "OP_CHECKSIG").Build();
   EXPECT_STREQ(script.GetHex().c_str(), "555293ac");
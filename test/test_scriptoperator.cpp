@@ -151,3 +151,32 @@ TEST(ScriptOperator, IsOpSuccess) {
   EXPECT_TRUE(ScriptOperator::IsOpSuccess(ScriptType::kOpSuccess195));
   EXPECT_TRUE(ScriptOperator::IsOpSuccess(ScriptType::kOpSuccess195, true));
 }
+
+TEST(ScriptOperator, OpcodeTable) {
+  // canonical text and the ScriptOperator::Get round trip.
+  for (uint32_t code = 0x4c; code <= 0xff; ++code) {
+    ScriptOperator ope(static_cast<ScriptType>(code));
+    std::string text = ope.ToString();
+    EXPECT_STRNE(text.c_str(), "UNKNOWN") << code;
+    EXPECT_TRUE(ScriptOperator::IsValid(text)) << text;
+    EXPECT_EQ(ScriptOperator::Get(text).GetDataType(), ope.GetDataType());
+    EXPECT_TRUE(ScriptOperator::IsValid(ope.ToCodeString())) << text;
+    EXPECT_EQ(
+        ScriptOperator::Get(ope.ToCodeString()).GetDataType(),
+        ope.GetDataType());
+  }
+  EXPECT_STREQ(ScriptOperator(ScriptType::kOpReserved).ToString().c_str(),
+      "OP_RESERVED");
+  EXPECT_STREQ(ScriptOperator::Get("OP_SUCCESS80").ToString().c_str(),
+      "OP_SUCCESS80");
+  EXPECT_STREQ(ScriptOperator::Get("OP_16").ToString().c_str(), "16");
+  EXPECT_STREQ(ScriptOperator(static_cast<ScriptType>(0x14)).ToString().c_str(),
+      "UNKNOWN");
+  EXPECT_FALSE(ScriptOperator::IsValid("OP_17"));
+  EXPECT_FALSE(ScriptOperator::IsValid("OP_01"));
+  EXPECT_FALSE(ScriptOperator::IsValid("OP_DU"));
+  EXPECT_FALSE(ScriptOperator::IsValid("OP_DUPP"));
+  EXPECT_FALSE(ScriptOperator::IsValid(""));
+  EXPECT_TRUE(ScriptOperator::OP_16.IsPushOperator());
+  EXPECT_FALSE(ScriptOperator::OP_NOP.IsPushOperator());
+}
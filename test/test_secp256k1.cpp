@@ -1,4 +1,6 @@
 #include "gtest/gtest.h"
+#include <thread>
+#include <vector>
 
 #include "wally_core.h"
 #include "cfdcore_secp256k1.h"
@@ -8,6 +10,7 @@ using cfd::core::ByteData;
 using cfd::core::CfdError;
 using cfd::core::CfdException;
 using cfd::core::Secp256k1;
+using cfd::core::Secp256k1ContextPool;
 
 typedef struct {
   std::vector<ByteData> pubkeys;
@@ -460,3 +463,67 @@ TEST(Secp256k1, RangeProofInfoSecp256k1ErrorTest) {
     }
   }
 }
+
+TEST(Secp256k1ContextPool, GetContextTest) {
+  struct secp256k1_context_struct *ctx = wally_get_secp_context();
+  Secp256k1ContextPool pool;
+  EXPECT_FALSE(pool.IsInitialized());
+  EXPECT_EQ(nullptr, pool.GetContext());
+  EXPECT_THROW(pool.Initialize(nullptr), CfdException);
+
+  pool.Initialize(ctx, 2, 4);
+  EXPECT_TRUE(pool.IsInitialized());
+  EXPECT_THROW(pool.Initialize(ctx), CfdException);
+
+  // same context on the same thread, even after the re-randomization.
+  void* main_context = pool.GetContext();
+  EXPECT_NE(nullptr, main_context);
+  EXPECT_NE(static_cast<void*>(ctx), main_context);
+  for (int count = 0; count < 10; ++count) {
+    EXPECT_EQ(main_context, pool.GetContext());
+  }
+
+  // the context works like the base context.
+  Secp256k1 secp(pool.GetContext());
+  ByteData combined = secp.CombinePubkeySecp256k1Ec({
+      ByteData("03662a01c232918c9deb3b330272483c3e4ec0c6b5da86df59252835afeb4ab5f9"),
+      ByteData("0261e37f277f02a977b4f11eb5055abab4990bbf8dee701119d88df382fcc1fafe")});
+  EXPECT_EQ("022a66efd1ea9b1ad3acfcc62a5ce8c756fa6fc3917fce3d4952a8701244ed1049",
+      combined.GetHex());
+
+  // each thread has another context.
+  std::vector<void*> thread_contexts(4);
+  std::vector<std::thread> threads;
+  for (size_t idx = 0; idx < thread_contexts.size(); ++idx) {
+    threads.emplace_back([&pool, &thread_contexts, idx]() {
+      thread_contexts[idx] = pool.GetContext();
+      EXPECT_EQ(thread_contexts[idx], pool.GetContext());
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (const auto& context : thread_contexts) {
+    EXPECT_NE(nullptr, context);
+    EXPECT_NE(main_context, context);
+  }
+
+  // the returned context is re-randomized and still works.
+  std::string reused_combined;
+  std::thread reuse_thread([&pool, &reused_combined]() {
+    Secp256k1 thread_secp(pool.GetContext());
+    reused_combined = thread_secp.CombinePubkeySecp256k1Ec({
+        ByteData("03662a01c232918c9deb3b330272483c3e4ec0c6b5da86df59252835afeb4ab5f9"),
+        ByteData("0261e37f277f02a977b4f11eb5055abab4990bbf8dee701119d88df382fcc1fafe")})
+        .GetHex();
+  });
+  reuse_thread.join();
+  EXPECT_EQ(combined.GetHex(), reused_combined);
+
+  pool.Finalize();
+  EXPECT_FALSE(pool.IsInitialized());
+  EXPECT_EQ(nullptr, pool.GetContext());
+
+  // the thread slot is renewed on the re-initialize.
+  pool.Initialize(ctx);
+  EXPECT_NE(nullptr, pool.GetContext());
+  pool.Finalize();
+}
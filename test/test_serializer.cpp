@@ -4,10 +4,13 @@
 #include "cfdcore/cfdcore_common.h"
 #include "cfdcore/cfdcore_bytedata.h"
 #include "cfdcore/cfdcore_exception.h"
+#include "cfdcore/cfdcore_util.h"
 
 using cfd::core::ByteData;
 using cfd::core::ByteData160;
 using cfd::core::ByteData256;
+using cfd::core::CfdException;
+using cfd::core::HashUtil;
 using cfd::core::Serializer;
 
 TEST(Serializer, Normal) {
@@ -56,3 +59,70 @@ TEST(Serializer, BigEndian) {
   builder.AddDirectBigEndianNumber(0x01020304);
   EXPECT_EQ("01020304", builder.Output().GetHex());
 }
+
+TEST(Serializer, ExternalBuffer) {
+  Serializer counter = Serializer::CreateSizeCounter();
+  counter.AddDirectNumber(uint32_t{1});
+  counter.AddVariableBuffer(ByteData("f1f2"));
+  counter.AddDirectBigEndianNumber(0x01020304);
+  EXPECT_EQ(11U, counter.GetWriteSize());
+  EXPECT_THROW(counter.Output(), CfdException);
+
+  std::vector<uint8_t> buffer(counter.GetWriteSize());
+  Serializer builder(buffer.data(), static_cast<uint32_t>(buffer.size()));
+  builder.AddDirectNumber(uint32_t{1});
+  builder.AddVariableBuffer(ByteData("f1f2"));
+  builder.AddDirectBigEndianNumber(0x01020304);
+  EXPECT_EQ("0100000002f1f201020304", ByteData(buffer).GetHex());
+  EXPECT_EQ("0100000002f1f201020304", builder.Output().GetHex());
+  EXPECT_EQ(
+      HashUtil::Sha256(ByteData(buffer)).GetHex(),
+      builder.OutputSha256().GetHex());
+  EXPECT_THROW(builder.AddDirectByte(0), CfdException);
+}
+
+TEST(Serializer, Sha256Sink) {
+  Serializer builder;
+  Serializer sink = Serializer::CreateSha256Sink();
+  for (uint32_t index = 0; index < 100; ++index) {
+    ByteData data(std::vector<uint8_t>(index, static_cast<uint8_t>(index)));
+    builder.AddVariableBuffer(data);
+    builder.AddDirectNumber(index);
+    sink.AddVariableBuffer(data);
+    sink.AddDirectNumber(index);
+  }
+  EXPECT_EQ(builder.GetWriteSize(), sink.GetWriteSize());
+  EXPECT_EQ(
+      HashUtil::Sha256(builder.Output()).GetHex(),
+      sink.OutputSha256().GetHex());
+  EXPECT_EQ(
+      HashUtil::Sha256D(builder.Output()).GetHex(),
+      sink.OutputSha256d().GetHex());
+  EXPECT_EQ(
+      builder.OutputSha256().GetHex(), sink.OutputSha256().GetHex());
+  EXPECT_THROW(sink.Output(), CfdException);
+
+  Serializer empty_sink = Serializer::CreateSha256Sink();
+  EXPECT_EQ(
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+      empty_sink.OutputSha256().GetHex());
+}
+
+TEST(Serializer, TaggedSha256Sink) {
+  ByteData256 tag = HashUtil::Sha256("TapLeaf");
+  ByteData script(
+      "2079be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798ac");
+  Serializer builder;
+  builder.AddDirectBytes(tag);
+  builder.AddDirectBytes(tag);
+  builder.AddDirectByte(0xc0);
+  builder.AddVariableBuffer(script);
+
+  Serializer sink = Serializer::CreateTaggedSha256Sink("TapLeaf");
+  sink.AddDirectByte(0xc0);
+  sink.AddVariableBuffer(script);
+  EXPECT_EQ(
+      HashUtil::Sha256(builder.Output()).GetHex(),
+      sink.OutputSha256().GetHex());
+  EXPECT_EQ(36U, sink.GetWriteSize());
+}
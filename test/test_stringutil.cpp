@@ -66,6 +66,70 @@ TEST(StringUtil, ByteToStringEmpty) {
   EXPECT_STREQ(result.c_str(), "");
 }
 
+TEST(StringUtil, ByteToStringBuffer) {
+  // cover the vectorized and the remaining scalar path.
+  std::vector<uint8_t> bytes(100);
+  std::string expect_hex;
+  for (size_t index = 0; index < bytes.size(); ++index) {
+    bytes[index] = static_cast<uint8_t>(index * 37 + 11);
+    const char *hex_table = "0123456789abcdef";
+    expect_hex += hex_table[bytes[index] >> 4];
+    expect_hex += hex_table[bytes[index] & 0x0f];
+  }
+  for (size_t size = 0; size <= bytes.size(); ++size) {
+    std::vector<char> buffer(size * 2 + 1, 'x');
+    EXPECT_EQ(size * 2, StringUtil::ByteToString(
+        bytes.data(), size, buffer.data(), buffer.size()));
+    EXPECT_EQ(expect_hex.substr(0, size * 2),
+        std::string(buffer.data(), size * 2));
+    EXPECT_EQ('x', buffer[size * 2]);
+    EXPECT_EQ(expect_hex.substr(0, size * 2), StringUtil::ByteToString(
+        std::vector<uint8_t>(bytes.begin(), bytes.begin() + size)));
+  }
+
+  char small_buffer[3];
+  EXPECT_THROW(StringUtil::ByteToString(bytes.data(), 2, small_buffer,
+      sizeof(small_buffer)), cfd::core::CfdException);
+}
+
+TEST(StringUtil, StringToByteBuffer) {
+  std::string hex;
+  for (size_t index = 0; index < 100; ++index) {
+    hex += (index % 3 == 0) ? "Af" : "9c";
+  }
+  std::vector<uint8_t> expect_bytes;
+  for (size_t index = 0; index < 100; ++index) {
+    expect_bytes.push_back((index % 3 == 0) ? 0xaf : 0x9c);
+  }
+  for (size_t size = 0; size <= expect_bytes.size(); ++size) {
+    std::vector<uint8_t> buffer(size + 1, 0x55);
+    EXPECT_EQ(size, StringUtil::StringToByte(
+        hex.data(), size * 2, buffer.data(), buffer.size()));
+    EXPECT_EQ(std::vector<uint8_t>(expect_bytes.begin(),
+        expect_bytes.begin() + size),
+        std::vector<uint8_t>(buffer.begin(), buffer.begin() + size));
+    EXPECT_EQ(0x55, buffer[size]);
+  }
+
+  // an invalid character at every position.
+  static const char kInvalidChars[] = {'g', 'G', '/', ':', '@', '`', ' ', 'z',
+      '\0', static_cast<char>(0x80), static_cast<char>(0xff)};
+  std::vector<uint8_t> buffer(expect_bytes.size());
+  for (size_t index = 0; index < hex.size(); ++index) {
+    std::string target = hex;
+    target[index] = kInvalidChars[index % sizeof(kInvalidChars)];
+    EXPECT_THROW(StringUtil::StringToByte(target.data(), target.size(),
+        buffer.data(), buffer.size()), cfd::core::CfdException);
+    EXPECT_FALSE(StringUtil::IsValidHexString(target));
+  }
+  EXPECT_THROW(StringUtil::StringToByte(hex.data(), hex.size(),
+      buffer.data(), buffer.size() - 1), cfd::core::CfdException);
+  EXPECT_THROW(StringUtil::StringToByte(hex.data(), 3,
+      buffer.data(), buffer.size()), cfd::core::CfdException);
+  EXPECT_TRUE(StringUtil::IsValidHexString(hex));
+  EXPECT_FALSE(StringUtil::IsValidHexString("abc"));
+}
+
 TEST(StringUtil, ToLower) {
   std::string result = StringUtil::ToLower("AbCdE_1fg");
   EXPECT_STREQ(result.c_str(), "abcde_1fg");
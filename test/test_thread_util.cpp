@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "cfdcore_thread_util.h"
+
+using cfd::core::ParallelFor;
+using cfd::core::RunOnWorkerPool;
+
+TEST(ThreadUtil, ParallelFor) {
+  std::vector<uint8_t> visited(1000, 0);
+  ParallelFor(visited.size(), 4, 16, [&visited](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) ++visited[index];
+  });
+  EXPECT_EQ(std::vector<uint8_t>(1000, 1), visited);
+
+  // small range runs on the caller thread.
+  std::thread::id caller_id = std::this_thread::get_id();
+  std::thread::id run_id;
+  ParallelFor(10, 4, 16, [&run_id](size_t, size_t) {
+    run_id = std::this_thread::get_id();
+  });
+  EXPECT_EQ(caller_id, run_id);
+
+  EXPECT_THROW(
+      ParallelFor(100, 4, 1, [](size_t begin, size_t) {
+        if (begin != 0) throw std::runtime_error("test");
+      }),
+      std::runtime_error);
+}
+
+TEST(ThreadUtil, RunOnWorkerPoolReuseThreads) {
+  std::mutex mutex;
+  std::set<std::thread::id> first_ids;
+  std::set<std::thread::id> second_ids;
+  auto collect = [&mutex](std::set<std::thread::id>* ids) {
+    return [&mutex, ids](size_t) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      std::lock_guard<std::mutex> lock(mutex);
+      ids->insert(std::this_thread::get_id());
+    };
+  };
+  RunOnWorkerPool(32, 4, collect(&first_ids));
+  RunOnWorkerPool(32, 4, collect(&second_ids));
+  EXPECT_LE(first_ids.size(), 4U);
+  EXPECT_LE(second_ids.size(), 4U);
+  first_ids.insert(std::this_thread::get_id());
+  // the second call does not create new threads.
+  for (const auto& id : second_ids) {
+    EXPECT_EQ(1U, first_ids.count(id));
+  }
+}
+
+TEST(ThreadUtil, RunOnWorkerPoolNested) {
+  std::atomic<size_t> count(0);
+  RunOnWorkerPool(8, 4, [&count](size_t) {
+    ParallelFor(64, 4, 1, [&count](size_t begin, size_t end) {
+      count += end - begin;
+    });
+  });
+  EXPECT_EQ(8U * 64, count);
+
+  std::vector<std::thread> threads;
+  for (int index = 0; index < 4; ++index) {
+    threads.emplace_back([&count]() {
+      RunOnWorkerPool(16, 8, [&count](size_t) { ++count; });
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ((8U * 64) + (4 * 16), count);
+}
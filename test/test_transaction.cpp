@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <type_traits>
 #include <vector>
 
 #include "cfdcore/cfdcore_address.h"
@@ -30,7 +31,9 @@ using cfd::core::SchnorrUtil;
 using cfd::core::Script;
 using cfd::core::ScriptBuilder;
 using cfd::core::ScriptOperator;
+using cfd::core::ScriptPool;
 using cfd::core::ScriptUtil;
+using cfd::core::Serializer;
 using cfd::core::SigHashAlgorithm;
 using cfd::core::SigHashType;
 using cfd::core::Transaction;
@@ -259,6 +262,59 @@ TEST(Transaction, operator_equal) {
   EXPECT_EQ(tx.HasWitness(), false);
 }
 
+TEST(Transaction, MoveTest) {
+  static_assert(std::is_nothrow_move_constructible<Transaction>::value,
+      "Transaction move constructor must be noexcept.");
+  static_assert(std::is_nothrow_move_assignable<Transaction>::value,
+      "Transaction move assignment must be noexcept.");
+  Transaction base_tx(exp_tx_legacy);
+  Transaction moved_tx(std::move(base_tx));
+  EXPECT_STREQ(moved_tx.GetHex().c_str(), exp_tx_legacy.c_str());
+  EXPECT_EQ(moved_tx.GetTxInCount(), 1);
+  EXPECT_EQ(moved_tx.GetTxOutCount(), 1);
+
+  Transaction assigned_tx(3, 3);
+  assigned_tx = std::move(moved_tx);
+  EXPECT_STREQ(assigned_tx.GetHex().c_str(), exp_tx_legacy.c_str());
+  EXPECT_EQ(assigned_tx.GetTxInCount(), 1);
+
+  // a moved-from object can be assigned again
+  base_tx = assigned_tx;
+  EXPECT_STREQ(base_tx.GetHex().c_str(), exp_tx_legacy.c_str());
+
+  std::vector<Transaction> txs(4, assigned_tx);
+  txs.reserve(32);
+  for (const auto& item : txs) {
+    EXPECT_STREQ(item.GetHex().c_str(), exp_tx_legacy.c_str());
+  }
+}
+
+TEST(Transaction, ConstructorWithScriptPool) {
+  Transaction base_tx(exp_version, exp_locktime);
+  Script script("76a914925d4028880bd0c9d68fbc7fc7dfee976698629c88ac");
+  base_tx.AddTxIn(
+      Txid("b0c2b12cb9c2c1e0e5e2cf8d5b77e9bf6c4d2f8ae0c6f5c1d8f5aa1b3c4d5e6f"),
+      0, 0xffffffff);
+  base_tx.AddTxOut(Amount::CreateBySatoshiAmount(10000), script);
+  base_tx.AddTxOut(Amount::CreateBySatoshiAmount(20000), script);
+  base_tx.AddTxOut(Amount::CreateBySatoshiAmount(30000), Script("6a0100"));
+
+  ScriptPool pool;
+  Transaction tx1(base_tx.GetData(), &pool);
+  Transaction tx2(base_tx.GetData(), &pool);
+  EXPECT_STREQ(tx1.GetHex().c_str(), base_tx.GetHex().c_str());
+  EXPECT_STREQ(
+      tx2.GetTxOut(1).GetLockingScript().GetHex().c_str(),
+      script.GetHex().c_str());
+  EXPECT_EQ(2, pool.GetSize());
+  EXPECT_EQ(6, pool.GetInternCount());
+  EXPECT_EQ(4, pool.GetHitCount());
+
+  Transaction tx3(base_tx.GetData(), nullptr);
+  EXPECT_STREQ(tx3.GetHex().c_str(), base_tx.GetHex().c_str());
+  EXPECT_EQ(2, pool.GetSize());
+}
+
 TEST(Transaction, AddTxIn_RemoveTxIn) {
   Transaction tx(exp_version, exp_locktime);
 
@@ -467,6 +523,25 @@ TEST(Transaction, CheckTxOutBuffer) {
   EXPECT_EQ(tx.GetTxOutCount(), 1);
 }
 
+TEST(Transaction, WriteByteData) {
+  Transaction tx(exp_tx_witness);
+  Serializer counter = Serializer::CreateSizeCounter();
+  tx.WriteByteData(true, &counter);
+  EXPECT_EQ(tx.GetTotalSize(), counter.GetWriteSize());
+
+  std::vector<uint8_t> buffer(counter.GetWriteSize());
+  Serializer builder(buffer.data(), static_cast<uint32_t>(buffer.size()));
+  tx.WriteByteData(true, &builder);
+  EXPECT_EQ(exp_tx_witness, ByteData(buffer).GetHex());
+
+  Serializer sink = Serializer::CreateSha256Sink();
+  tx.WriteByteData(false, &sink);
+  EXPECT_EQ(
+      "08e969a2d0a15e906caa60e7327ec725acfd40f6c5bdff108d6a49cd796e1ee7",
+      Txid(sink.OutputSha256d()).GetHex());
+  EXPECT_THROW(tx.WriteByteData(true, nullptr), CfdException);
+}
+
 TEST(Transaction, GetSchnorrSignatureHash) {
   Privkey key("305e293b010d29bf3c888b617763a438fee9054c8cab66eb12ad078f819d9f27");
   Pubkey pubkey = key.GeneratePubkey();
@@ -503,7 +578,7 @@ TEST(Transaction, GetSchnorrSignatureHash) {
       Txid("2fea883042440d030ca5929814ead927075a8f52fef5f4720fa3cec2e475d916"),
       0, 0xffffffff);  // taproot
   Address addr2("bcrt1qze8fshg0eykfy7nxcr96778xagufv2w429wx40");
-  tx2.AddTxOut(Amount(int64_t{2499998000}), addr2.GetLockingScript());
+  tx2.AddTxOut(Amount::CreateBySatoshiAmount(2499998000), addr2.GetLockingScript());
   std::vector<TxOut> utxo_list(1);
   TxOut utxo(amt1, locking_script);
   utxo_list[0] = utxo;
@@ -555,7 +630,7 @@ TEST(Transaction, GetSchnorrSignatureHashNonce) {
       Txid("2fea883042440d030ca5929814ead927075a8f52fef5f4720fa3cec2e475d916"),
       0, 0xffffffff);  // taproot
   Address addr2("bcrt1qze8fshg0eykfy7nxcr96778xagufv2w429wx40");
-  tx2.AddTxOut(Amount(int64_t{2499998000}), addr2.GetLockingScript());
+  tx2.AddTxOut(Amount::CreateBySatoshiAmount(2499998000), addr2.GetLockingScript());
   std::vector<TxOut> utxo_list(1);
   TxOut utxo(amt1, locking_script);
   utxo_list[0] = utxo;
@@ -572,6 +647,32 @@ TEST(Transaction, GetSchnorrSignatureHashNonce) {
   EXPECT_TRUE(schnorr_pubkey.Verify(schnorr_sig, sighash2));
 }
 
+TEST(Transaction, GetSchnorrSignatureHashWithAnnex) {
+  // BIP341: sha_annex = SHA256(compact_size(size of annex) || annex)
+  Transaction tx(2, 0);
+  tx.AddTxIn(
+      Txid("2fea883042440d030ca5929814ead927075a8f52fef5f4720fa3cec2e475d916"),
+      0, 0xffffffff);
+  tx.AddTxOut(Amount::CreateBySatoshiAmount(2499998000),
+      Script("0014164e985d0fc92c927a66c0cbaf78e6ea389629d5"));
+  std::vector<TxOut> utxo_list(1);
+  utxo_list[0] = TxOut(Amount::CreateBySatoshiAmount(2499999000),
+      Script("51201777701648fa4dd93c74edd9d58cfcc7bdc2fa30a2f6fa908b6fd70c"
+             "92833cfb"));
+  ByteData annex("50a500112233445566778899aabbccddeeff");
+
+  SigHashType sighash_type(SigHashAlgorithm::kSigHashDefault);
+  EXPECT_EQ(
+      "2297cb8f1d10a009bd1129cffca79b2e2c8e41cab9870f07a702ea63d7de7dad",
+      tx.GetSchnorrSignatureHash(
+          0, sighash_type, utxo_list, nullptr, annex).GetHex());
+  sighash_type = SigHashType(SigHashAlgorithm::kSigHashSingle, true);
+  EXPECT_EQ(
+      "8ad54babc8cea6f4161e24f825517d152ad9a3de67e821b7f70cbfcd721a88da",
+      tx.GetSchnorrSignatureHash(
+          0, sighash_type, utxo_list, nullptr, annex).GetHex());
+}
+
 TEST(Transaction, ParseCoinbaseTx) {
   const std::string tx = "020000000001010000000000000000000000000000000000000000000000000000000000000000ffffffff4803632b1e045352b260425443506f6f6cfabe6d6d4b081c2a3c7cb234c159b8e198294dfa79c04b54803e0e54c4a37d239445eb42020000007296cd100100000e8338000000000000ffffffff0245039b000000000017a9147bef0b4a4dafa77b2ec52b81659cbcf0d9a91487870000000000000000266a24aa21a9edba23c37a95438644cda3c06c06ef03047168f3201aade74f3518530a4ba9db710120000000000000000000000000000000000000000000000000000000000000000000000000";
   Transaction tx_obj(tx);